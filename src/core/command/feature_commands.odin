@@ -85,6 +85,30 @@ add_feature_command_execute :: proc(cmd: ^AddFeatureCommand) -> bool {
             return true
         }
 
+    case .Move, .CopyBody:
+        #partial switch params in cmd.params {
+        case ftree.TransformParams:
+            // Generate a default name
+            prefix := cmd.feature_type == .Move ? "Move" : "Copy"
+            name := fmt.aprintf("%s%03d", prefix, ftree.feature_tree_count_type(cmd.tree_ref, cmd.feature_type) + 1)
+
+            if cmd.feature_type == .Move {
+                cmd.feature_id = ftree.feature_tree_add_move(cmd.tree_ref, params.base_feature_id, params.translation, name)
+            } else {
+                cmd.feature_id = ftree.feature_tree_add_copy_body(cmd.tree_ref, params.base_feature_id, params.translation, name)
+            }
+            if cmd.feature_id < 0 {
+                return false
+            }
+            cmd.feature_index = len(cmd.tree_ref.features) - 1
+
+            // Keep any rotation the command was given
+            if params.angle != 0 {
+                ftree.change_body_rotation(cmd.tree_ref, cmd.feature_id, params.axis, params.angle, params.pivot)
+            }
+            return true
+        }
+
     case .Fillet, .Chamfer:
         fmt.println("⚠️  Feature type not yet implemented")
         return false
@@ -104,6 +128,7 @@ add_feature_command_undo :: proc(cmd: AddFeatureCommand) -> bool {
 
         // Remove from array
         ordered_remove(&cmd.tree_ref.features, cmd.feature_index)
+        cmd.tree_ref.revision += 1
 
         // Update active feature if needed
         if cmd.tree_ref.active_feature_id == cmd.feature_id {
@@ -140,6 +165,10 @@ add_feature_command_get_name :: proc(cmd: AddFeatureCommand) -> string {
         return "Add Fillet"
     case .Chamfer:
         return "Add Chamfer"
+    case .Move:
+        return "Add Move"
+    case .CopyBody:
+        return "Add Copy Body"
     }
     return "Add Feature"
 }
@@ -159,6 +188,7 @@ delete_feature_command_execute :: proc(cmd: ^DeleteFeatureCommand) -> bool {
 
         // Remove from array
         ordered_remove(&cmd.tree_ref.features, cmd.feature_index)
+        cmd.tree_ref.revision += 1
 
         // Update active feature if needed
         if cmd.tree_ref.active_feature_id == cmd.deleted_feature.id {
@@ -178,6 +208,7 @@ delete_feature_command_undo :: proc(cmd: DeleteFeatureCommand) -> bool {
     } else {
         inject_at(&cmd.tree_ref.features, cmd.feature_index, cmd.deleted_feature)
     }
+    cmd.tree_ref.revision += 1
 
     // Mark feature as needing update
     cmd.tree_ref.features[cmd.feature_index].status = .NeedsUpdate
@@ -189,6 +220,7 @@ delete_feature_command_redo :: proc(cmd: DeleteFeatureCommand) -> bool {
     // Delete the feature again
     if cmd.feature_index >= 0 && cmd.feature_index < len(cmd.tree_ref.features) {
         ordered_remove(&cmd.tree_ref.features, cmd.feature_index)
+        cmd.tree_ref.revision += 1
 
         // Update active feature if needed
         if cmd.tree_ref.active_feature_id == cmd.deleted_feature.id {
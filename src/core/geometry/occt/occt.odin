@@ -57,6 +57,109 @@ DEFAULT_TESSELLATION :: TessellationParams{
     relative = false,
 }
 
+// =============================================================================
+// Topology Cleanup Parameters
+// =============================================================================
+
+SimplifyParams :: struct {
+    unify_faces: bool,          // Merge same-domain faces (coplanar, co-cylindrical, ...)
+    unify_edges: bool,          // Merge same-domain edges (removes seam/split edges)
+    concat_bsplines: bool,      // Concatenate C1-continuous B-spline edges
+    linear_tolerance: f64,      // Max distance between surfaces to treat as same domain
+    angular_tolerance: f64,     // Max angle (radians) between normals to treat as same domain
+    fix_shape: bool,            // Run ShapeFix_Shape after unification
+    fix_precision: f64,         // ShapeFix basic precision
+    fix_max_tolerance: f64,     // ShapeFix maximum allowed tolerance
+}
+
+// Default cleanup after booleans (tolerances suit millimeter-scale parts)
+DEFAULT_SIMPLIFY :: SimplifyParams{
+    unify_faces = true,
+    unify_edges = true,
+    concat_bsplines = false,
+    linear_tolerance = 1e-7,
+    angular_tolerance = 1e-6,     // ~0.00006° - only merge truly same-domain faces
+    fix_shape = true,
+    fix_precision = 1e-7,
+    fix_max_tolerance = 1e-3,
+}
+
+// Face/edge counts before and after a cleanup pass
+SimplifyStats :: struct {
+    faces_before: int,
+    faces_after: int,
+    edges_before: int,
+    edges_after: int,
+}
+
+// =============================================================================
+// Defeaturing Parameters
+// =============================================================================
+
+// Surface kinds (bit positions match OCCT_SURFACE_* in occt_c_wrapper.h)
+SurfaceKind :: enum u32 {
+    Plane    = 0,
+    Cylinder = 1,  // Holes, bosses, fillets on straight edges
+    Cone     = 2,  // Countersinks, drill tips, chamfers
+    Sphere   = 3,  // Corner blends
+    Torus    = 4,  // Fillets on circular edges
+    Other    = 5,  // B-spline/Bezier/offset/swept (variable fillets)
+}
+
+SurfaceKinds :: bit_set[SurfaceKind; u32]
+
+// Face selections for common detail features
+HOLE_SURFACES :: SurfaceKinds{.Cylinder, .Cone}
+BLEND_SURFACES :: SurfaceKinds{.Cylinder, .Torus, .Sphere, .Other}
+
+// With no surfaces and no size filter nothing is removed
+DefeatureParams :: struct {
+    max_face_area: f64,     // Remove faces smaller than this (model units²); <= 0 disables the size filter
+    surfaces: SurfaceKinds, // Only remove faces of these kinds; empty selects every kind (u32 mask in C)
+    parallel: bool,         // Run the underlying boolean in parallel mode
+}
+
+// Default: strip small holes and blends, keep all planar faces
+DEFAULT_DEFEATURE :: DefeatureParams{
+    max_face_area = 25.0,   // 25mm² - e.g. an M3 hole through a 2mm wall
+    surfaces = HOLE_SURFACES | BLEND_SURFACES,
+    parallel = true,
+}
+
+// =============================================================================
+// Face Queries
+// =============================================================================
+
+// Exact data of one face (mirrors OCCT_FaceInfo)
+// origin/direction/x_direction: plane → area centroid, outward normal, plane X axis;
+// cylinder/cone/sphere/torus → axis location, axis, reference X axis
+FaceInfo :: struct {
+    surface: SurfaceKinds,  // Exactly one kind
+    origin: [3]f64,
+    direction: [3]f64,
+    x_direction: [3]f64,
+    radius: f64,            // Cylinder/sphere radius, cone reference radius, torus major radius
+    minor_radius: f64,      // Torus minor radius
+    semi_angle: f64,        // Cone half-angle (radians)
+    area: f64,
+    center: [3]f64,         // Area centroid
+    bbox_min: [3]f64,
+    bbox_max: [3]f64,
+    loop_start: c.int,      // First outer-loop point in FaceTable.loop_points
+    loop_count: c.int,      // Outer-loop points (closed implicitly)
+}
+
+// Every face of a shape, in count_faces order (free with delete_face_table)
+FaceTable :: struct {
+    faces: [^]FaceInfo,
+    num_faces: c.int,
+    loop_points: [^][3]f64,
+    num_loop_points: c.int,
+}
+
+// Max distance between a curved boundary edge and its outer-loop polyline (model units)
+DEFAULT_FACE_LOOP_DEFLECTION :: 0.05
+
 // =============================================================================
 // Tessellated Mesh (Triangle Soup)
 // =============================================================================
@@ -69,6 +172,8 @@ Mesh :: struct {
 
     triangles: [^]c.int,   // Array of vertex indices (3 per triangle)
     num_triangles: c.int,  // Number of triangles
+
+    triangle_faces: [^]c.int,  // Source face per triangle (count_faces / face_table index)
 }
 
 // =============================================================================
@@ -96,6 +201,9 @@ foreign occt_lib {
     OCCT_Shape_Delete :: proc(shape: Shape) ---
     OCCT_Shape_IsValid :: proc(shape: Shape) -> bool ---
     OCCT_Shape_Type :: proc(shape: Shape) -> c.int ---
+    OCCT_Shape_Share :: proc(shape: Shape) -> Shape ---
+    OCCT_Shape_BoundingBox :: proc(shape: Shape, out_min: [^]f64, out_max: [^]f64) -> bool ---
+    OCCT_Shape_Located :: proc(shape: Shape, matrix: [^]f64) -> Shape ---
 
     // Geometry Primitives
     OCCT_Pnt_Create :: proc(x, y, z: f64) -> Pnt ---
@@ -113,6 +221,8 @@ foreign occt_lib {
     // Wire Creation
     OCCT_Wire_FromPoints2D :: proc(points: [^]f64, num_points: c.int, closed: bool) -> Wire ---
     OCCT_Wire_FromPoints3D :: proc(points: [^]f64, num_points: c.int, closed: bool) -> Wire ---
+    OCCT_Wire_FromPoints2D_PerEdge :: proc(points: [^]f64, num_points: c.int, closed: bool) -> Wire ---
+    OCCT_Wire_FromBSplines2D :: proc(poles: [^]f64, pole_counts: [^]c.int, num_curves: c.int, closed: bool) -> Wire ---
     OCCT_Wire_Delete :: proc(wire: Wire) ---
 
     // Extrusion
@@ -127,6 +237,17 @@ foreign occt_lib {
     OCCT_Boolean_Difference :: proc(base, tool: Shape) -> Shape ---
     OCCT_Boolean_Intersection :: proc(shape1, shape2: Shape) -> Shape ---
 
+    // Topology Cleanup
+    OCCT_Shape_Simplify :: proc(shape: Shape, params: SimplifyParams) -> Shape ---
+    OCCT_Shape_CountSubShapes :: proc(shape: Shape, type: c.int) -> c.int ---
+
+    // Defeaturing
+    OCCT_Defeature :: proc(shape: Shape, params: DefeatureParams, removed_faces: ^c.int) -> Shape ---
+
+    // Face Queries
+    OCCT_Shape_Faces :: proc(shape: Shape, deflection: f64, parallel: bool) -> ^FaceTable ---
+    OCCT_FaceTable_Delete :: proc(table: ^FaceTable) ---
+
     // Primitive Shapes
     OCCT_Primitive_Box :: proc(dx, dy, dz: f64) -> Shape ---
     OCCT_Primitive_Box_TwoCorners :: proc(x1, y1, z1, x2, y2, z2: f64) -> Shape ---
@@ -184,9 +305,118 @@ delete_shape :: proc(shape: Shape) {
     }
 }
 
+// Share shape with another owner (same B-Rep, released independently with delete_shape)
+share_shape :: proc(shape: Shape) -> Shape {
+    if shape == nil {
+        return nil
+    }
+    return OCCT_Shape_Share(shape)
+}
+
+// Axis-aligned bounding box of shape
+bounding_box :: proc(shape: Shape) -> (min_pt: [3]f64, max_pt: [3]f64, ok: bool) {
+    if shape == nil {
+        return
+    }
+    ok = OCCT_Shape_BoundingBox(shape, raw_data(min_pt[:]), raw_data(max_pt[:]))
+    return
+}
+
+// Rigidly placed copy of shape sharing the same B-Rep (TopLoc_Location - no geometry copy)
+// transform must be rigid (rotation + translation). Caller owns the result; nil on failure.
+locate_shape :: proc(shape: Shape, transform: matrix[4,4]f64) -> Shape {
+    if shape == nil {
+        return nil
+    }
+
+    rows: [12]f64
+    for r in 0..<3 {
+        for c in 0..<4 {
+            rows[r * 4 + c] = transform[r, c]
+        }
+    }
+    return OCCT_Shape_Located(shape, raw_data(rows[:]))
+}
+
 // Delete mesh (manual memory management)
 delete_mesh :: proc(mesh: ^Mesh) {
     if mesh != nil {
         OCCT_Mesh_Delete(mesh)
     }
 }
+
+// Source face of triangle i (index into count_faces / face_table order)
+mesh_triangle_face :: proc(mesh: ^Mesh, i: int) -> int {
+    if mesh.triangle_faces == nil do return -1
+    return int(mesh.triangle_faces[i])
+}
+
+// Count unique faces in shape (-1 on failure)
+count_faces :: proc(shape: Shape) -> int {
+    if shape == nil do return -1
+    return int(OCCT_Shape_CountSubShapes(shape, c.int(ShapeType.FACE)))
+}
+
+// Count unique edges in shape (-1 on failure)
+count_edges :: proc(shape: Shape) -> int {
+    if shape == nil do return -1
+    return int(OCCT_Shape_CountSubShapes(shape, c.int(ShapeType.EDGE)))
+}
+
+// Merge same-domain faces/edges and heal the result
+// Returns a new shape (caller owns it) and the face/edge reduction, or nil on failure
+simplify_shape :: proc(shape: Shape, params: SimplifyParams = DEFAULT_SIMPLIFY) -> (Shape, SimplifyStats) {
+    stats: SimplifyStats
+    if shape == nil do return nil, stats
+
+    stats.faces_before = count_faces(shape)
+    stats.edges_before = count_edges(shape)
+
+    result := OCCT_Shape_Simplify(shape, params)
+    if result == nil do return nil, stats
+
+    stats.faces_after = count_faces(result)
+    stats.edges_after = count_edges(result)
+    return result, stats
+}
+
+// Remove small/detail faces and heal the gaps (BRepAlgoAPI_Defeaturing)
+// Returns a new shape (caller owns it) and the number of faces removed, or nil on failure
+defeature_shape :: proc(shape: Shape, params: DefeatureParams = DEFAULT_DEFEATURE) -> (Shape, int) {
+    if shape == nil do return nil, 0
+
+    removed: c.int
+    result := OCCT_Defeature(shape, params, &removed)
+    return result, int(removed)
+}
+
+// Describe every face of shape once, faces in parallel (see OCCT_Shape_Faces)
+// Caller owns the table (delete_face_table); nil on failure
+face_table :: proc(
+    shape: Shape,
+    deflection: f64 = DEFAULT_FACE_LOOP_DEFLECTION,
+    parallel: bool = true,
+) -> ^FaceTable {
+    if shape == nil do return nil
+    return OCCT_Shape_Faces(shape, deflection, parallel)
+}
+
+// Delete face table (manual memory management)
+delete_face_table :: proc(table: ^FaceTable) {
+    if table != nil {
+        OCCT_FaceTable_Delete(table)
+    }
+}
+
+// Faces of a table as a slice (owned by the table)
+face_infos :: proc(table: ^FaceTable) -> []FaceInfo {
+    if table == nil do return nil
+    return table.faces[:table.num_faces]
+}
+
+// Outer-loop polyline of one face (owned by the table)
+face_loop :: proc(table: ^FaceTable, index: int) -> [][3]f64 {
+    if table == nil || index < 0 || index >= int(table.num_faces) do return nil
+    info := &table.faces[index]
+    return table.loop_points[info.loop_start:][:info.loop_count]
+}
@@ -7,7 +7,7 @@
  *     -I/opt/homebrew/include/opencascade \
  *     -L/opt/homebrew/lib \
  *     -lTKernel -lTKMath -lTKBRep -lTKG2d -lTKG3d -lTKGeomBase \
- *     -lTKGeomAlgo -lTKTopAlgo -lTKPrim -lTKBool -lTKFeat \
+ *     -lTKGeomAlgo -lTKTopAlgo -lTKShHealing -lTKPrim -lTKBool -lTKFeat \
  *     -lTKMesh -lTKOffset -lTKFillet \
  *     -Wl,-rpath,/opt/homebrew/lib
  */
@@ -30,10 +30,16 @@
 #include <gp_Dir.hxx>
 #include <gp_Ax1.hxx>
 #include <gp_Ax2.hxx>
+#include <gp_Trsf.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
 
 // B-Rep Building
+#include <Geom_BSplineCurve.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRep_Builder.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeSolid.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
@@ -52,6 +58,26 @@
 #include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepAlgoAPI_Common.hxx>
 
+// Topology Cleanup
+#include <ShapeUpgrade_UnifySameDomain.hxx>
+#include <ShapeFix_Shape.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+// Defeaturing
+#include <BRepAlgoAPI_Defeaturing.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <TopTools_ListOfShape.hxx>
+
+// Face Queries
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepTools.hxx>
+#include <BRepTools_WireExplorer.hxx>
+#include <GCPnts_QuasiUniformDeflection.hxx>
+#include <OSD_Parallel.hxx>
+
 // Mesh Generation (Tessellation)
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <Poly_Triangulation.hxx>
@@ -61,9 +87,14 @@
 
 // Utilities
 #include <BRepCheck_Analyzer.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
 #include <Standard_Version.hxx>
+#include <Precision.hxx>
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <cstdio>
 
@@ -125,6 +156,70 @@ int OCCT_Shape_Type(OCCT_Shape shape) {
     return static_cast<int>(s->ShapeType());
 }
 
+OCCT_Shape OCCT_Shape_Share(OCCT_Shape shape) {
+    if (!shape) return nullptr;
+
+    try {
+        // Copying a TopoDS_Shape copies the handle, not the topology: the new owner
+        // references the same TShape (atomically refcounted by OCCT)
+        TopoDS_Shape* result = new TopoDS_Shape(*toShape(shape));
+        return fromShape(result);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+bool OCCT_Shape_BoundingBox(OCCT_Shape shape, double* out_min, double* out_max) {
+    if (!shape || !out_min || !out_max) return false;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return false;
+
+        Bnd_Box box;
+        BRepBndLib::Add(*s, box);
+        if (box.IsVoid()) return false;
+
+        box.Get(out_min[0], out_min[1], out_min[2], out_max[0], out_max[1], out_max[2]);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+OCCT_Shape OCCT_Shape_Located(OCCT_Shape shape, const double* matrix) {
+    if (!shape || !matrix) return nullptr;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return nullptr;
+
+        // Locations must be rigid: orthonormal rows, no mirroring (SetValues would silently
+        // orthogonalize a scaled or sheared matrix)
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                const double* a = matrix + i * 4;
+                const double* b = matrix + j * 4;
+                double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+                if (std::abs(dot - (i == j ? 1.0 : 0.0)) > 1e-9) return nullptr;
+            }
+        }
+
+        gp_Trsf trsf;
+        trsf.SetValues(matrix[0], matrix[1], matrix[2],  matrix[3],
+                       matrix[4], matrix[5], matrix[6],  matrix[7],
+                       matrix[8], matrix[9], matrix[10], matrix[11]);
+
+        if (trsf.IsNegative()) return nullptr;
+
+        // Moved() composes the location on top of the shape's own - the TShape is shared
+        TopoDS_Shape* result = new TopoDS_Shape(s->Moved(TopLoc_Location(trsf)));
+        return fromShape(result);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
 // =============================================================================
 // Geometry Primitives (gp package)
 // =============================================================================
@@ -179,9 +274,78 @@ void OCCT_Ax2_Delete(OCCT_Ax2 ax2) {
 // Wire Creation (2D Profile)
 // =============================================================================
 
+// Polygon wire in one pass: one shared vertex per distinct point, edges bound
+// directly to those vertices and appended with BRep_Builder. MakeWire::Add
+// searches the wire for a connecting vertex on every call, which is
+// quadratic in the edge count on dense profiles.
+static TopoDS_Shape* makePolygonWire(const double* points, int num_points, int stride, bool closed) {
+    const double degenerate = 1e-7;
+
+    std::vector<gp_Pnt> pts;
+    pts.reserve(num_points);
+    for (int i = 0; i < num_points; i++) {
+        const double* p = points + i * stride;
+        gp_Pnt pnt(p[0], p[1], stride == 3 ? p[2] : 0.0);
+
+        // Skip degenerate edges (same point)
+        if (!pts.empty() && pts.back().Distance(pnt) < degenerate) continue;
+        pts.push_back(pnt);
+    }
+
+    // A closed profile that repeats its first point ends on that vertex
+    if (closed && pts.size() > 2 && pts.back().Distance(pts.front()) < degenerate) {
+        pts.pop_back();
+    }
+    if (pts.size() < 2) return nullptr;
+
+    BRep_Builder builder;
+    std::vector<TopoDS_Vertex> vertices(pts.size());
+    for (size_t i = 0; i < pts.size(); i++) {
+        builder.MakeVertex(vertices[i], pts[i], Precision::Confusion());
+    }
+
+    TopoDS_Wire wire;
+    builder.MakeWire(wire);
+
+    size_t num_edges = pts.size() - 1;
+    if (closed && pts.size() > 2) num_edges = pts.size();
+
+    for (size_t i = 0; i < num_edges; i++) {
+        size_t next = (i + 1) % vertices.size();
+
+        BRepBuilderAPI_MakeEdge edgeBuilder(vertices[i], vertices[next]);
+        if (!edgeBuilder.IsDone()) return nullptr;
+
+        builder.Add(wire, edgeBuilder.Edge());
+    }
+
+    wire.Closed(num_edges == pts.size());
+    return new TopoDS_Shape(wire);
+}
+
 OCCT_Wire OCCT_Wire_FromPoints2D(const double* points, int num_points, bool closed) {
     if (!points || num_points < 2) return nullptr;
 
+    try {
+        return fromShape(makePolygonWire(points, num_points, 2, closed));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+OCCT_Wire OCCT_Wire_FromPoints3D(const double* points, int num_points, bool closed) {
+    if (!points || num_points < 2) return nullptr;
+
+    try {
+        return fromShape(makePolygonWire(points, num_points, 3, closed));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+OCCT_Wire OCCT_Wire_FromPoints2D_PerEdge(const double* points, int num_points, bool closed) {
+    if (!points || num_points < 2) return nullptr;
+
     try {
         BRepBuilderAPI_MakeWire wireBuilder;
 
@@ -215,29 +379,69 @@ OCCT_Wire OCCT_Wire_FromPoints2D(const double* points, int num_points, bool clos
     }
 }
 
-OCCT_Wire OCCT_Wire_FromPoints3D(const double* points, int num_points, bool closed) {
-    if (!points || num_points < 2) return nullptr;
+OCCT_Wire OCCT_Wire_FromBSplines2D(const double* poles, const int* pole_counts, int num_curves, bool closed) {
+    if (!poles || !pole_counts || num_curves < 1) return nullptr;
 
     try {
         BRepBuilderAPI_MakeWire wireBuilder;
 
-        // Create edges connecting consecutive points in 3D
-        for (int i = 0; i < num_points; i++) {
-            int next = (i + 1) % num_points;
+        gp_Pnt wire_start, wire_end;
+        bool has_edges = false;
+        int offset = 0;
+
+        for (int c = 0; c < num_curves; c++) {
+            int n = pole_counts[c];
+            const double* p = poles + offset * 2;
+            offset += n;
+            if (n < 2) continue;
+
+            gp_Pnt first(p[0], p[1], 0.0);
+            gp_Pnt last(p[(n - 1) * 2], p[(n - 1) * 2 + 1], 0.0);
+
+            TopoDS_Edge edge;
+            if (n == 2) {
+                // Skip degenerate edges (same point)
+                if (first.Distance(last) < 1e-7) continue;
+
+                BRepBuilderAPI_MakeEdge edgeBuilder(first, last);
+                if (!edgeBuilder.IsDone()) continue;
+                edge = edgeBuilder.Edge();
+            } else {
+                // Clamped uniform knot vector: end knots repeated degree + 1 times
+                int degree = n < 4 ? n - 1 : 3;
+                int spans = n - degree;
+
+                TColgp_Array1OfPnt cps(1, n);
+                for (int i = 0; i < n; i++) {
+                    cps.SetValue(i + 1, gp_Pnt(p[i * 2], p[i * 2 + 1], 0.0));
+                }
 
-            // Only connect to next if not at end (unless closed)
-            if (i == num_points - 1 && !closed) break;
+                TColStd_Array1OfReal knots(1, spans + 1);
+                TColStd_Array1OfInteger mults(1, spans + 1);
+                for (int k = 0; k <= spans; k++) {
+                    knots.SetValue(k + 1, static_cast<double>(k));
+                    mults.SetValue(k + 1, (k == 0 || k == spans) ? degree + 1 : 1);
+                }
 
-            gp_Pnt p1(points[i*3], points[i*3 + 1], points[i*3 + 2]);
-            gp_Pnt p2(points[next*3], points[next*3 + 1], points[next*3 + 2]);
+                Handle(Geom_BSplineCurve) curve = new Geom_BSplineCurve(cps, knots, mults, degree);
+                BRepBuilderAPI_MakeEdge edgeBuilder(curve);
+                if (!edgeBuilder.IsDone()) continue;
+                edge = edgeBuilder.Edge();
+            }
 
-            // Skip degenerate edges
-            if (p1.Distance(p2) < 1e-7) continue;
+            wireBuilder.Add(edge);
+            if (!wireBuilder.IsDone()) return nullptr;
 
-            BRepBuilderAPI_MakeEdge edgeBuilder(p1, p2);
-            if (!edgeBuilder.IsDone()) continue;
+            if (!has_edges) wire_start = first;
+            wire_end = last;
+            has_edges = true;
+        }
 
-            wireBuilder.Add(edgeBuilder.Edge());
+        if (!has_edges) return nullptr;
+
+        if (closed && wire_end.Distance(wire_start) >= 1e-7) {
+            BRepBuilderAPI_MakeEdge closing(wire_end, wire_start);
+            if (closing.IsDone()) wireBuilder.Add(closing.Edge());
         }
 
         if (!wireBuilder.IsDone()) return nullptr;
@@ -429,6 +633,311 @@ OCCT_Shape OCCT_Boolean_Intersection(OCCT_Shape shape1, OCCT_Shape shape2) {
     }
 }
 
+// =============================================================================
+// Topology Cleanup (ShapeUpgrade / ShapeFix)
+// =============================================================================
+
+OCCT_Shape OCCT_Shape_Simplify(OCCT_Shape shape, OCCT_SimplifyParams params) {
+    if (!shape) return nullptr;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return nullptr;
+
+        TopoDS_Shape result = *s;
+
+        if (params.unify_faces || params.unify_edges) {
+            ShapeUpgrade_UnifySameDomain unify(result, params.unify_edges, params.unify_faces,
+                                               params.concat_bsplines);
+            if (params.linear_tolerance > 0.0) unify.SetLinearTolerance(params.linear_tolerance);
+            if (params.angular_tolerance > 0.0) unify.SetAngularTolerance(params.angular_tolerance);
+            unify.Build();
+            result = unify.Shape();
+            if (result.IsNull()) return nullptr;
+        }
+
+        if (params.fix_shape) {
+            ShapeFix_Shape fixer(result);
+            if (params.fix_precision > 0.0) fixer.SetPrecision(params.fix_precision);
+            if (params.fix_max_tolerance > 0.0) fixer.SetMaxTolerance(params.fix_max_tolerance);
+            fixer.Perform();
+            result = fixer.Shape();
+            if (result.IsNull()) return nullptr;
+        }
+
+        TopoDS_Shape* out = new TopoDS_Shape(result);
+        return fromShape(out);
+
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+int OCCT_Shape_CountSubShapes(OCCT_Shape shape, int type) {
+    if (!shape) return -1;
+    if (type < 0 || type > 6) return -1;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return -1;
+
+        static const TopAbs_ShapeEnum types[] = {
+            TopAbs_VERTEX, TopAbs_EDGE, TopAbs_WIRE, TopAbs_FACE,
+            TopAbs_SHELL, TopAbs_SOLID, TopAbs_COMPOUND
+        };
+
+        // Indexed map counts each shared sub-shape once (explorer would visit shared edges twice)
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(*s, types[type], map);
+        return map.Extent();
+
+    } catch (...) {
+        return -1;
+    }
+}
+
+// =============================================================================
+// Defeaturing (BRepAlgoAPI_Defeaturing)
+// =============================================================================
+
+static unsigned int surfaceTypeBit(const TopoDS_Face& face) {
+    BRepAdaptor_Surface surface(face, false);
+    switch (surface.GetType()) {
+        case GeomAbs_Plane:    return OCCT_SURFACE_PLANE;
+        case GeomAbs_Cylinder: return OCCT_SURFACE_CYLINDER;
+        case GeomAbs_Cone:     return OCCT_SURFACE_CONE;
+        case GeomAbs_Sphere:   return OCCT_SURFACE_SPHERE;
+        case GeomAbs_Torus:    return OCCT_SURFACE_TORUS;
+        default:               return OCCT_SURFACE_OTHER;
+    }
+}
+
+OCCT_Shape OCCT_Defeature(OCCT_Shape shape, OCCT_DefeatureParams params, int* removed_faces) {
+    if (removed_faces) *removed_faces = 0;
+    if (!shape) return nullptr;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return nullptr;
+
+        // No filter set - every face would match and the whole shell would be removed
+        if (params.surface_mask == 0 && params.max_face_area <= 0.0) {
+            return fromShape(new TopoDS_Shape(*s));
+        }
+
+        // Collect faces matching the type mask and size threshold
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(*s, TopAbs_FACE, faces);
+
+        TopTools_ListOfShape toRemove;
+        for (int i = 1; i <= faces.Extent(); i++) {
+            const TopoDS_Face& face = TopoDS::Face(faces(i));
+
+            if (params.surface_mask != 0 && !(params.surface_mask & surfaceTypeBit(face))) {
+                continue;
+            }
+
+            if (params.max_face_area > 0.0) {
+                GProp_GProps props;
+                BRepGProp::SurfaceProperties(face, props);
+                if (props.Mass() >= params.max_face_area) continue;
+            }
+
+            toRemove.Append(face);
+        }
+
+        // Nothing to strip - simplified shape is the exact shape
+        if (toRemove.IsEmpty()) {
+            return fromShape(new TopoDS_Shape(*s));
+        }
+
+        BRepAlgoAPI_Defeaturing defeaturer;
+        defeaturer.SetShape(*s);
+        defeaturer.AddFacesToRemove(toRemove);
+        defeaturer.SetRunParallel(params.parallel);
+        defeaturer.SetToFillHistory(false);
+        defeaturer.Build();
+
+        if (!defeaturer.IsDone() || defeaturer.HasErrors()) return nullptr;
+
+        TopoDS_Shape result = defeaturer.Shape();
+        if (result.IsNull()) return nullptr;
+
+        if (removed_faces) *removed_faces = toRemove.Extent();
+        return fromShape(new TopoDS_Shape(result));
+
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// =============================================================================
+// Face Queries
+// =============================================================================
+
+static void storeXYZ(double* out, const gp_XYZ& xyz) {
+    out[0] = xyz.X();
+    out[1] = xyz.Y();
+    out[2] = xyz.Z();
+}
+
+// Outer wire of face as a polyline, edges in wire order with their orientation applied
+// Each edge contributes every point but its last (the next edge starts there)
+static void outerLoopPoints(const TopoDS_Face& face, double deflection, std::vector<gp_Pnt>& out) {
+    TopoDS_Wire wire = BRepTools::OuterWire(face);
+    if (wire.IsNull()) return;
+
+    for (BRepTools_WireExplorer it(wire, face); it.More(); it.Next()) {
+        const TopoDS_Edge& edge = it.Current();
+        if (BRep_Tool::Degenerated(edge)) continue;
+
+        BRepAdaptor_Curve curve(edge);
+        std::vector<gp_Pnt> points;
+
+        if (curve.GetType() == GeomAbs_Line) {
+            points.push_back(curve.Value(curve.FirstParameter()));
+            points.push_back(curve.Value(curve.LastParameter()));
+        } else {
+            GCPnts_QuasiUniformDeflection sampler(curve, deflection);
+            if (!sampler.IsDone() || sampler.NbPoints() < 2) continue;
+            for (int i = 1; i <= sampler.NbPoints(); i++) {
+                points.push_back(sampler.Value(i));
+            }
+        }
+
+        if (edge.Orientation() == TopAbs_REVERSED) {
+            std::reverse(points.begin(), points.end());
+        }
+        out.insert(out.end(), points.begin(), points.end() - 1);
+    }
+}
+
+// Everything the face table holds for one face (runs on a worker thread)
+static void describeFace(const TopoDS_Face& face, double deflection,
+                         OCCT_FaceInfo& info, std::vector<gp_Pnt>& loop) {
+    BRepAdaptor_Surface surface(face);
+    info.surface = surfaceTypeBit(face);
+
+    GProp_GProps props;
+    BRepGProp::SurfaceProperties(face, props);
+    info.area = props.Mass();
+    storeXYZ(info.center, props.CentreOfMass().XYZ());
+
+    Bnd_Box box;
+    BRepBndLib::Add(face, box, false);
+    if (!box.IsVoid()) {
+        box.Get(info.bbox_min[0], info.bbox_min[1], info.bbox_min[2],
+                info.bbox_max[0], info.bbox_max[1], info.bbox_max[2]);
+    }
+
+    // Analytic parameters (BRepAdaptor_Surface applies the face location)
+    gp_Ax3 position;
+    switch (surface.GetType()) {
+        case GeomAbs_Plane: {
+            position = surface.Plane().Position();
+            // Centroid lies on the plane and, unlike the plane location, inside the face
+            storeXYZ(info.origin, props.CentreOfMass().XYZ());
+            gp_Dir normal = position.Direction();
+            if (face.Orientation() == TopAbs_REVERSED) normal.Reverse();
+            storeXYZ(info.direction, normal.XYZ());
+            storeXYZ(info.x_direction, position.XDirection().XYZ());
+            break;
+        }
+        case GeomAbs_Cylinder:
+            position = surface.Cylinder().Position();
+            info.radius = surface.Cylinder().Radius();
+            break;
+        case GeomAbs_Cone:
+            position = surface.Cone().Position();
+            info.radius = surface.Cone().RefRadius();
+            info.semi_angle = surface.Cone().SemiAngle();
+            break;
+        case GeomAbs_Sphere:
+            position = surface.Sphere().Position();
+            info.radius = surface.Sphere().Radius();
+            break;
+        case GeomAbs_Torus:
+            position = surface.Torus().Position();
+            info.radius = surface.Torus().MajorRadius();
+            info.minor_radius = surface.Torus().MinorRadius();
+            break;
+        default:
+            break;
+    }
+    if (info.surface != OCCT_SURFACE_PLANE && info.surface != OCCT_SURFACE_OTHER) {
+        storeXYZ(info.origin, position.Location().XYZ());
+        storeXYZ(info.direction, position.Direction().XYZ());
+        storeXYZ(info.x_direction, position.XDirection().XYZ());
+    }
+
+    outerLoopPoints(face, deflection, loop);
+}
+
+OCCT_FaceTable* OCCT_Shape_Faces(OCCT_Shape shape, double deflection, bool parallel) {
+    if (!shape || deflection <= 0.0) return nullptr;
+
+    try {
+        TopoDS_Shape* s = toShape(shape);
+        if (s->IsNull()) return nullptr;
+
+        // Same indexing as OCCT_Shape_CountSubShapes (shared faces listed once)
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(*s, TopAbs_FACE, faces);
+        const int count = faces.Extent();
+        if (count == 0) return nullptr;
+
+        std::vector<OCCT_FaceInfo> infos(count);
+        std::vector<std::vector<gp_Pnt>> loops(count);
+        std::vector<char> failed(count, 0);
+
+        // Faces are independent - each worker only reads the shared B-Rep
+        OSD_Parallel::For(0, count, [&](int i) {
+            try {
+                describeFace(TopoDS::Face(faces(i + 1)), deflection, infos[i], loops[i]);
+            } catch (...) {
+                failed[i] = 1;
+            }
+        }, !parallel);
+
+        for (char f : failed) {
+            if (f) return nullptr;
+        }
+
+        size_t total_points = 0;
+        for (const auto& loop : loops) total_points += loop.size();
+
+        OCCT_FaceTable* table = new OCCT_FaceTable();
+        table->num_faces = count;
+        table->faces = new OCCT_FaceInfo[count];
+        table->num_loop_points = static_cast<int>(total_points);
+        table->loop_points = new double[total_points * 3];
+
+        int next = 0;
+        for (int i = 0; i < count; i++) {
+            infos[i].loop_start = next;
+            infos[i].loop_count = static_cast<int>(loops[i].size());
+            for (const gp_Pnt& p : loops[i]) {
+                storeXYZ(table->loop_points + next * 3, p.XYZ());
+                next++;
+            }
+            table->faces[i] = infos[i];
+        }
+
+        return table;
+
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void OCCT_FaceTable_Delete(OCCT_FaceTable* table) {
+    if (table) {
+        delete[] table->faces;
+        delete[] table->loop_points;
+        delete table;
+    }
+}
+
 // =============================================================================
 // Primitive Shapes (BRepPrimAPI)
 // =============================================================================
@@ -621,11 +1130,17 @@ OCCT_Mesh* OCCT_Tessellate(OCCT_Shape shape, OCCT_TessellationParams params) {
         std::vector<float> vertices;
         std::vector<float> normals;
         std::vector<int> triangles;
+        std::vector<int> triangle_faces;
+
+        // Face ids follow OCCT_Shape_CountSubShapes / OCCT_FaceTable indexing
+        TopTools_IndexedMapOfShape face_ids;
+        TopExp::MapShapes(*topoShape, TopAbs_FACE, face_ids);
 
         // Explore all faces in the shape
         for (TopExp_Explorer exp(*topoShape, TopAbs_FACE); exp.More(); exp.Next()) {
             TopoDS_Face face = TopoDS::Face(exp.Current());
             TopLoc_Location location;
+            const int face_id = face_ids.FindIndex(face) - 1;
 
             // Get triangulation
             const Handle(Poly_Triangulation)& tri = BRep_Tool::Triangulation(face, location);
@@ -695,6 +1210,7 @@ OCCT_Mesh* OCCT_Tessellate(OCCT_Shape shape, OCCT_TessellationParams params) {
                 triangles.push_back(vertex_offset + n1 - 1);
                 triangles.push_back(vertex_offset + n2 - 1);
                 triangles.push_back(vertex_offset + n3 - 1);
+                triangle_faces.push_back(face_id);
             }
         }
 
@@ -717,6 +1233,9 @@ OCCT_Mesh* OCCT_Tessellate(OCCT_Shape shape, OCCT_TessellationParams params) {
         mesh->triangles = new int[triangles.size()];
         std::memcpy(mesh->triangles, triangles.data(), triangles.size() * sizeof(int));
 
+        mesh->triangle_faces = new int[triangle_faces.size()];
+        std::memcpy(mesh->triangle_faces, triangle_faces.data(), triangle_faces.size() * sizeof(int));
+
         return mesh;
 
     } catch (...) {
@@ -729,6 +1248,7 @@ void OCCT_Mesh_Delete(OCCT_Mesh* mesh) {
         delete[] mesh->vertices;
         delete[] mesh->normals;
         delete[] mesh->triangles;
+        delete[] mesh->triangle_faces;
         delete mesh;
     }
 }
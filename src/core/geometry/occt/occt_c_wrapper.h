@@ -45,6 +45,18 @@ bool OCCT_Shape_IsValid(OCCT_Shape shape);
 // Get shape type (0=VERTEX, 1=EDGE, 2=WIRE, 3=FACE, 4=SHELL, 5=SOLID, 6=COMPOUND)
 int OCCT_Shape_Type(OCCT_Shape shape);
 
+// Create another owner of the same shape (shares the underlying TShape, no geometry copy)
+// Each handle is released independently with OCCT_Shape_Delete
+OCCT_Shape OCCT_Shape_Share(OCCT_Shape shape);
+
+// Axis-aligned bounding box (out_min/out_max are 3 doubles each); false if shape is null/empty
+bool OCCT_Shape_BoundingBox(OCCT_Shape shape, double* out_min, double* out_max);
+
+// Rigidly placed shape: shares the same TShape under a composed TopLoc_Location
+// (O(1) - no geometry copy). matrix: 3x4 row-major [R | t], R orthonormal.
+// Returns a new handle (caller owns it), or NULL if the matrix is not a rigid transform.
+OCCT_Shape OCCT_Shape_Located(OCCT_Shape shape, const double* matrix);
+
 // =============================================================================
 // Geometry Primitives (gp package)
 // =============================================================================
@@ -73,11 +85,25 @@ void OCCT_Ax2_Delete(OCCT_Ax2 ax2);
 // points: array of [x, y] pairs
 // num_points: number of points
 // closed: whether to close the wire (connect last to first)
+// Consecutive points closer than 1e-7 are merged; each remaining point becomes one
+// vertex shared by its two edges, so the wire is built in a single linear pass
 OCCT_Wire OCCT_Wire_FromPoints2D(const double* points, int num_points, bool closed);
 
-// Create wire from array of 3D points
+// Create wire from array of 3D points (same vertex sharing as the 2D variant)
 OCCT_Wire OCCT_Wire_FromPoints3D(const double* points, int num_points, bool closed);
 
+// Reference path: one BRepBuilderAPI_MakeEdge per segment fed to BRepBuilderAPI_MakeWire
+// Quadratic on dense profiles - kept only so bench-wire-build can compare against it
+OCCT_Wire OCCT_Wire_FromPoints2D_PerEdge(const double* points, int num_points, bool closed);
+
+// Create wire from a chain of clamped uniform B-spline curves on the XY plane
+// poles: [x, y] pairs of every curve's control points, back to back
+// pole_counts: control points per curve (2 = straight edge, 3 = quadratic, 4+ = cubic;
+//              a cubic with 4 poles is a single Bezier segment)
+// closed: add a straight closing edge if the last curve does not end at the first's start
+// Each curve becomes one exact Geom_BSplineCurve edge (no tessellation).
+OCCT_Wire OCCT_Wire_FromBSplines2D(const double* poles, const int* pole_counts, int num_curves, bool closed);
+
 void OCCT_Wire_Delete(OCCT_Wire wire);
 
 // =============================================================================
@@ -115,6 +141,96 @@ OCCT_Shape OCCT_Boolean_Difference(OCCT_Shape base, OCCT_Shape tool);
 // Boolean intersection (common)
 OCCT_Shape OCCT_Boolean_Intersection(OCCT_Shape shape1, OCCT_Shape shape2);
 
+// =============================================================================
+// Topology Cleanup (ShapeUpgrade / ShapeFix)
+// =============================================================================
+
+// Cleanup parameters for post-boolean simplification
+typedef struct {
+    bool unify_faces;           // Merge same-domain faces (coplanar, co-cylindrical, ...)
+    bool unify_edges;           // Merge same-domain edges (removes seam/split edges)
+    bool concat_bsplines;       // Concatenate C1-continuous B-spline edges
+    double linear_tolerance;    // Max distance between surfaces to treat as same domain
+    double angular_tolerance;   // Max angle (radians) between normals to treat as same domain
+    bool fix_shape;             // Run ShapeFix_Shape after unification
+    double fix_precision;       // ShapeFix basic precision
+    double fix_max_tolerance;   // ShapeFix maximum allowed tolerance
+} OCCT_SimplifyParams;
+
+// Merge same-domain faces/edges (ShapeUpgrade_UnifySameDomain) and optionally heal (ShapeFix_Shape)
+// Returns a new shape (caller owns it), or NULL on failure. Input shape is not modified.
+OCCT_Shape OCCT_Shape_Simplify(OCCT_Shape shape, OCCT_SimplifyParams params);
+
+// Count unique sub-shapes of a given type (same codes as OCCT_Shape_Type)
+// Returns -1 on failure
+int OCCT_Shape_CountSubShapes(OCCT_Shape shape, int type);
+
+// =============================================================================
+// Defeaturing (BRepAlgoAPI_Defeaturing)
+// =============================================================================
+
+// Surface type bits for selecting faces to remove
+#define OCCT_SURFACE_PLANE     (1u << 0)
+#define OCCT_SURFACE_CYLINDER  (1u << 1)   // Holes, bosses, fillets on straight edges
+#define OCCT_SURFACE_CONE      (1u << 2)   // Countersinks, drill tips, chamfers
+#define OCCT_SURFACE_SPHERE    (1u << 3)   // Corner blends
+#define OCCT_SURFACE_TORUS     (1u << 4)   // Fillets on circular edges
+#define OCCT_SURFACE_OTHER     (1u << 5)   // B-spline/Bezier/offset/swept (variable fillets)
+
+// Defeaturing parameters
+// A face is removed if its surface type is in surface_mask AND (max_face_area <= 0 or its area is below it).
+// With neither filter set nothing is removed (the result is an unchanged copy).
+typedef struct {
+    double max_face_area;       // Area threshold (model units^2); <= 0 disables the size filter
+    unsigned int surface_mask;  // OCCT_SURFACE_* bits; 0 selects every surface type
+    bool parallel;              // Run the underlying boolean in parallel mode
+} OCCT_DefeatureParams;
+
+// Remove selected faces and heal the gaps with the adjacent faces
+// removed_faces (optional) receives the number of faces removed
+// Returns a new shape (caller owns it), or NULL on failure. Input shape is not modified.
+OCCT_Shape OCCT_Defeature(OCCT_Shape shape, OCCT_DefeatureParams params, int* removed_faces);
+
+// =============================================================================
+// Face Queries
+// =============================================================================
+
+// Exact data of one face
+// origin/direction/x_direction: plane → area centroid, outward normal (face orientation
+// applied), plane X axis; cylinder/cone/sphere/torus → axis location, axis, reference X axis
+typedef struct {
+    unsigned int surface;       // One OCCT_SURFACE_* bit
+    double origin[3];
+    double direction[3];
+    double x_direction[3];
+    double radius;              // Cylinder/sphere radius, cone reference radius, torus major radius
+    double minor_radius;        // Torus minor radius
+    double semi_angle;          // Cone half-angle (radians)
+    double area;
+    double center[3];           // Area centroid
+    double bbox_min[3];
+    double bbox_max[3];
+    int loop_start;             // First outer-loop point in OCCT_FaceTable.loop_points
+    int loop_count;             // Outer-loop points (closed implicitly, last → first)
+} OCCT_FaceInfo;
+
+// Every face of a shape, in OCCT_Shape_CountSubShapes(FACE) order
+typedef struct {
+    OCCT_FaceInfo* faces;
+    int num_faces;
+    double* loop_points;        // x,y,z triples of all outer loops, back to back
+    int num_loop_points;
+} OCCT_FaceTable;
+
+// Enumerate the faces of shape once: surface type and parameters, area, bounding box and
+// outer-loop polyline (curved edges sampled to within deflection). Faces are independent,
+// so with parallel = true they are described concurrently (OSD_Parallel).
+// Returns NULL on failure; free with OCCT_FaceTable_Delete
+OCCT_FaceTable* OCCT_Shape_Faces(OCCT_Shape shape, double deflection, bool parallel);
+
+// Free a face table
+void OCCT_FaceTable_Delete(OCCT_FaceTable* table);
+
 // =============================================================================
 // Primitive Shapes (BRepPrimAPI)
 // =============================================================================
@@ -168,6 +284,9 @@ typedef struct {
     // Triangles (array of vertex indices, 3 per triangle)
     int* triangles;
     int num_triangles;
+
+    // Source face of each triangle (same indexing as OCCT_Shape_CountSubShapes / the face table)
+    int* triangle_faces;
 } OCCT_Mesh;
 
 // Generate triangle mesh from shape
@@ -59,7 +59,79 @@ extrude_profile_2d :: proc(
 
     fmt.println("✅ OCCT: Created wire from profile")
 
-    // Step 3: Extrude wire to create solid
+    return extrude_wire(wire, extrude_vector)
+}
+
+// =============================================================================
+// Exact Curve Profile → OCCT Shape + Mesh Extrusion
+// =============================================================================
+
+// One exact curve of a profile: the control points of a clamped uniform B-spline
+// (2 = straight edge, 3 = quadratic, 4+ = cubic; see OCCT_Wire_FromBSplines2D)
+ProfileCurve2D :: struct {
+    poles: []m.Vec2,
+}
+
+// Extrude a closed chain of 2D curves; splines become exact B-spline edges
+// Caller is responsible for deleting both shape and mesh
+extrude_curves_2d :: proc(
+    curves: []ProfileCurve2D,     // Curves in loop order, each starting where the previous ends
+    extrude_vector: m.Vec3,       // Extrusion direction and distance
+) -> ExtrudeResult {
+
+    result: ExtrudeResult
+
+    if len(curves) == 0 {
+        fmt.println("❌ OCCT Extrude: Profile has no curves")
+        return result
+    }
+
+    fmt.printf("🔧 OCCT Extrude: Extruding %d-curve profile...\n", len(curves))
+
+    pole_count := 0
+    for curve in curves {
+        pole_count += len(curve.poles)
+    }
+
+    occt_poles := make([]f64, pole_count * 2)
+    defer delete(occt_poles)
+    occt_counts := make([]c.int, len(curves))
+    defer delete(occt_counts)
+
+    i := 0
+    for curve, ci in curves {
+        occt_counts[ci] = c.int(len(curve.poles))
+        for pole in curve.poles {
+            occt_poles[i*2 + 0] = f64(pole.x)
+            occt_poles[i*2 + 1] = f64(pole.y)
+            i += 1
+        }
+    }
+
+    wire := OCCT_Wire_FromBSplines2D(
+        raw_data(occt_poles),
+        raw_data(occt_counts),
+        c.int(len(curves)),
+        true,  // closed loop
+    )
+
+    if wire == nil {
+        fmt.println("❌ OCCT Extrude: Failed to create wire from profile curves")
+        return result
+    }
+    defer OCCT_Wire_Delete(wire)
+
+    fmt.println("✅ OCCT: Created exact wire from profile curves")
+
+    return extrude_wire(wire, extrude_vector)
+}
+
+// Extrude a closed wire to a solid and tessellate it
+@(private="file")
+extrude_wire :: proc(wire: Wire, extrude_vector: m.Vec3) -> ExtrudeResult {
+    result: ExtrudeResult
+
+    // Extrude wire to create solid
     solid_shape := OCCT_Extrude_Wire(
         wire,
         extrude_vector.x,
@@ -83,7 +155,7 @@ extrude_profile_2d :: proc(
     shape_type := get_type(solid_shape)
     fmt.printf("✅ OCCT: Extruded to shape (type: %v)\n", shape_type)
 
-    // Step 4: Tessellate to triangle mesh
+    // Tessellate to triangle mesh
     mesh := OCCT_Tessellate(solid_shape, DEFAULT_TESSELLATION)
 
     if mesh == nil {
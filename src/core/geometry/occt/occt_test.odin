@@ -330,6 +330,95 @@ main :: proc() {
 
     fmt.println("\n✅ All primitive tests passed!")
 
+    // =============================================================================
+    // Test: Rigid Placement (TopLoc_Location)
+    // =============================================================================
+
+    fmt.println("\nTesting rigid placement (torus moved by (100, 0, 50), turned 90° about Z)...")
+    placement := matrix[4,4]f64{
+        0, -1, 0, 100,
+        1,  0, 0,   0,
+        0,  0, 1,  50,
+        0,  0, 0,   1,
+    }
+    moved := locate_shape(torus, placement)
+    if moved == nil {
+        fmt.eprintln("❌ FAILED: Could not place torus")
+        return
+    }
+    defer delete_shape(moved)
+
+    moved_min, moved_max, bbox_ok := bounding_box(moved)
+    center := (moved_min + moved_max) * 0.5
+    if !bbox_ok || math.abs(center.x - 100) > 1e-3 || math.abs(center.y) > 1e-3 || math.abs(center.z - 50) > 1e-3 {
+        fmt.eprintf("❌ FAILED: Placed torus centered at %v (expected [100, 0, 50])\n", center)
+        return
+    }
+
+    // A scale is not a location
+    scaled := placement
+    scaled[0, 1] = -2
+    if rejected := locate_shape(torus, scaled); rejected != nil {
+        delete_shape(rejected)
+        fmt.eprintln("❌ FAILED: Non-rigid placement was accepted")
+        return
+    }
+
+    fmt.println("✓ Placed torus shares its B-Rep and is centered at (100, 0, 50)")
+
+    // =============================================================================
+    // Test: Face Table (exact per-face data, enumerated in parallel)
+    // =============================================================================
+
+    fmt.println("\nTesting face table (20x30x40 box, r=10 h=50 cylinder)...")
+    box_faces := face_table(box)
+    if box_faces == nil || box_faces.num_faces != 6 {
+        fmt.eprintln("❌ FAILED: Box face table should list 6 faces")
+        return
+    }
+    defer delete_face_table(box_faces)
+
+    box_area: f64
+    for &info, i in face_infos(box_faces) {
+        // Outward normal points away from the box center (10, 15, 20)
+        outward := (info.center - [3]f64{10, 15, 20}) * info.direction
+        if info.surface != {.Plane} || outward.x + outward.y + outward.z <= 0 || len(face_loop(box_faces, i)) != 4 {
+            fmt.eprintf("❌ FAILED: Box face %d is not an outward plane with a 4-point loop: %v\n", i, info)
+            return
+        }
+        box_area += info.area
+    }
+    if math.abs(box_area - 2 * (20*30 + 30*40 + 20*40)) > 1e-6 {
+        fmt.eprintf("❌ FAILED: Box face areas sum to %.6f\n", box_area)
+        return
+    }
+
+    cylinder_faces := face_table(cylinder, parallel = false)
+    if cylinder_faces == nil || cylinder_faces.num_faces != 3 {
+        fmt.eprintln("❌ FAILED: Cylinder face table should list 3 faces")
+        return
+    }
+    defer delete_face_table(cylinder_faces)
+
+    planes, sides := 0, 0
+    for &info, i in face_infos(cylinder_faces) {
+        if info.surface == {.Plane} {
+            planes += 1
+        } else if info.surface == {.Cylinder} && math.abs(info.radius - 10) < 1e-9 && info.direction.z > 0.999 {
+            sides += 1
+        }
+        if len(face_loop(cylinder_faces, i)) < 8 {
+            fmt.eprintf("❌ FAILED: Cylinder face %d loop has only %d points\n", i, len(face_loop(cylinder_faces, i)))
+            return
+        }
+    }
+    if planes != 2 || sides != 1 {
+        fmt.eprintf("❌ FAILED: Cylinder faces: %d planes, %d cylinders (expected 2, 1)\n", planes, sides)
+        return
+    }
+
+    fmt.println("✓ Face table: box planes face outward with exact areas, cylinder axis and radius recovered")
+
     // =============================================================================
     // Final Summary
     // =============================================================================
@@ -339,4 +428,5 @@ main :: proc() {
     fmt.println("✅ Pentagon extrusion works (unlike Manifold)")
     fmt.println("✅ Boolean operations work (pocket cut succeeded)")
     fmt.println("✅ All 5 primitives work (box, cylinder, sphere, cone, torus)")
+    fmt.println("✅ Face table reports exact planes, axes, areas and outer loops")
 }
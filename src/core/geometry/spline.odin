@@ -0,0 +1,270 @@
+// core/geometry - Bézier and B-spline curves
+// The cubic Bézier segment is the evaluation primitive. A clamped uniform cubic B-spline is
+// split into Bézier segments by knot insertion, and each segment is flattened by evaluating
+// its Bernstein form four parameters at a time. Wang's bound gives a segment's subdivision
+// count up front, so flattening is a straight batched loop with no recursion.
+
+package ohcad_geometry
+
+import m "../../core/math"
+import glsl "core:math/linalg/glsl"
+import "core:math"
+import "core:simd"
+
+@(private="file") F64x4 :: #simd[4]f64
+
+// Upper bound on the subdivision count of one Bézier segment
+BEZIER_MAX_FLATTEN_SEGMENTS :: 1024
+
+// 2D cubic Bézier segment
+Bezier2 :: struct {
+    control_points: [4]m.Vec2,
+}
+
+// =============================================================================
+// Bézier Evaluation
+// =============================================================================
+
+// Evaluate a point on a 2D cubic Bézier using parameter t in [0, 1]
+point_on_bezier_2d :: proc(curve: Bezier2, t: f64) -> m.Vec2 {
+    p := curve.control_points
+    s := 1.0 - t
+    return p[0] * (s * s * s) + p[1] * (3.0 * s * s * t) + p[2] * (3.0 * s * t * t) + p[3] * (t * t * t)
+}
+
+// Evaluate a point on a 3D cubic Bézier using parameter t in [0, 1]
+point_on_bezier_3d :: proc(curve: Bezier3, t: f64) -> m.Vec3 {
+    p := curve.control_points
+    s := 1.0 - t
+    return p[0] * (s * s * s) + p[1] * (3.0 * s * s * t) + p[2] * (3.0 * s * t * t) + p[3] * (t * t * t)
+}
+
+// First derivative of a 2D cubic Bézier (not normalized)
+tangent_on_bezier_2d :: proc(curve: Bezier2, t: f64) -> m.Vec2 {
+    p := curve.control_points
+    s := 1.0 - t
+    return (p[1] - p[0]) * (3.0 * s * s) + (p[2] - p[1]) * (6.0 * s * t) + (p[3] - p[2]) * (3.0 * t * t)
+}
+
+// Split a 2D cubic Bézier at t (de Casteljau); both halves keep the original direction
+split_bezier_2d :: proc(curve: Bezier2, t: f64) -> (left, right: Bezier2) {
+    p := curve.control_points
+    p01 := lerp_2d(p[0], p[1], t)
+    p12 := lerp_2d(p[1], p[2], t)
+    p23 := lerp_2d(p[2], p[3], t)
+    p012 := lerp_2d(p01, p12, t)
+    p123 := lerp_2d(p12, p23, t)
+    mid := lerp_2d(p012, p123, t)
+
+    left = Bezier2{{p[0], p01, p012, mid}}
+    right = Bezier2{{mid, p123, p23, p[3]}}
+    return
+}
+
+// out[i] = point_on_bezier_2d(curve, params[i]), four parameters per step
+points_on_bezier_2d_batch :: proc(curve: Bezier2, params: []f64, out: []m.Vec2) {
+    assert(len(out) >= len(params))
+
+    i := 0
+    for ; i + 4 <= len(params); i += 4 {
+        t := F64x4{params[i], params[i + 1], params[i + 2], params[i + 3]}
+        x, y := bezier_eval_x4(curve, t)
+        store_points_x4(x, y, out[i:i + 4])
+    }
+
+    for ; i < len(params); i += 1 {
+        out[i] = point_on_bezier_2d(curve, params[i])
+    }
+}
+
+// Number of uniform segments that keeps a flattened cubic within `tolerance` of the curve
+// (Wang's bound: n = sqrt(3·2/8 · max|P[i] - 2P[i+1] + P[i+2]| / tolerance))
+bezier_flatten_count_2d :: proc(curve: Bezier2, tolerance: f64) -> int {
+    p := curve.control_points
+    d0 := glsl.length(p[0] - 2.0 * p[1] + p[2])
+    d1 := glsl.length(p[1] - 2.0 * p[2] + p[3])
+    dd := max(d0, d1)
+
+    if dd <= 0 || tolerance <= 0 {
+        return 1
+    }
+
+    n := int(math.ceil(math.sqrt(0.75 * dd / tolerance)))
+    return clamp(n, 1, BEZIER_MAX_FLATTEN_SEGMENTS)
+}
+
+// Append a polyline within `tolerance` of the curve to out
+// The start point is skipped when include_start is false (continuing a chain of segments).
+flatten_bezier_2d :: proc(curve: Bezier2, tolerance: f64, out: ^[dynamic]m.Vec2, include_start := true) {
+    n := bezier_flatten_count_2d(curve, tolerance)
+    first := 0 if include_start else 1
+
+    base := len(out^)
+    resize(out, base + (n + 1 - first))
+    dst := out^[base:]
+
+    inv_n := 1.0 / f64(n)
+    lane := F64x4{0, 1, 2, 3}
+
+    i := first
+    for ; i + 4 <= n + 1; i += 4 {
+        t := (lane + splat(f64(i))) * splat(inv_n)
+        x, y := bezier_eval_x4(curve, t)
+        store_points_x4(x, y, dst[i - first:i - first + 4])
+    }
+
+    for ; i <= n; i += 1 {
+        dst[i - first] = point_on_bezier_2d(curve, f64(i) * inv_n)
+    }
+
+    // Land exactly on the end point (t = n * (1/n) may round)
+    dst[n - first] = curve.control_points[3]
+}
+
+// =============================================================================
+// B-Spline → Bézier Conversion
+// =============================================================================
+
+// Split a clamped uniform cubic B-spline into its Bézier segments (appended to out)
+// 4 control points give one segment; each extra control point adds one. Two or three
+// control points are treated as a line or quadratic, raised to cubic.
+bspline_to_beziers_2d :: proc(controls: []m.Vec2, out: ^[dynamic]Bezier2) -> bool {
+    n := len(controls)
+
+    switch {
+    case n < 2:
+        return false
+
+    case n == 2:
+        p0, p1 := controls[0], controls[1]
+        append(out, Bezier2{{p0, lerp_2d(p0, p1, 1.0 / 3.0), lerp_2d(p0, p1, 2.0 / 3.0), p1}})
+        return true
+
+    case n == 3:
+        // Degree elevation of a quadratic
+        q0, q1, q2 := controls[0], controls[1], controls[2]
+        append(out, Bezier2{{q0, lerp_2d(q0, q1, 2.0 / 3.0), lerp_2d(q2, q1, 2.0 / 3.0), q2}})
+        return true
+    }
+
+    // Clamped uniform knots: [0,0,0,0, 1, 2, ..., k-1, k,k,k,k] for k = n - 3 segments
+    segments := n - 3
+    knots := make([dynamic]f64, 0, n + 4 + 2 * segments, context.temp_allocator)
+    for _ in 0..<4 do append(&knots, 0)
+    for u in 1..<segments do append(&knots, f64(u))
+    for _ in 0..<4 do append(&knots, f64(segments))
+
+    poles := make([dynamic]m.Vec2, 0, 3 * segments + 1, context.temp_allocator)
+    append(&poles, ..controls)
+
+    // Raise every interior knot to multiplicity 3; the poles then chain into Bézier segments
+    for u in 1..<segments {
+        bspline_insert_knot_2d(&poles, &knots, f64(u))
+        bspline_insert_knot_2d(&poles, &knots, f64(u))
+    }
+
+    for s in 0..<segments {
+        append(out, Bezier2{{poles[3 * s], poles[3 * s + 1], poles[3 * s + 2], poles[3 * s + 3]}})
+    }
+    return true
+}
+
+// Append a polyline within `tolerance` of a clamped uniform cubic B-spline to out
+flatten_bspline_2d :: proc(controls: []m.Vec2, tolerance: f64, out: ^[dynamic]m.Vec2) -> bool {
+    beziers := make([dynamic]Bezier2, 0, max(len(controls) - 3, 1), context.temp_allocator)
+    if !bspline_to_beziers_2d(controls, &beziers) {
+        return false
+    }
+
+    for segment, i in beziers {
+        flatten_bezier_2d(segment, tolerance, out, include_start = i == 0)
+    }
+    return true
+}
+
+// Distance from a point to a polyline, and the index of the closest segment
+distance_point_to_polyline_2d :: proc(point: m.Vec2, polyline: []m.Vec2) -> (f64, int) {
+    if len(polyline) == 0 {
+        return math.F64_MAX, -1
+    }
+    if len(polyline) == 1 {
+        return glsl.length(point - polyline[0]), 0
+    }
+
+    best := math.F64_MAX
+    best_index := 0
+    for i in 0..<len(polyline) - 1 {
+        d := distance_point_to_segment_2d(point, Line2{polyline[i], polyline[i + 1]})
+        if d < best {
+            best = d
+            best_index = i
+        }
+    }
+    return best, best_index
+}
+
+// =============================================================================
+// Internal Helpers
+// =============================================================================
+
+// Bernstein evaluation of four parameters at once
+@(private="file")
+bezier_eval_x4 :: proc(curve: Bezier2, t: F64x4) -> (x, y: F64x4) {
+    p := curve.control_points
+    s := splat(1.0) - t
+    b0 := s * s * s
+    b1 := splat(3.0) * s * s * t
+    b2 := splat(3.0) * s * t * t
+    b3 := t * t * t
+
+    x = b0 * splat(p[0].x) + b1 * splat(p[1].x) + b2 * splat(p[2].x) + b3 * splat(p[3].x)
+    y = b0 * splat(p[0].y) + b1 * splat(p[1].y) + b2 * splat(p[2].y) + b3 * splat(p[3].y)
+    return
+}
+
+@(private="file")
+store_points_x4 :: proc(x, y: F64x4, out: []m.Vec2) {
+    xs := simd.to_array(x)
+    ys := simd.to_array(y)
+    for j in 0..<4 {
+        out[j] = m.Vec2{xs[j], ys[j]}
+    }
+}
+
+// Boehm knot insertion for a cubic (one insertion of u)
+@(private="file")
+bspline_insert_knot_2d :: proc(poles: ^[dynamic]m.Vec2, knots: ^[dynamic]f64, u: f64) {
+    DEGREE :: 3
+
+    // Knot span: knots[span] <= u < knots[span + 1]
+    span := DEGREE
+    for span + 1 < len(knots) - DEGREE - 1 && knots[span + 1] <= u {
+        span += 1
+    }
+
+    old := poles^
+    inserted := make([dynamic]m.Vec2, len(old) + 1, context.temp_allocator)
+    for i in 0..=span - DEGREE {
+        inserted[i] = old[i]
+    }
+    for i in span - DEGREE + 1..=span {
+        alpha := (u - knots[i]) / (knots[i + DEGREE] - knots[i])
+        inserted[i] = lerp_2d(old[i - 1], old[i], alpha)
+    }
+    for i in span + 1..<len(inserted) {
+        inserted[i] = old[i - 1]
+    }
+
+    poles^ = inserted
+    inject_at(knots, span + 1, u)
+}
+
+@(private="file")
+splat :: #force_inline proc "contextless" (v: f64) -> F64x4 {
+    return F64x4{v, v, v, v}
+}
+
+@(private="file")
+lerp_2d :: #force_inline proc "contextless" (a, b: m.Vec2, t: f64) -> m.Vec2 {
+    return a + (b - a) * t
+}
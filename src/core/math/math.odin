@@ -144,63 +144,48 @@ point_on_plane :: proc(point: Vec3, plane_origin: Vec3, plane_normal: Vec3, eps:
 
 // Line-line intersection in 2D
 // Returns (intersection_point, success)
-// Uses parametric form: P = P0 + t * (P1 - P0)
+// Side tests go through orient2d (predicates.odin): d0, d1 are the signed areas of a0 and a1
+// against line B, so the point is a0 + t * (a1 - a0) with t = d0 / (d0 - d1), and d0 - d1
+// equals cross(a1 - a0, b1 - b0). Lines whose cross product is within eps are parallel.
 line_line_intersect_2d :: proc(
     a0, a1: Vec2,  // Line A endpoints
     b0, b1: Vec2,  // Line B endpoints
     eps: f64 = DEFAULT_TOLERANCE,
 ) -> (Vec2, bool) {
-    // Direction vectors
-    da := a1 - a0
-    db := b1 - b0
+    d0 := orient2d(b0, b1, a0)
+    d1 := orient2d(b0, b1, a1)
 
-    // Vector from a0 to b0
-    diff := b0 - a0
-
-    // Solve: a0 + t*da = b0 + s*db
-    // Using cross product in 2D: da.x * db.y - da.y * db.x
-    cross_d := da.x * db.y - da.y * db.x
-
-    if is_zero(cross_d, eps) {
+    denom := d0 - d1
+    if d0 == d1 || is_zero(denom, eps) {
         // Lines are parallel or coincident
         return Vec2{}, false
     }
 
-    // Solve for parameter t on line A
-    t := (diff.x * db.y - diff.y * db.x) / cross_d
-
-    // Intersection point
-    intersection := a0 + da * t
-
-    return intersection, true
+    t := d0 / denom
+    return a0 + (a1 - a0) * t, true
 }
 
 // Line segment intersection in 2D (checks if intersection is within segments)
 // Returns (intersection_point, success)
+// Whether the closed segments meet is decided exactly (segments_intersect_2d), so touching
+// endpoints count and near misses do not. Collinear overlaps have no single point and fail.
 segment_segment_intersect_2d :: proc(
     a0, a1: Vec2,
     b0, b1: Vec2,
-    eps: f64 = DEFAULT_TOLERANCE,
 ) -> (Vec2, bool) {
-    da := a1 - a0
-    db := b1 - b0
-    diff := b0 - a0
-
-    cross_d := da.x * db.y - da.y * db.x
-
-    if is_zero(cross_d, eps) {
+    if !segments_intersect_2d(a0, a1, b0, b1) {
         return Vec2{}, false
     }
 
-    t := (diff.x * db.y - diff.y * db.x) / cross_d
-    s := (diff.x * da.y - diff.y * da.x) / cross_d
-
-    // Check if intersection is within both segments [0, 1]
-    if t >= -eps && t <= 1.0 + eps && s >= -eps && s <= 1.0 + eps {
-        return a0 + da * t, true
+    d0 := orient2d(b0, b1, a0)
+    d1 := orient2d(b0, b1, a1)
+    if d0 == d1 {
+        return Vec2{}, false  // Collinear (d0 == d1 == 0)
     }
 
-    return Vec2{}, false
+    // d0 and d1 have opposite signs (or one is zero), so t lies in [0, 1]
+    t := clamp(d0 / (d0 - d1), 0, 1)
+    return a0 + (a1 - a0) * t, true
 }
 
 // =============================================================================
@@ -367,33 +352,11 @@ plane_plane_intersect :: proc(
 // 2D Polygon Operations
 // =============================================================================
 
-// Check if a point is inside a 2D polygon using ray casting algorithm
+// Check if a point is strictly inside a 2D polygon (even-odd rule)
 // Polygon vertices should be ordered (clockwise or counter-clockwise)
+// Edge crossings are decided with the exact orient2d predicate (see predicates.odin)
 point_in_polygon_2d :: proc(point: Vec2, polygon: []Vec2) -> bool {
-    if len(polygon) < 3 {
-        return false
-    }
-
-    // Ray casting algorithm - count intersections with edges
-    intersections := 0
-
-    for i in 0..<len(polygon) {
-        v1 := polygon[i]
-        v2 := polygon[(i + 1) % len(polygon)]
-
-        // Check if ray from point going right intersects edge
-        if (v1.y > point.y) != (v2.y > point.y) {
-            // Edge crosses the horizontal line through point
-            x_intersection := (v2.x - v1.x) * (point.y - v1.y) / (v2.y - v1.y) + v1.x
-
-            if point.x < x_intersection {
-                intersections += 1
-            }
-        }
-    }
-
-    // Odd number of intersections means inside
-    return (intersections % 2) == 1
+    return classify_point_polygon_2d(point, polygon) == .Inside
 }
 
 // Calculate the signed area of a 2D polygon
@@ -0,0 +1,738 @@
+// core/math - Robust geometric predicates
+// orient2d, orient3d, incircle, ray-triangle and point-in-polygon with exact signs.
+// Every predicate first evaluates in plain f64 with a forward error bound (Shewchuk's
+// static filter); only inputs too close to degenerate for the bound fall back to exact
+// expansion arithmetic. Batch variants evaluate the filter four lanes at a time.
+//
+// Sign conventions (Shewchuk):
+//   orient2d(a, b, c)    > 0 if a, b, c are counter-clockwise (c left of a→b)
+//   orient3d(a, b, c, d) > 0 if d lies below the plane through a, b, c
+//                          (a, b, c counter-clockwise seen from above)
+//   incircle(a, b, c, d) > 0 if d lies inside the circle through a, b, c (a, b, c CCW)
+// The returned value has the exact sign; its magnitude is only approximate.
+
+package ohcad_math
+
+import "core:simd"
+
+// Half an ulp of 1.0 and the Dekker splitter for f64
+@(private="file") PRED_EPSILON :: 1.1102230246251565e-16   // 2^-53
+@(private="file") PRED_SPLITTER :: 134217729.0            // 2^27 + 1
+
+// Forward error bounds for the f64 filters
+@(private="file") CCW_ERRBOUND :: (3.0 + 16.0 * PRED_EPSILON) * PRED_EPSILON
+@(private="file") O3D_ERRBOUND :: (7.0 + 56.0 * PRED_EPSILON) * PRED_EPSILON
+@(private="file") ICC_ERRBOUND :: (10.0 + 96.0 * PRED_EPSILON) * PRED_EPSILON
+
+@(private="file") F64x4 :: #simd[4]f64
+
+// Triangle corners for batch ray queries
+TrianglePoints :: [3]Vec3
+
+// Point classification against a polygon
+PolygonSide :: enum {
+    Outside,
+    Inside,
+    Boundary,
+}
+
+// =============================================================================
+// Scalar Predicates
+// =============================================================================
+
+orient2d :: proc(a, b, c: Vec2) -> f64 {
+    detleft := (a.x - c.x) * (b.y - c.y)
+    detright := (a.y - c.y) * (b.x - c.x)
+    det := detleft - detright
+
+    errbound := CCW_ERRBOUND * (abs(detleft) + abs(detright))
+    if det > errbound || -det > errbound || (detleft == 0 && detright == 0) {
+        return det
+    }
+    return orient2d_exact(a, b, c)
+}
+
+orient3d :: proc(a, b, c, d: Vec3) -> f64 {
+    adx, ady, adz := a.x - d.x, a.y - d.y, a.z - d.z
+    bdx, bdy, bdz := b.x - d.x, b.y - d.y, b.z - d.z
+    cdx, cdy, cdz := c.x - d.x, c.y - d.y, c.z - d.z
+
+    bdxcdy, cdxbdy := bdx * cdy, cdx * bdy
+    cdxady, adxcdy := cdx * ady, adx * cdy
+    adxbdy, bdxady := adx * bdy, bdx * ady
+
+    det := adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady)
+    permanent := (abs(bdxcdy) + abs(cdxbdy)) * abs(adz) +
+                 (abs(cdxady) + abs(adxcdy)) * abs(bdz) +
+                 (abs(adxbdy) + abs(bdxady)) * abs(cdz)
+
+    errbound := O3D_ERRBOUND * permanent
+    if det > errbound || -det > errbound || permanent == 0 {
+        return det
+    }
+    return orient3d_exact(a, b, c, d)
+}
+
+incircle :: proc(a, b, c, d: Vec2) -> f64 {
+    adx, ady := a.x - d.x, a.y - d.y
+    bdx, bdy := b.x - d.x, b.y - d.y
+    cdx, cdy := c.x - d.x, c.y - d.y
+
+    bdxcdy, cdxbdy := bdx * cdy, cdx * bdy
+    cdxady, adxcdy := cdx * ady, adx * cdy
+    adxbdy, bdxady := adx * bdy, bdx * ady
+    alift := adx * adx + ady * ady
+    blift := bdx * bdx + bdy * bdy
+    clift := cdx * cdx + cdy * cdy
+
+    det := alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady)
+    permanent := (abs(bdxcdy) + abs(cdxbdy)) * alift +
+                 (abs(cdxady) + abs(adxcdy)) * blift +
+                 (abs(adxbdy) + abs(bdxady)) * clift
+
+    errbound := ICC_ERRBOUND * permanent
+    if det > errbound || -det > errbound || permanent == 0 {
+        return det
+    }
+    return incircle_exact(a, b, c, d)
+}
+
+// Ray-triangle intersection with exact inside/outside decisions
+// The line through origin and origin + dir is tested against the triangle edges with
+// orient3d. A zero edge sign is resolved by shifting the ray symbolically (edge_tie_break),
+// so a ray through an edge shared by two consistently wound triangles hits exactly one of
+// them (no cracks, no double hits); rays through a shared vertex are resolved the same way.
+// Only the hit distance t is computed in floating point.
+ray_triangle :: proc(origin, dir: Vec3, a, b, c: Vec3) -> (t: f64, hit: bool) {
+    q := origin + dir
+    s0 := orient3d(origin, q, a, b)
+    s1 := orient3d(origin, q, b, c)
+    s2 := orient3d(origin, q, c, a)
+    return ray_triangle_finish(origin, dir, a, b, c, s0, s1, s2)
+}
+
+// Classify point against a simple or self-intersecting polygon (even-odd rule)
+classify_point_polygon_2d :: proc(point: Vec2, polygon: []Vec2) -> PolygonSide {
+    if len(polygon) < 3 {
+        return .Outside
+    }
+
+    inside := false
+    n := len(polygon)
+    for i in 0..<n {
+        v1 := polygon[i]
+        v2 := polygon[(i + 1) % n]
+        if point.y < min(v1.y, v2.y) || point.y > max(v1.y, v2.y) do continue
+
+        side, crossing := polygon_edge_step(v1, v2, point, orient2d(v1, v2, point))
+        if side == .Boundary do return .Boundary
+        if crossing do inside = !inside
+    }
+
+    return inside ? .Inside : .Outside
+}
+
+// Exact test for two closed segments sharing at least one point
+segments_intersect_2d :: proc(a0, a1, b0, b1: Vec2) -> bool {
+    d0 := orient2d(b0, b1, a0)
+    d1 := orient2d(b0, b1, a1)
+    d2 := orient2d(a0, a1, b0)
+    d3 := orient2d(a0, a1, b1)
+
+    if ((d0 > 0 && d1 < 0) || (d0 < 0 && d1 > 0)) && ((d2 > 0 && d3 < 0) || (d2 < 0 && d3 > 0)) {
+        return true
+    }
+
+    // Touching / collinear cases
+    on_segment :: proc(p, q, r: Vec2) -> bool {
+        return min(p.x, q.x) <= r.x && r.x <= max(p.x, q.x) &&
+               min(p.y, q.y) <= r.y && r.y <= max(p.y, q.y)
+    }
+    return (d0 == 0 && on_segment(b0, b1, a0)) ||
+           (d1 == 0 && on_segment(b0, b1, a1)) ||
+           (d2 == 0 && on_segment(a0, a1, b0)) ||
+           (d3 == 0 && on_segment(a0, a1, b1))
+}
+
+// =============================================================================
+// Batch Predicates (4-wide filter, exact fallback per ambiguous lane)
+// =============================================================================
+
+// out[i] = orient2d(a, b, points[i])
+orient2d_batch :: proc(a, b: Vec2, points: []Vec2, out: []f64) {
+    assert(len(out) >= len(points))
+
+    i := 0
+    for ; i + 4 <= len(points); i += 4 {
+        p := points[i:i + 4]
+        px := F64x4{p[0].x, p[1].x, p[2].x, p[3].x}
+        py := F64x4{p[0].y, p[1].y, p[2].y, p[3].y}
+
+        det, errbound := orient2d_x4(a, b, px, py)
+        store_filtered(det, errbound, out[i:i + 4])
+        for j in 0..<4 {
+            if is_nan(out[i + j]) do out[i + j] = orient2d_exact(a, b, p[j])
+        }
+    }
+
+    for ; i < len(points); i += 1 {
+        out[i] = orient2d(a, b, points[i])
+    }
+}
+
+// out[i] = orient3d(a, b, c, points[i])
+orient3d_batch :: proc(a, b, c: Vec3, points: []Vec3, out: []f64) {
+    assert(len(out) >= len(points))
+
+    i := 0
+    for ; i + 4 <= len(points); i += 4 {
+        p := points[i:i + 4]
+        det, errbound := orient3d_x4(
+            splat(a.x), splat(a.y), splat(a.z),
+            splat(b.x), splat(b.y), splat(b.z),
+            splat(c.x), splat(c.y), splat(c.z),
+            F64x4{p[0].x, p[1].x, p[2].x, p[3].x},
+            F64x4{p[0].y, p[1].y, p[2].y, p[3].y},
+            F64x4{p[0].z, p[1].z, p[2].z, p[3].z},
+        )
+        store_filtered(det, errbound, out[i:i + 4])
+        for j in 0..<4 {
+            if is_nan(out[i + j]) do out[i + j] = orient3d_exact(a, b, c, p[j])
+        }
+    }
+
+    for ; i < len(points); i += 1 {
+        out[i] = orient3d(a, b, c, points[i])
+    }
+}
+
+// out[i] = incircle(a, b, c, points[i])
+incircle_batch :: proc(a, b, c: Vec2, points: []Vec2, out: []f64) {
+    assert(len(out) >= len(points))
+
+    i := 0
+    for ; i + 4 <= len(points); i += 4 {
+        p := points[i:i + 4]
+        dx := F64x4{p[0].x, p[1].x, p[2].x, p[3].x}
+        dy := F64x4{p[0].y, p[1].y, p[2].y, p[3].y}
+
+        adx, ady := splat(a.x) - dx, splat(a.y) - dy
+        bdx, bdy := splat(b.x) - dx, splat(b.y) - dy
+        cdx, cdy := splat(c.x) - dx, splat(c.y) - dy
+
+        bdxcdy, cdxbdy := bdx * cdy, cdx * bdy
+        cdxady, adxcdy := cdx * ady, adx * cdy
+        adxbdy, bdxady := adx * bdy, bdx * ady
+        alift := adx * adx + ady * ady
+        blift := bdx * bdx + bdy * bdy
+        clift := cdx * cdx + cdy * cdy
+
+        det := alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady)
+        permanent := (simd.abs(bdxcdy) + simd.abs(cdxbdy)) * alift +
+                     (simd.abs(cdxady) + simd.abs(adxcdy)) * blift +
+                     (simd.abs(adxbdy) + simd.abs(bdxady)) * clift
+
+        store_filtered(det, splat(ICC_ERRBOUND) * permanent, out[i:i + 4])
+        for j in 0..<4 {
+            if is_nan(out[i + j]) do out[i + j] = incircle_exact(a, b, c, p[j])
+        }
+    }
+
+    for ; i < len(points); i += 1 {
+        out[i] = incircle(a, b, c, points[i])
+    }
+}
+
+// Ray against many triangles; out_t[i] = hit distance or +Inf on a miss
+// Returns the number of triangles hit
+ray_triangles_batch :: proc(origin, dir: Vec3, tris: []TrianglePoints, out_t: []f64) -> int {
+    assert(len(out_t) >= len(tris))
+
+    hits := 0
+    i := 0
+    for ; i + 4 <= len(tris); i += 4 {
+        s := ray_edge_signs_x4(origin, dir, tris[i:i + 4])
+        for j in 0..<4 {
+            tri := tris[i + j]
+            t, hit := ray_triangle_finish(origin, dir, tri[0], tri[1], tri[2], s[0][j], s[1][j], s[2][j])
+            out_t[i + j] = hit ? t : INF_F64
+            if hit do hits += 1
+        }
+    }
+
+    for ; i < len(tris); i += 1 {
+        tri := tris[i]
+        t, hit := ray_triangle(origin, dir, tri[0], tri[1], tri[2])
+        out_t[i] = hit ? t : INF_F64
+        if hit do hits += 1
+    }
+
+    return hits
+}
+
+// True if the ray hits any triangle with 0 < t < max_t (occlusion queries)
+ray_triangles_any_hit :: proc(origin, dir: Vec3, tris: []TrianglePoints, max_t: f64) -> bool {
+    i := 0
+    for ; i + 4 <= len(tris); i += 4 {
+        s := ray_edge_signs_x4(origin, dir, tris[i:i + 4])
+        for j in 0..<4 {
+            tri := tris[i + j]
+            t, hit := ray_triangle_finish(origin, dir, tri[0], tri[1], tri[2], s[0][j], s[1][j], s[2][j])
+            if hit && t > 0 && t < max_t do return true
+        }
+    }
+
+    for ; i < len(tris); i += 1 {
+        tri := tris[i]
+        t, hit := ray_triangle(origin, dir, tri[0], tri[1], tri[2])
+        if hit && t > 0 && t < max_t do return true
+    }
+
+    return false
+}
+
+// Classify many points against one polygon (edges outer, points inner, 4 points per step)
+classify_points_polygon_2d_batch :: proc(points: []Vec2, polygon: []Vec2, out: []PolygonSide) {
+    assert(len(out) >= len(points))
+
+    for i in 0..<len(points) {
+        out[i] = .Outside
+    }
+    if len(polygon) < 3 {
+        return
+    }
+
+    n := len(polygon)
+    dets: [4]f64
+    for e in 0..<n {
+        v1 := polygon[e]
+        v2 := polygon[(e + 1) % n]
+        y_lo, y_hi := min(v1.y, v2.y), max(v1.y, v2.y)
+
+        i := 0
+        for ; i + 4 <= len(points); i += 4 {
+            p := points[i:i + 4]
+            det, errbound := orient2d_x4(v1, v2,
+                F64x4{p[0].x, p[1].x, p[2].x, p[3].x},
+                F64x4{p[0].y, p[1].y, p[2].y, p[3].y})
+            store_filtered(det, errbound, dets[:])
+
+            for j in 0..<4 {
+                if out[i + j] == .Boundary || p[j].y < y_lo || p[j].y > y_hi do continue
+                if is_nan(dets[j]) do dets[j] = orient2d_exact(v1, v2, p[j])
+                polygon_edge_apply(v1, v2, p[j], dets[j], &out[i + j])
+            }
+        }
+
+        for ; i < len(points); i += 1 {
+            if out[i] == .Boundary || points[i].y < y_lo || points[i].y > y_hi do continue
+            polygon_edge_apply(v1, v2, points[i], orient2d(v1, v2, points[i]), &out[i])
+        }
+    }
+}
+
+// =============================================================================
+// Internals - shared decision logic
+// =============================================================================
+
+@(private="file")
+INF_F64 :: 0h7FF0000000000000
+
+@(private="file")
+splat :: #force_inline proc(x: f64) -> F64x4 {
+    return F64x4{x, x, x, x}
+}
+
+@(private="file")
+is_nan :: #force_inline proc(x: f64) -> bool {
+    return x != x
+}
+
+// One crossing-number step for an edge whose y-range contains point
+// Crossing rule: half-open in y, so vertices on the ray are counted exactly once
+@(private="file")
+polygon_edge_step :: proc(v1, v2, point: Vec2, det: f64) -> (side: PolygonSide, crossing: bool) {
+    if det == 0 && min(v1.x, v2.x) <= point.x && point.x <= max(v1.x, v2.x) {
+        return .Boundary, false
+    }
+
+    above1 := v1.y > point.y
+    above2 := v2.y > point.y
+    if above1 == above2 {
+        return .Outside, false
+    }
+
+    // Upward edge: point is left of it (ray crosses) when det > 0; downward: det < 0
+    return .Outside, above2 ? det > 0 : det < 0
+}
+
+@(private="file")
+polygon_edge_apply :: proc(v1, v2, point: Vec2, det: f64, state: ^PolygonSide) {
+    side, crossing := polygon_edge_step(v1, v2, point, det)
+    if side == .Boundary {
+        state^ = .Boundary
+    } else if crossing {
+        state^ = state^ == .Inside ? .Outside : .Inside
+    }
+}
+
+// Edge signs agree (after the tie-break) → hit; t from the supporting plane
+@(private="file")
+ray_triangle_finish :: proc(origin, dir, a, b, c: Vec3, s0, s1, s2: f64) -> (t: f64, hit: bool) {
+    if s0 == 0 && s1 == 0 && s2 == 0 {
+        return 0, false  // Ray lies in the triangle's plane
+    }
+
+    d0 := edge_tie_break(s0, dir, a, b)
+    d1 := edge_tie_break(s1, dir, b, c)
+    d2 := edge_tie_break(s2, dir, c, a)
+    if (d0 < 0 || d1 < 0 || d2 < 0) && (d0 > 0 || d1 > 0 || d2 > 0) {
+        return 0, false
+    }
+
+    ab := b - a
+    ac := c - a
+    n := Vec3{ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x}
+    denom := n.x * dir.x + n.y * dir.y + n.z * dir.z
+    if denom == 0 {
+        return 0, false
+    }
+
+    ao := a - origin
+    t = (n.x * ao.x + n.y * ao.y + n.z * ao.z) / denom
+    return t, true
+}
+
+// Sign of edge p0→p1 for a ray passing exactly through it: the sign after translating the
+// ray by (ε, ε², ε³), i.e. the first nonzero component of dir × (p0 - p1). The neighbor
+// sharing the edge sees p1→p0 and gets exactly the opposite sign, so one triangle claims
+// the ray. An edge parallel to the ray falls back to the vertex order.
+@(private="file")
+edge_tie_break :: #force_inline proc(s: f64, dir, p0, p1: Vec3) -> f64 {
+    if s != 0 do return s
+
+    e := p0 - p1
+    shift := Vec3{dir.y * e.z - dir.z * e.y, dir.z * e.x - dir.x * e.z, dir.x * e.y - dir.y * e.x}
+    if shift.x != 0 do return shift.x
+    if shift.y != 0 do return shift.y
+    if shift.z != 0 do return shift.z
+
+    if p0.x != p1.x do return p0.x < p1.x ? 1 : -1
+    if p0.y != p1.y do return p0.y < p1.y ? 1 : -1
+    return p0.z < p1.z ? 1 : -1
+}
+
+// =============================================================================
+// Internals - 4-wide filters
+// =============================================================================
+
+// Lanes that pass the filter get det, the rest NaN (caller runs the exact fallback)
+@(private="file")
+store_filtered :: #force_inline proc(det, errbound: F64x4, out: []f64) {
+    d := simd.to_array(det)
+    e := simd.to_array(errbound)
+    for j in 0..<4 {
+        out[j] = (d[j] > e[j] || -d[j] > e[j]) ? d[j] : f64(0h7FF8000000000000)
+    }
+}
+
+@(private="file")
+orient2d_x4 :: #force_inline proc(a, b: Vec2, cx, cy: F64x4) -> (det, errbound: F64x4) {
+    detleft := (splat(a.x) - cx) * (splat(b.y) - cy)
+    detright := (splat(a.y) - cy) * (splat(b.x) - cx)
+    det = detleft - detright
+    errbound = splat(CCW_ERRBOUND) * (simd.abs(detleft) + simd.abs(detright))
+    return
+}
+
+@(private="file")
+orient3d_x4 :: #force_inline proc(ax, ay, az, bx, by, bz, cx, cy, cz, dx, dy, dz: F64x4) -> (det, errbound: F64x4) {
+    adx, ady, adz := ax - dx, ay - dy, az - dz
+    bdx, bdy, bdz := bx - dx, by - dy, bz - dz
+    cdx, cdy, cdz := cx - dx, cy - dy, cz - dz
+
+    bdxcdy, cdxbdy := bdx * cdy, cdx * bdy
+    cdxady, adxcdy := cdx * ady, adx * cdy
+    adxbdy, bdxady := adx * bdy, bdx * ady
+
+    det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady)
+    permanent := (simd.abs(bdxcdy) + simd.abs(cdxbdy)) * simd.abs(adz) +
+                 (simd.abs(cdxady) + simd.abs(adxcdy)) * simd.abs(bdz) +
+                 (simd.abs(adxbdy) + simd.abs(bdxady)) * simd.abs(cdz)
+    errbound = splat(O3D_ERRBOUND) * permanent
+    return
+}
+
+// orient3d(origin, q, edge start, edge end) for the three edges of 4 triangles
+@(private="file")
+ray_edge_signs_x4 :: proc(origin, dir: Vec3, tris: []TrianglePoints) -> (signs: [3][4]f64) {
+    q := origin + dir
+    ox, oy, oz := splat(origin.x), splat(origin.y), splat(origin.z)
+    qx, qy, qz := splat(q.x), splat(q.y), splat(q.z)
+
+    for e in 0..<3 {
+        k0, k1 := e, (e + 1) % 3
+        det, errbound := orient3d_x4(
+            ox, oy, oz, qx, qy, qz,
+            F64x4{tris[0][k0].x, tris[1][k0].x, tris[2][k0].x, tris[3][k0].x},
+            F64x4{tris[0][k0].y, tris[1][k0].y, tris[2][k0].y, tris[3][k0].y},
+            F64x4{tris[0][k0].z, tris[1][k0].z, tris[2][k0].z, tris[3][k0].z},
+            F64x4{tris[0][k1].x, tris[1][k1].x, tris[2][k1].x, tris[3][k1].x},
+            F64x4{tris[0][k1].y, tris[1][k1].y, tris[2][k1].y, tris[3][k1].y},
+            F64x4{tris[0][k1].z, tris[1][k1].z, tris[2][k1].z, tris[3][k1].z},
+        )
+        store_filtered(det, errbound, signs[e][:])
+        for j in 0..<4 {
+            if is_nan(signs[e][j]) {
+                signs[e][j] = orient3d_exact(origin, q, tris[j][k0], tris[j][k1])
+            }
+        }
+    }
+    return
+}
+
+// =============================================================================
+// Internals - exact expansion arithmetic (Shewchuk)
+// =============================================================================
+// An expansion is a slice of non-overlapping f64 components in increasing magnitude whose
+// exact sum is the value. Zero components are eliminated, so the last component carries
+// the sign.
+
+@(private="file")
+two_sum :: #force_inline proc(a, b: f64) -> (x, y: f64) {
+    x = a + b
+    bv := x - a
+    av := x - bv
+    y = (a - av) + (b - bv)
+    return
+}
+
+@(private="file")
+fast_two_sum :: #force_inline proc(a, b: f64) -> (x, y: f64) {
+    x = a + b
+    y = b - (x - a)
+    return
+}
+
+@(private="file")
+two_diff :: #force_inline proc(a, b: f64) -> (x, y: f64) {
+    x = a - b
+    bv := a - x
+    av := x + bv
+    y = (a - av) + (bv - b)
+    return
+}
+
+@(private="file")
+split :: #force_inline proc(a: f64) -> (hi, lo: f64) {
+    c := PRED_SPLITTER * a
+    hi = c - (c - a)
+    lo = a - hi
+    return
+}
+
+@(private="file")
+two_product :: #force_inline proc(a, b: f64) -> (x, y: f64) {
+    x = a * b
+    ahi, alo := split(a)
+    bhi, blo := split(b)
+    err := x - ahi * bhi - alo * bhi - ahi * blo
+    y = alo * blo - err
+    return
+}
+
+// Exact a - b as an expansion (1 or 2 components)
+@(private="file")
+exp_diff :: proc(a, b: f64, h: []f64) -> int {
+    x, y := two_diff(a, b)
+    if y == 0 {
+        h[0] = x
+        return 1
+    }
+    h[0], h[1] = y, x
+    return 2
+}
+
+// h = e + b (h may alias e; needs len(e) + 1 slots)
+@(private="file")
+grow_expansion :: proc(e: []f64, b: f64, h: []f64) -> int {
+    q := b
+    n := 0
+    for enow in e {
+        hh: f64
+        q, hh = two_sum(q, enow)
+        if hh != 0 {
+            h[n] = hh
+            n += 1
+        }
+    }
+    if q != 0 || n == 0 {
+        h[n] = q
+        n += 1
+    }
+    return n
+}
+
+// h = e + f (needs len(e) + len(f) slots; h must not alias f)
+@(private="file")
+exp_sum :: proc(e, f: []f64, h: []f64) -> int {
+    copy(h, e)
+    n := len(e)
+    for fnow in f {
+        n = grow_expansion(h[:n], fnow, h)
+    }
+    return n
+}
+
+// h = e * b (needs 2 * len(e) slots)
+@(private="file")
+scale_expansion :: proc(e: []f64, b: f64, h: []f64) -> int {
+    q, hh := two_product(e[0], b)
+    n := 0
+    if hh != 0 {
+        h[n] = hh
+        n += 1
+    }
+    for i in 1..<len(e) {
+        p1, p0 := two_product(e[i], b)
+        sum: f64
+        sum, hh = two_sum(q, p0)
+        if hh != 0 {
+            h[n] = hh
+            n += 1
+        }
+        q, hh = fast_two_sum(p1, sum)
+        if hh != 0 {
+            h[n] = hh
+            n += 1
+        }
+    }
+    if q != 0 || n == 0 {
+        h[n] = q
+        n += 1
+    }
+    return n
+}
+
+// h = e * f (h needs 2 * len(e) * len(f) slots, scratch that plus 2 * len(e))
+@(private="file")
+exp_product :: proc(e, f: []f64, h, scratch: []f64) -> int {
+    h[0] = 0
+    n := 1
+    for fnow in f {
+        k := scale_expansion(e, fnow, scratch)
+        copy(scratch[k:], h[:n])
+        n = exp_sum(scratch[k:k + n], scratch[:k], h)
+    }
+    return n
+}
+
+@(private="file")
+exp_negate :: proc(e: []f64) {
+    for &c in e {
+        c = -c
+    }
+}
+
+// Most significant non-zero component (exact sign)
+@(private="file")
+exp_sign_value :: proc(e: []f64) -> f64 {
+    for i := len(e) - 1; i >= 0; i -= 1 {
+        if e[i] != 0 do return e[i]
+    }
+    return 0
+}
+
+// e1*f1 - e2*f2 for 2-component operands (≤ 16 components)
+@(private="file")
+exp_cross :: proc(e1, f1, e2, f2: []f64, h: []f64) -> int {
+    p1, p2, scratch: [16]f64
+    n1 := exp_product(e1, f1, p1[:], scratch[:])
+    n2 := exp_product(e2, f2, p2[:], scratch[:])
+    exp_negate(p2[:n2])
+    return exp_sum(p1[:n1], p2[:n2], h)
+}
+
+@(private="file")
+orient2d_exact :: proc(a, b, c: Vec2) -> f64 {
+    acx, acy, bcx, bcy: [2]f64
+    nacx := exp_diff(a.x, c.x, acx[:])
+    nacy := exp_diff(a.y, c.y, acy[:])
+    nbcx := exp_diff(b.x, c.x, bcx[:])
+    nbcy := exp_diff(b.y, c.y, bcy[:])
+
+    det: [16]f64
+    n := exp_cross(acx[:nacx], bcy[:nbcy], acy[:nacy], bcx[:nbcx], det[:])
+    return exp_sign_value(det[:n])
+}
+
+@(private="file")
+orient3d_exact :: proc(a, b, c, d: Vec3) -> f64 {
+    ad, bd, cd: [3][2]f64
+    nad, nbd, ncd: [3]int
+    for k in 0..<3 {
+        nad[k] = exp_diff(a[k], d[k], ad[k][:])
+        nbd[k] = exp_diff(b[k], d[k], bd[k][:])
+        ncd[k] = exp_diff(c[k], d[k], cd[k][:])
+    }
+
+    // Minors of the x/y columns
+    bc, ca, ab: [16]f64
+    nbc := exp_cross(bd[0][:nbd[0]], cd[1][:ncd[1]], cd[0][:ncd[0]], bd[1][:nbd[1]], bc[:])
+    nca := exp_cross(cd[0][:ncd[0]], ad[1][:nad[1]], ad[0][:nad[0]], cd[1][:ncd[1]], ca[:])
+    nab := exp_cross(ad[0][:nad[0]], bd[1][:nbd[1]], bd[0][:nbd[0]], ad[1][:nad[1]], ab[:])
+
+    t1, t2, t3: [64]f64
+    scratch: [128]f64
+    n1 := exp_product(bc[:nbc], ad[2][:nad[2]], t1[:], scratch[:])
+    n2 := exp_product(ca[:nca], bd[2][:nbd[2]], t2[:], scratch[:])
+    n3 := exp_product(ab[:nab], cd[2][:ncd[2]], t3[:], scratch[:])
+
+    s12: [128]f64
+    det: [192]f64
+    n12 := exp_sum(t1[:n1], t2[:n2], s12[:])
+    n := exp_sum(s12[:n12], t3[:n3], det[:])
+    return exp_sign_value(det[:n])
+}
+
+@(private="file")
+incircle_exact :: proc(a, b, c, d: Vec2) -> f64 {
+    ad, bd, cd: [2][2]f64
+    nad, nbd, ncd: [2]int
+    for k in 0..<2 {
+        nad[k] = exp_diff(a[k], d[k], ad[k][:])
+        nbd[k] = exp_diff(b[k], d[k], bd[k][:])
+        ncd[k] = exp_diff(c[k], d[k], cd[k][:])
+    }
+
+    // Lifted coordinates |p - d|^2 (≤ 16 components)
+    lift :: proc(px, py: []f64, h: []f64) -> int {
+        xx, yy: [8]f64
+        scratch: [16]f64
+        nx := exp_product(px, px, xx[:], scratch[:])
+        ny := exp_product(py, py, yy[:], scratch[:])
+        return exp_sum(xx[:nx], yy[:ny], h)
+    }
+
+    alift, blift, clift: [16]f64
+    nal := lift(ad[0][:nad[0]], ad[1][:nad[1]], alift[:])
+    nbl := lift(bd[0][:nbd[0]], bd[1][:nbd[1]], blift[:])
+    ncl := lift(cd[0][:ncd[0]], cd[1][:ncd[1]], clift[:])
+
+    bc, ca, ab: [16]f64
+    nbc := exp_cross(bd[0][:nbd[0]], cd[1][:ncd[1]], cd[0][:ncd[0]], bd[1][:nbd[1]], bc[:])
+    nca := exp_cross(cd[0][:ncd[0]], ad[1][:nad[1]], ad[0][:nad[0]], cd[1][:ncd[1]], ca[:])
+    nab := exp_cross(ad[0][:nad[0]], bd[1][:nbd[1]], bd[0][:nbd[0]], ad[1][:nad[1]], ab[:])
+
+    t1, t2, t3: [512]f64
+    scratch: [1024]f64
+    n1 := exp_product(alift[:nal], bc[:nbc], t1[:], scratch[:])
+    n2 := exp_product(blift[:nbl], ca[:nca], t2[:], scratch[:])
+    n3 := exp_product(clift[:ncl], ab[:nab], t3[:], scratch[:])
+
+    s12: [1024]f64
+    det: [1536]f64
+    n12 := exp_sum(t1[:n1], t2[:n2], s12[:])
+    n := exp_sum(s12[:n12], t3[:n3], det[:])
+    return exp_sign_value(det[:n])
+}
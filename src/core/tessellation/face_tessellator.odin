@@ -1,9 +1,8 @@
 // core/tessellation/face_tessellator.odin
-// Tessellates SimpleFace polygons into triangles using libtess2
+// Tessellates SimpleFace polygons into triangles (fast paths, libtess2 for complex faces)
 package tessellation
 
 import "core:fmt"
-import "core:c"
 import m "../../core/math"
 
 // Intermediate triangle structure (to avoid circular dependency with extrude.odin)
@@ -15,8 +14,24 @@ FaceTri :: struct {
 
 // Tessellate a face (list of 3D vertices) into triangles
 // Returns array of FaceTri which can be converted to Triangle3D by caller
+// Convex and simple faces take the fast paths in polygon_triangulate.odin; only
+// self-intersecting or very large faces reach libtess2
 tessellate_face :: proc(vertices: []m.Vec3, face_normal: m.Vec3, face_id: int) -> [dynamic]FaceTri {
-    triangles := make([dynamic]FaceTri, 0, len(vertices))
+    return tessellate_face_with_path(vertices, face_normal, face_id, .Auto)
+}
+
+// Tessellate complex polygon using libtess2 (forces the sweep path)
+tessellate_polygon_3d :: proc(vertices: []m.Vec3, face_normal: m.Vec3, face_id: int) -> [dynamic]FaceTri {
+    return tessellate_face_with_path(vertices, face_normal, face_id, .Sweep)
+}
+
+tessellate_face_with_path :: proc(
+    vertices: []m.Vec3,
+    face_normal: m.Vec3,
+    face_id: int,
+    path: TriangulatePath,
+) -> [dynamic]FaceTri {
+    triangles := make([dynamic]FaceTri, 0, max(len(vertices) - 2, 1))
 
     if len(vertices) < 3 {
         fmt.println("Error: Face must have at least 3 vertices")
@@ -25,150 +40,80 @@ tessellate_face :: proc(vertices: []m.Vec3, face_normal: m.Vec3, face_id: int) -
 
     // Special case: Triangle - no tessellation needed
     if len(vertices) == 3 {
-        tri := FaceTri {
+        append(&triangles, FaceTri{
             v0 = vertices[0],
             v1 = vertices[1],
             v2 = vertices[2],
             normal = face_normal,
             face_id = face_id,
-        }
-        append(&triangles, tri)
+        })
         return triangles
     }
 
-    // Special case: Quad - split into 2 triangles
-    if len(vertices) == 4 {
-        // Triangle 1: v0, v1, v2
-        tri1 := FaceTri {
-            v0 = vertices[0],
-            v1 = vertices[1],
-            v2 = vertices[2],
-            normal = face_normal,
-            face_id = face_id,
-        }
-        append(&triangles, tri1)
-
-        // Triangle 2: v0, v2, v3
-        tri2 := FaceTri {
-            v0 = vertices[0],
-            v1 = vertices[2],
-            v2 = vertices[3],
-            normal = face_normal,
-            face_id = face_id,
-        }
-        append(&triangles, tri2)
-
-        return triangles
+    drop_axis := dominant_axis(face_normal)
+    points_2d := make([]m.Vec2, len(vertices))
+    defer delete(points_2d)
+    for v, i in vertices {
+        points_2d[i] = drop_component(v, drop_axis)
     }
 
-    // Complex polygon: Use libtess2
-    triangles_from_libtess2 := tessellate_polygon_3d(vertices, face_normal, face_id)
-    return triangles_from_libtess2
-}
-
-// Tessellate complex polygon using libtess2
-tessellate_polygon_3d :: proc(vertices: []m.Vec3, face_normal: m.Vec3, face_id: int) -> [dynamic]FaceTri {
-    triangles := make([dynamic]FaceTri, 0, len(vertices))
+    result := triangulate_polygon_2d(points_2d, nil, path)
+    defer triangulation_destroy(&result)
 
-    // Create tesselator
-    tess := NewTess(nil)
-    if tess == nil {
-        fmt.println("Error: Failed to create tesselator")
-        return triangles
-    }
-    defer DeleteTess(tess)
-
-    // Project 3D polygon to 2D plane for tessellation
-    vertices_2d := project_vertices_to_2d(vertices, face_normal)
-    defer delete(vertices_2d)
-
-    // Add contour to tesselator
-    AddContour(tess, 2, &vertices_2d[0], size_of(TESSreal) * 2, c.int(len(vertices_2d) / 2))
-
-    // Check status
-    status := GetStatus(tess)
-    if status != .OK {
-        fmt.println("Error: Failed to add contour, status:", status)
-        return triangles
-    }
-
-    // Tesselate into triangles
-    result := Tesselate(tess,
-        c.int(TessWindingRule.NONZERO),   // NONZERO winding rule
-        c.int(TessElementType.POLYGONS),  // Output polygons (triangles)
-        3,                                 // polySize = 3 (triangles)
-        2,                                 // vertexSize = 2D
-        nil)                              // auto-calculate normal
-
-    if result == 0 {
-        fmt.println("Error: Tessellation failed")
-        return triangles
-    }
-
-    // Get tessellation results
-    tri_count := GetElementCount(tess)
-    elements := GetElements(tess)
-
-    if elements == nil {
-        fmt.println("Error: No triangles generated")
-        return triangles
+    // Map indices back to 3D (new libtess2 vertices are lifted onto the face plane)
+    corner :: proc(vertices: []m.Vec3, result: ^Triangulation, index, drop_axis: int, normal: m.Vec3) -> m.Vec3 {
+        if index < len(vertices) {
+            return vertices[index]
+        }
+        return lift_to_plane(result.extra_points[index - len(vertices)], drop_axis, vertices[0], normal)
     }
 
-    // Build FaceTri from tessellation results
-    for i in 0..<tri_count {
-        idx0 := elements[i * 3 + 0]
-        idx1 := elements[i * 3 + 1]
-        idx2 := elements[i * 3 + 2]
-
-        // Map back to 3D vertices
-        if idx0 >= 0 && idx0 < c.int(len(vertices)) &&
-           idx1 >= 0 && idx1 < c.int(len(vertices)) &&
-           idx2 >= 0 && idx2 < c.int(len(vertices)) {
-
-            tri := FaceTri {
-                v0 = vertices[idx0],
-                v1 = vertices[idx1],
-                v2 = vertices[idx2],
-                normal = face_normal,
-                face_id = face_id,
-            }
-            append(&triangles, tri)
-        }
+    for t in result.triangles {
+        append(&triangles, FaceTri{
+            v0 = corner(vertices, &result, t[0], drop_axis, face_normal),
+            v1 = corner(vertices, &result, t[1], drop_axis, face_normal),
+            v2 = corner(vertices, &result, t[2], drop_axis, face_normal),
+            normal = face_normal,
+            face_id = face_id,
+        })
     }
 
     return triangles
 }
 
-// Project 3D vertices to 2D plane for tessellation
-// Returns flat array of 2D coordinates: [x0, y0, x1, y1, ...]
-project_vertices_to_2d :: proc(vertices: []m.Vec3, normal: m.Vec3) -> [dynamic]TESSreal {
-    coords := make([dynamic]TESSreal, 0, len(vertices) * 2)
-
-    // Choose projection plane based on dominant normal component
+// Axis with the largest normal component (dropped when projecting to 2D)
+@(private="file")
+dominant_axis :: proc(normal: m.Vec3) -> int {
     abs_x := abs(normal.x)
     abs_y := abs(normal.y)
     abs_z := abs(normal.z)
 
-    // Project onto plane with largest normal component
-    if abs_z >= abs_x && abs_z >= abs_y {
-        // XY plane (drop Z)
-        for v in vertices {
-            append(&coords, TESSreal(v.x))
-            append(&coords, TESSreal(v.y))
-        }
-    } else if abs_x >= abs_y && abs_x >= abs_z {
-        // YZ plane (drop X)
-        for v in vertices {
-            append(&coords, TESSreal(v.y))
-            append(&coords, TESSreal(v.z))
-        }
-    } else {
-        // XZ plane (drop Y)
-        for v in vertices {
-            append(&coords, TESSreal(v.x))
-            append(&coords, TESSreal(v.z))
-        }
+    if abs_z >= abs_x && abs_z >= abs_y do return 2
+    if abs_x >= abs_y do return 0
+    return 1
+}
+
+@(private="file")
+drop_component :: proc(v: m.Vec3, drop_axis: int) -> m.Vec2 {
+    switch drop_axis {
+    case 0: return m.Vec2{v.y, v.z}
+    case 1: return m.Vec2{v.x, v.z}
     }
+    return m.Vec2{v.x, v.y}
+}
 
-    return coords
+// Inverse of drop_component for a point on the plane (origin, normal)
+@(private="file")
+lift_to_plane :: proc(p: m.Vec2, drop_axis: int, origin, normal: m.Vec3) -> m.Vec3 {
+    // Solve normal · (v - origin) = 0 for the dropped coordinate
+    switch drop_axis {
+    case 0:
+        x := origin.x - (normal.y * (p.x - origin.y) + normal.z * (p.y - origin.z)) / normal.x
+        return m.Vec3{x, p.x, p.y}
+    case 1:
+        y := origin.y - (normal.x * (p.x - origin.x) + normal.z * (p.y - origin.z)) / normal.y
+        return m.Vec3{p.x, y, p.y}
+    }
+    z := origin.z - (normal.x * (p.x - origin.x) + normal.y * (p.y - origin.y)) / normal.z
+    return m.Vec3{p.x, p.y, z}
 }
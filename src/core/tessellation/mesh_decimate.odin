@@ -0,0 +1,700 @@
+// core/tessellation/mesh_decimate.odin
+// Quadric-error-metric (Garland-Heckbert) decimation for indexed triangle meshes
+// Used for mesh-only bodies (no exact B-Rep) - display LODs and STL export budgets
+package tessellation
+
+import "core:container/priority_queue"
+import "core:math"
+import glsl "core:math/linalg/glsl"
+import "core:os"
+import "core:slice"
+import "core:thread"
+import m "../../core/math"
+
+// Indexed triangle mesh with per-triangle source face id
+IndexedMesh :: struct {
+    positions: [dynamic]m.Vec3,
+    triangles: [dynamic][3]int,
+    face_ids: [dynamic]int,      // Boundaries between different ids are preserved
+}
+
+// Decimation parameters
+// At least one of target_triangles / max_error should be set
+DecimateParams :: struct {
+    target_triangles: int,   // Stop at this many triangles (0 = error-driven only)
+    max_error: f64,          // Stop before any collapse that moves the surface more than this (0 = no limit)
+    feature_angle: f64,      // Dihedral angle (degrees) above which an edge is kept as a feature edge
+    partitions: int,         // Spatial partitions decimated in parallel (0 = one per core, 1 = serial)
+}
+
+DEFAULT_DECIMATE :: DecimateParams{
+    target_triangles = 0,
+    max_error = 0,
+    feature_angle = 30.0,
+    partitions = 0,
+}
+
+// Meshes smaller than this are decimated serially (thread startup costs more than it saves)
+DECIMATE_PARALLEL_MIN_TRIANGLES :: 20_000
+
+DecimateStats :: struct {
+    triangles_before: int,
+    triangles_after: int,
+    vertices_before: int,
+    vertices_after: int,
+    max_error: f64,          // Upper bound on surface deviation of the applied collapses
+}
+
+// =============================================================================
+// Indexed Mesh Helpers
+// =============================================================================
+
+// Build an indexed mesh from a triangle soup, welding vertices closer than weld_tolerance
+indexed_mesh_from_tris :: proc(tris: []FaceTri, weld_tolerance: f64 = 1e-6) -> IndexedMesh {
+    mesh := IndexedMesh{
+        positions = make([dynamic]m.Vec3, 0, len(tris) / 2 + 3),
+        triangles = make([dynamic][3]int, 0, len(tris)),
+        face_ids = make([dynamic]int, 0, len(tris)),
+    }
+
+    lookup := make(map[[3]i64]int, len(tris) / 2 + 3)
+    defer delete(lookup)
+
+    inv := 1.0 / weld_tolerance
+    weld :: proc(mesh: ^IndexedMesh, lookup: ^map[[3]i64]int, p: m.Vec3, inv: f64) -> int {
+        key := [3]i64{i64(math.round(p.x * inv)), i64(math.round(p.y * inv)), i64(math.round(p.z * inv))}
+        if idx, found := lookup[key]; found {
+            return idx
+        }
+        idx := len(mesh.positions)
+        append(&mesh.positions, p)
+        lookup[key] = idx
+        return idx
+    }
+
+    for tri in tris {
+        a := weld(&mesh, &lookup, tri.v0, inv)
+        b := weld(&mesh, &lookup, tri.v1, inv)
+        c := weld(&mesh, &lookup, tri.v2, inv)
+        if a == b || b == c || a == c do continue  // Degenerate after welding
+
+        append(&mesh.triangles, [3]int{a, b, c})
+        append(&mesh.face_ids, tri.face_id)
+    }
+
+    return mesh
+}
+
+// Convert an indexed mesh back to a triangle soup with flat normals
+indexed_mesh_to_tris :: proc(mesh: ^IndexedMesh) -> [dynamic]FaceTri {
+    tris := make([dynamic]FaceTri, 0, len(mesh.triangles))
+
+    for tri, i in mesh.triangles {
+        p0 := mesh.positions[tri[0]]
+        p1 := mesh.positions[tri[1]]
+        p2 := mesh.positions[tri[2]]
+
+        append(&tris, FaceTri{
+            v0 = p0,
+            v1 = p1,
+            v2 = p2,
+            normal = triangle_normal(p0, p1, p2),
+            face_id = mesh.face_ids[i],
+        })
+    }
+
+    return tris
+}
+
+indexed_mesh_destroy :: proc(mesh: ^IndexedMesh) {
+    delete(mesh.positions)
+    delete(mesh.triangles)
+    delete(mesh.face_ids)
+}
+
+// =============================================================================
+// Decimation
+// =============================================================================
+
+// Decimate mesh in place with half-edge collapses ordered by quadric error
+// Mesh boundaries, boundaries between face_ids and edges sharper than feature_angle are
+// only collapsed along themselves; their corners never move.
+decimate_mesh :: proc(mesh: ^IndexedMesh, params: DecimateParams = DEFAULT_DECIMATE) -> DecimateStats {
+    stats := DecimateStats{
+        triangles_before = len(mesh.triangles),
+        vertices_before = len(mesh.positions),
+    }
+
+    target := max(params.target_triangles, 0)
+    if len(mesh.triangles) == 0 || (target == 0 && params.max_error <= 0) || target >= len(mesh.triangles) {
+        stats.triangles_after = stats.triangles_before
+        stats.vertices_after = stats.vertices_before
+        return stats
+    }
+
+    d: Decimator
+    decimator_init(&d, mesh, params)
+    defer decimator_destroy(&d)
+
+    max_cost := params.max_error > 0 ? params.max_error * params.max_error : math.INF_F64
+
+    // Phase 1: independent spatial partitions in parallel
+    partitions := params.partitions
+    if partitions <= 0 {
+        partitions = os.processor_core_count()
+    }
+    if len(mesh.triangles) < DECIMATE_PARALLEL_MIN_TRIANGLES {
+        partitions = 1
+    }
+
+    if partitions > 1 {
+        assign_partitions(&d, partitions)
+        ratio := target > 0 ? f64(target) / f64(len(mesh.triangles)) : 0.0
+
+        // Count triangles fully inside each partition to split the target
+        tris_in := make([]int, partitions)
+        defer delete(tris_in)
+        for tri in mesh.triangles {
+            p := d.partition[tri[0]]
+            if d.partition[tri[1]] == p && d.partition[tri[2]] == p {
+                tris_in[p] += 1
+            }
+        }
+
+        workers := make([]Worker, partitions)
+        defer delete(workers)
+
+        pool: thread.Pool
+        thread.pool_init(&pool, context.allocator, partitions)
+        for &w, p in workers {
+            remove := max(int)
+            if target > 0 {
+                remove = tris_in[p] - int(f64(tris_in[p]) * ratio)
+            }
+            worker_init(&w, &d, p, remove, max_cost)
+            thread.pool_add_task(&pool, context.allocator, decimate_task, &w, p)
+        }
+        thread.pool_start(&pool)
+        thread.pool_finish(&pool)
+        thread.pool_destroy(&pool)
+
+        for &w in workers {
+            stats.max_error = max(stats.max_error, w.max_applied)
+            d.alive_tris -= w.removed
+            worker_destroy(&w)
+        }
+    }
+
+    // Phase 2: serial pass over the whole mesh (partition seams, remaining budget)
+    remove := max(int)
+    if target > 0 {
+        remove = d.alive_tris - target
+    }
+    if remove > 0 {
+        w: Worker
+        worker_init(&w, &d, -1, remove, max_cost)
+        worker_run(&w)
+        stats.max_error = max(stats.max_error, w.max_applied)
+        d.alive_tris -= w.removed
+        worker_destroy(&w)
+    }
+
+    compact_mesh(&d)
+    stats.max_error = math.sqrt(stats.max_error)
+    stats.triangles_after = len(mesh.triangles)
+    stats.vertices_after = len(mesh.positions)
+    return stats
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+// Symmetric 4x4 quadric: a2 ab ac ad b2 bc bd c2 cd d2
+@(private="file")
+Quadric :: [10]f64
+
+@(private="file")
+VertexClass :: enum u8 {
+    Free,    // Interior of a single face - may collapse into any neighbor
+    Crease,  // On exactly one boundary/feature line - may only slide along it
+    Locked,  // Corner of boundary/feature lines (or where one turns sharply) - never moves
+}
+
+@(private="file")
+Candidate :: struct {
+    cost: f64,
+    u, v: int,     // Collapse u onto v
+    stamp: u32,    // stamp[u] when computed (lazy invalidation)
+}
+
+@(private="file")
+Decimator :: struct {
+    mesh: ^IndexedMesh,
+    quadrics: []Quadric,
+    vert_tris: [][dynamic]int,   // Live triangles incident to each vertex
+    vert_class: []VertexClass,
+    crease_nbrs: [][2]int,       // The two crease-line neighbors of Crease vertices
+    vert_alive: []bool,
+    tri_alive: []bool,
+    stamp: []u32,
+    partition: []int,            // Partition per vertex (all 0 when serial)
+    alive_tris: int,
+}
+
+// Per-thread state; only touches vertices whose whole neighborhood is in its partition
+@(private="file")
+Worker :: struct {
+    d: ^Decimator,
+    partition: int,        // -1 = whole mesh
+    remove_target: int,    // Triangles to remove before stopping
+    max_cost: f64,         // Squared error limit
+    removed: int,
+    max_applied: f64,
+    queue: priority_queue.Priority_Queue(Candidate),
+    ring_u: [dynamic]int,
+    ring_v: [dynamic]int,
+    affected: [dynamic]int,
+}
+
+@(private="file")
+triangle_normal :: proc(p0, p1, p2: m.Vec3) -> m.Vec3 {
+    n := glsl.cross(p1 - p0, p2 - p0)
+    n_len := glsl.length(n)
+    if n_len < 1e-300 do return m.Vec3{0, 0, 0}
+    return n / n_len
+}
+
+@(private="file")
+quadric_from_plane :: proc(n: m.Vec3, d: f64) -> Quadric {
+    a, b, c := n.x, n.y, n.z
+    return Quadric{a*a, a*b, a*c, a*d, b*b, b*c, b*d, c*c, c*d, d*d}
+}
+
+@(private="file")
+quadric_eval :: proc(q: Quadric, p: m.Vec3) -> f64 {
+    x, y, z := p.x, p.y, p.z
+    return q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x +
+           q[4]*y*y + 2*q[5]*y*z + 2*q[6]*y +
+           q[7]*z*z + 2*q[8]*z +
+           q[9]
+}
+
+@(private="file")
+decimator_init :: proc(d: ^Decimator, mesh: ^IndexedMesh, params: DecimateParams) {
+    nv := len(mesh.positions)
+    nt := len(mesh.triangles)
+
+    d.mesh = mesh
+    d.quadrics = make([]Quadric, nv)
+    d.vert_tris = make([][dynamic]int, nv)
+    d.vert_class = make([]VertexClass, nv)
+    d.crease_nbrs = make([][2]int, nv)
+    d.vert_alive = make([]bool, nv)
+    d.tri_alive = make([]bool, nt)
+    d.stamp = make([]u32, nv)
+    d.partition = make([]int, nv)
+    d.alive_tris = nt
+
+    normals := make([]m.Vec3, nt)
+    defer delete(normals)
+
+    // Plane quadrics (unweighted, so cost is a bound on squared distance)
+    for tri, t in mesh.triangles {
+        p0 := mesh.positions[tri[0]]
+        n := triangle_normal(p0, mesh.positions[tri[1]], mesh.positions[tri[2]])
+        normals[t] = n
+        q := quadric_from_plane(n, -glsl.dot(n, p0))
+
+        for k in 0..<3 {
+            d.quadrics[tri[k]] += q
+            append(&d.vert_tris[tri[k]], t)
+            d.vert_alive[tri[k]] = true
+        }
+        d.tri_alive[t] = true
+    }
+
+    // Edge adjacency: first triangle, second triangle, use count
+    EdgeInfo :: struct { t0, t1, count: int }
+    edges := make(map[[2]int]EdgeInfo, nt * 2)
+    defer delete(edges)
+
+    for tri, t in mesh.triangles {
+        for k in 0..<3 {
+            a, b := tri[k], tri[(k + 1) % 3]
+            key := a < b ? [2]int{a, b} : [2]int{b, a}
+            info := edges[key] or_else EdgeInfo{t0 = t, t1 = -1}
+            if info.count == 1 do info.t1 = t
+            info.count += 1
+            edges[key] = info
+        }
+    }
+
+    // Classify crease edges and add perpendicular constraint planes so collapses keep them in place
+    cos_feature := math.cos(math.to_radians(params.feature_angle))
+    crease_count := make([]int, nv)
+    defer delete(crease_count)
+
+    for key, info in edges {
+        crease := false
+        switch {
+        case info.count != 2:
+            crease = true
+            if info.count > 2 {
+                // Non-manifold edge - pin both ends
+                d.vert_class[key[0]] = .Locked
+                d.vert_class[key[1]] = .Locked
+            }
+        case mesh.face_ids[info.t0] != mesh.face_ids[info.t1]:
+            crease = true
+        case glsl.dot(normals[info.t0], normals[info.t1]) < cos_feature:
+            crease = true
+        }
+        if !crease do continue
+
+        a, b := key[0], key[1]
+        for c in 0..<2 {
+            x := c == 0 ? a : b
+            if crease_count[x] < 2 {
+                d.crease_nbrs[x][crease_count[x]] = c == 0 ? b : a
+            }
+            crease_count[x] += 1
+        }
+
+        pa := mesh.positions[a]
+        e := mesh.positions[b] - pa
+        n := glsl.cross(e, normals[info.t0])
+        n_len := glsl.length(n)
+        if n_len > 1e-300 {
+            n /= n_len
+            q := quadric_from_plane(n, -glsl.dot(n, pa))
+            d.quadrics[a] += q
+            d.quadrics[b] += q
+        }
+    }
+
+    for x in 0..<nv {
+        if d.vert_class[x] == .Locked do continue
+        switch crease_count[x] {
+        case 0: d.vert_class[x] = .Free
+        case 2: d.vert_class[x] = crease_turns(mesh, x, d.crease_nbrs[x], cos_feature) ? .Locked : .Crease
+        case:   d.vert_class[x] = .Locked
+        }
+    }
+}
+
+// True if the crease line through x turns by more than the feature angle there
+// (an L-shaped corner of a face boundary); gently curved lines such as tessellated circles
+// stay slidable.
+@(private="file")
+crease_turns :: proc(mesh: ^IndexedMesh, x: int, nbrs: [2]int, cos_feature: f64) -> bool {
+    incoming := mesh.positions[x] - mesh.positions[nbrs[0]]
+    outgoing := mesh.positions[nbrs[1]] - mesh.positions[x]
+    len_in, len_out := glsl.length(incoming), glsl.length(outgoing)
+    if len_in < 1e-300 || len_out < 1e-300 do return true
+    return glsl.dot(incoming, outgoing) / (len_in * len_out) < cos_feature
+}
+
+@(private="file")
+decimator_destroy :: proc(d: ^Decimator) {
+    for &list in d.vert_tris {
+        delete(list)
+    }
+    delete(d.vert_tris)
+    delete(d.quadrics)
+    delete(d.vert_class)
+    delete(d.crease_nbrs)
+    delete(d.vert_alive)
+    delete(d.tri_alive)
+    delete(d.stamp)
+    delete(d.partition)
+}
+
+// Split vertices into equal-count slabs along the longest bounding-box axis
+@(private="file")
+assign_partitions :: proc(d: ^Decimator, count: int) {
+    positions := d.mesh.positions[:]
+    lo, hi := positions[0], positions[0]
+    for p in positions {
+        lo = m.Vec3{min(lo.x, p.x), min(lo.y, p.y), min(lo.z, p.z)}
+        hi = m.Vec3{max(hi.x, p.x), max(hi.y, p.y), max(hi.z, p.z)}
+    }
+    size := hi - lo
+    axis := 0
+    if size.y > size[axis] do axis = 1
+    if size.z > size[axis] do axis = 2
+
+    coords := make([]f64, len(positions))
+    defer delete(coords)
+    for p, i in positions {
+        coords[i] = p[axis]
+    }
+    slice.sort(coords)
+
+    bounds := make([]f64, count - 1)
+    defer delete(bounds)
+    for i in 0..<count - 1 {
+        bounds[i] = coords[(i + 1) * len(coords) / count]
+    }
+
+    for p, i in positions {
+        part := 0
+        for part < count - 1 && p[axis] >= bounds[part] {
+            part += 1
+        }
+        d.partition[i] = part
+    }
+}
+
+@(private="file")
+worker_init :: proc(w: ^Worker, d: ^Decimator, partition: int, remove_target: int, max_cost: f64) {
+    w^ = Worker{
+        d = d,
+        partition = partition,
+        remove_target = remove_target,
+        max_cost = max_cost,
+    }
+    priority_queue.init(
+        &w.queue,
+        proc(a, b: Candidate) -> bool { return a.cost < b.cost },
+        priority_queue.default_swap_proc(Candidate),
+    )
+}
+
+@(private="file")
+worker_destroy :: proc(w: ^Worker) {
+    priority_queue.destroy(&w.queue)
+    delete(w.ring_u)
+    delete(w.ring_v)
+    delete(w.affected)
+}
+
+@(private="file")
+decimate_task :: proc(task: thread.Task) {
+    worker_run((^Worker)(task.data))
+}
+
+@(private="file")
+in_partition :: #force_inline proc(w: ^Worker, x: int) -> bool {
+    return w.partition < 0 || w.d.partition[x] == w.partition
+}
+
+// Unique vertices sharing a live triangle with x
+@(private="file")
+gather_ring :: proc(d: ^Decimator, x: int, ring: ^[dynamic]int) {
+    clear(ring)
+    for t in d.vert_tris[x] {
+        for y in d.mesh.triangles[t] {
+            if y != x && !slice.contains(ring[:], y) {
+                append(ring, y)
+            }
+        }
+    }
+}
+
+// Check that collapsing u onto v is legal; returns its cost
+@(private="file")
+collapse_cost :: proc(w: ^Worker, u, v: int) -> (cost: f64, ok: bool) {
+    d := w.d
+
+    switch d.vert_class[u] {
+    case .Locked:
+        return 0, false
+    case .Crease:
+        if v != d.crease_nbrs[u][0] && v != d.crease_nbrs[u][1] do return 0, false
+    case .Free:
+    }
+    if !in_partition(w, v) do return 0, false
+
+    // Every triangle touched (u's and v's) must belong to this worker's partition
+    if w.partition >= 0 {
+        for x in ([2]int{u, v}) {
+            for t in d.vert_tris[x] {
+                for y in d.mesh.triangles[t] {
+                    if !in_partition(w, y) do return 0, false
+                }
+            }
+        }
+    }
+
+    // Link condition: u and v may share only the vertices opposite their common edge
+    gather_ring(d, v, &w.ring_v)
+    shared := 0
+    for t in d.vert_tris[u] {
+        tri := d.mesh.triangles[t]
+        if tri[0] == v || tri[1] == v || tri[2] == v do shared += 1
+    }
+    if shared == 0 || shared > 2 do return 0, false
+
+    common := 0
+    for y in w.ring_u {
+        if y != v && slice.contains(w.ring_v[:], y) do common += 1
+    }
+    if common != shared do return 0, false
+
+    // Reject collapses that flip or degenerate any surviving triangle
+    pv := d.mesh.positions[v]
+    for t in d.vert_tris[u] {
+        tri := d.mesh.triangles[t]
+        if tri[0] == v || tri[1] == v || tri[2] == v do continue
+
+        p: [3]m.Vec3
+        for k in 0..<3 {
+            p[k] = d.mesh.positions[tri[k]]
+        }
+        n_old := triangle_normal(p[0], p[1], p[2])
+        for k in 0..<3 {
+            if tri[k] == u do p[k] = pv
+        }
+        n_new := triangle_normal(p[0], p[1], p[2])
+        if glsl.dot(n_old, n_new) < 0.2 do return 0, false
+    }
+
+    return quadric_eval(d.quadrics[u] + d.quadrics[v], pv), true
+}
+
+// Cheapest legal collapse of u (u's ring is left in w.ring_u)
+@(private="file")
+best_collapse :: proc(w: ^Worker, u: int) -> (Candidate, bool) {
+    d := w.d
+    best := Candidate{cost = math.INF_F64, u = u, v = -1, stamp = d.stamp[u]}
+    if !d.vert_alive[u] || d.vert_class[u] == .Locked || !in_partition(w, u) {
+        return best, false
+    }
+
+    gather_ring(d, u, &w.ring_u)
+    for v in w.ring_u {
+        if cost, ok := collapse_cost(w, u, v); ok && cost < best.cost {
+            best.cost = cost
+            best.v = v
+        }
+    }
+    return best, best.v >= 0
+}
+
+@(private="file")
+push_best :: proc(w: ^Worker, u: int) {
+    if c, ok := best_collapse(w, u); ok {
+        priority_queue.push(&w.queue, c)
+    }
+}
+
+@(private="file")
+remove_tri_from_vertex :: proc(d: ^Decimator, x: int, t: int) {
+    list := &d.vert_tris[x]
+    for i in 0..<len(list) {
+        if list[i] == t {
+            unordered_remove(list, i)
+            return
+        }
+    }
+}
+
+@(private="file")
+apply_collapse :: proc(w: ^Worker, u, v: int) {
+    d := w.d
+
+    for t in d.vert_tris[u] {
+        tri := &d.mesh.triangles[t]
+        if tri[0] == v || tri[1] == v || tri[2] == v {
+            // Triangle on the collapsed edge disappears
+            d.tri_alive[t] = false
+            for y in tri^ {
+                if y != u do remove_tri_from_vertex(d, y, t)
+            }
+            w.removed += 1
+        } else {
+            for k in 0..<3 {
+                if tri[k] == u do tri[k] = v
+            }
+            append(&d.vert_tris[v], t)
+        }
+    }
+    clear(&d.vert_tris[u])
+    d.vert_alive[u] = false
+    d.quadrics[v] += d.quadrics[u]
+
+    // Keep crease lines connected: u's other crease neighbor now links to v
+    if d.vert_class[u] == .Crease {
+        other := d.crease_nbrs[u][0] == v ? d.crease_nbrs[u][1] : d.crease_nbrs[u][0]
+        if d.vert_class[v] == .Crease {
+            for &nb in d.crease_nbrs[v] {
+                if nb == u do nb = other
+            }
+        }
+        if d.vert_class[other] == .Crease {
+            for &nb in d.crease_nbrs[other] {
+                if nb == u do nb = v
+            }
+        }
+    }
+}
+
+@(private="file")
+worker_run :: proc(w: ^Worker) {
+    d := w.d
+
+    for u in 0..<len(d.mesh.positions) {
+        push_best(w, u)
+    }
+
+    for w.removed < w.remove_target && priority_queue.len(w.queue) > 0 {
+        c := priority_queue.pop(&w.queue)
+        if !d.vert_alive[c.u] || d.stamp[c.u] != c.stamp do continue
+        if c.cost > w.max_cost do break
+
+        // Neighborhood may have changed since the candidate was queued
+        gather_ring(d, c.u, &w.ring_u)
+        cost, ok := collapse_cost(w, c.u, c.v)
+        if !ok || cost > c.cost + 1e-12 {
+            d.stamp[c.u] += 1
+            push_best(w, c.u)
+            continue
+        }
+
+        apply_collapse(w, c.u, c.v)
+        w.max_applied = max(w.max_applied, cost)
+
+        // Re-queue v and everything around it
+        gather_ring(d, c.v, &w.ring_v)
+        clear(&w.affected)
+        append(&w.affected, c.v)
+        append(&w.affected, ..w.ring_v[:])
+        for x in w.affected {
+            d.stamp[x] += 1
+            push_best(w, x)
+        }
+    }
+}
+
+// Drop dead triangles/vertices and reindex
+@(private="file")
+compact_mesh :: proc(d: ^Decimator) {
+    mesh := d.mesh
+
+    remap := make([]int, len(mesh.positions))
+    defer delete(remap)
+
+    new_count := 0
+    for i in 0..<len(mesh.positions) {
+        if d.vert_alive[i] {
+            remap[i] = new_count
+            mesh.positions[new_count] = mesh.positions[i]
+            new_count += 1
+        } else {
+            remap[i] = -1
+        }
+    }
+    resize(&mesh.positions, new_count)
+
+    tri_count := 0
+    for t in 0..<len(mesh.triangles) {
+        if !d.tri_alive[t] do continue
+        tri := mesh.triangles[t]
+        mesh.triangles[tri_count] = [3]int{remap[tri[0]], remap[tri[1]], remap[tri[2]]}
+        mesh.face_ids[tri_count] = mesh.face_ids[t]
+        tri_count += 1
+    }
+    resize(&mesh.triangles, tri_count)
+    resize(&mesh.face_ids, tri_count)
+}
@@ -0,0 +1,338 @@
+// core/tessellation/polygon_triangulate.odin
+// Triangulation front end: classifies each polygon and picks the cheapest correct path
+//   - convex            → fan from the first vertex
+//   - simple, no holes  → ear clipping (exact orient2d, O(n²) on small polygons)
+//   - holes, self-intersections, very large polygons → libtess2 sweep
+// Output is canonical on every path: triangles keep the input winding, start at their
+// lowest vertex index and are sorted, so callers see the same order whichever path ran.
+package tessellation
+
+import "core:c"
+import "core:fmt"
+import "core:slice"
+import m "../../core/math"
+
+// Polygons above this size skip the O(n²) simplicity check and ear clipper
+TRIANGULATE_FAST_PATH_MAX_VERTICES :: 64
+
+PolygonClass :: enum {
+    Degenerate,  // < 3 distinct vertices or zero area - no triangles
+    Convex,
+    Simple,      // Hole-free, non-self-intersecting
+    Complex,     // Holes, self-intersections or too large for the fast paths
+}
+
+// Triangulation algorithm (Auto = pick from the polygon's class)
+TriangulatePath :: enum {
+    Auto,
+    Fan,       // Convex
+    EarClip,   // Simple
+    Sweep,     // libtess2
+}
+
+// Triangles index the input points (outer contour first, then holes in order);
+// indices >= the input count refer to extra_points (intersections created by libtess2)
+Triangulation :: struct {
+    triangles: [dynamic][3]int,
+    extra_points: [dynamic]m.Vec2,
+    class: PolygonClass,      // Class of the input
+    path: TriangulatePath,    // Path that produced the triangles (.Auto = none ran)
+}
+
+triangulation_destroy :: proc(tri: ^Triangulation) {
+    delete(tri.triangles)
+    delete(tri.extra_points)
+}
+
+// Triangulate a polygon with optional holes
+// force: run a specific path regardless of class (tests/benchmarks; Fan assumes convex input)
+triangulate_polygon_2d :: proc(
+    outer: []m.Vec2,
+    holes: [][]m.Vec2 = nil,
+    force: TriangulatePath = .Auto,
+) -> Triangulation {
+    result := Triangulation{
+        triangles = make([dynamic][3]int, 0, max(len(outer) - 2, 0)),
+    }
+
+    result.class = len(holes) > 0 ? .Complex : classify_polygon_2d(outer)
+
+    path := force
+    if path == .Auto {
+        switch result.class {
+        case .Degenerate:
+            return result
+        case .Convex:
+            path = .Fan
+        case .Simple:
+            path = .EarClip
+        case .Complex:
+            path = .Sweep
+        }
+    }
+
+    // Fast paths only handle a single contour
+    if len(holes) > 0 {
+        path = .Sweep
+    }
+
+    ok := false
+    #partial switch path {
+    case .Fan:
+        ok = triangulate_fan(outer, &result.triangles)
+    case .EarClip:
+        ok = triangulate_ear_clip(outer, &result.triangles)
+    }
+
+    if !ok {
+        // Fast path gave up (near-degenerate input) or was not eligible - the sweep handles anything
+        clear(&result.triangles)
+        path = .Sweep
+        triangulate_libtess2(outer, holes, &result)
+    }
+
+    result.path = path
+    canonicalize_triangles(result.triangles[:])
+    return result
+}
+
+// Classify a single contour (see PolygonClass)
+classify_polygon_2d :: proc(points: []m.Vec2) -> PolygonClass {
+    n := len(points)
+    if n < 3 {
+        return .Degenerate
+    }
+
+    // Duplicate consecutive vertices (including a repeated closing point) break the
+    // turn-based tests below; leave those to the sweep
+    for i in 0..<n {
+        if points[i] == points[(i + 1) % n] {
+            return .Complex
+        }
+    }
+
+    area := m.polygon_signed_area_2d(points)
+    if area == 0 {
+        return .Degenerate
+    }
+    winding: f64 = area > 0 ? 1 : -1
+
+    // Convex: every turn goes the same way and the boundary winds around only once
+    // (edge directions change x/y sign at most twice - rules out pentagram-style stars)
+    convex := true
+    x_flips, y_flips := 0, 0
+    prev_dx, prev_dy: f64
+    for i in 0..<n {
+        a := points[(i + n - 1) % n]
+        b := points[i]
+        cc := points[(i + 1) % n]
+        if m.orient2d(a, b, cc) * winding < 0 {
+            convex = false
+            break
+        }
+
+        d := cc - b
+        if d.x != 0 {
+            if prev_dx != 0 && (d.x > 0) != (prev_dx > 0) do x_flips += 1
+            prev_dx = d.x
+        }
+        if d.y != 0 {
+            if prev_dy != 0 && (d.y > 0) != (prev_dy > 0) do y_flips += 1
+            prev_dy = d.y
+        }
+    }
+    if convex && x_flips <= 2 && y_flips <= 2 {
+        return .Convex
+    }
+
+    if n > TRIANGULATE_FAST_PATH_MAX_VERTICES {
+        return .Complex
+    }
+
+    // Simple: no two edges touch except neighbours at their shared vertex
+    for i in 0..<n {
+        a0, a1 := points[i], points[(i + 1) % n]
+
+        // Neighbour folding back onto this edge (collinear spike)
+        a2 := points[(i + 2) % n]
+        if m.orient2d(a0, a1, a2) == 0 {
+            d0, d1 := a0 - a1, a2 - a1
+            if d0.x * d1.x + d0.y * d1.y > 0 do return .Complex
+        }
+
+        for j in i + 2..<n {
+            if i == 0 && j == n - 1 do continue  // Adjacent through the closing edge
+            if m.segments_intersect_2d(a0, a1, points[j], points[(j + 1) % n]) {
+                return .Complex
+            }
+        }
+    }
+
+    return .Simple
+}
+
+// =============================================================================
+// Paths
+// =============================================================================
+
+// Collinear runs next to vertex 0 would give zero-area triangles; those are skipped
+@(private="file")
+triangulate_fan :: proc(points: []m.Vec2, out: ^[dynamic][3]int) -> bool {
+    for i in 1..<len(points) - 1 {
+        if m.orient2d(points[0], points[i], points[i + 1]) != 0 {
+            append(out, [3]int{0, i, i + 1})
+        }
+    }
+    return len(out) > 0
+}
+
+// Ear clipping over a doubly linked vertex ring
+// Returns false if no ear can be found (numerically degenerate input)
+@(private="file")
+triangulate_ear_clip :: proc(points: []m.Vec2, out: ^[dynamic][3]int) -> bool {
+    n := len(points)
+    winding: f64 = m.polygon_signed_area_2d(points) > 0 ? 1 : -1
+
+    prev := make([]int, n)
+    defer delete(prev)
+    next := make([]int, n)
+    defer delete(next)
+    for i in 0..<n {
+        prev[i] = (i + n - 1) % n
+        next[i] = (i + 1) % n
+    }
+
+    is_ear :: proc(points: []m.Vec2, prev, next: []int, i: int, winding: f64) -> bool {
+        a, b, cc := points[prev[i]], points[i], points[next[i]]
+        if m.orient2d(a, b, cc) * winding <= 0 {
+            return false  // Reflex or collinear
+        }
+
+        // No other remaining vertex may lie in (or on) the ear
+        for j := next[next[i]]; j != prev[i]; j = next[j] {
+            p := points[j]
+            if p == a || p == b || p == cc do continue
+            if m.orient2d(a, b, p) * winding >= 0 &&
+               m.orient2d(b, cc, p) * winding >= 0 &&
+               m.orient2d(cc, a, p) * winding >= 0 {
+                return false
+            }
+        }
+        return true
+    }
+
+    remaining := n
+    i := 0
+    stall := 0
+    for remaining > 3 {
+        if is_ear(points, prev, next, i, winding) {
+            append(out, [3]int{prev[i], i, next[i]})
+            next[prev[i]] = next[i]
+            prev[next[i]] = prev[i]
+            remaining -= 1
+            stall = 0
+            i = next[i]
+            continue
+        }
+
+        i = next[i]
+        stall += 1
+        if stall > remaining {
+            return false
+        }
+    }
+
+    // Last triangle (zero area if the remaining vertices are collinear)
+    if m.orient2d(points[prev[i]], points[i], points[next[i]]) != 0 {
+        append(out, [3]int{prev[i], i, next[i]})
+    }
+    return true
+}
+
+// libtess2 sweep (holes, self-intersections); fills result.triangles/extra_points
+@(private="file")
+triangulate_libtess2 :: proc(outer: []m.Vec2, holes: [][]m.Vec2, result: ^Triangulation) {
+    tess := NewTess(nil)
+    if tess == nil {
+        fmt.println("Error: Failed to create tesselator")
+        return
+    }
+    defer DeleteTess(tess)
+
+    // libtess2 works in f32; original vertices are mapped back by index so they stay exact
+    add_contour :: proc(tess: ^TESStesselator, points: []m.Vec2) -> int {
+        if len(points) == 0 do return 0
+        coords := make([]TESSreal, len(points) * 2)
+        defer delete(coords)
+        for p, i in points {
+            coords[i * 2 + 0] = TESSreal(p.x)
+            coords[i * 2 + 1] = TESSreal(p.y)
+        }
+        AddContour(tess, 2, &coords[0], size_of(TESSreal) * 2, c.int(len(points)))
+        return len(points)
+    }
+
+    // Vertex indices run across contours in the order they were added
+    input_count := add_contour(tess, outer)
+    for hole in holes {
+        input_count += add_contour(tess, hole)
+    }
+
+    if GetStatus(tess) != .OK {
+        fmt.println("Error: Failed to add contour, status:", GetStatus(tess))
+        return
+    }
+
+    if Tesselate(tess, c.int(TessWindingRule.NONZERO), c.int(TessElementType.POLYGONS), 3, 2, nil) == 0 {
+        fmt.println("Error: Tessellation failed")
+        return
+    }
+
+    vertex_count := int(GetVertexCount(tess))
+    vertices := GetVertices(tess)
+    vertex_indices := GetVertexIndices(tess)
+    elements := GetElements(tess)
+    if elements == nil || vertices == nil || vertex_indices == nil {
+        fmt.println("Error: No triangles generated")
+        return
+    }
+
+    // Output vertex → input index (original vertex) or extra point index (new intersection)
+    remap := make([]int, vertex_count)
+    defer delete(remap)
+    for v in 0..<vertex_count {
+        original := vertex_indices[v]
+        if original != TESS_UNDEF && int(original) < input_count {
+            remap[v] = int(original)
+        } else {
+            remap[v] = input_count + len(result.extra_points)
+            append(&result.extra_points, m.Vec2{f64(vertices[v * 2]), f64(vertices[v * 2 + 1])})
+        }
+    }
+
+    // libtess2 already keeps the input contour's winding (CheckOrientation in tess.c)
+    for i in 0..<int(GetElementCount(tess)) {
+        e0, e1, e2 := elements[i * 3 + 0], elements[i * 3 + 1], elements[i * 3 + 2]
+        if e0 == TESS_UNDEF || e1 == TESS_UNDEF || e2 == TESS_UNDEF do continue
+
+        append(&result.triangles, [3]int{remap[e0], remap[e1], remap[e2]})
+    }
+}
+
+// Rotate each triangle to start at its lowest index (winding preserved), then sort
+@(private="file")
+canonicalize_triangles :: proc(triangles: [][3]int) {
+    for &t in triangles {
+        if t[1] < t[0] && t[1] < t[2] {
+            t = {t[1], t[2], t[0]}
+        } else if t[2] < t[0] && t[2] < t[1] {
+            t = {t[2], t[0], t[1]}
+        }
+    }
+
+    slice.sort_by(triangles, proc(a, b: [3]int) -> bool {
+        if a[0] != b[0] do return a[0] < b[0]
+        if a[1] != b[1] do return a[1] < b[1]
+        return a[2] < b[2]
+    })
+}
@@ -24,6 +24,8 @@ CutParams :: struct {
     direction:   CutDirection,               // Cut direction
     base_solid:  ^extrude.SimpleSolid,       // Tessellated mesh (for backward compatibility, will be deprecated)
     base_shape:  occt.Shape,                  // NEW: Exact B-Rep geometry for boolean operations
+    simplify:    bool,                        // Merge split faces/seam edges after the boolean
+    simplify_params: occt.SimplifyParams,     // Cleanup tolerances (used when simplify is set)
 }
 
 // Cut result
@@ -32,6 +34,7 @@ CutResult :: struct {
     solid:      ^extrude.SimpleSolid,  // Tessellated mesh for rendering
     success:    bool,                   // Operation success flag
     message:    string,                 // Error/status message
+    simplify_stats: occt.SimplifyStats, // Face/edge reduction from post-boolean cleanup
 }
 
 // =============================================================================
@@ -83,7 +86,7 @@ cut_sketch :: proc(sk: ^sketch.Sketch2D, params: CutParams) -> CutResult {
         len(closed_profile.entities), len(closed_profile.points))
 
     // Perform boolean subtract using OCCT
-    occt_shape, solid := boolean_subtract_occt(sk, closed_profile, params)
+    occt_shape, solid, stats := boolean_subtract_occt(sk, closed_profile, params)
 
     if occt_shape == nil || solid == nil {
         result.message = "Failed to perform OCCT boolean subtract"
@@ -92,6 +95,7 @@ cut_sketch :: proc(sk: ^sketch.Sketch2D, params: CutParams) -> CutResult {
 
     result.occt_shape = occt_shape
     result.solid = solid
+    result.simplify_stats = stats
     result.success = true
     result.message = "Cut successful"
 
@@ -107,20 +111,22 @@ cut_sketch :: proc(sk: ^sketch.Sketch2D, params: CutParams) -> CutResult {
 // 1. Create 2D wire from sketch profile
 // 2. Extrude wire to create cut volume as OCCT shape
 // 3. Use OCCT boolean difference: base - cut
-// 4. Tessellate result to SimpleSolid for rendering
-// 5. Return both OCCT shape and SimpleSolid
+// 4. Optionally merge split faces/seam edges left by the boolean
+// 5. Tessellate result to SimpleSolid for rendering
+// 6. Return both OCCT shape and SimpleSolid
 boolean_subtract_occt :: proc(
     sk: ^sketch.Sketch2D,
     profile: sketch.Profile,
     params: CutParams,
-) -> (occt.Shape, ^extrude.SimpleSolid) {
+) -> (occt.Shape, ^extrude.SimpleSolid, occt.SimplifyStats) {
+    stats: occt.SimplifyStats
 
     fmt.println("\n🔧 Starting OCCT boolean subtract...")
 
     // Validate base shape exists
     if params.base_shape == nil {
         fmt.println("❌ Error: No base OCCT shape provided")
-        return nil, nil
+        return nil, nil, stats
     }
 
     // Step 1: Create 2D wire from profile points
@@ -129,7 +135,7 @@ boolean_subtract_occt :: proc(
 
     if len(profile_points) < 3 {
         fmt.println("❌ Error: Profile must have at least 3 points")
-        return nil, nil
+        return nil, nil, stats
     }
 
     // Convert profile points to 3D world coordinates
@@ -147,7 +153,7 @@ boolean_subtract_occt :: proc(
     wire := occt.OCCT_Wire_FromPoints3D(raw_data(points_3d), i32(len(profile_points)), true)
     if wire == nil {
         fmt.println("❌ Error: Failed to create OCCT wire from profile")
-        return nil, nil
+        return nil, nil, stats
     }
     defer occt.OCCT_Wire_Delete(wire)
 
@@ -160,34 +166,57 @@ boolean_subtract_occt :: proc(
     cut_shape := occt.OCCT_Extrude_Wire(wire, cut_offset.x, cut_offset.y, cut_offset.z)
     if cut_shape == nil {
         fmt.println("❌ Error: Failed to extrude cut profile")
-        return nil, nil
+        return nil, nil, stats
     }
     defer occt.delete_shape(cut_shape)
 
     fmt.println("✅ Created cut volume via OCCT extrusion")
 
+    // Tool misses the base entirely - the result is the base itself, so share it
+    // (both the B-Rep and the tessellation) instead of running a boolean
+    if params.base_solid != nil && !shapes_may_overlap(params.base_shape, cut_shape) {
+        fmt.println("✅ Cut volume does not reach the base - sharing base geometry")
+        return occt.share_shape(params.base_shape), extrude.simple_solid_retain(params.base_solid), stats
+    }
+
     // Step 4: Perform boolean difference (base - cut)
     result_shape := occt.OCCT_Boolean_Difference(params.base_shape, cut_shape)
     if result_shape == nil {
         fmt.println("❌ Error: OCCT boolean difference failed")
-        return nil, nil
+        return nil, nil, stats
     }
 
     // Validate result
     if !occt.is_valid(result_shape) {
         fmt.println("❌ Error: Boolean result shape is invalid")
         occt.delete_shape(result_shape)
-        return nil, nil
+        return nil, nil, stats
     }
 
     fmt.println("✅ OCCT boolean difference succeeded")
 
+    // Step 4b: Merge coplanar/co-cylindrical faces so face count doesn't grow with every cut
+    if params.simplify {
+        simplified, simplify_stats := occt.simplify_shape(result_shape, params.simplify_params)
+        if simplified != nil && occt.is_valid(simplified) {
+            occt.delete_shape(result_shape)
+            result_shape = simplified
+            stats = simplify_stats
+            fmt.printf("✅ Topology cleanup: faces %d → %d, edges %d → %d\n",
+                stats.faces_before, stats.faces_after, stats.edges_before, stats.edges_after)
+        } else {
+            // Keep the unsimplified (but valid) boolean result
+            occt.delete_shape(simplified)
+            fmt.println("⚠️  Topology cleanup failed, keeping raw boolean result")
+        }
+    }
+
     // Step 5: Tessellate result to SimpleSolid for rendering
     mesh := occt.OCCT_Tessellate(result_shape, occt.DEFAULT_TESSELLATION)
     if mesh == nil {
         fmt.println("❌ Error: Failed to tessellate cut result")
         occt.delete_shape(result_shape)
-        return nil, nil
+        return nil, nil, stats
     }
     defer occt.delete_mesh(mesh)
 
@@ -199,14 +228,31 @@ boolean_subtract_occt :: proc(
     if solid == nil {
         fmt.println("❌ Error: Failed to convert mesh to SimpleSolid")
         occt.delete_shape(result_shape)
-        return nil, nil
+        return nil, nil, stats
     }
 
     fmt.printf("✅ OCCT boolean subtract complete: %d vertices, %d triangles\n",
         len(solid.vertices), len(solid.triangles))
 
     // Return both OCCT shape (don't delete - caller owns it) and SimpleSolid
-    return result_shape, solid
+    return result_shape, solid, stats
+}
+
+// Conservative overlap test on bounding boxes (true when unknown)
+@(private="file")
+shapes_may_overlap :: proc(a, b: occt.Shape) -> bool {
+    a_min, a_max, a_ok := occt.bounding_box(a)
+    b_min, b_max, b_ok := occt.bounding_box(b)
+    if !a_ok || !b_ok {
+        return true
+    }
+
+    for axis in 0..<3 {
+        if a_max[axis] < b_min[axis] || b_max[axis] < a_min[axis] {
+            return false
+        }
+    }
+    return true
 }
 
 // Convert OCCT mesh to SimpleSolid (same as primitives module)
@@ -275,7 +321,7 @@ occt_mesh_to_simple_solid :: proc(mesh: ^occt.Mesh) -> ^extrude.SimpleSolid {
             v1 = v1,
             v2 = v2,
             normal = face_normal,
-            face_id = -1,
+            face_id = occt.mesh_triangle_face(mesh, i),
         }
 
         append(&solid.triangles, tri)
@@ -489,6 +535,11 @@ calculate_cut_offset :: proc(plane: ^sketch.SketchPlane, params: CutParams) -> m
 
 // Get profile points in order
 get_profile_points_ordered :: proc(sk: ^sketch.Sketch2D, profile: sketch.Profile) -> [dynamic]m.Vec2 {
+    // Splines are flattened into the outline (the cut tool wire is built from 3D points)
+    if sketch.profile_has_splines(sk, profile) {
+        return extrude.get_profile_points_tessellated(sk, profile)
+    }
+
     points := make([dynamic]m.Vec2, 0, len(profile.points))
 
     for point_id in profile.points {
@@ -544,24 +595,8 @@ point_in_bbox :: proc(point: m.Vec3, bbox: BoundingBox) -> bool {
            point.z >= (bbox.min.z - eps) && point.z <= (bbox.max.z + eps)
 }
 
-// Check if point is inside cut volume
-// Simplified: project point to sketch plane and check if inside 2D profile
-point_inside_cut_volume :: proc(
-    point: m.Vec3,
-    sk: ^sketch.Sketch2D,
-    profile: sketch.Profile,
-    params: CutParams,
-) -> bool {
-
-    // Project point to sketch plane to get 2D coordinates
-    point_2d := sketch.world_to_sketch(&sk.plane, point)
-
-    // Check if point is inside 2D profile using ray casting
-    if !point_inside_polygon_2d(point_2d, sk, profile) {
-        return false
-    }
-
-    // Also check depth: point must be within the cut depth range
+// Depth check: point must be within the cut depth range along the sketch normal
+point_within_cut_depth :: proc(point: m.Vec3, sk: ^sketch.Sketch2D, params: CutParams) -> bool {
     // Calculate distance from point to sketch plane
     plane_to_point := point - sk.plane.origin
     distance_along_normal := glsl.dot(plane_to_point, sk.plane.normal)
@@ -587,67 +622,34 @@ point_inside_cut_volume :: proc(
     return false
 }
 
-// Ray casting algorithm to check if point is inside 2D polygon
-point_inside_polygon_2d :: proc(
-    point: m.Vec2,
+// Keep the triangles whose centroid lies outside the cut volume
+// Centroids are classified against the profile in one batch (exact orient2d predicates)
+append_triangles_outside_cut :: proc(
+    result: ^[dynamic]extrude.Triangle3D,
+    triangles: []extrude.Triangle3D,
     sk: ^sketch.Sketch2D,
     profile: sketch.Profile,
-) -> bool {
-
-    // Get profile points
+    params: CutParams,
+) {
     profile_points := get_profile_points_ordered(sk, profile)
     defer delete(profile_points)
 
-    if len(profile_points) < 3 {
-        return false
-    }
-
-    // Ray casting: count intersections with horizontal ray from point
-    inside := false
-    n := len(profile_points)
-
-    for i in 0..<n {
-        j := (i + 1) % n
-
-        p1 := profile_points[i]
-        p2 := profile_points[j]
-
-        // Check if horizontal ray intersects edge
-        if ((p1.y > point.y) != (p2.y > point.y)) &&
-           (point.x < (p2.x - p1.x) * (point.y - p1.y) / (p2.y - p1.y) + p1.x) {
-            inside = !inside
-        }
-    }
-
-    return inside
-}
-
-// Copy a solid (deep copy)
-copy_solid :: proc(solid: ^extrude.SimpleSolid) -> ^extrude.SimpleSolid {
-    result := new(extrude.SimpleSolid)
-    result.vertices = make([dynamic]^extrude.Vertex, 0, len(solid.vertices))
-    result.edges = make([dynamic]^extrude.Edge, 0, len(solid.edges))
+    centroids := make([]m.Vec2, len(triangles))
+    defer delete(centroids)
+    sides := make([]m.PolygonSide, len(triangles))
+    defer delete(sides)
 
-    // Copy vertices and create mapping
-    vertex_map := make(map[rawptr]^extrude.Vertex)
-    defer delete(vertex_map)
-
-    for old_vertex in solid.vertices {
-        new_vertex := new(extrude.Vertex)
-        new_vertex.position = old_vertex.position
-        append(&result.vertices, new_vertex)
-        vertex_map[old_vertex] = new_vertex
+    for tri, i in triangles {
+        centroids[i] = sketch.world_to_sketch(&sk.plane, (tri.v0 + tri.v1 + tri.v2) / 3.0)
     }
+    m.classify_points_polygon_2d_batch(centroids, profile_points[:], sides)
 
-    // Copy edges with updated vertex references
-    for old_edge in solid.edges {
-        new_edge := new(extrude.Edge)
-        new_edge.v0 = vertex_map[old_edge.v0]
-        new_edge.v1 = vertex_map[old_edge.v1]
-        append(&result.edges, new_edge)
+    for tri, i in triangles {
+        inside := sides[i] == .Inside && point_within_cut_depth((tri.v0 + tri.v1 + tri.v2) / 3.0, sk, params)
+        if !inside {
+            append(result, tri)
+        }
     }
-
-    return result
 }
 
 // Add cut boundary edges to result solid
@@ -865,23 +867,7 @@ cut_result_print :: proc(result: CutResult) {
 
 // Destroy cut result (cleanup)
 cut_result_destroy :: proc(result: ^CutResult) {
-    if result.solid != nil {
-        // Free all vertices
-        for vertex in result.solid.vertices {
-            free(vertex)
-        }
-        delete(result.solid.vertices)
-
-        // Free all edges
-        for edge in result.solid.edges {
-            free(edge)
-        }
-        delete(result.solid.edges)
-
-        // Free solid itself
-        free(result.solid)
-        result.solid = nil
-    }
+    extrude.simple_solid_release(&result.solid)
 }
 
 // Generate proper pocket geometry with bottom face and side walls
@@ -893,17 +879,15 @@ generate_pocket_geometry :: proc(
 ) -> [dynamic]extrude.Triangle3D {
     result := make([dynamic]extrude.Triangle3D)
 
-    // Ensure base solid has triangles
-    base_triangles: [dynamic]extrude.Triangle3D
-    if len(base_solid.triangles) == 0 {
+    // Read the base solid's triangles in place (it is shared and immutable)
+    base_triangles := base_solid.triangles[:]
+    generated: [dynamic]extrude.Triangle3D
+    defer delete(generated)
+    if len(base_triangles) == 0 {
         fmt.println("⚠️  Base solid has no triangles, generating...")
-        base_triangles = extrude.generate_face_triangles(base_solid)
-    } else {
-        // Copy existing triangles
-        base_triangles = make([dynamic]extrude.Triangle3D, len(base_solid.triangles))
-        copy(base_triangles[:], base_solid.triangles[:])
+        generated = extrude.generate_face_triangles(base_solid)
+        base_triangles = generated[:]
     }
-    defer delete(base_triangles)
 
     // Get profile points for pocket geometry
     profile_points := get_profile_points_ordered(sk, profile)
@@ -919,15 +903,7 @@ generate_pocket_geometry :: proc(
 
     // 1. Filter triangles from base solid that intersect the cut region
     //    Check ALL triangles, not just top face
-    for tri in base_triangles {
-        // Calculate triangle centroid
-        centroid := (tri.v0 + tri.v1 + tri.v2) / 3.0
-
-        // Keep triangle only if it's NOT inside the cut volume
-        if !point_inside_cut_volume(centroid, sk, profile, params) {
-            append(&result, tri)
-        }
-    }
+    append_triangles_outside_cut(&result, base_triangles, sk, profile, params)
 
     // 2. Generate pocket bottom face using libtess2 for proper triangulation
     // Convert 2D profile points to 3D bottom vertices
@@ -1052,18 +1028,10 @@ copy_triangles_excluding_cut_region :: proc(
         defer delete(triangles)
 
         // Filter triangles that are in the cut region
-        for tri in triangles {
-            if !triangle_in_cut_region(tri, sk, profile, params) {
-                append(&result, tri)
-            }
-        }
+        append_triangles_outside_cut(&result, triangles[:], sk, profile, params)
     } else {
         // Filter existing triangles
-        for tri in base_solid.triangles {
-            if !triangle_in_cut_region(tri, sk, profile, params) {
-                append(&result, tri)
-            }
-        }
+        append_triangles_outside_cut(&result, base_solid.triangles[:], sk, profile, params)
     }
 
     fmt.printf("  Filtered %d → %d triangles (removed %d in cut region)\n",
@@ -1071,17 +1039,3 @@ copy_triangles_excluding_cut_region :: proc(
 
     return result
 }
-
-// Check if triangle is inside the cut region
-triangle_in_cut_region :: proc(
-    tri: extrude.Triangle3D,
-    sk: ^sketch.Sketch2D,
-    profile: sketch.Profile,
-    params: CutParams,
-) -> bool {
-    // Calculate triangle centroid
-    centroid := (tri.v0 + tri.v1 + tri.v2) / 3.0
-
-    // Check if centroid is inside cut volume
-    return point_inside_cut_volume(centroid, sk, profile, params)
-}
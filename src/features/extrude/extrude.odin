@@ -5,6 +5,7 @@ package ohcad_extrude
 import "core:fmt"
 import "core:slice"
 import "core:math"
+import "core:sync"
 import sketch "../../features/sketch"
 import topo "../../core/topology"
 import m "../../core/math"
@@ -43,6 +44,7 @@ SimpleSolid :: struct {
     edges: [dynamic]^Edge,
     faces: [dynamic]SimpleFace,  // Face data for selection/sketching
     triangles: [dynamic]Triangle3D,  // NEW: Triangle mesh for shaded rendering & STL export
+    shared_refs: int,  // Extra owners sharing this solid (0 = sole owner) - see simple_solid_retain
 }
 
 // Simple vertex (world space)
@@ -155,7 +157,15 @@ extrude_profile :: proc(
     fmt.printf("🔧 Extruding %d-point profile using OCCT...\n", len(profile_points))
 
     // Use OCCT to perform extrusion and get both shape and mesh
-    occt_result := occt.extrude_profile_2d(profile_points[:], extrude_offset)
+    // Profiles with splines keep them as exact B-spline edges; the tessellated points
+    // are then only used for the face metadata below.
+    occt_result: occt.ExtrudeResult
+    if sketch.profile_has_splines(sk, profile) {
+        curves := get_profile_curves(sk, profile)
+        occt_result = occt.extrude_curves_2d(curves, extrude_offset)
+    } else {
+        occt_result = occt.extrude_profile_2d(profile_points[:], extrude_offset)
+    }
 
     if occt_result.shape == nil || occt_result.mesh == nil {
         fmt.println("❌ OCCT extrusion failed")
@@ -195,6 +205,8 @@ extrude_profile :: proc(
 // =============================================================================
 
 // Add face metadata to OCCT-generated solid for selection/sketching
+// Only the cap faces; picking and sketch-on-face prefer the exact face table of the
+// feature's B-Rep (feature_face_table) and fall back to these for mesh-only solids
 add_face_metadata :: proc(
     solid: ^SimpleSolid,
     sk: ^sketch.Sketch2D,
@@ -329,7 +341,7 @@ occt_mesh_to_simple_solid :: proc(mesh: ^occt.Mesh) -> ^SimpleSolid {
             v1 = v1,
             v2 = v2,
             normal = face_normal,
-            face_id = 0,  // OCCT doesn't distinguish faces in tessellation
+            face_id = occt.mesh_triangle_face(mesh, i),
         }
 
         append(&solid.triangles, tri)
@@ -641,16 +653,47 @@ get_profile_points_tessellated :: proc(sk: ^sketch.Sketch2D, profile: sketch.Pro
         }
     }
 
-    // For line-based profiles, use the existing point extraction
-    // Profile.points already contains the ordered point IDs
-    for point_id in profile.points {
-        if point_id >= 0 && point_id < len(sk.points) {
-            point := sk.points[point_id]
-            append(&points, m.Vec2{point.x, point.y})
+    // For line-based profiles, follow the ordered point IDs (splines add their flattened interior)
+    sketch.sketch_profile_outline(sk, profile, &points)
+
+    return points
+}
+
+// Get the profile as exact curves in loop order (temp-allocated)
+// Lines become two-pole curves; splines keep their control points, reversed when the
+// loop runs from the spline's end to its start.
+get_profile_curves :: proc(sk: ^sketch.Sketch2D, profile: sketch.Profile) -> []occt.ProfileCurve2D {
+    curves := make([dynamic]occt.ProfileCurve2D, 0, len(profile.entities), context.temp_allocator)
+
+    for entity_index, k in profile.entities {
+        if k >= len(profile.points) do break
+        from_id := profile.points[k]
+        to_id := profile.points[(k + 1) % len(profile.points)]
+
+        if spline, is_spline := sk.entities[entity_index].(sketch.SketchSpline); is_spline {
+            buf: [sketch.SPLINE_MAX_CONTROL_POINTS]m.Vec2
+            controls, ok := sketch.sketch_spline_controls(sk, spline, &buf)
+            if !ok do continue
+
+            poles := slice.clone(controls, context.temp_allocator)
+            if start_id, _ := sketch.spline_endpoints(sk, spline); start_id != from_id {
+                slice.reverse(poles)
+            }
+            append(&curves, occt.ProfileCurve2D{poles = poles})
+            continue
         }
+
+        from := sketch.sketch_get_point(sk, from_id)
+        to := sketch.sketch_get_point(sk, to_id)
+        if from == nil || to == nil do continue
+
+        poles := make([]m.Vec2, 2, context.temp_allocator)
+        poles[0] = m.Vec2{from.x, from.y}
+        poles[1] = m.Vec2{to.x, to.y}
+        append(&curves, occt.ProfileCurve2D{poles = poles})
     }
 
-    return points
+    return curves[:]
 }
 
 // =============================================================================
@@ -672,23 +715,56 @@ extrude_result_print :: proc(result: ExtrudeResult) {
 
 // Destroy extrude result (cleanup)
 extrude_result_destroy :: proc(result: ^ExtrudeResult) {
-    if result.solid != nil {
-        // Free all vertices
-        for vertex in result.solid.vertices {
-            free(vertex)
-        }
-        delete(result.solid.vertices)
+    simple_solid_release(&result.solid)
+}
 
-        // Free all edges
-        for edge in result.solid.edges {
-            free(edge)
-        }
-        delete(result.solid.edges)
+// =============================================================================
+// Shared Ownership
+// =============================================================================
+
+// Published feature solids are immutable, so a feature whose result is identical to
+// another's (e.g. a cut that misses its base) shares the solid instead of deep-copying it.
+// Every owner holds one reference and drops it with simple_solid_release.
+
+// Take another reference to solid (returns it for convenience)
+simple_solid_retain :: proc(solid: ^SimpleSolid) -> ^SimpleSolid {
+    if solid != nil {
+        sync.atomic_add(&solid.shared_refs, 1)
+    }
+    return solid
+}
+
+// Drop the caller's reference and clear its pointer; the last owner frees the solid
+simple_solid_release :: proc(solid: ^^SimpleSolid) {
+    s := solid^
+    solid^ = nil
+    if s == nil {
+        return
+    }
 
-        // Free solid itself
-        free(result.solid)
-        result.solid = nil
+    // Other owners remain
+    if sync.atomic_sub(&s.shared_refs, 1) > 0 {
+        return
     }
+
+    for vertex in s.vertices {
+        free(vertex)
+    }
+    delete(s.vertices)
+
+    for edge in s.edges {
+        free(edge)
+    }
+    delete(s.edges)
+
+    for &face in s.faces {
+        delete(face.vertices)
+    }
+    delete(s.faces)
+
+    delete(s.triangles)
+
+    free(s)
 }
 
 // =============================================================================
@@ -729,3 +805,98 @@ generate_face_triangles :: proc(solid: ^SimpleSolid) -> [dynamic]Triangle3D {
 
     return all_triangles
 }
+
+// Build a decimated copy of a solid's triangle mesh (display LODs / export budgets)
+// Returns a new triangles-only solid with feature edges; caller owns it
+simple_solid_decimate :: proc(solid: ^SimpleSolid, params: tess.DecimateParams) -> (^SimpleSolid, tess.DecimateStats) {
+    if solid == nil || len(solid.triangles) == 0 {
+        return nil, {}
+    }
+
+    face_tris := make([dynamic]tess.FaceTri, 0, len(solid.triangles))
+    defer delete(face_tris)
+    for tri in solid.triangles {
+        append(&face_tris, tess.FaceTri{v0 = tri.v0, v1 = tri.v1, v2 = tri.v2, normal = tri.normal, face_id = tri.face_id})
+    }
+
+    mesh := tess.indexed_mesh_from_tris(face_tris[:])
+    defer tess.indexed_mesh_destroy(&mesh)
+
+    stats := tess.decimate_mesh(&mesh, params)
+
+    decimated := tess.indexed_mesh_to_tris(&mesh)
+    defer delete(decimated)
+
+    lod := new(SimpleSolid)
+    lod.triangles = make([dynamic]Triangle3D, 0, len(decimated))
+    for ft in decimated {
+        append(&lod.triangles, Triangle3D{v0 = ft.v0, v1 = ft.v1, v2 = ft.v2, normal = ft.normal, face_id = ft.face_id})
+    }
+
+    extract_feature_edges_from_mesh(lod)
+    return lod, stats
+}
+
+// World-space copy of a solid under a rigid transform (moved/copied bodies - picking and export)
+// Normals are rotated only, so transform must not scale. Caller owns the result.
+simple_solid_transformed :: proc(solid: ^SimpleSolid, transform: m.Mat4) -> ^SimpleSolid {
+    if solid == nil {
+        return nil
+    }
+
+    point :: proc(t: m.Mat4, p: m.Vec3) -> m.Vec3 {
+        return (t * m.Vec4{p.x, p.y, p.z, 1}).xyz
+    }
+    direction :: proc(t: m.Mat4, d: m.Vec3) -> m.Vec3 {
+        return (t * m.Vec4{d.x, d.y, d.z, 0}).xyz
+    }
+
+    result := new(SimpleSolid)
+    reserve(&result.vertices, len(solid.vertices))
+    reserve(&result.edges, len(solid.edges))
+    reserve(&result.faces, len(solid.faces))
+    reserve(&result.triangles, len(solid.triangles))
+
+    // Edges and faces reference vertices by pointer - remap them to the copies
+    copies := make(map[^Vertex]^Vertex, len(solid.vertices))
+    defer delete(copies)
+
+    for vertex in solid.vertices {
+        moved := new(Vertex)
+        moved.position = point(transform, vertex.position)
+        copies[vertex] = moved
+        append(&result.vertices, moved)
+    }
+
+    for edge in solid.edges {
+        e := new(Edge)
+        e.v0 = copies[edge.v0]
+        e.v1 = copies[edge.v1]
+        append(&result.edges, e)
+    }
+
+    for face in solid.faces {
+        f := SimpleFace{
+            vertices = make([dynamic]^Vertex, 0, len(face.vertices)),
+            normal = direction(transform, face.normal),
+            center = point(transform, face.center),
+            name = face.name,
+        }
+        for vertex in face.vertices {
+            append(&f.vertices, copies[vertex])
+        }
+        append(&result.faces, f)
+    }
+
+    for tri in solid.triangles {
+        append(&result.triangles, Triangle3D{
+            v0 = point(transform, tri.v0),
+            v1 = point(transform, tri.v1),
+            v2 = point(transform, tri.v2),
+            normal = direction(transform, tri.normal),
+            face_id = tri.face_id,
+        })
+    }
+
+    return result
+}
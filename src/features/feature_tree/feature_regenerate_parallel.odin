@@ -0,0 +1,243 @@
+// features/feature_tree - Concurrent regeneration of independent feature branches
+// Builds the dependency DAG from parent_features and sketch/base references and
+// regenerates ready features on a worker pool (independent bodies run in parallel)
+package ohcad_feature_tree
+
+import "core:fmt"
+import "core:os"
+import "core:slice"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+// Dependency graph over tree.features (indices, not feature IDs)
+RegenGraph :: struct {
+    deps: [][dynamic]int,        // Features that must finish before each feature
+    dependents: [][dynamic]int,  // Reverse edges
+}
+
+// Per-feature outcome, joined on the calling thread in feature order
+RegenOutcome :: struct {
+    success: bool,
+    duration: time.Duration,
+}
+
+// Shared scheduler state (tasks only touch their own outcome slot)
+@(private="file")
+RegenScheduler :: struct {
+    tree: ^FeatureTree,
+    outcomes: []RegenOutcome,
+    mutex: sync.Mutex,           // Guards finished
+    finished: [dynamic]int,      // Feature indices completed since the scheduler last looked
+    done: sync.Sema,             // Posted once per finished task
+}
+
+// Build the regeneration DAG
+// Edges only point to earlier features (same inputs the serial order would see), so the graph is acyclic.
+// Features reading the same sketch or body are chained in tree order: OCCT shapes are not shared
+// between concurrently running tasks, and results match a serial regeneration. Bodies are keyed by
+// their shape root (see regen_shape_roots), since placed copies and cut results share B-Rep data.
+regen_graph_build :: proc(tree: ^FeatureTree) -> RegenGraph {
+    n := len(tree.features)
+    graph := RegenGraph{
+        deps = make([][dynamic]int, n),
+        dependents = make([][dynamic]int, n),
+    }
+
+    index_of := make(map[int]int, n)
+    defer delete(index_of)
+    for feature, i in tree.features {
+        index_of[feature.id] = i
+    }
+
+    shape_root := regen_shape_roots(tree)
+    defer delete(shape_root)
+
+    // Last feature that read each input (root feature ID → consumer index)
+    last_reader := make(map[int]int)
+    defer delete(last_reader)
+
+    add_edge :: proc(graph: ^RegenGraph, from, to: int) {
+        if from < 0 || from >= to || slice.contains(graph.deps[to][:], from) do return
+        append(&graph.deps[to], from)
+        append(&graph.dependents[from], to)
+    }
+
+    inputs := make([dynamic]int, 0, 4)
+    defer delete(inputs)
+
+    for &feature, i in tree.features {
+        clear(&inputs)
+        append(&inputs, ..feature.parent_features[:])
+
+        #partial switch params in feature.params {
+        case ExtrudeParams:
+            append(&inputs, params.sketch_feature_id)
+        case CutParams:
+            append(&inputs, params.sketch_feature_id, params.base_feature_id)
+        case RevolveParams:
+            append(&inputs, params.sketch_feature_id)
+        case TransformParams:
+            append(&inputs, params.base_feature_id)
+        }
+
+        for input_id in inputs {
+            parent, found := index_of[input_id]
+            if !found do continue
+
+            add_edge(&graph, parent, i)
+
+            key := shape_root[input_id] or_else input_id
+            if reader, seen := last_reader[key]; seen {
+                add_edge(&graph, reader, i)
+            }
+            last_reader[key] = i
+        }
+    }
+
+    return graph
+}
+
+// Feature ID → ID of the feature whose OCCT shape its body shares TShapes with
+// Move/copy-body places its base's shape (occt.locate_shape), and a cut result keeps its base's
+// untouched faces (or is the base shape itself when the tool misses, occt.share_shape). Meshing
+// writes triangulations onto those shared faces, so everything under one root must run in order.
+@(private="file")
+regen_shape_roots :: proc(tree: ^FeatureTree) -> map[int]int {
+    roots := make(map[int]int, len(tree.features))
+    for &feature in tree.features {
+        root := feature.id
+        #partial switch params in feature.params {
+        case CutParams:
+            root = roots[params.base_feature_id] or_else params.base_feature_id
+        case TransformParams:
+            root = roots[params.base_feature_id] or_else params.base_feature_id
+        }
+        roots[feature.id] = root
+    }
+    return roots
+}
+
+regen_graph_destroy :: proc(graph: ^RegenGraph) {
+    for &list in graph.deps {
+        delete(list)
+    }
+    for &list in graph.dependents {
+        delete(list)
+    }
+    delete(graph.deps)
+    delete(graph.dependents)
+}
+
+// Regenerate all features, running independent branches concurrently
+// workers: 0 = one per core, 1 = serial (tree order)
+feature_tree_regenerate_parallel :: proc(tree: ^FeatureTree, workers: int = 0) -> bool {
+    n := len(tree.features)
+    if n == 0 {
+        return true
+    }
+
+    worker_count := workers > 0 ? workers : os.processor_core_count()
+    worker_count = min(worker_count, n)
+
+    outcomes := make([]RegenOutcome, n)
+    defer delete(outcomes)
+
+    start := time.tick_now()
+
+    if worker_count <= 1 {
+        for &feature, i in tree.features {
+            task_start := time.tick_now()
+            outcomes[i].success = feature_regenerate(tree, feature.id)
+            outcomes[i].duration = time.tick_since(task_start)
+        }
+    } else {
+        regen_run_scheduled(tree, outcomes, worker_count)
+    }
+
+    wall := time.tick_since(start)
+
+    // Join in tree order so reporting does not depend on completion order
+    success := true
+    busy: time.Duration
+    for outcome, i in outcomes {
+        busy += outcome.duration
+        if !outcome.success {
+            success = false
+            feature := &tree.features[i]
+            fmt.printf("⚠️  Feature %d (%s) failed to regenerate\n", feature.id, feature.name)
+        }
+    }
+
+    fmt.printf("⏱️  Regenerated %d features in %.1f ms on %d worker(s) (%.1f ms of feature work)\n",
+        n, time.duration_milliseconds(wall), worker_count, time.duration_milliseconds(busy))
+
+    return success
+}
+
+@(private="file")
+regen_run_scheduled :: proc(tree: ^FeatureTree, outcomes: []RegenOutcome, worker_count: int) {
+    n := len(tree.features)
+
+    graph := regen_graph_build(tree)
+    defer regen_graph_destroy(&graph)
+
+    pending := make([]int, n)
+    defer delete(pending)
+    for i in 0..<n {
+        pending[i] = len(graph.deps[i])
+    }
+
+    sched := RegenScheduler{tree = tree, outcomes = outcomes}
+    defer delete(sched.finished)
+
+    pool: thread.Pool
+    thread.pool_init(&pool, context.allocator, worker_count)
+    defer thread.pool_destroy(&pool)
+    thread.pool_start(&pool)
+
+    // Only the calling thread touches pending and queues tasks
+    for i in 0..<n {
+        if pending[i] == 0 {
+            thread.pool_add_task(&pool, context.allocator, regen_task, &sched, i)
+        }
+    }
+
+    completed := 0
+    for completed < n {
+        sync.sema_wait(&sched.done)
+
+        sync.mutex_lock(&sched.mutex)
+        index := pop_front(&sched.finished)
+        sync.mutex_unlock(&sched.mutex)
+        completed += 1
+
+        // Dependents are queued in tree order, which keeps scheduling reproducible
+        for next in graph.dependents[index] {
+            pending[next] -= 1
+            if pending[next] == 0 {
+                thread.pool_add_task(&pool, context.allocator, regen_task, &sched, next)
+            }
+        }
+    }
+
+    thread.pool_finish(&pool)
+}
+
+@(private="file")
+regen_task :: proc(task: thread.Task) {
+    sched := (^RegenScheduler)(task.data)
+    index := task.user_index
+    feature_id := sched.tree.features[index].id
+
+    start := time.tick_now()
+    ok := feature_regenerate(sched.tree, feature_id)
+    sched.outcomes[index] = RegenOutcome{success = ok, duration = time.tick_since(start)}
+
+    free_all(context.temp_allocator)
+
+    sync.mutex_lock(&sched.mutex)
+    append(&sched.finished, index)
+    sync.mutex_unlock(&sched.mutex)
+    sync.sema_post(&sched.done)
+}
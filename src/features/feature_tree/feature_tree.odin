@@ -3,12 +3,17 @@
 package ohcad_feature_tree
 
 import "core:fmt"
+import "core:math"
+import "core:sync"
+import glsl "core:math/linalg/glsl"
 import sketch "../../features/sketch"
 import extrude "../../features/extrude"
 import cut "../../features/cut"
 import revolve "../../features/revolve"
+import primitives "../../features/primitives"
 import m "../../core/math"
 import occt "../../core/geometry/occt"
+import tess "../../core/tessellation"
 
 // Feature types
 FeatureType :: enum {
@@ -18,6 +23,8 @@ FeatureType :: enum {
     Revolve,  // Revolve operation (future)
     Fillet,   // Fillet operation (future)
     Chamfer,  // Chamfer operation (future)
+    Move,     // Rigid move of a body (placement only - no re-meshing)
+    CopyBody, // Rigidly placed copy of a body (the original stays)
 }
 
 // Feature status
@@ -34,6 +41,7 @@ FeatureParams :: union {
     ExtrudeParams,
     CutParams,
     RevolveParams,
+    TransformParams,
 }
 
 // Sketch feature parameters
@@ -55,6 +63,8 @@ CutParams :: struct {
     direction: cut.CutDirection,       // Cut direction
     sketch_feature_id: int,            // ID of sketch to cut with
     base_feature_id: int,              // ID of solid to cut from
+    simplify: bool,                    // Merge split faces/seam edges after the boolean
+    simplify_params: occt.SimplifyParams,  // Cleanup tolerances
 }
 
 // Revolve feature parameters
@@ -65,6 +75,58 @@ RevolveParams :: struct {
     sketch_feature_id: int,              // ID of sketch to revolve
 }
 
+// Move / copy-body parameters (rotation about an axis through pivot, then translation)
+TransformParams :: struct {
+    base_feature_id: int,   // ID of body to place
+    translation: m.Vec3,    // Offset applied after the rotation
+    axis: m.Vec3,           // Rotation axis (zero = no rotation)
+    angle: f64,             // Rotation angle in degrees
+    pivot: m.Vec3,          // Point the rotation axis passes through
+}
+
+// Which representation of a feature's result a consumer wants
+RepresentationContext :: enum {
+    Display,     // Viewport - simplified when the part is small on screen
+    Export,      // Exact geometry (manufacturing export)
+    Simulation,  // Simplified whenever available (downstream analysis)
+}
+
+// Below this on-screen size (bounding-box diagonal in pixels) the viewport draws the simplified rep
+SIMPLIFIED_SCREEN_SIZE_PX :: 150.0
+
+// Mesh-only bodies (no exact B-Rep) get a decimated rep with this fraction of the triangles
+MESH_LOD_RATIO :: 0.25
+
+// Defeatured copy of a feature result, cached next to the exact geometry
+SimplifiedRep :: struct {
+    enabled: bool,                      // Build/keep the simplified rep on regeneration
+    params: occt.DefeatureParams,       // Which faces to strip
+    shape: occt.Shape,                  // Defeatured B-Rep (owned)
+    solid: ^extrude.SimpleSolid,        // Tessellated defeatured mesh (owned)
+    faces_removed: int,                 // Faces stripped from the exact shape
+    extent: f64,                        // Bounding-box diagonal of the exact result (model units)
+}
+
+// Rigid placement of a move/copy-body result
+// result_solid is another reference to the source body's tessellation, in its mesh space, and
+// occt_shape is the source B-Rep under a TopLoc_Location, so placing a body copies no geometry.
+// The viewport draws (and picks) through transform; feature_world_solid makes a world-space
+// copy for the consumers that read positions directly (export, mass properties).
+BodyPlacement :: struct {
+    placed: bool,
+    transform: m.Mat4,                  // Mesh space → world
+    source_id: int,                     // Feature that owns the tessellation (GPU mesh cache key)
+}
+
+// Exact per-face data of a feature's B-Rep (see feature_face_table)
+// Sketch-on-face, face picking and the face highlight read it instead of re-deriving
+// planes from the tessellation; rebuilt only when the shape or revision changes.
+FaceCache :: struct {
+    table: ^occt.FaceTable,             // Owned
+    shape: occt.Shape,                  // Shape the table describes (not owned)
+    revision: u64,                      // Feature revision the table was built at
+}
+
 // Feature node - represents a single operation in the design history
 FeatureNode :: struct {
     id: int,                        // Unique feature ID
@@ -78,11 +140,22 @@ FeatureNode :: struct {
 
     // Result data
     occt_shape: occt.Shape,                  // NEW: Exact B-Rep geometry for boolean/fillet/chamfer operations
-    result_solid: ^extrude.SimpleSolid,      // Tessellated mesh for rendering
+    result_solid: ^extrude.SimpleSolid,      // Tessellated mesh for rendering (mesh space when placed)
+    simplify_stats: occt.SimplifyStats,      // Face/edge reduction from last post-boolean cleanup
+    simplified: SimplifiedRep,               // Lightweight defeatured representation (optional)
+
+    // Analytic primitives: result_solid is generated from the parameters and occt_shape
+    // stays nil until a boolean needs it (feature_ensure_shape)
+    primitive: primitives.PrimitiveParams,          // nil for sketch-based features
+    primitive_instance: primitives.PrimitiveInstance,  // Shared unit mesh + scale for instanced drawing
+
+    placement: BodyPlacement,       // Move/copy-body features: result is a placed source body
+    faces: FaceCache,               // Exact face table of occt_shape, built on first query
 
     // Metadata
     enabled: bool,                  // Is feature enabled?
     visible: bool,                  // Should result be visible?
+    revision: u64,                  // Bumped on regenerate/mark dirty (UI caches key off it)
 }
 
 // Feature tree - manages all features in order
@@ -90,6 +163,7 @@ FeatureTree :: struct {
     features: [dynamic]FeatureNode,  // All features in chronological order
     next_id: int,                    // Next available feature ID
     active_feature_id: int,          // Currently selected/active feature
+    revision: u64,                   // Bumped when features are added, removed or reordered
 }
 
 // =============================================================================
@@ -127,11 +201,12 @@ feature_node_destroy :: proc(node: ^FeatureNode) {
     }
 
     // Clean up result data (tessellated mesh)
-    if node.result_solid != nil {
-        result := extrude.ExtrudeResult{solid = node.result_solid}
-        extrude.extrude_result_destroy(&result)
-        node.result_solid = nil
-    }
+    extrude.simple_solid_release(&node.result_solid)
+    body_placement_clear(&node.placement)
+    face_cache_clear(&node.faces)
+
+    // Clean up simplified representation
+    simplified_rep_clear(&node.simplified)
 
     // Clean up parameters
     #partial switch &params in node.params {
@@ -172,6 +247,7 @@ feature_tree_add_sketch :: proc(tree: ^FeatureTree, sk: ^sketch.Sketch2D, name:
 
     tree.next_id += 1
     append(&tree.features, feature)
+    tree.revision += 1
     tree.active_feature_id = feature.id
 
     fmt.printf("✅ Added sketch feature '%s' (ID=%d)\n", name, feature.id)
@@ -221,6 +297,7 @@ feature_tree_add_extrude :: proc(
 
     tree.next_id += 1
     append(&tree.features, feature)
+    tree.revision += 1
     tree.active_feature_id = feature.id
 
     fmt.printf("✅ Added extrude feature '%s' (ID=%d, parent_sketch=%d)\n",
@@ -272,6 +349,8 @@ feature_tree_add_cut :: proc(
             direction = direction,
             sketch_feature_id = sketch_feature_id,
             base_feature_id = base_feature_id,
+            simplify = true,
+            simplify_params = occt.DEFAULT_SIMPLIFY,
         },
         status = .NeedsUpdate,  // Needs initial generation
         parent_features = make([dynamic]int),
@@ -286,6 +365,7 @@ feature_tree_add_cut :: proc(
 
     tree.next_id += 1
     append(&tree.features, feature)
+    tree.revision += 1
     tree.active_feature_id = feature.id
 
     fmt.printf("✅ Added cut feature '%s' (ID=%d, parent_sketch=%d, base=%d)\n",
@@ -338,6 +418,7 @@ feature_tree_add_revolve :: proc(
 
     tree.next_id += 1
     append(&tree.features, feature)
+    tree.revision += 1
     tree.active_feature_id = feature.id
 
     fmt.printf("✅ Added revolve feature '%s' (ID=%d, parent_sketch=%d, angle=%.1f°, segments=%d)\n",
@@ -346,6 +427,66 @@ feature_tree_add_revolve :: proc(
     return feature.id
 }
 
+// Add move feature to tree (the base body is consumed, like a cut's base)
+feature_tree_add_move :: proc(tree: ^FeatureTree, base_feature_id: int, translation: m.Vec3, name: string) -> int {
+    return feature_tree_add_placed_body(tree, .Move, base_feature_id, translation, name)
+}
+
+// Add copy-body feature to tree (the base body stays)
+feature_tree_add_copy_body :: proc(tree: ^FeatureTree, base_feature_id: int, translation: m.Vec3, name: string) -> int {
+    return feature_tree_add_placed_body(tree, .CopyBody, base_feature_id, translation, name)
+}
+
+@(private="file")
+feature_tree_add_placed_body :: proc(
+    tree: ^FeatureTree,
+    type: FeatureType,
+    base_feature_id: int,
+    translation: m.Vec3,
+    name: string,
+) -> int {
+
+    // Validate base feature exists and has a solid
+    base_feature := feature_tree_get_feature(tree, base_feature_id)
+    if base_feature == nil {
+        fmt.printf("❌ Cannot add %v: base feature %d not found\n", type, base_feature_id)
+        return -1
+    }
+
+    if base_feature.result_solid == nil {
+        fmt.printf("❌ Cannot add %v: base feature %d has no solid\n", type, base_feature_id)
+        return -1
+    }
+
+    feature := FeatureNode{
+        id = tree.next_id,
+        type = type,
+        name = name,
+        params = TransformParams{
+            base_feature_id = base_feature_id,
+            translation = translation,
+        },
+        status = .NeedsUpdate,  // Needs initial generation
+        parent_features = make([dynamic]int),
+        result_solid = nil,
+        enabled = true,
+        visible = true,
+    }
+
+    // Add dependency on base solid
+    append(&feature.parent_features, base_feature_id)
+
+    tree.next_id += 1
+    append(&tree.features, feature)
+    tree.revision += 1
+    tree.active_feature_id = feature.id
+
+    fmt.printf("✅ Added %v feature '%s' (ID=%d, base=%d, offset=(%.2f, %.2f, %.2f))\n",
+        type, name, feature.id, base_feature_id, translation.x, translation.y, translation.z)
+
+    return feature.id
+}
+
 // =============================================================================
 // Feature Queries
 // =============================================================================
@@ -376,6 +517,23 @@ feature_tree_set_active :: proc(tree: ^FeatureTree, feature_id: int) {
     }
 }
 
+// IDs of bodies consumed by later features (cut bases, moved bodies) - only the final
+// results are drawn and exported. Caller deletes the map.
+feature_tree_consumed_features :: proc(tree: ^FeatureTree, allocator := context.allocator) -> map[int]bool {
+    consumed := make(map[int]bool, allocator = allocator)
+    for feature in tree.features {
+        #partial switch params in feature.params {
+        case CutParams:
+            consumed[params.base_feature_id] = true
+        case TransformParams:
+            if feature.type == .Move {
+                consumed[params.base_feature_id] = true
+            }
+        }
+    }
+    return consumed
+}
+
 // Count features of a specific type
 feature_tree_count_type :: proc(tree: ^FeatureTree, type: FeatureType) -> int {
     count := 0
@@ -405,6 +563,7 @@ feature_regenerate :: proc(tree: ^FeatureTree, feature_id: int) -> bool {
     }
 
     fmt.printf("🔄 Regenerating feature %d (%s)...\n", feature_id, feature.name)
+    feature.revision += 1
 
     switch feature.type {
     case .Sketch:
@@ -413,13 +572,19 @@ feature_regenerate :: proc(tree: ^FeatureTree, feature_id: int) -> bool {
         return true
 
     case .Extrude:
-        return feature_regenerate_extrude(tree, feature)
+        if feature.primitive != nil {
+            return feature_refresh_simplified_rep(feature, feature_regenerate_primitive(feature))
+        }
+        return feature_refresh_simplified_rep(feature, feature_regenerate_extrude(tree, feature))
 
     case .Cut:
-        return feature_regenerate_cut(tree, feature)
+        return feature_refresh_simplified_rep(feature, feature_regenerate_cut(tree, feature))
 
     case .Revolve:
-        return feature_regenerate_revolve(tree, feature)
+        return feature_refresh_simplified_rep(feature, feature_regenerate_revolve(tree, feature))
+
+    case .Move, .CopyBody:
+        return feature_refresh_simplified_rep(feature, feature_regenerate_transform(tree, feature))
 
     case .Fillet, .Chamfer:
         fmt.println("❌ Feature type not yet implemented")
@@ -461,12 +626,8 @@ feature_regenerate_extrude :: proc(tree: ^FeatureTree, feature: ^FeatureNode) ->
         feature.occt_shape = nil
     }
 
-    // Clean up old result solid
-    if feature.result_solid != nil {
-        old_result := extrude.ExtrudeResult{solid = feature.result_solid}
-        extrude.extrude_result_destroy(&old_result)
-        feature.result_solid = nil
-    }
+    // Drop our reference to the old result solid (later features may still share it)
+    extrude.simple_solid_release(&feature.result_solid)
 
     // Perform extrusion
     extrude_params := extrude.ExtrudeParams{
@@ -492,6 +653,36 @@ feature_regenerate_extrude :: proc(tree: ^FeatureTree, feature: ^FeatureNode) ->
     return true
 }
 
+// Regenerate analytic primitive feature (mesh only - the exact shape is rebuilt on demand)
+feature_regenerate_primitive :: proc(feature: ^FeatureNode) -> bool {
+    // A cut sharing this base may be building the shape lazily on another worker
+    sync.mutex_lock(&primitive_shape_mutex)
+    if feature.occt_shape != nil {
+        occt.delete_shape(feature.occt_shape)
+        feature.occt_shape = nil
+    }
+    sync.mutex_unlock(&primitive_shape_mutex)
+
+    // Drop our reference to the old result solid (later features may still share it)
+    extrude.simple_solid_release(&feature.result_solid)
+    feature.primitive_instance = {}
+
+    result := primitives.create_primitive(feature.primitive)
+    if !result.success {
+        fmt.printf("❌ Primitive failed: %s\n", result.message)
+        feature.status = .Failed
+        return false
+    }
+
+    feature.result_solid = result.solid
+    feature.primitive_instance = result.instance
+    feature.status = .Valid
+
+    fmt.printf("✅ Primitive regenerated successfully\n")
+
+    return true
+}
+
 // Regenerate cut feature
 feature_regenerate_cut :: proc(tree: ^FeatureTree, feature: ^FeatureNode) -> bool {
     params, ok := feature.params.(CutParams)
@@ -531,8 +722,9 @@ feature_regenerate_cut :: proc(tree: ^FeatureTree, feature: ^FeatureNode) -> boo
         return false
     }
 
-    // Validate base feature has OCCT shape for exact boolean operations
-    if base_feature.occt_shape == nil {
+    // Validate base feature has OCCT shape for exact boolean operations (never the simplified rep)
+    base_shape := feature_get_shape(base_feature, .Export)
+    if base_shape == nil {
         fmt.printf("❌ Base feature %d has no OCCT shape (required for boolean operations)\n", params.base_feature_id)
         feature.status = .Failed
         return false
@@ -544,19 +736,21 @@ feature_regenerate_cut :: proc(tree: ^FeatureTree, feature: ^FeatureNode) -> boo
         feature.occt_shape = nil
     }
 
-    // Clean up old result solid
-    if feature.result_solid != nil {
-        old_result := cut.CutResult{solid = feature.result_solid}
-        cut.cut_result_destroy(&old_result)
-        feature.result_solid = nil
-    }
+    // Drop our reference to the old result solid (later features may still share it)
+    extrude.simple_solid_release(&feature.result_solid)
+
+    // The base shape is in world space, so a placed base's mesh has to be too
+    base_solid := feature_world_solid(base_feature)
+    defer extrude.simple_solid_release(&base_solid)
 
     // Perform cut with OCCT boolean operations
     cut_params := cut.CutParams{
         depth = params.depth,
         direction = params.direction,
-        base_solid = base_feature.result_solid,  // For backward compatibility (will be deprecated)
-        base_shape = base_feature.occt_shape,     // NEW: Exact B-Rep geometry for boolean operations
+        base_solid = base_solid,                  // For backward compatibility (will be deprecated)
+        base_shape = base_shape,                  // NEW: Exact B-Rep geometry for boolean operations
+        simplify = params.simplify,
+        simplify_params = params.simplify_params,
     }
 
     result := cut.cut_sketch(sketch_params.sketch_ref, cut_params)
@@ -570,9 +764,16 @@ feature_regenerate_cut :: proc(tree: ^FeatureTree, feature: ^FeatureNode) -> boo
     // Store both exact geometry and tessellated mesh
     feature.occt_shape = result.occt_shape    // Exact B-Rep result
     feature.result_solid = result.solid        // Tessellated mesh for rendering
+    feature.simplify_stats = result.simplify_stats
     feature.status = .Valid
 
-    fmt.printf("✅ Cut regenerated successfully\n")
+    if params.simplify {
+        stats := result.simplify_stats
+        fmt.printf("✅ Cut regenerated successfully (cleanup removed %d faces, %d edges)\n",
+            stats.faces_before - stats.faces_after, stats.edges_before - stats.edges_after)
+    } else {
+        fmt.printf("✅ Cut regenerated successfully\n")
+    }
 
     return true
 }
@@ -602,12 +803,8 @@ feature_regenerate_revolve :: proc(tree: ^FeatureTree, feature: ^FeatureNode) ->
         return false
     }
 
-    // Clean up old result
-    if feature.result_solid != nil {
-        old_result := revolve.RevolveResult{solid = feature.result_solid}
-        revolve.revolve_result_destroy(&old_result)
-        feature.result_solid = nil
-    }
+    // Drop our reference to the old result
+    extrude.simple_solid_release(&feature.result_solid)
 
     // Perform revolve
     revolve_params := revolve.RevolveParams{
@@ -635,19 +832,372 @@ feature_regenerate_revolve :: proc(tree: ^FeatureTree, feature: ^FeatureNode) ->
     return true
 }
 
-// Regenerate all features in tree (in order)
-feature_tree_regenerate_all :: proc(tree: ^FeatureTree) -> bool {
-    fmt.println("\n=== Regenerating All Features ===")
+// Regenerate move / copy-body feature
+// Only the placement is recomputed: the exact shape is relocated (TopLoc_Location) and the
+// result shares the source tessellation, so moving a body never re-meshes or copies it.
+feature_regenerate_transform :: proc(tree: ^FeatureTree, feature: ^FeatureNode) -> bool {
+    params, ok := feature.params.(TransformParams)
+    if !ok {
+        fmt.println("❌ Invalid transform parameters")
+        feature.status = .Failed
+        return false
+    }
 
-    success := true
+    // Get base feature
+    base_feature := feature_tree_get_feature(tree, params.base_feature_id)
+    if base_feature == nil {
+        fmt.printf("❌ Base feature %d not found\n", params.base_feature_id)
+        feature.status = .Failed
+        return false
+    }
 
-    for &feature in tree.features {
-        if !feature_regenerate(tree, feature.id) {
-            success = false
-            fmt.printf("⚠️  Feature %d (%s) failed to regenerate\n", feature.id, feature.name)
+    if base_feature.result_solid == nil {
+        fmt.printf("❌ Base feature %d has no solid\n", params.base_feature_id)
+        feature.status = .Failed
+        return false
+    }
+
+    // Clean up old OCCT shape and placement
+    if feature.occt_shape != nil {
+        occt.delete_shape(feature.occt_shape)
+        feature.occt_shape = nil
+    }
+    extrude.simple_solid_release(&feature.result_solid)
+    body_placement_clear(&feature.placement)
+
+    local := transform_params_matrix(params)
+
+    // Placing a placed body composes onto the original tessellation (its result_solid)
+    placement := BodyPlacement{placed = true, transform = local, source_id = base_feature.id}
+    if base_feature.placement.placed {
+        placement.transform = local * base_feature.placement.transform
+        placement.source_id = base_feature.placement.source_id
+    }
+
+    // Primitives keep building their exact shape lazily (feature_ensure_shape applies the placement)
+    feature.primitive = base_feature.primitive
+    feature.primitive_instance = base_feature.primitive_instance
+    if base_feature.occt_shape != nil {
+        feature.occt_shape = occt.locate_shape(base_feature.occt_shape, local)
+        if feature.occt_shape == nil {
+            fmt.println("❌ Failed to place exact shape")
+            feature.status = .Failed
+            return false
         }
     }
 
+    feature.placement = placement
+    feature.result_solid = extrude.simple_solid_retain(base_feature.result_solid)
+    feature.status = .Valid
+
+    fmt.printf("✅ %v regenerated successfully (placement only)\n", feature.type)
+
+    return true
+}
+
+// Rigid transform of a move / copy-body feature relative to its base
+transform_params_matrix :: proc(params: TransformParams) -> m.Mat4 {
+    result := glsl.dmat4Translate(params.translation)
+
+    if axis, ok := m.safe_normalize(params.axis); ok && params.angle != 0 {
+        rotation := glsl.dmat4Rotate(axis, math.to_radians(params.angle))
+        result = result * glsl.dmat4Translate(params.pivot) * rotation * glsl.dmat4Translate(-params.pivot)
+    }
+
+    return result
+}
+
+// Forget a body placement (the shared tessellation is released with result_solid)
+body_placement_clear :: proc(placement: ^BodyPlacement) {
+    placement^ = {}
+}
+
+// Mesh space → world matrix of a feature's result (identity unless the body is placed)
+feature_model_matrix :: proc(feature: ^FeatureNode) -> m.Mat4 {
+    if feature.placement.placed {
+        return feature.placement.transform
+    }
+    return m.Mat4(1)
+}
+
+// Position in a feature's mesh space → world
+feature_point_to_world :: proc(feature: ^FeatureNode, p: m.Vec3) -> m.Vec3 {
+    if !feature.placement.placed {
+        return p
+    }
+    return (feature.placement.transform * m.Vec4{p.x, p.y, p.z, 1}).xyz
+}
+
+// Direction in a feature's mesh space → world (placements are rigid, so lengths are kept)
+feature_direction_to_world :: proc(feature: ^FeatureNode, d: m.Vec3) -> m.Vec3 {
+    if !feature.placement.placed {
+        return d
+    }
+    return (feature.placement.transform * m.Vec4{d.x, d.y, d.z, 0}).xyz
+}
+
+// World-space mesh of a feature for consumers that read positions directly (export, mass
+// properties, mesh fallbacks of booleans). Placed bodies get a transformed copy, everything
+// else another reference to the stored mesh; release it with extrude.simple_solid_release.
+feature_world_solid :: proc(feature: ^FeatureNode, ctx: RepresentationContext = .Export) -> ^extrude.SimpleSolid {
+    solid := feature_get_solid(feature, ctx)
+    if solid == nil {
+        return nil
+    }
+    if feature.placement.placed {
+        return extrude.simple_solid_transformed(solid, feature.placement.transform)
+    }
+    return extrude.simple_solid_retain(solid)
+}
+
+// =============================================================================
+// Simplified Representation (Defeaturing)
+// =============================================================================
+
+// Release cached simplified geometry (keeps enabled/params)
+simplified_rep_clear :: proc(rep: ^SimplifiedRep) {
+    if rep.shape != nil {
+        occt.delete_shape(rep.shape)
+        rep.shape = nil
+    }
+
+    extrude.simple_solid_release(&rep.solid)
+
+    rep.faces_removed = 0
+    rep.extent = 0
+}
+
+// Rebuild the simplified rep from the feature's exact shape
+// Mesh-only features (no exact shape) get a QEM-decimated mesh instead; a shape with no
+// faces to strip keeps an empty rep, so consumers get the exact shape and mesh
+// Returns false if defeaturing/decimation fails (exact result is still used)
+feature_update_simplified_rep :: proc(feature: ^FeatureNode) -> bool {
+    rep := &feature.simplified
+    simplified_rep_clear(rep)
+
+    if !rep.enabled || feature.result_solid == nil {
+        return false
+    }
+
+    if feature.occt_shape == nil {
+        return feature_update_decimated_rep(feature)
+    }
+
+    shape, removed := occt.defeature_shape(feature.occt_shape, rep.params)
+    if shape == nil {
+        fmt.printf("⚠️  Defeaturing failed for feature %d (%s), using exact geometry\n", feature.id, feature.name)
+        return false
+    }
+
+    // Nothing stripped: the simplified rep would be an identical re-tessellation, so leave it
+    // empty and let feature_get_solid/feature_get_shape hand out the exact shape and mesh
+    if removed == 0 {
+        occt.delete_shape(shape)
+        fmt.printf("🔧 Simplified rep for feature %d: nothing to strip, reusing exact geometry\n", feature.id)
+        return true
+    }
+
+    mesh := occt.OCCT_Tessellate(shape, occt.DEFAULT_TESSELLATION)
+    if mesh == nil {
+        fmt.printf("⚠️  Failed to tessellate simplified rep for feature %d\n", feature.id)
+        occt.delete_shape(shape)
+        return false
+    }
+    defer occt.delete_mesh(mesh)
+
+    solid := cut.occt_mesh_to_simple_solid(mesh)
+    if solid == nil {
+        occt.delete_shape(shape)
+        return false
+    }
+
+    // A placed body's shape carries its location, but its meshes are drawn in mesh space
+    if feature.placement.placed {
+        world := solid
+        solid = extrude.simple_solid_transformed(world, glsl.inverse(feature.placement.transform))
+        extrude.simple_solid_release(&world)
+    }
+
+    bbox := cut.compute_bounding_box(feature.result_solid)
+    d := bbox.max - bbox.min
+
+    rep.shape = shape
+    rep.solid = solid
+    rep.faces_removed = removed
+    rep.extent = math.sqrt(d.x*d.x + d.y*d.y + d.z*d.z)
+
+    fmt.printf("✅ Simplified rep for feature %d: removed %d faces, %d → %d triangles\n",
+        feature.id, removed, len(feature.result_solid.triangles), len(solid.triangles))
+
+    return true
+}
+
+// Simplified rep for mesh-only features: decimate the tessellation, keeping face boundaries
+@(private)
+feature_update_decimated_rep :: proc(feature: ^FeatureNode) -> bool {
+    rep := &feature.simplified
+
+    params := tess.DEFAULT_DECIMATE
+    params.target_triangles = int(f64(len(feature.result_solid.triangles)) * MESH_LOD_RATIO)
+
+    solid, stats := extrude.simple_solid_decimate(feature.result_solid, params)
+    if solid == nil || stats.triangles_after >= stats.triangles_before {
+        extrude.simple_solid_release(&solid)
+        return false
+    }
+
+    bbox := cut.compute_bounding_box(feature.result_solid)
+    d := bbox.max - bbox.min
+
+    rep.solid = solid
+    rep.extent = math.sqrt(d.x*d.x + d.y*d.y + d.z*d.z)
+
+    fmt.printf("✅ Decimated rep for feature %d: %d → %d triangles (max error %.4f)\n",
+        feature.id, stats.triangles_before, stats.triangles_after, stats.max_error)
+
+    return true
+}
+
+// Keep the simplified rep in sync after a regeneration attempt; passes through the regeneration result
+@(private)
+feature_refresh_simplified_rep :: proc(feature: ^FeatureNode, regenerated: bool) -> bool {
+    if regenerated && feature.simplified.enabled {
+        feature_update_simplified_rep(feature)
+    } else {
+        simplified_rep_clear(&feature.simplified)
+    }
+    return regenerated
+}
+
+// Enable/disable the simplified representation for a feature and rebuild it
+feature_tree_set_simplified_rep :: proc(
+    tree: ^FeatureTree,
+    feature_id: int,
+    enabled: bool,
+    params: occt.DefeatureParams = occt.DEFAULT_DEFEATURE,
+) -> bool {
+    feature := feature_tree_get_feature(tree, feature_id)
+    if feature == nil {
+        return false
+    }
+
+    feature.simplified.enabled = enabled
+    feature.simplified.params = params
+
+    if !enabled {
+        simplified_rep_clear(&feature.simplified)
+        fmt.printf("🔧 Simplified rep disabled for feature %d (%s)\n", feature.id, feature.name)
+        return true
+    }
+
+    return feature_update_simplified_rep(feature)
+}
+
+// Pick exact or simplified solid for a consumer
+// pixel_size_world: world size of one screen pixel (only used for .Display)
+feature_get_solid :: proc(
+    feature: ^FeatureNode,
+    ctx: RepresentationContext,
+    pixel_size_world: f64 = 0,
+) -> ^extrude.SimpleSolid {
+    rep := &feature.simplified
+    if rep.solid == nil {
+        return feature.result_solid
+    }
+
+    switch ctx {
+    case .Export:
+        return feature.result_solid
+    case .Simulation:
+        return rep.solid
+    case .Display:
+        if pixel_size_world > 0 && rep.extent / pixel_size_world < SIMPLIFIED_SCREEN_SIZE_PX {
+            return rep.solid
+        }
+    }
+
+    return feature.result_solid
+}
+
+// Guards lazy primitive shape creation (cuts sharing a base may regenerate concurrently)
+@(private="file")
+primitive_shape_mutex: sync.Mutex
+
+// Exact B-Rep of a feature, building it from the primitive parameters on first use
+// Returns nil for mesh-only features or if the shape cannot be built.
+feature_ensure_shape :: proc(feature: ^FeatureNode) -> occt.Shape {
+    if feature.primitive == nil {
+        return feature.occt_shape
+    }
+
+    sync.mutex_lock(&primitive_shape_mutex)
+    defer sync.mutex_unlock(&primitive_shape_mutex)
+
+    if feature.occt_shape == nil {
+        feature.occt_shape = primitives.primitive_build_shape(feature.primitive)
+
+        // Moved/copied primitive: relocate the freshly built shape (shares its B-Rep)
+        if feature.occt_shape != nil && feature.placement.placed {
+            unplaced := feature.occt_shape
+            feature.occt_shape = occt.locate_shape(unplaced, feature.placement.transform)
+            occt.delete_shape(unplaced)
+        }
+
+        if feature.occt_shape != nil {
+            fmt.printf("🔧 Built exact shape for primitive feature %d (%s)\n", feature.id, feature.name)
+        }
+    }
+    return feature.occt_shape
+}
+
+// Exact face table of a feature, enumerating its B-Rep faces on first use
+// Cached until the feature regenerates; nil for mesh-only features or on failure.
+// Face indices match occt.count_faces order and stay valid until the next regeneration.
+feature_face_table :: proc(feature: ^FeatureNode) -> ^occt.FaceTable {
+    shape := feature_ensure_shape(feature)
+    cache := &feature.faces
+
+    if cache.table != nil && cache.shape == shape && cache.revision == feature.revision {
+        return cache.table
+    }
+
+    face_cache_clear(cache)
+    if shape == nil do return nil
+
+    cache.table = occt.face_table(shape)
+    if cache.table == nil {
+        fmt.printf("⚠️  Failed to enumerate faces of feature %d (%s)\n", feature.id, feature.name)
+        return nil
+    }
+
+    cache.shape = shape
+    cache.revision = feature.revision
+    fmt.printf("🔧 Face table for feature %d (%s): %d faces\n", feature.id, feature.name, cache.table.num_faces)
+    return cache.table
+}
+
+// Release a cached face table
+face_cache_clear :: proc(cache: ^FaceCache) {
+    occt.delete_face_table(cache.table)
+    cache^ = {}
+}
+
+// Pick exact or simplified B-Rep for a consumer (see feature_get_solid)
+feature_get_shape :: proc(feature: ^FeatureNode, ctx: RepresentationContext) -> occt.Shape {
+    if ctx == .Simulation && feature.simplified.shape != nil {
+        return feature.simplified.shape
+    }
+    return feature_ensure_shape(feature)
+}
+
+// Regenerate all features in tree
+// Independent branches (e.g. separate bodies from separate sketches) regenerate concurrently;
+// see feature_tree_regenerate_parallel. Pass workers = 1 for strict tree order on one thread.
+feature_tree_regenerate_all :: proc(tree: ^FeatureTree, workers: int = 0) -> bool {
+    fmt.println("\n=== Regenerating All Features ===")
+
+    success := feature_tree_regenerate_parallel(tree, workers)
+
     if success {
         fmt.println("✅ All features regenerated successfully")
     } else {
@@ -665,6 +1215,7 @@ feature_tree_mark_dirty :: proc(tree: ^FeatureTree, feature_id: int) {
     }
 
     // Mark this feature
+    feature.revision += 1
     if feature.status == .Valid {
         feature.status = .NeedsUpdate
         fmt.printf("🔄 Marked feature %d (%s) as needing update\n", feature.id, feature.name)
@@ -741,6 +1292,36 @@ change_cut_depth :: proc(tree: ^FeatureTree, feature_id: int, new_depth: f64) ->
     return true
 }
 
+// Enable/disable post-boolean topology cleanup for a cut
+set_cut_simplify :: proc(tree: ^FeatureTree, feature_id: int, enabled: bool) -> bool {
+    feature := feature_tree_get_feature(tree, feature_id)
+    if feature == nil {
+        return false
+    }
+
+    if feature.type != .Cut {
+        fmt.println("❌ Feature is not a cut")
+        return false
+    }
+
+    params, ok := &feature.params.(CutParams)
+    if !ok {
+        return false
+    }
+
+    if params.simplify == enabled {
+        return true
+    }
+
+    params.simplify = enabled
+    fmt.printf("🔧 Cut topology cleanup: %s\n", enabled ? "enabled" : "disabled")
+
+    // Mark feature as needing update
+    feature_tree_mark_dirty(tree, feature_id)
+
+    return true
+}
+
 // Change revolve angle
 change_revolve_angle :: proc(tree: ^FeatureTree, feature_id: int, new_angle: f64) -> bool {
     feature := feature_tree_get_feature(tree, feature_id)
@@ -777,6 +1358,52 @@ change_revolve_angle :: proc(tree: ^FeatureTree, feature_id: int, new_angle: f64
     return true
 }
 
+// Change the offset of a move / copy-body feature (regeneration only relocates - no re-meshing)
+change_body_translation :: proc(tree: ^FeatureTree, feature_id: int, translation: m.Vec3) -> bool {
+    feature := feature_tree_get_feature(tree, feature_id)
+    if feature == nil {
+        return false
+    }
+
+    params, ok := &feature.params.(TransformParams)
+    if !ok {
+        fmt.println("❌ Feature is not a move or copy-body")
+        return false
+    }
+
+    params.translation = translation
+
+    // Mark feature as needing update
+    feature_tree_mark_dirty(tree, feature_id)
+
+    return true
+}
+
+// Change the rotation of a move / copy-body feature (angle in degrees about axis through pivot)
+change_body_rotation :: proc(tree: ^FeatureTree, feature_id: int, axis: m.Vec3, angle: f64, pivot: m.Vec3) -> bool {
+    feature := feature_tree_get_feature(tree, feature_id)
+    if feature == nil {
+        return false
+    }
+
+    params, ok := &feature.params.(TransformParams)
+    if !ok {
+        fmt.println("❌ Feature is not a move or copy-body")
+        return false
+    }
+
+    params.axis = axis
+    params.angle = angle
+    params.pivot = pivot
+
+    fmt.printf("🔁 Changed body rotation: %.1f° about (%.2f, %.2f, %.2f)\n", angle, axis.x, axis.y, axis.z)
+
+    // Mark feature as needing update
+    feature_tree_mark_dirty(tree, feature_id)
+
+    return true
+}
+
 // =============================================================================
 // Debugging & Display
 // =============================================================================
@@ -806,6 +1433,11 @@ feature_tree_print :: proc(tree: ^FeatureTree) {
             fmt.printf("      Parents: %v\n", feature.parent_features)
         }
 
+        if feature.simplified.solid != nil {
+            fmt.printf("      Simplified: %d faces removed, %d triangles\n",
+                feature.simplified.faces_removed, len(feature.simplified.solid.triangles))
+        }
+
         // Print type-specific info
         #partial switch params in feature.params {
         case SketchParams:
@@ -830,6 +1462,18 @@ feature_tree_print :: proc(tree: ^FeatureTree) {
                     len(feature.result_solid.vertices),
                     len(feature.result_solid.edges))
             }
+            if params.simplify && feature.occt_shape != nil {
+                stats := feature.simplify_stats
+                fmt.printf("      Cleanup: faces %d → %d, edges %d → %d\n",
+                    stats.faces_before, stats.faces_after, stats.edges_before, stats.edges_after)
+            }
+        case TransformParams:
+            fmt.printf("      Base: %d, Offset: (%.3f, %.3f, %.3f), Rotation: %.1f°\n",
+                params.base_feature_id, params.translation.x, params.translation.y, params.translation.z, params.angle)
+            if feature.placement.placed {
+                fmt.printf("      Draws feature %d's mesh (%d triangles) through its placement\n",
+                    feature.placement.source_id, len(feature.result_solid.triangles))
+            }
         }
     }
 
@@ -0,0 +1,466 @@
+// features/primitives - Analytic primitive tessellation
+// Box, cylinder, sphere, cone and torus meshes are generated straight from their surfaces
+// instead of building the OCCT solid and running BRepMesh on it. Segment counts follow the
+// same linear/angular deflection as occt.TessellationParams, every triangle carries the id
+// of the B-Rep face it lies on, and its normal is the exact surface normal at the center of
+// its parameter cell.
+//
+// Meshes are built once per unit shape (radius/height 1, keyed by segment counts and the
+// radius ratios scaling cannot express, snapped to a deflection-sized grid) and cached.
+// A primitive is an instance: a shared unit template plus a per-axis scale. The viewport
+// draws the template with a model matrix; the world-space SimpleSolid (picking, export,
+// sketch-on-face) is a scaled copy.
+package ohcad_primitives
+
+import "core:fmt"
+import "core:math"
+import "core:sync"
+import m "../../core/math"
+import glsl "core:math/linalg/glsl"
+import occt "../../core/geometry/occt"
+import extrude "../../features/extrude"
+
+// Segment count limits for one full turn
+PRIMITIVE_MIN_SEGMENTS :: 8
+PRIMITIVE_MAX_SEGMENTS :: 512
+
+// Radius ratio grid limits (steps per unit) - bounds the number of cone/torus templates
+PRIMITIVE_MIN_RATIO_STEPS :: 64
+PRIMITIVE_MAX_RATIO_STEPS :: 4096
+
+// =============================================================================
+// Types
+// =============================================================================
+
+// Identifies a unit template - equal keys share one mesh
+PrimitiveTemplateKey :: struct {
+    type: PrimitiveType,
+    around: int,    // Segments around the Z axis (0 for boxes)
+    along: int,     // Segments along the profile: height, meridian or tube (0 for boxes)
+    shape: [2]f64,  // Unit-space radii: cone (bottom, top), torus (tube, 0)
+}
+
+TemplateTriangle :: struct {
+    indices: [3]int,  // Into PrimitiveTemplate.positions
+    normal: m.Vec3,   // Unit-space surface normal
+    face_id: int,
+}
+
+// Planar face (selection/sketching); vertices are face_vertices[first:first + count]
+TemplateFace :: struct {
+    first, count: int,
+    normal: m.Vec3,
+    center: m.Vec3,
+    name: string,
+}
+
+// Unit-space mesh shared by every primitive with the same key
+PrimitiveTemplate :: struct {
+    id: int,                        // Stable per-process index (GPU mesh cache key)
+    key: PrimitiveTemplateKey,
+    positions: [dynamic]m.Vec3,
+    triangles: [dynamic]TemplateTriangle,
+    faces: [dynamic]TemplateFace,
+    face_vertices: [dynamic]int,
+    edges: [dynamic][2]int,         // B-Rep edges (box edges, cap circles, seams)
+    face_count: int,                // Number of B-Rep faces (face ids are 0..<face_count)
+    mesh: ^extrude.SimpleSolid,     // Unit-space solid drawn by instances
+}
+
+// A primitive = shared unit template + per-axis scale (model matrix diag(scale))
+PrimitiveInstance :: struct {
+    template: ^PrimitiveTemplate,
+    scale: m.Vec3,
+}
+
+@(private="file")
+template_cache: struct {
+    mutex: sync.Mutex,  // Primitives may be (re)generated from regeneration workers
+    templates: map[PrimitiveTemplateKey]^PrimitiveTemplate,
+}
+
+// =============================================================================
+// Instances
+// =============================================================================
+
+// Number of segments that keeps a circle of `radius` within the deflection limits
+primitive_segments :: proc(radius: f64, tess: occt.TessellationParams) -> int {
+    step := tess.angular_deflection > 0 ? tess.angular_deflection : math.TAU
+
+    linear := tess.linear_deflection
+    if tess.relative {
+        linear *= 2 * radius
+    }
+    if linear > 0 && linear < radius {
+        // Chord sagitta: d = r (1 - cos(step / 2))
+        step = min(step, 2 * math.acos(1 - linear / radius))
+    }
+
+    n := int(math.ceil(math.TAU / step))
+    return clamp(n, PRIMITIVE_MIN_SEGMENTS, PRIMITIVE_MAX_SEGMENTS)
+}
+
+// Snap a unit-space radius ratio to a grid no finer than the deflection needs
+// The step is a power of two between 1/PRIMITIVE_MAX_RATIO_STEPS and 1/PRIMITIVE_MIN_RATIO_STEPS,
+// so while the user drags a radius only a bounded set of templates is ever created, and the
+// snapped shape stays within half the linear deflection of the exact one.
+primitive_quantize_ratio :: proc(ratio, radius: f64, tess: occt.TessellationParams) -> f64 {
+    linear := tess.linear_deflection
+    if tess.relative {
+        linear *= 2 * radius
+    }
+
+    steps := f64(PRIMITIVE_MAX_RATIO_STEPS)
+    if linear > 0 && radius > 0 {
+        steps = math.pow(2, math.ceil(math.log2(radius / linear)))
+    }
+    steps = clamp(steps, PRIMITIVE_MIN_RATIO_STEPS, PRIMITIVE_MAX_RATIO_STEPS)
+    // A nonzero ratio (torus tube, cone tip) never collapses to a degenerate 0
+    return max(math.round(ratio * steps), ratio > 0 ? 1 : 0) / steps
+}
+
+// Unit template and scale for a primitive (parameters must already be valid)
+primitive_instance :: proc(params: PrimitiveParams, tess: occt.TessellationParams) -> PrimitiveInstance {
+    key: PrimitiveTemplateKey
+    scale: m.Vec3
+
+    switch p in params {
+    case BoxParams:
+        key = {type = .Box}
+        scale = {p.width, p.height, p.depth}
+
+    case CylinderParams:
+        key = {type = .Cylinder, around = primitive_segments(p.radius, tess), along = 1}
+        scale = {p.radius, p.radius, p.height}
+
+    case SphereParams:
+        around := primitive_segments(p.radius, tess)
+        key = {type = .Sphere, around = around, along = max(around / 2, 2)}
+        scale = {p.radius, p.radius, p.radius}
+
+    case ConeParams:
+        r := max(p.bottom_radius, p.top_radius)
+        key = {
+            type = .Cone,
+            around = primitive_segments(r, tess),
+            along = 1,
+            shape = {
+                primitive_quantize_ratio(p.bottom_radius / r, r, tess),
+                primitive_quantize_ratio(p.top_radius / r, r, tess),
+            },
+        }
+        scale = {r, r, p.height}
+
+    case TorusParams:
+        key = {
+            type = .Torus,
+            around = primitive_segments(p.major_radius + p.minor_radius, tess),
+            along = primitive_segments(p.minor_radius, tess),
+            shape = {primitive_quantize_ratio(p.minor_radius / p.major_radius, p.major_radius, tess), 0},
+        }
+        scale = {p.major_radius, p.major_radius, p.major_radius}
+    }
+
+    return PrimitiveInstance{template = primitive_template_acquire(key), scale = scale}
+}
+
+// World-space solid for an instance (caller owns it - release with destroy_primitive)
+primitive_instance_solid :: proc(instance: PrimitiveInstance) -> ^extrude.SimpleSolid {
+    t := instance.template
+    s := instance.scale
+    inv := m.Vec3{1 / s.x, 1 / s.y, 1 / s.z}  // Normals transform by the inverse transpose of diag(s)
+
+    solid := new(extrude.SimpleSolid)
+    reserve(&solid.vertices, len(t.positions))
+    reserve(&solid.triangles, len(t.triangles))
+    reserve(&solid.edges, len(t.edges))
+    reserve(&solid.faces, len(t.faces))
+
+    for p in t.positions {
+        vertex := new(extrude.Vertex)
+        vertex.position = p * s
+        append(&solid.vertices, vertex)
+    }
+
+    for tri in t.triangles {
+        append(&solid.triangles, extrude.Triangle3D{
+            v0 = solid.vertices[tri.indices[0]].position,
+            v1 = solid.vertices[tri.indices[1]].position,
+            v2 = solid.vertices[tri.indices[2]].position,
+            normal = glsl.normalize(tri.normal * inv),
+            face_id = tri.face_id,
+        })
+    }
+
+    for e in t.edges {
+        edge := new(extrude.Edge)
+        edge.v0 = solid.vertices[e[0]]
+        edge.v1 = solid.vertices[e[1]]
+        append(&solid.edges, edge)
+    }
+
+    for f in t.faces {
+        face := extrude.SimpleFace{
+            vertices = make([dynamic]^extrude.Vertex, 0, f.count),
+            normal = glsl.normalize(f.normal * inv),
+            center = f.center * s,
+            name = f.name,
+        }
+        for index in t.face_vertices[f.first:][:f.count] {
+            append(&face.vertices, solid.vertices[index])
+        }
+        append(&solid.faces, face)
+    }
+
+    return solid
+}
+
+// =============================================================================
+// Template Cache
+// =============================================================================
+
+// Shared template for key, built on first use
+primitive_template_acquire :: proc(key: PrimitiveTemplateKey) -> ^PrimitiveTemplate {
+    sync.mutex_lock(&template_cache.mutex)
+    defer sync.mutex_unlock(&template_cache.mutex)
+
+    if t, found := template_cache.templates[key]; found {
+        return t
+    }
+
+    t := new(PrimitiveTemplate)
+    t.id = len(template_cache.templates)
+    t.key = key
+
+    switch key.type {
+    case .Box:
+        build_box_template(t)
+    case .Cylinder, .Sphere, .Cone, .Torus:
+        build_revolved_template(t)
+    }
+
+    t.mesh = primitive_instance_solid(PrimitiveInstance{template = t, scale = {1, 1, 1}})
+    template_cache.templates[key] = t
+
+    fmt.printf("🧩 Primitive template %d (%v, %d x %d): %d triangles, %d faces\n",
+        t.id, key.type, key.around, key.along, len(t.triangles), t.face_count)
+    return t
+}
+
+// Number of cached templates
+primitive_template_count :: proc() -> int {
+    sync.mutex_lock(&template_cache.mutex)
+    defer sync.mutex_unlock(&template_cache.mutex)
+    return len(template_cache.templates)
+}
+
+// Free all templates (shutdown - no instance may be drawn afterwards)
+primitive_template_cache_destroy :: proc() {
+    sync.mutex_lock(&template_cache.mutex)
+    defer sync.mutex_unlock(&template_cache.mutex)
+
+    for _, t in template_cache.templates {
+        extrude.simple_solid_release(&t.mesh)
+        delete(t.positions)
+        delete(t.triangles)
+        delete(t.faces)
+        delete(t.face_vertices)
+        delete(t.edges)
+        free(t)
+    }
+    delete(template_cache.templates)
+    template_cache.templates = nil
+}
+
+// =============================================================================
+// Template Builders
+// =============================================================================
+
+// Unit cube [0,1]^3 (matches BRepPrimAPI_MakeBox: corner at the origin)
+@(private="file")
+build_box_template :: proc(t: ^PrimitiveTemplate) {
+    for i in 0..<8 {
+        append(&t.positions, m.Vec3{f64(i & 1), f64((i >> 1) & 1), f64((i >> 2) & 1)})
+    }
+
+    // Corners listed counter-clockwise around the outward normal
+    BoxFace :: struct { corners: [4]int, normal: m.Vec3, name: string }
+    faces := [6]BoxFace{
+        {{0, 4, 6, 2}, {-1, 0, 0}, "Left"},
+        {{1, 3, 7, 5}, { 1, 0, 0}, "Right"},
+        {{0, 1, 5, 4}, {0, -1, 0}, "Front"},
+        {{2, 6, 7, 3}, {0,  1, 0}, "Back"},
+        {{0, 2, 3, 1}, {0, 0, -1}, "Bottom"},
+        {{4, 5, 7, 6}, {0, 0,  1}, "Top"},
+    }
+
+    for f, face_id in faces {
+        c := f.corners
+        append(&t.triangles, TemplateTriangle{{c[0], c[1], c[2]}, f.normal, face_id})
+        append(&t.triangles, TemplateTriangle{{c[0], c[2], c[3]}, f.normal, face_id})
+
+        center := (t.positions[c[0]] + t.positions[c[2]]) * 0.5
+        add_face(t, c[:], f.normal, center, f.name)
+    }
+    t.face_count = len(faces)
+
+    // Corners differing in exactly one coordinate
+    for a in 0..<8 {
+        for bit in ([3]int{1, 2, 4}) {
+            if a & bit == 0 {
+                append(&t.edges, [2]int{a, a | bit})
+            }
+        }
+    }
+}
+
+// Surfaces of revolution about Z: grid of rings (one vertex for rings on the axis),
+// plus planar caps for cylinders and cones
+@(private="file")
+build_revolved_template :: proc(t: ^PrimitiveTemplate) {
+    key := t.key
+    around := key.around
+    closed := key.type == .Torus           // Profile wraps (tube circle)
+    ring_count := closed ? key.along : key.along + 1
+
+    ring_start := make([]int, ring_count, context.temp_allocator)
+    ring_single := make([]bool, ring_count, context.temp_allocator)
+
+    for j in 0..<ring_count {
+        r, z, _ := revolved_profile(key, f64(j) / f64(key.along))
+        ring_start[j] = len(t.positions)
+        ring_single[j] = r < 1e-12
+
+        if ring_single[j] {
+            append(&t.positions, m.Vec3{0, 0, z})
+            continue
+        }
+        for i in 0..<around {
+            u := math.TAU * f64(i) / f64(around)
+            append(&t.positions, m.Vec3{r * math.cos(u), r * math.sin(u), z})
+        }
+    }
+
+    ring_vertex :: proc(start: []int, single: []bool, j, i, around: int) -> int {
+        return single[j] ? start[j] : start[j] + i % around
+    }
+
+    // Lateral surface - face 0
+    for j in 0..<key.along {
+        j1 := (j + 1) % ring_count
+        for i in 0..<around {
+            a := ring_vertex(ring_start, ring_single, j, i, around)
+            b := ring_vertex(ring_start, ring_single, j, i + 1, around)
+            c := ring_vertex(ring_start, ring_single, j1, i + 1, around)
+            d := ring_vertex(ring_start, ring_single, j1, i, around)
+
+            // Surface normal at the center of the parameter cell
+            u := math.TAU * (f64(i) + 0.5) / f64(around)
+            _, _, n := revolved_profile(key, (f64(j) + 0.5) / f64(key.along))
+            normal := m.Vec3{n.x * math.cos(u), n.x * math.sin(u), n.y}
+
+            if !ring_single[j] {
+                add_triangle(t, a, b, c, normal, 0)
+            }
+            if !ring_single[j1] {
+                add_triangle(t, a, c, d, normal, 0)
+            }
+        }
+    }
+    t.face_count = 1
+
+    // Planar caps (cylinder/cone ends that are not a point)
+    if key.type == .Cylinder || key.type == .Cone {
+        for j in ([2]int{0, ring_count - 1}) {
+            if ring_single[j] do continue
+
+            z := t.positions[ring_start[j]].z
+            normal := m.Vec3{0, 0, j == 0 ? -1 : 1}
+            face_id := t.face_count
+            t.face_count += 1
+
+            center := len(t.positions)
+            append(&t.positions, m.Vec3{0, 0, z})
+
+            ring := make([]int, around, context.temp_allocator)
+            for i in 0..<around {
+                ring[i] = ring_start[j] + i
+                add_triangle(t, center, ring_start[j] + i, ring_start[j] + (i + 1) % around, normal, face_id)
+                append(&t.edges, [2]int{ring_start[j] + i, ring_start[j] + (i + 1) % around})
+            }
+
+            // Boundary counter-clockwise around the outward normal
+            if j == 0 {
+                for k in 0..<around / 2 {
+                    ring[k], ring[around - 1 - k] = ring[around - 1 - k], ring[k]
+                }
+            }
+            add_face(t, ring, normal, m.Vec3{0, 0, z}, j == 0 ? "Bottom" : "Top")
+        }
+    }
+
+    // Seams of the periodic surfaces (same edges OCCT reports)
+    #partial switch key.type {
+    case .Sphere:
+        for j in 0..<key.along {
+            append(&t.edges, [2]int{
+                ring_vertex(ring_start, ring_single, j, 0, around),
+                ring_vertex(ring_start, ring_single, j + 1, 0, around),
+            })
+        }
+    case .Torus:
+        for i in 0..<around {
+            append(&t.edges, [2]int{ring_start[0] + i, ring_start[0] + (i + 1) % around})
+        }
+        for j in 0..<ring_count {
+            append(&t.edges, [2]int{ring_start[j], ring_start[(j + 1) % ring_count]})
+        }
+    }
+}
+
+// Profile of a unit surface of revolution at v in [0, 1]:
+// radius, height and the outward normal in the (radius, height) plane
+@(private="file")
+revolved_profile :: proc(key: PrimitiveTemplateKey, v: f64) -> (r, z: f64, normal: m.Vec2) {
+    #partial switch key.type {
+    case .Cylinder:
+        return 1, v, {1, 0}
+
+    case .Cone:
+        r0, r1 := key.shape[0], key.shape[1]
+        return r0 + (r1 - r0) * v, v, glsl.normalize(m.Vec2{1, r0 - r1})
+
+    case .Sphere:
+        phi := -math.PI / 2 + math.PI * v
+        return math.cos(phi), math.sin(phi), {math.cos(phi), math.sin(phi)}
+
+    case .Torus:
+        theta := math.TAU * v
+        a := key.shape[0]
+        return 1 + a * math.cos(theta), a * math.sin(theta), {math.cos(theta), math.sin(theta)}
+    }
+    return 0, 0, {}
+}
+
+// Append a triangle wound counter-clockwise around `normal`
+@(private="file")
+add_triangle :: proc(t: ^PrimitiveTemplate, a, b, c: int, normal: m.Vec3, face_id: int) {
+    p0, p1, p2 := t.positions[a], t.positions[b], t.positions[c]
+    if glsl.dot(glsl.cross(p1 - p0, p2 - p0), normal) < 0 {
+        append(&t.triangles, TemplateTriangle{{a, c, b}, normal, face_id})
+    } else {
+        append(&t.triangles, TemplateTriangle{{a, b, c}, normal, face_id})
+    }
+}
+
+@(private="file")
+add_face :: proc(t: ^PrimitiveTemplate, vertices: []int, normal, center: m.Vec3, name: string) {
+    append(&t.faces, TemplateFace{
+        first = len(t.face_vertices),
+        count = len(vertices),
+        normal = normal,
+        center = center,
+        name = name,
+    })
+    append(&t.face_vertices, ..vertices)
+}
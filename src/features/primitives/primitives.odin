@@ -1,5 +1,6 @@
 // features/primitives - Primitive Solid Creation
-// Creates basic 3D primitives (Box, Cylinder, Sphere, Cone, Torus) using OCCT
+// Creates basic 3D primitives (Box, Cylinder, Sphere, Cone, Torus). Meshes are generated
+// analytically (primitive_mesh.odin); the OCCT solid is only built when a boolean needs it.
 package ohcad_primitives
 
 import "core:fmt"
@@ -63,8 +64,9 @@ PrimitiveParams :: union {
 // =============================================================================
 
 PrimitiveResult :: struct {
-    occt_shape: occt.Shape,          // NEW: Exact B-Rep geometry for boolean/fillet/chamfer operations
-    solid:      ^extrude.SimpleSolid,  // Tessellated mesh for rendering
+    occt_shape: occt.Shape,             // Exact B-Rep - nil until a boolean needs it (see primitive_build_shape)
+    solid:      ^extrude.SimpleSolid,   // Analytic world-space mesh (picking, export, sketch-on-face)
+    instance:   PrimitiveInstance,      // Shared unit mesh + scale for instanced drawing
     success:    bool,                   // Operation success flag
     message:    string,                 // Error/status message
 }
@@ -73,128 +75,102 @@ PrimitiveResult :: struct {
 // Main Primitive Creation Function
 // =============================================================================
 
-create_primitive :: proc(params: PrimitiveParams) -> PrimitiveResult {
+// Tessellate a primitive analytically; the exact OCCT solid is not built here
+create_primitive :: proc(params: PrimitiveParams, tess := occt.DEFAULT_TESSELLATION) -> PrimitiveResult {
     result: PrimitiveResult
 
-    // Create OCCT shape based on primitive type
-    shape: occt.Shape = nil
+    if ok, message := validate_primitive(params); !ok {
+        result.message = message
+        return result
+    }
+
+    result.instance = primitive_instance(params, tess)
+    result.solid = primitive_instance_solid(result.instance)
+    result.success = true
+    result.message = "Primitive created successfully"
 
-    fmt.println("🔍 DEBUG: Starting primitive creation...")
+    fmt.printf("✓ Primitive created: %d vertices, %d triangles, %d faces (template %d)\n",
+        len(result.solid.vertices), len(result.solid.triangles), result.instance.template.face_count,
+        result.instance.template.id)
 
+    return result
+}
+
+// Build the exact OCCT solid for a primitive (nil on failure)
+// Same placement as the analytic mesh: box corner, cylinder/cone base at the origin, along +Z.
+primitive_build_shape :: proc(params: PrimitiveParams) -> occt.Shape {
+    if ok, message := validate_primitive(params); !ok {
+        fmt.printf("❌ %s\n", message)
+        return nil
+    }
+
+    shape: occt.Shape
+    switch p in params {
+    case BoxParams:
+        shape = occt.create_box(p.width, p.height, p.depth)
+    case CylinderParams:
+        shape = occt.create_cylinder(p.radius, p.height)
+    case SphereParams:
+        shape = occt.create_sphere(p.radius)
+    case ConeParams:
+        shape = occt.create_cone(p.bottom_radius, p.top_radius, p.height)
+    case TorusParams:
+        shape = occt.create_torus(p.major_radius, p.minor_radius)
+    }
+
+    if shape == nil {
+        fmt.println("❌ Failed to create OCCT shape for primitive")
+        return nil
+    }
+
+    if !occt.is_valid(shape) {
+        fmt.println("❌ OCCT primitive shape is invalid")
+        occt.delete_shape(shape)
+        return nil
+    }
+
+    return shape
+}
+
+// Check primitive dimensions; returns false and a message if they are invalid
+validate_primitive :: proc(params: PrimitiveParams) -> (bool, string) {
     switch p in params {
     case BoxParams:
-        fmt.printf("🔍 DEBUG: Creating Box (%.1f x %.1f x %.1f)\n", p.width, p.height, p.depth)
         if p.width <= 0 || p.height <= 0 || p.depth <= 0 {
-            result.message = "Box dimensions must be positive"
-            return result
+            return false, "Box dimensions must be positive"
         }
-        fmt.println("🔍 DEBUG: Calling occt.create_box()...")
-        shape = occt.create_box(p.width, p.height, p.depth)
-        fmt.printf("🔍 DEBUG: occt.create_box() returned: %v\n", shape)
 
     case CylinderParams:
-        fmt.printf("🔍 DEBUG: Creating Cylinder (r=%.1f, h=%.1f)\n", p.radius, p.height)
         if p.radius <= 0 || p.height <= 0 {
-            result.message = "Cylinder radius and height must be positive"
-            return result
+            return false, "Cylinder radius and height must be positive"
         }
-        fmt.println("🔍 DEBUG: Calling occt.create_cylinder()...")
-        shape = occt.create_cylinder(p.radius, p.height)
-        fmt.printf("🔍 DEBUG: occt.create_cylinder() returned: %v\n", shape)
 
     case SphereParams:
-        fmt.printf("🔍 DEBUG: Creating Sphere (r=%.1f)\n", p.radius)
         if p.radius <= 0 {
-            result.message = "Sphere radius must be positive"
-            return result
+            return false, "Sphere radius must be positive"
         }
-        fmt.println("🔍 DEBUG: Calling occt.create_sphere()...")
-        shape = occt.create_sphere(p.radius)
-        fmt.printf("🔍 DEBUG: occt.create_sphere() returned: %v\n", shape)
 
     case ConeParams:
-        fmt.printf("🔍 DEBUG: Creating Cone (r1=%.1f, r2=%.1f, h=%.1f)\n", p.bottom_radius, p.top_radius, p.height)
         if p.bottom_radius < 0 || p.top_radius < 0 || p.height <= 0 {
-            result.message = "Cone dimensions invalid"
-            return result
+            return false, "Cone dimensions invalid"
         }
         if p.bottom_radius == 0 && p.top_radius == 0 {
-            result.message = "Both cone radii cannot be zero"
-            return result
+            return false, "Both cone radii cannot be zero"
         }
-        fmt.println("🔍 DEBUG: Calling occt.create_cone()...")
-        shape = occt.create_cone(p.bottom_radius, p.top_radius, p.height)
-        fmt.printf("🔍 DEBUG: occt.create_cone() returned: %v\n", shape)
 
     case TorusParams:
-        fmt.printf("🔍 DEBUG: Creating Torus (major=%.1f, minor=%.1f)\n", p.major_radius, p.minor_radius)
         if p.major_radius <= 0 || p.minor_radius <= 0 {
-            result.message = "Torus radii must be positive"
-            return result
+            return false, "Torus radii must be positive"
         }
         if p.minor_radius >= p.major_radius {
-            result.message = "Torus minor radius must be less than major radius"
-            return result
+            return false, "Torus minor radius must be less than major radius"
         }
-        fmt.println("🔍 DEBUG: Calling occt.create_torus()...")
-        shape = occt.create_torus(p.major_radius, p.minor_radius)
-        fmt.printf("🔍 DEBUG: occt.create_torus() returned: %v\n", shape)
-    }
-
-    if shape == nil {
-        fmt.println("🔍 DEBUG: ❌ Shape is nil - OCCT creation failed!")
-        result.message = "Failed to create OCCT shape"
-        return result
-    }
-    fmt.println("🔍 DEBUG: ✓ Shape created successfully")
 
-    // Validate shape
-    fmt.println("🔍 DEBUG: Validating shape...")
-    if !occt.is_valid(shape) {
-        fmt.println("🔍 DEBUG: ❌ Shape validation failed!")
-        // Clean up invalid shape
-        occt.delete_shape(shape)
-        result.message = "OCCT shape is invalid"
-        return result
-    }
-    fmt.println("🔍 DEBUG: ✓ Shape is valid")
-
-    // Tessellate to triangle mesh
-    fmt.println("🔍 DEBUG: Tessellating shape to mesh...")
-    mesh := occt.OCCT_Tessellate(shape, occt.DEFAULT_TESSELLATION)
-    if mesh == nil {
-        fmt.println("🔍 DEBUG: ❌ Tessellation failed!")
-        // Clean up shape on failure
-        occt.delete_shape(shape)
-        result.message = "Failed to tessellate primitive"
-        return result
-    }
-    fmt.printf("🔍 DEBUG: ✓ Tessellation successful: %d vertices, %d triangles\n",
-        mesh.num_vertices, mesh.num_triangles)
-    defer occt.delete_mesh(mesh)
-
-    // Convert OCCT mesh to SimpleSolid
-    fmt.println("🔍 DEBUG: Converting mesh to SimpleSolid...")
-    solid := occt_mesh_to_simple_solid(mesh)
-    if solid == nil {
-        fmt.println("🔍 DEBUG: ❌ Mesh conversion failed!")
-        // Clean up shape on failure
-        occt.delete_shape(shape)
-        result.message = "Failed to convert mesh to solid"
-        return result
+    case:
+        return false, "No primitive parameters"
     }
-    fmt.println("🔍 DEBUG: ✓ Mesh conversion successful")
-
-    // Store both exact geometry and tessellated mesh
-    result.occt_shape = shape  // IMPORTANT: Shape is NOT deleted - stored for boolean ops
-    result.solid = solid
-    result.success = true
-    result.message = "Primitive created successfully"
-
-    fmt.printf("✓ Primitive created: %d vertices, %d triangles\n",
-        len(solid.vertices), len(solid.triangles))
 
-    return result
+    return true, ""
 }
 
 // =============================================================================
@@ -230,7 +206,7 @@ occt_mesh_to_simple_solid :: proc(mesh: ^occt.Mesh) -> ^extrude.SimpleSolid {
                 f64(mesh.normals[i0*3 + 1]),
                 f64(mesh.normals[i0*3 + 2]),
             },
-            face_id = -1,  // Primitives don't have face selection yet
+            face_id = occt.mesh_triangle_face(mesh, i),
         }
 
         append(&solid.triangles, tri)
@@ -247,28 +223,7 @@ occt_mesh_to_simple_solid :: proc(mesh: ^occt.Mesh) -> ^extrude.SimpleSolid {
 // =============================================================================
 
 destroy_primitive :: proc(solid: ^extrude.SimpleSolid) {
-    if solid == nil do return
-
-    // Free vertices
-    for v in solid.vertices {
-        free(v)
-    }
-    delete(solid.vertices)
-
-    // Free edges
-    for e in solid.edges {
-        free(e)
-    }
-    delete(solid.edges)
-
-    // Free faces
-    for &face in solid.faces {
-        delete(face.vertices)
-    }
-    delete(solid.faces)
-
-    // Free triangles
-    delete(solid.triangles)
-
-    free(solid)
+    // Primitive solids follow the same shared-ownership rules as feature results
+    solid := solid
+    extrude.simple_solid_release(&solid)
 }
@@ -454,14 +454,8 @@ get_profile_points_tessellated :: proc(sk: ^sketch.Sketch2D, profile: sketch.Pro
         }
     }
 
-    // For line-based profiles, use the existing point extraction
-    // Profile.points already contains the ordered point IDs
-    for point_id in profile.points {
-        if point_id >= 0 && point_id < len(sk.points) {
-            point := sk.points[point_id]
-            append(&points, m.Vec2{point.x, point.y})
-        }
-    }
+    // For line-based profiles, follow the ordered point IDs (splines add their flattened interior)
+    sketch.sketch_profile_outline(sk, profile, &points)
 
     return points
 }
@@ -472,12 +466,8 @@ get_profile_points_tessellated :: proc(sk: ^sketch.Sketch2D, profile: sketch.Pro
 
 // Destroy revolve result (cleanup)
 revolve_result_destroy :: proc(result: ^RevolveResult) {
-    if result.solid != nil {
-        // Use extrude's cleanup since we're using SimpleSolid
-        extrude_result := extrude.ExtrudeResult{solid = result.solid}
-        extrude.extrude_result_destroy(&extrude_result)
-        result.solid = nil
-    }
+    // Shared with extrude since we're using SimpleSolid
+    extrude.simple_solid_release(&result.solid)
 }
 
 // =============================================================================
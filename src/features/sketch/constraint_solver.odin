@@ -266,7 +266,7 @@ convert_sketch_to_slvs :: proc(s: ^Sketch2D) -> (SketchMapping, bool) {
 
     // Add all entities (lines, circles, arcs)
     for entity in s.entities {
-        slvs_entity, ok := convert_entity_to_slvs(entity, &mapping)
+        slvs_entity, ok := convert_entity_to_slvs(s, entity, &mapping)
         if ok {
             // Extract ID from entity
             entity_id := get_entity_id(entity)
@@ -289,7 +289,7 @@ convert_sketch_to_slvs :: proc(s: ^Sketch2D) -> (SketchMapping, bool) {
 }
 
 // Convert a single OhCAD entity to libslvs entity
-convert_entity_to_slvs :: proc(entity: SketchEntity, mapping: ^SketchMapping) -> (solver.Slvs_Entity, bool) {
+convert_entity_to_slvs :: proc(s: ^Sketch2D, entity: SketchEntity, mapping: ^SketchMapping) -> (solver.Slvs_Entity, bool) {
     switch e in entity {
     case SketchLine:
         p1, p1_ok := mapping.point_map[e.start_id]
@@ -320,6 +320,19 @@ convert_entity_to_slvs :: proc(entity: SketchEntity, mapping: ^SketchMapping) ->
             // Use the workplane's 3D normal (arcs require 3D normals, not 2D)
             return solver.Slvs_AddArc(mapping.group, mapping.workplane_normal, center, start, end, mapping.workplane), true
         }
+
+    case SketchSpline:
+        // libslvs only knows single cubic segments; longer splines are solved through
+        // their control points alone (they are ordinary points either way)
+        if ids := spline_control_ids(s, e); len(ids) == 4 {
+            p0, p0_ok := mapping.point_map[ids[0]]
+            p1, p1_ok := mapping.point_map[ids[1]]
+            p2, p2_ok := mapping.point_map[ids[2]]
+            p3, p3_ok := mapping.point_map[ids[3]]
+            if p0_ok && p1_ok && p2_ok && p3_ok {
+                return solver.Slvs_AddCubic(mapping.group, p0, p1, p2, p3, mapping.workplane), true
+            }
+        }
     }
 
     return solver.SLVS_E_NONE, false
@@ -524,6 +537,8 @@ get_entity_id :: proc(entity: SketchEntity) -> int {
         return e.id
     case SketchArc:
         return e.id
+    case SketchSpline:
+        return e.id
     }
     return -1
 }
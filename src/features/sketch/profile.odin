@@ -3,7 +3,10 @@
 package ohcad_sketch
 
 import "core:fmt"
+import "core:hash"
+import "core:mem"
 import "core:slice"
+import m "../../core/math"
 
 // Profile type classification
 ProfileType :: enum {
@@ -100,6 +103,17 @@ build_edge_graph :: proc(sketch: ^Sketch2D) -> [dynamic]Edge {
         case SketchArc:
             // Arc connects two endpoints
             // TODO: Implement arc support
+
+        case SketchSpline:
+            // Spline connects its first and last control points
+            start_id, end_id := spline_endpoints(sketch, e)
+            if start_id >= 0 && start_id != end_id {
+                append(&edges, Edge{
+                    entity_id = idx,
+                    start_point = start_id,
+                    end_point = end_id,
+                })
+            }
         }
     }
 
@@ -261,6 +275,54 @@ sketch_get_closed_profile :: proc(sketch: ^Sketch2D) -> (Profile, bool) {
     return Profile{}, false
 }
 
+// =============================================================================
+// Profile Geometry
+// =============================================================================
+
+// Append the profile's outline (sketch coordinates, loop order) to out
+// Entity k runs from points[k] to points[k + 1]; splines contribute their flattened
+// interior so the outline follows the curve rather than its endpoints.
+sketch_profile_outline :: proc(sketch: ^Sketch2D, profile: Profile, out: ^[dynamic]m.Vec2) {
+    for point_id, k in profile.points {
+        pt := sketch_get_point(sketch, point_id)
+        if pt == nil do continue
+        append(out, m.Vec2{pt.x, pt.y})
+
+        if k >= len(profile.entities) do continue
+        spline, is_spline := sketch.entities[profile.entities[k]].(SketchSpline)
+        if !is_spline do continue
+
+        polyline := make([dynamic]m.Vec2, 0, 64, context.temp_allocator)
+        if !sketch_flatten_spline(sketch, spline, &polyline) || len(polyline) < 3 do continue
+
+        interior := polyline[1:len(polyline) - 1]
+        if start_id, _ := spline_endpoints(sketch, spline); start_id != point_id {
+            slice.reverse(interior)
+        }
+        append(out, ..interior)
+    }
+}
+
+// True if any entity of the profile is a spline
+profile_has_splines :: proc(sketch: ^Sketch2D, profile: Profile) -> bool {
+    for entity_index in profile.entities {
+        if _, is_spline := sketch.entities[entity_index].(SketchSpline); is_spline {
+            return true
+        }
+    }
+    return false
+}
+
+// Fingerprint of everything profile detection reads (points, entities, spline controls, plane)
+// Cheap enough to take every frame; caches of profile-derived data key off it.
+sketch_geometry_fingerprint :: proc(sketch: ^Sketch2D) -> u64 {
+    h := hash.fnv64a(slice.to_bytes(sketch.points[:]))
+    h = hash.fnv64a(slice.to_bytes(sketch.entities[:]), h)
+    h = hash.fnv64a(slice.to_bytes(sketch.spline_controls[:]), h)
+    plane := sketch.plane
+    return hash.fnv64a(mem.ptr_to_bytes(&plane), h)
+}
+
 // =============================================================================
 // Profile Printing/Debugging
 // =============================================================================
@@ -28,6 +28,7 @@ SketchEntityType :: enum {
     Line,
     Circle,
     Arc,
+    Spline,
     Point,
 }
 
@@ -54,11 +55,27 @@ SketchArc :: struct {
     radius: f64,
 }
 
+// Control point limits of one spline (4 = one cubic segment)
+SPLINE_MIN_CONTROL_POINTS :: 4
+SPLINE_MAX_CONTROL_POINTS :: 32
+
+// Sketch spline (clamped uniform cubic B-spline; 4 control points = one cubic Bézier)
+// The curve starts at the first and ends at the last control point. Control points are
+// ordinary sketch points, so constraints and the solver drive the curve's shape.
+// Their IDs live out of line in Sketch2D.spline_controls (see spline_control_ids), which
+// keeps SketchEntity as small as a line or arc.
+SketchSpline :: struct {
+    id: int,
+    control_start: int,  // First index in Sketch2D.spline_controls
+    control_count: int,
+}
+
 // Union type for sketch entities
 SketchEntity :: union {
     SketchLine,
     SketchCircle,
     SketchArc,
+    SketchSpline,
 }
 
 // Sketch tool types
@@ -78,6 +95,7 @@ Sketch2D :: struct {
     // Geometry
     points: [dynamic]SketchPoint,
     entities: [dynamic]SketchEntity,
+    spline_controls: [dynamic]int,  // Control point IDs of every spline, in order (append-only)
 
     // Constraints
     constraints: [dynamic]Constraint,
@@ -192,6 +210,7 @@ sketch_init :: proc(name: string, plane: SketchPlane) -> Sketch2D {
         plane = plane,
         points = make([dynamic]SketchPoint),
         entities = make([dynamic]SketchEntity),
+        spline_controls = make([dynamic]int),
         constraints = make([dynamic]Constraint),
         next_point_id = 0,
         next_entity_id = 0,
@@ -217,6 +236,7 @@ sketch_init :: proc(name: string, plane: SketchPlane) -> Sketch2D {
 sketch_destroy :: proc(sketch: ^Sketch2D) {
     delete(sketch.points)
     delete(sketch.entities)
+    delete(sketch.spline_controls)
     delete(sketch.constraints)
 }
 
@@ -338,6 +358,7 @@ sketch_print_info :: proc(sketch: ^Sketch2D) {
     line_count := 0
     circle_count := 0
     arc_count := 0
+    spline_count := 0
 
     for entity in sketch.entities {
         switch _ in entity {
@@ -347,10 +368,13 @@ sketch_print_info :: proc(sketch: ^Sketch2D) {
             circle_count += 1
         case SketchArc:
             arc_count += 1
+        case SketchSpline:
+            spline_count += 1
         }
     }
 
     fmt.printf("    Lines: %d\n", line_count)
     fmt.printf("    Circles: %d\n", circle_count)
     fmt.printf("    Arcs: %d\n", arc_count)
+    fmt.printf("    Splines: %d\n", spline_count)
 }
@@ -4,6 +4,7 @@ package ohcad_sketch
 import "core:fmt"
 import "core:math"
 import m "../../core/math"
+import geom "../../core/geometry"
 import glsl "core:math/linalg/glsl"
 
 // Hover entity types
@@ -13,6 +14,7 @@ HoverEntityType :: enum {
     Line,
     Circle,
     Arc,
+    Spline,
     Constraint,  // NEW: Hovering over a constraint (dimension text/icon)
     RadiusHandle,  // NEW: Hovering over circle radius handle (Week 12.3 - Task 2)
     LineEndpointHandle,  // NEW: Hovering over line endpoint handle (Week 12.3 - Task 3)
@@ -85,6 +87,35 @@ detect_hover_circle :: proc(sketch: ^Sketch2D, circle: SketchCircle, cursor_pos:
     return dist <= tolerance, dist
 }
 
+// Detect hover for spline curve under cursor
+// The curve lies inside its control points' hull, so the control-point bounds reject
+// far-away splines before any flattening.
+detect_hover_spline :: proc(sketch: ^Sketch2D, spline: SketchSpline, cursor_pos: m.Vec2, tolerance: f64) -> (bool, f64) {
+    buf: [SPLINE_MAX_CONTROL_POINTS]m.Vec2
+    controls, ok := sketch_spline_controls(sketch, spline, &buf)
+    if !ok || len(controls) == 0 {
+        return false, 0.0
+    }
+
+    lo, hi := controls[0], controls[0]
+    for c in controls[1:] {
+        lo = glsl.min(lo, c)
+        hi = glsl.max(hi, c)
+    }
+    if cursor_pos.x < lo.x - tolerance || cursor_pos.x > hi.x + tolerance ||
+       cursor_pos.y < lo.y - tolerance || cursor_pos.y > hi.y + tolerance {
+        return false, tolerance + 1.0
+    }
+
+    polyline := make([dynamic]m.Vec2, 0, 64, context.temp_allocator)
+    if !geom.flatten_bspline_2d(controls, SPLINE_FLATTEN_TOLERANCE, &polyline) {
+        return false, 0.0
+    }
+    dist, _ := geom.distance_point_to_polyline_2d(cursor_pos, polyline[:])
+
+    return dist <= tolerance, dist
+}
+
 // Detect hover for arc edge under cursor
 detect_hover_arc :: proc(sketch: ^Sketch2D, arc: SketchArc, cursor_pos: m.Vec2, tolerance: f64) -> (bool, f64) {
     center_pt := sketch_get_point(sketch, arc.center_id)
@@ -561,6 +592,14 @@ sketch_update_hover :: proc(sketch: ^Sketch2D, cursor_pos: m.Vec2, pixel_size_wo
                 closest_edge_id = idx
                 closest_edge_type = .Arc
             }
+
+        case SketchSpline:
+            is_hover, dist := detect_hover_spline(sketch, e, cursor_pos, edge_tolerance)
+            if is_hover && dist < closest_edge_dist {
+                closest_edge_dist = dist
+                closest_edge_id = idx
+                closest_edge_type = .Spline
+            }
         }
     }
 
@@ -650,6 +689,15 @@ get_hover_info :: proc(sketch: ^Sketch2D, hover: HoverState) -> string {
         if !ok do return ""
 
         return fmt.tprintf("Arc #%d (radius: %.2f)", hover.entity_id, arc.radius)
+
+    case .Spline:
+        if hover.entity_id < 0 || hover.entity_id >= len(sketch.entities) {
+            return ""
+        }
+        spline, ok := sketch.entities[hover.entity_id].(SketchSpline)
+        if !ok do return ""
+
+        return fmt.tprintf("Spline #%d (%d control points)", hover.entity_id, spline.control_count)
     }
 
     return ""
@@ -2,8 +2,8 @@
 package ohcad_sketch
 
 import "core:fmt"
-import "core:os"
 import "core:encoding/json"
+import "core:slice"
 import m "../../core/math"
 
 // JSON-serializable structures for sketch export
@@ -30,6 +30,10 @@ SketchArcJSON :: struct {
     radius: f64,
 }
 
+SketchSplineJSON :: struct {
+    control_ids: []int,
+}
+
 SketchPlaneJSON :: struct {
     origin: [3]f64,
     x_axis: [3]f64,
@@ -44,6 +48,7 @@ SketchJSON :: struct {
     lines: []SketchLineJSON,
     circles: []SketchCircleJSON,
     arcs: []SketchArcJSON,
+    splines: []SketchSplineJSON,
 }
 
 // Convert Sketch2D to JSON-serializable structure
@@ -75,6 +80,7 @@ sketch_to_json :: proc(sketch: ^Sketch2D, allocator := context.allocator) -> Ske
     lines := make([dynamic]SketchLineJSON, 0, len(sketch.entities), allocator)
     circles := make([dynamic]SketchCircleJSON, 0, len(sketch.entities), allocator)
     arcs := make([dynamic]SketchArcJSON, 0, len(sketch.entities), allocator)
+    splines := make([dynamic]SketchSplineJSON, 0, len(sketch.entities), allocator)
 
     for entity in sketch.entities {
         switch e in entity {
@@ -95,12 +101,18 @@ sketch_to_json :: proc(sketch: ^Sketch2D, allocator := context.allocator) -> Ske
                 end_id = e.end_id,
                 radius = e.radius,
             })
+        case SketchSpline:
+            control_ids := slice.clone(spline_control_ids(sketch, e), allocator)
+            append(&splines, SketchSplineJSON{
+                control_ids = control_ids,
+            })
         }
     }
 
     result.lines = lines[:]
     result.circles = circles[:]
     result.arcs = arcs[:]
+    result.splines = splines[:]
 
     return result
 }
@@ -166,6 +178,15 @@ sketch_from_json :: proc(sketch_json: SketchJSON) -> Sketch2D {
         }))
     }
 
+    // Convert splines
+    for spline_json in sketch_json.splines {
+        count := len(spline_json.control_ids)
+        if count < SPLINE_MIN_CONTROL_POINTS || count > SPLINE_MAX_CONTROL_POINTS do continue
+        spline := SketchSpline{control_start = len(sketch.spline_controls), control_count = count}
+        append(&sketch.spline_controls, ..spline_json.control_ids)
+        append(&sketch.entities, SketchEntity(spline))
+    }
+
     // Initialize tool state
     sketch.current_tool = .Select
     sketch.temp_point_valid = false
@@ -175,29 +196,9 @@ sketch_from_json :: proc(sketch_json: SketchJSON) -> Sketch2D {
     return sketch
 }
 
-// Save sketch to JSON file
-sketch_save_to_file :: proc(sketch: ^Sketch2D, filename: string) -> bool {
-    // Convert to JSON structure
-    sketch_json := sketch_to_json(sketch)
-    defer {
-        delete(sketch_json.points)
-        delete(sketch_json.lines)
-        delete(sketch_json.circles)
-        delete(sketch_json.arcs)
-    }
-
-    // Marshal to JSON with indentation
-    data, marshal_err := json.marshal(sketch_json, {pretty = true, use_spaces = true, spaces = 2})
-    if marshal_err != nil {
-        fmt.eprintln("ERROR: Failed to marshal sketch to JSON:", marshal_err)
-        return false
-    }
-    defer delete(data)
-
-    // Write to file
-    write_ok := os.write_entire_file(filename, data)
-    if !write_ok {
-        fmt.eprintln("ERROR: Failed to write file:", filename)
+// Save sketch to file (streaming writer - includes constraints and entity order)
+sketch_save_to_file :: proc(sketch: ^Sketch2D, filename: string, format: SketchFileFormat = .Text) -> bool {
+    if !sketch_write_file(sketch, filename, format) {
         return false
     }
 
@@ -205,16 +206,19 @@ sketch_save_to_file :: proc(sketch: ^Sketch2D, filename: string) -> bool {
     return true
 }
 
-// Load sketch from JSON file
+// Load sketch from file (binary, streaming JSON, or legacy v1 JSON)
 sketch_load_from_file :: proc(filename: string) -> (Sketch2D, bool) {
-    // Read file
-    data, read_ok := os.read_entire_file(filename)
-    if !read_ok {
-        fmt.eprintln("ERROR: Failed to read file:", filename)
+    sketch, ok := sketch_read_file(filename)
+    if !ok {
         return Sketch2D{}, false
     }
-    defer delete(data)
 
+    fmt.printf("Sketch loaded from: %s\n", filename)
+    return sketch, true
+}
+
+// Load version 1 JSON (SketchJSON layout, no constraints)
+sketch_load_legacy_json :: proc(data: []byte) -> (Sketch2D, bool) {
     // Unmarshal JSON
     sketch_json: SketchJSON
     unmarshal_err := json.unmarshal(data, &sketch_json)
@@ -230,8 +234,5 @@ sketch_load_from_file :: proc(filename: string) -> (Sketch2D, bool) {
     }
 
     // Convert to Sketch2D
-    sketch := sketch_from_json(sketch_json)
-
-    fmt.printf("Sketch loaded from: %s\n", filename)
-    return sketch, true
+    return sketch_from_json(sketch_json), true
 }
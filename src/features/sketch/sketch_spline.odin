@@ -0,0 +1,116 @@
+// features/sketch - Spline entities
+// Creation, evaluation and hit-testing of SketchSpline. Evaluation goes through the
+// batched Bézier kernels in core/geometry: the spline's control points are gathered into
+// a fixed buffer, split into cubic Bézier segments and flattened to a polyline.
+package ohcad_sketch
+
+import "core:fmt"
+import m "../../core/math"
+import geom "../../core/geometry"
+
+// Maximum distance between a flattened spline and the exact curve (sketch units)
+SPLINE_FLATTEN_TOLERANCE :: 0.001
+
+// =============================================================================
+// Creation
+// =============================================================================
+
+// Add a spline through existing control points; returns the entity ID or -1
+sketch_add_spline :: proc(sketch: ^Sketch2D, control_ids: []int) -> int {
+    if len(control_ids) < SPLINE_MIN_CONTROL_POINTS || len(control_ids) > SPLINE_MAX_CONTROL_POINTS {
+        fmt.printf("❌ Spline needs %d to %d control points (got %d)\n",
+            SPLINE_MIN_CONTROL_POINTS, SPLINE_MAX_CONTROL_POINTS, len(control_ids))
+        return -1
+    }
+
+    spline := SketchSpline{
+        id = sketch.next_entity_id,
+        control_start = len(sketch.spline_controls),
+        control_count = len(control_ids),
+    }
+    append(&sketch.spline_controls, ..control_ids)
+
+    append(&sketch.entities, spline)
+    sketch.next_entity_id += 1
+    return spline.id
+}
+
+// Add a single cubic Bézier segment
+sketch_add_bezier :: proc(sketch: ^Sketch2D, p0_id, p1_id, p2_id, p3_id: int) -> int {
+    return sketch_add_spline(sketch, []int{p0_id, p1_id, p2_id, p3_id})
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// IDs of the spline's control points, in order (a view into the sketch's pool)
+spline_control_ids :: proc(sketch: ^Sketch2D, spline: SketchSpline) -> []int {
+    end := spline.control_start + spline.control_count
+    if spline.control_start < 0 || end > len(sketch.spline_controls) {
+        return nil
+    }
+    return sketch.spline_controls[spline.control_start:end]
+}
+
+// First and last control points (the curve's endpoints)
+spline_endpoints :: proc(sketch: ^Sketch2D, spline: SketchSpline) -> (start_id, end_id: int) {
+    ids := spline_control_ids(sketch, spline)
+    if len(ids) == 0 {
+        return -1, -1
+    }
+    return ids[0], ids[len(ids) - 1]
+}
+
+// True if the point is one of the spline's control points
+spline_uses_point :: proc(sketch: ^Sketch2D, spline: SketchSpline, point_id: int) -> bool {
+    for id in spline_control_ids(sketch, spline) {
+        if id == point_id do return true
+    }
+    return false
+}
+
+// Gather control point positions into buf; false if a control point is missing
+sketch_spline_controls :: proc(
+    sketch: ^Sketch2D,
+    spline: SketchSpline,
+    buf: ^[SPLINE_MAX_CONTROL_POINTS]m.Vec2,
+) -> ([]m.Vec2, bool) {
+    ids := spline_control_ids(sketch, spline)
+    if len(ids) == 0 || len(ids) > len(buf) {
+        return nil, false
+    }
+    for id, i in ids {
+        pt := sketch_get_point(sketch, id)
+        if pt == nil {
+            return nil, false
+        }
+        buf[i] = m.Vec2{pt.x, pt.y}
+    }
+    return buf[:len(ids)], true
+}
+
+// Append the spline's flattened polyline (sketch coordinates) to out
+sketch_flatten_spline :: proc(
+    sketch: ^Sketch2D,
+    spline: SketchSpline,
+    out: ^[dynamic]m.Vec2,
+    tolerance: f64 = SPLINE_FLATTEN_TOLERANCE,
+) -> bool {
+    buf: [SPLINE_MAX_CONTROL_POINTS]m.Vec2
+    controls, ok := sketch_spline_controls(sketch, spline, &buf)
+    if !ok {
+        return false
+    }
+    return geom.flatten_bspline_2d(controls, tolerance, out)
+}
+
+// Distance from a sketch position to the spline curve
+sketch_distance_to_spline :: proc(sketch: ^Sketch2D, spline: SketchSpline, pos: m.Vec2) -> (f64, bool) {
+    polyline := make([dynamic]m.Vec2, 0, 64, context.temp_allocator)
+    if !sketch_flatten_spline(sketch, spline, &polyline) {
+        return 0, false
+    }
+    dist, _ := geom.distance_point_to_polyline_2d(pos, polyline[:])
+    return dist, true
+}
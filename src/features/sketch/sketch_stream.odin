@@ -0,0 +1,1159 @@
+// features/sketch - Streaming sketch serialization (text JSON + compact binary)
+//
+// Unlike sketch_to_json/sketch_from_json, these encoders write straight from a
+// Sketch2D and the decoders fill a Sketch2D directly - no intermediate arrays or
+// json.Value tree. Everything needed to restore design intent is included:
+// plane, points (with fixed flag), entities in their original order (constraint
+// line/circle ids are entity indices, so order matters), every constraint type,
+// and the id counters.
+//
+// Text format (version 2) is plain JSON:
+//   {"format":"ohcad-sketch","version":2,"name":"...",
+//    "plane":{"origin":[x,y,z],"x_axis":[..],"y_axis":[..],"normal":[..]},
+//    "next_ids":[point,entity,constraint],
+//    "points":[[id,x,y,fixed],...],
+//    "entities":[["L",id,start,end],["C",id,center,r],["A",id,center,start,end,r],
+//                ["S",id,[control,...]],...],
+//    "constraints":[["Distance",id,enabled,driving,[ints...],[floats...]],...]}
+//
+// Binary format is little-endian: "OHSK" magic, u32 version, then the same
+// content with i32 ids and f64 values (see sketch_write_binary).
+package ohcad_sketch
+
+import "core:fmt"
+import "core:math"
+import "core:os"
+import "core:reflect"
+import "core:strconv"
+import "core:strings"
+import "core:encoding/endian"
+import m "../../core/math"
+
+SKETCH_STREAM_VERSION :: 2
+SKETCH_BINARY_MAGIC :: "OHSK"
+
+// Bytes buffered before a streaming writer flushes to its file
+SKETCH_STREAM_CHUNK :: 64 * 1024
+
+SketchFileFormat :: enum {
+    Text,    // Streaming JSON (human readable, default)
+    Binary,  // Compact little-endian binary
+}
+
+SketchIOError :: enum {
+    None,
+    Truncated,        // Input ended early
+    Syntax,           // Malformed JSON / unexpected token
+    Bad_Magic,        // Binary header mismatch
+    Bad_Version,      // Unsupported format version
+    Bad_Constraint,   // Unknown constraint type or wrong field count
+    Bad_Entity,       // Unknown entity tag
+    Legacy_Format,    // Version 1 JSON (use sketch_from_json)
+}
+
+// =============================================================================
+// Constraint Field Layout
+// =============================================================================
+// Each constraint is flattened to (ints, floats) in a fixed order per type.
+// Both encodings share this layout so they can never disagree.
+
+MAX_CONSTRAINT_INTS :: 2
+MAX_CONSTRAINT_FLOATS :: 4
+
+ConstraintFields :: struct {
+    ints: [MAX_CONSTRAINT_INTS]int,
+    floats: [MAX_CONSTRAINT_FLOATS]f64,
+    n_ints: int,
+    n_floats: int,
+}
+
+// Number of int/float fields stored for each constraint type
+constraint_field_counts :: proc(type: ConstraintType) -> (n_ints: int, n_floats: int) {
+    switch type {
+    case .Coincident:                  return 2, 0
+    case .Distance:                    return 2, 3  // distance, offset.x, offset.y
+    case .DistanceX, .DistanceY:       return 2, 4  // distance, offset.x, offset.y, locked delta
+    case .Diameter:                    return 1, 3  // diameter, offset.x, offset.y
+    case .Angle:                       return 2, 3  // angle (deg), offset.x, offset.y
+    case .Perpendicular, .Parallel:    return 2, 0
+    case .Horizontal, .Vertical:       return 1, 0
+    case .Tangent, .Equal:             return 2, 0
+    case .PointOnLine, .PointOnCircle: return 2, 0
+    case .FixedPoint:                  return 1, 2  // x, y
+    case .FixedDistance, .FixedAngle:  return 0, 0  // No data variant
+    }
+    return 0, 0
+}
+
+// Flatten constraint data into the shared field layout
+constraint_to_fields :: proc(c: ^Constraint) -> ConstraintFields {
+    f: ConstraintFields
+    f.n_ints, f.n_floats = constraint_field_counts(c.type)
+
+    switch data in c.data {
+    case CoincidentData:
+        f.ints = {data.point1_id, data.point2_id}
+    case DistanceData:
+        f.ints = {data.point1_id, data.point2_id}
+        f.floats = {data.distance, data.offset.x, data.offset.y, 0}
+    case DistanceXData:
+        f.ints = {data.point1_id, data.point2_id}
+        f.floats = {data.distance, data.offset.x, data.offset.y, data.locked_dy}
+    case DistanceYData:
+        f.ints = {data.point1_id, data.point2_id}
+        f.floats = {data.distance, data.offset.x, data.offset.y, data.locked_dx}
+    case DiameterData:
+        f.ints = {data.circle_id, 0}
+        f.floats = {data.diameter, data.offset.x, data.offset.y, 0}
+    case AngleData:
+        f.ints = {data.line1_id, data.line2_id}
+        f.floats = {data.angle, data.offset.x, data.offset.y, 0}
+    case PerpendicularData:
+        f.ints = {data.line1_id, data.line2_id}
+    case ParallelData:
+        f.ints = {data.line1_id, data.line2_id}
+    case HorizontalData:
+        f.ints = {data.line_id, 0}
+    case VerticalData:
+        f.ints = {data.line_id, 0}
+    case TangentData:
+        f.ints = {data.entity1_id, data.entity2_id}
+    case EqualData:
+        f.ints = {data.entity1_id, data.entity2_id}
+    case PointOnLineData:
+        f.ints = {data.point_id, data.line_id}
+    case PointOnCircleData:
+        f.ints = {data.point_id, data.circle_id}
+    case FixedPointData:
+        f.ints = {data.point_id, 0}
+        f.floats = {data.x, data.y, 0, 0}
+    }
+
+    return f
+}
+
+// Rebuild constraint data from the shared field layout
+constraint_from_fields :: proc(type: ConstraintType, f: ^ConstraintFields) -> (ConstraintData, bool) {
+    n_ints, n_floats := constraint_field_counts(type)
+    if f.n_ints != n_ints || f.n_floats != n_floats do return nil, false
+
+    i := f.ints
+    v := f.floats
+
+    switch type {
+    case .Coincident:     return CoincidentData{point1_id = i[0], point2_id = i[1]}, true
+    case .Distance:       return DistanceData{point1_id = i[0], point2_id = i[1], distance = v[0], offset = m.Vec2{v[1], v[2]}}, true
+    case .DistanceX:      return DistanceXData{point1_id = i[0], point2_id = i[1], distance = v[0], offset = m.Vec2{v[1], v[2]}, locked_dy = v[3]}, true
+    case .DistanceY:      return DistanceYData{point1_id = i[0], point2_id = i[1], distance = v[0], offset = m.Vec2{v[1], v[2]}, locked_dx = v[3]}, true
+    case .Diameter:       return DiameterData{circle_id = i[0], diameter = v[0], offset = m.Vec2{v[1], v[2]}}, true
+    case .Angle:          return AngleData{line1_id = i[0], line2_id = i[1], angle = v[0], offset = m.Vec2{v[1], v[2]}}, true
+    case .Perpendicular:  return PerpendicularData{line1_id = i[0], line2_id = i[1]}, true
+    case .Parallel:       return ParallelData{line1_id = i[0], line2_id = i[1]}, true
+    case .Horizontal:     return HorizontalData{line_id = i[0]}, true
+    case .Vertical:       return VerticalData{line_id = i[0]}, true
+    case .Tangent:        return TangentData{entity1_id = i[0], entity2_id = i[1]}, true
+    case .Equal:          return EqualData{entity1_id = i[0], entity2_id = i[1]}, true
+    case .PointOnLine:    return PointOnLineData{point_id = i[0], line_id = i[1]}, true
+    case .PointOnCircle:  return PointOnCircleData{point_id = i[0], circle_id = i[1]}, true
+    case .FixedPoint:     return FixedPointData{point_id = i[0], x = v[0], y = v[1]}, true
+    case .FixedDistance, .FixedAngle: return nil, true
+    }
+
+    return nil, false
+}
+
+// =============================================================================
+// Stream Writer (chunked: in-memory or flushed to a file)
+// =============================================================================
+
+SketchStreamWriter :: struct {
+    buf: [dynamic]byte,
+    file: os.Handle,
+    to_file: bool,
+    ok: bool,
+}
+
+stream_writer_memory :: proc(allocator := context.allocator) -> SketchStreamWriter {
+    return SketchStreamWriter{buf = make([dynamic]byte, 0, SKETCH_STREAM_CHUNK, allocator), ok = true}
+}
+
+stream_writer_file :: proc(file: os.Handle) -> SketchStreamWriter {
+    return SketchStreamWriter{buf = make([dynamic]byte, 0, SKETCH_STREAM_CHUNK * 2), file = file, to_file = true, ok = true}
+}
+
+stream_flush :: proc(w: ^SketchStreamWriter) {
+    if !w.to_file || len(w.buf) == 0 do return
+    written, err := os.write(w.file, w.buf[:])
+    if err != os.ERROR_NONE || written != len(w.buf) {
+        w.ok = false
+    }
+    clear(&w.buf)
+}
+
+stream_bytes :: #force_inline proc(w: ^SketchStreamWriter, data: []byte) {
+    append(&w.buf, ..data)
+    if w.to_file && len(w.buf) >= SKETCH_STREAM_CHUNK {
+        stream_flush(w)
+    }
+}
+
+stream_string :: #force_inline proc(w: ^SketchStreamWriter, s: string) {
+    stream_bytes(w, transmute([]byte)s)
+}
+
+stream_int :: proc(w: ^SketchStreamWriter, value: int) {
+    tmp: [32]byte
+    stream_string(w, strconv.itoa(tmp[:], value))
+}
+
+// Shortest representation that round-trips exactly; non-finite values become null
+stream_f64 :: proc(w: ^SketchStreamWriter, value: f64) {
+    if math.is_nan(value) || math.is_inf(value) {
+        stream_string(w, "null")
+        return
+    }
+    tmp: [64]byte
+    s := strconv.append_float(tmp[:], value, 'g', -1, 64)
+    if len(s) > 0 && s[0] == '+' do s = s[1:]
+    stream_string(w, s)
+}
+
+stream_bool :: proc(w: ^SketchStreamWriter, value: bool) {
+    stream_string(w, value ? "true" : "false")
+}
+
+// JSON string with the escapes required by RFC 8259
+stream_json_string :: proc(w: ^SketchStreamWriter, s: string) {
+    HEX :: "0123456789abcdef"
+    stream_string(w, "\"")
+    start := 0
+    for i in 0..<len(s) {
+        c := s[i]
+        if c != '"' && c != '\\' && c >= 0x20 do continue
+
+        stream_string(w, s[start:i])
+        switch c {
+        case '"':  stream_string(w, "\\\"")
+        case '\\': stream_string(w, "\\\\")
+        case '\n': stream_string(w, "\\n")
+        case '\t': stream_string(w, "\\t")
+        case '\r': stream_string(w, "\\r")
+        case:
+            esc := [6]byte{'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]}
+            stream_bytes(w, esc[:])
+        }
+        start = i + 1
+    }
+    stream_string(w, s[start:])
+    stream_string(w, "\"")
+}
+
+stream_vec3 :: proc(w: ^SketchStreamWriter, v: m.Vec3) {
+    stream_string(w, "[")
+    stream_f64(w, v.x)
+    stream_string(w, ",")
+    stream_f64(w, v.y)
+    stream_string(w, ",")
+    stream_f64(w, v.z)
+    stream_string(w, "]")
+}
+
+stream_u8 :: #force_inline proc(w: ^SketchStreamWriter, value: u8) {
+    append(&w.buf, value)
+}
+
+stream_u32 :: #force_inline proc(w: ^SketchStreamWriter, value: u32) {
+    tmp: [4]byte
+    endian.put_u32(tmp[:], .Little, value)
+    stream_bytes(w, tmp[:])
+}
+
+stream_i32 :: #force_inline proc(w: ^SketchStreamWriter, value: int) {
+    tmp: [4]byte
+    endian.put_i32(tmp[:], .Little, i32(value))
+    stream_bytes(w, tmp[:])
+}
+
+stream_f64_bin :: #force_inline proc(w: ^SketchStreamWriter, value: f64) {
+    tmp: [8]byte
+    endian.put_f64(tmp[:], .Little, value)
+    stream_bytes(w, tmp[:])
+}
+
+// =============================================================================
+// Text (JSON) Encoder
+// =============================================================================
+
+sketch_write_text :: proc(w: ^SketchStreamWriter, sketch: ^Sketch2D) {
+    stream_string(w, "{\n\"format\":\"ohcad-sketch\",\n\"version\":")
+    stream_int(w, SKETCH_STREAM_VERSION)
+    stream_string(w, ",\n\"name\":")
+    stream_json_string(w, sketch.name)
+
+    stream_string(w, ",\n\"plane\":{\"origin\":")
+    stream_vec3(w, sketch.plane.origin)
+    stream_string(w, ",\"x_axis\":")
+    stream_vec3(w, sketch.plane.x_axis)
+    stream_string(w, ",\"y_axis\":")
+    stream_vec3(w, sketch.plane.y_axis)
+    stream_string(w, ",\"normal\":")
+    stream_vec3(w, sketch.plane.normal)
+    stream_string(w, "},\n\"next_ids\":[")
+    stream_int(w, sketch.next_point_id)
+    stream_string(w, ",")
+    stream_int(w, sketch.next_entity_id)
+    stream_string(w, ",")
+    stream_int(w, sketch.next_constraint_id)
+    stream_string(w, "]")
+
+    // Points: [id, x, y, fixed]
+    stream_string(w, ",\n\"points\":[")
+    for pt, i in sketch.points {
+        stream_string(w, i == 0 ? "\n[" : ",\n[")
+        stream_int(w, pt.id)
+        stream_string(w, ",")
+        stream_f64(w, pt.x)
+        stream_string(w, ",")
+        stream_f64(w, pt.y)
+        stream_string(w, ",")
+        stream_bool(w, pt.fixed)
+        stream_string(w, "]")
+    }
+
+    // Entities, original order preserved
+    stream_string(w, "],\n\"entities\":[")
+    for entity, i in sketch.entities {
+        stream_string(w, i == 0 ? "\n" : ",\n")
+        switch e in entity {
+        case SketchLine:
+            stream_string(w, "[\"L\",")
+            stream_int(w, e.id)
+            stream_string(w, ",")
+            stream_int(w, e.start_id)
+            stream_string(w, ",")
+            stream_int(w, e.end_id)
+        case SketchCircle:
+            stream_string(w, "[\"C\",")
+            stream_int(w, e.id)
+            stream_string(w, ",")
+            stream_int(w, e.center_id)
+            stream_string(w, ",")
+            stream_f64(w, e.radius)
+        case SketchArc:
+            stream_string(w, "[\"A\",")
+            stream_int(w, e.id)
+            stream_string(w, ",")
+            stream_int(w, e.center_id)
+            stream_string(w, ",")
+            stream_int(w, e.start_id)
+            stream_string(w, ",")
+            stream_int(w, e.end_id)
+            stream_string(w, ",")
+            stream_f64(w, e.radius)
+        case SketchSpline:
+            stream_string(w, "[\"S\",")
+            stream_int(w, e.id)
+            stream_string(w, ",[")
+            for control_id, k in spline_control_ids(sketch, e) {
+                if k > 0 do stream_string(w, ",")
+                stream_int(w, control_id)
+            }
+            stream_string(w, "]")
+        case:
+            stream_string(w, "[\"?\"")
+        }
+        stream_string(w, "]")
+    }
+
+    // Constraints: [type, id, enabled, driving, [ints], [floats]]
+    stream_string(w, "],\n\"constraints\":[")
+    for &c, i in sketch.constraints {
+        type_name, _ := fmt.enum_value_to_string(c.type)
+        fields := constraint_to_fields(&c)
+
+        stream_string(w, i == 0 ? "\n[" : ",\n[")
+        stream_json_string(w, type_name)
+        stream_string(w, ",")
+        stream_int(w, c.id)
+        stream_string(w, ",")
+        stream_bool(w, c.enabled)
+        stream_string(w, ",")
+        stream_bool(w, c.driving)
+        stream_string(w, ",[")
+        for k in 0..<fields.n_ints {
+            if k > 0 do stream_string(w, ",")
+            stream_int(w, fields.ints[k])
+        }
+        stream_string(w, "],[")
+        for k in 0..<fields.n_floats {
+            if k > 0 do stream_string(w, ",")
+            stream_f64(w, fields.floats[k])
+        }
+        stream_string(w, "]]")
+    }
+    stream_string(w, "]\n}\n")
+}
+
+// =============================================================================
+// Binary Encoder
+// =============================================================================
+// Layout (little-endian):
+//   "OHSK" u32:version u32:name_len name_bytes
+//   plane: 12 x f64 (origin, x_axis, y_axis, normal)
+//   next ids: 3 x i32
+//   counts: u32 points, u32 entities, u32 constraints
+//   point:      i32 id, f64 x, f64 y, u8 fixed
+//   entity:     u8 tag (1=line 2=circle 3=arc 4=spline), i32 id, then
+//               line: i32 start, i32 end | circle: i32 center, f64 r |
+//               arc: i32 center, i32 start, i32 end, f64 r |
+//               spline: u8 count, i32 x count control point ids
+//   constraint: u8 type, i32 id, u8 flags (bit0 enabled, bit1 driving),
+//               i32 x n_ints, f64 x n_floats (see constraint_field_counts)
+
+ENTITY_TAG_LINE :: 1
+ENTITY_TAG_CIRCLE :: 2
+ENTITY_TAG_ARC :: 3
+ENTITY_TAG_SPLINE :: 4
+
+sketch_write_binary :: proc(w: ^SketchStreamWriter, sketch: ^Sketch2D) {
+    stream_string(w, SKETCH_BINARY_MAGIC)
+    stream_u32(w, SKETCH_STREAM_VERSION)
+    stream_u32(w, u32(len(sketch.name)))
+    stream_string(w, sketch.name)
+
+    for v in ([4]m.Vec3{sketch.plane.origin, sketch.plane.x_axis, sketch.plane.y_axis, sketch.plane.normal}) {
+        stream_f64_bin(w, v.x)
+        stream_f64_bin(w, v.y)
+        stream_f64_bin(w, v.z)
+    }
+
+    stream_i32(w, sketch.next_point_id)
+    stream_i32(w, sketch.next_entity_id)
+    stream_i32(w, sketch.next_constraint_id)
+
+    stream_u32(w, u32(len(sketch.points)))
+    stream_u32(w, u32(len(sketch.entities)))
+    stream_u32(w, u32(len(sketch.constraints)))
+
+    for pt in sketch.points {
+        stream_i32(w, pt.id)
+        stream_f64_bin(w, pt.x)
+        stream_f64_bin(w, pt.y)
+        stream_u8(w, pt.fixed ? 1 : 0)
+    }
+
+    for entity in sketch.entities {
+        switch e in entity {
+        case SketchLine:
+            stream_u8(w, ENTITY_TAG_LINE)
+            stream_i32(w, e.id)
+            stream_i32(w, e.start_id)
+            stream_i32(w, e.end_id)
+        case SketchCircle:
+            stream_u8(w, ENTITY_TAG_CIRCLE)
+            stream_i32(w, e.id)
+            stream_i32(w, e.center_id)
+            stream_f64_bin(w, e.radius)
+        case SketchArc:
+            stream_u8(w, ENTITY_TAG_ARC)
+            stream_i32(w, e.id)
+            stream_i32(w, e.center_id)
+            stream_i32(w, e.start_id)
+            stream_i32(w, e.end_id)
+            stream_f64_bin(w, e.radius)
+        case SketchSpline:
+            stream_u8(w, ENTITY_TAG_SPLINE)
+            stream_i32(w, e.id)
+            control_ids := spline_control_ids(sketch, e)
+            stream_u8(w, u8(len(control_ids)))
+            for control_id in control_ids do stream_i32(w, control_id)
+        case:
+            stream_u8(w, 0)
+        }
+    }
+
+    for &c in sketch.constraints {
+        fields := constraint_to_fields(&c)
+        flags: u8 = 0
+        if c.enabled do flags |= 1
+        if c.driving do flags |= 2
+
+        stream_u8(w, u8(c.type))
+        stream_i32(w, c.id)
+        stream_u8(w, flags)
+        for k in 0..<fields.n_ints do stream_i32(w, fields.ints[k])
+        for k in 0..<fields.n_floats do stream_f64_bin(w, fields.floats[k])
+    }
+}
+
+// =============================================================================
+// Encode Helpers
+// =============================================================================
+
+// Encode sketch to an in-memory buffer (caller owns the returned bytes)
+sketch_encode :: proc(sketch: ^Sketch2D, format: SketchFileFormat = .Text, allocator := context.allocator) -> []byte {
+    w := stream_writer_memory(allocator)
+    switch format {
+    case .Text:   sketch_write_text(&w, sketch)
+    case .Binary: sketch_write_binary(&w, sketch)
+    }
+    return w.buf[:]
+}
+
+// Decode sketch from bytes, auto-detecting binary vs text
+sketch_decode :: proc(data: []byte) -> (Sketch2D, SketchIOError) {
+    if len(data) >= 4 && string(data[:4]) == SKETCH_BINARY_MAGIC {
+        return sketch_read_binary(data)
+    }
+    return sketch_read_text(data)
+}
+
+// =============================================================================
+// Text (JSON) Decoder - single pass, fills Sketch2D directly
+// =============================================================================
+
+SketchTextReader :: struct {
+    data: []byte,
+    pos: int,
+    err: SketchIOError,
+}
+
+@(private="file")
+reader_fail :: proc(r: ^SketchTextReader, err: SketchIOError) {
+    if r.err == .None do r.err = err
+}
+
+@(private="file")
+reader_skip_ws :: #force_inline proc(r: ^SketchTextReader) {
+    for r.pos < len(r.data) {
+        switch r.data[r.pos] {
+        case ' ', '\n', '\r', '\t':
+            r.pos += 1
+        case:
+            return
+        }
+    }
+}
+
+@(private="file")
+reader_peek :: proc(r: ^SketchTextReader) -> byte {
+    reader_skip_ws(r)
+    if r.pos >= len(r.data) {
+        reader_fail(r, .Truncated)
+        return 0
+    }
+    return r.data[r.pos]
+}
+
+@(private="file")
+reader_expect :: proc(r: ^SketchTextReader, c: byte) -> bool {
+    if reader_peek(r) != c {
+        reader_fail(r, .Syntax)
+        return false
+    }
+    r.pos += 1
+    return true
+}
+
+// Consume ',' and report true, or consume `close` and report false
+@(private="file")
+reader_next_item :: proc(r: ^SketchTextReader, close: byte) -> bool {
+    c := reader_peek(r)
+    if c == ',' {
+        r.pos += 1
+        return true
+    }
+    if c != close do reader_fail(r, .Syntax)
+    r.pos += 1
+    return false
+}
+
+// Open a container; returns false if it is empty (closing bracket consumed)
+@(private="file")
+reader_open :: proc(r: ^SketchTextReader, open, close: byte) -> bool {
+    if !reader_expect(r, open) do return false
+    if reader_peek(r) == close {
+        r.pos += 1
+        return false
+    }
+    return r.err == .None
+}
+
+// Read a string. Escape-free strings alias the input buffer; escaped ones
+// are decoded into the temp allocator. Callers clone what they keep.
+@(private="file")
+reader_string :: proc(r: ^SketchTextReader) -> string {
+    if !reader_expect(r, '"') do return ""
+
+    start := r.pos
+    has_escape := false
+    for r.pos < len(r.data) && r.data[r.pos] != '"' {
+        if r.data[r.pos] == '\\' {
+            has_escape = true
+            r.pos += 1
+        }
+        r.pos += 1
+    }
+    if r.pos >= len(r.data) {
+        reader_fail(r, .Truncated)
+        return ""
+    }
+    raw := r.data[start:r.pos]
+    r.pos += 1
+
+    if !has_escape do return string(raw)
+
+    b := strings.builder_make(0, len(raw), context.temp_allocator)
+    for i := 0; i < len(raw); i += 1 {
+        c := raw[i]
+        if c != '\\' || i + 1 >= len(raw) {
+            strings.write_byte(&b, c)
+            continue
+        }
+        i += 1
+        switch raw[i] {
+        case 'n': strings.write_byte(&b, '\n')
+        case 't': strings.write_byte(&b, '\t')
+        case 'r': strings.write_byte(&b, '\r')
+        case 'b': strings.write_byte(&b, '\b')
+        case 'f': strings.write_byte(&b, '\f')
+        case 'u':
+            if i + 4 < len(raw) {
+                code, ok := strconv.parse_int(string(raw[i + 1:i + 5]), 16)
+                if ok do strings.write_rune(&b, rune(code))
+                i += 4
+            }
+        case: strings.write_byte(&b, raw[i])  // \" \\ \/
+        }
+    }
+    return strings.to_string(b)
+}
+
+@(private="file")
+reader_token :: proc(r: ^SketchTextReader) -> string {
+    reader_skip_ws(r)
+    start := r.pos
+    for r.pos < len(r.data) {
+        switch r.data[r.pos] {
+        case '0'..='9', '-', '+', '.', 'a'..='z', 'E':
+            r.pos += 1
+            continue
+        }
+        break
+    }
+    if r.pos == start do reader_fail(r, r.pos >= len(r.data) ? .Truncated : .Syntax)
+    return string(r.data[start:r.pos])
+}
+
+@(private="file")
+reader_f64 :: proc(r: ^SketchTextReader) -> f64 {
+    tok := reader_token(r)
+    if tok == "null" do return math.nan_f64()
+    value, ok := strconv.parse_f64(tok)
+    if !ok do reader_fail(r, .Syntax)
+    return value
+}
+
+@(private="file")
+reader_int :: proc(r: ^SketchTextReader) -> int {
+    tok := reader_token(r)
+    value, ok := strconv.parse_int(tok)
+    if !ok do reader_fail(r, .Syntax)
+    return value
+}
+
+@(private="file")
+reader_bool :: proc(r: ^SketchTextReader) -> bool {
+    tok := reader_token(r)
+    switch tok {
+    case "true":  return true
+    case "false": return false
+    }
+    reader_fail(r, .Syntax)
+    return false
+}
+
+@(private="file")
+reader_vec3 :: proc(r: ^SketchTextReader) -> m.Vec3 {
+    v: m.Vec3
+    reader_expect(r, '[')
+    v.x = reader_f64(r)
+    reader_expect(r, ',')
+    v.y = reader_f64(r)
+    reader_expect(r, ',')
+    v.z = reader_f64(r)
+    reader_expect(r, ']')
+    return v
+}
+
+// Skip any JSON value (used for unknown keys - forward compatibility)
+@(private="file")
+reader_skip_value :: proc(r: ^SketchTextReader) {
+    switch reader_peek(r) {
+    case '"':
+        reader_string(r)
+    case '[':
+        if reader_open(r, '[', ']') {
+            for r.err == .None {
+                reader_skip_value(r)
+                if !reader_next_item(r, ']') do break
+            }
+        }
+    case '{':
+        if reader_open(r, '{', '}') {
+            for r.err == .None {
+                reader_string(r)
+                reader_expect(r, ':')
+                reader_skip_value(r)
+                if !reader_next_item(r, '}') do break
+            }
+        }
+    case:
+        reader_token(r)
+    }
+}
+
+@(private="file")
+reader_plane :: proc(r: ^SketchTextReader, plane: ^SketchPlane) {
+    if !reader_open(r, '{', '}') do return
+    for r.err == .None {
+        key := reader_string(r)
+        reader_expect(r, ':')
+        switch key {
+        case "origin": plane.origin = reader_vec3(r)
+        case "x_axis": plane.x_axis = reader_vec3(r)
+        case "y_axis": plane.y_axis = reader_vec3(r)
+        case "normal": plane.normal = reader_vec3(r)
+        case:          reader_skip_value(r)
+        }
+        if !reader_next_item(r, '}') do break
+    }
+}
+
+@(private="file")
+reader_points :: proc(r: ^SketchTextReader, sketch: ^Sketch2D) {
+    if !reader_open(r, '[', ']') do return
+
+    // Version 1 stores points as {"id","x","y"} objects (and writes them before "lines")
+    if reader_peek(r) == '{' {
+        reader_fail(r, .Legacy_Format)
+        return
+    }
+
+    for r.err == .None {
+        pt: SketchPoint
+        reader_expect(r, '[')
+        pt.id = reader_int(r)
+        reader_expect(r, ',')
+        pt.x = reader_f64(r)
+        reader_expect(r, ',')
+        pt.y = reader_f64(r)
+        reader_expect(r, ',')
+        pt.fixed = reader_bool(r)
+        reader_expect(r, ']')
+        append(&sketch.points, pt)
+        if !reader_next_item(r, ']') do break
+    }
+}
+
+@(private="file")
+reader_entities :: proc(r: ^SketchTextReader, sketch: ^Sketch2D) {
+    if !reader_open(r, '[', ']') do return
+    for r.err == .None {
+        reader_expect(r, '[')
+        tag := reader_string(r)
+        reader_expect(r, ',')
+        id := reader_int(r)
+
+        switch tag {
+        case "L":
+            line := SketchLine{id = id}
+            reader_expect(r, ',')
+            line.start_id = reader_int(r)
+            reader_expect(r, ',')
+            line.end_id = reader_int(r)
+            append(&sketch.entities, line)
+        case "C":
+            circle := SketchCircle{id = id}
+            reader_expect(r, ',')
+            circle.center_id = reader_int(r)
+            reader_expect(r, ',')
+            circle.radius = reader_f64(r)
+            append(&sketch.entities, circle)
+        case "A":
+            arc := SketchArc{id = id}
+            reader_expect(r, ',')
+            arc.center_id = reader_int(r)
+            reader_expect(r, ',')
+            arc.start_id = reader_int(r)
+            reader_expect(r, ',')
+            arc.end_id = reader_int(r)
+            reader_expect(r, ',')
+            arc.radius = reader_f64(r)
+            append(&sketch.entities, arc)
+        case "S":
+            spline := SketchSpline{id = id, control_start = len(sketch.spline_controls)}
+            reader_expect(r, ',')
+            if reader_open(r, '[', ']') {
+                for r.err == .None {
+                    if spline.control_count >= SPLINE_MAX_CONTROL_POINTS {
+                        reader_fail(r, .Bad_Entity)
+                        return
+                    }
+                    append(&sketch.spline_controls, reader_int(r))
+                    spline.control_count += 1
+                    if !reader_next_item(r, ']') do break
+                }
+            }
+            if r.err == .None && spline.control_count < SPLINE_MIN_CONTROL_POINTS {
+                reader_fail(r, .Bad_Entity)  // sketch_add_spline could never have made it
+                return
+            }
+            append(&sketch.entities, spline)
+        case:
+            reader_fail(r, .Bad_Entity)
+            return
+        }
+        reader_expect(r, ']')
+        if !reader_next_item(r, ']') do break
+    }
+}
+
+@(private="file")
+reader_constraints :: proc(r: ^SketchTextReader, sketch: ^Sketch2D) {
+    if !reader_open(r, '[', ']') do return
+    for r.err == .None {
+        c: Constraint
+        fields: ConstraintFields
+
+        reader_expect(r, '[')
+        type_name := reader_string(r)
+        type, type_ok := reflect.enum_from_name(ConstraintType, type_name)
+        if !type_ok {
+            reader_fail(r, .Bad_Constraint)
+            return
+        }
+        c.type = type
+        reader_expect(r, ',')
+        c.id = reader_int(r)
+        reader_expect(r, ',')
+        c.enabled = reader_bool(r)
+        reader_expect(r, ',')
+        c.driving = reader_bool(r)
+        reader_expect(r, ',')
+
+        if reader_open(r, '[', ']') {
+            for r.err == .None {
+                if fields.n_ints >= MAX_CONSTRAINT_INTS {
+                    reader_fail(r, .Bad_Constraint)
+                    return
+                }
+                fields.ints[fields.n_ints] = reader_int(r)
+                fields.n_ints += 1
+                if !reader_next_item(r, ']') do break
+            }
+        }
+        reader_expect(r, ',')
+        if reader_open(r, '[', ']') {
+            for r.err == .None {
+                if fields.n_floats >= MAX_CONSTRAINT_FLOATS {
+                    reader_fail(r, .Bad_Constraint)
+                    return
+                }
+                fields.floats[fields.n_floats] = reader_f64(r)
+                fields.n_floats += 1
+                if !reader_next_item(r, ']') do break
+            }
+        }
+        reader_expect(r, ']')
+
+        data, data_ok := constraint_from_fields(c.type, &fields)
+        if !data_ok {
+            reader_fail(r, .Bad_Constraint)
+            return
+        }
+        c.data = data
+        append(&sketch.constraints, c)
+
+        if !reader_next_item(r, ']') do break
+    }
+}
+
+sketch_read_text :: proc(data: []byte) -> (Sketch2D, SketchIOError) {
+    r := SketchTextReader{data = data}
+    sketch := sketch_init("", SketchPlane{})
+    name: string  // Cloned; owned by sketch only once decoding succeeds
+    version := 0
+
+    if reader_open(&r, '{', '}') {
+        for r.err == .None {
+            key := reader_string(&r)
+            reader_expect(&r, ':')
+
+            switch key {
+            case "version":
+                version = reader_int(&r)
+                if version != SKETCH_STREAM_VERSION do reader_fail(&r, .Bad_Version)
+            case "name":
+                delete(name)
+                name = strings.clone(reader_string(&r))
+            case "plane":
+                reader_plane(&r, &sketch.plane)
+            case "next_ids":
+                reader_expect(&r, '[')
+                sketch.next_point_id = reader_int(&r)
+                reader_expect(&r, ',')
+                sketch.next_entity_id = reader_int(&r)
+                reader_expect(&r, ',')
+                sketch.next_constraint_id = reader_int(&r)
+                reader_expect(&r, ']')
+            case "points":
+                reader_points(&r, &sketch)
+            case "entities":
+                reader_entities(&r, &sketch)
+            case "constraints":
+                reader_constraints(&r, &sketch)
+            case "lines", "circles", "arcs":
+                // Version 1 layout (sketch_to_json) - entities split by type
+                reader_fail(&r, .Legacy_Format)
+            case:
+                reader_skip_value(&r)
+            }
+
+            if !reader_next_item(&r, '}') do break
+        }
+    }
+
+    if r.err == .None && version == 0 do r.err = .Legacy_Format
+    if r.err != .None {
+        delete(name)
+        sketch_destroy(&sketch)
+        return Sketch2D{}, r.err
+    }
+
+    sketch.name = name
+    return sketch, .None
+}
+
+// =============================================================================
+// Binary Decoder
+// =============================================================================
+
+SketchBinaryReader :: struct {
+    data: []byte,
+    pos: int,
+    ok: bool,
+}
+
+@(private="file")
+bin_take :: #force_inline proc(r: ^SketchBinaryReader, n: int) -> []byte {
+    if !r.ok || r.pos + n > len(r.data) {
+        r.ok = false
+        return nil
+    }
+    b := r.data[r.pos:r.pos + n]
+    r.pos += n
+    return b
+}
+
+@(private="file")
+bin_u8 :: #force_inline proc(r: ^SketchBinaryReader) -> u8 {
+    b := bin_take(r, 1)
+    return b != nil ? b[0] : 0
+}
+
+@(private="file")
+bin_u32 :: #force_inline proc(r: ^SketchBinaryReader) -> u32 {
+    value, _ := endian.get_u32(bin_take(r, 4), .Little)
+    return value
+}
+
+@(private="file")
+bin_i32 :: #force_inline proc(r: ^SketchBinaryReader) -> int {
+    value, _ := endian.get_i32(bin_take(r, 4), .Little)
+    return int(value)
+}
+
+@(private="file")
+bin_f64 :: #force_inline proc(r: ^SketchBinaryReader) -> f64 {
+    value, _ := endian.get_f64(bin_take(r, 8), .Little)
+    return value
+}
+
+@(private="file")
+bin_vec3 :: proc(r: ^SketchBinaryReader) -> m.Vec3 {
+    x := bin_f64(r)
+    y := bin_f64(r)
+    z := bin_f64(r)
+    return m.Vec3{x, y, z}
+}
+
+sketch_read_binary :: proc(data: []byte) -> (Sketch2D, SketchIOError) {
+    r := SketchBinaryReader{data = data, ok = true}
+
+    magic := bin_take(&r, 4)
+    if magic == nil || string(magic) != SKETCH_BINARY_MAGIC do return Sketch2D{}, .Bad_Magic
+    if bin_u32(&r) != SKETCH_STREAM_VERSION do return Sketch2D{}, .Bad_Version
+
+    name_len := int(bin_u32(&r))
+    name := bin_take(&r, name_len)
+    if !r.ok do return Sketch2D{}, .Truncated
+
+    plane: SketchPlane
+    plane.origin = bin_vec3(&r)
+    plane.x_axis = bin_vec3(&r)
+    plane.y_axis = bin_vec3(&r)
+    plane.normal = bin_vec3(&r)
+
+    sketch := sketch_init(strings.clone(string(name)), plane)
+    sketch.next_point_id = bin_i32(&r)
+    sketch.next_entity_id = bin_i32(&r)
+    sketch.next_constraint_id = bin_i32(&r)
+
+    point_count := int(bin_u32(&r))
+    entity_count := int(bin_u32(&r))
+    constraint_count := int(bin_u32(&r))
+
+    // Reject counts that cannot fit in the remaining input before reserving
+    MIN_RECORD :: 4
+    if !r.ok || (point_count + entity_count + constraint_count) * MIN_RECORD > len(data) - r.pos {
+        delete(sketch.name)
+        sketch_destroy(&sketch)
+        return Sketch2D{}, .Truncated
+    }
+
+    reserve(&sketch.points, point_count)
+    reserve(&sketch.entities, entity_count)
+    reserve(&sketch.constraints, constraint_count)
+
+    for _ in 0..<point_count {
+        pt: SketchPoint
+        pt.id = bin_i32(&r)
+        pt.x = bin_f64(&r)
+        pt.y = bin_f64(&r)
+        pt.fixed = bin_u8(&r) != 0
+        append(&sketch.points, pt)
+    }
+
+    err := SketchIOError.None
+
+    entity_loop: for _ in 0..<entity_count {
+        tag := bin_u8(&r)
+        id := bin_i32(&r)
+        switch tag {
+        case ENTITY_TAG_LINE:
+            start_id := bin_i32(&r)
+            end_id := bin_i32(&r)
+            append(&sketch.entities, SketchLine{id = id, start_id = start_id, end_id = end_id})
+        case ENTITY_TAG_CIRCLE:
+            center_id := bin_i32(&r)
+            radius := bin_f64(&r)
+            append(&sketch.entities, SketchCircle{id = id, center_id = center_id, radius = radius})
+        case ENTITY_TAG_ARC:
+            center_id := bin_i32(&r)
+            start_id := bin_i32(&r)
+            end_id := bin_i32(&r)
+            radius := bin_f64(&r)
+            append(&sketch.entities, SketchArc{id = id, center_id = center_id, start_id = start_id, end_id = end_id, radius = radius})
+        case ENTITY_TAG_SPLINE:
+            spline := SketchSpline{id = id, control_start = len(sketch.spline_controls), control_count = int(bin_u8(&r))}
+            if spline.control_count < SPLINE_MIN_CONTROL_POINTS || spline.control_count > SPLINE_MAX_CONTROL_POINTS {
+                err = .Bad_Entity
+                break entity_loop
+            }
+            for _ in 0..<spline.control_count do append(&sketch.spline_controls, bin_i32(&r))
+            append(&sketch.entities, spline)
+        case:
+            err = .Bad_Entity
+            break entity_loop
+        }
+    }
+
+    if err == .None {
+        constraint_loop: for _ in 0..<constraint_count {
+            type_raw := bin_u8(&r)
+            if int(type_raw) > int(max(ConstraintType)) {
+                err = .Bad_Constraint
+                break constraint_loop
+            }
+
+            c: Constraint
+            c.type = ConstraintType(type_raw)
+            c.id = bin_i32(&r)
+            flags := bin_u8(&r)
+            c.enabled = flags & 1 != 0
+            c.driving = flags & 2 != 0
+
+            fields: ConstraintFields
+            fields.n_ints, fields.n_floats = constraint_field_counts(c.type)
+            for k in 0..<fields.n_ints do fields.ints[k] = bin_i32(&r)
+            for k in 0..<fields.n_floats do fields.floats[k] = bin_f64(&r)
+
+            data, data_ok := constraint_from_fields(c.type, &fields)
+            if !data_ok {
+                err = .Bad_Constraint
+                break constraint_loop
+            }
+            c.data = data
+            append(&sketch.constraints, c)
+        }
+    }
+
+    if err == .None && !r.ok do err = .Truncated
+    if err != .None {
+        delete(sketch.name)
+        sketch_destroy(&sketch)
+        return Sketch2D{}, err
+    }
+
+    return sketch, .None
+}
+
+// =============================================================================
+// File API
+// =============================================================================
+
+// Stream sketch to a file (chunked writes, no full in-memory copy)
+sketch_write_file :: proc(sketch: ^Sketch2D, filename: string, format: SketchFileFormat = .Text) -> bool {
+    file, err := os.open(filename, os.O_WRONLY | os.O_CREATE | os.O_TRUNC, 0o644)
+    if err != os.ERROR_NONE {
+        fmt.eprintln("ERROR: Failed to open file for writing:", filename)
+        return false
+    }
+    defer os.close(file)
+
+    w := stream_writer_file(file)
+    defer delete(w.buf)
+
+    switch format {
+    case .Text:   sketch_write_text(&w, sketch)
+    case .Binary: sketch_write_binary(&w, sketch)
+    }
+    stream_flush(&w)
+
+    if !w.ok {
+        fmt.eprintln("ERROR: Failed to write file:", filename)
+    }
+    return w.ok
+}
+
+// Read a sketch file in any supported format (binary, text v2, legacy JSON v1)
+sketch_read_file :: proc(filename: string) -> (Sketch2D, bool) {
+    data, read_ok := os.read_entire_file(filename)
+    if !read_ok {
+        fmt.eprintln("ERROR: Failed to read file:", filename)
+        return Sketch2D{}, false
+    }
+    defer delete(data)
+
+    sketch, err := sketch_decode(data)
+    if err == .Legacy_Format {
+        return sketch_load_legacy_json(data)
+    }
+    if err != .None {
+        fmt.eprintf("ERROR: Failed to decode sketch '%s': %v\n", filename, err)
+        return Sketch2D{}, false
+    }
+
+    return sketch, true
+}
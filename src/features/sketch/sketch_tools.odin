@@ -422,6 +422,12 @@ sketch_find_entity_at :: proc(sketch: ^Sketch2D, pos: m.Vec2, threshold: f64 = 0
         case SketchArc:
             // TODO: Arc hit testing
             continue
+
+        case SketchSpline:
+            dist, ok := sketch_distance_to_spline(sketch, e, pos)
+            if ok && dist < threshold {
+                return i
+            }
         }
     }
 
@@ -463,6 +469,8 @@ sketch_delete_selected :: proc(sketch: ^Sketch2D) -> bool {
             append(&points_to_check, e.center_id)
             append(&points_to_check, e.start_id)
             append(&points_to_check, e.end_id)
+        case SketchSpline:
+            append(&points_to_check, ..spline_control_ids(sketch, e))
         }
 
         // Delete the entity first
@@ -498,6 +506,10 @@ sketch_is_point_used :: proc(sketch: ^Sketch2D, point_id: int) -> bool {
             if e.center_id == point_id || e.start_id == point_id || e.end_id == point_id {
                 return true
             }
+        case SketchSpline:
+            if spline_uses_point(sketch, e, point_id) {
+                return true
+            }
         }
     }
     return false
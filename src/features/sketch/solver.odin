@@ -11,6 +11,10 @@ SolverConfig :: struct {
     lambda_initial: f64,     // Initial damping parameter
     lambda_factor: f64,      // Factor to increase/decrease lambda
     epsilon: f64,            // Finite difference epsilon for Jacobian
+
+    // Optional cancellation check, polled once per iteration (background solves)
+    cancel: proc(data: rawptr) -> bool,
+    cancel_data: rawptr,
 }
 
 // Default solver configuration
@@ -31,6 +35,7 @@ SolverStatus :: enum {
     Overconstrained,   // System is overconstrained (conflicting constraints)
     Underconstrained,  // System is underconstrained (needs more constraints)
     NumericalError,    // Numerical error (NaN, singular matrix, etc.)
+    Cancelled,         // Abandoned via SolverConfig.cancel (sketch left partially solved)
 }
 
 // Solver result
@@ -81,6 +86,13 @@ sketch_solve_constraints :: proc(sketch: ^Sketch2D, config: Maybe(SolverConfig)
     lambda := solver_config.lambda_initial
 
     for iter in 0..<solver_config.max_iterations {
+        if solver_config.cancel != nil && solver_config.cancel(solver_config.cancel_data) {
+            result.status = .Cancelled
+            result.iterations = iter
+            result.message = "Cancelled"
+            return result
+        }
+
         // Evaluate residuals at current position
         residuals := sketch_evaluate_constraints(sketch)
         defer delete(residuals)
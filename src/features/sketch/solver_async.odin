@@ -0,0 +1,216 @@
+// features/sketch - Background constraint solving
+// Runs sketch_solve_constraints on a worker thread so edits never block rendering:
+//   - sketch_solve_async snapshots points/entities/constraints and queues the snapshot
+//     (a queued, not yet started request is simply replaced by a newer one)
+//   - each request gets a generation; a running solve is cancelled as soon as a newer
+//     request (or sketch_solve_cancel) bumps the generation
+//   - the worker publishes solved positions into a back buffer that is swapped with the
+//     published slot; the UI thread swaps that slot with its front buffer in
+//     sketch_async_solver_poll and copies the positions into the live sketch, so the
+//     renderer always draws the latest published solve and neither side waits on the other
+package ohcad_sketch
+
+import "core:fmt"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+// Solved positions for one request
+AsyncSolveResult :: struct {
+    generation: u64,
+    sketch_ref: ^Sketch2D,        // Sketch the request was made for (identity only - never dereferenced off the UI thread)
+    points: [dynamic]SketchPoint, // Solved copy of Sketch2D.points
+    result: SolverResult,
+    duration: time.Duration,      // Worker time spent solving
+}
+
+AsyncSolver :: struct {
+    worker: ^thread.Thread,
+    wake: sync.Sema,
+    mutex: sync.Mutex,            // Guards the request and published slots (held only to swap them)
+    quit: bool,                   // Atomic
+
+    // Generations: requested is bumped by every request/cancel, published by the worker
+    requested_generation: u64,    // Atomic
+    published_generation: u64,    // Atomic
+    solving_generation: u64,      // Worker-owned: request currently being solved
+    applied_generation: u64,      // UI-owned: last generation copied into a sketch
+
+    // UI → worker
+    staging: Sketch2D,            // UI-owned snapshot being filled
+    request: Sketch2D,            // Latest queued snapshot (mutex)
+    request_sketch: ^Sketch2D,
+    request_generation: u64,
+    request_pending: bool,
+
+    // Worker-owned working copy the solver mutates
+    work: Sketch2D,
+
+    // Worker → UI double buffer
+    back: AsyncSolveResult,       // Worker-owned, filled after each solve
+    published: AsyncSolveResult,  // Latest completed solve (mutex)
+    front: AsyncSolveResult,      // UI-owned, last result taken by poll
+}
+
+sketch_async_solver_init :: proc(solver: ^AsyncSolver) -> bool {
+    solver^ = {}
+    solver.worker = thread.create_and_start_with_data(solver, async_solver_worker)
+    if solver.worker == nil {
+        fmt.eprintln("ERROR: Failed to start constraint solver thread")
+        return false
+    }
+    return true
+}
+
+sketch_async_solver_destroy :: proc(solver: ^AsyncSolver) {
+    if solver.worker != nil {
+        sync.atomic_store(&solver.quit, true)
+        sync.atomic_add(&solver.requested_generation, 1)  // Cancel any running solve
+        sync.sema_post(&solver.wake)
+        thread.join(solver.worker)
+        thread.destroy(solver.worker)
+        solver.worker = nil
+    }
+
+    for sk in ([]^Sketch2D{&solver.staging, &solver.request, &solver.work}) {
+        delete(sk.points)
+        delete(sk.entities)
+        delete(sk.spline_controls)
+        delete(sk.constraints)
+    }
+    delete(solver.back.points)
+    delete(solver.published.points)
+    delete(solver.front.points)
+}
+
+// Queue a solve of the sketch's current state; returns the request's generation
+// Any queued or running solve for an older generation is dropped/cancelled.
+sketch_solve_async :: proc(solver: ^AsyncSolver, sk: ^Sketch2D) -> u64 {
+    // Snapshot outside the lock (the worker never touches staging)
+    snapshot_into(&solver.staging.points, sk.points[:])
+    snapshot_into(&solver.staging.entities, sk.entities[:])
+    snapshot_into(&solver.staging.spline_controls, sk.spline_controls[:])
+    snapshot_into(&solver.staging.constraints, sk.constraints[:])
+
+    generation := sync.atomic_add(&solver.requested_generation, 1) + 1
+
+    sync.mutex_lock(&solver.mutex)
+    solver.staging, solver.request = solver.request, solver.staging
+    solver.request_sketch = sk
+    solver.request_generation = generation
+    solver.request_pending = true
+    sync.mutex_unlock(&solver.mutex)
+
+    sync.sema_post(&solver.wake)
+    return generation
+}
+
+// Abandon any queued or running solve (e.g. the user started editing the sketch again)
+sketch_solve_cancel :: proc(solver: ^AsyncSolver) {
+    sync.atomic_add(&solver.requested_generation, 1)
+}
+
+// True while the latest request has not been published yet
+sketch_async_solver_busy :: proc(solver: ^AsyncSolver) -> bool {
+    requested := sync.atomic_load(&solver.requested_generation)
+    return solver.applied_generation < requested && sync.atomic_load(&solver.published_generation) < requested
+}
+
+// Apply the latest published solve to `sk` (UI thread, once per frame/loop iteration)
+// Returns the solve's result when new positions were applied. Results for an older
+// request, another sketch, or a sketch whose points changed shape since are dropped.
+sketch_async_solver_poll :: proc(solver: ^AsyncSolver, sk: ^Sketch2D) -> (result: AsyncSolveResult, applied: bool) {
+    published := sync.atomic_load(&solver.published_generation)
+    if published <= solver.applied_generation {
+        return
+    }
+
+    sync.mutex_lock(&solver.mutex)
+    solver.published, solver.front = solver.front, solver.published
+    sync.mutex_unlock(&solver.mutex)
+
+    front := &solver.front
+    if front.generation <= solver.applied_generation {
+        return  // Already taken
+    }
+    solver.applied_generation = front.generation
+
+    if sk == nil || front.sketch_ref != sk || front.generation != sync.atomic_load(&solver.requested_generation) {
+        return  // Superseded or for a sketch that is no longer active
+    }
+    if len(front.points) != len(sk.points) {
+        return  // Points added/removed since the snapshot
+    }
+    for p, i in front.points {
+        if sk.points[i].id != p.id do return
+    }
+
+    copy(sk.points[:], front.points[:])
+    return front^, true
+}
+
+// =============================================================================
+// Worker
+// =============================================================================
+
+@(private="file")
+async_solver_worker :: proc(data: rawptr) {
+    solver := (^AsyncSolver)(data)
+
+    for {
+        sync.sema_wait(&solver.wake)
+        if sync.atomic_load(&solver.quit) {
+            return
+        }
+
+        sync.mutex_lock(&solver.mutex)
+        if !solver.request_pending {
+            sync.mutex_unlock(&solver.mutex)
+            continue
+        }
+        solver.request, solver.work = solver.work, solver.request
+        target := solver.request_sketch
+        generation := solver.request_generation
+        solver.request_pending = false
+        sync.mutex_unlock(&solver.mutex)
+
+        if generation != sync.atomic_load(&solver.requested_generation) {
+            continue  // Superseded before it started
+        }
+        solver.solving_generation = generation
+
+        config := default_solver_config()
+        config.cancel = proc(data: rawptr) -> bool {
+            s := (^AsyncSolver)(data)
+            return sync.atomic_load(&s.requested_generation) != s.solving_generation
+        }
+        config.cancel_data = solver
+
+        start := time.tick_now()
+        result := sketch_solve_constraints(&solver.work, config)
+        duration := time.tick_since(start)
+        free_all(context.temp_allocator)
+
+        if result.status == .Cancelled {
+            continue
+        }
+
+        snapshot_into(&solver.back.points, solver.work.points[:])
+        solver.back.generation = generation
+        solver.back.sketch_ref = target
+        solver.back.result = result
+        solver.back.duration = duration
+
+        sync.mutex_lock(&solver.mutex)
+        solver.back, solver.published = solver.published, solver.back
+        sync.mutex_unlock(&solver.mutex)
+        sync.atomic_store(&solver.published_generation, generation)
+    }
+}
+
+// Copy into a reused buffer (keeps its capacity between solves)
+@(private="file")
+snapshot_into :: proc(dst: ^[dynamic]$T, src: []T) {
+    resize(dst, len(src))
+    copy(dst[:], src)
+}
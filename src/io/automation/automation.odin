@@ -0,0 +1,276 @@
+// io/automation - Persistent automation server (documents and operations)
+// Documents stay loaded between requests so repeated regenerate/query/export jobs skip
+// process startup, OCCT initialization and cold caches. Each document owns a FIFO of
+// pending requests; one pool task drains it at a time, so requests on a document run in
+// the order they arrived while different documents run concurrently.
+package ohcad_automation
+
+import "core:fmt"
+import "core:strings"
+import "core:sync"
+import "core:time"
+import glsl "core:math/linalg/glsl"
+import m "../../core/math"
+import extrude "../../features/extrude"
+import ftree "../../features/feature_tree"
+import sketch "../../features/sketch"
+import stl "../../io/stl"
+
+// Extrude depth used by `load` when the request gives none
+DEFAULT_LOAD_DEPTH :: 10.0
+
+// Loaded document and its request queue
+AutomationDocument :: struct {
+    name: string,                   // Client-chosen document key (owned)
+    path: string,                   // Sketch file it was loaded from (owned)
+    tree: ftree.FeatureTree,
+    loaded: bool,                   // Atomic: written by the document's pool task, read by `stats`
+
+    // Guarded by AutomationServer.mutex
+    queue: [dynamic]PendingRequest, // Requests waiting to run, in arrival order
+    scheduled: bool,                // A pool task is draining queue
+
+    // Result cache (valid while the tree's content revision is unchanged)
+    mass: MassProperties,
+    mass_revision: u64,
+    mass_valid: bool,
+}
+
+// Volume properties of a document's visible bodies (from the tessellated result meshes)
+MassProperties :: struct {
+    volume: f64,
+    area: f64,
+    centroid: m.Vec3,
+    bbox_min: m.Vec3,
+    bbox_max: m.Vec3,
+    triangles: int,
+    bodies: int,
+}
+
+// =============================================================================
+// Document Operations
+// =============================================================================
+
+// Replace the document's tree with a sketch file (and an extrude of its profile when depth > 0)
+document_load :: proc(document: ^AutomationDocument, path: string, depth: f64) -> (ok: bool, message: string) {
+    loaded_sketch, load_ok := sketch.sketch_load_from_file(path)
+    if !load_ok {
+        return false, "failed to load sketch file"
+    }
+
+    document_unload(document)
+
+    document.tree = ftree.feature_tree_init()
+    document.path = strings.clone(path)
+
+    sk := new(sketch.Sketch2D)
+    sk^ = loaded_sketch
+    sketch_id := ftree.feature_tree_add_sketch(&document.tree, sk, "Sketch")
+    if depth > 0 {
+        ftree.feature_tree_add_extrude(&document.tree, sketch_id, depth, .Forward, "Extrude")
+    }
+    sync.atomic_store(&document.loaded, true)
+
+    regenerated, failed := document_regenerate(document)
+    if failed > 0 {
+        return false, fmt.tprintf("%d of %d feature(s) failed to regenerate", failed, regenerated)
+    }
+    return true, ""
+}
+
+// Drop the document's tree (the server removes the entry once its queue drains)
+document_unload :: proc(document: ^AutomationDocument) {
+    if !document.loaded {
+        return
+    }
+
+    ftree.feature_tree_destroy(&document.tree)
+    delete(document.path)
+    document.path = ""
+    sync.atomic_store(&document.loaded, false)
+    document.mass_valid = false
+}
+
+// Set a numeric feature parameter; feature_id < 0 picks the first feature the parameter applies to
+document_set_param :: proc(
+    document: ^AutomationDocument,
+    feature_id: int,
+    param: string,
+    value: f64,
+) -> (ok: bool, message: string) {
+    target := feature_id
+    if target < 0 {
+        for feature in document.tree.features {
+            if param_applies(feature.type, param) {
+                target = feature.id
+                break
+            }
+        }
+    }
+
+    feature := ftree.feature_tree_get_feature(&document.tree, target)
+    if feature == nil {
+        return false, "no feature with that parameter"
+    }
+    if !param_applies(feature.type, param) {
+        return false, fmt.tprintf("feature %d has no parameter '%s'", target, param)
+    }
+
+    switch feature.type {
+    case .Extrude:
+        ok = ftree.change_extrude_depth(&document.tree, target, value)
+    case .Cut:
+        ok = ftree.change_cut_depth(&document.tree, target, value)
+    case .Revolve:
+        ok = ftree.change_revolve_angle(&document.tree, target, value)
+    case .Move, .CopyBody:
+        // Placement-only regeneration - batch moves never re-mesh
+        params := feature.params.(ftree.TransformParams)
+        translation := params.translation
+        switch param {
+        case "dx": translation.x = value
+        case "dy": translation.y = value
+        case "dz": translation.z = value
+        }
+        ok = ftree.change_body_translation(&document.tree, target, translation)
+    case .Sketch, .Fillet, .Chamfer:
+    }
+    if !ok {
+        return false, "parameter rejected"
+    }
+    return true, ""
+}
+
+// Regenerate features that are not up to date (tree order; clean results are kept)
+document_regenerate :: proc(document: ^AutomationDocument) -> (regenerated, failed: int) {
+    for &feature in document.tree.features {
+        if feature.status != .NeedsUpdate && feature.status != .Failed {
+            continue
+        }
+        regenerated += 1
+        if !ftree.feature_regenerate(&document.tree, feature.id) {
+            failed += 1
+        }
+    }
+    return
+}
+
+// Mass properties, recomputed only when a feature changed since the last query
+document_mass_properties :: proc(document: ^AutomationDocument) -> (props: MassProperties, cached: bool) {
+    revision := document_content_revision(document)
+    if document.mass_valid && document.mass_revision == revision {
+        return document.mass, true
+    }
+
+    solids := document_visible_solids(document)
+    defer release_solids(solids)
+    document.mass = mass_properties(solids)
+    document.mass_revision = revision
+    document.mass_valid = true
+    return document.mass, false
+}
+
+// Write the document's visible bodies to a binary STL file
+document_export_stl :: proc(document: ^AutomationDocument, path: string) -> (triangles: int, ok: bool, message: string) {
+    solids := document_visible_solids(document)
+    defer release_solids(solids)
+    for solid in solids {
+        triangles += len(solid.triangles)
+    }
+
+    result := stl.export_feature_tree_to_stl(solids, path)
+    if !result.success {
+        message = strings.clone(result.message, context.temp_allocator)
+    }
+    delete(result.message)
+    return triangles, result.success, message
+}
+
+// Sum of feature revisions plus the structural revision (changes on any edit or regenerate)
+document_content_revision :: proc(document: ^AutomationDocument) -> u64 {
+    revision := document.tree.revision
+    for feature in document.tree.features {
+        revision += feature.revision
+    }
+    return revision
+}
+
+// World-space meshes of enabled, visible final bodies (cut bases and moved bodies are consumed)
+// The slice is temp allocated; the references in it are released with release_solids.
+document_visible_solids :: proc(document: ^AutomationDocument) -> []^extrude.SimpleSolid {
+    solids := make([dynamic]^extrude.SimpleSolid, 0, len(document.tree.features), context.temp_allocator)
+    consumed := ftree.feature_tree_consumed_features(&document.tree, context.temp_allocator)
+    for &feature in document.tree.features {
+        if feature.result_solid == nil || !feature.visible || !feature.enabled do continue
+        if consumed[feature.id] do continue
+        append(&solids, ftree.feature_world_solid(&feature))
+    }
+    return solids[:]
+}
+
+@(private="file")
+release_solids :: proc(solids: []^extrude.SimpleSolid) {
+    for &solid in solids {
+        extrude.simple_solid_release(&solid)
+    }
+}
+
+// =============================================================================
+// Mass Properties
+// =============================================================================
+
+// Volume, area and centroid of closed triangle meshes (divergence theorem over signed tetrahedra)
+mass_properties :: proc(solids: []^extrude.SimpleSolid) -> MassProperties {
+    props: MassProperties
+    moment: m.Vec3
+    first := true
+
+    for solid in solids {
+        props.bodies += 1
+        props.triangles += len(solid.triangles)
+
+        for tri in solid.triangles {
+            cross := glsl.cross(tri.v1 - tri.v0, tri.v2 - tri.v0)
+            props.area += 0.5 * glsl.length(cross)
+
+            // Signed volume of the tetrahedron (origin, v0, v1, v2)
+            tet := glsl.dot(tri.v0, glsl.cross(tri.v1, tri.v2)) / 6.0
+            props.volume += tet
+            moment += (tri.v0 + tri.v1 + tri.v2) * (tet / 4.0)
+
+            corners := [3]m.Vec3{tri.v0, tri.v1, tri.v2}
+            for p in corners {
+                if first {
+                    props.bbox_min, props.bbox_max = p, p
+                    first = false
+                }
+                props.bbox_min = glsl.min(props.bbox_min, p)
+                props.bbox_max = glsl.max(props.bbox_max, p)
+            }
+        }
+    }
+
+    if abs(props.volume) > 1e-12 {
+        props.centroid = moment / props.volume
+    }
+    return props
+}
+
+// =============================================================================
+// Internal Helpers
+// =============================================================================
+
+@(private="file")
+param_applies :: proc(type: ftree.FeatureType, param: string) -> bool {
+    switch param {
+    case "depth": return type == .Extrude || type == .Cut
+    case "angle": return type == .Revolve
+    case "dx", "dy", "dz": return type == .Move || type == .CopyBody
+    }
+    return false
+}
+
+@(private)
+elapsed_ms :: proc(start: time.Tick) -> f64 {
+    return time.duration_milliseconds(time.tick_since(start))
+}
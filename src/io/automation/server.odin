@@ -0,0 +1,556 @@
+// io/automation - Unix socket server and request protocol
+//
+// Requests and responses are newline-delimited JSON objects. Clients may pipeline: send any
+// number of requests without waiting, then match responses by "id". Responses for one
+// document come back in request order; responses for different documents may interleave.
+//
+//   {"id":1,"op":"load","doc":"bracket","path":"bracket.json","depth":10}
+//   {"id":2,"op":"set_param","doc":"bracket","param":"depth","value":12.5}   (optional "feature")
+//   {"id":3,"op":"regenerate","doc":"bracket"}
+//   {"id":4,"op":"mass_properties","doc":"bracket"}
+//   {"id":5,"op":"export_stl","doc":"bracket","path":"out/bracket.stl"}
+//   {"id":6,"op":"close","doc":"bracket"}                                    (forgets the document)
+//   {"id":7,"op":"ping"}  {"id":8,"op":"stats"}  {"id":9,"op":"shutdown"}
+//
+//   → {"id":4,"ok":true,"ms":0.21,"cached":false,"volume":...,"area":...,"centroid":[x,y,z],...}
+//   → {"id":9,"ok":false,"error":"..."}
+package ohcad_automation
+
+import "core:encoding/json"
+import "core:fmt"
+import "core:os"
+import "core:strings"
+import "core:sync"
+import "core:sys/posix"
+import "core:thread"
+import "core:time"
+import primitives "../../features/primitives"
+
+// Longest accepted request line (bytes)
+MAX_REQUEST_BYTES :: 1 << 20
+
+SERVER_LISTEN_BACKLOG :: 64
+
+AutomationServer :: struct {
+    socket_path: string,
+    listen_fd: posix.FD,
+    pool: thread.Pool,
+
+    mutex: sync.Mutex,                            // Guards documents and every document's queue
+    documents: map[string]^AutomationDocument,    // Created by `load`; removed once unloaded and idle
+
+    running: bool,                                // Cleared by `shutdown` (atomic)
+    requests_served: u64,                         // Atomic
+    started: time.Tick,
+
+    readers: [dynamic]ReaderThread,               // Accept loop only: live connection readers
+}
+
+// One client socket; freed when the reader, the accept loop and every queued request have released it
+Connection :: struct {
+    fd: posix.FD,
+    write_mutex: sync.Mutex,   // Responses from pool tasks and the reader must not interleave
+    refs: int,                 // Atomic: reader + accept loop + queued requests
+}
+
+// Reader thread of one connection; the accept loop keeps a reference to conn until it has joined it
+ReaderThread :: struct {
+    thread: ^thread.Thread,
+    conn: ^Connection,
+}
+
+// Decoded request (strings owned, freed by request_destroy)
+Request :: struct {
+    id: i64,
+    op: string,
+    doc: string,
+    path: string,
+    param: string,
+    feature: int,
+    value: f64,
+    depth: f64,
+}
+
+PendingRequest :: struct {
+    conn: ^Connection,
+    request: Request,
+}
+
+// =============================================================================
+// Server Lifecycle
+// =============================================================================
+
+// Serve until a client sends `shutdown`; returns the process exit code
+automation_serve :: proc(socket_path: string, workers: int = 0) -> int {
+    // Reader threads and pool tasks hold this pointer, so it must not live on this stack frame
+    server := new(AutomationServer)
+    defer free(server)
+
+    if !server_listen(server, socket_path) {
+        return 1
+    }
+    defer server_close(server)
+
+    thread.pool_init(&server.pool, context.allocator, workers > 0 ? workers : os.processor_core_count())
+    thread.pool_start(&server.pool)
+
+    fmt.printf("🛰️  Automation server listening on %s (%d worker(s))\n", socket_path, len(server.pool.threads))
+
+    for sync.atomic_load(&server.running) {
+        fd := posix.accept(server.listen_fd, nil, nil)
+        if fd < 0 {
+            if sync.atomic_load(&server.running) {
+                fmt.eprintln("⚠️  accept failed:", posix.strerror(posix.errno()))
+            }
+            continue
+        }
+        if !sync.atomic_load(&server.running) {
+            posix.close(fd)
+            break
+        }
+
+        server_reap_readers(server, false)
+
+        conn := new(Connection)
+        conn.fd = fd
+        conn.refs = 2
+        reader := thread.create_and_start_with_poly_data2(server, conn, connection_reader)
+        append(&server.readers, ReaderThread{thread = reader, conn = conn})
+    }
+
+    // No reader may still be routing requests into the pool or reading documents
+    server_reap_readers(server, true)
+
+    // Let queued document work finish before documents are destroyed
+    thread.pool_finish(&server.pool)
+    thread.pool_destroy(&server.pool)
+
+    fmt.printf("🛰️  Automation server stopped after %d request(s) in %.1f s\n",
+        sync.atomic_load(&server.requests_served), time.duration_seconds(time.tick_since(server.started)))
+    return 0
+}
+
+@(private="file")
+server_listen :: proc(server: ^AutomationServer, socket_path: string) -> bool {
+    addr := posix.sockaddr_un{sun_family = .UNIX}
+    if len(socket_path) >= len(addr.sun_path) {
+        fmt.eprintln("❌ Socket path too long:", socket_path)
+        return false
+    }
+    copy(addr.sun_path[:], socket_path)
+
+    // Writing to a client that hung up must fail the write, not kill the server
+    posix.signal(.SIGPIPE, posix.SIG_IGN)
+
+    fd := posix.socket(.UNIX, .STREAM)
+    if fd < 0 {
+        fmt.eprintln("❌ socket failed:", posix.strerror(posix.errno()))
+        return false
+    }
+
+    // A stale socket file from a previous run would make bind fail
+    posix.unlink(strings.clone_to_cstring(socket_path, context.temp_allocator))
+
+    if posix.bind(fd, (^posix.sockaddr)(&addr), size_of(addr)) != .OK ||
+       posix.listen(fd, SERVER_LISTEN_BACKLOG) != .OK {
+        fmt.eprintln("❌ Cannot listen on", socket_path, "-", posix.strerror(posix.errno()))
+        posix.close(fd)
+        return false
+    }
+
+    server.socket_path = socket_path
+    server.listen_fd = fd
+    server.documents = make(map[string]^AutomationDocument)
+    server.running = true
+    server.started = time.tick_now()
+    return true
+}
+
+// Join finished readers (all of them when stopping: their sockets are shut down for
+// reading first, so each blocked recv returns). Queued responses can still be written.
+@(private="file")
+server_reap_readers :: proc(server: ^AutomationServer, stopping: bool) {
+    if stopping {
+        for reader in server.readers {
+            posix.shutdown(reader.conn.fd, .RD)
+        }
+    }
+
+    for i := 0; i < len(server.readers); {
+        reader := server.readers[i]
+        if !stopping && !thread.is_done(reader.thread) {
+            i += 1
+            continue
+        }
+        thread.destroy(reader.thread)
+        connection_release(reader.conn)
+        unordered_remove(&server.readers, i)
+    }
+}
+
+@(private="file")
+server_close :: proc(server: ^AutomationServer) {
+    posix.close(server.listen_fd)
+    posix.unlink(strings.clone_to_cstring(server.socket_path, context.temp_allocator))
+
+    for name, document in server.documents {
+        document_unload(document)
+        delete(document.queue)
+        delete(name)
+        free(document)
+    }
+    delete(server.documents)
+    delete(server.readers)
+}
+
+// Stop accepting; the blocked accept() is woken by a throwaway connection
+@(private="file")
+server_request_stop :: proc(server: ^AutomationServer) {
+    if !sync.atomic_exchange(&server.running, false) {
+        return
+    }
+
+    addr := posix.sockaddr_un{sun_family = .UNIX}
+    copy(addr.sun_path[:], server.socket_path)
+    fd := posix.socket(.UNIX, .STREAM)
+    if fd >= 0 {
+        posix.connect(fd, (^posix.sockaddr)(&addr), size_of(addr))
+        posix.close(fd)
+    }
+}
+
+// =============================================================================
+// Connections
+// =============================================================================
+
+// Reader thread: split the stream into lines and route each request
+@(private="file")
+connection_reader :: proc(server: ^AutomationServer, conn: ^Connection) {
+    buffer := make([dynamic]u8, 0, 64 * 1024)
+    defer delete(buffer)
+
+    chunk: [64 * 1024]u8
+    for {
+        n := posix.recv(conn.fd, raw_data(chunk[:]), len(chunk), {})
+        if n <= 0 {
+            break
+        }
+        append(&buffer, ..chunk[:n])
+
+        // Dispatch every complete line; keep the partial tail
+        consumed := 0
+        for {
+            newline := -1
+            for i in consumed..<len(buffer) {
+                if buffer[i] == '\n' {
+                    newline = i
+                    break
+                }
+            }
+            if newline < 0 do break
+
+            line := strings.trim_space(string(buffer[consumed:newline]))
+            consumed = newline + 1
+            if len(line) > 0 {
+                route_request(server, conn, line)
+            }
+        }
+        remove_range(&buffer, 0, consumed)
+
+        if len(buffer) > MAX_REQUEST_BYTES {
+            respond_error(conn, 0, "request too large")
+            break
+        }
+        free_all(context.temp_allocator)
+    }
+
+    connection_release(conn)
+}
+
+@(private="file")
+connection_release :: proc(conn: ^Connection) {
+    if sync.atomic_sub(&conn.refs, 1) == 1 {
+        posix.close(conn.fd)
+        free(conn)
+    }
+}
+
+// Write all of data (under the connection's write lock)
+@(private="file")
+connection_write :: proc(conn: ^Connection, data: []u8) {
+    sync.mutex_lock(&conn.write_mutex)
+    defer sync.mutex_unlock(&conn.write_mutex)
+
+    for sent := 0; sent < len(data); {
+        n := posix.send(conn.fd, raw_data(data[sent:]), uint(len(data) - sent), {})
+        if n <= 0 {
+            return
+        }
+        sent += int(n)
+    }
+}
+
+// =============================================================================
+// Request Routing
+// =============================================================================
+
+// Document requests go to the document's queue; server-level requests are answered inline
+@(private="file")
+route_request :: proc(server: ^AutomationServer, conn: ^Connection, line: string) {
+    request: Request
+    request.feature = -1
+    request.depth = DEFAULT_LOAD_DEPTH
+    if err := json.unmarshal_string(line, &request); err != nil {
+        request_destroy(&request)
+        respond_error(conn, 0, fmt.tprintf("malformed request: %v", err))
+        return
+    }
+
+    switch request.op {
+    case "ping", "stats", "shutdown":
+        handle_server_request(server, conn, request)
+        request_destroy(&request)
+        return
+    }
+
+    if !sync.atomic_load(&server.running) {
+        respond_error(conn, request.id, "server is shutting down")
+        request_destroy(&request)
+        return
+    }
+    if len(request.doc) == 0 {
+        respond_error(conn, request.id, "missing \"doc\"")
+        request_destroy(&request)
+        return
+    }
+
+    sync.mutex_lock(&server.mutex)
+    document, found := server.documents[request.doc]
+    if !found {
+        // Only `load` creates documents, so mistyped or one-off names don't pile up
+        if request.op != "load" {
+            sync.mutex_unlock(&server.mutex)
+            sync.atomic_add(&server.requests_served, 1)
+            respond_error(conn, request.id, fmt.tprintf("document '%s' is not loaded", request.doc))
+            request_destroy(&request)
+            return
+        }
+        document = new(AutomationDocument)
+        document.name = strings.clone(request.doc)
+        server.documents[document.name] = document
+    }
+    sync.atomic_add(&conn.refs, 1)
+    append(&document.queue, PendingRequest{conn = conn, request = request})
+    start_task := !document.scheduled
+    document.scheduled = true
+    sync.mutex_unlock(&server.mutex)
+
+    if start_task {
+        thread.pool_add_task(&server.pool, context.allocator, document_drain_task, server_document_task_data(server, document))
+    }
+}
+
+// Pool task data: the server and one document
+@(private="file")
+DocumentTask :: struct {
+    server: ^AutomationServer,
+    document: ^AutomationDocument,
+}
+
+@(private="file")
+server_document_task_data :: proc(server: ^AutomationServer, document: ^AutomationDocument) -> rawptr {
+    data := new(DocumentTask)
+    data^ = {server, document}
+    return data
+}
+
+// Pool task: run the document's queued requests until the queue is empty
+// A document left unloaded (closed, or a failed first load) is removed from the server then.
+@(private="file")
+document_drain_task :: proc(task: thread.Task) {
+    data := (^DocumentTask)(task.data)
+    server, document := data.server, data.document
+    free(data)
+
+    for {
+        sync.mutex_lock(&server.mutex)
+        if len(document.queue) == 0 {
+            document.scheduled = false
+            if !document.loaded {
+                delete_key(&server.documents, document.name)
+                delete(document.queue)
+                delete(document.name)
+                free(document)
+            }
+            sync.mutex_unlock(&server.mutex)
+            return
+        }
+        pending := pop_front(&document.queue)
+        sync.mutex_unlock(&server.mutex)
+
+        handle_document_request(server, document, pending.conn, pending.request)
+
+        request_destroy(&pending.request)
+        connection_release(pending.conn)
+        free_all(context.temp_allocator)
+    }
+}
+
+// =============================================================================
+// Request Handlers
+// =============================================================================
+
+@(private="file")
+handle_server_request :: proc(server: ^AutomationServer, conn: ^Connection, request: Request) {
+    start := time.tick_now()
+    sync.atomic_add(&server.requests_served, 1)
+
+    b := response_begin(request.id, true)
+    switch request.op {
+    case "stats":
+        sync.mutex_lock(&server.mutex)
+        loaded := 0
+        for _, document in server.documents {
+            if sync.atomic_load(&document.loaded) do loaded += 1
+        }
+        sync.mutex_unlock(&server.mutex)
+
+        fmt.sbprintf(&b, ",\"documents\":%d,\"requests\":%d,\"uptime_s\":%.3f,\"primitive_templates\":%d",
+            loaded, sync.atomic_load(&server.requests_served),
+            time.duration_seconds(time.tick_since(server.started)), primitives.primitive_template_count())
+    case "shutdown":
+        server_request_stop(server)
+    }
+    response_end(&b, start)
+    connection_write(conn, b.buf[:])
+}
+
+@(private="file")
+handle_document_request :: proc(server: ^AutomationServer, document: ^AutomationDocument, conn: ^Connection, request: Request) {
+    start := time.tick_now()
+    sync.atomic_add(&server.requests_served, 1)
+
+    if request.op != "load" && !document.loaded {
+        respond_error(conn, request.id, fmt.tprintf("document '%s' is not loaded", document.name))
+        return
+    }
+
+    b := response_begin(request.id, true)
+    switch request.op {
+    case "load":
+        if len(request.path) == 0 {
+            respond_error(conn, request.id, "missing \"path\"")
+            return
+        }
+        if ok, message := document_load(document, request.path, request.depth); !ok {
+            respond_error(conn, request.id, message)
+            return
+        }
+        fmt.sbprintf(&b, ",\"features\":%d", len(document.tree.features))
+
+    case "set_param":
+        if ok, message := document_set_param(document, request.feature, request.param, request.value); !ok {
+            respond_error(conn, request.id, message)
+            return
+        }
+
+    case "regenerate":
+        regenerated, failed := document_regenerate(document)
+        if failed > 0 {
+            respond_error(conn, request.id, fmt.tprintf("%d of %d feature(s) failed to regenerate", failed, regenerated))
+            return
+        }
+        fmt.sbprintf(&b, ",\"regenerated\":%d", regenerated)
+
+    case "mass_properties":
+        document_regenerate(document)
+        props, cached := document_mass_properties(document)
+        fmt.sbprintf(&b, ",\"cached\":%v,\"volume\":%.9g,\"area\":%.9g", cached, props.volume, props.area)
+        fmt.sbprintf(&b, ",\"centroid\":[%.9g,%.9g,%.9g]", props.centroid.x, props.centroid.y, props.centroid.z)
+        fmt.sbprintf(&b, ",\"bbox_min\":[%.9g,%.9g,%.9g]", props.bbox_min.x, props.bbox_min.y, props.bbox_min.z)
+        fmt.sbprintf(&b, ",\"bbox_max\":[%.9g,%.9g,%.9g]", props.bbox_max.x, props.bbox_max.y, props.bbox_max.z)
+        fmt.sbprintf(&b, ",\"bodies\":%d,\"triangles\":%d", props.bodies, props.triangles)
+
+    case "export_stl":
+        if len(request.path) == 0 {
+            respond_error(conn, request.id, "missing \"path\"")
+            return
+        }
+        document_regenerate(document)
+        triangles, ok, message := document_export_stl(document, request.path)
+        if !ok {
+            respond_error(conn, request.id, message)
+            return
+        }
+        fmt.sbprintf(&b, ",\"triangles\":%d", triangles)
+
+    case "close":
+        document_unload(document)
+
+    case:
+        respond_error(conn, request.id, fmt.tprintf("unknown op '%s'", request.op))
+        return
+    }
+    response_end(&b, start)
+    connection_write(conn, b.buf[:])
+}
+
+// =============================================================================
+// Responses
+// =============================================================================
+
+@(private="file")
+response_begin :: proc(id: i64, ok: bool) -> strings.Builder {
+    b := strings.builder_make(context.temp_allocator)
+    fmt.sbprintf(&b, "{\"id\":%d,\"ok\":%v", id, ok)
+    return b
+}
+
+@(private="file")
+response_end :: proc(b: ^strings.Builder, start: time.Tick) {
+    fmt.sbprintf(b, ",\"ms\":%.3f}\n", elapsed_ms(start))
+}
+
+@(private="file")
+respond_error :: proc(conn: ^Connection, id: i64, message: string) {
+    b := response_begin(id, false)
+    strings.write_string(&b, ",\"error\":")
+    write_json_string(&b, message)
+    strings.write_string(&b, "}\n")
+    connection_write(conn, b.buf[:])
+}
+
+// JSON string with the escapes required by RFC 8259
+@(private="file")
+write_json_string :: proc(b: ^strings.Builder, s: string) {
+    HEX :: "0123456789abcdef"
+    strings.write_byte(b, '"')
+    start := 0
+    for i in 0..<len(s) {
+        c := s[i]
+        if c != '"' && c != '\\' && c >= 0x20 do continue
+
+        strings.write_string(b, s[start:i])
+        switch c {
+        case '"':  strings.write_string(b, "\\\"")
+        case '\\': strings.write_string(b, "\\\\")
+        case '\n': strings.write_string(b, "\\n")
+        case '\t': strings.write_string(b, "\\t")
+        case '\r': strings.write_string(b, "\\r")
+        case:
+            esc := [6]byte{'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]}
+            strings.write_bytes(b, esc[:])
+        }
+        start = i + 1
+    }
+    strings.write_string(b, s[start:])
+    strings.write_byte(b, '"')
+}
+
+@(private="file")
+request_destroy :: proc(request: ^Request) {
+    delete(request.op)
+    delete(request.doc)
+    delete(request.path)
+    delete(request.param)
+}
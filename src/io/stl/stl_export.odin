@@ -7,6 +7,7 @@ import "core:os"
 import "core:encoding/endian"
 import m "../../core/math"
 import extrude "../../features/extrude"
+import tess "../../core/tessellation"
 
 // STL Export Result
 STLExportResult :: struct {
@@ -53,7 +54,12 @@ export_stl :: proc(solid: ^extrude.SimpleSolid, filepath: string) -> STLExportRe
 }
 
 // Export all solids from feature tree to binary STL file
-export_feature_tree_to_stl :: proc(features: []^extrude.SimpleSolid, filepath: string) -> STLExportResult {
+// triangle_budget > 0: solids are QEM-decimated proportionally so the file stays within the budget
+export_feature_tree_to_stl :: proc(
+	features: []^extrude.SimpleSolid,
+	filepath: string,
+	triangle_budget: int = 0,
+) -> STLExportResult {
 	result: STLExportResult
 	result.filepath = filepath
 
@@ -75,6 +81,39 @@ export_feature_tree_to_stl :: proc(features: []^extrude.SimpleSolid, filepath: s
 		return result
 	}
 
+	// Decimate copies of the solids when over budget (originals are left untouched)
+	decimated := make([dynamic]^extrude.SimpleSolid, 0, len(features))
+	defer {
+		for &solid in decimated {
+			extrude.simple_solid_release(&solid)
+		}
+		delete(decimated)
+	}
+
+	export_solids := features
+	if triangle_budget > 0 && total_triangles > triangle_budget {
+		ratio := f64(triangle_budget) / f64(total_triangles)
+		original_triangles := total_triangles
+		export_solids = make([]^extrude.SimpleSolid, len(features), context.temp_allocator)
+		total_triangles = 0
+
+		for solid, i in features {
+			export_solids[i] = solid
+			if solid == nil do continue
+
+			params := tess.DEFAULT_DECIMATE
+			params.target_triangles = max(int(f64(len(solid.triangles)) * ratio), 4)
+			if lod, _ := extrude.simple_solid_decimate(solid, params); lod != nil {
+				append(&decimated, lod)
+				export_solids[i] = lod
+			}
+			total_triangles += len(export_solids[i].triangles)
+		}
+
+		fmt.printf("🔧 Decimated export mesh: %d → %d triangles (budget %d)\n",
+			original_triangles, total_triangles, triangle_budget)
+	}
+
 	// Create STL file
 	file, err := os.open(filepath, os.O_WRONLY | os.O_CREATE | os.O_TRUNC, 0o644)
 	if err != os.ERROR_NONE {
@@ -97,7 +136,7 @@ export_feature_tree_to_stl :: proc(features: []^extrude.SimpleSolid, filepath: s
 	os.write(file, count_bytes[:])
 
 	// Write all triangles from all solids
-	for solid in features {
+	for solid in export_solids {
 		if solid != nil {
 			for tri in solid.triangles {
 				write_stl_triangle(file, tri)
@@ -11,13 +11,19 @@ import "core:fmt"
 import "core:math"
 import glsl "core:math/linalg/glsl"
 import "core:os"
+import "core:path/filepath"
 import "core:strconv"
+import "core:strings"
+import "core:sync"
+import "core:thread"
+import "core:time"
 import cut "features/cut"
 import extrude "features/extrude"
 import ftree "features/feature_tree"
 import primitives "features/primitives"
 import revolve "features/revolve"
 import sketch "features/sketch"
+import automation "io/automation"
 import stl "io/stl"
 import occt "core/geometry/occt"
 import v "ui/viewer"
@@ -44,7 +50,16 @@ SketchPlaneType :: enum {
 // Face selection (for sketch-on-face)
 SelectedFace :: struct {
 	feature_id: int, // ID of the feature containing the solid
-	face_index: int, // Index of the face within the solid
+	face_index: int, // Index of the face within the solid (or its exact face table)
+	exact:      bool, // face_index refers to ftree.feature_face_table, not result_solid.faces
+}
+
+// Edge wireframe of a final solid (placed bodies are drawn through their placement)
+SolidWireframeGPU :: struct {
+	feature_id: int,
+	solid:      ^extrude.SimpleSolid, // Solid the mesh was built from
+	mesh:       v.WireframeMeshGPU,
+	transform:  matrix[4,4]f32, // Mesh space → world
 }
 
 // Application state
@@ -75,7 +90,13 @@ AppStateGPU :: struct {
 	cut_feature_id:             int,
 
 	// Wireframe cache for all solids
-	solid_wireframes:           [dynamic]v.WireframeMeshGPU,
+	solid_wireframes:           [dynamic]SolidWireframeGPU,
+	mesh_revisions:             map[int]u64, // Feature revision each feature's cached GPU meshes were built from
+
+	// Edge/vertex picking in Solid Mode
+	solid_picker:               v.SolidPicker,
+	hovered_pick:               v.PickResult, // Edge/vertex under the cursor
+	selected_pick:              v.PickResult, // Last clicked edge/vertex
 
 	// Update flags
 	needs_wireframe_update:     bool,
@@ -83,6 +104,9 @@ AppStateGPU :: struct {
 	needs_solid_update:         bool,
 	needs_redraw:               bool, // Event-driven rendering: only redraw when true
 
+	// Background constraint solver (results applied by poll_async_solve_gpu)
+	solver:                     sketch.AsyncSolver,
+
 	// Status message (for status bar feedback)
 	status_message:             string,
 
@@ -98,6 +122,9 @@ AppStateGPU :: struct {
 	// Sketch visualization settings
 	show_profile_fill:          bool, // Toggle for closed shape visualization
 
+	// Hi-Z occlusion culling of shaded bodies (F5)
+	occlusion_culling:          bool,
+
 	// Command history (undo/redo system)
 	command_history:            cmd.CommandHistory,
 	shift_held:                 bool, // Track shift key for Ctrl+Shift+Z
@@ -203,25 +230,22 @@ solve_constraints :: proc(app: ^AppStateGPU) {
 
 	fmt.println("\n=== Running Constraint Solver ===")
 
-	result := sketch.sketch_solve_constraints(active_sketch)
-	sketch.solver_result_print(result)
-
-	if result.status == .Success {
-		fmt.println("✅ Constraints solved! Geometry updated.")
-		app.needs_wireframe_update = true
-		app.needs_selection_update = true
-	} else if result.status == .Underconstrained {
-		fmt.println("⚠️  Sketch needs more constraints to be fully defined")
-	} else if result.status == .Overconstrained {
-		fmt.println("❌ Sketch has conflicting constraints")
-	} else if result.status == .MaxIterations {
-		fmt.println("⚠️  Solver reached maximum iterations without converging")
-	} else if result.status == .MaxIterations {
-		fmt.println("❌ Numerical error during solving")
-	}
+	// Result is reported by poll_async_solve_gpu when the worker finishes
+	sketch.sketch_solve_async(&app.solver, active_sketch)
+	app.status_message = "Solving constraints..."
 }
 
 main :: proc() {
+	// Headless thumbnail / contact sheet rendering (no window)
+	if len(os.args) > 1 && os.args[1] == "--render" {
+		os.exit(run_preview_cli(os.args[2:]))
+	}
+
+	// Persistent automation server on a Unix socket (no window)
+	if len(os.args) > 1 && os.args[1] == "--serve" {
+		os.exit(run_automation_server(os.args[2:]))
+	}
+
 	fmt.println("=== OhCAD Interactive Sketcher (SDL3 GPU) ===")
 
 	// Initialize OCCT library
@@ -259,6 +283,10 @@ main :: proc() {
 		return
 	}
 	defer v.text_renderer_gpu_destroy(&text_renderer)
+	text_renderer.profiler = &viewer_inst.profiler
+
+	// Shared primitive meshes outlive every feature that instances them
+	defer primitives.primitive_template_cache_destroy()
 
 	// Initialize feature tree (empty - no initial sketch)
 	feature_tree := ftree.feature_tree_init()
@@ -277,6 +305,10 @@ main :: proc() {
 	app.text_renderer = text_renderer
 	app.ui_context = ui.ui_context_init(viewer_inst, &text_renderer)
 	app.cad_ui_state = ui.cad_ui_state_init()
+	defer ui.cad_ui_state_destroy(&app.cad_ui_state)
+	sketch.sketch_async_solver_init(&app.solver)
+	defer sketch.sketch_async_solver_destroy(&app.solver)
+	app.cad_ui_state.async_solver = &app.solver
 	app.document_settings = doc.document_settings_default() // Initialize document settings
 	app._sketch = nil // No global sketch anymore
 	app.wireframe = wireframe
@@ -290,6 +322,9 @@ main :: proc() {
 	// Enable profile fill visualization by default
 	app.show_profile_fill = true
 
+	// Cull hidden bodies on the GPU when the device supports it
+	app.occlusion_culling = true
+
 	// Initialize command history (undo/redo system)
 	app.command_history = cmd.command_history_init(50) // Max 50 commands
 	defer cmd.command_history_destroy(&app.command_history)
@@ -313,16 +348,19 @@ main :: proc() {
 	app.sketch_feature_id = -1 // No sketch
 	app.extrude_feature_id = -1
 	app.cut_feature_id = -1
-	app.solid_wireframes = make([dynamic]v.WireframeMeshGPU)
+	app.solid_wireframes = make([dynamic]SolidWireframeGPU)
+	app.mesh_revisions = make(map[int]u64)
 	app.needs_wireframe_update = false
 	app.needs_selection_update = false
 	app.needs_redraw = true // Render first frame
 
 	defer {
-		for &mesh in app.solid_wireframes {
-			v.wireframe_mesh_gpu_destroy(&mesh)
+		for &wireframe in app.solid_wireframes {
+			v.wireframe_mesh_gpu_destroy(&wireframe.mesh)
 		}
 		delete(app.solid_wireframes)
+		delete(app.mesh_revisions)
+		v.solid_picker_destroy(&app.solid_picker)
 		free(app)
 	}
 
@@ -339,6 +377,9 @@ main :: proc() {
 	fmt.println("  [E] Extrude sketch")
 	fmt.println("  [O] Revolve sketch")
 	fmt.println("  [T] Cut/Pocket from sketch")
+	fmt.println("  [U] Toggle simplified (defeatured) rep on active feature")
+	fmt.println("  [M] Move active body / [Shift+M] Copy active body")
+	fmt.println("  [Arrows] Nudge moved/copied body in X/Y ([Shift+Up/Down] Z)")
 	fmt.println("  [+]/[-] Change extrude/revolve depth/angle")
 	fmt.println("")
 	fmt.println("=== Sketch Mode (2D) ===")
@@ -355,12 +396,15 @@ main :: proc() {
 	fmt.println("")
 	fmt.println("=== Global ===")
 	fmt.println("  [Ctrl+Shift+E] Export to STL")
+	fmt.println("  [Ctrl+Shift+D] Export simplified (defeatured) STL")
 	fmt.println("  [Ctrl+Z] Undo")
 	fmt.println("  [Ctrl+Shift+Z] / [Ctrl+Y] Redo")
 	fmt.println("  [R] Regenerate all features")
 	fmt.println("  [F] Print feature tree")
 	fmt.println("  [W] Wireframe mode / [Shift+W] Shaded mode")
 	fmt.println("  [HOME] Reset camera")
+	fmt.println("  [F3] Frame-time HUD / [F4] Export frame stats CSV")
+	fmt.println("  [F5] Toggle occlusion culling")
 	fmt.println("  [Q] Quit\n")
 
 	// Main render loop (event-driven rendering for efficiency)
@@ -368,6 +412,11 @@ main :: proc() {
 		// Poll all pending events (non-blocking)
 		handle_events_gpu(app)
 
+		// Pick up a finished background solve (redraws with the solved geometry)
+		if poll_async_solve_gpu(app) {
+			app.needs_redraw = true
+		}
+
 		// Only update and render if something changed
 		if app.needs_redraw {
 			// Update wireframe if needed (use active sketch)
@@ -388,8 +437,8 @@ main :: proc() {
 			// Render frame
 			render_frame_gpu(app)
 
-			// Reset redraw flag after rendering
-			app.needs_redraw = false
+			// Reset redraw flag after rendering (the frame-time HUD keeps frames coming)
+			app.needs_redraw = app.viewer.profiler.hud_visible
 		} else {
 			// Nothing to draw - sleep briefly to avoid busy-waiting
 			// This allows event processing while keeping CPU usage minimal
@@ -570,6 +619,12 @@ handle_events_gpu :: proc(app: ^AppStateGPU) {
 				v.viewer_gpu_handle_mouse_motion(app.viewer, &event.motion)
 			}
 
+			// Solid Mode: hover edges/vertices (skipped while orbiting/panning)
+			if app.mode == .Solid && !app.viewer.mouse_left_down && !app.viewer.mouse_middle_down &&
+			   !app.viewer.mouse_right_down {
+				update_solid_hover_gpu(app)
+			}
+
 		case .MOUSE_BUTTON_DOWN, .MOUSE_BUTTON_UP:
 			// Track left button state for UI
 			if event.button.button == u8(sdl.BUTTON_LEFT) {
@@ -594,15 +649,7 @@ handle_events_gpu :: proc(app: ^AppStateGPU) {
 									fmt.println(
 										"🔄 Re-solving constraints after radius change...",
 									)
-									result := sketch.sketch_solve_constraints(active_sketch)
-									if result.status == .Success {
-										fmt.println("✅ Constraints solved!")
-									} else {
-										fmt.println(
-											"⚠️  Constraint solving status:",
-											result.status,
-										)
-									}
+									sketch.sketch_solve_async(&app.solver, active_sketch)
 								}
 							}
 						}
@@ -673,7 +720,12 @@ handle_events_gpu :: proc(app: ^AppStateGPU) {
 			v.viewer_gpu_handle_mouse_button(app.viewer, &event.button)
 
 		case .MOUSE_WHEEL:
-			v.viewer_gpu_handle_mouse_wheel(app.viewer, &event.wheel)
+			// Over a panel the wheel scrolls the UI (feature history) instead of zooming
+			if app.ui_context.mouse_over_ui {
+				app.ui_context.scroll_y += event.wheel.y
+			} else {
+				v.viewer_gpu_handle_mouse_wheel(app.viewer, &event.wheel)
+			}
 
 		case .FINGER_DOWN, .FINGER_UP, .FINGER_MOTION:
 			v.viewer_gpu_handle_finger(app.viewer, &event)
@@ -732,6 +784,37 @@ handle_key_down_gpu :: proc(app: ^AppStateGPU, key: sdl.Keycode, mods: sdl.Keymo
 		return
 	}
 
+	// STL EXPORT: [Ctrl+Shift+D] Export defeatured solids (simulation/lightweight)
+	if app.ctrl_held && app.shift_held && key == sdl.K_D {
+		export_to_stl_gpu(app, .Simulation)
+		return
+	}
+
+	// FRAME STATS: [F3] Toggle frame-time HUD, [F4] Export frame history to CSV
+	if key == sdl.K_F3 {
+		app.viewer.profiler.hud_visible = !app.viewer.profiler.hud_visible
+		fmt.printf("📊 Frame-time HUD %s\n", app.viewer.profiler.hud_visible ? "on" : "off")
+		return
+	}
+	if key == sdl.K_F4 {
+		v.frame_profiler_export_csv(&app.viewer.profiler, "frame_stats.csv")
+		return
+	}
+
+	// OCCLUSION: [F5] Toggle GPU occlusion culling of shaded bodies
+	if key == sdl.K_F5 {
+		app.occlusion_culling = !app.occlusion_culling
+		fmt.printf("🫥 Occlusion culling %s\n", app.occlusion_culling ? "on" : "off")
+		v.occlusion_print_stats(app.viewer)
+		return
+	}
+
+	// HISTORY PANEL: [PageUp]/[PageDown] Scroll the feature tree a page at a time
+	if key == sdl.K_PAGEUP || key == sdl.K_PAGEDOWN {
+		ui.ui_feature_tree_scroll_pages(&app.cad_ui_state, key == sdl.K_PAGEUP ? -1 : 1)
+		return
+	}
+
 	// TEST COMMAND: [Ctrl+T] Add a test line command to verify undo/redo works
 	if app.ctrl_held && key == sdl.K_T {
 		active_sketch := get_active_sketch(app)
@@ -782,10 +865,11 @@ handle_key_down_gpu :: proc(app: ^AppStateGPU, key: sdl.Keycode, mods: sdl.Keymo
 
 	case sdl.K_F:
 		ftree.feature_tree_print(&app.feature_tree)
+		v.gpu_mesh_cache_print_stats(&app.viewer.mesh_cache)
 		return
 
 	case sdl.K_R:
-		ftree.feature_tree_regenerate_all(&app.feature_tree)
+		regenerate_all_timed_gpu(app)
 		update_solid_wireframes_gpu(app)
 		fmt.println("🔄 Regenerated all features")
 		return
@@ -871,6 +955,25 @@ handle_solid_mode_keys :: proc(app: ^AppStateGPU, key: sdl.Keycode, mods: sdl.Ke
 	case sdl.K_T:
 		test_cut_gpu(app)
 
+	case sdl.K_U:
+		toggle_simplified_rep_gpu(app)
+
+	case sdl.K_M:
+		// M: Move active body, Shift+M: Copy it
+		add_placed_body_gpu(app, .LSHIFT in mods || .RSHIFT in mods)
+
+	case sdl.K_LEFT, sdl.K_RIGHT, sdl.K_UP, sdl.K_DOWN:
+		// Arrows nudge the active moved/copied body in X/Y (Shift+Up/Down: Z)
+		shift := .LSHIFT in mods || .RSHIFT in mods
+		offset: m.Vec3
+		switch key {
+		case sdl.K_LEFT:  offset = m.Vec3{-BODY_NUDGE_STEP, 0, 0}
+		case sdl.K_RIGHT: offset = m.Vec3{BODY_NUDGE_STEP, 0, 0}
+		case sdl.K_UP:    offset = shift ? m.Vec3{0, 0, BODY_NUDGE_STEP} : m.Vec3{0, BODY_NUDGE_STEP, 0}
+		case sdl.K_DOWN:  offset = shift ? m.Vec3{0, 0, -BODY_NUDGE_STEP} : m.Vec3{0, -BODY_NUDGE_STEP, 0}
+		}
+		nudge_placed_body_gpu(app, offset)
+
 	case sdl.K_EQUALS, sdl.K_KP_PLUS:
 		change_active_feature_parameter(app, 0.1)
 
@@ -1028,8 +1131,15 @@ handle_mouse_button_gpu :: proc(app: ^AppStateGPU, button: ^sdl.MouseButtonEvent
 		// Mode-specific click handling
 		switch app.mode {
 		case .Solid:
-			// Solid Mode: Click to select faces
-			select_face_at_cursor(app, app.mouse_x, app.mouse_y)
+			// Solid Mode: Click selects the hovered edge/vertex, otherwise a face
+			if app.hovered_pick.kind != .None {
+				app.selected_pick = app.hovered_pick
+				print_pick_gpu(app, app.selected_pick)
+				app.needs_redraw = true
+			} else {
+				app.selected_pick = {}
+				select_face_at_cursor(app, app.mouse_x, app.mouse_y)
+			}
 
 		case .Sketch:
 			// Sketch Mode: Click to use sketch tools
@@ -1052,6 +1162,7 @@ handle_mouse_button_gpu :: proc(app: ^AppStateGPU, button: ^sdl.MouseButtonEvent
 				if circle, ok := entity.(sketch.SketchCircle); ok {
 					// Start dragging the radius handle
 					app.dragging_radius = true
+					sketch.sketch_solve_cancel(&app.solver) // An in-flight solve must not overwrite the drag
 					app.dragging_circle_id = app.hover_state.entity_id
 					app.drag_start_radius = circle.radius
 					fmt.printf(
@@ -1071,6 +1182,7 @@ handle_mouse_button_gpu :: proc(app: ^AppStateGPU, button: ^sdl.MouseButtonEvent
 				if point != nil && !point.fixed {
 					// Start dragging the endpoint point (reuses point dragging system)
 					app.dragging_point = true
+					sketch.sketch_solve_cancel(&app.solver) // An in-flight solve must not overwrite the drag
 					app.dragging_point_id = app.hover_state.point_id
 					app.drag_start_pos = m.Vec2{point.x, point.y}
 					fmt.printf(
@@ -1107,6 +1219,7 @@ handle_mouse_button_gpu :: proc(app: ^AppStateGPU, button: ^sdl.MouseButtonEvent
 				if point != nil && !point.fixed {
 					// Start dragging this point
 					app.dragging_point = true
+					sketch.sketch_solve_cancel(&app.solver) // An in-flight solve must not overwrite the drag
 					app.dragging_point_id = app.hover_state.point_id
 					app.drag_start_pos = m.Vec2{point.x, point.y}
 					fmt.printf(
@@ -1180,7 +1293,7 @@ handle_mouse_button_gpu :: proc(app: ^AppStateGPU, button: ^sdl.MouseButtonEvent
 			// This ensures selection uses the same screen-space tolerances as hover (no mismatch)
 			if active_sketch.current_tool == .Select {
 				#partial switch app.hover_state.entity_type {
-				case .Point, .Line, .Circle, .Arc:
+				case .Point, .Line, .Circle, .Arc, .Spline:
 					// Hovering over an entity - select it directly using hover state
 					active_sketch.selected_entity = app.hover_state.entity_id
 					active_sketch.selected_constraint_id = -1 // Deselect constraint
@@ -1388,7 +1501,7 @@ render_hover_highlight_gpu :: proc(
 
 		v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, point, mvp, hover_color, 6.0)
 
-	case .Line, .Circle, .Arc:
+	case .Line, .Circle, .Arc, .Spline:
 		// Render hovered entity wireframe with thicker line
 		if app.hover_state.entity_id < 0 || app.hover_state.entity_id >= len(sk.entities) {
 			return
@@ -1419,6 +1532,12 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 	cmd := sdl.AcquireGPUCommandBuffer(app.viewer.gpu_device)
 	if cmd == nil do return
 
+	profiler := &app.viewer.profiler
+	v.frame_profiler_begin_frame(profiler)
+
+	// Advance the GPU mesh cache clock (LRU eviction skips meshes drawn this frame)
+	v.gpu_mesh_cache_begin_frame(&app.viewer.mesh_cache)
+
 	// Acquire swapchain texture
 	swapchain: ^sdl.GPUTexture
 	w, h: u32
@@ -1437,8 +1556,8 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 		// Create depth texture for this frame (matches swapchain size)
 		depth_texture_info := sdl.GPUTextureCreateInfo {
 			type                 = .D2,
-			format               = .D16_UNORM,
-			usage                = {.DEPTH_STENCIL_TARGET},
+			format               = app.viewer.depth_format,
+			usage                = v.occlusion_depth_usage(app.viewer), // Sampled by the Hi-Z pyramid build
 			width                = w,
 			height               = h,
 			layer_count_or_depth = 1,
@@ -1452,6 +1571,70 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 		}
 		defer sdl.ReleaseGPUTexture(app.viewer.gpu_device, depth_texture)
 
+		// Calculate MVP matrix
+		view := v.camera_get_view_matrix(&app.viewer.camera)
+		proj := v.camera_get_projection_matrix(&app.viewer.camera)
+		mvp := proj * view
+
+		viewport := sdl.GPUViewport {
+			x         = 0,
+			y         = 0,
+			w         = f32(w),
+			h         = f32(h),
+			min_depth = 0.0,
+			max_depth = 1.0,
+		}
+		scissor := sdl.Rect {
+			x = 0,
+			y = 0,
+			w = i32(w),
+			h = i32(h),
+		}
+
+		// Occlusion culling: last frame's visible bodies go into the depth buffer first, the
+		// pyramid built from it culls the rest, and the main pass draws what was revealed
+		occlusion_items: [dynamic]v.OcclusionItem
+		if app.viewer.render_mode != .Wireframe {
+			occlusion_items = collect_shaded_bodies(app)
+		}
+		defer delete(occlusion_items)
+
+		occluders_drawn := false
+		if app.occlusion_culling && len(occlusion_items) > 0 {
+			occluders_drawn = v.occlusion_begin_frame(app.viewer, cmd, occlusion_items[:])
+		}
+
+		// Without a pyramid (tiny window) the main pass falls back to drawing every body
+		occluded := false
+		if occluders_drawn {
+			v.frame_profiler_pass(profiler, .Solids)
+
+			occluder_color := sdl.GPUColorTargetInfo {
+				texture     = swapchain,
+				load_op     = .CLEAR,
+				store_op    = .STORE,
+				clear_color = {0.08, 0.08, 0.08, 1.0},
+			}
+			occluder_depth := sdl.GPUDepthStencilTargetInfo {
+				texture          = depth_texture,
+				load_op          = .CLEAR,
+				store_op         = .STORE, // Read by the pyramid build and the main pass
+				clear_depth      = 1.0,
+				stencil_load_op  = .DONT_CARE,
+				stencil_store_op = .DONT_CARE,
+				cycle            = true,
+			}
+
+			occluder_pass := sdl.BeginGPURenderPass(cmd, &occluder_color, 1, &occluder_depth)
+			sdl.SetGPUViewport(occluder_pass, viewport)
+			sdl.SetGPUScissor(occluder_pass, scissor)
+			v.occlusion_draw(app.viewer, occlusion_items[:], .Previous, mvp)
+			v.render_queue_flush(app.viewer, cmd, occluder_pass)
+			sdl.EndGPURenderPass(occluder_pass)
+
+			occluded = v.occlusion_cull(app.viewer, cmd, depth_texture, w, h, mvp)
+		}
+
 		// Begin render pass with depth buffer
 		color_target := sdl.GPUColorTargetInfo {
 			texture     = swapchain,
@@ -1465,38 +1648,28 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 			load_op     = .CLEAR,
 			store_op    = .DONT_CARE, // We don't need to preserve depth between frames
 			clear_depth = 1.0, // Clear to far plane
+			stencil_load_op  = .CLEAR, // Profile fills expect a zeroed stencil
+			stencil_store_op = .DONT_CARE,
+			clear_stencil    = 0,
 			cycle       = true, // Allow GPU to discard previous contents
 		}
 
+		// Keep the occluders drawn above
+		if occluders_drawn {
+			color_target.load_op = .LOAD
+			depth_stencil_target.load_op = .LOAD
+			depth_stencil_target.cycle = false
+		}
+
 		pass := sdl.BeginGPURenderPass(cmd, &color_target, 1, &depth_stencil_target)
 
 		// Bind pipeline
 		sdl.BindGPUGraphicsPipeline(pass, app.viewer.pipeline)
 
-		// Set viewport
-		viewport := sdl.GPUViewport {
-			x         = 0,
-			y         = 0,
-			w         = f32(w),
-			h         = f32(h),
-			min_depth = 0.0,
-			max_depth = 1.0,
-		}
 		sdl.SetGPUViewport(pass, viewport)
-
-		// Set scissor
-		scissor := sdl.Rect {
-			x = 0,
-			y = 0,
-			w = i32(w),
-			h = i32(h),
-		}
 		sdl.SetGPUScissor(pass, scissor)
 
-		// Calculate MVP matrix
-		view := v.camera_get_view_matrix(&app.viewer.camera)
-		proj := v.camera_get_projection_matrix(&app.viewer.camera)
-		mvp := proj * view
+		v.frame_profiler_pass(profiler, .Grid)
 
 		// Render grid (behind everything)
 		v.viewer_gpu_render_grid(app.viewer, cmd, pass, mvp)
@@ -1509,6 +1682,7 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 
 		for feature in app.feature_tree.features {
 			if feature.type != .Sketch do continue
+			v.frame_profiler_pass(profiler, .Sketches)
 			if !feature.visible do continue
 
 			params, ok := feature.params.(ftree.SketchParams)
@@ -1576,6 +1750,7 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 				v.viewer_gpu_render_sketch_preview(app.viewer, cmd, pass, &app.text_renderer, active_sketch, mvp, view, proj)
 
 				// Render constraints (dimensions, icons)
+				v.frame_profiler_pass(profiler, .Constraints)
 				v.viewer_gpu_render_sketch_constraints(
 					app.viewer,
 					cmd,
@@ -1590,96 +1765,38 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 
 				// Render closed profile fills if visualization is enabled
 				if app.show_profile_fill {
+					v.frame_profiler_pass(profiler, .ProfileFills)
 					render_profile_fills_gpu(app, cmd, pass, active_sketch, mvp)
 				}
 			}
 		}
 
-		// Render 3D solids based on render mode
+		// Render 3D solids based on render mode - queued, then drawn sorted by state
+		v.frame_profiler_pass(profiler, .Solids)
 		#partial switch app.viewer.render_mode {
 		case .Wireframe:
 			// Wireframe mode: Render edges only
-			for &solid_mesh in app.solid_wireframes {
-				v.viewer_gpu_render_wireframe(
-					app.viewer,
-					cmd,
-					pass,
-					&solid_mesh,
-					{1.0, 1.0, 1.0, 1},
-					mvp,
-					2.0,
-				)
+			for &wireframe in app.solid_wireframes {
+				v.render_queue_submit_wireframe(app.viewer, &wireframe.mesh, {1.0, 1.0, 1.0, 1}, mvp * wireframe.transform, 2.0)
 			}
 
-		case .Shaded:
+		case .Shaded, .Both:
 			// Shaded mode: Render lit triangles with wireframe overlay (Fusion 360 style)
-			for feature in app.feature_tree.features {
-				if !feature.visible || !feature.enabled do continue
-				if feature.result_solid == nil do continue
-
-				// Convert solid to triangle mesh
-				tri_mesh := v.solid_to_triangle_mesh_gpu(feature.result_solid)
-				defer v.triangle_mesh_gpu_destroy(&tri_mesh)
-
-				// Render with lighting (dark gray material like Fusion 360)
-				v.viewer_gpu_render_triangle_mesh(
-					app.viewer,
-					cmd,
-					pass,
-					&tri_mesh,
-					{0.45, 0.45, 0.45, 1.0},
-					mvp,
-				)
-			}
-
-			// Render wireframe overlay for clear geometry definition
-			for &solid_mesh in app.solid_wireframes {
-				v.viewer_gpu_render_wireframe(
-					app.viewer,
-					cmd,
-					pass,
-					&solid_mesh,
-					{0.2, 0.2, 0.2, 1},
-					mvp,
-					1.5,
-				)
-			}
-
-		case .Both:
-			// Both mode: Render shaded triangles + wireframe edges
-			for feature in app.feature_tree.features {
-				if !feature.visible || !feature.enabled do continue
-				if feature.result_solid == nil do continue
-
-				// Render triangles first (shaded)
-				tri_mesh := v.solid_to_triangle_mesh_gpu(feature.result_solid)
-				defer v.triangle_mesh_gpu_destroy(&tri_mesh)
-				v.viewer_gpu_render_triangle_mesh(
-					app.viewer,
-					cmd,
-					pass,
-					&tri_mesh,
-					{0.45, 0.45, 0.45, 1.0},
-					mvp,
-				)
-			}
+			// Both mode: the same, edges drawn darker for contrast
+			queue_shaded_bodies_gpu(app, occlusion_items[:], occluded, mvp)
 
-			// Then render wireframe on top (darker for contrast)
-			for &solid_mesh in app.solid_wireframes {
-				v.viewer_gpu_render_wireframe(
-					app.viewer,
-					cmd,
-					pass,
-					&solid_mesh,
-					{0.2, 0.2, 0.2, 1},
-					mvp,
-					1.5,
-				)
+			for &wireframe in app.solid_wireframes {
+				v.render_queue_submit_wireframe(app.viewer, &wireframe.mesh, {0.2, 0.2, 0.2, 1}, mvp * wireframe.transform, 1.5)
 			}
 		}
+		v.render_queue_flush(app.viewer, cmd, pass)
+
+		v.frame_profiler_pass(profiler, .Highlights)
 
 		// Render selected face highlight (yellow semi-transparent overlay)
-		if selected_face, has_selection := app.selected_face.?; has_selection {
+		if selected_face, has_selection := app.selected_face.?; has_selection && selected_face.exact {
+			render_exact_face_outline_gpu(app, cmd, pass, selected_face, {1.0, 1.0, 0.0, 1}, mvp)
+		} else if has_selection {
 			feature := ftree.feature_tree_get_feature(&app.feature_tree, selected_face.feature_id)
 			if feature != nil && feature.result_solid != nil {
 				if selected_face.face_index >= 0 &&
@@ -1691,12 +1808,24 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 						pass,
 						face,
 						{1.0, 1.0, 0.0, 0.4},
-						mvp,
+						mvp * v.mat4_to_f32(ftree.feature_model_matrix(feature)),
 					)
 				}
 			}
 		}
 
+		// Render hovered/selected edge or vertex (Solid Mode)
+		if app.mode == .Solid {
+			render_pick_highlight_gpu(app, cmd, pass, app.selected_pick, {1.0, 0.6, 0.0, 1}, mvp)
+			render_pick_highlight_gpu(app, cmd, pass, app.hovered_pick, {1.0, 1.0, 0.0, 1}, mvp)
+		}
+
+		// Draw all queued sketch points, handles and pick markers in one instanced call
+		// (after solids so they stay visible on top of shaded geometry)
+		v.viewer_gpu_flush_point_sprites(app.viewer, cmd, pass, mvp, w, h)
+
+		v.frame_profiler_pass(profiler, .Text)
+
 		// Render text overlay
 		v.text_render_2d_gpu(
 			&app.text_renderer,
@@ -1772,6 +1901,8 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 			}
 		}
 
+		v.frame_profiler_pass(profiler, .UIPanels)
+
 		// ========== Real CAD UI ==========
 		// Begin UI frame
 		ui.ui_begin_frame(
@@ -2180,46 +2311,48 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 
 		// Create primitive with default parameters
 		// TODO: In the future, show parameter dialog to let user customize dimensions
-		result: primitives.PrimitiveResult
+		params: primitives.PrimitiveParams
 
 		switch prim_id {
 		case 5:  // Box
 			fmt.println("📦 Creating Box primitive (20x30x40mm)")
-			result = primitives.create_primitive(primitives.BoxParams{
+			params = primitives.BoxParams{
 				width = 20.0,
 				height = 30.0,
 				depth = 40.0,
-			})
+			}
 
 		case 6:  // Cylinder
 			fmt.println("🛢️  Creating Cylinder primitive (r=10mm, h=50mm)")
-			result = primitives.create_primitive(primitives.CylinderParams{
+			params = primitives.CylinderParams{
 				radius = 10.0,
 				height = 50.0,
-			})
+			}
 
 		case 7:  // Sphere
 			fmt.println("⚪ Creating Sphere primitive (r=15mm)")
-			result = primitives.create_primitive(primitives.SphereParams{
+			params = primitives.SphereParams{
 				radius = 15.0,
-			})
+			}
 
 		case 8:  // Cone
 			fmt.println("🔺 Creating Cone primitive (r1=10mm, r2=5mm, h=30mm)")
-			result = primitives.create_primitive(primitives.ConeParams{
+			params = primitives.ConeParams{
 				bottom_radius = 10.0,
 				top_radius = 5.0,
 				height = 30.0,
-			})
+			}
 
 		case 9:  // Torus
 			fmt.println("🍩 Creating Torus primitive (major=20mm, minor=5mm)")
-			result = primitives.create_primitive(primitives.TorusParams{
+			params = primitives.TorusParams{
 				major_radius = 20.0,
 				minor_radius = 5.0,
-			})
+			}
 		}
 
+		result := primitives.create_primitive(params)
+
 		// Add primitive to feature tree if successful
 		if result.success {
 			// Create feature name
@@ -2245,14 +2378,16 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 				},
 				status = ftree.FeatureStatus.Valid,
 				parent_features = make([dynamic]int),
-				occt_shape = result.occt_shape,  // Store OCCT shape for boolean operations
-				result_solid = result.solid,      // Store tessellated mesh for rendering
+				result_solid = result.solid,      // Analytic mesh (exact shape is built when a cut needs it)
+				primitive = params,
+				primitive_instance = result.instance,
 				enabled = true,
 				visible = true,
 			}
 
 			app.feature_tree.next_id += 1
 			append(&app.feature_tree.features, feature)
+			app.feature_tree.revision += 1
 			app.feature_tree.active_feature_id = feature.id
 
 			// Update wireframe
@@ -2333,7 +2468,7 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 		// If properties changed (e.g., extrude depth), regenerate and update solids
 		if needs_update {
 			// Regenerate all features to update geometry
-			ftree.feature_tree_regenerate_all(&app.feature_tree)
+			regenerate_all_timed_gpu(app)
 			// Update wireframe display
 			update_solid_wireframes_gpu(app)
 		}
@@ -2341,16 +2476,26 @@ render_frame_gpu :: proc(app: ^AppStateGPU) {
 		// End UI frame
 		ui.ui_end_frame(&app.ui_context)
 
+		v.frame_profiler_pass(profiler, .Submit)
+
+		// Frame-time HUD on top of everything (F3)
+		v.viewer_gpu_render_frame_hud(app.viewer, &app.text_renderer, cmd, pass, w, h)
+
 		sdl.EndGPURenderPass(pass)
 	}
 
-	// Submit command buffer
-	_ = sdl.SubmitGPUCommandBuffer(cmd)
+	// Submit command buffer (waits for the GPU while the frame-time HUD is measuring)
+	v.frame_profiler_submit(profiler, app.viewer.gpu_device, cmd)
+
+	// Queue this frame's visibility download and apply finished ones
+	v.occlusion_end_frame(app.viewer)
 
 	// Update font atlas texture AFTER frame rendering
 	// This uploads any new glyphs that were added during this frame
 	// They will be available for the NEXT frame (one-frame delay is acceptable)
 	v.text_renderer_gpu_update_texture(&app.text_renderer)
+
+	v.frame_profiler_end_frame(profiler)
 }
 
 // Test extrude feature
@@ -2419,7 +2564,7 @@ test_extrude_gpu :: proc(app: ^AppStateGPU) {
 	app.extrude_feature_id = extrude_id
 	app.cad_ui_state.temp_extrude_depth = 1.0 // Initialize UI state
 
-	if !ftree.feature_regenerate(&app.feature_tree, extrude_id) {
+	if !regenerate_feature_timed_gpu(app, extrude_id) {
 		fmt.println("❌ Failed to regenerate extrude")
 		return
 	}
@@ -2523,7 +2668,7 @@ test_cut_gpu :: proc(app: ^AppStateGPU) {
 
 	app.cut_feature_id = cut_id
 
-	if !ftree.feature_regenerate(&app.feature_tree, cut_id) {
+	if !regenerate_feature_timed_gpu(app, cut_id) {
 		fmt.println("❌ Failed to regenerate cut")
 		return
 	}
@@ -2594,7 +2739,7 @@ test_revolve_gpu :: proc(app: ^AppStateGPU) {
 		return
 	}
 
-	if !ftree.feature_regenerate(&app.feature_tree, revolve_id) {
+	if !regenerate_feature_timed_gpu(app, revolve_id) {
 		fmt.println("❌ Failed to regenerate revolve")
 		return
 	}
@@ -2605,29 +2750,28 @@ test_revolve_gpu :: proc(app: ^AppStateGPU) {
 	fmt.println("\n✅ Revolve added!")
 }
 
+// Triangle cap for simplified (simulation) STL exports - meshes above it are decimated
+SIMULATION_STL_TRIANGLE_BUDGET :: 100_000
+
 // Export all solids to STL file
-export_to_stl_gpu :: proc(app: ^AppStateGPU) {
+export_to_stl_gpu :: proc(app: ^AppStateGPU, rep_context: ftree.RepresentationContext = .Export) {
 	fmt.println("\n=== Exporting to STL ===")
 
-	// Collect all visible solids from feature tree
+	// Collect all visible solids from feature tree (world-space references, released below)
 	solids := make([dynamic]^extrude.SimpleSolid)
-	defer delete(solids)
-
-	// Build a set of feature IDs that are consumed by other features
-	consumed_features := make(map[int]bool)
-	defer delete(consumed_features)
-
-	// Mark features that are used as base solids for Cut operations
-	for feature in app.feature_tree.features {
-		if feature.type == .Cut {
-			if params, ok := feature.params.(ftree.CutParams); ok {
-				consumed_features[params.base_feature_id] = true
-			}
+	defer {
+		for &solid in solids {
+			extrude.simple_solid_release(&solid)
 		}
+		delete(solids)
 	}
 
+	// Build a set of feature IDs that are consumed by other features (cut bases, moved bodies)
+	consumed_features := ftree.feature_tree_consumed_features(&app.feature_tree)
+	defer delete(consumed_features)
+
 	// Export only the final solids (not consumed by other operations)
-	for feature in app.feature_tree.features {
+	for &feature in app.feature_tree.features {
 		if !feature.visible || !feature.enabled {
 			continue
 		}
@@ -2637,8 +2781,9 @@ export_to_stl_gpu :: proc(app: ^AppStateGPU) {
 			continue
 		}
 
-		if feature.result_solid != nil {
-			append(&solids, feature.result_solid)
+		// Exact geometry for .Export, defeatured (when available) for .Simulation
+		if solid := ftree.feature_world_solid(&feature, rep_context); solid != nil {
+			append(&solids, solid)
 		}
 	}
 
@@ -2651,12 +2796,13 @@ export_to_stl_gpu :: proc(app: ^AppStateGPU) {
 	// Generate filename with timestamp for uniqueness
 	// Format: export_YYYYMMDD_HHMMSS.stl
 	// For now, use simple counter or just "export.stl"
-	filepath := "export.stl"
+	filepath := rep_context == .Simulation ? "export_simplified.stl" : "export.stl"
 
 	fmt.printf("📦 Exporting %d solid(s) to STL...\n", len(solids))
 
-	// Export to STL
-	result := stl.export_feature_tree_to_stl(solids[:], filepath)
+	// Export to STL (simulation exports are also capped to a triangle budget)
+	triangle_budget := rep_context == .Simulation ? SIMULATION_STL_TRIANGLE_BUDGET : 0
+	result := stl.export_feature_tree_to_stl(solids[:], filepath, triangle_budget)
 
 	if !result.success {
 		fmt.println("❌", result.message)
@@ -2671,119 +2817,418 @@ export_to_stl_gpu :: proc(app: ^AppStateGPU) {
 	}
 }
 
-// Update solid wireframes from feature tree
-update_solid_wireframes_gpu :: proc(app: ^AppStateGPU) {
-	for &mesh in app.solid_wireframes {
-		v.wireframe_mesh_gpu_destroy(&mesh)
+// Toggle the defeatured (simplified) representation on the active feature
+toggle_simplified_rep_gpu :: proc(app: ^AppStateGPU) {
+	feature := ftree.feature_tree_get_active(&app.feature_tree)
+	if feature == nil || feature.result_solid == nil {
+		fmt.println("❌ No active solid feature to simplify")
+		return
 	}
-	clear(&app.solid_wireframes)
 
-	// Build a set of feature IDs that are consumed by other features
-	consumed_features := make(map[int]bool)
-	defer delete(consumed_features)
+	enable := !feature.simplified.enabled
+	ok := ftree.feature_tree_set_simplified_rep(&app.feature_tree, feature.id, enable)
+	v.gpu_mesh_cache_invalidate(&app.viewer.mesh_cache, app.viewer.gpu_device, feature.id)
 
-	// Mark features that are used as base solids for Cut operations
-	for feature in app.feature_tree.features {
-		if feature.type == .Cut {
-			if params, ok := feature.params.(ftree.CutParams); ok {
-				consumed_features[params.base_feature_id] = true
-			}
-		}
+	if !enable {
+		app.status_message = fmt.tprintf("Simplified rep OFF for '%s'", feature.name)
+	} else if ok {
+		app.status_message = fmt.tprintf(
+			"Simplified rep ON for '%s' (%d faces removed)",
+			feature.name,
+			feature.simplified.faces_removed,
+		)
+	} else {
+		app.status_message = fmt.tprintf("Simplification failed for '%s'", feature.name)
 	}
+	app.needs_redraw = true
+}
 
-	// Render only the final solids (not consumed by other operations)
-	for feature in app.feature_tree.features {
-		if !feature.visible || !feature.enabled {
-			continue
-		}
-
-		// Skip features that are consumed by other operations
-		if consumed_features[feature.id] {
-			continue
-		}
+// Arrow-key step for moved/copied bodies (model units)
+BODY_NUDGE_STEP :: 1.0
 
-		if feature.result_solid != nil {
-			mesh := v.solid_to_wireframe_gpu(feature.result_solid)
-			append(&app.solid_wireframes, mesh)
-		}
+// Add a move ([M]) or copy-body ([Shift+M]) feature for the active body
+// A copy starts one body width (+10%) along X so it does not overlap the original.
+add_placed_body_gpu :: proc(app: ^AppStateGPU, copy_body: bool) {
+	feature := ftree.feature_tree_get_active(&app.feature_tree)
+	if feature == nil || feature.result_solid == nil {
+		fmt.println("❌ No active solid feature to move or copy")
+		return
 	}
 
-	fmt.printf("Updated %d solid wireframes\n", len(app.solid_wireframes))
-}
+	offset: m.Vec3
+	if copy_body {
+		bbox := cut.compute_bounding_box(feature.result_solid)
+		offset.x = (bbox.max.x - bbox.min.x) * 1.1
+	}
 
-// Change extrude depth
-change_extrude_depth_gpu :: proc(app: ^AppStateGPU, delta: f64) {
-	if app.extrude_feature_id < 0 {
-		fmt.println("❌ No extrude feature")
+	id: int
+	if copy_body {
+		name := fmt.aprintf("Copy%03d", ftree.feature_tree_count_type(&app.feature_tree, .CopyBody) + 1)
+		id = ftree.feature_tree_add_copy_body(&app.feature_tree, feature.id, offset, name)
+	} else {
+		name := fmt.aprintf("Move%03d", ftree.feature_tree_count_type(&app.feature_tree, .Move) + 1)
+		id = ftree.feature_tree_add_move(&app.feature_tree, feature.id, offset, name)
+	}
+	if id < 0 {
 		return
 	}
 
-	feature := ftree.feature_tree_get_feature(&app.feature_tree, app.extrude_feature_id)
-	if feature == nil do return
+	if !regenerate_feature_timed_gpu(app, id) {
+		fmt.println("❌ Failed to place body")
+		return
+	}
 
-	params, ok := feature.params.(ftree.ExtrudeParams)
-	if !ok do return
+	update_solid_wireframes_gpu(app)
+	app.status_message = fmt.tprintf("%s '%s' - arrow keys nudge it", copy_body ? "Copied" : "Moving", feature.name)
+	app.needs_redraw = true
+}
 
-	new_depth := params.depth + delta
-	if new_depth < 0.1 {
-		new_depth = 0.1
+// Nudge the active moved/copied body
+// Only placements regenerate (no OCCT geometry or re-meshing) and the source body's cached GPU
+// mesh stays resident - the shaded draw just gets a new model matrix.
+nudge_placed_body_gpu :: proc(app: ^AppStateGPU, offset: m.Vec3) {
+	feature := ftree.feature_tree_get_active(&app.feature_tree)
+	if feature == nil {
+		return
 	}
 
-	params.depth = new_depth
-	feature.params = params
-
-	fmt.printf("🔄 Extrude depth: %.2f\n", new_depth)
+	params, ok := feature.params.(ftree.TransformParams)
+	if !ok {
+		fmt.println("❌ Active feature is not a moved or copied body (create one with [M] / [Shift+M])")
+		return
+	}
 
-	ftree.feature_tree_mark_dirty(&app.feature_tree, app.extrude_feature_id)
+	ftree.change_body_translation(&app.feature_tree, feature.id, params.translation + offset)
 
-	if ftree.feature_regenerate(&app.feature_tree, app.extrude_feature_id) {
-		update_solid_wireframes_gpu(app)
-		fmt.printf("✅ Depth updated: %.2f\n", new_depth)
+	// Regenerate the placement and anything built on it, in tree order
+	regenerated := make([dynamic]int, context.temp_allocator)
+	for &dirty in app.feature_tree.features {
+		if dirty.status != .NeedsUpdate do continue
+		regenerate_feature_timed_gpu(app, dirty.id)
+		append(&regenerated, dirty.id)
 	}
-}
+	invalidate_regenerated_meshes_gpu(app)
 
-// Change active feature parameters (smart: extrude/revolve)
-change_active_feature_parameter :: proc(app: ^AppStateGPU, delta: f64) {
-	// Get the last feature in the tree (most recent operation)
-	if len(app.feature_tree.features) == 0 {
-		fmt.println("❌ No features to modify")
-		return
+	// Only the regenerated features' wireframes and pick entries change; the rest of the
+	// scene keeps its buffers and BVHs
+	consumed_features := ftree.feature_tree_consumed_features(&app.feature_tree, context.temp_allocator)
+	for id in regenerated {
+		if !update_feature_wireframe_gpu(app, id, consumed_features[id]) {
+			update_solid_wireframes_gpu(app)
+			break
+		}
 	}
+	app.needs_redraw = true
+}
 
-	// Find the most recent extrude or revolve feature
-	last_feature_id := -1
-	for i := len(app.feature_tree.features) - 1; i >= 0; i -= 1 {
-		feature := app.feature_tree.features[i]
-		if feature.type == .Extrude || feature.type == .Revolve {
-			last_feature_id = feature.id
+// Refresh one feature's wireframe and pick entry after it regenerated
+// A placement-only change just swaps the model matrix. Returns false if the set of drawn
+// solids changed (the feature gained or lost its solid), which needs a full rebuild.
+update_feature_wireframe_gpu :: proc(app: ^AppStateGPU, feature_id: int, consumed: bool) -> bool {
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, feature_id)
+	drawn := feature != nil && feature.visible && feature.enabled && !consumed && feature.result_solid != nil
+
+	wireframe: ^SolidWireframeGPU
+	for &entry in app.solid_wireframes {
+		if entry.feature_id == feature_id {
+			wireframe = &entry
 			break
 		}
 	}
-
-	if last_feature_id < 0 {
-		fmt.println("❌ No extrude or revolve feature to modify")
-		return
+	if wireframe == nil || !drawn {
+		return wireframe == nil && !drawn
 	}
 
-	feature := ftree.feature_tree_get_feature(&app.feature_tree, last_feature_id)
-	if feature == nil do return
+	// A placed body shares its (unchanged) source mesh; anything else was rebuilt
+	geometry_changed := !feature.placement.placed || wireframe.solid != feature.result_solid
+	if geometry_changed {
+		v.wireframe_mesh_gpu_destroy(&wireframe.mesh)
+		wireframe.mesh = v.solid_to_wireframe_gpu(feature.result_solid)
+		wireframe.solid = feature.result_solid
 
-	#partial switch feature.type {
-	case .Extrude:
-		params, ok := &feature.params.(ftree.ExtrudeParams)
-		if !ok do return
+		// Stale picks would reference freed edges
+		if app.hovered_pick.feature_id == feature_id do app.hovered_pick = {}
+		if app.selected_pick.feature_id == feature_id do app.selected_pick = {}
+	}
+	wireframe.transform = v.mat4_to_f32(ftree.feature_model_matrix(feature))
 
-		new_depth := params.depth + delta
-		if new_depth < 0.1 {
-			new_depth = 0.1
-		}
+	return v.solid_picker_update_solid(&app.solid_picker, feature_pick_solid(feature), geometry_changed)
+}
 
-		params.depth = new_depth
-		fmt.printf("🔄 Extrude depth: %.2f\n", new_depth)
+// Pickable solid of a feature (placed bodies are picked in mesh space)
+feature_pick_solid :: proc(feature: ^ftree.FeatureNode) -> v.PickSolid {
+	return v.PickSolid{
+		feature_id = feature.id,
+		solid      = feature.result_solid,
+		placed     = feature.placement.placed,
+		transform  = feature.placement.transform,
+	}
+}
+
+// GPU mesh cache key for the solid drawn for a feature (exact mesh or simplified LOD)
+solid_mesh_key :: proc(feature: ^ftree.FeatureNode, solid: ^extrude.SimpleSolid) -> v.GPUMeshKey {
+	return v.GPUMeshKey{owner_id = feature.id, lod = solid == feature.result_solid ? 0 : 1}
+}
+
+// Shared primitive templates are cached under negative owner IDs (feature IDs are >= 0)
+primitive_template_mesh_key :: proc(template: ^primitives.PrimitiveTemplate) -> v.GPUMeshKey {
+	return v.GPUMeshKey{owner_id = -1 - template.id, lod = 0}
+}
+
+// Shaded bodies of the visible features (same filters in every shaded render mode)
+// Small parts use their defeatured rep; colors are the dark gray Fusion 360 style material.
+collect_shaded_bodies :: proc(app: ^AppStateGPU) -> [dynamic]v.OcclusionItem {
+	items := make([dynamic]v.OcclusionItem, 0, len(app.feature_tree.features))
+	pixel_size_world := f64(v.get_pixel_size_world(app.viewer))
+
+	// Only final bodies, like the wireframes and export (a moved body is not also drawn where it was)
+	consumed_features := ftree.feature_tree_consumed_features(&app.feature_tree, context.temp_allocator)
+
+	for &feature in app.feature_tree.features {
+		if !feature.visible || !feature.enabled do continue
+		if feature.result_solid == nil do continue
+		if consumed_features[feature.id] do continue
+
+		solid := ftree.feature_get_solid(&feature, .Display, pixel_size_world)
+		append(&items, feature_shaded_item(&feature, solid, {0.45, 0.45, 0.45, 1.0}))
+	}
+	return items
+}
+
+// Queue the shaded bodies: with occlusion culling only the ones the Hi-Z test revealed
+// (the rest were drawn before the pyramid was built), otherwise all of them
+queue_shaded_bodies_gpu :: proc(app: ^AppStateGPU, items: []v.OcclusionItem, occluded: bool, mvp: matrix[4,4]f32) {
+	if occluded {
+		v.occlusion_draw(app.viewer, items, .Revealed, mvp)
+		return
+	}
+
+	for item in items {
+		v.render_queue_submit_cached_mesh(app.viewer, item.key, item.solid, item.color, mvp * item.transform, item.normal_matrix)
+	}
+}
+
+// Shaded draw of a feature's solid; analytic primitives draw their shared unit template
+// scaled by the instance, so identical primitive shapes upload one mesh. Moved and copied
+// bodies share their source's mesh (and its GPU buffer) and draw it through the placement.
+feature_shaded_item :: proc(
+	feature: ^ftree.FeatureNode,
+	solid: ^extrude.SimpleSolid,
+	color: [4]f32,
+) -> v.OcclusionItem {
+	identity := matrix[4,4]f32{
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1,
+	}
+
+	exact := solid == feature.result_solid
+	key := solid_mesh_key(feature, solid)
+
+	// A rigid placement without its translation is its own inverse transpose
+	// (the simplified rep of a placed body is kept in mesh space too)
+	placement := identity
+	rotation := identity
+	if feature.placement.placed {
+		placement = v.mat4_to_f32(feature.placement.transform)
+		rotation = placement
+		rotation[0, 3], rotation[1, 3], rotation[2, 3] = 0, 0, 0
+
+		if exact {
+			key = v.GPUMeshKey{owner_id = feature.placement.source_id, lod = 0}
+		}
+	}
+
+	instance := feature.primitive_instance
+	if instance.template == nil || !exact {
+		return v.OcclusionItem{
+			owner_id      = feature.id,
+			key           = key,
+			solid         = solid,
+			transform     = placement,
+			normal_matrix = rotation,
+			color         = color,
+		}
+	}
+
+	s := [3]f32{f32(instance.scale.x), f32(instance.scale.y), f32(instance.scale.z)}
+	model := matrix[4,4]f32{
+		s.x, 0, 0, 0,
+		0, s.y, 0, 0,
+		0, 0, s.z, 0,
+		0, 0, 0, 1,
+	}
+	// Inverse transpose of the scale keeps normals correct for non-uniform scales
+	normal_matrix := matrix[4,4]f32{
+		1 / s.x, 0, 0, 0,
+		0, 1 / s.y, 0, 0,
+		0, 0, 1 / s.z, 0,
+		0, 0, 0, 1,
+	}
+
+	return v.OcclusionItem{
+		owner_id      = feature.id,
+		key           = primitive_template_mesh_key(instance.template),
+		solid         = instance.template.mesh,
+		transform     = placement * model,
+		normal_matrix = rotation * normal_matrix,
+		color         = color,
+	}
+}
+
+// Update solid wireframes from feature tree
+update_solid_wireframes_gpu :: proc(app: ^AppStateGPU) {
+	for &wireframe in app.solid_wireframes {
+		v.wireframe_mesh_gpu_destroy(&wireframe.mesh)
+	}
+	clear(&app.solid_wireframes)
+
+	// Regenerated solids may have been reallocated - drop only their cached shaded meshes
+	invalidate_regenerated_meshes_gpu(app)
+
+	// Build a set of feature IDs that are consumed by other features (cut bases, moved bodies)
+	consumed_features := ftree.feature_tree_consumed_features(&app.feature_tree)
+	defer delete(consumed_features)
+
+	pick_solids := make([dynamic]v.PickSolid)
+	defer delete(pick_solids)
+
+	// Render only the final solids (not consumed by other operations)
+	for &feature in app.feature_tree.features {
+		if !feature.visible || !feature.enabled {
+			continue
+		}
+
+		// Skip features that are consumed by other operations
+		if consumed_features[feature.id] {
+			continue
+		}
+
+		if feature.result_solid != nil {
+			append(&app.solid_wireframes, SolidWireframeGPU{
+				feature_id = feature.id,
+				solid      = feature.result_solid,
+				mesh       = v.solid_to_wireframe_gpu(feature.result_solid),
+				transform  = v.mat4_to_f32(ftree.feature_model_matrix(&feature)),
+			})
+			append(&pick_solids, feature_pick_solid(&feature))
+		}
+	}
+
+	// Same solids are pickable; stale picks would reference freed edges
+	v.solid_picker_set_solids(&app.solid_picker, pick_solids[:])
+	app.hovered_pick = {}
+	app.selected_pick = {}
+
+	fmt.printf("Updated %d solid wireframes\n", len(app.solid_wireframes))
+}
+
+// Drop cached GPU meshes of features regenerated or removed since their meshes were built
+// Unchanged features keep their resident buffers; primitive templates (negative ids) are never touched.
+invalidate_regenerated_meshes_gpu :: proc(app: ^AppStateGPU) {
+	cache := &app.viewer.mesh_cache
+	device := app.viewer.gpu_device
+
+	present := make(map[int]bool, len(app.feature_tree.features), context.temp_allocator)
+	for feature in app.feature_tree.features {
+		present[feature.id] = true
+
+		revision, found := app.mesh_revisions[feature.id]
+		if found && revision == feature.revision {
+			continue
+		}
+
+		v.gpu_mesh_cache_invalidate(cache, device, feature.id)
+		app.mesh_revisions[feature.id] = feature.revision
+	}
+
+	removed := make([dynamic]int, 0, 4, context.temp_allocator)
+	for id in app.mesh_revisions {
+		if !present[id] {
+			append(&removed, id)
+		}
+	}
+
+	for id in removed {
+		v.gpu_mesh_cache_invalidate(cache, device, id)
+		delete_key(&app.mesh_revisions, id)
+	}
+}
+
+// Change extrude depth
+change_extrude_depth_gpu :: proc(app: ^AppStateGPU, delta: f64) {
+	if app.extrude_feature_id < 0 {
+		fmt.println("❌ No extrude feature")
+		return
+	}
+
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, app.extrude_feature_id)
+	if feature == nil do return
+
+	params, ok := feature.params.(ftree.ExtrudeParams)
+	if !ok do return
+
+	new_depth := params.depth + delta
+	if new_depth < 0.1 {
+		new_depth = 0.1
+	}
+
+	params.depth = new_depth
+	feature.params = params
+
+	fmt.printf("🔄 Extrude depth: %.2f\n", new_depth)
+
+	ftree.feature_tree_mark_dirty(&app.feature_tree, app.extrude_feature_id)
+
+	if regenerate_feature_timed_gpu(app, app.extrude_feature_id) {
+		update_solid_wireframes_gpu(app)
+		fmt.printf("✅ Depth updated: %.2f\n", new_depth)
+	}
+}
+
+// Change active feature parameters (smart: extrude/revolve)
+change_active_feature_parameter :: proc(app: ^AppStateGPU, delta: f64) {
+	// Get the last feature in the tree (most recent operation)
+	if len(app.feature_tree.features) == 0 {
+		fmt.println("❌ No features to modify")
+		return
+	}
+
+	// Find the most recent extrude or revolve feature
+	last_feature_id := -1
+	for i := len(app.feature_tree.features) - 1; i >= 0; i -= 1 {
+		feature := app.feature_tree.features[i]
+		if feature.type == .Extrude || feature.type == .Revolve {
+			last_feature_id = feature.id
+			break
+		}
+	}
+
+	if last_feature_id < 0 {
+		fmt.println("❌ No extrude or revolve feature to modify")
+		return
+	}
+
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, last_feature_id)
+	if feature == nil do return
+
+	#partial switch feature.type {
+	case .Extrude:
+		params, ok := &feature.params.(ftree.ExtrudeParams)
+		if !ok do return
+
+		new_depth := params.depth + delta
+		if new_depth < 0.1 {
+			new_depth = 0.1
+		}
+
+		params.depth = new_depth
+		fmt.printf("🔄 Extrude depth: %.2f\n", new_depth)
 
 		ftree.feature_tree_mark_dirty(&app.feature_tree, last_feature_id)
 
-		if ftree.feature_regenerate(&app.feature_tree, last_feature_id) {
+		if regenerate_feature_timed_gpu(app, last_feature_id) {
 			update_solid_wireframes_gpu(app)
 			fmt.printf("✅ Depth updated: %.2f\n", new_depth)
 		}
@@ -2809,7 +3254,7 @@ change_active_feature_parameter :: proc(app: ^AppStateGPU, delta: f64) {
 
 		ftree.feature_tree_mark_dirty(&app.feature_tree, last_feature_id)
 
-		if ftree.feature_regenerate(&app.feature_tree, last_feature_id) {
+		if regenerate_feature_timed_gpu(app, last_feature_id) {
 			update_solid_wireframes_gpu(app)
 			fmt.printf("✅ Angle updated: %.1f°\n", new_angle)
 		}
@@ -2975,7 +3420,7 @@ exit_sketch_edit_mode :: proc(app: ^AppStateGPU) {
 	fmt.println("🔄 Marked feature tree as dirty - regenerating...")
 
 	// Regenerate all features (this will rebuild the solid geometry)
-	ftree.feature_tree_regenerate_all(&app.feature_tree)
+	regenerate_all_timed_gpu(app)
 
 	// Update visualization
 	update_solid_wireframes_gpu(app)
@@ -3076,21 +3521,43 @@ create_sketch_on_face :: proc(app: ^AppStateGPU) -> int {
 		return -1
 	}
 
-	// Get the face
-	solid := feature.result_solid
-	if selected_face.face_index < 0 || selected_face.face_index >= len(solid.faces) {
-		fmt.println("❌ Invalid face index")
-		return -1
-	}
+	// Extract plane from face
+	// Use face center as origin and face normal as Z-axis
+	plane_origin, plane_normal: m.Vec3
+	face_name: string
+
+	if selected_face.exact {
+		// Exact B-Rep face: plane straight from the cached face table
+		faces := occt.face_infos(ftree.feature_face_table(feature))
+		if selected_face.face_index < 0 || selected_face.face_index >= len(faces) {
+			fmt.println("❌ Invalid face index")
+			return -1
+		}
 
-	face := &solid.faces[selected_face.face_index]
+		info := &faces[selected_face.face_index]
+		face_name = fmt.tprintf("Face%d", selected_face.face_index)
+		if .Plane not_in info.surface {
+			fmt.printf("❌ Face '%s' is not planar (%v) - select a planar face\n", face_name, info.surface)
+			return -1
+		}
 
-	fmt.printf("📐 Creating sketch on face: '%s'\n", face.name)
+		plane_origin = info.origin
+		plane_normal = info.direction
+	} else {
+		// Mesh-only feature: fall back to the face metadata of the solid
+		solid := feature.result_solid
+		if selected_face.face_index < 0 || selected_face.face_index >= len(solid.faces) {
+			fmt.println("❌ Invalid face index")
+			return -1
+		}
 
-	// Extract plane from face
-	// Use face center as origin and face normal as Z-axis
-	plane_origin := face.center
-	plane_normal := face.normal
+		face := &solid.faces[selected_face.face_index]
+		face_name = face.name
+		plane_origin = ftree.feature_point_to_world(feature, face.center)
+		plane_normal = ftree.feature_direction_to_world(feature, face.normal)
+	}
+
+	fmt.printf("📐 Creating sketch on face: '%s'\n", face_name)
 
 	// Calculate U and V axes for the sketch plane
 	// Choose U axis: prefer world X axis if not parallel to normal
@@ -3155,7 +3622,7 @@ create_sketch_on_face :: proc(app: ^AppStateGPU) -> int {
 	fmt.printf(
 		"✅ Created %s on face '%s' (ID: %d) - Now in SKETCH MODE\n",
 		sketch_name,
-		face.name,
+		face_name,
 		sketch_id,
 	)
 	fmt.println("   Plane origin:", plane_origin)
@@ -3206,9 +3673,24 @@ point_in_face_polygon :: proc(point: m.Vec3, face: ^extrude.SimpleFace) -> bool
 		return false
 	}
 
+	polygon := make([]m.Vec3, len(face.vertices))
+	defer delete(polygon)
+	for vertex, i in face.vertices {
+		polygon[i] = vertex.position
+	}
+
+	return point_in_planar_polygon(point, face.normal, polygon)
+}
+
+// Point-in-polygon test for a planar 3D polygon with the given normal
+point_in_planar_polygon :: proc(point: m.Vec3, normal: m.Vec3, polygon_3d: []m.Vec3) -> bool {
+	if len(polygon_3d) < 3 {
+		return false
+	}
+
 	// Project point and vertices onto 2D plane using face normal
 	// Use cross products to determine the major axis to drop
-	abs_normal := m.Vec3{glsl.abs(face.normal.x), glsl.abs(face.normal.y), glsl.abs(face.normal.z)}
+	abs_normal := m.Vec3{glsl.abs(normal.x), glsl.abs(normal.y), glsl.abs(normal.z)}
 
 	// Choose projection plane (drop axis with largest normal component)
 	project_to_2d :: proc(p: m.Vec3, drop_axis: int) -> m.Vec2 {
@@ -3237,23 +3719,105 @@ point_in_face_polygon :: proc(point: m.Vec3, face: ^extrude.SimpleFace) -> bool
 	// Project point to 2D
 	point_2d := project_to_2d(point, drop_axis)
 
-	// Ray casting algorithm for point-in-polygon
-	inside := false
-	n := len(face.vertices)
+	// Exact point-in-polygon (edge and vertex hits count as inside)
+	polygon := make([]m.Vec2, len(polygon_3d))
+	defer delete(polygon)
+	for vertex, i in polygon_3d {
+		polygon[i] = project_to_2d(vertex, drop_axis)
+	}
 
-	for i in 0 ..< n {
-		j := (i + 1) % n
-		vi := project_to_2d(face.vertices[i].position, drop_axis)
-		vj := project_to_2d(face.vertices[j].position, drop_axis)
+	return m.classify_point_polygon_2d(point_2d, polygon) != .Outside
+}
 
-		// Check if ray crosses edge
-		if ((vi.y > point_2d.y) != (vj.y > point_2d.y)) &&
-		   (point_2d.x < (vj.x - vi.x) * (point_2d.y - vi.y) / (vj.y - vi.y) + vi.x) {
-			inside = !inside
+// Update the hovered edge/vertex under the cursor (Solid Mode)
+update_solid_hover_gpu :: proc(app: ^AppStateGPU) {
+	if app.ui_context.mouse_over_ui {
+		if app.hovered_pick.kind != .None {
+			app.hovered_pick = {}
+			app.needs_redraw = true
 		}
+		return
+	}
+
+	pick := v.solid_picker_pick(&app.solid_picker, app.viewer, f32(app.mouse_x), f32(app.mouse_y))
+	if pick.kind != app.hovered_pick.kind ||
+	   pick.feature_id != app.hovered_pick.feature_id ||
+	   pick.index != app.hovered_pick.index {
+		app.needs_redraw = true
 	}
+	app.hovered_pick = pick
+}
+
+// Log a picked edge/vertex
+print_pick_gpu :: proc(app: ^AppStateGPU, pick: v.PickResult) {
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, pick.feature_id)
+	if feature == nil || feature.result_solid == nil do return
+
+	// The pick may predate a regeneration that changed the solid
+	#partial switch pick.kind {
+	case .Vertex:
+		if pick.index < 0 || pick.index >= len(feature.result_solid.vertices) do return
+		p := ftree.feature_point_to_world(feature, feature.result_solid.vertices[pick.index].position)
+		fmt.printf("✅ Selected vertex %d of feature %d at (%.3f, %.3f, %.3f)\n",
+			pick.index, pick.feature_id, p.x, p.y, p.z)
+	case .Edge:
+		if pick.index < 0 || pick.index >= len(feature.result_solid.edges) do return
+		edge := feature.result_solid.edges[pick.index]
+		fmt.printf("✅ Selected edge %d of feature %d (length %.3f)\n",
+			pick.index, pick.feature_id, glsl.length(edge.v1.position - edge.v0.position))
+	}
+}
+
+// Highlight a picked edge (thick line) or vertex (point sprite)
+render_pick_highlight_gpu :: proc(
+	app: ^AppStateGPU,
+	cmd: ^sdl.GPUCommandBuffer,
+	pass: ^sdl.GPURenderPass,
+	pick: v.PickResult,
+	color: [4]f32,
+	mvp: matrix[4, 4]f32,
+) {
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, pick.feature_id)
+	if feature == nil || feature.result_solid == nil do return
+	solid := feature.result_solid
 
-	return inside
+	#partial switch pick.kind {
+	case .Edge:
+		if pick.index >= len(solid.edges) do return
+		edge := solid.edges[pick.index]
+		p0 := ftree.feature_point_to_world(feature, edge.v0.position)
+		p1 := ftree.feature_point_to_world(feature, edge.v1.position)
+		lines := [1][2][3]f32{{{f32(p0.x), f32(p0.y), f32(p0.z)}, {f32(p1.x), f32(p1.y), f32(p1.z)}}}
+		v.viewer_gpu_render_thick_lines(app.viewer, cmd, pass, lines[:], color, mvp, 4.0)
+
+	case .Vertex:
+		if pick.index >= len(solid.vertices) || !v.point_sprites_enabled(app.viewer) do return
+		p := ftree.feature_point_to_world(feature, solid.vertices[pick.index].position)
+		v.point_sprites_add(app.viewer, {f32(p.x), f32(p.y), f32(p.z)}, color, 6.0, .Ring)
+	}
+}
+
+// Outline the outer loop of a selected exact face (loops may be concave, so no fan fill)
+render_exact_face_outline_gpu :: proc(
+	app: ^AppStateGPU,
+	cmd: ^sdl.GPUCommandBuffer,
+	pass: ^sdl.GPURenderPass,
+	selected: SelectedFace,
+	color: [4]f32,
+	mvp: matrix[4, 4]f32,
+) {
+	feature := ftree.feature_tree_get_feature(&app.feature_tree, selected.feature_id)
+	if feature == nil do return
+
+	loop := occt.face_loop(ftree.feature_face_table(feature), selected.face_index)
+	if len(loop) < 2 do return
+
+	lines := make([][2][3]f32, len(loop), context.temp_allocator)
+	for p, i in loop {
+		q := loop[(i + 1) % len(loop)]
+		lines[i] = {{f32(p.x), f32(p.y), f32(p.z)}, {f32(q.x), f32(q.y), f32(q.z)}}
+	}
+	v.viewer_gpu_render_thick_lines(app.viewer, cmd, pass, lines, color, mvp, 3.0)
 }
 
 // Select face at screen cursor position
@@ -3298,43 +3862,92 @@ select_face_at_cursor :: proc(app: ^AppStateGPU, screen_x, screen_y: f64) -> boo
 	ray_dir := m.Vec3{f64(ray_dir_f32.x), f64(ray_dir_f32.y), f64(ray_dir_f32.z)}
 
 	// Find closest face hit
-	closest_t := max(f64)
 	found_face := false
 	selected := SelectedFace{}
 
-	// Test all features with solids
-	for feature in app.feature_tree.features {
-		if feature.result_solid == nil do continue
-		if !feature.visible || !feature.enabled do continue
+	// Nearest visible surface from the triangle BVH of the pickable solids (visible, not
+	// consumed). Only the body it belongs to is tested, and only faces at that depth, so
+	// faces behind another body - or behind a curved face of the same body - are never picked.
+	mesh_feature_id, mesh_t, mesh_hit := v.solid_picker_ray_nearest(&app.solid_picker, ray_origin, ray_dir)
+	feature := mesh_hit ? ftree.feature_tree_get_feature(&app.feature_tree, mesh_feature_id) : nil
+
+	if feature != nil && feature.result_solid != nil {
+		depth_tolerance := 1e-4 * max(f64(app.viewer.camera.distance), 1.0)
+		closest_t := mesh_t + depth_tolerance
+
+		// Exact B-Rep faces (planes and outer loops precomputed per shape). Lazily built
+		// primitive shapes are not forced here - their analytic face metadata is used instead.
+		table: ^occt.FaceTable
+		if feature.occt_shape != nil {
+			table = ftree.feature_face_table(feature)
+		}
 
-		solid := feature.result_solid
+		if table != nil {
+			for &info, face_idx in occt.face_infos(table) {
+				if .Plane not_in info.surface do continue
 
-		// Test each face in the solid
-		for &face, face_idx in solid.faces {
-			// Ray-plane intersection
-			t, hit := ray_plane_intersection(ray_origin, ray_dir, face.center, face.normal)
-			if !hit || t >= closest_t do continue
+				t, hit := ray_plane_intersection(ray_origin, ray_dir, info.origin, info.direction)
+				if !hit || t >= closest_t do continue
 
-			// Calculate hit point
-			hit_point := ray_origin + ray_dir * t
+				hit_point := ray_origin + ray_dir * t
+				if !point_in_planar_polygon(hit_point, info.direction, occt.face_loop(table, face_idx)) do continue
 
-			// Point-in-polygon test
-			if point_in_face_polygon(hit_point, &face) {
 				closest_t = t
 				found_face = true
 				selected = SelectedFace {
 					feature_id = feature.id,
 					face_index = face_idx,
+					exact      = true,
 				}
 
 				fmt.printf(
-					"🎯 Hit face '%s' (Feature %d, Face %d) at t=%.3f\n",
-					face.name,
-					feature.id,
+					"🎯 Hit face 'Face%d' (Feature %d, exact plane, %.2f mm²) at t=%.3f\n",
 					face_idx,
+					feature.id,
+					info.area,
 					t,
 				)
 			}
+		} else {
+			// Mesh faces are in the solid's mesh space; a rigid placement keeps ray distances
+			local_origin, local_dir := ray_origin, ray_dir
+			if feature.placement.placed {
+				inv := glsl.inverse(feature.placement.transform)
+				local_origin = (inv * m.Vec4{ray_origin.x, ray_origin.y, ray_origin.z, 1}).xyz
+				local_dir = (inv * m.Vec4{ray_dir.x, ray_dir.y, ray_dir.z, 0}).xyz
+			}
+
+			// Test each face in the solid
+			for &face, face_idx in feature.result_solid.faces {
+				// Ray-plane intersection
+				t, hit := ray_plane_intersection(local_origin, local_dir, face.center, face.normal)
+				if !hit || t >= closest_t do continue
+
+				// Calculate hit point
+				hit_point := local_origin + local_dir * t
+
+				// Point-in-polygon test
+				if point_in_face_polygon(hit_point, &face) {
+					closest_t = t
+					found_face = true
+					selected = SelectedFace {
+						feature_id = feature.id,
+						face_index = face_idx,
+					}
+
+					fmt.printf(
+						"🎯 Hit face '%s' (Feature %d, Face %d) at t=%.3f\n",
+						face.name,
+						feature.id,
+						face_idx,
+						t,
+					)
+				}
+			}
+		}
+
+		if !found_face {
+			fmt.printf("⚠️  Surface hit on feature %d is not a planar face\n", feature.id)
 		}
 	}
 
@@ -3509,6 +4122,57 @@ stop_constraint_editing :: proc(app: ^AppStateGPU, commit: bool) {
 	ui.text_input_widget_stop(&app.text_input_widget)
 }
 
+// Timed wrappers - regeneration and solver time show up in the frame-time HUD (F3)
+regenerate_all_timed_gpu :: proc(app: ^AppStateGPU) -> bool {
+	start := time.tick_now()
+	defer v.frame_profiler_add_regen(&app.viewer.profiler, time.tick_since(start))
+	return ftree.feature_tree_regenerate_all(&app.feature_tree)
+}
+
+regenerate_feature_timed_gpu :: proc(app: ^AppStateGPU, feature_id: int) -> bool {
+	start := time.tick_now()
+	defer v.frame_profiler_add_regen(&app.viewer.profiler, time.tick_since(start))
+	return ftree.feature_regenerate(&app.feature_tree, feature_id)
+}
+
+// Apply a finished background solve to the active sketch; true if geometry changed
+poll_async_solve_gpu :: proc(app: ^AppStateGPU) -> bool {
+	solved, applied := sketch.sketch_async_solver_poll(&app.solver, get_active_sketch(app))
+	if !applied {
+		return false
+	}
+
+	result := solved.result
+	v.frame_profiler_add_solve(&app.viewer.profiler, solved.duration)
+
+	#partial switch result.status {
+	case .Success:
+		fmt.printf("✅ Constraints solved in %d iterations (%.1f ms)\n", result.iterations, time.duration_milliseconds(solved.duration))
+		app.status_message = "Constraints solved"
+	case .MaxIterations:
+		fmt.println("⚠️  Solver reached maximum iterations without converging")
+		app.status_message = "Solver did not converge"
+	case .Overconstrained:
+		fmt.println("❌ Sketch has conflicting constraints")
+		app.status_message = "Sketch has conflicting constraints"
+	case:
+		fmt.println("❌ Failed to solve constraints:", result.message)
+		app.status_message = "Failed to solve constraints"
+	}
+
+	app.needs_wireframe_update = true
+	app.needs_selection_update = true
+
+	// Solve queued from the properties panel: features built on the sketch follow it
+	if app.cad_ui_state.solve_regenerates {
+		app.cad_ui_state.solve_regenerates = false
+		regenerate_all_timed_gpu(app)
+		update_solid_wireframes_gpu(app)
+	}
+
+	return true
+}
+
 // Update constraint value and re-solve
 update_constraint_value :: proc(app: ^AppStateGPU, constraint_id: int, new_value: f64) {
 	active_sketch := get_active_sketch(app)
@@ -3645,21 +4309,9 @@ update_constraint_value :: proc(app: ^AppStateGPU, constraint_id: int, new_value
 	if constraint.driving {
 		// Re-solve constraints
 		fmt.println("🔄 Re-solving constraints...")
-		result := sketch.sketch_solve_constraints(active_sketch)
-
-		if result.status == .Success {
-			fmt.println("✅ Constraints solved! Geometry updated.")
-			app.needs_wireframe_update = true
-			app.needs_selection_update = true
-			app.status_message = fmt.tprintf("Updated constraint to %.2f", new_value)
-		} else if result.status == .Underconstrained {
-			fmt.println("⚠️  Sketch is underconstrained")
-			app.needs_wireframe_update = true
-			app.needs_selection_update = true
-		} else {
-			fmt.println("❌ Failed to solve constraints")
-			app.status_message = "Failed to solve constraints"
-		}
+		sketch.sketch_solve_async(&app.solver, active_sketch)
+		app.needs_wireframe_update = true  // Dimension text updates now, geometry when the solve lands
+		app.status_message = fmt.tprintf("Updated constraint to %.2f", new_value)
 	} else {
 		// Non-driving constraint (reference dimension) - just update the value
 		fmt.println("📏 Updated reference dimension (non-driving)")
@@ -3684,12 +4336,83 @@ parse_f64 :: proc(s: string) -> (f64, bool) {
 }
 
 // Render closed profile fills with transparency
+// Stencil-then-cover: every closed outline goes into one even-odd fill, so concave profiles
+// fill correctly and nested profiles show as holes. Outlines are only rebuilt and uploaded
+// when the sketch geometry changes.
 render_profile_fills_gpu :: proc(
 	app: ^AppStateGPU,
 	cmd: ^sdl.GPUCommandBuffer,
 	pass: ^sdl.GPURenderPass,
 	sk: ^sketch.Sketch2D,
 	mvp: matrix[4, 4]f32,
+) {
+	if !v.profile_fill_enabled(app.viewer) {
+		render_profile_fills_fan_gpu(app, cmd, pass, sk, mvp)
+		return
+	}
+
+	revision := sketch.sketch_geometry_fingerprint(sk)
+	if !v.profile_fill_is_current(app.viewer, revision) {
+		v.profile_fill_upload(app.viewer, sk, closed_profile_outlines(sk), revision)
+	}
+
+	v.viewer_gpu_render_profile_fill(app.viewer, cmd, pass, mvp, {0.0, 1.0, 1.0, 0.2}, .EvenOdd) // Dark cyan, 20% opacity
+}
+
+// Outlines of all closed profiles in sketch coordinates (temp-allocated); circles are flattened
+closed_profile_outlines :: proc(sk: ^sketch.Sketch2D) -> [][]m.Vec2 {
+	profiles := sketch.sketch_detect_profiles(sk)
+	defer {
+		for &profile in profiles {
+			sketch.profile_destroy(&profile)
+		}
+		delete(profiles)
+	}
+
+	outlines := make([dynamic][]m.Vec2, 0, len(profiles), context.temp_allocator)
+	for profile in profiles {
+		if profile.type != .Closed {
+			continue
+		}
+
+		outline := make([dynamic]m.Vec2, 0, max(len(profile.points), 64), context.temp_allocator)
+		circle: sketch.SketchCircle
+		is_circle := false
+		if len(profile.entities) == 1 {
+			circle, is_circle = sk.entities[profile.entities[0]].(sketch.SketchCircle)
+		}
+
+		if is_circle {
+			center_pt := sketch.sketch_get_point(sk, circle.center_id)
+			if center_pt == nil do continue
+
+			segments := 64
+			for i in 0 ..< segments {
+				angle := f64(i) * (2.0 * math.PI) / f64(segments)
+				append(&outline, m.Vec2{
+					center_pt.x + circle.radius * math.cos(angle),
+					center_pt.y + circle.radius * math.sin(angle),
+				})
+			}
+		} else {
+			sketch.sketch_profile_outline(sk, profile, &outline)
+		}
+
+		if len(outline) >= 3 {
+			append(&outlines, outline[:])
+		}
+	}
+
+	return outlines[:]
+}
+
+// Fallback fill without a stencil buffer: one CPU triangle fan per profile (convex profiles only)
+render_profile_fills_fan_gpu :: proc(
+	app: ^AppStateGPU,
+	cmd: ^sdl.GPUCommandBuffer,
+	pass: ^sdl.GPURenderPass,
+	sk: ^sketch.Sketch2D,
+	mvp: matrix[4, 4]f32,
 ) {
 	// Detect all profiles
 	profiles := sketch.sketch_detect_profiles(sk)
@@ -3715,9 +4438,11 @@ render_profile_fills_gpu :: proc(
 			}
 		}
 
-		// Line-based closed profile - tessellate as triangle fan
-		if len(profile.points) >= 3 {
-			render_polygon_fill_gpu(app, cmd, pass, sk, profile.points[:], mvp)
+		// Line/spline closed profile - tessellate its outline as triangle fan
+		outline := make([dynamic]m.Vec2, 0, len(profile.points), context.temp_allocator)
+		sketch.sketch_profile_outline(sk, profile, &outline)
+		if len(outline) >= 3 {
+			render_polygon_fill_gpu(app, cmd, pass, sk, outline[:], mvp)
 		}
 	}
 }
@@ -3781,38 +4506,30 @@ render_polygon_fill_gpu :: proc(
 	cmd: ^sdl.GPUCommandBuffer,
 	pass: ^sdl.GPURenderPass,
 	sk: ^sketch.Sketch2D,
-	point_ids: []int,
+	outline: []m.Vec2,
 	mvp: matrix[4, 4]f32,
 ) {
-	if len(point_ids) < 3 do return
+	if len(outline) < 3 do return
 
 	// Calculate centroid for triangle fan center
 	centroid := m.Vec2{0, 0}
-	for point_id in point_ids {
-		pt := sketch.sketch_get_point(sk, point_id)
-		if pt == nil do return
-		centroid.x += pt.x
-		centroid.y += pt.y
+	for pos in outline {
+		centroid += pos
 	}
-	centroid.x /= f64(len(point_ids))
-	centroid.y /= f64(len(point_ids))
+	centroid /= f64(len(outline))
 
 	centroid_3d := sketch.sketch_to_world(&sk.plane, centroid)
 	centroid_f32 := [3]f32{f32(centroid_3d.x), f32(centroid_3d.y), f32(centroid_3d.z)}
 
 	// Generate triangle fan from centroid
-	triangle_verts := make([dynamic]v.LineVertex, 0, len(point_ids) * 3)
+	triangle_verts := make([dynamic]v.LineVertex, 0, len(outline) * 3)
 	defer delete(triangle_verts)
 
-	for i in 0 ..< len(point_ids) {
-		j := (i + 1) % len(point_ids)
+	for i in 0 ..< len(outline) {
+		j := (i + 1) % len(outline)
 
-		pt_i := sketch.sketch_get_point(sk, point_ids[i])
-		pt_j := sketch.sketch_get_point(sk, point_ids[j])
-		if pt_i == nil || pt_j == nil do continue
-
-		pos_i_2d := m.Vec2{pt_i.x, pt_i.y}
-		pos_j_2d := m.Vec2{pt_j.x, pt_j.y}
+		pos_i_2d := outline[i]
+		pos_j_2d := outline[j]
 
 		pos_i_3d := sketch.sketch_to_world(&sk.plane, pos_i_2d)
 		pos_j_3d := sketch.sketch_to_world(&sk.plane, pos_j_2d)
@@ -3898,6 +4615,7 @@ render_filled_triangles_gpu :: proc(
 	sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
 	sdl.EndGPUCopyPass(copy_pass)
 	_ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+	v.frame_profiler_count_upload(&app.viewer.profiler, len(vertices) * size_of(v.LineVertex))
 
 	// Wait for upload to complete
 	_ = sdl.WaitForGPUIdle(app.viewer.gpu_device)
@@ -3920,6 +4638,7 @@ render_filled_triangles_gpu :: proc(
 	sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(v.Uniforms))
 	sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(v.Uniforms))
 	sdl.DrawGPUPrimitives(pass, u32(len(vertices)), 1, 0, 0)
+	v.frame_profiler_count_draw(&app.viewer.profiler, len(vertices) / 3)
 
 	// Switch back to line pipeline
 	sdl.BindGPUGraphicsPipeline(pass, app.viewer.pipeline)
@@ -3941,8 +4660,8 @@ render_circle_centers_gpu :: proc(
 		if circle, is_circle := entity.(sketch.SketchCircle); is_circle {
 			center_pt := sketch.sketch_get_point(sk, circle.center_id)
 			if center_pt != nil {
-				// Render center point slightly larger (5px) for better visibility
-				v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, center_pt, mvp, center_color, 5.0)
+				// Render center point slightly larger (5px) as a square so it reads differently from regular points
+				v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, center_pt, mvp, center_color, 5.0, .Square)
 			}
 		}
 	}
@@ -3992,10 +4711,12 @@ render_radius_handle_gpu :: proc(
 	center_2d := m.Vec2{center_pt.x, center_pt.y}
 	handle_2d := m.Vec2{center_2d.x + circle.radius, center_2d.y}
 
-	// Render handle as a filled dot (similar to point rendering, but with distinct color)
+	// Render handle as a ring; hover only changes the instance color and size
 	handle_color: [4]f32
+	handle_size: f32 = 6.0
 	if app.hover_state.entity_type == .RadiusHandle {
 		handle_color = {1.0, 1.0, 0.0, 1.0} // Yellow when hovered
+		handle_size = 7.0
 	} else {
 		handle_color = {1.0, 0.5, 0.0, 1.0} // Orange when not hovered
 	}
@@ -4008,8 +4729,8 @@ render_radius_handle_gpu :: proc(
 		fixed = false,
 	}
 
-	// Render handle dot (size 6px - slightly larger for visibility)
-	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, &handle_pt, mvp, handle_color, 6.0)
+	// Render handle ring (size 6px - slightly larger for visibility)
+	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, &handle_pt, mvp, handle_color, handle_size, .Ring)
 }
 
 // Render line endpoint handles for selected line (Week 12.3 - Task 3)
@@ -4059,11 +4780,11 @@ render_line_endpoint_handles_gpu :: proc(
 		end_color = {0.0, 1.0, 0.0, 1.0} // Green default
 	}
 
-	// Render start endpoint handle (size 6px)
-	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, start_pt, mvp, start_color, 6.0)
+	// Render start endpoint handle ring (size 6px)
+	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, start_pt, mvp, start_color, 6.0, .Ring)
 
-	// Render end endpoint handle (size 6px)
-	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, end_pt, mvp, end_color, 6.0)
+	// Render end endpoint handle ring (size 6px)
+	v.viewer_gpu_render_single_point(app.viewer, cmd, pass, sk, end_pt, mvp, end_color, 6.0, .Ring)
 }
 
 // Helper to render a filled rectangle in screen space (for UI overlays)
@@ -4141,6 +4862,7 @@ render_filled_rect_gpu :: proc(
 	sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
 	sdl.EndGPUCopyPass(copy_pass)
 	_ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+	v.frame_profiler_count_upload(&app.viewer.profiler, len(vertices) * size_of(v.LineVertex))
 
 	// Wait for upload
 	_ = sdl.WaitForGPUIdle(app.viewer.gpu_device)
@@ -4171,7 +4893,384 @@ render_filled_rect_gpu :: proc(
 	sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(v.Uniforms))
 	sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(v.Uniforms))
 	sdl.DrawGPUPrimitives(pass, u32(len(vertices)), 1, 0, 0)
+	v.frame_profiler_count_draw(&app.viewer.profiler, len(vertices) / 3)
 
 	// Switch back to line pipeline
 	sdl.BindGPUGraphicsPipeline(pass, app.viewer.pipeline)
 }
+
+// =============================================================================
+// Automation Server
+// =============================================================================
+//
+//   ohcad_gpu --serve <socket path> [--jobs n]
+//
+// Keeps documents, OCCT and result caches warm between batch jobs; see io/automation for
+// the request protocol.
+
+run_automation_server :: proc(args: []string) -> int {
+	socket_path := ""
+	jobs := 0
+	for i := 0; i < len(args); i += 1 {
+		switch {
+		case args[i] == "--jobs" && i + 1 < len(args):
+			i += 1
+			jobs, _ = strconv.parse_int(args[i])
+		case !strings.has_prefix(args[i], "-") && socket_path == "":
+			socket_path = args[i]
+		case:
+			socket_path = ""
+			i = len(args)
+		}
+	}
+	if socket_path == "" {
+		fmt.eprintln("Usage: ohcad_gpu --serve <socket path> [--jobs n]")
+		return 1
+	}
+
+	occt.initialize()
+	defer occt.cleanup()
+	defer primitives.primitive_template_cache_destroy()
+
+	return automation.automation_serve(socket_path, jobs)
+}
+
+// =============================================================================
+// Headless Preview Rendering (thumbnails / contact sheets)
+// =============================================================================
+//
+//   ohcad_gpu --render [options] <sketch files...>
+//     -o <dir>           Output directory (default: current directory)
+//     --size <px>        Pixels per view (default 256)
+//     --views <list>     Comma-separated: iso,front,top,right,back,left,bottom (default iso);
+//                        more than one view writes a contact sheet
+//     --depth <mm>       Extrude depth for closed profiles, 0 = sketch edges only (default 10)
+//     --jobs <n>         Documents loaded/regenerated in parallel (default: one per core)
+//     --wireframe        Edges only
+//
+// Documents load and regenerate on a worker pool; the calling thread records GPU work into a
+// small ring of offscreen targets while the previous render finishes, and PNG encoding goes
+// back to the pool.
+
+PREVIEW_TARGETS_IN_FLIGHT :: 2
+PREVIEW_OWNER_STRIDE :: 1 << 20 // Mesh cache owner = document index * stride + feature ID
+
+PreviewOptions :: struct {
+	files:   [dynamic]string,
+	out_dir: string,
+	size:    u32,
+	views:   [dynamic]v.PreviewView,
+	depth:   f64,
+	jobs:    int,
+	style:   v.OffscreenStyle,
+}
+
+PreviewDocument :: struct {
+	path:     string,
+	out_path: string,
+	tree:     ftree.FeatureTree,
+	edges:    [dynamic]v.WireframeMeshGPU,
+	items:    [dynamic]v.OffscreenItem,
+	loaded:   bool,
+
+	// Filled once rendered (written by the PNG task)
+	pixels:   []u8,
+	width:    u32,
+	height:   u32,
+	written:  bool,
+}
+
+// Shared with pool tasks (each task only touches its own document)
+PreviewBatch :: struct {
+	docs:   []PreviewDocument,
+	depth:  f64,
+	mutex:  sync.Mutex, // Guards loaded
+	loaded: [dynamic]int, // Documents ready to render, in completion order
+	ready:  sync.Sema, // Posted once per finished load
+}
+
+// Entry point for --render; returns the process exit code
+run_preview_cli :: proc(args: []string) -> int {
+	opts, opts_ok := parse_preview_args(args)
+	defer {
+		delete(opts.files)
+		delete(opts.views)
+	}
+	if !opts_ok || len(opts.files) == 0 {
+		fmt.eprintln("Usage: ohcad_gpu --render [-o dir] [--size px] [--views iso,front,top,right,...]")
+		fmt.eprintln("                  [--depth mm] [--jobs n] [--wireframe] <sketch files...>")
+		return 1
+	}
+
+	occt.initialize()
+	defer occt.cleanup()
+
+	viewer, ok := v.viewer_gpu_init(v.HEADLESS_GPU_CONFIG)
+	if !ok {
+		fmt.eprintln("Failed to initialize headless GPU renderer")
+		return 1
+	}
+	defer v.viewer_gpu_destroy(viewer)
+
+	// One size x size tile per view
+	cols := int(math.ceil(math.sqrt(f64(len(opts.views)))))
+	rows := (len(opts.views) + cols - 1) / cols
+	width, height := opts.size * u32(cols), opts.size * u32(rows)
+
+	targets: [PREVIEW_TARGETS_IN_FLIGHT]v.OffscreenTarget
+	target_doc: [PREVIEW_TARGETS_IN_FLIGHT]int
+	for &target, i in targets {
+		target_ok: bool
+		target, target_ok = v.offscreen_target_create(viewer, width, height)
+		if !target_ok {
+			for &t in targets[:i] do v.offscreen_target_destroy(viewer, &t)
+			return 1
+		}
+		target_doc[i] = -1
+	}
+	defer for &target in targets do v.offscreen_target_destroy(viewer, &target)
+
+	docs := make([]PreviewDocument, len(opts.files))
+	defer {
+		for document in docs do delete(document.out_path)
+		delete(docs)
+	}
+	for path, i in opts.files {
+		docs[i].path = path
+		docs[i].out_path = preview_output_path(opts.out_dir, path)
+		docs[i].tree = ftree.feature_tree_init()
+	}
+
+	batch := PreviewBatch{docs = docs, depth = opts.depth}
+	defer delete(batch.loaded)
+
+	start := time.tick_now()
+
+	pool: thread.Pool
+	thread.pool_init(&pool, context.allocator, opts.jobs > 0 ? opts.jobs : os.processor_core_count())
+	defer thread.pool_destroy(&pool)
+	thread.pool_start(&pool)
+
+	for _, i in docs {
+		thread.pool_add_task(&pool, context.allocator, preview_load_task, &batch, i)
+	}
+
+	// Render documents as they finish loading (GPU work stays on this thread)
+	submitted := 0
+	for _ in 0..<len(docs) {
+		sync.sema_wait(&batch.ready)
+		sync.mutex_lock(&batch.mutex)
+		index := pop_front(&batch.loaded)
+		sync.mutex_unlock(&batch.mutex)
+
+		document := &docs[index]
+		if !document.loaded {
+			thread.pool_add_task(&pool, context.allocator, preview_write_task, &batch, index)
+			continue
+		}
+
+		// Reusing a slot: finish its previous render first
+		slot := submitted % PREVIEW_TARGETS_IN_FLIGHT
+		preview_collect(viewer, &targets[slot], &target_doc[slot], &batch, &pool)
+
+		if v.offscreen_render_submit(viewer, &targets[slot], document.items[:], opts.views[:], cols, opts.style) {
+			target_doc[slot] = index
+			submitted += 1
+		} else {
+			thread.pool_add_task(&pool, context.allocator, preview_write_task, &batch, index)
+		}
+	}
+
+	for &target, slot in targets {
+		preview_collect(viewer, &target, &target_doc[slot], &batch, &pool)
+	}
+	thread.pool_finish(&pool)
+
+	written := 0
+	for document in docs {
+		if document.written do written += 1
+	}
+
+	fmt.printf("🖼️  Rendered %d/%d document(s) (%dx%d, %d view(s)) in %.1f ms\n",
+		written, len(docs), width, height, len(opts.views),
+		time.duration_milliseconds(time.tick_since(start)))
+	v.gpu_mesh_cache_print_stats(&viewer.mesh_cache)
+
+	return written == len(docs) ? 0 : 1
+}
+
+parse_preview_args :: proc(args: []string) -> (opts: PreviewOptions, ok: bool) {
+	opts.out_dir = "."
+	opts.size = 256
+	opts.depth = 10
+	opts.style = v.DEFAULT_OFFSCREEN_STYLE
+
+	for i := 0; i < len(args); i += 1 {
+		arg := args[i]
+		has_value := i + 1 < len(args)
+
+		switch arg {
+		case "-o":
+			if !has_value do return opts, false
+			i += 1
+			opts.out_dir = args[i]
+		case "--size":
+			if !has_value do return opts, false
+			i += 1
+			size, size_ok := strconv.parse_uint(args[i])
+			if !size_ok || size == 0 do return opts, false
+			opts.size = u32(size)
+		case "--depth":
+			if !has_value do return opts, false
+			i += 1
+			opts.depth = strconv.parse_f64(args[i]) or_return
+		case "--jobs":
+			if !has_value do return opts, false
+			i += 1
+			opts.jobs = strconv.parse_int(args[i]) or_return
+		case "--views":
+			if !has_value do return opts, false
+			i += 1
+			for name in strings.split_iterator(&args[i], ",") {
+				view, view_ok := preview_view_from_name(name)
+				if !view_ok {
+					fmt.eprintln("Unknown view:", name)
+					return opts, false
+				}
+				append(&opts.views, view)
+			}
+		case "--wireframe":
+			opts.style.mode = .Wireframe
+			opts.style.edge_color = {0.9, 0.9, 0.9, 1}
+		case:
+			if strings.has_prefix(arg, "-") {
+				fmt.eprintln("Unknown option:", arg)
+				return opts, false
+			}
+			append(&opts.files, arg)
+		}
+	}
+
+	if len(opts.views) == 0 {
+		append(&opts.views, v.PreviewView.Iso)
+	}
+	return opts, true
+}
+
+preview_view_from_name :: proc(name: string) -> (v.PreviewView, bool) {
+	switch strings.trim_space(name) {
+	case "iso":    return .Iso, true
+	case "front":  return .Front, true
+	case "top":    return .Top, true
+	case "right":  return .Right, true
+	case "back":   return .Back, true
+	case "left":   return .Left, true
+	case "bottom": return .Bottom, true
+	}
+	return .Iso, false
+}
+
+// <out_dir>/<file stem>.png
+preview_output_path :: proc(out_dir, path: string) -> string {
+	name := strings.concatenate({filepath.stem(path), ".png"}, context.temp_allocator)
+	joined, _ := filepath.join({out_dir, name})
+	return joined
+}
+
+// Pool task: load the sketch, extrude its profile and build the draw list
+preview_load_task :: proc(task: thread.Task) {
+	batch := (^PreviewBatch)(task.data)
+	document := &batch.docs[task.user_index]
+
+	if loaded_sketch, ok := sketch.sketch_load_from_file(document.path); ok {
+		sk := new(sketch.Sketch2D)
+		sk^ = loaded_sketch
+		sketch_id := ftree.feature_tree_add_sketch(&document.tree, sk, "Sketch")
+
+		// Closed profiles get a body; sketches without one fall back to their edges below
+		if batch.depth > 0 {
+			ftree.feature_tree_add_extrude(&document.tree, sketch_id, batch.depth, .Forward, "Extrude")
+		}
+
+		// Documents already run in parallel - regenerate each tree serially
+		ftree.feature_tree_regenerate_all(&document.tree, 1)
+
+		for &feature in document.tree.features {
+			if feature.result_solid == nil || !feature.visible || !feature.enabled do continue
+			append(&document.edges, v.solid_to_wireframe_gpu(feature.result_solid))
+			append(&document.items, v.OffscreenItem{
+				key = {owner_id = task.user_index * PREVIEW_OWNER_STRIDE + feature.id},
+				solid = feature.result_solid,
+			})
+		}
+
+		if len(document.items) == 0 {
+			append(&document.edges, v.sketch_to_wireframe_gpu(sk))
+			append(&document.items, v.OffscreenItem{})
+		}
+
+		// Edges are complete - safe to point into the array now
+		for &item, i in document.items {
+			item.edges = &document.edges[i]
+		}
+		document.loaded = true
+	} else {
+		fmt.eprintln("❌ Failed to load:", document.path)
+	}
+
+	free_all(context.temp_allocator)
+
+	sync.mutex_lock(&batch.mutex)
+	append(&batch.loaded, task.user_index)
+	sync.mutex_unlock(&batch.mutex)
+	sync.sema_post(&batch.ready)
+}
+
+// Pool task: encode the PNG, then free the document
+preview_write_task :: proc(task: thread.Task) {
+	batch := (^PreviewBatch)(task.data)
+	document := &batch.docs[task.user_index]
+
+	if document.pixels != nil {
+		document.written = v.offscreen_write_png(document.out_path, document.pixels, document.width, document.height)
+		if document.written {
+			fmt.printf("✅ %s → %s\n", document.path, document.out_path)
+		}
+		delete(document.pixels)
+		document.pixels = nil
+	}
+
+	for &mesh in document.edges {
+		v.wireframe_mesh_gpu_destroy(&mesh)
+	}
+	delete(document.edges)
+	delete(document.items)
+	ftree.feature_tree_destroy(&document.tree)
+
+	free_all(context.temp_allocator)
+}
+
+// Read back the render in a target slot (if any) and hand its document to a PNG task
+preview_collect :: proc(
+	viewer: ^v.ViewerGPU,
+	target: ^v.OffscreenTarget,
+	slot_document: ^int,
+	batch: ^PreviewBatch,
+	pool: ^thread.Pool,
+) {
+	if slot_document^ < 0 do return
+	document := &batch.docs[slot_document^]
+
+	document.pixels, _ = v.offscreen_target_read(viewer, target)
+	document.width, document.height = target.width, target.height
+
+	// The document's solids are freed by the PNG task - drop their cached GPU meshes first
+	for item in document.items {
+		if item.solid != nil {
+			v.gpu_mesh_cache_invalidate(&viewer.mesh_cache, viewer.gpu_device, item.key.owner_id)
+		}
+	}
+
+	thread.pool_add_task(pool, context.allocator, preview_write_task, batch, slot_document^)
+	slot_document^ = -1
+}
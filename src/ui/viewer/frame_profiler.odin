@@ -0,0 +1,346 @@
+// ui/viewer - Frame profiler and frame-time HUD (SDL3 GPU)
+// Records per-pass CPU times, draw/upload/triangle counters and regeneration/solver time for
+// each rendered frame into a ring buffer, draws them as an overlay (histogram + breakdown),
+// and exports the history to CSV for comparing builds.
+//
+// SDL3 GPU exposes no timestamp queries on any backend, so GPU time is measured per frame:
+// while the HUD is visible the frame is submitted with a fence and the CPU waits for it.
+// That serializes CPU and GPU (frames get slower, numbers get exact) and only covers the whole
+// frame, not individual passes.
+package ohcad_viewer
+
+import "core:fmt"
+import "core:os"
+import "core:strings"
+import "core:time"
+import sdl "vendor:sdl3"
+
+FRAME_HISTORY :: 240  // Frames kept for the histogram and CSV export
+
+// Sections of render_frame_gpu, in drawing order
+FramePass :: enum {
+    Setup,         // Command buffer, swapchain, depth texture, render pass begin
+    Grid,          // Grid and axes
+    Sketches,      // Sketch wireframes, points, selection and preview geometry
+    Constraints,   // Dimensions and constraint icons
+    ProfileFills,
+    Solids,        // Shaded meshes and edge overlays
+    Highlights,    // Face/edge/vertex picks and point sprite flush
+    Text,          // Title, status line, tooltips
+    UIPanels,      // Toolbar, properties, feature tree, status bar and their actions
+    Submit,        // End pass, submit, font atlas upload
+}
+
+FRAME_PASS_NAMES := [FramePass]string{
+    .Setup = "Setup",
+    .Grid = "Grid",
+    .Sketches = "Sketches",
+    .Constraints = "Constraints",
+    .ProfileFills = "ProfileFills",
+    .Solids = "Solids",
+    .Highlights = "Highlights",
+    .Text = "Text",
+    .UIPanels = "UIPanels",
+    .Submit = "Submit",
+}
+
+FrameSample :: struct {
+    frame: u64,
+    interval: time.Duration,       // Start of previous frame → start of this one
+    cpu_time: time.Duration,       // render_frame_gpu on the CPU, without the fence wait
+    gpu_time: time.Duration,       // Submit → fence signaled (0 = not measured)
+    pass_times: [FramePass]time.Duration,
+    draw_calls: int,
+    triangles: int,
+    upload_bytes: int,
+    queue: RenderQueueStats,       // Sorted render queue, before/after sorting
+    regen_time: time.Duration,     // Feature regeneration since the previous frame
+    solve_time: time.Duration,     // Constraint solving since the previous frame
+}
+
+FrameProfiler :: struct {
+    hud_visible: bool,
+
+    current: FrameSample,          // Counters accumulate here until frame_profiler_end_frame
+    frame_start: time.Tick,
+    last_frame_start: time.Tick,
+    pass: FramePass,
+    pass_start: time.Tick,
+    fence_wait: time.Duration,     // Time blocked on the GPU fence this frame (not CPU work)
+    in_frame: bool,
+
+    history: [FRAME_HISTORY]FrameSample,
+    frames: u64,                   // Frames recorded (history index = frames % FRAME_HISTORY)
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+frame_profiler_begin_frame :: proc(p: ^FrameProfiler) {
+    now := time.tick_now()
+    if p.last_frame_start != {} {
+        p.current.interval = time.tick_diff(p.last_frame_start, now)
+    }
+    p.last_frame_start = now
+    p.frame_start = now
+    p.current.pass_times = {}  // A frame abandoned before end_frame (no swapchain) leaves partial times
+    p.current.gpu_time = 0
+    p.fence_wait = 0
+    p.pass = .Setup
+    p.pass_start = now
+    p.in_frame = true
+}
+
+// Close the running pass and start timing the next one
+frame_profiler_pass :: proc(p: ^FrameProfiler, pass: FramePass) {
+    if !p.in_frame do return
+    now := time.tick_now()
+    p.current.pass_times[p.pass] += time.tick_diff(p.pass_start, now)
+    p.pass = pass
+    p.pass_start = now
+}
+
+frame_profiler_end_frame :: proc(p: ^FrameProfiler) {
+    if !p.in_frame do return
+    now := time.tick_now()
+    p.current.pass_times[p.pass] += time.tick_diff(p.pass_start, now)
+    p.current.cpu_time = time.tick_diff(p.frame_start, now) - p.fence_wait
+    p.current.frame = p.frames
+
+    p.history[p.frames % FRAME_HISTORY] = p.current
+    p.frames += 1
+    p.current = {}
+    p.in_frame = false
+}
+
+frame_profiler_count_draw :: #force_inline proc(p: ^FrameProfiler, triangles: int) {
+    p.current.draw_calls += 1
+    p.current.triangles += triangles
+}
+
+frame_profiler_count_upload :: #force_inline proc(p: ^FrameProfiler, bytes: int) {
+    p.current.upload_bytes += bytes
+}
+
+frame_profiler_count_queue :: proc(p: ^FrameProfiler, stats: RenderQueueStats) {
+    q := &p.current.queue
+    q.items += stats.items
+    q.draws_unsorted += stats.draws_unsorted
+    q.draws += stats.draws
+    q.binds_unsorted += stats.binds_unsorted
+    q.binds += stats.binds
+    q.pushes_unsorted += stats.pushes_unsorted
+    q.pushes += stats.pushes
+}
+
+frame_profiler_add_regen :: proc(p: ^FrameProfiler, duration: time.Duration) {
+    p.current.regen_time += duration
+}
+
+frame_profiler_add_solve :: proc(p: ^FrameProfiler, duration: time.Duration) {
+    p.current.solve_time += duration
+}
+
+// Submit the frame; while the HUD is visible, wait for the GPU and record the frame's GPU time.
+// The wait is kept out of cpu_time and the pass times, so CPU + GPU does not count it twice.
+frame_profiler_submit :: proc(p: ^FrameProfiler, device: ^sdl.GPUDevice, cmd: ^sdl.GPUCommandBuffer) {
+    if !p.hud_visible {
+        _ = sdl.SubmitGPUCommandBuffer(cmd)
+        return
+    }
+
+    start := time.tick_now()
+    fence := sdl.SubmitGPUCommandBufferAndAcquireFence(cmd)
+    if fence == nil do return
+
+    // Close the running pass before blocking; it resumes once the fence is signaled
+    wait_start := time.tick_now()
+    if p.in_frame {
+        p.current.pass_times[p.pass] += time.tick_diff(p.pass_start, wait_start)
+    }
+
+    if sdl.WaitForGPUFences(device, true, &fence, 1) {
+        p.current.gpu_time = time.tick_since(start)
+    }
+
+    wait_end := time.tick_now()
+    if p.in_frame {
+        p.fence_wait += time.tick_diff(wait_start, wait_end)
+        p.pass_start = wait_end
+    }
+    sdl.ReleaseGPUFence(device, fence)
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// Recorded frames (up to FRAME_HISTORY), oldest first
+frame_profiler_samples :: proc(p: ^FrameProfiler, allocator := context.temp_allocator) -> []FrameSample {
+    count := int(min(p.frames, FRAME_HISTORY))
+    samples := make([]FrameSample, count, allocator)
+    first := p.frames - u64(count)
+    for i in 0..<count {
+        samples[i] = p.history[(first + u64(i)) % FRAME_HISTORY]
+    }
+    return samples
+}
+
+frame_profiler_export_csv :: proc(p: ^FrameProfiler, path: string) -> bool {
+    b := strings.builder_make()
+    defer strings.builder_destroy(&b)
+
+    ms :: proc(d: time.Duration) -> f64 { return time.duration_milliseconds(d) }
+
+    strings.write_string(&b, "frame,interval_ms,cpu_ms,gpu_ms")
+    for name in FRAME_PASS_NAMES {
+        fmt.sbprintf(&b, ",%s_ms", name)
+    }
+    strings.write_string(&b, ",draw_calls,triangles,upload_bytes,regen_ms,solve_ms")
+    strings.write_string(&b, ",queue_items,queue_draws_unsorted,queue_draws,queue_binds_unsorted,queue_binds,queue_pushes_unsorted,queue_pushes\n")
+
+    for s in frame_profiler_samples(p) {
+        fmt.sbprintf(&b, "%d,%.4f,%.4f,%.4f", s.frame, ms(s.interval), ms(s.cpu_time), ms(s.gpu_time))
+        for t in s.pass_times {
+            fmt.sbprintf(&b, ",%.4f", ms(t))
+        }
+        fmt.sbprintf(&b, ",%d,%d,%d,%.4f,%.4f",
+            s.draw_calls, s.triangles, s.upload_bytes, ms(s.regen_time), ms(s.solve_time))
+        q := s.queue
+        fmt.sbprintf(&b, ",%d,%d,%d,%d,%d,%d,%d\n",
+            q.items, q.draws_unsorted, q.draws, q.binds_unsorted, q.binds, q.pushes_unsorted, q.pushes)
+    }
+
+    if !os.write_entire_file(path, b.buf[:]) {
+        fmt.printf("❌ Failed to write frame stats to %s\n", path)
+        return false
+    }
+
+    fmt.printf("✅ Exported %d frames of stats to %s\n", min(p.frames, FRAME_HISTORY), path)
+    return true
+}
+
+// =============================================================================
+// HUD
+// =============================================================================
+
+// Draw the overlay in the top-right corner (call inside the frame's render pass, last)
+viewer_gpu_render_frame_hud :: proc(
+    viewer: ^ViewerGPU,
+    text_renderer: ^TextRendererGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    screen_width, screen_height: u32,
+) {
+    p := &viewer.profiler
+    if !p.hud_visible || p.frames == 0 {
+        return
+    }
+
+    samples := frame_profiler_samples(p, context.allocator)
+    defer delete(samples)
+    last := samples[len(samples) - 1]
+
+    BAR_WIDTH :: 1.5
+    GRAPH_HEIGHT :: 80.0
+    GRAPH_SCALE_MS :: 50.0  // Graph top
+    TEXT_SIZE :: 14.0
+    LINE_HEIGHT :: 17.0
+    PANEL_WIDTH :: f32(FRAME_HISTORY) * BAR_WIDTH + 20
+
+    x0 := f32(screen_width) - PANEL_WIDTH - 10
+    y0 := f32(60)
+    lines := 7 + len(FramePass)
+    panel_height := f32(GRAPH_HEIGHT) + 20 + f32(lines) * LINE_HEIGHT
+
+    viewer_gpu_render_rect_inline(viewer, cmd, pass, x0, y0, PANEL_WIDTH, panel_height, {0, 0, 0, 0.7}, screen_width, screen_height)
+
+    // Frame-time histogram (frame interval, or CPU time for isolated event-driven frames),
+    // one batch per budget class: green ≤ 16.7 ms, yellow ≤ 33.3 ms, red above
+    bars: [3][dynamic]LineVertex
+    for &b in bars do b = make([dynamic]LineVertex, 0, len(samples) * 6)
+    defer for b in bars do delete(b)
+
+    graph_x := x0 + 10
+    graph_bottom := y0 + 10 + GRAPH_HEIGHT
+    for s, i in samples {
+        frame_ms := time.duration_milliseconds(frame_sample_duration(s))
+        bar_h := f32(min(frame_ms / GRAPH_SCALE_MS, 1)) * GRAPH_HEIGHT
+        class := frame_ms <= 1000.0 / 60 ? 0 : frame_ms <= 1000.0 / 30 ? 1 : 2
+
+        bx := graph_x + f32(FRAME_HISTORY - len(samples) + i) * BAR_WIDTH
+        append_screen_rect(&bars[class], bx, graph_bottom - bar_h, BAR_WIDTH, bar_h, screen_width, screen_height)
+    }
+
+    bar_colors := [3][4]f32{{0.2, 0.8, 0.3, 0.9}, {0.9, 0.8, 0.2, 0.9}, {0.9, 0.25, 0.2, 0.9}}
+    for b, i in bars {
+        viewer_gpu_render_triangles_2d(viewer, cmd, pass, b[:], bar_colors[i])
+    }
+
+    // 60 fps budget line
+    budget_y := graph_bottom - f32(1000.0 / 60 / GRAPH_SCALE_MS) * GRAPH_HEIGHT
+    viewer_gpu_render_rect_inline(viewer, cmd, pass, graph_x, budget_y, f32(FRAME_HISTORY) * BAR_WIDTH, 1, {1, 1, 1, 0.35}, screen_width, screen_height)
+
+    if text_renderer == nil {
+        return
+    }
+
+    // Averages over the history
+    avg, worst: time.Duration
+    for s in samples {
+        d := frame_sample_duration(s)
+        avg += d
+        worst = max(worst, d)
+    }
+    avg /= time.Duration(len(samples))
+
+    ms :: proc(d: time.Duration) -> f64 { return time.duration_milliseconds(d) }
+
+    white := [4]u8{230, 230, 230, 255}
+    dim := [4]u8{160, 160, 160, 255}
+    y := graph_bottom + 10
+    text :: proc(r: ^TextRendererGPU, cmd: ^sdl.GPUCommandBuffer, pass: ^sdl.GPURenderPass, s: string, x: f32, y: ^f32, color: [4]u8, w, h: u32) {
+        text_render_2d_gpu(r, cmd, pass, s, x, y^, TEXT_SIZE, color, w, h)
+        y^ += LINE_HEIGHT
+    }
+
+    tx := x0 + 10
+    text(text_renderer, cmd, pass, fmt.tprintf("Frame %.2f ms  avg %.2f  max %.2f", ms(frame_sample_duration(last)), ms(avg), ms(worst)), tx, &y, white, screen_width, screen_height)
+    text(text_renderer, cmd, pass, fmt.tprintf("CPU %.2f ms  GPU %.2f ms", ms(last.cpu_time), ms(last.gpu_time)), tx, &y, white, screen_width, screen_height)
+    for t, pass_id in last.pass_times {
+        text(text_renderer, cmd, pass, fmt.tprintf("  %-12s %6.2f ms", FRAME_PASS_NAMES[pass_id], ms(t)), tx, &y, dim, screen_width, screen_height)
+    }
+    text(text_renderer, cmd, pass, fmt.tprintf("Draws %d  Tris %d", last.draw_calls, last.triangles), tx, &y, white, screen_width, screen_height)
+    q := last.queue
+    text(text_renderer, cmd, pass, fmt.tprintf("Queue %d: draws %d->%d binds %d->%d pushes %d->%d",
+        q.items, q.draws_unsorted, q.draws, q.binds_unsorted, q.binds, q.pushes_unsorted, q.pushes), tx, &y, white, screen_width, screen_height)
+    text(text_renderer, cmd, pass, fmt.tprintf("Uploads %.1f KB", f64(last.upload_bytes) / 1024), tx, &y, white, screen_width, screen_height)
+    text(text_renderer, cmd, pass, fmt.tprintf("Regen %.2f ms  Solve %.2f ms", ms(last.regen_time), ms(last.solve_time)), tx, &y, white, screen_width, screen_height)
+    text(text_renderer, cmd, pass, "[F3] hide  [F4] export CSV", tx, &y, dim, screen_width, screen_height)
+}
+
+// Frame cost shown in the histogram: the frame interval when frames run back to back,
+// otherwise (event-driven redraw after idle) the frame's own CPU + GPU time
+@(private="file")
+frame_sample_duration :: proc(s: FrameSample) -> time.Duration {
+    busy := s.cpu_time + s.gpu_time
+    if s.interval == 0 || s.interval > 4 * busy + 100 * time.Millisecond {
+        return busy
+    }
+    return s.interval
+}
+
+// Two NDC triangles for a screen-space rectangle
+@(private="file")
+append_screen_rect :: proc(out: ^[dynamic]LineVertex, x, y, width, height: f32, screen_width, screen_height: u32) {
+    x0 := (2.0 * x) / f32(screen_width) - 1.0
+    y0 := 1.0 - (2.0 * y) / f32(screen_height)
+    x1 := (2.0 * (x + width)) / f32(screen_width) - 1.0
+    y1 := 1.0 - (2.0 * (y + height)) / f32(screen_height)
+
+    append(out,
+        LineVertex{{x0, y0, 0}}, LineVertex{{x0, y1, 0}}, LineVertex{{x1, y1, 0}},
+        LineVertex{{x0, y0, 0}}, LineVertex{{x1, y1, 0}}, LineVertex{{x1, y0, 0}},
+    )
+}
@@ -0,0 +1,395 @@
+// ui/viewer - GPU mesh cache with a VRAM budget and LRU eviction (SDL3 GPU)
+// Shaded meshes are uploaded once per feature/LOD and kept resident while they fit the
+// budget. Resident meshes sit on a use-ordered list, so eviction takes its head in O(1);
+// meshes that are not drawn (hidden, consumed by a cut, stale LODs) age out first, and
+// evicted meshes are re-uploaded from the CPU solid the next time they are drawn.
+package ohcad_viewer
+
+import "core:fmt"
+import extrude "../../features/extrude"
+import sdl "vendor:sdl3"
+
+// Default VRAM budget for cached solid meshes
+DEFAULT_GPU_MESH_BUDGET :: 256 * 1024 * 1024
+
+// =============================================================================
+// Types
+// =============================================================================
+
+// Cache key - one entry per feature and level of detail
+GPUMeshKey :: struct {
+    owner_id: int,  // Feature ID (negative for meshes shared between features)
+    lod: int,       // 0 = exact mesh, 1+ = simplified/decimated reps
+}
+
+// Cached mesh (buffer is nil while evicted)
+GPUMeshEntry :: struct {
+    source: ^extrude.SimpleSolid,  // CPU data to (re-)upload from
+    source_triangles: int,         // Triangle count at upload time (detects changed solids)
+    buffer: ^sdl.GPUBuffer,
+    vertex_count: u32,
+    size_bytes: u64,
+    last_used_frame: u64,
+
+    // Resident entries form a list from least to most recently used, linked by key
+    // (map values move when the map grows, so links can't be pointers)
+    lru_prev, lru_next: GPUMeshKey,
+    in_lru: bool,
+}
+
+// Snapshot of cache usage
+GPUMeshCacheStats :: struct {
+    budget_bytes: u64,
+    resident_count: int,    // Meshes currently in VRAM
+    resident_bytes: u64,
+    evicted_count: int,     // Known meshes currently evicted
+    evicted_bytes: u64,
+    uploads: int,           // Lifetime uploads (including re-uploads)
+    evictions: int,         // Lifetime evictions
+    over_budget: bool,      // Current frame needs more than the budget
+}
+
+GPUMeshCache :: struct {
+    entries: map[GPUMeshKey]GPUMeshEntry,
+    lru_head: GPUMeshKey,   // Least recently used resident entry (valid while lru_count > 0)
+    lru_tail: GPUMeshKey,   // Most recently used resident entry
+    lru_count: int,
+    budget_bytes: u64,
+    resident_bytes: u64,
+    frame: u64,             // Advanced by gpu_mesh_cache_begin_frame
+    uploads: int,
+    evictions: int,
+}
+
+// =============================================================================
+// Init / Destroy
+// =============================================================================
+
+gpu_mesh_cache_init :: proc(cache: ^GPUMeshCache, budget_bytes: u64 = DEFAULT_GPU_MESH_BUDGET) {
+    cache.entries = make(map[GPUMeshKey]GPUMeshEntry)
+    cache.budget_bytes = budget_bytes
+}
+
+gpu_mesh_cache_destroy :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice) {
+    gpu_mesh_cache_invalidate_all(cache, device)
+    delete(cache.entries)
+}
+
+// =============================================================================
+// Frame / Budget Management
+// =============================================================================
+
+// Call once per rendered frame before drawing cached meshes
+gpu_mesh_cache_begin_frame :: proc(cache: ^GPUMeshCache) {
+    cache.frame += 1
+}
+
+// Change the budget, evicting immediately if the cache is now over it
+gpu_mesh_cache_set_budget :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice, budget_bytes: u64) {
+    cache.budget_bytes = budget_bytes
+    gpu_mesh_cache_evict_to_fit(cache, device, 0)
+}
+
+// Forget all LODs of one owner (its CPU solid was replaced or freed)
+gpu_mesh_cache_invalidate :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice, owner_id: int) {
+    stale := make([dynamic]GPUMeshKey, 0, 4, context.temp_allocator)
+    for key in cache.entries {
+        if key.owner_id == owner_id {
+            append(&stale, key)
+        }
+    }
+
+    for key in stale {
+        gpu_mesh_entry_release(cache, device, key)
+        delete_key(&cache.entries, key)
+    }
+}
+
+// Forget every entry (e.g. on shutdown or device loss)
+gpu_mesh_cache_invalidate_all :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice) {
+    for _, &entry in cache.entries {
+        if entry.buffer != nil {
+            sdl.ReleaseGPUBuffer(device, entry.buffer)
+        }
+    }
+    clear(&cache.entries)
+    cache.resident_bytes = 0
+    cache.lru_count = 0
+}
+
+// Release least-recently-used buffers until incoming_bytes more fit in the budget
+// Meshes drawn in the current frame are never evicted; returns false if the budget still can't be met
+gpu_mesh_cache_evict_to_fit :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice, incoming_bytes: u64) -> bool {
+    for cache.resident_bytes + incoming_bytes > cache.budget_bytes {
+        if cache.lru_count == 0 {
+            return false
+        }
+
+        // The list is in use order, so once the head was drawn this frame every entry was
+        victim := cache.lru_head
+        if cache.entries[victim].last_used_frame >= cache.frame {
+            return false
+        }
+
+        gpu_mesh_entry_release(cache, device, victim)
+        cache.evictions += 1
+    }
+
+    return true
+}
+
+gpu_mesh_cache_stats :: proc(cache: ^GPUMeshCache) -> GPUMeshCacheStats {
+    stats := GPUMeshCacheStats{
+        budget_bytes = cache.budget_bytes,
+        resident_bytes = cache.resident_bytes,
+        uploads = cache.uploads,
+        evictions = cache.evictions,
+        over_budget = cache.resident_bytes > cache.budget_bytes,
+    }
+
+    for _, entry in cache.entries {
+        if entry.buffer != nil {
+            stats.resident_count += 1
+        } else {
+            stats.evicted_count += 1
+            stats.evicted_bytes += entry.size_bytes
+        }
+    }
+
+    return stats
+}
+
+gpu_mesh_cache_print_stats :: proc(cache: ^GPUMeshCache) {
+    s := gpu_mesh_cache_stats(cache)
+    fmt.printf("GPU mesh cache: %d resident (%.1f / %.1f MB), %d evicted (%.1f MB), %d uploads, %d evictions%s\n",
+        s.resident_count, f64(s.resident_bytes) / (1024 * 1024), f64(s.budget_bytes) / (1024 * 1024),
+        s.evicted_count, f64(s.evicted_bytes) / (1024 * 1024),
+        s.uploads, s.evictions, s.over_budget ? " ⚠️ over budget" : "")
+}
+
+// =============================================================================
+// Acquire / Draw
+// =============================================================================
+
+// Get a resident vertex buffer for solid, uploading it if missing, evicted or out of date
+gpu_mesh_cache_acquire :: proc(
+    viewer: ^ViewerGPU,
+    key: GPUMeshKey,
+    solid: ^extrude.SimpleSolid,
+) -> (buffer: ^sdl.GPUBuffer, vertex_count: u32, ok: bool) {
+    cache := &viewer.mesh_cache
+    if solid == nil || len(solid.triangles) == 0 {
+        return nil, 0, false
+    }
+
+    entry, found := &cache.entries[key]
+    if !found {
+        cache.entries[key] = GPUMeshEntry{}
+        entry = &cache.entries[key]
+    }
+
+    // Solid replaced since upload - drop the stale buffer
+    if entry.source != solid || entry.source_triangles != len(solid.triangles) {
+        gpu_mesh_entry_release(cache, viewer.gpu_device, key)
+        entry.source = solid
+        entry.source_triangles = len(solid.triangles)
+    }
+
+    entry.last_used_frame = cache.frame
+
+    if entry.buffer == nil && !gpu_mesh_entry_upload(viewer, entry) {
+        return nil, 0, false
+    }
+
+    // Most recently used moves to the tail
+    lru_unlink(cache, key, entry)
+    lru_push_back(cache, key, entry)
+
+    return entry.buffer, entry.vertex_count, true
+}
+
+// Draw a solid from the cache with the shaded pipeline
+viewer_gpu_render_cached_mesh :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    key: GPUMeshKey,
+    solid: ^extrude.SimpleSolid,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+) {
+    if viewer.shaded_pipeline == nil {
+        return
+    }
+
+    buffer, vertex_count, ok := gpu_mesh_cache_acquire(viewer, key, solid)
+    if !ok {
+        return
+    }
+
+    viewer_gpu_draw_shaded_buffer(viewer, cmd, pass, buffer, vertex_count, color, mvp)
+}
+
+// Draw a cached mesh shared by several instances (e.g. a unit primitive template)
+// mvp already includes the instance's model transform; normal_matrix is its inverse transpose.
+viewer_gpu_render_cached_mesh_instanced :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    key: GPUMeshKey,
+    solid: ^extrude.SimpleSolid,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+) {
+    if viewer.shaded_pipeline == nil {
+        return
+    }
+
+    buffer, vertex_count, ok := gpu_mesh_cache_acquire(viewer, key, solid)
+    if !ok {
+        return
+    }
+
+    viewer_gpu_draw_shaded_buffer_transformed(viewer, cmd, pass, buffer, vertex_count, color, mvp, normal_matrix)
+}
+
+// Queue a cached mesh on the sorted render queue (drawn by render_queue_flush)
+render_queue_submit_cached_mesh :: proc(
+    viewer: ^ViewerGPU,
+    key: GPUMeshKey,
+    solid: ^extrude.SimpleSolid,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+) {
+    buffer, vertex_count, ok := gpu_mesh_cache_acquire(viewer, key, solid)
+    if !ok {
+        return
+    }
+
+    render_queue_submit_shaded(viewer, buffer, vertex_count, color, mvp, normal_matrix)
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+@(private="file")
+gpu_mesh_entry_release :: proc(cache: ^GPUMeshCache, device: ^sdl.GPUDevice, key: GPUMeshKey) {
+    entry, found := &cache.entries[key]
+    if !found || entry.buffer == nil {
+        return
+    }
+
+    // SDL defers the actual release until in-flight command buffers are done with it
+    sdl.ReleaseGPUBuffer(device, entry.buffer)
+    entry.buffer = nil
+    cache.resident_bytes -= entry.size_bytes
+    lru_unlink(cache, key, entry)
+}
+
+@(private="file")
+lru_unlink :: proc(cache: ^GPUMeshCache, key: GPUMeshKey, entry: ^GPUMeshEntry) {
+    if !entry.in_lru {
+        return
+    }
+
+    if key == cache.lru_head {
+        cache.lru_head = entry.lru_next
+    } else {
+        prev, _ := &cache.entries[entry.lru_prev]
+        prev.lru_next = entry.lru_next
+    }
+    if key == cache.lru_tail {
+        cache.lru_tail = entry.lru_prev
+    } else {
+        next, _ := &cache.entries[entry.lru_next]
+        next.lru_prev = entry.lru_prev
+    }
+
+    entry.in_lru = false
+    cache.lru_count -= 1
+}
+
+@(private="file")
+lru_push_back :: proc(cache: ^GPUMeshCache, key: GPUMeshKey, entry: ^GPUMeshEntry) {
+    if cache.lru_count == 0 {
+        cache.lru_head = key
+    } else {
+        tail, _ := &cache.entries[cache.lru_tail]
+        tail.lru_next = key
+        entry.lru_prev = cache.lru_tail
+    }
+
+    cache.lru_tail = key
+    entry.in_lru = true
+    cache.lru_count += 1
+}
+
+// Build vertices from the CPU solid and upload them into a new buffer
+@(private="file")
+gpu_mesh_entry_upload :: proc(viewer: ^ViewerGPU, entry: ^GPUMeshEntry) -> bool {
+    cache := &viewer.mesh_cache
+
+    mesh := solid_to_triangle_mesh_gpu(entry.source)
+    defer triangle_mesh_gpu_destroy(&mesh)
+
+    size := u64(len(mesh.vertices) * size_of(TriangleVertex))
+    if !gpu_mesh_cache_evict_to_fit(cache, viewer.gpu_device, size) {
+        // Everything resident is in use this frame - allow the overshoot rather than drop geometry
+        fmt.printf("⚠️  GPU mesh budget exceeded (%.1f MB needed this frame)\n",
+            f64(cache.resident_bytes + size) / (1024 * 1024))
+    }
+
+    buffer := sdl.CreateGPUBuffer(viewer.gpu_device, sdl.GPUBufferCreateInfo{
+        usage = {.VERTEX},
+        size = u32(size),
+    })
+    if buffer == nil {
+        fmt.eprintln("ERROR: Failed to create cached mesh vertex buffer")
+        return false
+    }
+
+    transfer := sdl.CreateGPUTransferBuffer(viewer.gpu_device, sdl.GPUTransferBufferCreateInfo{
+        usage = .UPLOAD,
+        size = u32(size),
+    })
+    if transfer == nil {
+        fmt.eprintln("ERROR: Failed to create transfer buffer for cached mesh")
+        sdl.ReleaseGPUBuffer(viewer.gpu_device, buffer)
+        return false
+    }
+    defer sdl.ReleaseGPUTransferBuffer(viewer.gpu_device, transfer)
+
+    transfer_ptr := sdl.MapGPUTransferBuffer(viewer.gpu_device, transfer, false)
+    if transfer_ptr == nil {
+        fmt.eprintln("ERROR: Failed to map transfer buffer for cached mesh")
+        sdl.ReleaseGPUBuffer(viewer.gpu_device, buffer)
+        return false
+    }
+    copy(([^]TriangleVertex)(transfer_ptr)[:len(mesh.vertices)], mesh.vertices[:])
+    sdl.UnmapGPUTransferBuffer(viewer.gpu_device, transfer)
+
+    // Upload on its own command buffer - submitted before the frame's render pass,
+    // so GPU submission order guarantees the data is in place when it is drawn
+    upload_cmd := sdl.AcquireGPUCommandBuffer(viewer.gpu_device)
+    copy_pass := sdl.BeginGPUCopyPass(upload_cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        sdl.GPUTransferBufferLocation{transfer_buffer = transfer, offset = 0},
+        sdl.GPUBufferRegion{buffer = buffer, offset = 0, size = u32(size)},
+        false,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, int(size))
+
+    entry.buffer = buffer
+    entry.vertex_count = u32(len(mesh.vertices))
+    entry.size_bytes = size
+    cache.resident_bytes += size
+    cache.uploads += 1
+
+    return true
+}
@@ -0,0 +1,709 @@
+// ui/viewer - Two-phase hierarchical-Z occlusion culling (SDL3 GPU compute)
+// Every shaded body gets a slot with its world bounding box. Each frame:
+//   1. occlusion_begin_frame uploads the boxes and writes indirect draws for the bodies that
+//      were visible last frame (before any render pass)
+//   2. occlusion_draw(.Previous) queues them - the occluders (drawn by render_queue_flush)
+//   3. occlusion_cull builds a max-depth pyramid from that depth buffer and tests every box
+//      against it, writing indirect draws for bodies that phase 1 skipped but are visible now
+//   4. occlusion_draw(.Revealed) queues those for the main pass
+//   5. occlusion_end_frame downloads the visibility flags; they reach the CPU a frame or two
+//      later and decide which bodies are parked (not drawn at all, so their meshes age out of
+//      the GPU mesh cache first)
+// Draw/skip is decided on the GPU in the same frame, so nothing pops when the camera moves;
+// only parked bodies wait for the readback before they are drawn again.
+// Runs on Metal and on Vulkan (including lavapipe) with the SPIR-V ports of occlusion.metal.
+package ohcad_viewer
+
+import "core:fmt"
+import glsl "core:math/linalg/glsl"
+import extrude "../../features/extrude"
+import sdl "vendor:sdl3"
+
+OCCLUSION_SHADER_PATH :: "src/ui/viewer/shaders/occlusion.metallib"
+
+OCCLUSION_MAX_LEVELS :: 16       // Depth pyramid levels (level 0 = half resolution)
+OCCLUSION_READBACK_FRAMES :: 3   // Visibility downloads in flight
+OCCLUSION_PARK_FRAMES :: 60      // Readbacks in a row a body must be hidden before it is parked
+OCCLUSION_MIN_CAPACITY :: 64
+
+@(private="file") ITEM_GROUP_SIZE :: 64
+@(private="file") HIZ_GROUP_SIZE :: 8
+@(private="file") ITEM_ACTIVE :: u32(1)
+@(private="file") ITEM_NEW :: u32(2)
+@(private="file") FREE_SLOT :: min(int)
+
+// =============================================================================
+// Types
+// =============================================================================
+
+OcclusionPhase :: enum {
+    Previous,  // Bodies visible last frame (drawn before the pyramid is built)
+    Revealed,  // Bodies the pyramid test found visible that phase 1 skipped
+}
+
+// One shaded body; transform maps the mesh into world space (identity, an instance scale or a
+// moved body's placement)
+OcclusionItem :: struct {
+    owner_id: int,                  // Stable identity across frames (feature ID)
+    key: GPUMeshKey,                // Mesh cache entry to draw
+    solid: ^extrude.SimpleSolid,
+    transform: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+    color: [4]f32,
+}
+
+OcclusionStats :: struct {
+    items: int,
+    visible: int,   // As of the latest readback
+    hidden: int,
+    parked: int,    // Hidden for OCCLUSION_PARK_FRAMES readbacks - not drawn
+    levels: int,    // Depth pyramid levels
+}
+
+OcclusionCuller :: struct {
+    enabled: bool,  // Compute pipelines created and the depth format can be sampled
+
+    prepare_pipeline: ^sdl.GPUComputePipeline,
+    depth_pipeline: ^sdl.GPUComputePipeline,
+    reduce_pipeline: ^sdl.GPUComputePipeline,
+    cull_pipeline: ^sdl.GPUComputePipeline,
+    depth_sampler: ^sdl.GPUSampler,
+
+    // Per-slot GPU data (capacity slots)
+    capacity: int,
+    items_buffer: ^sdl.GPUBuffer,
+    items_transfer: ^sdl.GPUTransferBuffer,
+    visibility_buffer: ^sdl.GPUBuffer,    // 1 = visible when last tested (read by next frame's phase 1)
+    args_buffer: ^sdl.GPUBuffer,          // Indirect draws: [0, capacity) phase 1, [capacity, 2 * capacity) phase 2
+
+    // Depth pyramid, all levels packed in one buffer
+    pyramid: ^sdl.GPUBuffer,
+    pyramid_width: u32,                   // Framebuffer size it was built for
+    pyramid_height: u32,
+    levels: [OCCLUSION_MAX_LEVELS][4]u32, // offset, width, height, 0
+    level_count: int,
+
+    // CPU side of the slots
+    slots: [dynamic]OcclusionSlot,
+    slot_of: map[int]int,                 // Owner ID → slot
+    free_slots: [dynamic]int,
+    frame_slots: [dynamic]int,            // Slot of each item passed to occlusion_begin_frame
+    frame: u64,
+    culled: bool,                         // occlusion_cull recorded this frame - download pending
+
+    readbacks: [OCCLUSION_READBACK_FRAMES]OcclusionReadback,
+    readback_next: int,
+
+    stats: OcclusionStats,
+}
+
+OcclusionSlot :: struct {
+    owner_id: int,                  // FREE_SLOT when unused
+    solid: ^extrude.SimpleSolid,    // Mesh the local bounds were computed from
+    triangles: int,
+    local_min: [3]f32,
+    local_max: [3]f32,
+    center: [3]f32,                 // World bounding box center (front-to-back draw order)
+    frame: u64,                     // Last frame the owner was submitted
+    fresh: bool,                    // No visibility history on the GPU yet
+    visible: bool,                  // Latest readback
+    hidden_frames: int,             // Consecutive readbacks that found it hidden
+}
+
+OcclusionReadback :: struct {
+    transfer: ^sdl.GPUTransferBuffer,
+    size: u32,
+    fence: ^sdl.GPUFence,
+    owners: [dynamic]int,           // Slot owners when the download was recorded
+}
+
+// GPU layouts (std430 / std140) - must match occlusion.metal and the .comp ports
+@(private="file")
+OcclusionItemGPU :: struct {
+    bbox_min: [4]f32,
+    bbox_max: [4]f32,
+    vertex_count: u32,
+    flags: u32,
+    _: [2]u32,
+}
+
+@(private="file")
+PrepareParams :: struct {
+    info: [4]u32,
+}
+
+@(private="file")
+HiZParams :: struct {
+    src: [4]u32,
+    dst: [4]u32,
+}
+
+@(private="file")
+CullParams :: struct {
+    view_proj: matrix[4,4]f32,
+    viewport: [4]f32,
+    info: [4]u32,
+    levels: [OCCLUSION_MAX_LEVELS][4]u32,
+}
+
+// =============================================================================
+// Init / Destroy
+// =============================================================================
+
+// Returns false (culling disabled, everything is drawn) when the depth buffer can't be
+// sampled or the compute shaders are missing
+occlusion_init :: proc(occ: ^OcclusionCuller, device: ^sdl.GPUDevice, depth_format: sdl.GPUTextureFormat) -> bool {
+    if !sdl.GPUTextureSupportsFormat(device, depth_format, .D2, {.DEPTH_STENCIL_TARGET, .SAMPLER}) {
+        fmt.eprintln("WARNING: Depth format cannot be sampled - occlusion culling disabled")
+        return false
+    }
+
+    occ.prepare_pipeline = viewer_gpu_load_compute_pipeline(device, OCCLUSION_SHADER_PATH, "occlusion_prepare", {
+        num_readonly_storage_buffers = 2,
+        num_readwrite_storage_buffers = 1,
+        num_uniform_buffers = 1,
+        threadcount_x = ITEM_GROUP_SIZE, threadcount_y = 1, threadcount_z = 1,
+    })
+    occ.depth_pipeline = viewer_gpu_load_compute_pipeline(device, OCCLUSION_SHADER_PATH, "hiz_depth", {
+        num_samplers = 1,
+        num_readwrite_storage_buffers = 1,
+        num_uniform_buffers = 1,
+        threadcount_x = HIZ_GROUP_SIZE, threadcount_y = HIZ_GROUP_SIZE, threadcount_z = 1,
+    })
+    occ.reduce_pipeline = viewer_gpu_load_compute_pipeline(device, OCCLUSION_SHADER_PATH, "hiz_reduce", {
+        num_readwrite_storage_buffers = 1,
+        num_uniform_buffers = 1,
+        threadcount_x = HIZ_GROUP_SIZE, threadcount_y = HIZ_GROUP_SIZE, threadcount_z = 1,
+    })
+    occ.cull_pipeline = viewer_gpu_load_compute_pipeline(device, OCCLUSION_SHADER_PATH, "occlusion_cull", {
+        num_readonly_storage_buffers = 2,
+        num_readwrite_storage_buffers = 2,
+        num_uniform_buffers = 1,
+        threadcount_x = ITEM_GROUP_SIZE, threadcount_y = 1, threadcount_z = 1,
+    })
+    occ.depth_sampler = sdl.CreateGPUSampler(device, sdl.GPUSamplerCreateInfo{
+        min_filter = .NEAREST,
+        mag_filter = .NEAREST,
+        mipmap_mode = .NEAREST,
+        address_mode_u = .CLAMP_TO_EDGE,
+        address_mode_v = .CLAMP_TO_EDGE,
+        address_mode_w = .CLAMP_TO_EDGE,
+    })
+
+    if occ.prepare_pipeline == nil || occ.depth_pipeline == nil || occ.reduce_pipeline == nil ||
+       occ.cull_pipeline == nil || occ.depth_sampler == nil {
+        fmt.eprintln("WARNING: Failed to create occlusion culling pipelines:", sdl.GetError())
+        occlusion_destroy(occ, device)
+        return false
+    }
+
+    occ.slot_of = make(map[int]int)
+    occ.enabled = true
+    fmt.println("✓ GPU occlusion culling pipelines created")
+    return true
+}
+
+occlusion_destroy :: proc(occ: ^OcclusionCuller, device: ^sdl.GPUDevice) {
+    for &rb in occ.readbacks {
+        if rb.fence != nil {
+            _ = sdl.WaitForGPUFences(device, true, &rb.fence, 1)
+            sdl.ReleaseGPUFence(device, rb.fence)
+        }
+        if rb.transfer != nil do sdl.ReleaseGPUTransferBuffer(device, rb.transfer)
+        delete(rb.owners)
+    }
+
+    occlusion_release_slot_buffers(occ, device)
+    if occ.pyramid != nil do sdl.ReleaseGPUBuffer(device, occ.pyramid)
+
+    if occ.prepare_pipeline != nil do sdl.ReleaseGPUComputePipeline(device, occ.prepare_pipeline)
+    if occ.depth_pipeline != nil do sdl.ReleaseGPUComputePipeline(device, occ.depth_pipeline)
+    if occ.reduce_pipeline != nil do sdl.ReleaseGPUComputePipeline(device, occ.reduce_pipeline)
+    if occ.cull_pipeline != nil do sdl.ReleaseGPUComputePipeline(device, occ.cull_pipeline)
+    if occ.depth_sampler != nil do sdl.ReleaseGPUSampler(device, occ.depth_sampler)
+
+    delete(occ.slots)
+    delete(occ.slot_of)
+    delete(occ.free_slots)
+    delete(occ.frame_slots)
+    occ^ = {}
+}
+
+// Depth texture usage for passes whose depth is culled against
+occlusion_depth_usage :: proc(viewer: ^ViewerGPU) -> sdl.GPUTextureUsageFlags {
+    if viewer.occlusion.enabled {
+        return {.DEPTH_STENCIL_TARGET, .SAMPLER}
+    }
+    return {.DEPTH_STENCIL_TARGET}
+}
+
+// =============================================================================
+// Per-Frame Pipeline
+// =============================================================================
+
+// Upload this frame's bodies and write the phase-1 draws; record before any render pass.
+// Returns false when culling is unavailable - draw everything the usual way instead.
+occlusion_begin_frame :: proc(viewer: ^ViewerGPU, cmd: ^sdl.GPUCommandBuffer, items: []OcclusionItem) -> bool {
+    occ := &viewer.occlusion
+    if !occ.enabled {
+        return false
+    }
+
+    occ.frame += 1
+    occ.culled = false
+    clear(&occ.frame_slots)
+
+    for item in items {
+        slot_index, found := occ.slot_of[item.owner_id]
+        if !found {
+            slot_index = occlusion_slot_alloc(occ, item.owner_id)
+        }
+        slot := &occ.slots[slot_index]
+        slot.frame = occ.frame
+
+        if slot.solid != item.solid || slot.triangles != len(item.solid.triangles) {
+            slot.solid = item.solid
+            slot.triangles = len(item.solid.triangles)
+            slot.local_min, slot.local_max = solid_local_bounds(item.solid)
+        }
+        append(&occ.frame_slots, slot_index)
+    }
+
+    // Owners not submitted this frame give their slot up
+    for &slot, i in occ.slots {
+        if slot.owner_id == FREE_SLOT || slot.frame == occ.frame do continue
+        delete_key(&occ.slot_of, slot.owner_id)
+        slot = OcclusionSlot{owner_id = FREE_SLOT}
+        append(&occ.free_slots, i)
+    }
+
+    if len(occ.slots) > occ.capacity && !occlusion_grow(occ, viewer.gpu_device, len(occ.slots)) {
+        return false
+    }
+
+    // Boxes → transfer buffer
+    count := len(occ.slots)
+    mapped := sdl.MapGPUTransferBuffer(viewer.gpu_device, occ.items_transfer, true)
+    if mapped == nil {
+        fmt.eprintln("ERROR: Failed to map occlusion item buffer:", sdl.GetError())
+        return false
+    }
+    gpu_items := ([^]OcclusionItemGPU)(mapped)[:count]
+    for &gpu_item in gpu_items {
+        gpu_item = {}
+    }
+    for item, i in items {
+        slot_index := occ.frame_slots[i]
+        slot := &occ.slots[slot_index]
+        bbox_min, bbox_max := transform_bounds(slot.local_min, slot.local_max, item.transform)
+        slot.center = (bbox_min + bbox_max) * 0.5
+        gpu_items[slot_index] = OcclusionItemGPU{
+            bbox_min = {bbox_min.x, bbox_min.y, bbox_min.z, 0},
+            bbox_max = {bbox_max.x, bbox_max.y, bbox_max.z, 0},
+            vertex_count = u32(slot.triangles * 3),
+            flags = ITEM_ACTIVE | (slot.fresh ? ITEM_NEW : 0),
+        }
+        slot.fresh = false
+    }
+    sdl.UnmapGPUTransferBuffer(viewer.gpu_device, occ.items_transfer)
+
+    copy_pass := sdl.BeginGPUCopyPass(cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        sdl.GPUTransferBufferLocation{transfer_buffer = occ.items_transfer},
+        sdl.GPUBufferRegion{buffer = occ.items_buffer, size = u32(count * size_of(OcclusionItemGPU))},
+        true,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    frame_profiler_count_upload(&viewer.profiler, count * size_of(OcclusionItemGPU))
+
+    // Phase-1 draws from last frame's visibility
+    args_binding := sdl.GPUStorageBufferReadWriteBinding{buffer = occ.args_buffer}
+    pass := sdl.BeginGPUComputePass(cmd, nil, 0, &args_binding, 1)
+    sdl.BindGPUComputePipeline(pass, occ.prepare_pipeline)
+    readonly := [2]^sdl.GPUBuffer{occ.items_buffer, occ.visibility_buffer}
+    sdl.BindGPUComputeStorageBuffers(pass, 0, &readonly[0], 2)
+    params := PrepareParams{info = {u32(count), 0, 0, 0}}
+    sdl.PushGPUComputeUniformData(cmd, 0, &params, size_of(PrepareParams))
+    sdl.DispatchGPUCompute(pass, group_count(count, ITEM_GROUP_SIZE), 1, 1)
+    sdl.EndGPUComputePass(pass)
+
+    occ.stats.items = len(items)
+    return true
+}
+
+// Queue one phase of the items passed to occlusion_begin_frame (same slice, same order);
+// draw them with render_queue_flush in that phase's render pass
+occlusion_draw :: proc(
+    viewer: ^ViewerGPU,
+    items: []OcclusionItem,
+    phase: OcclusionPhase,
+    mvp: matrix[4,4]f32,
+) {
+    occ := &viewer.occlusion
+    if viewer.shaded_pipeline == nil || len(items) != len(occ.frame_slots) {
+        return
+    }
+
+    base := phase == .Previous ? 0 : occ.capacity
+    eye := [3]f32{f32(viewer.camera.position.x), f32(viewer.camera.position.y), f32(viewer.camera.position.z)}
+    for item, i in items {
+        slot_index := occ.frame_slots[i]
+        slot := &occ.slots[slot_index]
+
+        // Parked: skip the draw and leave the mesh untouched so the cache can evict it
+        if slot.hidden_frames >= OCCLUSION_PARK_FRAMES do continue
+
+        buffer, vertex_count, ok := gpu_mesh_cache_acquire(viewer, item.key, item.solid)
+        if !ok do continue
+
+        // The GPU decides; the profiler counts what the latest readback expects to be drawn
+        expected := slot.visible == (phase == .Previous)
+        offset := u32((base + slot_index) * size_of(sdl.GPUIndirectDrawCommand))
+        render_queue_submit_shaded_indirect(
+            viewer, buffer, occ.args_buffer, offset,
+            item.color, mvp * item.transform, item.normal_matrix,
+            expected ? int(vertex_count) / 3 : 0,
+            depth = f32(glsl.length(slot.center - eye)),
+        )
+    }
+}
+
+// Build the depth pyramid from the phase-1 depth buffer and cull every item against it.
+// Record after the phase-1 render pass has ended and before the phase-2 pass begins.
+occlusion_cull :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    depth: ^sdl.GPUTexture,
+    width, height: u32,
+    view_proj: matrix[4,4]f32,
+) -> bool {
+    occ := &viewer.occlusion
+    if !occ.enabled || !occlusion_ensure_pyramid(occ, viewer.gpu_device, width, height) {
+        return false
+    }
+
+    pyramid_binding := sdl.GPUStorageBufferReadWriteBinding{buffer = occ.pyramid}
+
+    // Level 0 from the depth buffer
+    {
+        pass := sdl.BeginGPUComputePass(cmd, nil, 0, &pyramid_binding, 1)
+        sdl.BindGPUComputePipeline(pass, occ.depth_pipeline)
+        sampler_binding := sdl.GPUTextureSamplerBinding{texture = depth, sampler = occ.depth_sampler}
+        sdl.BindGPUComputeSamplers(pass, 0, &sampler_binding, 1)
+        params := HiZParams{src = {0, width, height, 0}, dst = occ.levels[0]}
+        sdl.PushGPUComputeUniformData(cmd, 0, &params, size_of(HiZParams))
+        sdl.DispatchGPUCompute(pass, group_count(int(params.dst[1]), HIZ_GROUP_SIZE), group_count(int(params.dst[2]), HIZ_GROUP_SIZE), 1)
+        sdl.EndGPUComputePass(pass)
+    }
+
+    // One pass per level: each reads the level the previous pass wrote
+    for level in 1..<occ.level_count {
+        pass := sdl.BeginGPUComputePass(cmd, nil, 0, &pyramid_binding, 1)
+        sdl.BindGPUComputePipeline(pass, occ.reduce_pipeline)
+        params := HiZParams{src = occ.levels[level - 1], dst = occ.levels[level]}
+        sdl.PushGPUComputeUniformData(cmd, 0, &params, size_of(HiZParams))
+        sdl.DispatchGPUCompute(pass, group_count(int(params.dst[1]), HIZ_GROUP_SIZE), group_count(int(params.dst[2]), HIZ_GROUP_SIZE), 1)
+        sdl.EndGPUComputePass(pass)
+    }
+
+    // Box tests → phase-2 draws + visibility
+    count := len(occ.slots)
+    bindings := [2]sdl.GPUStorageBufferReadWriteBinding{{buffer = occ.args_buffer}, {buffer = occ.visibility_buffer}}
+    pass := sdl.BeginGPUComputePass(cmd, nil, 0, &bindings[0], 2)
+    sdl.BindGPUComputePipeline(pass, occ.cull_pipeline)
+    readonly := [2]^sdl.GPUBuffer{occ.items_buffer, occ.pyramid}
+    sdl.BindGPUComputeStorageBuffers(pass, 0, &readonly[0], 2)
+    params := CullParams{
+        view_proj = view_proj,
+        viewport = {f32(width), f32(height), 0, 0},
+        info = {u32(count), u32(occ.level_count), u32(occ.capacity), 0},
+        levels = occ.levels,
+    }
+    sdl.PushGPUComputeUniformData(cmd, 0, &params, size_of(CullParams))
+    sdl.DispatchGPUCompute(pass, group_count(count, ITEM_GROUP_SIZE), 1, 1)
+    sdl.EndGPUComputePass(pass)
+
+    occ.culled = true
+    occ.stats.levels = occ.level_count
+    return true
+}
+
+// After the frame's command buffer is submitted: download this frame's visibility and
+// apply any downloads that have finished
+occlusion_end_frame :: proc(viewer: ^ViewerGPU) {
+    occ := &viewer.occlusion
+    if !occ.enabled {
+        return
+    }
+
+    if occ.culled {
+        occ.culled = false
+        rb := &occ.readbacks[occ.readback_next]
+        if rb.fence != nil {
+            occlusion_apply_readback(viewer, rb, true)
+        }
+
+        size := u32(len(occ.slots) * size_of(u32))
+        if rb.size < size {
+            if rb.transfer != nil do sdl.ReleaseGPUTransferBuffer(viewer.gpu_device, rb.transfer)
+            rb.size = u32(occ.capacity * size_of(u32))
+            rb.transfer = sdl.CreateGPUTransferBuffer(viewer.gpu_device, sdl.GPUTransferBufferCreateInfo{
+                usage = .DOWNLOAD,
+                size = rb.size,
+            })
+        }
+
+        // Own command buffer after the frame's: queue order means the fence covers the cull
+        cmd := rb.transfer != nil && size > 0 ? sdl.AcquireGPUCommandBuffer(viewer.gpu_device) : nil
+        if cmd != nil {
+            copy_pass := sdl.BeginGPUCopyPass(cmd)
+            sdl.DownloadFromGPUBuffer(
+                copy_pass,
+                sdl.GPUBufferRegion{buffer = occ.visibility_buffer, size = size},
+                sdl.GPUTransferBufferLocation{transfer_buffer = rb.transfer},
+            )
+            sdl.EndGPUCopyPass(copy_pass)
+            rb.fence = sdl.SubmitGPUCommandBufferAndAcquireFence(cmd)
+
+            clear(&rb.owners)
+            for slot in occ.slots {
+                append(&rb.owners, slot.owner_id)
+            }
+            occ.readback_next = (occ.readback_next + 1) % OCCLUSION_READBACK_FRAMES
+        }
+    }
+
+    occlusion_collect(viewer, false)
+}
+
+// Apply finished visibility downloads, oldest first (wait = block until all are done)
+occlusion_collect :: proc(viewer: ^ViewerGPU, wait: bool) {
+    occ := &viewer.occlusion
+    for i in 0..<OCCLUSION_READBACK_FRAMES {
+        rb := &occ.readbacks[(occ.readback_next + i) % OCCLUSION_READBACK_FRAMES]
+        if rb.fence != nil {
+            occlusion_apply_readback(viewer, rb, wait)
+        }
+    }
+
+    occ.stats.visible, occ.stats.hidden, occ.stats.parked = 0, 0, 0
+    for slot in occ.slots {
+        if slot.owner_id == FREE_SLOT do continue
+        if slot.visible {
+            occ.stats.visible += 1
+        } else {
+            occ.stats.hidden += 1
+        }
+        if slot.hidden_frames >= OCCLUSION_PARK_FRAMES do occ.stats.parked += 1
+    }
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// Consecutive readbacks that found the owner hidden (0 = visible or not tested yet)
+occlusion_hidden_frames :: proc(viewer: ^ViewerGPU, owner_id: int) -> int {
+    occ := &viewer.occlusion
+    if slot_index, found := occ.slot_of[owner_id]; found {
+        return occ.slots[slot_index].hidden_frames
+    }
+    return 0
+}
+
+occlusion_print_stats :: proc(viewer: ^ViewerGPU) {
+    occ := &viewer.occlusion
+    if !occ.enabled {
+        fmt.println("🫥 Occlusion culling unavailable")
+        return
+    }
+    s := occ.stats
+    fmt.printf("🫥 Occlusion: %d bodies, %d visible, %d hidden (%d parked), %d pyramid levels (%dx%d)\n",
+        s.items, s.visible, s.hidden, s.parked, s.levels, occ.pyramid_width, occ.pyramid_height)
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+@(private="file")
+occlusion_slot_alloc :: proc(occ: ^OcclusionCuller, owner_id: int) -> int {
+    index: int
+    if len(occ.free_slots) > 0 {
+        index = pop(&occ.free_slots)
+    } else {
+        index = len(occ.slots)
+        append(&occ.slots, OcclusionSlot{})
+    }
+
+    // Unknown bodies count as visible until the GPU has tested them
+    occ.slots[index] = OcclusionSlot{owner_id = owner_id, fresh = true, visible = true}
+    occ.slot_of[owner_id] = index
+    return index
+}
+
+// Reallocate the per-slot buffers; visibility history is lost, so every slot starts fresh
+@(private="file")
+occlusion_grow :: proc(occ: ^OcclusionCuller, device: ^sdl.GPUDevice, needed: int) -> bool {
+    capacity := max(occ.capacity, OCCLUSION_MIN_CAPACITY)
+    for capacity < needed {
+        capacity *= 2
+    }
+
+    occlusion_release_slot_buffers(occ, device)
+
+    occ.items_buffer = sdl.CreateGPUBuffer(device, sdl.GPUBufferCreateInfo{
+        usage = {.COMPUTE_STORAGE_READ},
+        size = u32(capacity * size_of(OcclusionItemGPU)),
+    })
+    occ.items_transfer = sdl.CreateGPUTransferBuffer(device, sdl.GPUTransferBufferCreateInfo{
+        usage = .UPLOAD,
+        size = u32(capacity * size_of(OcclusionItemGPU)),
+    })
+    occ.visibility_buffer = sdl.CreateGPUBuffer(device, sdl.GPUBufferCreateInfo{
+        usage = {.COMPUTE_STORAGE_READ, .COMPUTE_STORAGE_WRITE},
+        size = u32(capacity * size_of(u32)),
+    })
+    occ.args_buffer = sdl.CreateGPUBuffer(device, sdl.GPUBufferCreateInfo{
+        usage = {.INDIRECT, .COMPUTE_STORAGE_WRITE},
+        size = u32(2 * capacity * size_of(sdl.GPUIndirectDrawCommand)),
+    })
+
+    if occ.items_buffer == nil || occ.items_transfer == nil || occ.visibility_buffer == nil || occ.args_buffer == nil {
+        fmt.eprintln("ERROR: Failed to create occlusion buffers:", sdl.GetError())
+        occlusion_release_slot_buffers(occ, device)
+        return false
+    }
+
+    occ.capacity = capacity
+    for &slot in occ.slots {
+        slot.fresh = true
+    }
+    return true
+}
+
+@(private="file")
+occlusion_release_slot_buffers :: proc(occ: ^OcclusionCuller, device: ^sdl.GPUDevice) {
+    if occ.items_buffer != nil do sdl.ReleaseGPUBuffer(device, occ.items_buffer)
+    if occ.items_transfer != nil do sdl.ReleaseGPUTransferBuffer(device, occ.items_transfer)
+    if occ.visibility_buffer != nil do sdl.ReleaseGPUBuffer(device, occ.visibility_buffer)
+    if occ.args_buffer != nil do sdl.ReleaseGPUBuffer(device, occ.args_buffer)
+    occ.items_buffer, occ.items_transfer, occ.visibility_buffer, occ.args_buffer = nil, nil, nil, nil
+    occ.capacity = 0
+}
+
+// (Re)build the level layout when the framebuffer size changes
+@(private="file")
+occlusion_ensure_pyramid :: proc(occ: ^OcclusionCuller, device: ^sdl.GPUDevice, width, height: u32) -> bool {
+    if occ.pyramid != nil && occ.pyramid_width == width && occ.pyramid_height == height {
+        return true
+    }
+    if width < 2 || height < 2 {
+        return false
+    }
+
+    if occ.pyramid != nil {
+        sdl.ReleaseGPUBuffer(device, occ.pyramid)
+        occ.pyramid = nil
+    }
+
+    // Level 0 is half resolution; each level halves (rounding up) down to 1x1
+    w, h := (width + 1) / 2, (height + 1) / 2
+    offset: u32 = 0
+    occ.level_count = 0
+    for occ.level_count < OCCLUSION_MAX_LEVELS {
+        occ.levels[occ.level_count] = {offset, w, h, 0}
+        occ.level_count += 1
+        offset += w * h
+        if w == 1 && h == 1 do break
+        w, h = max((w + 1) / 2, 1), max((h + 1) / 2, 1)
+    }
+
+    occ.pyramid = sdl.CreateGPUBuffer(device, sdl.GPUBufferCreateInfo{
+        usage = {.COMPUTE_STORAGE_READ, .COMPUTE_STORAGE_WRITE},
+        size = offset * size_of(f32),
+    })
+    if occ.pyramid == nil {
+        fmt.eprintln("ERROR: Failed to create depth pyramid:", sdl.GetError())
+        return false
+    }
+
+    occ.pyramid_width, occ.pyramid_height = width, height
+    return true
+}
+
+// Copy one finished download into the slots (wait = block on its fence)
+@(private="file")
+occlusion_apply_readback :: proc(viewer: ^ViewerGPU, rb: ^OcclusionReadback, wait: bool) {
+    occ := &viewer.occlusion
+    device := viewer.gpu_device
+
+    done := wait ? sdl.WaitForGPUFences(device, true, &rb.fence, 1) : sdl.QueryGPUFence(device, rb.fence)
+    if !done {
+        return
+    }
+    sdl.ReleaseGPUFence(device, rb.fence)
+    rb.fence = nil
+
+    mapped := sdl.MapGPUTransferBuffer(device, rb.transfer, false)
+    if mapped == nil {
+        return
+    }
+    defer sdl.UnmapGPUTransferBuffer(device, rb.transfer)
+
+    flags := ([^]u32)(mapped)[:len(rb.owners)]
+    for owner, i in rb.owners {
+        // Skip slots that changed hands since the download was recorded
+        if owner == FREE_SLOT || i >= len(occ.slots) || occ.slots[i].owner_id != owner do continue
+
+        slot := &occ.slots[i]
+        slot.visible = flags[i] != 0
+        slot.hidden_frames = slot.visible ? 0 : slot.hidden_frames + 1
+    }
+}
+
+@(private="file")
+solid_local_bounds :: proc(solid: ^extrude.SimpleSolid) -> (bbox_min, bbox_max: [3]f32) {
+    if len(solid.triangles) == 0 {
+        return
+    }
+
+    first := solid.triangles[0].v0
+    bbox_min = {f32(first.x), f32(first.y), f32(first.z)}
+    bbox_max = bbox_min
+    for tri in solid.triangles {
+        for v in ([3][3]f64{tri.v0, tri.v1, tri.v2}) {
+            p := [3]f32{f32(v.x), f32(v.y), f32(v.z)}
+            bbox_min = {min(bbox_min.x, p.x), min(bbox_min.y, p.y), min(bbox_min.z, p.z)}
+            bbox_max = {max(bbox_max.x, p.x), max(bbox_max.y, p.y), max(bbox_max.z, p.z)}
+        }
+    }
+    return
+}
+
+// World box of an affinely transformed local box (all 8 corners)
+@(private="file")
+transform_bounds :: proc(local_min, local_max: [3]f32, transform: matrix[4,4]f32) -> (bbox_min, bbox_max: [3]f32) {
+    for c in 0..<8 {
+        corner := [4]f32{
+            c & 1 != 0 ? local_max.x : local_min.x,
+            c & 2 != 0 ? local_max.y : local_min.y,
+            c & 4 != 0 ? local_max.z : local_min.z,
+            1,
+        }
+        p := (transform * corner).xyz
+        if c == 0 {
+            bbox_min, bbox_max = p, p
+            continue
+        }
+        bbox_min = {min(bbox_min.x, p.x), min(bbox_min.y, p.y), min(bbox_min.z, p.z)}
+        bbox_max = {max(bbox_max.x, p.x), max(bbox_max.y, p.y), max(bbox_max.z, p.z)}
+    }
+    return
+}
+
+@(private="file")
+group_count :: #force_inline proc(n, group_size: int) -> u32 {
+    return u32(max((n + group_size - 1) / group_size, 1))
+}
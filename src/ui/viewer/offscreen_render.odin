@@ -0,0 +1,382 @@
+// ui/viewer - Offscreen rendering for thumbnails and multi-view contact sheets (SDL3 GPU)
+// Draws with the same shaded and wireframe pipelines as the window, but into an RGBA8 texture
+// that is read back for PNG output. Works on a headless viewer (HEADLESS_GPU_CONFIG, no window)
+// with any backend, including Vulkan on lavapipe. Shaded meshes come from the viewer's GPU mesh
+// cache, so every view of a document uploads its meshes once.
+package ohcad_viewer
+
+import "core:fmt"
+import "core:math"
+import "core:strings"
+import m "../../core/math"
+import extrude "../../features/extrude"
+import glsl "core:math/linalg/glsl"
+import sdl "vendor:sdl3"
+import stbi "vendor:stb/image"
+
+// Color format of offscreen targets (and of every pipeline on a headless viewer)
+OFFSCREEN_COLOR_FORMAT :: sdl.GPUTextureFormat.R8G8B8A8_UNORM
+
+// =============================================================================
+// Types
+// =============================================================================
+
+// Render target + readback buffer, reusable across renders of the same size
+OffscreenTarget :: struct {
+    color: ^sdl.GPUTexture,
+    depth: ^sdl.GPUTexture,
+    readback: ^sdl.GPUTransferBuffer,  // Color pixels are copied here after each render
+    width: u32,
+    height: u32,
+    fence: ^sdl.GPUFence,              // Submitted render not yet read back (nil = idle)
+}
+
+// Standard view directions for previews
+PreviewView :: enum {
+    Iso,
+    Front,   // Looking down -Z (sketch XY plane face-on)
+    Top,     // Looking down -Y
+    Right,   // Looking down -X
+    Back,
+    Left,
+    Bottom,
+}
+
+// One body in an offscreen scene
+OffscreenItem :: struct {
+    key: GPUMeshKey,               // Mesh cache key (reused across views and renders)
+    solid: ^extrude.SimpleSolid,   // Shaded body (nil = edges only, e.g. a bare sketch)
+    edges: ^WireframeMeshGPU,      // Edge overlay (nil = none)
+}
+
+OffscreenStyle :: struct {
+    mode: RenderMode,              // Wireframe = edges only; Shaded/Both = lit body + edge overlay
+    background: [4]f32,
+    body_color: [4]f32,
+    edge_color: [4]f32,
+    edge_thickness: f32,           // Pixels
+    margin: f32,                   // Padding around the bounding sphere (fraction of its diameter)
+}
+
+// Matches the interactive viewer's shaded look
+DEFAULT_OFFSCREEN_STYLE :: OffscreenStyle{
+    mode = .Shaded,
+    background = {0.08, 0.08, 0.08, 1.0},
+    body_color = {0.45, 0.45, 0.45, 1.0},
+    edge_color = {0.2, 0.2, 0.2, 1.0},
+    edge_thickness = 1.5,
+    margin = 0.1,
+}
+
+// =============================================================================
+// Targets
+// =============================================================================
+
+offscreen_target_create :: proc(viewer: ^ViewerGPU, width, height: u32) -> (OffscreenTarget, bool) {
+    target := OffscreenTarget{width = width, height = height}
+
+    target.color = sdl.CreateGPUTexture(viewer.gpu_device, sdl.GPUTextureCreateInfo{
+        type = .D2,
+        format = viewer.color_format,
+        usage = {.COLOR_TARGET},
+        width = width,
+        height = height,
+        layer_count_or_depth = 1,
+        num_levels = 1,
+    })
+    if target.color == nil {
+        fmt.eprintln("ERROR: Failed to create offscreen color texture:", sdl.GetError())
+        return target, false
+    }
+
+    target.depth = sdl.CreateGPUTexture(viewer.gpu_device, sdl.GPUTextureCreateInfo{
+        type = .D2,
+        format = viewer.depth_format,
+        usage = {.DEPTH_STENCIL_TARGET},
+        width = width,
+        height = height,
+        layer_count_or_depth = 1,
+        num_levels = 1,
+    })
+    if target.depth == nil {
+        fmt.eprintln("ERROR: Failed to create offscreen depth texture:", sdl.GetError())
+        offscreen_target_destroy(viewer, &target)
+        return target, false
+    }
+
+    target.readback = sdl.CreateGPUTransferBuffer(viewer.gpu_device, sdl.GPUTransferBufferCreateInfo{
+        usage = .DOWNLOAD,
+        size = width * height * 4,
+    })
+    if target.readback == nil {
+        fmt.eprintln("ERROR: Failed to create offscreen readback buffer:", sdl.GetError())
+        offscreen_target_destroy(viewer, &target)
+        return target, false
+    }
+
+    return target, true
+}
+
+offscreen_target_destroy :: proc(viewer: ^ViewerGPU, target: ^OffscreenTarget) {
+    if target.fence != nil {
+        _ = sdl.WaitForGPUFences(viewer.gpu_device, true, &target.fence, 1)
+        sdl.ReleaseGPUFence(viewer.gpu_device, target.fence)
+    }
+    if target.readback != nil {
+        sdl.ReleaseGPUTransferBuffer(viewer.gpu_device, target.readback)
+    }
+    if target.depth != nil {
+        sdl.ReleaseGPUTexture(viewer.gpu_device, target.depth)
+    }
+    if target.color != nil {
+        sdl.ReleaseGPUTexture(viewer.gpu_device, target.color)
+    }
+    target^ = {}
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+// Record and submit a render of items into target without waiting for it
+// One view fills the target (thumbnail); several are tiled in a grid (contact sheet,
+// columns = 0 picks a near-square layout). Collect the pixels with offscreen_target_read.
+offscreen_render_submit :: proc(
+    viewer: ^ViewerGPU,
+    target: ^OffscreenTarget,
+    items: []OffscreenItem,
+    views: []PreviewView,
+    columns: int = 0,
+    style: OffscreenStyle = DEFAULT_OFFSCREEN_STYLE,
+) -> bool {
+    if target.fence != nil {
+        fmt.eprintln("ERROR: Offscreen target still has an unread render")
+        return false
+    }
+    if len(views) == 0 {
+        return false
+    }
+
+    cols := columns > 0 ? columns : int(math.ceil(math.sqrt(f64(len(views)))))
+    cols = min(cols, len(views))
+    rows := (len(views) + cols - 1) / cols
+    tile_w := target.width / u32(cols)
+    tile_h := target.height / u32(rows)
+    if tile_w == 0 || tile_h == 0 {
+        fmt.eprintln("ERROR: Offscreen target too small for", len(views), "views")
+        return false
+    }
+
+    cmd := sdl.AcquireGPUCommandBuffer(viewer.gpu_device)
+    if cmd == nil {
+        fmt.eprintln("ERROR: Failed to acquire command buffer:", sdl.GetError())
+        return false
+    }
+
+    // Every view in this render counts as one cache frame, so none of its meshes is evicted mid-sheet
+    gpu_mesh_cache_begin_frame(&viewer.mesh_cache)
+
+    bbox_min, bbox_max := offscreen_scene_bounds(items)
+
+    color_target := sdl.GPUColorTargetInfo{
+        texture = target.color,
+        load_op = .CLEAR,
+        store_op = .STORE,
+        clear_color = {style.background.r, style.background.g, style.background.b, style.background.a},
+    }
+    depth_target := sdl.GPUDepthStencilTargetInfo{
+        texture = target.depth,
+        load_op = .CLEAR,
+        store_op = .DONT_CARE,
+        clear_depth = 1.0,
+        cycle = true,
+    }
+
+    pass := sdl.BeginGPURenderPass(cmd, &color_target, 1, &depth_target)
+
+    // Drawing helpers read the camera and viewport size from the viewer (pixel-sized edges)
+    saved_camera := viewer.camera
+    saved_width, saved_height := viewer.window_width, viewer.window_height
+    defer {
+        viewer.camera = saved_camera
+        viewer.window_width = saved_width
+        viewer.window_height = saved_height
+    }
+
+    for view, i in views {
+        x := u32(i % cols) * tile_w
+        y := u32(i / cols) * tile_h
+
+        sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
+        sdl.SetGPUViewport(pass, sdl.GPUViewport{
+            x = f32(x), y = f32(y), w = f32(tile_w), h = f32(tile_h),
+            min_depth = 0.0, max_depth = 1.0,
+        })
+        sdl.SetGPUScissor(pass, sdl.Rect{x = i32(x), y = i32(y), w = i32(tile_w), h = i32(tile_h)})
+
+        viewer.window_width = tile_w
+        viewer.window_height = tile_h
+        viewer.camera = preview_camera(view, bbox_min, bbox_max, f32(tile_w) / f32(tile_h), style.margin)
+        mvp := camera_get_projection_matrix(&viewer.camera) * camera_get_view_matrix(&viewer.camera)
+
+        // One sorted flush per view (the viewport changes between views)
+        if style.mode != .Wireframe {
+            for &item in items {
+                if item.solid == nil do continue
+                render_queue_submit_cached_mesh(viewer, item.key, item.solid, style.body_color, mvp, 1)
+            }
+        }
+
+        for &item in items {
+            if item.edges == nil do continue
+            render_queue_submit_wireframe(viewer, item.edges, style.edge_color, mvp, style.edge_thickness)
+        }
+        render_queue_flush(viewer, cmd, pass)
+    }
+
+    sdl.EndGPURenderPass(pass)
+
+    // Copy the finished image into the readback buffer on the same command buffer
+    copy_pass := sdl.BeginGPUCopyPass(cmd)
+    sdl.DownloadFromGPUTexture(
+        copy_pass,
+        sdl.GPUTextureRegion{texture = target.color, w = target.width, h = target.height, d = 1},
+        sdl.GPUTextureTransferInfo{transfer_buffer = target.readback, offset = 0},
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+
+    target.fence = sdl.SubmitGPUCommandBufferAndAcquireFence(cmd)
+    if target.fence == nil {
+        fmt.eprintln("ERROR: Failed to submit offscreen render:", sdl.GetError())
+        return false
+    }
+
+    return true
+}
+
+// Wait for the submitted render and copy out its pixels (RGBA8, tightly packed, top row first)
+offscreen_target_read :: proc(
+    viewer: ^ViewerGPU,
+    target: ^OffscreenTarget,
+    allocator := context.allocator,
+) -> (pixels: []u8, ok: bool) {
+    if target.fence == nil {
+        fmt.eprintln("ERROR: Offscreen target has no submitted render")
+        return nil, false
+    }
+
+    waited := sdl.WaitForGPUFences(viewer.gpu_device, true, &target.fence, 1)
+    sdl.ReleaseGPUFence(viewer.gpu_device, target.fence)
+    target.fence = nil
+    if !waited {
+        fmt.eprintln("ERROR: Offscreen render did not complete:", sdl.GetError())
+        return nil, false
+    }
+
+    mapped := sdl.MapGPUTransferBuffer(viewer.gpu_device, target.readback, false)
+    if mapped == nil {
+        fmt.eprintln("ERROR: Failed to map offscreen readback buffer:", sdl.GetError())
+        return nil, false
+    }
+    defer sdl.UnmapGPUTransferBuffer(viewer.gpu_device, target.readback)
+
+    size := int(target.width * target.height * 4)
+    pixels = make([]u8, size, allocator)
+    copy(pixels, ([^]u8)(mapped)[:size])
+    return pixels, true
+}
+
+// Write RGBA8 pixels as a PNG (safe to call from worker threads)
+offscreen_write_png :: proc(path: string, pixels: []u8, width, height: u32) -> bool {
+    if len(pixels) < int(width * height * 4) {
+        return false
+    }
+
+    cpath := strings.clone_to_cstring(path, context.temp_allocator)
+    if stbi.write_png(cpath, i32(width), i32(height), 4, raw_data(pixels), i32(width * 4)) == 0 {
+        fmt.eprintln("ERROR: Failed to write PNG:", path)
+        return false
+    }
+    return true
+}
+
+// =============================================================================
+// Cameras
+// =============================================================================
+
+// Orthographic camera looking at the box from a standard direction, framed to fit it
+preview_camera :: proc(view: PreviewView, bbox_min, bbox_max: m.Vec3, aspect: f32, margin: f32 = 0.1) -> Camera {
+    camera: Camera
+    camera_init(&camera, aspect)
+
+    // Just short of straight up/down so the Y-up look-at basis stays defined
+    POLE :: math.PI * 0.5 - 1e-3
+
+    switch view {
+    case .Iso:    camera.azimuth, camera.elevation = math.PI * 0.25, math.PI * 0.25
+    case .Front:  camera.azimuth, camera.elevation = math.PI * 0.5, 0
+    case .Back:   camera.azimuth, camera.elevation = -math.PI * 0.5, 0
+    case .Right:  camera.azimuth, camera.elevation = 0, 0
+    case .Left:   camera.azimuth, camera.elevation = math.PI, 0
+    case .Top:    camera.azimuth, camera.elevation = math.PI * 0.5, POLE
+    case .Bottom: camera.azimuth, camera.elevation = math.PI * 0.5, -POLE
+    }
+
+    // Frame the bounding sphere: fits every view direction with the same scale
+    radius := f32(glsl.length(bbox_max - bbox_min) * 0.5)
+    radius = max(radius, 1e-3)
+    camera.target = (bbox_min + bbox_max) * 0.5
+    camera.distance = radius * 3
+    camera.near_plane = radius * 0.5
+    camera.far_plane = radius * 6
+    camera.projection_mode = .Orthographic
+    camera.ortho_width = 2 * radius * (1 + margin) * max(aspect, 1)
+    camera_update_position(&camera)
+
+    return camera
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+// Bounds of everything drawn (solids and edges); a 100 mm box around the origin for empty scenes
+@(private="file")
+offscreen_scene_bounds :: proc(items: []OffscreenItem) -> (bbox_min, bbox_max: m.Vec3) {
+    bbox_min = {math.F64_MAX, math.F64_MAX, math.F64_MAX}
+    bbox_max = {-math.F64_MAX, -math.F64_MAX, -math.F64_MAX}
+    found := false
+
+    grow :: proc(bbox_min, bbox_max: ^m.Vec3, p: m.Vec3) {
+        bbox_min^ = {min(bbox_min.x, p.x), min(bbox_min.y, p.y), min(bbox_min.z, p.z)}
+        bbox_max^ = {max(bbox_max.x, p.x), max(bbox_max.y, p.y), max(bbox_max.z, p.z)}
+    }
+
+    for item in items {
+        if item.solid != nil {
+            for v in item.solid.vertices {
+                grow(&bbox_min, &bbox_max, v.position)
+                found = true
+            }
+            for tri in item.solid.triangles {
+                grow(&bbox_min, &bbox_max, tri.v0)
+                grow(&bbox_min, &bbox_max, tri.v1)
+                grow(&bbox_min, &bbox_max, tri.v2)
+                found = true
+            }
+        }
+        if item.edges != nil {
+            for edge in item.edges.edges {
+                for p in edge {
+                    grow(&bbox_min, &bbox_max, m.Vec3{f64(p.x), f64(p.y), f64(p.z)})
+                    found = true
+                }
+            }
+        }
+    }
+
+    if !found {
+        return {-50, -50, -50}, {50, 50, 50}
+    }
+    return
+}
@@ -0,0 +1,391 @@
+// ui/viewer - Instanced point sprites for sketch points and handles (SDL3 GPU)
+// All points of a frame are collected into one instance buffer and drawn with a
+// single instanced call; shapes are produced by an SDF fragment shader.
+package ohcad_viewer
+
+import "core:fmt"
+import "core:os"
+import m "../../core/math"
+import sketch "../../features/sketch"
+import sdl "vendor:sdl3"
+
+POINT_SPRITE_SHADER_PATH :: "src/ui/viewer/shaders/point_sprite_shader.metallib"
+
+// Initial instance capacity (buffers grow by doubling)
+POINT_SPRITE_INITIAL_CAPACITY :: 1024
+
+// =============================================================================
+// Types
+// =============================================================================
+
+// Point shape (must match POINT_STYLE_* in point_sprite_shader.metal)
+PointStyle :: enum u32 {
+    Circle = 0,  // Filled dot - regular sketch points
+    Square = 1,  // Filled square - circle centers
+    Ring   = 2,  // Hollow ring - drag handles
+}
+
+// Per-instance data (matches PointSpriteIn attributes 1-4)
+PointInstance :: struct {
+    position: [3]f32,  // World-space position
+    radius: f32,       // Radius in pixels
+    color: [4]f32,
+    style: PointStyle,
+    _pad: [3]u32,
+}
+
+// Uniform buffer structure (matches PointSpriteUniforms in Metal shader)
+PointSpriteUniforms :: struct {
+    mvp: matrix[4,4]f32,
+    viewport_size: [2]f32,
+    _pad: [2]f32,
+}
+
+// GPU resources and per-frame instance list for point sprites
+PointSpriteRenderer :: struct {
+    vertex_shader: ^sdl.GPUShader,
+    fragment_shader: ^sdl.GPUShader,
+    pipeline: ^sdl.GPUGraphicsPipeline,
+
+    quad_buffer: ^sdl.GPUBuffer,  // Static 6-vertex quad
+
+    instance_buffer: ^sdl.GPUBuffer,
+    transfer_buffer: ^sdl.GPUTransferBuffer,
+    capacity: int,  // Instances that fit in instance/transfer buffers
+
+    instances: [dynamic]PointInstance,  // Queued for the current frame
+}
+
+// =============================================================================
+// Init / Destroy
+// =============================================================================
+
+// Create point sprite pipeline and buffers
+// Returns false if the shader is missing; callers fall back to CPU triangle fans
+point_sprites_init :: proc(
+    ps: ^PointSpriteRenderer,
+    gpu_device: ^sdl.GPUDevice,
+    window: ^sdl.Window,
+) -> bool {
+    shader_data, shader_ok := os.read_entire_file(POINT_SPRITE_SHADER_PATH)
+    if !shader_ok {
+        fmt.eprintln("WARNING: Failed to read point sprite shader, using fallback point rendering:", POINT_SPRITE_SHADER_PATH)
+        return false
+    }
+    defer delete(shader_data)
+
+    vertex_shader_info := sdl.GPUShaderCreateInfo{
+        code = raw_data(shader_data),
+        code_size = len(shader_data),
+        entrypoint = "point_sprite_vertex_main",
+        format = {.METALLIB},
+        stage = .VERTEX,
+        num_uniform_buffers = 1,
+    }
+
+    vertex_shader := sdl.CreateGPUShader(gpu_device, vertex_shader_info)
+    if vertex_shader == nil {
+        fmt.eprintln("WARNING: Failed to create point sprite vertex shader:", sdl.GetError())
+        return false
+    }
+
+    fragment_shader_info := sdl.GPUShaderCreateInfo{
+        code = raw_data(shader_data),
+        code_size = len(shader_data),
+        entrypoint = "point_sprite_fragment_main",
+        format = {.METALLIB},
+        stage = .FRAGMENT,
+        num_uniform_buffers = 0,
+    }
+
+    fragment_shader := sdl.CreateGPUShader(gpu_device, fragment_shader_info)
+    if fragment_shader == nil {
+        fmt.eprintln("WARNING: Failed to create point sprite fragment shader:", sdl.GetError())
+        sdl.ReleaseGPUShader(gpu_device, vertex_shader)
+        return false
+    }
+
+    // Slot 0: quad corners (per vertex), slot 1: instances (per instance)
+    vertex_attributes := []sdl.GPUVertexAttribute{
+        {location = 0, buffer_slot = 0, format = .FLOAT2, offset = 0},   // corner
+        {location = 1, buffer_slot = 1, format = .FLOAT3, offset = 0},   // position
+        {location = 2, buffer_slot = 1, format = .FLOAT, offset = 12},   // radius
+        {location = 3, buffer_slot = 1, format = .FLOAT4, offset = 16},  // color
+        {location = 4, buffer_slot = 1, format = .UINT, offset = 32},    // style
+    }
+
+    vertex_bindings := []sdl.GPUVertexBufferDescription{
+        {slot = 0, pitch = size_of([2]f32), input_rate = .VERTEX},
+        {slot = 1, pitch = size_of(PointInstance), input_rate = .INSTANCE},
+    }
+
+    vertex_input_state := sdl.GPUVertexInputState{
+        vertex_buffer_descriptions = raw_data(vertex_bindings),
+        num_vertex_buffers = u32(len(vertex_bindings)),
+        vertex_attributes = raw_data(vertex_attributes),
+        num_vertex_attributes = u32(len(vertex_attributes)),
+    }
+
+    color_target := sdl.GPUColorTargetDescription{
+        format = sdl.GetGPUSwapchainTextureFormat(gpu_device, window),
+        blend_state = {
+            enable_blend = true,
+            alpha_blend_op = .ADD,
+            color_blend_op = .ADD,
+            src_color_blendfactor = .SRC_ALPHA,
+            dst_color_blendfactor = .ONE_MINUS_SRC_ALPHA,
+            src_alpha_blendfactor = .ONE,
+            dst_alpha_blendfactor = .ONE_MINUS_SRC_ALPHA,
+        },
+    }
+
+    pipeline_info := sdl.GPUGraphicsPipelineCreateInfo{
+        vertex_shader = vertex_shader,
+        fragment_shader = fragment_shader,
+        vertex_input_state = vertex_input_state,
+        primitive_type = .TRIANGLELIST,
+        rasterizer_state = {
+            fill_mode = .FILL,
+            cull_mode = .NONE,
+            front_face = .COUNTER_CLOCKWISE,
+        },
+        multisample_state = {
+            sample_count = ._4,
+            sample_mask = 0xFFFFFFFF,
+        },
+        depth_stencil_state = {
+            // Points are UI overlays - always render on top (same as triangle pipeline)
+            enable_depth_test = false,
+            enable_depth_write = false,
+            enable_stencil_test = false,
+        },
+        target_info = {
+            num_color_targets = 1,
+            color_target_descriptions = &color_target,
+            has_depth_stencil_target = true,
+            depth_stencil_format = viewer_gpu_depth_format(gpu_device),
+        },
+    }
+
+    pipeline := sdl.CreateGPUGraphicsPipeline(gpu_device, pipeline_info)
+    if pipeline == nil {
+        fmt.eprintln("WARNING: Failed to create point sprite pipeline:", sdl.GetError())
+        sdl.ReleaseGPUShader(gpu_device, fragment_shader)
+        sdl.ReleaseGPUShader(gpu_device, vertex_shader)
+        return false
+    }
+
+    ps.vertex_shader = vertex_shader
+    ps.fragment_shader = fragment_shader
+    ps.pipeline = pipeline
+
+    if !point_sprites_create_quad(ps, gpu_device) {
+        fmt.eprintln("WARNING: Failed to create point sprite quad buffer")
+        point_sprites_destroy(ps, gpu_device)
+        return false
+    }
+
+    ps.instances = make([dynamic]PointInstance, 0, POINT_SPRITE_INITIAL_CAPACITY)
+
+    fmt.println("✓ Point sprite pipeline created (instanced SDF points)")
+    return true
+}
+
+// Upload the static unit quad (two triangles, corners in [-1, 1])
+@(private="file")
+point_sprites_create_quad :: proc(ps: ^PointSpriteRenderer, gpu_device: ^sdl.GPUDevice) -> bool {
+    quad := [6][2]f32{
+        {-1, -1}, { 1, -1}, { 1,  1},
+        {-1, -1}, { 1,  1}, {-1,  1},
+    }
+    size := u32(size_of(quad))
+
+    ps.quad_buffer = sdl.CreateGPUBuffer(gpu_device, {usage = {.VERTEX}, size = size})
+    if ps.quad_buffer == nil do return false
+
+    transfer_buffer := sdl.CreateGPUTransferBuffer(gpu_device, {usage = .UPLOAD, size = size})
+    if transfer_buffer == nil do return false
+    defer sdl.ReleaseGPUTransferBuffer(gpu_device, transfer_buffer)
+
+    transfer_ptr := sdl.MapGPUTransferBuffer(gpu_device, transfer_buffer, false)
+    if transfer_ptr == nil do return false
+    (^[6][2]f32)(transfer_ptr)^ = quad
+    sdl.UnmapGPUTransferBuffer(gpu_device, transfer_buffer)
+
+    upload_cmd := sdl.AcquireGPUCommandBuffer(gpu_device)
+    copy_pass := sdl.BeginGPUCopyPass(upload_cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        {transfer_buffer = transfer_buffer, offset = 0},
+        {buffer = ps.quad_buffer, offset = 0, size = size},
+        false,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    return sdl.SubmitGPUCommandBuffer(upload_cmd)
+}
+
+// Release point sprite GPU resources
+point_sprites_destroy :: proc(ps: ^PointSpriteRenderer, gpu_device: ^sdl.GPUDevice) {
+    if ps.instance_buffer != nil {
+        sdl.ReleaseGPUBuffer(gpu_device, ps.instance_buffer)
+    }
+    if ps.transfer_buffer != nil {
+        sdl.ReleaseGPUTransferBuffer(gpu_device, ps.transfer_buffer)
+    }
+    if ps.quad_buffer != nil {
+        sdl.ReleaseGPUBuffer(gpu_device, ps.quad_buffer)
+    }
+    if ps.pipeline != nil {
+        sdl.ReleaseGPUGraphicsPipeline(gpu_device, ps.pipeline)
+    }
+    if ps.fragment_shader != nil {
+        sdl.ReleaseGPUShader(gpu_device, ps.fragment_shader)
+    }
+    if ps.vertex_shader != nil {
+        sdl.ReleaseGPUShader(gpu_device, ps.vertex_shader)
+    }
+    delete(ps.instances)
+    ps^ = {}
+}
+
+// =============================================================================
+// Queueing
+// =============================================================================
+
+// True when instanced point rendering is available
+point_sprites_enabled :: proc(viewer: ^ViewerGPU) -> bool {
+    return viewer.point_sprites.pipeline != nil
+}
+
+// Queue a point at a world-space position
+point_sprites_add :: proc(
+    viewer: ^ViewerGPU,
+    position: [3]f32,
+    color: [4]f32,
+    radius_pixels: f32,
+    style: PointStyle = .Circle,
+) {
+    append(&viewer.point_sprites.instances, PointInstance{
+        position = position,
+        radius = radius_pixels,
+        color = color,
+        style = style,
+    })
+}
+
+// Queue a sketch-plane point
+point_sprites_add_sketch_point :: proc(
+    viewer: ^ViewerGPU,
+    sk: ^sketch.Sketch2D,
+    x, y: f64,
+    color: [4]f32,
+    radius_pixels: f32,
+    style: PointStyle = .Circle,
+) {
+    p := sketch.sketch_to_world(&sk.plane, m.Vec2{x, y})
+    point_sprites_add(viewer, {f32(p.x), f32(p.y), f32(p.z)}, color, radius_pixels, style)
+}
+
+// =============================================================================
+// Flush
+// =============================================================================
+
+// Grow instance and transfer buffers to hold at least `count` instances
+@(private="file")
+point_sprites_reserve :: proc(ps: ^PointSpriteRenderer, gpu_device: ^sdl.GPUDevice, count: int) -> bool {
+    if count <= ps.capacity && ps.instance_buffer != nil do return true
+
+    new_capacity := max(ps.capacity, POINT_SPRITE_INITIAL_CAPACITY)
+    for new_capacity < count {
+        new_capacity *= 2
+    }
+    size := u32(new_capacity * size_of(PointInstance))
+
+    instance_buffer := sdl.CreateGPUBuffer(gpu_device, {usage = {.VERTEX}, size = size})
+    if instance_buffer == nil {
+        fmt.eprintln("ERROR: Failed to create point instance buffer")
+        return false
+    }
+
+    transfer_buffer := sdl.CreateGPUTransferBuffer(gpu_device, {usage = .UPLOAD, size = size})
+    if transfer_buffer == nil {
+        fmt.eprintln("ERROR: Failed to create point instance transfer buffer")
+        sdl.ReleaseGPUBuffer(gpu_device, instance_buffer)
+        return false
+    }
+
+    if ps.instance_buffer != nil {
+        sdl.ReleaseGPUBuffer(gpu_device, ps.instance_buffer)
+    }
+    if ps.transfer_buffer != nil {
+        sdl.ReleaseGPUTransferBuffer(gpu_device, ps.transfer_buffer)
+    }
+
+    ps.instance_buffer = instance_buffer
+    ps.transfer_buffer = transfer_buffer
+    ps.capacity = new_capacity
+    return true
+}
+
+// Upload all queued points and draw them with one instanced call, then clear the queue
+// Must be called inside the frame's render pass; rebinds the line pipeline afterwards
+// target_width/target_height are the pass's render target size (sprite sizes are in its pixels)
+viewer_gpu_flush_point_sprites :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    mvp: matrix[4,4]f32,
+    target_width, target_height: u32,
+) {
+    ps := &viewer.point_sprites
+    defer clear(&ps.instances)
+
+    count := len(ps.instances)
+    if count == 0 || ps.pipeline == nil do return
+
+    if !point_sprites_reserve(ps, viewer.gpu_device, count) do return
+
+    data_size := u32(count * size_of(PointInstance))
+
+    // Cycle so a buffer still referenced by an in-flight frame is never overwritten
+    transfer_ptr := sdl.MapGPUTransferBuffer(viewer.gpu_device, ps.transfer_buffer, true)
+    if transfer_ptr == nil {
+        fmt.eprintln("ERROR: Failed to map point instance transfer buffer")
+        return
+    }
+    copy(([^]PointInstance)(transfer_ptr)[:count], ps.instances[:])
+    sdl.UnmapGPUTransferBuffer(viewer.gpu_device, ps.transfer_buffer)
+
+    // Upload on a separate command buffer; it is submitted before the frame's
+    // command buffer, so the copy is ordered ahead of the draw without a GPU idle wait
+    upload_cmd := sdl.AcquireGPUCommandBuffer(viewer.gpu_device)
+    copy_pass := sdl.BeginGPUCopyPass(upload_cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        {transfer_buffer = ps.transfer_buffer, offset = 0},
+        {buffer = ps.instance_buffer, offset = 0, size = data_size},
+        true,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, int(data_size))
+
+    sdl.BindGPUGraphicsPipeline(pass, ps.pipeline)
+
+    bindings := [2]sdl.GPUBufferBinding{
+        {buffer = ps.quad_buffer, offset = 0},
+        {buffer = ps.instance_buffer, offset = 0},
+    }
+    sdl.BindGPUVertexBuffers(pass, 0, raw_data(bindings[:]), 2)
+
+    uniforms := PointSpriteUniforms{
+        mvp = mvp,
+        viewport_size = {f32(target_width), f32(target_height)},
+    }
+    sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(PointSpriteUniforms))
+    sdl.DrawGPUPrimitives(pass, 6, u32(count), 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, 2 * count)
+
+    // Switch back to line pipeline
+    sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
+}
@@ -0,0 +1,377 @@
+// ui/viewer - Stencil-then-cover fills for closed sketch profiles (SDL3 GPU)
+// Outlines are filled without triangulating them:
+//   1. a fan from one anchor point over every outline edge is drawn into the stencil only
+//      (even-odd: invert bit 0, nonzero: +1/-1 by the triangle's facing)
+//   2. one quad covering the outlines' bounds is drawn where the stencil is non-zero,
+//      resetting the stencil to zero as it goes
+// Concave outlines come out right, and nested outlines in the same fill become holes.
+// Fan and cover vertices are uploaded once per revision of the outlines and then redrawn
+// from a static buffer every frame.
+package ohcad_viewer
+
+import "core:fmt"
+import "core:math"
+import m "../../core/math"
+import sketch "../../features/sketch"
+import sdl "vendor:sdl3"
+
+// Initial vertex capacity (the buffer grows by doubling)
+PROFILE_FILL_INITIAL_CAPACITY :: 1024
+
+// =============================================================================
+// Types
+// =============================================================================
+
+// Which stencil counts mark a pixel as inside
+FillRule :: enum {
+    EvenOdd,  // Odd number of crossings - nested loops alternate filled/hole
+    NonZero,  // Non-zero winding - loops wound against their parent are holes
+}
+
+ProfileFillRenderer :: struct {
+    stencil_pipelines: [FillRule]^sdl.GPUGraphicsPipeline,  // Stencil-only fan passes
+    cover_pipeline: ^sdl.GPUGraphicsPipeline,              // Color where stencil != 0, then clear it
+
+    // Static geometry of the uploaded outlines: fan first, then the cover quad
+    vertex_buffer: ^sdl.GPUBuffer,
+    capacity: int,           // Vertices that fit in vertex_buffer
+    fan_vertex_count: u32,
+    cover_vertex_count: u32,
+    revision: u64,           // Caller's key for the uploaded outlines
+    uploaded: bool,
+}
+
+// =============================================================================
+// Init / Destroy
+// =============================================================================
+
+// Create the stencil and cover pipelines (line shaders, LineVertex input)
+// Returns false when the depth format has no stencil; callers fall back to CPU fans
+profile_fill_init :: proc(
+    fill: ^ProfileFillRenderer,
+    gpu_device: ^sdl.GPUDevice,
+    vertex_shader, fragment_shader: ^sdl.GPUShader,
+    color_format, depth_format: sdl.GPUTextureFormat,
+    sample_count: sdl.GPUSampleCount,
+) -> bool {
+    if depth_format != .D32_FLOAT_S8_UINT && depth_format != .D24_UNORM_S8_UINT {
+        return false
+    }
+
+    vertex_attribute := sdl.GPUVertexAttribute{location = 0, format = .FLOAT3, offset = 0}
+    vertex_binding := sdl.GPUVertexBufferDescription{
+        slot = 0,
+        pitch = size_of(LineVertex),
+        input_rate = .VERTEX,
+    }
+    vertex_input_state := sdl.GPUVertexInputState{
+        vertex_buffer_descriptions = &vertex_binding,
+        num_vertex_buffers = 1,
+        vertex_attributes = &vertex_attribute,
+        num_vertex_attributes = 1,
+    }
+
+    // Stencil passes write no color
+    stencil_color_target := sdl.GPUColorTargetDescription{
+        format = color_format,
+        blend_state = {
+            enable_color_write_mask = true,
+            color_write_mask = {},
+        },
+    }
+
+    // Cover pass blends like the triangle pipeline (translucent fills)
+    cover_color_target := sdl.GPUColorTargetDescription{
+        format = color_format,
+        blend_state = {
+            enable_blend = true,
+            alpha_blend_op = .ADD,
+            color_blend_op = .ADD,
+            src_color_blendfactor = .SRC_ALPHA,
+            dst_color_blendfactor = .ONE_MINUS_SRC_ALPHA,
+            src_alpha_blendfactor = .ONE,
+            dst_alpha_blendfactor = .ONE_MINUS_SRC_ALPHA,
+        },
+    }
+
+    pipeline_info := sdl.GPUGraphicsPipelineCreateInfo{
+        vertex_shader = vertex_shader,
+        fragment_shader = fragment_shader,
+        vertex_input_state = vertex_input_state,
+        primitive_type = .TRIANGLELIST,
+        rasterizer_state = {
+            fill_mode = .FILL,
+            cull_mode = .NONE,  // Both facings count (nonzero uses them for the winding sign)
+            front_face = .COUNTER_CLOCKWISE,
+        },
+        multisample_state = {
+            sample_count = sample_count,
+            sample_mask = 0xFFFFFFFF,
+        },
+        target_info = {
+            num_color_targets = 1,
+            color_target_descriptions = &stencil_color_target,
+            has_depth_stencil_target = true,
+            depth_stencil_format = depth_format,
+        },
+    }
+
+    for rule in FillRule {
+        front, back: sdl.GPUStencilOp
+        write_mask: u8
+        switch rule {
+        case .EvenOdd:
+            front, back, write_mask = .INVERT, .INVERT, 0x01
+        case .NonZero:
+            front, back, write_mask = .INCREMENT_AND_WRAP, .DECREMENT_AND_WRAP, 0xFF
+        }
+
+        pipeline_info.depth_stencil_state = {
+            enable_depth_test = false,
+            enable_depth_write = false,
+            enable_stencil_test = true,
+            front_stencil_state = {fail_op = .KEEP, pass_op = front, depth_fail_op = .KEEP, compare_op = .ALWAYS},
+            back_stencil_state = {fail_op = .KEEP, pass_op = back, depth_fail_op = .KEEP, compare_op = .ALWAYS},
+            compare_mask = 0xFF,
+            write_mask = write_mask,
+        }
+
+        fill.stencil_pipelines[rule] = sdl.CreateGPUGraphicsPipeline(gpu_device, pipeline_info)
+        if fill.stencil_pipelines[rule] == nil {
+            fmt.eprintln("WARNING: Failed to create profile fill stencil pipeline:", sdl.GetError())
+            profile_fill_destroy(fill, gpu_device)
+            return false
+        }
+    }
+
+    // Cover: draw where stencil != 0 (reference 0) and zero it for the next fill
+    cover_stencil := sdl.GPUStencilOpState{
+        fail_op = .KEEP,
+        pass_op = .ZERO,
+        depth_fail_op = .KEEP,
+        compare_op = .NOT_EQUAL,
+    }
+    pipeline_info.target_info.color_target_descriptions = &cover_color_target
+    pipeline_info.depth_stencil_state = {
+        enable_depth_test = false,
+        enable_depth_write = false,
+        enable_stencil_test = true,
+        front_stencil_state = cover_stencil,
+        back_stencil_state = cover_stencil,
+        compare_mask = 0xFF,
+        write_mask = 0xFF,
+    }
+
+    fill.cover_pipeline = sdl.CreateGPUGraphicsPipeline(gpu_device, pipeline_info)
+    if fill.cover_pipeline == nil {
+        fmt.eprintln("WARNING: Failed to create profile fill cover pipeline:", sdl.GetError())
+        profile_fill_destroy(fill, gpu_device)
+        return false
+    }
+
+    fmt.println("✓ Profile fill pipelines created (stencil-then-cover)")
+    return true
+}
+
+profile_fill_destroy :: proc(fill: ^ProfileFillRenderer, gpu_device: ^sdl.GPUDevice) {
+    if fill.vertex_buffer != nil {
+        sdl.ReleaseGPUBuffer(gpu_device, fill.vertex_buffer)
+    }
+    for pipeline in fill.stencil_pipelines {
+        if pipeline != nil {
+            sdl.ReleaseGPUGraphicsPipeline(gpu_device, pipeline)
+        }
+    }
+    if fill.cover_pipeline != nil {
+        sdl.ReleaseGPUGraphicsPipeline(gpu_device, fill.cover_pipeline)
+    }
+    fill^ = {}
+}
+
+// True when stencil-then-cover fills are available
+profile_fill_enabled :: proc(viewer: ^ViewerGPU) -> bool {
+    return viewer.profile_fill.cover_pipeline != nil
+}
+
+// =============================================================================
+// Upload
+// =============================================================================
+
+// True if the outlines for `revision` are already in the vertex buffer
+profile_fill_is_current :: proc(viewer: ^ViewerGPU, revision: u64) -> bool {
+    fill := &viewer.profile_fill
+    return fill.uploaded && fill.revision == revision
+}
+
+// Build and upload the fan + cover vertices for closed outlines on the sketch plane
+// Each outline is an implicitly closed loop in sketch coordinates.
+profile_fill_upload :: proc(
+    viewer: ^ViewerGPU,
+    sk: ^sketch.Sketch2D,
+    outlines: [][]m.Vec2,
+    revision: u64,
+) -> bool {
+    fill := &viewer.profile_fill
+    fill.uploaded = false
+    fill.revision = revision
+    fill.fan_vertex_count = 0
+    fill.cover_vertex_count = 0
+
+    edge_count := 0
+    lo := m.Vec2{math.F64_MAX, math.F64_MAX}
+    hi := m.Vec2{-math.F64_MAX, -math.F64_MAX}
+    for outline in outlines {
+        if len(outline) < 3 do continue
+        edge_count += len(outline)
+        for p in outline {
+            lo = {min(lo.x, p.x), min(lo.y, p.y)}
+            hi = {max(hi.x, p.x), max(hi.y, p.y)}
+        }
+    }
+
+    if edge_count == 0 {
+        fill.uploaded = true  // Nothing to draw for this revision
+        return true
+    }
+
+    // Anchor inside the bounds keeps fan triangles small (better precision than a far corner)
+    anchor := world_f32(sk, (lo + hi) * 0.5)
+
+    vertices := make([dynamic]LineVertex, 0, edge_count * 3 + 6, context.temp_allocator)
+    for outline in outlines {
+        if len(outline) < 3 do continue
+        prev := world_f32(sk, outline[len(outline) - 1])
+        for p in outline {
+            curr := world_f32(sk, p)
+            append(&vertices, LineVertex{anchor}, LineVertex{prev}, LineVertex{curr})
+            prev = curr
+        }
+    }
+    fan_count := len(vertices)
+
+    // Cover quad over the bounds (slightly padded so edge pixels are never clipped)
+    pad := max(hi.x - lo.x, hi.y - lo.y) * 0.01
+    c00 := world_f32(sk, {lo.x - pad, lo.y - pad})
+    c10 := world_f32(sk, {hi.x + pad, lo.y - pad})
+    c11 := world_f32(sk, {hi.x + pad, hi.y + pad})
+    c01 := world_f32(sk, {lo.x - pad, hi.y + pad})
+    append(&vertices,
+        LineVertex{c00}, LineVertex{c10}, LineVertex{c11},
+        LineVertex{c00}, LineVertex{c11}, LineVertex{c01},
+    )
+
+    if !profile_fill_write_vertices(viewer, vertices[:]) {
+        return false
+    }
+
+    fill.fan_vertex_count = u32(fan_count)
+    fill.cover_vertex_count = u32(len(vertices) - fan_count)
+    fill.uploaded = true
+    return true
+}
+
+// =============================================================================
+// Draw
+// =============================================================================
+
+// Fill the uploaded outlines (stencil fan, then cover quad)
+// Must be called inside the frame's render pass; rebinds the line pipeline afterwards
+viewer_gpu_render_profile_fill :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    mvp: matrix[4,4]f32,
+    color: [4]f32,
+    rule: FillRule = .EvenOdd,
+) {
+    fill := &viewer.profile_fill
+    if !fill.uploaded || fill.fan_vertex_count == 0 || fill.cover_pipeline == nil {
+        return
+    }
+
+    binding := sdl.GPUBufferBinding{buffer = fill.vertex_buffer, offset = 0}
+    uniforms := Uniforms{mvp = mvp, color = color}
+
+    sdl.SetGPUStencilReference(pass, 0)
+
+    sdl.BindGPUGraphicsPipeline(pass, fill.stencil_pipelines[rule])
+    sdl.BindGPUVertexBuffers(pass, 0, &binding, 1)
+    sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
+    sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
+    sdl.DrawGPUPrimitives(pass, fill.fan_vertex_count, 1, 0, 0)
+
+    sdl.BindGPUGraphicsPipeline(pass, fill.cover_pipeline)
+    sdl.DrawGPUPrimitives(pass, fill.cover_vertex_count, 1, fill.fan_vertex_count, 0)
+    frame_profiler_count_draw(&viewer.profiler, int(fill.fan_vertex_count + fill.cover_vertex_count) / 3)
+
+    // Switch back to line pipeline
+    sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+@(private="file")
+world_f32 :: proc(sk: ^sketch.Sketch2D, p: m.Vec2) -> [3]f32 {
+    w := sketch.sketch_to_world(&sk.plane, p)
+    return {f32(w.x), f32(w.y), f32(w.z)}
+}
+
+// Copy vertices into the static buffer (growing it if needed)
+@(private="file")
+profile_fill_write_vertices :: proc(viewer: ^ViewerGPU, vertices: []LineVertex) -> bool {
+    fill := &viewer.profile_fill
+    device := viewer.gpu_device
+
+    if fill.vertex_buffer == nil || len(vertices) > fill.capacity {
+        new_capacity := max(fill.capacity, PROFILE_FILL_INITIAL_CAPACITY)
+        for new_capacity < len(vertices) {
+            new_capacity *= 2
+        }
+
+        buffer := sdl.CreateGPUBuffer(device, {usage = {.VERTEX}, size = u32(new_capacity * size_of(LineVertex))})
+        if buffer == nil {
+            fmt.eprintln("ERROR: Failed to create profile fill vertex buffer")
+            return false
+        }
+        if fill.vertex_buffer != nil {
+            sdl.ReleaseGPUBuffer(device, fill.vertex_buffer)
+        }
+        fill.vertex_buffer = buffer
+        fill.capacity = new_capacity
+    }
+
+    size := u32(len(vertices) * size_of(LineVertex))
+    transfer := sdl.CreateGPUTransferBuffer(device, {usage = .UPLOAD, size = size})
+    if transfer == nil {
+        fmt.eprintln("ERROR: Failed to create transfer buffer for profile fill")
+        return false
+    }
+    defer sdl.ReleaseGPUTransferBuffer(device, transfer)
+
+    transfer_ptr := sdl.MapGPUTransferBuffer(device, transfer, false)
+    if transfer_ptr == nil {
+        fmt.eprintln("ERROR: Failed to map transfer buffer for profile fill")
+        return false
+    }
+    copy(([^]LineVertex)(transfer_ptr)[:len(vertices)], vertices)
+    sdl.UnmapGPUTransferBuffer(device, transfer)
+
+    // Upload on its own command buffer - submitted before the frame's render pass,
+    // so GPU submission order guarantees the data is in place when it is drawn.
+    // Cycling keeps a buffer still read by an in-flight frame intact.
+    upload_cmd := sdl.AcquireGPUCommandBuffer(device)
+    copy_pass := sdl.BeginGPUCopyPass(upload_cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        {transfer_buffer = transfer, offset = 0},
+        {buffer = fill.vertex_buffer, offset = 0, size = size},
+        true,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, int(size))
+
+    return true
+}
@@ -0,0 +1,407 @@
+// ui/viewer - Sorted render queue for 3D scene draws (SDL3 GPU)
+// The immediate draw helpers each bind their pipeline, vertex buffer and uniforms, draw, and
+// rebind the line pipeline - so a frame of N bodies costs 2N pipeline binds and N pushes, and
+// every thick-line call uploads its own vertex buffer. Draws submitted here are recorded as
+// keyed items instead and executed by render_queue_flush:
+//   key = layer | pipeline | material | depth (front to back)
+// Sorting groups items by state, binds and uniform pushes are skipped when the previous draw
+// left the same state, and adjacent items over contiguous vertices of one buffer merge into a
+// single draw. Thick lines share one transient vertex buffer, uploaded once per flush.
+// Counts before (submission order) and after sorting are added to the frame profiler.
+package ohcad_viewer
+
+import "core:mem"
+import "core:slice"
+import sdl "vendor:sdl3"
+
+// Sort order between groups of draws; each layer is flushed after the one before it
+RenderLayer :: enum u8 {
+    Opaque,   // Depth-tested and depth-written - any order is correct, sorted by state then depth
+    Edges,    // Depth-tested overlays (edge wireframes) - sorted by state
+    Overlay,  // Blended or not depth-tested - submission order, redundant state still skipped
+}
+
+// Viewer pipeline a queued draw uses
+RenderPipeline :: enum u8 {
+    Shaded,     // viewer.shaded_pipeline (TriangleVertex, TriangleUniforms)
+    Wireframe,  // viewer.wireframe_pipeline (depth-tested thick lines)
+    Triangles,  // viewer.triangle_pipeline (thick lines / fills without depth test)
+    Lines,      // viewer.pipeline (line list)
+}
+
+// One frame's queue counters; *_unsorted = the same items executed in submission order
+RenderQueueStats :: struct {
+    items: int,
+    draws_unsorted: int,
+    draws: int,             // After merging adjacent draws
+    binds_unsorted: int,
+    binds: int,             // Pipeline + vertex buffer binds
+    pushes_unsorted: int,
+    pushes: int,            // Uniform pushes (vertex + fragment stage count as one)
+}
+
+RenderQueue :: struct {
+    items: [dynamic]RenderItem,
+    sequence: u32,                          // Submission counter (ties and Overlay order)
+
+    // Uniform blocks, deduplicated per flush - identical blocks share one material ID
+    materials: [dynamic]RenderUniformBlock,
+    material_ids: map[RenderUniformBlock]u32,
+
+    // Thick-line vertices, uploaded once per flush
+    transient: [dynamic]LineVertex,
+    transient_buffer: ^sdl.GPUBuffer,
+    transient_transfer: ^sdl.GPUTransferBuffer,
+    transient_capacity: int,                // Vertices
+}
+
+RenderItem :: struct {
+    key: u64,
+    sequence: u32,
+    pipeline: RenderPipeline,
+    material: u32,
+    buffer: ^sdl.GPUBuffer,                 // nil = queue's transient buffer
+    first_vertex: u32,
+    vertex_count: u32,
+    indirect: ^sdl.GPUBuffer,               // Non-nil: counts come from an indirect command
+    indirect_offset: u32,
+    triangles: int,                         // For the profiler
+}
+
+RenderUniformBlock :: struct {
+    bytes: [size_of(TriangleUniforms)]u8,
+    size: u32,
+}
+
+// =============================================================================
+// Lifetime
+// =============================================================================
+
+render_queue_init :: proc(queue: ^RenderQueue) {
+    queue.items = make([dynamic]RenderItem)
+    queue.materials = make([dynamic]RenderUniformBlock)
+    queue.material_ids = make(map[RenderUniformBlock]u32)
+    queue.transient = make([dynamic]LineVertex)
+}
+
+render_queue_destroy :: proc(queue: ^RenderQueue, device: ^sdl.GPUDevice) {
+    if queue.transient_buffer != nil do sdl.ReleaseGPUBuffer(device, queue.transient_buffer)
+    if queue.transient_transfer != nil do sdl.ReleaseGPUTransferBuffer(device, queue.transient_transfer)
+    delete(queue.items)
+    delete(queue.materials)
+    delete(queue.material_ids)
+    delete(queue.transient)
+    queue^ = {}
+}
+
+// =============================================================================
+// Submission
+// =============================================================================
+
+// Shaded mesh (vertex buffer of TriangleVertex); depth = distance from the camera, for
+// front-to-back order within a material
+render_queue_submit_shaded :: proc(
+    viewer: ^ViewerGPU,
+    buffer: ^sdl.GPUBuffer,
+    vertex_count: u32,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+    depth: f32 = 0,
+) {
+    if viewer.shaded_pipeline == nil || buffer == nil || vertex_count == 0 {
+        return
+    }
+    uniforms := shaded_uniforms(color, mvp, normal_matrix)
+    render_queue_push_item(&viewer.render_queue, .Opaque, .Shaded, &uniforms, size_of(uniforms), depth, RenderItem{
+        buffer = buffer,
+        vertex_count = vertex_count,
+        triangles = int(vertex_count) / 3,
+    })
+}
+
+// Shaded mesh whose counts come from a GPU-written indirect command (occlusion culling);
+// triangles is what the profiler counts for it
+render_queue_submit_shaded_indirect :: proc(
+    viewer: ^ViewerGPU,
+    buffer: ^sdl.GPUBuffer,
+    args: ^sdl.GPUBuffer,
+    args_offset: u32,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+    triangles: int,
+    depth: f32 = 0,
+) {
+    if viewer.shaded_pipeline == nil || buffer == nil {
+        return
+    }
+    uniforms := shaded_uniforms(color, mvp, normal_matrix)
+    render_queue_push_item(&viewer.render_queue, .Opaque, .Shaded, &uniforms, size_of(uniforms), depth, RenderItem{
+        buffer = buffer,
+        indirect = args,
+        indirect_offset = args_offset,
+        triangles = triangles,
+    })
+}
+
+// Screen-space thick lines (same geometry as viewer_gpu_render_thick_lines)
+render_queue_submit_thick_lines :: proc(
+    viewer: ^ViewerGPU,
+    layer: RenderLayer,
+    lines: [][2][3]f32,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    thickness_pixels: f32,
+    use_depth_testing := false,
+) {
+    queue := &viewer.render_queue
+    first := len(queue.transient)
+    append_thick_line_quads(viewer, &queue.transient, lines, thickness_pixels)
+    count := len(queue.transient) - first
+    if count == 0 {
+        return
+    }
+
+    uniforms := Uniforms{mvp = mvp, color = color}
+    render_queue_push_item(queue, layer, use_depth_testing ? .Wireframe : .Triangles, &uniforms, size_of(uniforms), 0, RenderItem{
+        first_vertex = u32(first),
+        vertex_count = u32(count),
+        triangles = count / 3,
+    })
+}
+
+// Edge overlay of a solid (depth-tested, like viewer_gpu_render_wireframe)
+render_queue_submit_wireframe :: proc(
+    viewer: ^ViewerGPU,
+    mesh: ^WireframeMeshGPU,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    thickness_pixels: f32 = 2.0,
+) {
+    render_queue_submit_thick_lines(viewer, .Edges, mesh.edges[:], color, mvp, thickness_pixels, use_depth_testing = true)
+}
+
+// =============================================================================
+// Execution
+// =============================================================================
+
+// Sort and draw everything submitted since the last flush into pass, then leave the line
+// pipeline bound (what the immediate helpers expect). Uploads the transient vertices on their
+// own command buffer, so call it before cmd is submitted.
+render_queue_flush :: proc(viewer: ^ViewerGPU, cmd: ^sdl.GPUCommandBuffer, pass: ^sdl.GPURenderPass) {
+    queue := &viewer.render_queue
+    defer render_queue_reset(queue)
+
+    if len(queue.items) == 0 {
+        return
+    }
+
+    transient := render_queue_upload_transient(viewer, queue)
+
+    stats := RenderQueueStats{items = len(queue.items)}
+    stats.draws_unsorted, stats.binds_unsorted, stats.pushes_unsorted = render_queue_walk(viewer, queue.items[:], transient, nil, nil)
+
+    slice.sort_by(queue.items[:], proc(a, b: RenderItem) -> bool {
+        return a.key < b.key || (a.key == b.key && a.sequence < b.sequence)
+    })
+    stats.draws, stats.binds, stats.pushes = render_queue_walk(viewer, queue.items[:], transient, cmd, pass)
+
+    frame_profiler_count_queue(&viewer.profiler, stats)
+}
+
+// Discard submitted items without drawing them
+render_queue_reset :: proc(queue: ^RenderQueue) {
+    clear(&queue.items)
+    clear(&queue.materials)
+    clear(&queue.material_ids)
+    clear(&queue.transient)
+    queue.sequence = 0
+}
+
+// =============================================================================
+// Internals
+// =============================================================================
+
+@(private="file")
+render_queue_push_item :: proc(
+    queue: ^RenderQueue,
+    layer: RenderLayer,
+    pipeline: RenderPipeline,
+    uniforms: rawptr,
+    uniforms_size: int,
+    depth: f32,
+    item: RenderItem,
+) {
+    block := RenderUniformBlock{size = u32(uniforms_size)}
+    mem.copy(&block.bytes[0], uniforms, uniforms_size)
+
+    material, found := queue.material_ids[block]
+    if !found {
+        material = u32(len(queue.materials))
+        append(&queue.materials, block)
+        queue.material_ids[block] = material
+    }
+
+    item := item
+    item.pipeline = pipeline
+    item.material = material
+    item.sequence = queue.sequence
+    queue.sequence += 1
+
+    if layer == .Overlay {
+        item.key = u64(layer) << 62 | u64(item.sequence)
+    } else {
+        // Non-negative floats order like their bit patterns
+        item.key = u64(layer) << 62 | u64(pipeline) << 56 | u64(material & 0xFFFFFF) << 32 | u64(transmute(u32)max(depth, 0))
+    }
+    append(&queue.items, item)
+}
+
+// Execute items in order (cmd/pass nil = only count); returns draws, binds and pushes
+@(private="file")
+render_queue_walk :: proc(
+    viewer: ^ViewerGPU,
+    items: []RenderItem,
+    transient: ^sdl.GPUBuffer,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+) -> (draws, binds, pushes: int) {
+    queue := &viewer.render_queue
+    recording := pass != nil
+
+    NONE :: max(u32)
+    bound_pipeline := NONE
+    bound_buffer: ^sdl.GPUBuffer
+    pushed_material := NONE
+
+    for i := 0; i < len(items); {
+        item := items[i]
+        buffer := item.buffer != nil ? item.buffer : transient
+
+        // Merge following draws of contiguous vertices with the same state
+        vertex_count := item.vertex_count
+        triangles := item.triangles
+        next := i + 1
+        for item.indirect == nil && next < len(items) {
+            other := items[next]
+            if other.indirect != nil || other.pipeline != item.pipeline || other.material != item.material ||
+               other.buffer != item.buffer || other.first_vertex != item.first_vertex + vertex_count {
+                break
+            }
+            vertex_count += other.vertex_count
+            triangles += other.triangles
+            next += 1
+        }
+        i = next
+
+        if buffer == nil do continue
+
+        if bound_pipeline != u32(item.pipeline) {
+            bound_pipeline = u32(item.pipeline)
+            binds += 1
+            if recording do sdl.BindGPUGraphicsPipeline(pass, render_pipeline_handle(viewer, item.pipeline))
+        }
+        if bound_buffer != buffer {
+            bound_buffer = buffer
+            binds += 1
+            if recording {
+                binding := sdl.GPUBufferBinding{buffer = buffer}
+                sdl.BindGPUVertexBuffers(pass, 0, &binding, 1)
+            }
+        }
+        if pushed_material != item.material {
+            pushed_material = item.material
+            pushes += 1
+            if recording {
+                block := &queue.materials[item.material]
+                sdl.PushGPUVertexUniformData(cmd, 0, &block.bytes[0], block.size)
+                sdl.PushGPUFragmentUniformData(cmd, 0, &block.bytes[0], block.size)
+            }
+        }
+
+        draws += 1
+        if recording {
+            if item.indirect != nil {
+                sdl.DrawGPUPrimitivesIndirect(pass, item.indirect, item.indirect_offset, 1)
+            } else {
+                sdl.DrawGPUPrimitives(pass, vertex_count, 1, item.first_vertex, 0)
+            }
+            frame_profiler_count_draw(&viewer.profiler, triangles)
+        }
+    }
+
+    // Leave the line pipeline bound, like the immediate helpers
+    if bound_pipeline != NONE && bound_pipeline != u32(RenderPipeline.Lines) {
+        binds += 1
+        if recording do sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
+    }
+    return
+}
+
+// Copy this flush's thick-line vertices into the transient vertex buffer (grown as needed)
+@(private="file")
+render_queue_upload_transient :: proc(viewer: ^ViewerGPU, queue: ^RenderQueue) -> ^sdl.GPUBuffer {
+    count := len(queue.transient)
+    if count == 0 {
+        return nil
+    }
+
+    device := viewer.gpu_device
+    if count > queue.transient_capacity {
+        capacity := max(queue.transient_capacity, 4096)
+        for capacity < count {
+            capacity *= 2
+        }
+
+        if queue.transient_buffer != nil do sdl.ReleaseGPUBuffer(device, queue.transient_buffer)
+        if queue.transient_transfer != nil do sdl.ReleaseGPUTransferBuffer(device, queue.transient_transfer)
+        queue.transient_capacity = 0
+
+        size := u32(capacity * size_of(LineVertex))
+        queue.transient_buffer = sdl.CreateGPUBuffer(device, sdl.GPUBufferCreateInfo{usage = {.VERTEX}, size = size})
+        queue.transient_transfer = sdl.CreateGPUTransferBuffer(device, sdl.GPUTransferBufferCreateInfo{usage = .UPLOAD, size = size})
+        if queue.transient_buffer == nil || queue.transient_transfer == nil {
+            return nil
+        }
+        queue.transient_capacity = capacity
+    }
+
+    size := u32(count * size_of(LineVertex))
+    mapped := sdl.MapGPUTransferBuffer(device, queue.transient_transfer, true)
+    if mapped == nil {
+        return nil
+    }
+    copy(([^]LineVertex)(mapped)[:count], queue.transient[:])
+    sdl.UnmapGPUTransferBuffer(device, queue.transient_transfer)
+
+    // Own command buffer, submitted before the frame's: submission order puts the data in
+    // place before the draws. Cycling keeps earlier flushes' data intact for their draws.
+    upload_cmd := sdl.AcquireGPUCommandBuffer(device)
+    if upload_cmd == nil {
+        return nil
+    }
+    copy_pass := sdl.BeginGPUCopyPass(upload_cmd)
+    sdl.UploadToGPUBuffer(
+        copy_pass,
+        sdl.GPUTransferBufferLocation{transfer_buffer = queue.transient_transfer},
+        sdl.GPUBufferRegion{buffer = queue.transient_buffer, size = size},
+        true,
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+    _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, int(size))
+
+    return queue.transient_buffer
+}
+
+@(private="file")
+render_pipeline_handle :: proc(viewer: ^ViewerGPU, pipeline: RenderPipeline) -> ^sdl.GPUGraphicsPipeline {
+    switch pipeline {
+    case .Shaded:    return viewer.shaded_pipeline
+    case .Wireframe: return viewer.wireframe_pipeline
+    case .Triangles: return viewer.triangle_pipeline
+    case .Lines:     return viewer.pipeline
+    }
+    return viewer.pipeline
+}
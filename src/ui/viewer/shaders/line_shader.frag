@@ -0,0 +1,15 @@
+// OhCAD SPIR-V shaders (Vulkan / headless rendering) - line rendering, fragment stage
+// GLSL port of fragment_main in line_shader.metal; keep the two in sync
+// SDL3 GPU binds fragment-stage uniform buffers at set 3
+#version 450
+
+layout(location = 0) out vec4 out_color;
+
+layout(std140, set = 3, binding = 0) uniform Uniforms {
+    mat4 mvp;     // Model-View-Projection matrix
+    vec4 color;   // Line/shape color (RGBA)
+} uniforms;
+
+void main() {
+    out_color = uniforms.color;
+}
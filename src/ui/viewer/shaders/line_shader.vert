@@ -0,0 +1,15 @@
+// OhCAD SPIR-V shaders (Vulkan / headless rendering) - line rendering, vertex stage
+// GLSL port of vertex_main in line_shader.metal; keep the two in sync
+// SDL3 GPU binds vertex-stage uniform buffers at set 1
+#version 450
+
+layout(location = 0) in vec3 in_position;
+
+layout(std140, set = 1, binding = 0) uniform Uniforms {
+    mat4 mvp;     // Model-View-Projection matrix
+    vec4 color;   // Line/shape color (RGBA)
+} uniforms;
+
+void main() {
+    gl_Position = uniforms.mvp * vec4(in_position, 1.0);
+}
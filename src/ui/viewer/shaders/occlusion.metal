@@ -0,0 +1,178 @@
+// OhCAD Metal Shaders - Two-phase hierarchical-Z occlusion culling (compute)
+// occlusion_prepare: indirect draws for bodies visible last frame (phase 1)
+// hiz_depth / hiz_reduce: max-depth pyramid built from the phase-1 depth buffer
+// occlusion_cull: test every body's bounding box against the pyramid, write the phase-2 draws
+//
+// SDL3 GPU compute bindings: [[buffer]] = uniforms, then read-only storage buffers, then
+// read-write storage buffers; [[texture]]/[[sampler]] = sampled textures.
+// GLSL ports: occlusion_prepare.comp, hiz_depth.comp, hiz_reduce.comp, occlusion_cull.comp
+#include <metal_stdlib>
+using namespace metal;
+
+// =============================================================================
+// Shared Data Structures (match OcclusionItemGPU / sdl.GPUIndirectDrawCommand)
+// =============================================================================
+
+constant uint ITEM_ACTIVE = 1u;  // Item is part of this frame's scene
+constant uint ITEM_NEW = 2u;     // Slot was (re)assigned this frame - no visibility history yet
+
+struct OcclusionItem {
+    float4 bbox_min;     // World-space bounds (w unused)
+    float4 bbox_max;
+    uint vertex_count;
+    uint flags;
+    uint pad0;
+    uint pad1;
+};
+
+struct DrawCommand {
+    uint num_vertices;
+    uint num_instances;
+    uint first_vertex;
+    uint first_instance;
+};
+
+struct PrepareParams {
+    uint4 info;          // x = item count
+};
+
+struct HiZParams {
+    uint4 src;           // offset, width, height (pyramid level, or the depth texture size)
+    uint4 dst;           // offset, width, height
+};
+
+struct CullParams {
+    float4x4 view_proj;
+    float4 viewport;     // xy = framebuffer size in pixels
+    uint4 info;          // x = item count, y = pyramid levels, z = first phase-2 command
+    uint4 levels[16];    // offset, width, height per pyramid level
+};
+
+// Drawn in phase 1: visible when last tested, or too new to have been tested
+static bool drawn_in_phase_one(OcclusionItem item, uint previous) {
+    return (item.flags & ITEM_ACTIVE) != 0u && ((item.flags & ITEM_NEW) != 0u || previous != 0u);
+}
+
+// =============================================================================
+// Phase 1 Draws
+// =============================================================================
+
+kernel void occlusion_prepare(
+    constant PrepareParams& params [[buffer(0)]],
+    const device OcclusionItem* items [[buffer(1)]],
+    const device uint* visible [[buffer(2)]],
+    device DrawCommand* args [[buffer(3)]],
+    uint i [[thread_position_in_grid]]
+) {
+    if (i >= params.info.x) return;
+
+    OcclusionItem item = items[i];
+    uint instances = drawn_in_phase_one(item, visible[i]) ? 1u : 0u;
+    args[i] = DrawCommand{item.vertex_count, instances, 0u, 0u};
+}
+
+// =============================================================================
+// Depth Pyramid (each texel = farthest depth of the texels it covers)
+// =============================================================================
+
+kernel void hiz_depth(
+    constant HiZParams& params [[buffer(0)]],
+    device float* pyramid [[buffer(1)]],
+    depth2d<float> depth [[texture(0)]],
+    sampler depth_sampler [[sampler(0)]],
+    uint2 p [[thread_position_in_grid]]
+) {
+    if (p.x >= params.dst.y || p.y >= params.dst.z) return;
+
+    uint2 limit = params.src.yz - 1u;
+    uint2 base = p * 2u;
+    float d = max(
+        max(depth.read(min(base, limit)), depth.read(min(base + uint2(1, 0), limit))),
+        max(depth.read(min(base + uint2(0, 1), limit)), depth.read(min(base + uint2(1, 1), limit))));
+
+    pyramid[params.dst.x + p.y * params.dst.y + p.x] = d;
+}
+
+kernel void hiz_reduce(
+    constant HiZParams& params [[buffer(0)]],
+    device float* pyramid [[buffer(1)]],
+    uint2 p [[thread_position_in_grid]]
+) {
+    if (p.x >= params.dst.y || p.y >= params.dst.z) return;
+
+    uint2 limit = params.src.yz - 1u;
+    uint2 base = p * 2u;
+    uint2 t0 = min(base, limit);
+    uint2 t1 = min(base + 1u, limit);
+    uint row0 = params.src.x + t0.y * params.src.y;
+    uint row1 = params.src.x + t1.y * params.src.y;
+    float d = max(max(pyramid[row0 + t0.x], pyramid[row0 + t1.x]),
+                  max(pyramid[row1 + t0.x], pyramid[row1 + t1.x]));
+
+    pyramid[params.dst.x + p.y * params.dst.y + p.x] = d;
+}
+
+// =============================================================================
+// Culling
+// =============================================================================
+
+static bool box_visible(constant CullParams& params, const device float* pyramid, float3 bmin, float3 bmax) {
+    float2 lo = float2(1e30);
+    float2 hi = float2(-1e30);
+    float zmin = 1e30;
+
+    for (uint c = 0; c < 8; c++) {
+        float3 corner = float3((c & 1u) ? bmax.x : bmin.x, (c & 2u) ? bmax.y : bmin.y, (c & 4u) ? bmax.z : bmin.z);
+        float4 clip = params.view_proj * float4(corner, 1.0);
+        if (clip.w <= 1e-6) return true;  // Box reaches behind the camera
+        float3 ndc = clip.xyz / clip.w;
+        lo = min(lo, ndc.xy);
+        hi = max(hi, ndc.xy);
+        zmin = min(zmin, ndc.z);
+    }
+
+    // Outside the view frustum
+    if (hi.x < -1.0 || hi.y < -1.0 || lo.x > 1.0 || lo.y > 1.0 || zmin > 1.0) return false;
+    // Crosses the near plane - no depth to compare against
+    if (zmin <= 0.0) return true;
+
+    // NDC → level-0 texels (top row first, level 0 is half resolution)
+    float2 half_size = params.viewport.xy * 0.5;
+    float2 pmin = clamp((float2(lo.x, -hi.y) * 0.5 + 0.5) * half_size, float2(0.0), half_size - 1.0);
+    float2 pmax = clamp((float2(hi.x, -lo.y) * 0.5 + 0.5) * half_size, float2(0.0), half_size - 1.0);
+
+    // Coarsest level where the rectangle spans at most 2x2 texels
+    float extent = max(pmax.x - pmin.x, pmax.y - pmin.y);
+    uint level = min(uint(ceil(log2(max(extent, 1.0)))), params.info.y - 1u);
+    uint4 L = params.levels[level];
+    float scale = 1.0 / float(1u << level);
+    uint2 t0 = min(uint2(pmin * scale), L.yz - 1u);
+    uint2 t1 = min(uint2(pmax * scale), L.yz - 1u);
+
+    float farthest = 0.0;
+    for (uint y = t0.y; y <= t1.y; y++) {
+        for (uint x = t0.x; x <= t1.x; x++) {
+            farthest = max(farthest, pyramid[L.x + y * L.y + x]);
+        }
+    }
+    return zmin <= farthest;
+}
+
+kernel void occlusion_cull(
+    constant CullParams& params [[buffer(0)]],
+    const device OcclusionItem* items [[buffer(1)]],
+    const device float* pyramid [[buffer(2)]],
+    device DrawCommand* args [[buffer(3)]],
+    device uint* visible [[buffer(4)]],
+    uint i [[thread_position_in_grid]]
+) {
+    if (i >= params.info.x) return;
+
+    OcclusionItem item = items[i];
+    bool drawn = drawn_in_phase_one(item, visible[i]);
+    bool now_visible = (item.flags & ITEM_ACTIVE) != 0u && box_visible(params, pyramid, item.bbox_min.xyz, item.bbox_max.xyz);
+
+    // Phase 2 draws what phase 1 skipped but is visible now
+    args[params.info.z + i] = DrawCommand{item.vertex_count, (now_visible && !drawn) ? 1u : 0u, 0u, 0u};
+    visible[i] = now_visible ? 1u : 0u;
+}
@@ -0,0 +1,95 @@
+// OhCAD Metal Shaders - Instanced point sprites (sketch points and handles)
+// One static quad is expanded per instance in screen space; the fragment shader
+// shapes it with a signed distance field so all point styles share one draw call.
+#include <metal_stdlib>
+using namespace metal;
+
+// =============================================================================
+// Vertex/Fragment Data Structures
+// =============================================================================
+
+// Point styles (must match PointStyle enum in point_sprites_gpu.odin)
+constant uint POINT_STYLE_CIRCLE = 0;
+constant uint POINT_STYLE_SQUARE = 1;
+constant uint POINT_STYLE_RING   = 2;
+
+// Antialiasing margin around each sprite in pixels
+constant float POINT_AA_MARGIN = 1.5;
+
+// Slot 0: static quad corner (per vertex), slot 1: point instance (per instance)
+struct PointSpriteIn {
+    float2 corner   [[attribute(0)]];  // Quad corner in [-1, 1]
+    float3 center   [[attribute(1)]];  // World-space point position
+    float  radius   [[attribute(2)]];  // Radius in pixels
+    float4 color    [[attribute(3)]];  // RGBA color
+    uint   style    [[attribute(4)]];  // PointStyle
+};
+
+// Output from vertex shader, input to fragment shader
+struct PointSpriteOut {
+    float4 position [[position]];  // Clip-space position
+    float2 local;                  // Offset from point center in pixels
+    float  radius [[flat]];
+    float4 color  [[flat]];
+    uint   style  [[flat]];
+};
+
+// Uniform data passed via push constants
+struct PointSpriteUniforms {
+    float4x4 mvp;          // Model-View-Projection matrix
+    float2 viewportSize;   // Viewport size in pixels
+    float2 _pad;
+};
+
+// =============================================================================
+// Vertex Shader
+// =============================================================================
+
+vertex PointSpriteOut point_sprite_vertex_main(
+    PointSpriteIn in [[stage_in]],
+    constant PointSpriteUniforms& uniforms [[buffer(0)]]
+) {
+    PointSpriteOut out;
+
+    float4 clip = uniforms.mvp * float4(in.center, 1.0);
+
+    // Expand the quad in pixels, then convert to clip space so the size is
+    // constant on screen regardless of zoom or projection mode
+    float2 offset_px = in.corner * (in.radius + POINT_AA_MARGIN);
+    clip.xy += offset_px * 2.0 / uniforms.viewportSize * clip.w;
+
+    out.position = clip;
+    out.local = offset_px;
+    out.radius = in.radius;
+    out.color = in.color;
+    out.style = in.style;
+    return out;
+}
+
+// =============================================================================
+// Fragment Shader - SDF shapes
+// =============================================================================
+
+fragment float4 point_sprite_fragment_main(PointSpriteOut in [[stage_in]]) {
+    float d;
+
+    if (in.style == POINT_STYLE_SQUARE) {
+        // Slightly smaller half-size so squares read the same weight as circles
+        float2 q = abs(in.local) - float2(in.radius * 0.85);
+        d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0);
+    } else if (in.style == POINT_STYLE_RING) {
+        float thickness = max(in.radius * 0.3, 1.0);
+        d = abs(length(in.local) - (in.radius - thickness)) - thickness;
+    } else {
+        d = length(in.local) - in.radius;
+    }
+
+    // Distances are in pixels, so a one-pixel ramp gives clean edges
+    float aa = max(fwidth(d), 1e-4);
+    float coverage = saturate(0.5 - d / aa);
+    if (coverage <= 0.0) {
+        discard_fragment();
+    }
+
+    return float4(in.color.rgb, in.color.a * coverage);
+}
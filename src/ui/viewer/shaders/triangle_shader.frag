@@ -0,0 +1,30 @@
+// OhCAD SPIR-V shaders (Vulkan / headless rendering) - lit triangles, fragment stage
+// GLSL port of triangle_fragment_main in triangle_shader.metal; keep the two in sync
+// SDL3 GPU binds fragment-stage uniform buffers at set 3
+#version 450
+
+layout(location = 0) in vec3 in_normal;
+layout(location = 1) in vec3 in_world_pos;
+
+layout(location = 0) out vec4 out_color;
+
+layout(std140, set = 3, binding = 0) uniform TriangleUniforms {
+    mat4 mvp;
+    mat4 model;
+    vec4 baseColor;
+    vec3 lightDir;
+    float ambientStrength;
+} uniforms;
+
+void main() {
+    vec3 normal = normalize(in_normal);
+
+    // CAD lighting: 50% ambient + 50% directional (same as the Metal shader)
+    vec3 ambient = 0.50 * uniforms.baseColor.rgb;
+
+    vec3 light_dir = normalize(-uniforms.lightDir);
+    float diffuse_strength = max(dot(normal, light_dir), 0.0);
+    vec3 diffuse = diffuse_strength * uniforms.baseColor.rgb * 0.50;
+
+    out_color = vec4(ambient + diffuse, uniforms.baseColor.a);
+}
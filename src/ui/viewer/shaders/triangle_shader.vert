@@ -0,0 +1,24 @@
+// OhCAD SPIR-V shaders (Vulkan / headless rendering) - lit triangles, vertex stage
+// GLSL port of triangle_vertex_main in triangle_shader.metal; keep the two in sync
+// SDL3 GPU binds vertex-stage uniform buffers at set 1
+#version 450
+
+layout(location = 0) in vec3 in_position;  // 3D position
+layout(location = 1) in vec3 in_normal;    // Vertex normal
+
+layout(location = 0) out vec3 out_normal;     // World-space normal
+layout(location = 1) out vec3 out_world_pos;  // World-space position
+
+layout(std140, set = 1, binding = 0) uniform TriangleUniforms {
+    mat4 mvp;               // Model-View-Projection matrix
+    mat4 model;             // Model matrix (for normal transformation)
+    vec4 baseColor;         // Base material color (RGBA)
+    vec3 lightDir;          // Directional light direction (world space)
+    float ambientStrength;  // Ambient light strength (0-1)
+} uniforms;
+
+void main() {
+    gl_Position = uniforms.mvp * vec4(in_position, 1.0);
+    out_normal = normalize((uniforms.model * vec4(in_normal, 0.0)).xyz);
+    out_world_pos = (uniforms.model * vec4(in_position, 1.0)).xyz;
+}
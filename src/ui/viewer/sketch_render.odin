@@ -68,6 +68,9 @@ sketch_to_wireframe :: proc(sk: ^sketch.Sketch2D) -> WireframeMesh {
         case sketch.SketchArc:
             // TODO: Implement arc rendering
             fmt.println("Arc rendering not yet implemented")
+        
+        case sketch.SketchSpline:
+            wireframe_mesh_add_spline(&mesh, sk, e)
         }
     }
 
@@ -125,11 +128,29 @@ sketch_to_wireframe_selected :: proc(sk: ^sketch.Sketch2D) -> WireframeMesh {
 
     case sketch.SketchArc:
         // TODO: Arc rendering
+
+    case sketch.SketchSpline:
+        wireframe_mesh_add_spline(&mesh, sk, e)
     }
 
     return mesh
 }
 
+// Add a sketch spline to wireframe mesh (flattened to its polyline)
+wireframe_mesh_add_spline :: proc(mesh: ^WireframeMesh, sk: ^sketch.Sketch2D, spline: sketch.SketchSpline) {
+    polyline := make([dynamic]m.Vec2, 0, 64, context.temp_allocator)
+    if !sketch.sketch_flatten_spline(sk, spline, &polyline) || len(polyline) < 2 {
+        return
+    }
+
+    prev := sketch.sketch_to_world(&sk.plane, polyline[0])
+    for p in polyline[1:] {
+        cur := sketch.sketch_to_world(&sk.plane, p)
+        wireframe_mesh_add_edge(mesh, prev, cur)
+        prev = cur
+    }
+}
+
 // Render sketch points (vertices) as actual filled circular dots with screen-space constant size
 render_sketch_points :: proc(shader: ^LineShader, sk: ^sketch.Sketch2D, mvp: glsl.mat4, color: [4]f32, point_size_pixels: f32, viewport_height: f32, fov: f32, camera_distance: f32) {
     // Calculate screen-space to world-space conversion
@@ -531,6 +552,13 @@ render_equal_icon :: proc(shader: ^LineShader, sk: ^sketch.Sketch2D, data: sketc
     case sketch.SketchArc:
         // TODO: Arc support
         return
+    case sketch.SketchSpline:
+        // Marker at the curve's midpoint between its endpoints
+        start_id, end_id := sketch.spline_endpoints(sk, e)
+        p1 := sketch.sketch_get_point(sk, start_id)
+        p2 := sketch.sketch_get_point(sk, end_id)
+        if p1 == nil || p2 == nil do return
+        pos_2d = m.Vec2{(p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5}
     }
 
     // Draw equal symbol (two horizontal lines)
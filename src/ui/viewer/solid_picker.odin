@@ -0,0 +1,711 @@
+// ui/viewer - Edge and vertex picking for solids (screen-space segment grid)
+// Feature edges are projected once per camera change and binned into a grid of
+// PICK_CELL_SIZE_PX cells, so hover queries only look at the cells around the cursor.
+// Occlusion is resolved with a per-solid triangle BVH (built once per geometry change).
+// Placed bodies keep their mesh (and BVH) in mesh space; rays are moved into it through the
+// inverse placement, so moving a body only swaps its matrices.
+package ohcad_viewer
+
+import "core:math"
+import "core:slice"
+import m "../../core/math"
+import extrude "../../features/extrude"
+import glsl "core:math/linalg/glsl"
+
+// Grid cell size in pixels (pick tolerances should not exceed this)
+PICK_CELL_SIZE_PX :: 16
+
+// Default hover tolerances in pixels
+PICK_EDGE_TOLERANCE_PX :: 6.0
+PICK_VERTEX_TOLERANCE_PX :: 8.0
+
+// Triangles per BVH leaf
+PICK_BVH_LEAF_SIZE :: 4
+
+// =============================================================================
+// Types
+// =============================================================================
+
+PickKind :: enum {
+    None,
+    Vertex,
+    Edge,
+}
+
+// Result of a pick query
+PickResult :: struct {
+    kind: PickKind,
+    feature_id: int,
+    index: int,              // Index into solid.vertices or solid.edges
+    world_point: m.Vec3,     // Vertex position or closest point on the edge
+    distance_px: f32,        // Screen distance from the cursor
+}
+
+// A solid that participates in picking
+PickSolid :: struct {
+    feature_id: int,
+    solid: ^extrude.SimpleSolid,
+    placed: bool,            // Solid is in mesh space, drawn through transform
+    transform: m.Mat4,       // Mesh space → world (only when placed)
+}
+
+// Projected edge (screen space)
+@(private="file")
+PickEdge :: struct {
+    a, b: [2]f32,       // Screen-space endpoints (pixels)
+    wa, wb: f32,        // Clip w of endpoints (perspective-correct interpolation)
+    solid: i32,         // Index into picker.solids
+    edge: i32,          // Index into solid.edges
+}
+
+// Projected vertex (screen space)
+@(private="file")
+PickVertex :: struct {
+    p: [2]f32,
+    solid: i32,
+    vertex: i32,
+}
+
+// Flattened BVH node (leaf when count > 0)
+@(private="file")
+BVHNode :: struct {
+    lo, hi: [3]f64,
+    first: i32,         // Leaf: first triangle in tri_order; inner: left child (right = first + 1)
+    count: i32,
+}
+
+// Triangle BVH of one solid, used for occlusion rays
+@(private="file")
+PickBVH :: struct {
+    nodes: [dynamic]BVHNode,
+    tri_order: [dynamic]i32,
+}
+
+// Picking acceleration state
+SolidPicker :: struct {
+    solids: [dynamic]PickSolid,
+    bvhs: [dynamic]PickBVH,          // One per solid, in the solid's mesh space
+    inverses: [dynamic]m.Mat4,       // World → mesh space, one per solid
+
+    // Screen-space grid (rebuilt when the camera or viewport changes)
+    edges: [dynamic]PickEdge,
+    vertices: [dynamic]PickVertex,
+    cols, rows: int,
+    edge_cell_start: [dynamic]i32,   // CSR offsets, cols*rows + 1
+    edge_cell_items: [dynamic]i32,
+    vertex_cell_start: [dynamic]i32,
+    vertex_cell_items: [dynamic]i32,
+
+    // Camera state the grid was built for
+    grid_mvp: matrix[4,4]f32,
+    grid_width, grid_height: u32,
+    grid_valid: bool,
+}
+
+// =============================================================================
+// Lifetime
+// =============================================================================
+
+solid_picker_destroy :: proc(picker: ^SolidPicker) {
+    solid_picker_clear_solids(picker)
+    delete(picker.solids)
+    delete(picker.bvhs)
+    delete(picker.inverses)
+    delete(picker.edges)
+    delete(picker.vertices)
+    delete(picker.edge_cell_start)
+    delete(picker.edge_cell_items)
+    delete(picker.vertex_cell_start)
+    delete(picker.vertex_cell_items)
+}
+
+@(private="file")
+solid_picker_clear_solids :: proc(picker: ^SolidPicker) {
+    for &bvh in picker.bvhs {
+        delete(bvh.nodes)
+        delete(bvh.tri_order)
+    }
+    clear(&picker.bvhs)
+    clear(&picker.inverses)
+    clear(&picker.solids)
+    picker.grid_valid = false
+}
+
+@(private="file")
+pick_solid_inverse :: proc(entry: PickSolid) -> m.Mat4 {
+    return entry.placed ? glsl.inverse(entry.transform) : m.Mat4(1)
+}
+
+// Replace the pickable solids (call whenever solids are regenerated)
+solid_picker_set_solids :: proc(picker: ^SolidPicker, solids: []PickSolid) {
+    solid_picker_clear_solids(picker)
+
+    for entry in solids {
+        if entry.solid == nil do continue
+        append(&picker.solids, entry)
+        append(&picker.bvhs, pick_bvh_build(entry.solid))
+        append(&picker.inverses, pick_solid_inverse(entry))
+    }
+}
+
+// Update one feature's pickable solid in place; a placement-only change keeps its BVH
+// Returns false if the feature is not in the picker.
+solid_picker_update_solid :: proc(picker: ^SolidPicker, entry: PickSolid, geometry_changed: bool) -> bool {
+    for &existing, si in picker.solids {
+        if existing.feature_id != entry.feature_id do continue
+        if entry.solid == nil do return false
+
+        if geometry_changed {
+            delete(picker.bvhs[si].nodes)
+            delete(picker.bvhs[si].tri_order)
+            picker.bvhs[si] = pick_bvh_build(entry.solid)
+        }
+        existing = entry
+        picker.inverses[si] = pick_solid_inverse(entry)
+        picker.grid_valid = false
+        return true
+    }
+    return false
+}
+
+// Mesh-space position of a pickable solid → world
+@(private="file")
+pick_solid_to_world :: proc(entry: PickSolid, p: m.Vec3) -> m.Vec3 {
+    if !entry.placed {
+        return p
+    }
+    return (entry.transform * m.Vec4{p.x, p.y, p.z, 1}).xyz
+}
+
+// World ray → a solid's mesh space (placements are rigid, so ray distances are unchanged)
+@(private="file")
+pick_ray_to_local :: proc(picker: ^SolidPicker, si: int, origin, dir: m.Vec3) -> (local_origin, local_dir: m.Vec3) {
+    if !picker.solids[si].placed {
+        return origin, dir
+    }
+    inv := picker.inverses[si]
+    return (inv * m.Vec4{origin.x, origin.y, origin.z, 1}).xyz, (inv * m.Vec4{dir.x, dir.y, dir.z, 0}).xyz
+}
+
+// =============================================================================
+// Grid Build
+// =============================================================================
+
+// Rebuild the screen-space grid if the camera or viewport changed since the last build
+solid_picker_update :: proc(picker: ^SolidPicker, viewer: ^ViewerGPU) {
+    view := camera_get_view_matrix(&viewer.camera)
+    proj := camera_get_projection_matrix(&viewer.camera)
+    mvp := proj * view
+
+    if picker.grid_valid &&
+       picker.grid_mvp == mvp &&
+       picker.grid_width == viewer.window_width &&
+       picker.grid_height == viewer.window_height {
+        return
+    }
+
+    picker.grid_mvp = mvp
+    picker.grid_width = viewer.window_width
+    picker.grid_height = viewer.window_height
+    picker.grid_valid = true
+
+    width := f32(viewer.window_width)
+    height := f32(viewer.window_height)
+    picker.cols = max(int(viewer.window_width + PICK_CELL_SIZE_PX - 1) / PICK_CELL_SIZE_PX, 1)
+    picker.rows = max(int(viewer.window_height + PICK_CELL_SIZE_PX - 1) / PICK_CELL_SIZE_PX, 1)
+
+    clear(&picker.edges)
+    clear(&picker.vertices)
+
+    for entry, si in picker.solids {
+        solid := entry.solid
+        solid_mvp := mvp
+        if entry.placed {
+            solid_mvp = mvp * mat4_to_f32(entry.transform)
+        }
+
+        for vertex, vi in solid.vertices {
+            p, _, visible := project_to_screen(solid_mvp, vertex.position, width, height)
+            if visible {
+                append(&picker.vertices, PickVertex{p = p, solid = i32(si), vertex = i32(vi)})
+            }
+        }
+
+        for edge, ei in solid.edges {
+            a, wa, va := project_to_screen(solid_mvp, edge.v0.position, width, height)
+            b, wb, vb := project_to_screen(solid_mvp, edge.v1.position, width, height)
+            if !va || !vb do continue  // Edges crossing the near plane are not pickable
+
+            append(&picker.edges, PickEdge{a = a, b = b, wa = wa, wb = wb, solid = i32(si), edge = i32(ei)})
+        }
+    }
+
+    // Bin into CSR cell lists (count pass, then fill pass)
+    cell_count := picker.cols * picker.rows
+    resize(&picker.edge_cell_start, cell_count + 1)
+    resize(&picker.vertex_cell_start, cell_count + 1)
+    slice.zero(picker.edge_cell_start[:])
+    slice.zero(picker.vertex_cell_start[:])
+
+    edge_cursor := make([]i32, cell_count)
+    vertex_cursor := make([]i32, cell_count)
+    defer delete(edge_cursor)
+    defer delete(vertex_cursor)
+
+    for pass in 0..<2 {
+        fill := pass == 1
+        if fill {
+            prefix_sum(picker.edge_cell_start[:])
+            prefix_sum(picker.vertex_cell_start[:])
+            resize(&picker.edge_cell_items, int(picker.edge_cell_start[cell_count]))
+            resize(&picker.vertex_cell_items, int(picker.vertex_cell_start[cell_count]))
+        }
+
+        for ei in 0..<len(picker.edges) {
+            bin_segment(picker, picker.edges[ei].a, picker.edges[ei].b, i32(ei), fill, edge_cursor)
+        }
+
+        for vi in 0..<len(picker.vertices) {
+            cell, ok := cell_of(picker, picker.vertices[vi].p)
+            if !ok do continue
+            if fill {
+                picker.vertex_cell_items[picker.vertex_cell_start[cell] + vertex_cursor[cell]] = i32(vi)
+                vertex_cursor[cell] += 1
+            } else {
+                picker.vertex_cell_start[cell + 1] += 1
+            }
+        }
+    }
+}
+
+// Turn per-cell counts stored at [cell + 1] into start offsets
+@(private="file")
+prefix_sum :: proc(starts: []i32) {
+    for i in 1..<len(starts) {
+        starts[i] += starts[i - 1]
+    }
+}
+
+@(private="file")
+cell_of :: proc(picker: ^SolidPicker, p: [2]f32) -> (int, bool) {
+    cx := int(math.floor(p.x / PICK_CELL_SIZE_PX))
+    cy := int(math.floor(p.y / PICK_CELL_SIZE_PX))
+    if cx < 0 || cy < 0 || cx >= picker.cols || cy >= picker.rows {
+        return 0, false
+    }
+    return cy * picker.cols + cx, true
+}
+
+// Insert an edge into every cell its segment passes through (half-cell stepping;
+// queries scan a neighborhood, so corner-clipped cells are still found)
+// The segment is clipped to the grid first, so the step count is bounded by the viewport
+// size even for edges that project far off screen near the near plane.
+@(private="file")
+bin_segment :: proc(picker: ^SolidPicker, a, b: [2]f32, item: i32, fill: bool, cursor: []i32) {
+    grid_size := [2]f32{f32(picker.cols), f32(picker.rows)} * PICK_CELL_SIZE_PX
+    start, end, inside := clip_segment_to_rect(a, b, {0, 0}, grid_size)
+    if !inside do return
+
+    d := end - start
+    steps := int(math.ceil(max(abs(d.x), abs(d.y)) / (PICK_CELL_SIZE_PX * 0.5))) + 1
+    last_cell := -1
+
+    for s in 0..=steps {
+        p := start + d * (f32(s) / f32(steps))
+        cell, ok := cell_of(picker, p)
+        if !ok || cell == last_cell do continue
+        last_cell = cell
+
+        if fill {
+            picker.edge_cell_items[picker.edge_cell_start[cell] + cursor[cell]] = item
+            cursor[cell] += 1
+        } else {
+            picker.edge_cell_start[cell + 1] += 1
+        }
+    }
+}
+
+// Liang-Barsky clip of segment ab to the rectangle [lo, hi]
+@(private="file")
+clip_segment_to_rect :: proc(a, b, lo, hi: [2]f32) -> (ca, cb: [2]f32, inside: bool) {
+    d := b - a
+    t0, t1 := f32(0), f32(1)
+
+    for axis in 0..<2 {
+        if d[axis] == 0 {
+            if a[axis] < lo[axis] || a[axis] > hi[axis] do return {}, {}, false
+            continue
+        }
+        ta := (lo[axis] - a[axis]) / d[axis]
+        tb := (hi[axis] - a[axis]) / d[axis]
+        if ta > tb do ta, tb = tb, ta
+        t0 = max(t0, ta)
+        t1 = min(t1, tb)
+        if t0 > t1 do return {}, {}, false
+    }
+
+    return a + d * t0, a + d * t1, true
+}
+
+// f64 model matrix → GPU matrix
+mat4_to_f32 :: proc(mat: m.Mat4) -> (out: matrix[4,4]f32) {
+    for r in 0..<4 {
+        for c in 0..<4 {
+            out[r, c] = f32(mat[r, c])
+        }
+    }
+    return
+}
+
+// World → screen pixels (origin top-left); visible = in front of the camera
+@(private="file")
+project_to_screen :: proc(mvp: matrix[4,4]f32, p: m.Vec3, width, height: f32) -> (screen: [2]f32, w: f32, visible: bool) {
+    clip := mvp * glsl.vec4{f32(p.x), f32(p.y), f32(p.z), 1.0}
+    if clip.w <= 1e-6 {
+        return {}, clip.w, false
+    }
+
+    ndc_x := clip.x / clip.w
+    ndc_y := clip.y / clip.w
+    screen = {(ndc_x * 0.5 + 0.5) * width, (0.5 - ndc_y * 0.5) * height}
+    return screen, clip.w, true
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// Nearest visible vertex (preferred) or edge within the given pixel tolerances
+solid_picker_pick :: proc(
+    picker: ^SolidPicker,
+    viewer: ^ViewerGPU,
+    screen_x, screen_y: f32,
+    edge_tolerance_px: f32 = PICK_EDGE_TOLERANCE_PX,
+    vertex_tolerance_px: f32 = PICK_VERTEX_TOLERANCE_PX,
+) -> PickResult {
+    solid_picker_update(picker, viewer)
+
+    cursor := [2]f32{screen_x, screen_y}
+    best := PickResult{kind = .None, distance_px = max(f32)}
+
+    cx := int(math.floor(screen_x / PICK_CELL_SIZE_PX))
+    cy := int(math.floor(screen_y / PICK_CELL_SIZE_PX))
+    radius := int(math.ceil(max(edge_tolerance_px, vertex_tolerance_px) / PICK_CELL_SIZE_PX))
+
+    // Vertices first - snapping to a vertex wins over the edges that meet there
+    for y in cy - radius..=cy + radius {
+        for x in cx - radius..=cx + radius {
+            if x < 0 || y < 0 || x >= picker.cols || y >= picker.rows do continue
+            cell := y * picker.cols + x
+
+            for i in picker.vertex_cell_start[cell]..<picker.vertex_cell_start[cell + 1] {
+                pv := picker.vertices[picker.vertex_cell_items[i]]
+                dist := glsl.length(pv.p - cursor)
+                if dist > vertex_tolerance_px || dist >= best.distance_px do continue
+
+                entry := picker.solids[pv.solid]
+                world := pick_solid_to_world(entry, entry.solid.vertices[pv.vertex].position)
+                if point_occluded(picker, viewer, world) do continue
+
+                best = PickResult{
+                    kind = .Vertex,
+                    feature_id = entry.feature_id,
+                    index = int(pv.vertex),
+                    world_point = world,
+                    distance_px = dist,
+                }
+            }
+        }
+    }
+
+    if best.kind == .Vertex {
+        return best
+    }
+
+    for y in cy - radius..=cy + radius {
+        for x in cx - radius..=cx + radius {
+            if x < 0 || y < 0 || x >= picker.cols || y >= picker.rows do continue
+            cell := y * picker.cols + x
+
+            for i in picker.edge_cell_start[cell]..<picker.edge_cell_start[cell + 1] {
+                pe := picker.edges[picker.edge_cell_items[i]]
+
+                // Closest point on the projected segment
+                d := pe.b - pe.a
+                len_sq := glsl.dot(d, d)
+                t: f32 = 0
+                if len_sq > 1e-12 {
+                    t = clamp(glsl.dot(cursor - pe.a, d) / len_sq, 0, 1)
+                }
+                dist := glsl.length(pe.a + d * t - cursor)
+                if dist > edge_tolerance_px || dist >= best.distance_px do continue
+
+                // Perspective-correct parameter along the world-space edge
+                tw := f64((t / pe.wb) / ((1 - t) / pe.wa + t / pe.wb))
+                entry := picker.solids[pe.solid]
+                edge := entry.solid.edges[pe.edge]
+                world := pick_solid_to_world(entry, edge.v0.position + (edge.v1.position - edge.v0.position) * tw)
+                if point_occluded(picker, viewer, world) do continue
+
+                best = PickResult{
+                    kind = .Edge,
+                    feature_id = entry.feature_id,
+                    index = int(pe.edge),
+                    world_point = world,
+                    distance_px = dist,
+                }
+            }
+        }
+    }
+
+    return best
+}
+
+// True if any solid surface lies between the point and the camera
+@(private="file")
+point_occluded :: proc(picker: ^SolidPicker, viewer: ^ViewerGPU, point: m.Vec3) -> bool {
+    camera := &viewer.camera
+
+    dir: m.Vec3
+    max_t: f64
+    if camera.projection_mode == .Orthographic {
+        dir = camera.position - camera.target
+        max_t = math.INF_F64
+    } else {
+        dir = camera.position - point
+    }
+
+    dir_len := glsl.length(dir)
+    if dir_len < 1e-12 do return false
+    dir /= dir_len
+    if camera.projection_mode != .Orthographic do max_t = dir_len
+
+    // Start slightly off the surface the point lies on (scaled to the model size)
+    eps := 1e-4 * max(f64(camera.distance), 1.0)
+    origin := point + dir * eps
+
+    for &bvh, si in picker.bvhs {
+        local_origin, local_dir := pick_ray_to_local(picker, si, origin, dir)
+        if pick_bvh_any_hit(&bvh, picker.solids[si].solid, local_origin, local_dir, max_t - eps) {
+            return true
+        }
+    }
+    return false
+}
+
+// Nearest solid surface along a ray (face picking): owning feature and hit distance
+solid_picker_ray_nearest :: proc(picker: ^SolidPicker, origin, dir: m.Vec3) -> (feature_id: int, t: f64, hit: bool) {
+    t = math.INF_F64
+    for &bvh, si in picker.bvhs {
+        local_origin, local_dir := pick_ray_to_local(picker, si, origin, dir)
+        if solid_t, solid_hit := pick_bvh_nearest_hit(&bvh, picker.solids[si].solid, local_origin, local_dir, t); solid_hit {
+            t = solid_t
+            feature_id = picker.solids[si].feature_id
+            hit = true
+        }
+    }
+    return
+}
+
+// =============================================================================
+// Triangle BVH
+// =============================================================================
+
+@(private="file")
+tri_bounds :: proc(tri: extrude.Triangle3D) -> (lo, hi: [3]f64) {
+    lo = {min(tri.v0.x, tri.v1.x, tri.v2.x), min(tri.v0.y, tri.v1.y, tri.v2.y), min(tri.v0.z, tri.v1.z, tri.v2.z)}
+    hi = {max(tri.v0.x, tri.v1.x, tri.v2.x), max(tri.v0.y, tri.v1.y, tri.v2.y), max(tri.v0.z, tri.v1.z, tri.v2.z)}
+    return
+}
+
+// Median-split BVH over solid.triangles
+@(private="file")
+pick_bvh_build :: proc(solid: ^extrude.SimpleSolid) -> PickBVH {
+    bvh: PickBVH
+    n := len(solid.triangles)
+    if n == 0 {
+        return bvh
+    }
+
+    bvh.tri_order = make([dynamic]i32, n)
+    centroids := make([][3]f64, n)
+    defer delete(centroids)
+    for tri, i in solid.triangles {
+        bvh.tri_order[i] = i32(i)
+        c := (tri.v0 + tri.v1 + tri.v2) / 3.0
+        centroids[i] = {c.x, c.y, c.z}
+    }
+
+    bvh.nodes = make([dynamic]BVHNode, 0, 2 * n / PICK_BVH_LEAF_SIZE + 1)
+    append(&bvh.nodes, BVHNode{})
+
+    // Explicit stack of (node, first, count)
+    Range :: struct { node, first, count: int }
+    stack := make([dynamic]Range, 0, 64)
+    defer delete(stack)
+    append(&stack, Range{0, 0, n})
+
+    for len(stack) > 0 {
+        r := pop(&stack)
+        order := bvh.tri_order[r.first:r.first + r.count]
+
+        lo, hi := tri_bounds(solid.triangles[order[0]])
+        for idx in order[1:] {
+            tlo, thi := tri_bounds(solid.triangles[idx])
+            lo = {min(lo.x, tlo.x), min(lo.y, tlo.y), min(lo.z, tlo.z)}
+            hi = {max(hi.x, thi.x), max(hi.y, thi.y), max(hi.z, thi.z)}
+        }
+
+        node := &bvh.nodes[r.node]
+        node.lo = lo
+        node.hi = hi
+
+        if r.count <= PICK_BVH_LEAF_SIZE {
+            node.first = i32(r.first)
+            node.count = i32(r.count)
+            continue
+        }
+
+        // Split at the median centroid along the longest axis
+        ext := hi - lo
+        axis := 0
+        if ext.y > ext[axis] do axis = 1
+        if ext.z > ext[axis] do axis = 2
+
+        sort_by_axis(order, centroids, axis)
+
+        left := len(bvh.nodes)
+        node.first = i32(left)
+        node.count = 0
+        append(&bvh.nodes, BVHNode{}, BVHNode{})
+
+        half := r.count / 2
+        append(&stack, Range{left, r.first, half})
+        append(&stack, Range{left + 1, r.first + half, r.count - half})
+    }
+
+    return bvh
+}
+
+// Sort triangle indices by centroid along axis
+// (slice.sort_by can't capture the centroid table, so this is a small keyed quicksort)
+@(private="file")
+sort_by_axis :: proc(order: []i32, centroids: [][3]f64, axis: int) {
+    quick :: proc(order: []i32, centroids: [][3]f64, axis: int) {
+        for len(order) > 16 {
+            pivot := centroids[order[len(order) / 2]][axis]
+            i, j := 0, len(order) - 1
+            for i <= j {
+                for centroids[order[i]][axis] < pivot do i += 1
+                for centroids[order[j]][axis] > pivot do j -= 1
+                if i <= j {
+                    order[i], order[j] = order[j], order[i]
+                    i += 1
+                    j -= 1
+                }
+            }
+            if j + 1 < len(order) - i {
+                quick(order[:j + 1], centroids, axis)
+                order = order[i:]
+            } else {
+                quick(order[i:], centroids, axis)
+                order = order[:j + 1]
+            }
+        }
+
+        for k in 1..<len(order) {
+            x := order[k]
+            key := centroids[x][axis]
+            l := k - 1
+            for l >= 0 && centroids[order[l]][axis] > key {
+                order[l + 1] = order[l]
+                l -= 1
+            }
+            order[l + 1] = x
+        }
+    }
+
+    quick(order, centroids, axis)
+}
+
+@(private="file")
+ray_box :: proc(lo, hi: [3]f64, origin, inv_dir: m.Vec3, max_t: f64) -> bool {
+    t0: f64 = 0
+    t1 := max_t
+    for k in 0..<3 {
+        ta := (lo[k] - origin[k]) * inv_dir[k]
+        tb := (hi[k] - origin[k]) * inv_dir[k]
+        if ta > tb do ta, tb = tb, ta
+        t0 = max(t0, ta)
+        t1 = min(t1, tb)
+        if t0 > t1 do return false
+    }
+    return true
+}
+
+@(private="file")
+pick_bvh_any_hit :: proc(bvh: ^PickBVH, solid: ^extrude.SimpleSolid, origin, dir: m.Vec3, max_t: f64) -> bool {
+    if len(bvh.nodes) == 0 do return false
+
+    inv_dir := m.Vec3{1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z}
+
+    // Growable: a full fixed stack would silently drop subtrees and miss occluders
+    stack := make([dynamic]i32, 0, 64, context.temp_allocator)
+    append(&stack, 0)
+
+    for len(stack) > 0 {
+        node := bvh.nodes[pop(&stack)]
+        if !ray_box(node.lo, node.hi, origin, inv_dir, max_t) do continue
+
+        if node.count > 0 {
+            // Leaf triangles go through the 4-wide robust ray-triangle predicate together
+            leaf: [PICK_BVH_LEAF_SIZE]m.TrianglePoints
+            for idx, k in bvh.tri_order[node.first:node.first + node.count] {
+                tri := solid.triangles[idx]
+                leaf[k] = {tri.v0, tri.v1, tri.v2}
+            }
+            if m.ray_triangles_any_hit(origin, dir, leaf[:node.count], max_t) do return true
+        } else {
+            append(&stack, node.first, node.first + 1)
+        }
+    }
+
+    return false
+}
+
+// Closest triangle hit with 0 < t < max_t (children are culled against the best hit so far)
+@(private="file")
+pick_bvh_nearest_hit :: proc(bvh: ^PickBVH, solid: ^extrude.SimpleSolid, origin, dir: m.Vec3, max_t: f64) -> (t: f64, hit: bool) {
+    if len(bvh.nodes) == 0 do return max_t, false
+
+    inv_dir := m.Vec3{1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z}
+    t = max_t
+
+    stack := make([dynamic]i32, 0, 64, context.temp_allocator)
+    append(&stack, 0)
+
+    for len(stack) > 0 {
+        node := bvh.nodes[pop(&stack)]
+        if !ray_box(node.lo, node.hi, origin, inv_dir, t) do continue
+
+        if node.count > 0 {
+            leaf: [PICK_BVH_LEAF_SIZE]m.TrianglePoints
+            leaf_t: [PICK_BVH_LEAF_SIZE]f64
+            for idx, k in bvh.tri_order[node.first:node.first + node.count] {
+                tri := solid.triangles[idx]
+                leaf[k] = {tri.v0, tri.v1, tri.v2}
+            }
+            m.ray_triangles_batch(origin, dir, leaf[:node.count], leaf_t[:])
+            for k in 0..<node.count {
+                if leaf_t[k] > 0 && leaf_t[k] < t {
+                    t = leaf_t[k]
+                    hit = true
+                }
+            }
+        } else {
+            append(&stack, node.first, node.first + 1)
+        }
+    }
+
+    return
+}
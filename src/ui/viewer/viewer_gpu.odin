@@ -41,6 +41,7 @@ ViewerGPUConfig :: struct {
     window_height: i32,
     window_title: cstring,
     shader_path: string,
+    headless: bool,  // No window or swapchain - render into OffscreenTargets only (thumbnails, batch previews)
 }
 
 DEFAULT_GPU_CONFIG :: ViewerGPUConfig{
@@ -50,14 +51,27 @@ DEFAULT_GPU_CONFIG :: ViewerGPUConfig{
     shader_path = "src/ui/viewer/shaders/line_shader.metallib",  // Relative to project root
 }
 
+// Headless rendering on any backend: Metal, or Vulkan (including lavapipe) with the SPIR-V shaders
+// Width/height are only the default camera aspect - each OffscreenTarget has its own size
+HEADLESS_GPU_CONFIG :: ViewerGPUConfig{
+    window_width = 512,
+    window_height = 512,
+    window_title = "OhCAD (headless)",
+    shader_path = "src/ui/viewer/shaders/line_shader.metallib",
+    headless = true,
+}
+
 // =============================================================================
 // SDL3 GPU Viewer State
 // =============================================================================
 
 ViewerGPU :: struct {
-    // SDL3 window and GPU device
+    // SDL3 window and GPU device (window is nil when headless)
     window: ^sdl.Window,
     gpu_device: ^sdl.GPUDevice,
+    headless: bool,
+    color_format: sdl.GPUTextureFormat,  // Swapchain format, or the offscreen target format when headless
+    depth_format: sdl.GPUTextureFormat,  // Depth (+ stencil when available) of every render pass - see viewer_gpu_depth_format
 
     // Graphics pipelines
     vertex_shader: ^sdl.GPUShader,
@@ -71,6 +85,21 @@ ViewerGPU :: struct {
     triangle_fragment_shader: ^sdl.GPUShader,
     shaded_pipeline: ^sdl.GPUGraphicsPipeline,  // For shaded triangle rendering with lighting
 
+    // Instanced point sprites (sketch points and handles)
+    point_sprites: PointSpriteRenderer,
+
+    // Stencil-then-cover sketch profile fills
+    profile_fill: ProfileFillRenderer,
+
+    // Cached solid meshes (VRAM budget + LRU eviction)
+    mesh_cache: GPUMeshCache,
+
+    // Two-phase Hi-Z occlusion culling of shaded bodies
+    occlusion: OcclusionCuller,
+
+    // Sorted draws of the 3D scene (solids and their edge overlays)
+    render_queue: RenderQueue,
+
     // Vertex buffers
     axes_vertex_buffer: ^sdl.GPUBuffer,
     axes_vertex_count: u32,
@@ -99,6 +128,9 @@ ViewerGPU :: struct {
     window_width: u32,
     window_height: u32,
     render_mode: RenderMode,  // Current rendering mode (wireframe/shaded/both)
+
+    // Frame-time HUD and per-frame counters (F3)
+    profiler: FrameProfiler,
 }
 
 // Touch point for multi-touch tracking
@@ -156,6 +188,21 @@ wireframe_mesh_gpu_add_edge_f64 :: proc(mesh: ^WireframeMeshGPU, v0, v1: m.Vec3)
     append(&mesh.edges, [2][3]f32{v0_f32, v1_f32})
 }
 
+// Add a sketch spline to GPU wireframe mesh (flattened to its polyline)
+wireframe_mesh_gpu_add_spline :: proc(mesh: ^WireframeMeshGPU, sk: ^sketch.Sketch2D, spline: sketch.SketchSpline) {
+    polyline := make([dynamic]m.Vec2, 0, 64, context.temp_allocator)
+    if !sketch.sketch_flatten_spline(sk, spline, &polyline) || len(polyline) < 2 {
+        return
+    }
+
+    prev := sketch.sketch_to_world(&sk.plane, polyline[0])
+    for p in polyline[1:] {
+        cur := sketch.sketch_to_world(&sk.plane, p)
+        wireframe_mesh_gpu_add_edge_f64(mesh, prev, cur)
+        prev = cur
+    }
+}
+
 // =============================================================================
 // Triangle Mesh (GPU version for shaded rendering)
 // =============================================================================
@@ -267,6 +314,9 @@ sketch_entity_to_wireframe_gpu :: proc(sk: ^sketch.Sketch2D, entity_index: int)
 
     case sketch.SketchArc:
         // TODO: Arc rendering
+
+    case sketch.SketchSpline:
+        wireframe_mesh_gpu_add_spline(&mesh, sk, e)
     }
 
     return mesh
@@ -346,6 +396,9 @@ TextRendererGPU :: struct {
 
     // Track if texture has been uploaded
     texture_uploaded: bool,
+
+    // Draw/upload counters (optional - set to &viewer.profiler)
+    profiler: ^FrameProfiler,
 }
 
 // Initialize text renderer for SDL3 GPU
@@ -523,7 +576,7 @@ text_renderer_gpu_init :: proc(gpu_device: ^sdl.GPUDevice, window: ^sdl.Window,
             num_color_targets = 1,
             color_target_descriptions = &color_target,
             has_depth_stencil_target = true,  // Match render pass
-            depth_stencil_format = .D16_UNORM,
+            depth_stencil_format = viewer_gpu_depth_format(gpu_device),
         },
     }
 
@@ -694,6 +747,7 @@ text_render_2d_gpu :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    if renderer.profiler != nil do frame_profiler_count_upload(renderer.profiler, vertex_count * size_of(TextVertex))
 
     // Wait for upload to complete
     _ = sdl.WaitForGPUIdle(renderer.gpu_device)
@@ -723,6 +777,7 @@ text_render_2d_gpu :: proc(
 
     // Draw text
     sdl.DrawGPUPrimitives(pass, u32(vertex_count), 1, 0, 0)
+    if renderer.profiler != nil do frame_profiler_count_draw(renderer.profiler, vertex_count / 3)
 }
 
 // Update font atlas texture (upload to GPU)
@@ -778,6 +833,7 @@ text_renderer_gpu_update_texture :: proc(renderer: ^TextRendererGPU) {
     sdl.UploadToGPUTexture(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    if renderer.profiler != nil do frame_profiler_count_upload(renderer.profiler, renderer.texture_width * renderer.texture_height)
 
     // CRITICAL: Wait for texture upload to complete before proceeding
     // Without this, rendering might use the old/corrupted texture data
@@ -883,6 +939,9 @@ sketch_to_wireframe_gpu :: proc(sk: ^sketch.Sketch2D) -> WireframeMeshGPU {
 
         case sketch.SketchArc:
             // TODO: Implement arc rendering
+
+        case sketch.SketchSpline:
+            wireframe_mesh_gpu_add_spline(&mesh, sk, e)
         }
     }
 
@@ -940,6 +999,9 @@ sketch_to_wireframe_selected_gpu :: proc(sk: ^sketch.Sketch2D) -> WireframeMeshG
 
     case sketch.SketchArc:
         // TODO: Arc rendering
+
+    case sketch.SketchSpline:
+        wireframe_mesh_gpu_add_spline(&mesh, sk, e)
     }
 
     return mesh
@@ -977,6 +1039,15 @@ viewer_gpu_render_sketch_points :: proc(
 ) {
     if len(sk.points) == 0 do return
 
+    // Instanced path: queue points, drawn by viewer_gpu_flush_point_sprites
+    if point_sprites_enabled(viewer) {
+        for point in sk.points {
+            point_sprites_add_sketch_point(viewer, sk, point.x, point.y, color, point_size_pixels)
+        }
+        return
+    }
+
+    // Fallback: build triangle fans on the CPU
     // Calculate screen-space to world-space conversion
     pixel_size_world := get_pixel_size_world(viewer)
 
@@ -1079,6 +1150,7 @@ viewer_gpu_render_sketch_points :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(circle_verts) * size_of(LineVertex))
 
     // Wait for upload to complete
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
@@ -1101,6 +1173,7 @@ viewer_gpu_render_sketch_points :: proc(
     sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.DrawGPUPrimitives(pass, u32(len(circle_verts)), 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, len(circle_verts) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
@@ -1116,7 +1189,15 @@ viewer_gpu_render_single_point :: proc(
     mvp: matrix[4,4]f32,
     color: [4]f32,
     point_size_pixels: f32,
+    style: PointStyle = .Circle,
 ) {
+    // Instanced path: queue point, drawn by viewer_gpu_flush_point_sprites
+    if point_sprites_enabled(viewer) {
+        point_sprites_add_sketch_point(viewer, sk, point.x, point.y, color, point_size_pixels, style)
+        return
+    }
+
+    // Fallback: build a triangle fan on the CPU (style is ignored)
     // Calculate screen-space to world-space conversion
     pixel_size_world := get_pixel_size_world(viewer)
 
@@ -1217,6 +1298,7 @@ viewer_gpu_render_single_point :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(circle_verts) * size_of(LineVertex))
 
     // Wait for upload to complete
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
@@ -1239,6 +1321,7 @@ viewer_gpu_render_single_point :: proc(
     sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.DrawGPUPrimitives(pass, u32(len(circle_verts)), 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, len(circle_verts) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
@@ -1426,7 +1509,7 @@ viewer_gpu_render_sketch_preview :: proc(
                     // If cursor is near the chain start point, highlight it in yellow
                     if dist_to_start < AUTO_CLOSE_THRESHOLD {
                         // Render larger yellow point to indicate auto-close is available
-                        viewer_gpu_render_single_point(viewer, cmd, pass, sk, chain_start_pt, mvp, {1.0, 1.0, 0.0, 1.0}, 8.0)
+                        viewer_gpu_render_single_point(viewer, cmd, pass, sk, chain_start_pt, mvp, {1.0, 1.0, 0.0, 1.0}, 8.0, .Ring)
                     }
                 }
             }
@@ -3150,95 +3233,185 @@ solid_to_wireframe_gpu :: proc(solid: ^extrude.SimpleSolid) -> WireframeMeshGPU
 // Initialization
 // =============================================================================
 
+// Depth format shared by all passes and pipelines: prefer one with a stencil channel
+// (profile fills use it), falling back to plain 16-bit depth
+viewer_gpu_depth_format :: proc(device: ^sdl.GPUDevice) -> sdl.GPUTextureFormat {
+    for format in ([2]sdl.GPUTextureFormat{.D32_FLOAT_S8_UINT, .D24_UNORM_S8_UINT}) {
+        if sdl.GPUTextureSupportsFormat(device, format, .D2, {.DEPTH_STENCIL_TARGET}) {
+            return format
+        }
+    }
+    return .D16_UNORM
+}
+
+// Create one shader stage from a Metal library, or - on devices without Metal (Vulkan, lavapipe) -
+// from the SPIR-V module compiled next to it: <stem>.vert.spv / <stem>.frag.spv (make shaders-spirv)
+viewer_gpu_load_shader :: proc(
+    device: ^sdl.GPUDevice,
+    metallib_path: string,
+    entrypoint: cstring,
+    stage: sdl.GPUShaderStage,
+    num_uniform_buffers: u32 = 1,
+) -> ^sdl.GPUShader {
+    path := metallib_path
+    entry := entrypoint
+    format := sdl.GPUShaderFormat{.METALLIB}
+
+    if .METALLIB not_in sdl.GetGPUShaderFormats(device) {
+        stem := strings.trim_suffix(metallib_path, ".metallib")
+        path = fmt.tprintf("%s.%s.spv", stem, stage == .VERTEX ? "vert" : "frag")
+        entry = "main"
+        format = {.SPIRV}
+    }
+
+    code, ok := os.read_entire_file(path)
+    if !ok {
+        fmt.eprintln("ERROR: Failed to read shader file:", path)
+        return nil
+    }
+    defer delete(code)
+
+    return sdl.CreateGPUShader(device, sdl.GPUShaderCreateInfo{
+        code = raw_data(code),
+        code_size = len(code),
+        entrypoint = entry,
+        format = format,
+        stage = stage,
+        num_uniform_buffers = num_uniform_buffers,
+    })
+}
+
+// Compute pipeline from the Metal library, or `<dir>/<kernel>.comp.spv` next to it
+// (one SPIR-V module per kernel, entry point "main")
+viewer_gpu_load_compute_pipeline :: proc(
+    device: ^sdl.GPUDevice,
+    metallib_path: string,
+    kernel: cstring,
+    info: sdl.GPUComputePipelineCreateInfo,
+) -> ^sdl.GPUComputePipeline {
+    path := metallib_path
+    entry := kernel
+    format := sdl.GPUShaderFormat{.METALLIB}
+
+    if .METALLIB not_in sdl.GetGPUShaderFormats(device) {
+        dir := metallib_path[:strings.last_index_byte(metallib_path, '/') + 1]
+        path = fmt.tprintf("%s%s.comp.spv", dir, kernel)
+        entry = "main"
+        format = {.SPIRV}
+    }
+
+    code, ok := os.read_entire_file(path)
+    if !ok {
+        fmt.eprintln("ERROR: Failed to read shader file:", path)
+        return nil
+    }
+    defer delete(code)
+
+    create_info := info
+    create_info.code = raw_data(code)
+    create_info.code_size = len(code)
+    create_info.entrypoint = entry
+    create_info.format = format
+    return sdl.CreateGPUComputePipeline(device, create_info)
+}
+
 viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^ViewerGPU, bool) {
     fmt.println("=== Initializing SDL3 GPU Viewer ===\n")
 
-    // Set hint BEFORE SDL_Init to treat trackpad as touch device
-    // This enables FINGER_* events for Blender-style gestures!
-    sdl.SetHint(sdl.HINT_TRACKPAD_IS_TOUCH_ONLY, "1")
-    fmt.println("✓ Trackpad configured for touch events (Blender-style gestures)")
+    window: ^sdl.Window
+    gpu_device: ^sdl.GPUDevice
+    color_format: sdl.GPUTextureFormat
 
-    // Initialize SDL3
-    if !sdl.Init({.VIDEO}) {
-        fmt.eprintln("ERROR: Failed to initialize SDL3:", sdl.GetError())
-        return nil, false
-    }
+    if config.headless {
+        // No display needed: the offscreen video driver still lets SDL load Vulkan/Metal
+        sdl.SetHint(sdl.HINT_VIDEO_DRIVER, "offscreen")
+        if !sdl.Init({.VIDEO}) {
+            fmt.eprintln("ERROR: Failed to initialize SDL3:", sdl.GetError())
+            return nil, false
+        }
 
-    fmt.println("✓ SDL3 initialized")
+        // Metal on macOS, Vulkan elsewhere (SPIR-V shaders - lavapipe works as a software device)
+        gpu_device = sdl.CreateGPUDevice({.METALLIB, .SPIRV}, false, nil)
+        if gpu_device == nil {
+            fmt.eprintln("ERROR: Failed to create GPU device:", sdl.GetError())
+            sdl.Quit()
+            return nil, false
+        }
 
-    // Create window
-    window := sdl.CreateWindow(
-        config.window_title,
-        config.window_width,
-        config.window_height,
-        {.RESIZABLE},
-    )
+        // Offscreen targets are read back as RGBA8 for PNG output
+        color_format = OFFSCREEN_COLOR_FORMAT
+        fmt.printf("✓ Headless GPU device created (%s backend)\n", sdl.GetGPUDeviceDriver(gpu_device))
+    } else {
+        // Set hint BEFORE SDL_Init to treat trackpad as touch device
+        // This enables FINGER_* events for Blender-style gestures!
+        sdl.SetHint(sdl.HINT_TRACKPAD_IS_TOUCH_ONLY, "1")
+        fmt.println("✓ Trackpad configured for touch events (Blender-style gestures)")
+
+        // Initialize SDL3
+        if !sdl.Init({.VIDEO}) {
+            fmt.eprintln("ERROR: Failed to initialize SDL3:", sdl.GetError())
+            return nil, false
+        }
 
-    if window == nil {
-        fmt.eprintln("ERROR: Failed to create window:", sdl.GetError())
-        sdl.Quit()
-        return nil, false
-    }
+        fmt.println("✓ SDL3 initialized")
 
-    fmt.println("✓ Window created")
+        // Create window
+        window = sdl.CreateWindow(
+            config.window_title,
+            config.window_width,
+            config.window_height,
+            {.RESIZABLE},
+        )
 
-    // macOS: Raise window and give it keyboard focus
-    _ = sdl.RaiseWindow(window)
-    _ = sdl.SetWindowKeyboardGrab(window, true)
+        if window == nil {
+            fmt.eprintln("ERROR: Failed to create window:", sdl.GetError())
+            sdl.Quit()
+            return nil, false
+        }
 
-    // Create GPU device (Metal on macOS)
-    gpu_device := sdl.CreateGPUDevice(
-        {.METALLIB},
-        false,
-        nil,
-    )
+        fmt.println("✓ Window created")
 
-    if gpu_device == nil {
-        fmt.eprintln("ERROR: Failed to create GPU device:", sdl.GetError())
-        sdl.DestroyWindow(window)
-        sdl.Quit()
-        return nil, false
-    }
+        // macOS: Raise window and give it keyboard focus
+        _ = sdl.RaiseWindow(window)
+        _ = sdl.SetWindowKeyboardGrab(window, true)
 
-    driver := sdl.GetGPUDeviceDriver(gpu_device)
-    fmt.printf("✓ GPU device created (%s backend)\n", driver)
+        // Create GPU device (Metal on macOS)
+        gpu_device = sdl.CreateGPUDevice(
+            {.METALLIB},
+            false,
+            nil,
+        )
 
-    // Claim window for GPU rendering
-    if !sdl.ClaimWindowForGPUDevice(gpu_device, window) {
-        fmt.eprintln("ERROR: Failed to claim window for GPU:", sdl.GetError())
-        sdl.DestroyGPUDevice(gpu_device)
-        sdl.DestroyWindow(window)
-        sdl.Quit()
-        return nil, false
-    }
+        if gpu_device == nil {
+            fmt.eprintln("ERROR: Failed to create GPU device:", sdl.GetError())
+            sdl.DestroyWindow(window)
+            sdl.Quit()
+            return nil, false
+        }
 
-    fmt.println("✓ Window claimed for GPU rendering")
+        driver := sdl.GetGPUDeviceDriver(gpu_device)
+        fmt.printf("✓ GPU device created (%s backend)\n", driver)
 
-    // Load shaders
-    shader_data, shader_ok := os.read_entire_file(config.shader_path)
-    if !shader_ok {
-        fmt.eprintln("ERROR: Failed to read metallib file:", config.shader_path)
-        sdl.DestroyGPUDevice(gpu_device)
-        sdl.DestroyWindow(window)
-        sdl.Quit()
-        return nil, false
-    }
-    defer delete(shader_data)
+        // Claim window for GPU rendering
+        if !sdl.ClaimWindowForGPUDevice(gpu_device, window) {
+            fmt.eprintln("ERROR: Failed to claim window for GPU:", sdl.GetError())
+            sdl.DestroyGPUDevice(gpu_device)
+            sdl.DestroyWindow(window)
+            sdl.Quit()
+            return nil, false
+        }
 
-    fmt.printf("✓ Loaded shaders: %s (%d bytes)\n", config.shader_path, len(shader_data))
+        fmt.println("✓ Window claimed for GPU rendering")
 
-    // Create vertex shader
-    vertex_shader_info := sdl.GPUShaderCreateInfo{
-        code = raw_data(shader_data),
-        code_size = len(shader_data),
-        entrypoint = "vertex_main",
-        format = {.METALLIB},
-        stage = .VERTEX,
-        num_uniform_buffers = 1,
-        num_storage_buffers = 0,
+        color_format = sdl.GetGPUSwapchainTextureFormat(gpu_device, window)
     }
 
-    vertex_shader := sdl.CreateGPUShader(gpu_device, vertex_shader_info)
+    // MSAA needs a multisampled target + resolve; offscreen targets are single-sampled
+    sample_count: sdl.GPUSampleCount = config.headless ? ._1 : ._4
+    depth_format := viewer_gpu_depth_format(gpu_device)
+
+    // Load shaders (Metal library, or the SPIR-V modules built next to it)
+    vertex_shader := viewer_gpu_load_shader(gpu_device, config.shader_path, "vertex_main", .VERTEX)
     if vertex_shader == nil {
         fmt.eprintln("ERROR: Failed to create vertex shader:", sdl.GetError())
         sdl.DestroyGPUDevice(gpu_device)
@@ -3247,18 +3420,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
         return nil, false
     }
 
-    // Create fragment shader
-    fragment_shader_info := sdl.GPUShaderCreateInfo{
-        code = raw_data(shader_data),
-        code_size = len(shader_data),
-        entrypoint = "fragment_main",
-        format = {.METALLIB},
-        stage = .FRAGMENT,
-        num_uniform_buffers = 1,
-        num_storage_buffers = 0,
-    }
-
-    fragment_shader := sdl.CreateGPUShader(gpu_device, fragment_shader_info)
+    fragment_shader := viewer_gpu_load_shader(gpu_device, config.shader_path, "fragment_main", .FRAGMENT)
     if fragment_shader == nil {
         fmt.eprintln("ERROR: Failed to create fragment shader:", sdl.GetError())
         sdl.ReleaseGPUShader(gpu_device, vertex_shader)
@@ -3291,7 +3453,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
     }
 
     color_target := sdl.GPUColorTargetDescription{
-        format = sdl.GetGPUSwapchainTextureFormat(gpu_device, window),
+        format = color_format,
         blend_state = {
             enable_blend = false,
             alpha_blend_op = .ADD,
@@ -3314,7 +3476,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             front_face = .COUNTER_CLOCKWISE,
         },
         multisample_state = {
-            sample_count = ._4,  // 4x MSAA for antialiasing
+            sample_count = sample_count,  // 4x MSAA for antialiasing (windowed)
             sample_mask = 0xFFFFFFFF,
         },
         target_info = {
@@ -3340,7 +3502,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
     // Create triangle pipeline for thick lines and UI (same shaders, different primitive type)
     // Enable alpha blending for transparency (profile fills)
     triangle_color_target := sdl.GPUColorTargetDescription{
-        format = sdl.GetGPUSwapchainTextureFormat(gpu_device, window),
+        format = color_format,
         blend_state = {
             enable_blend = true,
             alpha_blend_op = .ADD,
@@ -3363,7 +3525,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             front_face = .COUNTER_CLOCKWISE,
         },
         multisample_state = {
-            sample_count = ._4,  // 4x MSAA for antialiasing
+            sample_count = sample_count,  // 4x MSAA for antialiasing (windowed)
             sample_mask = 0xFFFFFFFF,
         },
         depth_stencil_state = {
@@ -3376,7 +3538,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             num_color_targets = 1,
             color_target_descriptions = &triangle_color_target,
             has_depth_stencil_target = true,  // Match render pass
-            depth_stencil_format = .D16_UNORM,
+            depth_stencil_format = depth_format,
         },
     }
 
@@ -3406,7 +3568,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             front_face = .COUNTER_CLOCKWISE,
         },
         multisample_state = {
-            sample_count = ._4,
+            sample_count = sample_count,
             sample_mask = 0xFFFFFFFF,
         },
         depth_stencil_state = {
@@ -3420,7 +3582,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             num_color_targets = 1,
             color_target_descriptions = &triangle_color_target,
             has_depth_stencil_target = true,
-            depth_stencil_format = .D16_UNORM,
+            depth_stencil_format = depth_format,
         },
     }
 
@@ -3451,43 +3613,13 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
 
     // Load triangle shaders for shaded rendering
     triangle_shader_path := "src/ui/viewer/shaders/triangle_shader.metallib"
-    triangle_shader_data, triangle_shader_ok := os.read_entire_file(triangle_shader_path)
-    if !triangle_shader_ok {
-        fmt.eprintln("WARNING: Failed to read triangle shader, shaded rendering will be disabled:", triangle_shader_path)
-        // Continue without shaded rendering support
-        viewer.triangle_vertex_shader = nil
-        viewer.triangle_fragment_shader = nil
-        viewer.shaded_pipeline = nil
-    } else {
-        defer delete(triangle_shader_data)
-        fmt.printf("✓ Loaded triangle shaders: %s (%d bytes)\n", triangle_shader_path, len(triangle_shader_data))
-
-        // Create triangle vertex shader
-        tri_vertex_shader_info := sdl.GPUShaderCreateInfo{
-            code = raw_data(triangle_shader_data),
-            code_size = len(triangle_shader_data),
-            entrypoint = "triangle_vertex_main",
-            format = {.METALLIB},
-            stage = .VERTEX,
-            num_uniform_buffers = 1,
-        }
-
-        tri_vertex_shader := sdl.CreateGPUShader(gpu_device, tri_vertex_shader_info)
+    {
+        tri_vertex_shader := viewer_gpu_load_shader(gpu_device, triangle_shader_path, "triangle_vertex_main", .VERTEX)
         if tri_vertex_shader == nil {
             fmt.eprintln("WARNING: Failed to create triangle vertex shader, shaded rendering disabled:", sdl.GetError())
         }
 
-        // Create triangle fragment shader
-        tri_fragment_shader_info := sdl.GPUShaderCreateInfo{
-            code = raw_data(triangle_shader_data),
-            code_size = len(triangle_shader_data),
-            entrypoint = "triangle_fragment_main",
-            format = {.METALLIB},
-            stage = .FRAGMENT,
-            num_uniform_buffers = 1,
-        }
-
-        tri_fragment_shader := sdl.CreateGPUShader(gpu_device, tri_fragment_shader_info)
+        tri_fragment_shader := viewer_gpu_load_shader(gpu_device, triangle_shader_path, "triangle_fragment_main", .FRAGMENT)
         if tri_fragment_shader == nil {
             fmt.eprintln("WARNING: Failed to create triangle fragment shader, shaded rendering disabled:", sdl.GetError())
             if tri_vertex_shader != nil {
@@ -3537,7 +3669,7 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
                     num_color_targets = 1,
                     color_target_descriptions = &color_target,
                     has_depth_stencil_target = true,
-                    depth_stencil_format = .D16_UNORM,  // 16-bit depth buffer
+                    depth_stencil_format = depth_format,
                 },
             }
 
@@ -3563,8 +3695,31 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
             viewer.shaded_pipeline = nil
         }
     }
+
+    // Point sprites are optional - points fall back to CPU triangle fans without them
+    // (headless renders only draw solids, and the sprite shader is Metal-only)
+    if !config.headless && !point_sprites_init(&viewer.point_sprites, gpu_device, window) {
+        fmt.println("⚠ Instanced point rendering will not be available")
+    }
+
+    // Stencil-then-cover profile fills need a stencil channel - otherwise fills use CPU fans
+    if !config.headless && !profile_fill_init(&viewer.profile_fill, gpu_device, vertex_shader, fragment_shader, color_format, depth_format, sample_count) {
+        fmt.println("⚠ Stencil profile fills will not be available")
+    }
+
+    // Occlusion culling samples the depth buffer from compute - without it every body is drawn
+    if !occlusion_init(&viewer.occlusion, gpu_device, depth_format) {
+        fmt.println("⚠ GPU occlusion culling will not be available")
+    }
+
+    gpu_mesh_cache_init(&viewer.mesh_cache)
+    render_queue_init(&viewer.render_queue)
+
     viewer.window = window
     viewer.gpu_device = gpu_device
+    viewer.headless = config.headless
+    viewer.color_format = color_format
+    viewer.depth_format = depth_format
     viewer.vertex_shader = vertex_shader
     viewer.fragment_shader = fragment_shader
     viewer.pipeline = pipeline
@@ -3598,6 +3753,10 @@ viewer_gpu_init :: proc(config: ViewerGPUConfig = DEFAULT_GPU_CONFIG) -> (^Viewe
 
     fmt.println("✓ Coordinate axes and grid created\n")
     fmt.println("=== SDL3 GPU Viewer initialized successfully ===")
+    if config.headless {
+        return viewer, true
+    }
+
     fmt.println("Controls:")
     fmt.println("  Middle Mouse: Orbit camera")
     fmt.println("  Right Mouse: Pan camera")
@@ -3783,6 +3942,12 @@ viewer_gpu_create_grid :: proc(viewer: ^ViewerGPU, size: f32 = 10.0, divisions:
 // =============================================================================
 
 viewer_gpu_destroy :: proc(viewer: ^ViewerGPU) {
+    point_sprites_destroy(&viewer.point_sprites, viewer.gpu_device)
+    profile_fill_destroy(&viewer.profile_fill, viewer.gpu_device)
+    occlusion_destroy(&viewer.occlusion, viewer.gpu_device)
+    render_queue_destroy(&viewer.render_queue, viewer.gpu_device)
+    gpu_mesh_cache_destroy(&viewer.mesh_cache, viewer.gpu_device)
+
     if viewer.axes_vertex_buffer != nil {
         sdl.ReleaseGPUBuffer(viewer.gpu_device, viewer.axes_vertex_buffer)
     }
@@ -3984,6 +4149,7 @@ viewer_gpu_render_grid :: proc(viewer: ^ViewerGPU, cmd: ^sdl.GPUCommandBuffer, p
     sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.DrawGPUPrimitives(pass, viewer.grid_vertex_count, 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, 0)
 }
 
 // =============================================================================
@@ -4255,78 +4421,9 @@ viewer_gpu_render_thick_lines :: proc(
         return
     }
 
-    // Calculate screen-space to world-space conversion
-    pixel_size_world := get_pixel_size_world(viewer)
-
-    // Calculate actual thickness in world units
-    thick := pixel_size_world * thickness_pixels * 0.5  // Half-thickness for offset
-
     // Generate quad vertices for each line segment
     quad_verts := make([dynamic]LineVertex, context.temp_allocator)
-
-    for line in lines {
-        start := line[0]
-        end := line[1]
-
-        // Calculate line direction
-        dir := [3]f32{end.x - start.x, end.y - start.y, end.z - start.z}
-        dir_len := math.sqrt(dir.x*dir.x + dir.y*dir.y + dir.z*dir.z)
-        if dir_len < 0.0001 {
-            continue // Skip degenerate lines
-        }
-        dir = {dir.x / dir_len, dir.y / dir_len, dir.z / dir_len}
-
-        // Calculate perpendicular vector (billboard towards camera)
-        mid := [3]f32{
-            (start.x + end.x) * 0.5,
-            (start.y + end.y) * 0.5,
-            (start.z + end.z) * 0.5,
-        }
-
-        to_camera := [3]f32{
-            f32(viewer.camera.position.x) - mid.x,
-            f32(viewer.camera.position.y) - mid.y,
-            f32(viewer.camera.position.z) - mid.z,
-        }
-
-        // Cross product: dir × to_camera
-        right := [3]f32{
-            dir.y * to_camera.z - dir.z * to_camera.y,
-            dir.z * to_camera.x - dir.x * to_camera.z,
-            dir.x * to_camera.y - dir.y * to_camera.x,
-        }
-
-        right_len := math.sqrt(right.x*right.x + right.y*right.y + right.z*right.z)
-        if right_len < 0.0001 {
-            // Fallback if line points at camera
-            right = {dir.y * 1.0 - dir.z * 0.0, dir.z * 0.0 - dir.x * 1.0, dir.x * 0.0 - dir.y * 0.0}
-            right_len = math.sqrt(right.x*right.x + right.y*right.y + right.z*right.z)
-            if right_len < 0.0001 {
-                right = {dir.y * 0.0 - dir.z * 0.0, dir.z * 1.0 - dir.x * 0.0, dir.x * 0.0 - dir.y * 1.0}
-            }
-        }
-        right = {
-            (right.x / right_len) * thick,
-            (right.y / right_len) * thick,
-            (right.z / right_len) * thick,
-        }
-
-        // Create quad vertices (two triangles)
-        p0 := [3]f32{start.x - right.x, start.y - right.y, start.z - right.z}
-        p1 := [3]f32{start.x + right.x, start.y + right.y, start.z + right.z}
-        p2 := [3]f32{end.x + right.x, end.y + right.y, end.z + right.z}
-        p3 := [3]f32{end.x - right.x, end.y - right.y, end.z - right.z}
-
-        // First triangle (p0, p1, p2)
-        append(&quad_verts, LineVertex{p0})
-        append(&quad_verts, LineVertex{p1})
-        append(&quad_verts, LineVertex{p2})
-
-        // Second triangle (p0, p2, p3)
-        append(&quad_verts, LineVertex{p0})
-        append(&quad_verts, LineVertex{p2})
-        append(&quad_verts, LineVertex{p3})
-    }
+    append_thick_line_quads(viewer, &quad_verts, lines, thickness_pixels)
 
     if len(quad_verts) == 0 {
         return
@@ -4387,6 +4484,7 @@ viewer_gpu_render_thick_lines :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(quad_verts) * size_of(LineVertex))
 
     // Wait for upload to complete (synchronous for now)
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
@@ -4415,11 +4513,85 @@ viewer_gpu_render_thick_lines :: proc(
     sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.DrawGPUPrimitives(pass, u32(len(quad_verts)), 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, len(quad_verts) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
 }
 
+// Camera-facing quads (two triangles each) for screen-space thick lines
+append_thick_line_quads :: proc(viewer: ^ViewerGPU, out: ^[dynamic]LineVertex, lines: [][2][3]f32, thickness_pixels: f32) {
+    // Calculate screen-space to world-space conversion
+    pixel_size_world := get_pixel_size_world(viewer)
+
+    // Calculate actual thickness in world units
+    thick := pixel_size_world * thickness_pixels * 0.5  // Half-thickness for offset
+
+    for line in lines {
+        start := line[0]
+        end := line[1]
+
+        // Calculate line direction
+        dir := [3]f32{end.x - start.x, end.y - start.y, end.z - start.z}
+        dir_len := math.sqrt(dir.x*dir.x + dir.y*dir.y + dir.z*dir.z)
+        if dir_len < 0.0001 {
+            continue // Skip degenerate lines
+        }
+        dir = {dir.x / dir_len, dir.y / dir_len, dir.z / dir_len}
+
+        // Calculate perpendicular vector (billboard towards camera)
+        mid := [3]f32{
+            (start.x + end.x) * 0.5,
+            (start.y + end.y) * 0.5,
+            (start.z + end.z) * 0.5,
+        }
+
+        to_camera := [3]f32{
+            f32(viewer.camera.position.x) - mid.x,
+            f32(viewer.camera.position.y) - mid.y,
+            f32(viewer.camera.position.z) - mid.z,
+        }
+
+        // Cross product: dir × to_camera
+        right := [3]f32{
+            dir.y * to_camera.z - dir.z * to_camera.y,
+            dir.z * to_camera.x - dir.x * to_camera.z,
+            dir.x * to_camera.y - dir.y * to_camera.x,
+        }
+
+        right_len := math.sqrt(right.x*right.x + right.y*right.y + right.z*right.z)
+        if right_len < 0.0001 {
+            // Fallback if line points at camera
+            right = {dir.y * 1.0 - dir.z * 0.0, dir.z * 0.0 - dir.x * 1.0, dir.x * 0.0 - dir.y * 0.0}
+            right_len = math.sqrt(right.x*right.x + right.y*right.y + right.z*right.z)
+            if right_len < 0.0001 {
+                right = {dir.y * 0.0 - dir.z * 0.0, dir.z * 1.0 - dir.x * 0.0, dir.x * 0.0 - dir.y * 1.0}
+            }
+        }
+        right = {
+            (right.x / right_len) * thick,
+            (right.y / right_len) * thick,
+            (right.z / right_len) * thick,
+        }
+
+        // Create quad vertices (two triangles)
+        p0 := [3]f32{start.x - right.x, start.y - right.y, start.z - right.z}
+        p1 := [3]f32{start.x + right.x, start.y + right.y, start.z + right.z}
+        p2 := [3]f32{end.x + right.x, end.y + right.y, end.z + right.z}
+        p3 := [3]f32{end.x - right.x, end.y - right.y, end.z - right.z}
+
+        // First triangle (p0, p1, p2)
+        append(out, LineVertex{p0})
+        append(out, LineVertex{p1})
+        append(out, LineVertex{p2})
+
+        // Second triangle (p0, p2, p3)
+        append(out, LineVertex{p0})
+        append(out, LineVertex{p2})
+        append(out, LineVertex{p3})
+    }
+}
+
 // =============================================================================
 // Wireframe Mesh Rendering
 // =============================================================================
@@ -4474,6 +4646,19 @@ viewer_gpu_render_rect_inline :: proc(
         {{x_ndc + width_ndc, y_ndc, 0}},
     }
 
+    viewer_gpu_render_triangles_2d(viewer, cmd, pass, vertices[:], color)
+}
+
+// Render a triangle list already in NDC with one flat color (triangle pipeline, no depth test)
+viewer_gpu_render_triangles_2d :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    vertices: []LineVertex,
+    color: [4]f32,
+) {
+    if len(vertices) == 0 do return
+
     // Create temporary vertex buffer
     buffer_info := sdl.GPUBufferCreateInfo{
         usage = {.VERTEX},
@@ -4498,7 +4683,7 @@ viewer_gpu_render_rect_inline :: proc(
     if transfer_ptr == nil do return
 
     dest_slice := ([^]LineVertex)(transfer_ptr)[:len(vertices)]
-    copy(dest_slice, vertices[:])
+    copy(dest_slice, vertices)
     sdl.UnmapGPUTransferBuffer(viewer.gpu_device, transfer_buffer)
 
     // Upload to GPU
@@ -4519,6 +4704,7 @@ viewer_gpu_render_rect_inline :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(vertices) * size_of(LineVertex))
 
     // Wait for upload
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
@@ -4549,6 +4735,7 @@ viewer_gpu_render_rect_inline :: proc(
     sdl.PushGPUVertexUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &uniforms, size_of(Uniforms))
     sdl.DrawGPUPrimitives(pass, u32(len(vertices)), 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, len(vertices) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
@@ -4561,7 +4748,7 @@ viewer_gpu_render_rect_inline :: proc(
 // Triangle uniforms structure (matches Metal shader TriangleUniforms)
 TriangleUniforms :: struct {
     mvp: matrix[4,4]f32,          // Model-View-Projection matrix
-    model: matrix[4,4]f32,        // Model matrix (identity for now)
+    model: matrix[4,4]f32,        // Normal matrix (inverse transpose of the body's model matrix)
     baseColor: [4]f32,            // Base material color
     lightDir: [3]f32,             // Directional light direction
     ambientStrength: f32,         // Ambient light strength
@@ -4639,26 +4826,24 @@ viewer_gpu_render_triangle_mesh :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(mesh.vertices) * size_of(TriangleVertex))
 
     // Wait for upload to complete
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
 
-    // Switch to shaded rendering pipeline
-    sdl.BindGPUGraphicsPipeline(pass, viewer.shaded_pipeline)
-
-    // Bind vertex buffer
-    binding := sdl.GPUBufferBinding{
-        buffer = temp_vertex_buffer,
-        offset = 0,
-    }
-    sdl.BindGPUVertexBuffers(pass, 0, &binding, 1)
-
-    // Set up lighting parameters
-    // Light direction: from upper-right-front (balanced for CAD viewing)
-    // The shader negates this, so this vector points FROM the light source (use negative values!)
-    light_dir := [3]f32{-0.4, -0.5, -0.3}  // Gentle angle from upper-right-front
-    ambient_strength: f32 = 0.9            // 90% ambient light for minimal shadows (CAD-friendly)
+    viewer_gpu_draw_shaded_buffer(viewer, cmd, pass, temp_vertex_buffer, u32(len(mesh.vertices)), color, mvp)
+}
 
+// Draw a vertex buffer of TriangleVertex with the shaded (lit) pipeline
+viewer_gpu_draw_shaded_buffer :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    buffer: ^sdl.GPUBuffer,
+    vertex_count: u32,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+) {
     // Create identity matrix for model transform
     model_matrix := matrix[4,4]f32{
         1, 0, 0, 0,
@@ -4667,23 +4852,73 @@ viewer_gpu_render_triangle_mesh :: proc(
         0, 0, 0, 1,
     }
 
-    tri_uniforms := TriangleUniforms{
+    viewer_gpu_draw_shaded_buffer_transformed(viewer, cmd, pass, buffer, vertex_count, color, mvp, model_matrix)
+}
+
+// Shaded draw with a normal transform (inverse transpose of the model matrix)
+// The shader only uses the uniform `model` for normals, so it receives normal_matrix.
+viewer_gpu_draw_shaded_buffer_transformed :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    buffer: ^sdl.GPUBuffer,
+    vertex_count: u32,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+) {
+    viewer_gpu_bind_shaded(viewer, cmd, pass, buffer, color, mvp, normal_matrix)
+
+    // Draw triangles
+    sdl.DrawGPUPrimitives(pass, vertex_count, 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, int(vertex_count) / 3)
+
+    // Switch back to line pipeline
+    sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
+}
+
+// Uniforms of the shaded pipeline: material color plus the viewer's fixed CAD lighting
+shaded_uniforms :: proc(color: [4]f32, mvp: matrix[4,4]f32, normal_matrix: matrix[4,4]f32) -> TriangleUniforms {
+    // Light direction: from upper-right-front (balanced for CAD viewing)
+    // The shader negates this, so this vector points FROM the light source (use negative values!)
+    light_dir := [3]f32{-0.4, -0.5, -0.3}  // Gentle angle from upper-right-front
+    ambient_strength: f32 = 0.9            // 90% ambient light for minimal shadows (CAD-friendly)
+
+    return TriangleUniforms{
         mvp = mvp,
-        model = model_matrix,
+        model = normal_matrix,
         baseColor = color,
         lightDir = light_dir,
         ambientStrength = ambient_strength,
     }
+}
+
+// Bind the shaded pipeline, vertex buffer and lighting uniforms
+@(private="file")
+viewer_gpu_bind_shaded :: proc(
+    viewer: ^ViewerGPU,
+    cmd: ^sdl.GPUCommandBuffer,
+    pass: ^sdl.GPURenderPass,
+    buffer: ^sdl.GPUBuffer,
+    color: [4]f32,
+    mvp: matrix[4,4]f32,
+    normal_matrix: matrix[4,4]f32,
+) {
+    // Switch to shaded rendering pipeline
+    sdl.BindGPUGraphicsPipeline(pass, viewer.shaded_pipeline)
+
+    // Bind vertex buffer
+    binding := sdl.GPUBufferBinding{
+        buffer = buffer,
+        offset = 0,
+    }
+    sdl.BindGPUVertexBuffers(pass, 0, &binding, 1)
+
+    tri_uniforms := shaded_uniforms(color, mvp, normal_matrix)
 
     // Push uniforms to shader
     sdl.PushGPUVertexUniformData(cmd, 0, &tri_uniforms, size_of(TriangleUniforms))
     sdl.PushGPUFragmentUniformData(cmd, 0, &tri_uniforms, size_of(TriangleUniforms))
-
-    // Draw triangles
-    sdl.DrawGPUPrimitives(pass, u32(len(mesh.vertices)), 1, 0, 0)
-
-    // Switch back to line pipeline
-    sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
 }
 
 // Render highlighted face (filled polygon overlay)
@@ -4775,6 +5010,7 @@ viewer_gpu_render_face_highlight :: proc(
     sdl.UploadToGPUBuffer(copy_pass, upload_copy, destination, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    frame_profiler_count_upload(&viewer.profiler, len(triangle_vertices) * size_of(LineVertex))
 
     // Wait for upload to complete
     _ = sdl.WaitForGPUIdle(viewer.gpu_device)
@@ -4799,6 +5035,7 @@ viewer_gpu_render_face_highlight :: proc(
 
     // Draw triangles
     sdl.DrawGPUPrimitives(pass, u32(len(triangle_vertices)), 1, 0, 0)
+    frame_profiler_count_draw(&viewer.profiler, len(triangle_vertices) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(pass, viewer.pipeline)
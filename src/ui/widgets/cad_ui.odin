@@ -3,10 +3,12 @@ package widgets
 
 import "core:fmt"
 import "core:math"
+import "core:time"
 import doc "../../core/document"
 import sketch "../../features/sketch"
 import ftree "../../features/feature_tree"
 import extrude "../../features/extrude"
+import v "../viewer"
 
 // =============================================================================
 // CAD UI State - Holds state for CAD-specific UI panels
@@ -36,6 +38,13 @@ CADUIState :: struct {
     selected_feature_id: int,  // -1 if no face selected
     selected_face_index: int,  // Face index within feature
     create_sketch_on_face: bool,  // Flag to signal main loop to create sketch on selected face
+
+    // History panel scroll state and cached row layout
+    feature_tree_view: FeatureTreeView,
+
+    // Background constraint solving (nil = solve on the UI thread)
+    async_solver: ^sketch.AsyncSolver,
+    solve_regenerates: bool,  // Regenerate features when the queued solve lands
 }
 
 cad_ui_state_init :: proc() -> CADUIState {
@@ -51,9 +60,14 @@ cad_ui_state_init :: proc() -> CADUIState {
         temp_cut_depth = 0.3,
         selected_feature_id = -1,  // No face selected initially
         selected_face_index = -1,
+        feature_tree_view = feature_tree_view_init(),
     }
 }
 
+cad_ui_state_destroy :: proc(state: ^CADUIState) {
+    feature_tree_view_destroy(&state.feature_tree_view)
+}
+
 // =============================================================================
 // Toolbar Panel - Tool Selection
 // =============================================================================
@@ -381,14 +395,23 @@ ui_properties_panel :: proc(
                     ) {
                         // Update constraint value
                         if sketch.sketch_modify_constraint_value(sk, sk.selected_constraint_id, f64(cad_state.temp_constraint_value)) {
-                            // Re-solve constraints after modification
-                            result := sketch.sketch_solve_constraints(sk)
-                            if result.status == .Success {
-                                fmt.printf("✓ Constraint value updated: %.2f (solver converged)\n", cad_state.temp_constraint_value)
-                                needs_update = true
+                            // Re-solve constraints after modification - in the background when the
+                            // app provides a solver (rapid steps each queue a solve, cancelling the last)
+                            if cad_state.async_solver != nil {
+                                sketch.sketch_solve_async(cad_state.async_solver, sk)
+                                cad_state.solve_regenerates = true
+                                fmt.printf("✓ Constraint value updated: %.2f (solving...)\n", cad_state.temp_constraint_value)
                             } else {
-                                fmt.printf("⚠️  Constraint value updated: %.2f (solver: %v)\n", cad_state.temp_constraint_value, result.status)
-                                needs_update = true  // Still update display even if solver didn't converge
+                                solve_start := time.tick_now()
+                                result := sketch.sketch_solve_constraints(sk)
+                                v.frame_profiler_add_solve(&ctx.viewer.profiler, time.tick_since(solve_start))
+                                if result.status == .Success {
+                                    fmt.printf("✓ Constraint value updated: %.2f (solver converged)\n", cad_state.temp_constraint_value)
+                                    needs_update = true
+                                } else {
+                                    fmt.printf("⚠️  Constraint value updated: %.2f (solver: %v)\n", cad_state.temp_constraint_value, result.status)
+                                    needs_update = true  // Still update display even if solver didn't converge
+                                }
                             }
                         } else {
                             fmt.printf("❌ Failed to update constraint value\n")
@@ -482,6 +505,26 @@ ui_properties_panel :: proc(
                 "Arc",
             )
             current_y += widget_height + spacing
+
+        case sketch.SketchSpline:
+            // Spline properties
+            ui_text_input(
+                ctx,
+                x + spacing, current_y,
+                width - spacing * 2, widget_height,
+                "TYPE",
+                e.control_count == 4 ? "Bezier" : "Spline",
+            )
+            current_y += widget_height + spacing
+
+            ui_text_input(
+                ctx,
+                x + spacing, current_y,
+                width - spacing * 2, widget_height,
+                "CONTROL POINTS",
+                fmt.tprintf("%d", e.control_count),
+            )
+            current_y += widget_height + spacing
         }
         }
     } else {
@@ -742,7 +785,7 @@ ui_feature_tree_panel :: proc(
 ) -> (height: f32, interaction: FeatureTreeInteraction) {
     spacing: f32 = 10
     current_y := y
-    item_height: f32 = 28
+    item_height: f32 = FEATURE_ROW_HEIGHT
 
     // Initialize interaction result
     interaction = FeatureTreeInteraction{clicked_feature_id = -1, double_clicked = false}
@@ -758,41 +801,106 @@ ui_feature_tree_panel :: proc(
     )
     current_y += 50
 
-    // List all features
-    for feature, i in feature_tree.features {
-        if !feature.enabled do continue
+    // Virtualized list: only rows inside the scroll window are laid out and drawn
+    view := &cad_state.feature_tree_view
+    row_x := x + spacing
+    row_width := width - spacing * 2
+    icon_size: f32 = 24
+    label_width := row_width - (4 + icon_size + 8) - 48  // Room for the checkmark/visibility indicators
+    feature_tree_view_sync(view, ctx, feature_tree, label_width)
+
+    // Starting to edit a feature scrolls it into view
+    if editing_feature_id != view.last_editing_id {
+        view.last_editing_id = editing_feature_id
+        if editing_feature_id >= 0 do view.jump_to_id = editing_feature_id
+    }
+
+    // Scroll window runs down to the status bar (shrinks to fit short histories)
+    status_bar_height: f32 = 30
+    list_y := current_y
+    available_height := max(f32(ctx.screen_height) - status_bar_height - spacing - list_y, FEATURE_ROW_STRIDE * 3)
+    viewport_height := min(available_height, feature_tree_view_content_height(view))
+    feature_tree_view_set_viewport(view, viewport_height)
+
+    over_list := ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, x, list_y, width, viewport_height)
+    if over_list {
+        ctx.mouse_over_ui = true
+
+        // Mouse wheel: 3 rows per step, a page per step with Shift
+        if ctx.scroll_y != 0 {
+            step := ctx.viewer.shift_held ? max(viewport_height - FEATURE_ROW_STRIDE, FEATURE_ROW_STRIDE) : FEATURE_ROW_STRIDE * 3
+            view.scroll -= ctx.scroll_y * step
+            ctx.scroll_y = 0
+            feature_tree_view_clamp(view)
+        }
+    }
+
+    // Scrollbar in the right margin - drag the track to jump anywhere in the history
+    max_scroll := feature_tree_view_max_scroll(view)
+    scrollbar_x := x + width - spacing + 3
+    scrollbar_width: f32 = 4
+    if max_scroll > 0 {
+        thumb_height := max(viewport_height * viewport_height / feature_tree_view_content_height(view), 20)
+        over_track := ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, scrollbar_x - 3, list_y, scrollbar_width + 6, viewport_height)
+
+        if over_track {
+            ctx.mouse_over_ui = true
+            if !ctx.mouse_down_prev && ctx.mouse_down do view.dragging_scrollbar = true
+        }
+        if !ctx.mouse_down do view.dragging_scrollbar = false
+
+        if view.dragging_scrollbar {
+            ctx.mouse_over_ui = true
+            t := (ctx.mouse_y - list_y - thumb_height * 0.5) / max(viewport_height - thumb_height, 1)
+            view.scroll = clamp(t, 0, 1) * max_scroll
+        }
+
+        thumb_y := list_y + (view.scroll / max_scroll) * (viewport_height - thumb_height)
+        ui_render_rect(ctx, scrollbar_x, list_y, scrollbar_width, viewport_height, ctx.style.bg_dark)
+        ui_render_rect(ctx, scrollbar_x, thumb_y, scrollbar_width, thumb_height, view.dragging_scrollbar ? ctx.style.bg_light : ctx.style.bg_medium)
+    }
+
+    first, last := feature_tree_view_visible_range(view)
+
+    // Rows partially scrolled out are clipped to the window
+    ui_set_clip(ctx, x, list_y, width, viewport_height)
+    defer ui_clear_clip(ctx)
+
+    for row_index in first..<last {
+        row := &view.rows[row_index]
+        if row.feature_index >= len(feature_tree.features) || feature_tree.features[row.feature_index].id != row.feature_id {
+            view.tree_length = -1  // Tree changed without a revision bump - rebuild next frame
+            break
+        }
+        feature := &feature_tree.features[row.feature_index]
+        row_y := list_y + f32(row_index) * FEATURE_ROW_STRIDE - view.scroll
 
         // Feature type icon
-        icon_text := ""
+        icon_text := feature_type_icon(feature.type)
         icon_color := [4]u8{150, 150, 150, 255}
 
         switch feature.type {
         case .Sketch:
-            icon_text = "SK"
             icon_color = {0, 200, 200, 255}  // Cyan
         case .Extrude:
-            icon_text = "EX"
             icon_color = {0, 255, 100, 255}  // Green
         case .Revolve:
-            icon_text = "RV"
             icon_color = {255, 150, 0, 255}  // Orange
         case .Cut:
-            icon_text = "CT"
             icon_color = {255, 100, 100, 255}  // Red
+        case .Move, .CopyBody:
+            icon_color = {100, 150, 255, 255}  // Blue
         case .Fillet, .Chamfer:
-            icon_text = "??"
             icon_color = {150, 150, 150, 255}  // Gray
         }
 
         // Check if this feature is being edited
         is_editing := (editing_feature_id == feature.id)
 
-        // Draw feature item as a button-like widget
-        is_hot := ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, x + spacing, current_y, width - spacing * 2, item_height)
+        // Draw feature item as a button-like widget (only the part inside the window is clickable)
+        is_hot := over_list && !view.dragging_scrollbar && ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, row_x, row_y, row_width, item_height)
 
         if is_hot {
-            ctx.mouse_over_ui = true
-
             // Detect click on this feature (only on mouse button DOWN transition)
             if !ctx.mouse_down_prev && ctx.mouse_down {
                 interaction.clicked_feature_id = feature.id
@@ -809,45 +917,44 @@ ui_feature_tree_panel :: proc(
             bg_color = ctx.style.bg_dark
         }
 
-        ui_render_rect(ctx, x + spacing, current_y, width - spacing * 2, item_height, bg_color)
+        ui_render_rect(ctx, row_x, row_y, row_width, item_height, bg_color)
 
         // Border
         border_color := ctx.style.bg_light
         border_width: f32 = 1.0
-        ui_render_rect(ctx, x + spacing, current_y, width - spacing * 2, border_width, border_color)
-        ui_render_rect(ctx, x + spacing, current_y + item_height - border_width, width - spacing * 2, border_width, border_color)
-        ui_render_rect(ctx, x + spacing, current_y, border_width, item_height, border_color)
-        ui_render_rect(ctx, x + spacing + width - spacing * 2 - border_width, current_y, border_width, item_height, border_color)
+        ui_render_rect(ctx, row_x, row_y, row_width, border_width, border_color)
+        ui_render_rect(ctx, row_x, row_y + item_height - border_width, row_width, border_width, border_color)
+        ui_render_rect(ctx, row_x, row_y, border_width, item_height, border_color)
+        ui_render_rect(ctx, row_x + row_width - border_width, row_y, border_width, item_height, border_color)
 
         // Icon (with editing indicator)
-        icon_size: f32 = 24
-        icon_x := x + spacing + 4
-        icon_y := current_y + (item_height - icon_size) * 0.5
+        icon_x := row_x + 4
+        icon_y := row_y + (item_height - icon_size) * 0.5
 
         ui_render_rect(ctx, icon_x, icon_y, icon_size, icon_size, ctx.style.bg_medium)
 
         // Icon text - show "✏️" if editing, otherwise show feature type
         display_icon := is_editing ? "ED" : icon_text  // "ED" for "Editing"
         display_color := is_editing ? [4]u8{255, 255, 0, 255} : icon_color  // Yellow if editing
+        display_size := is_editing ? view.editing_icon_size : view.icon_sizes[feature.type]
 
-        icon_text_width, icon_text_height := ui_measure_text(ctx, display_icon, ctx.style.font_size_small)
-        icon_text_x := icon_x + (icon_size - icon_text_width) * 0.5
-        icon_text_y := icon_y + (icon_size - icon_text_height) * 0.5
+        icon_text_x := icon_x + (icon_size - display_size.x) * 0.5
+        icon_text_y := icon_y + (icon_size - display_size.y) * 0.5
         ui_render_text(ctx, display_icon, icon_text_x, icon_text_y, ctx.style.font_size_small, display_color)
 
-        // Feature name
+        // Feature name (measured and elided once per feature revision)
         name_x := icon_x + icon_size + 8
-        name_y := current_y + (item_height - ctx.style.font_size_small) * 0.5
-        ui_render_text(ctx, feature.name, name_x, name_y, ctx.style.font_size_small, ctx.style.text_primary)
+        name_y := row_y + (item_height - ctx.style.font_size_small) * 0.5
+        ui_render_text(ctx, feature_tree_view_row_label(view, ctx, row, feature), name_x, name_y, ctx.style.font_size_small, ctx.style.text_primary)
 
         // Checkmark button (✓) for finishing sketch edit (only show when editing)
         if is_editing && feature.type == .Sketch {
             checkmark_size: f32 = 20
             checkmark_x := x + width - spacing - checkmark_size - 40  // Position before visibility indicator
-            checkmark_y := current_y + (item_height - checkmark_size) * 0.5
+            checkmark_y := row_y + (item_height - checkmark_size) * 0.5
 
             // Check if mouse is over checkmark button
-            is_checkmark_hot := ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, checkmark_x, checkmark_y, checkmark_size, checkmark_size)
+            is_checkmark_hot := over_list && ui_point_in_rect(ctx.mouse_x, ctx.mouse_y, checkmark_x, checkmark_y, checkmark_size, checkmark_size)
 
             // Checkmark button background
             checkmark_bg_color := is_checkmark_hot ? [4]u8{0, 150, 0, 255} : [4]u8{0, 100, 0, 255}  // Green
@@ -862,14 +969,12 @@ ui_feature_tree_panel :: proc(
 
             // Checkmark text "✓"
             checkmark_text := "OK"  // Using "OK" since "✓" might not render well
-            check_text_width, check_text_height := ui_measure_text(ctx, checkmark_text, ctx.style.font_size_small)
-            check_text_x := checkmark_x + (checkmark_size - check_text_width) * 0.5
-            check_text_y := checkmark_y + (checkmark_size - check_text_height) * 0.5
+            check_text_x := checkmark_x + (checkmark_size - view.checkmark_size.x) * 0.5
+            check_text_y := checkmark_y + (checkmark_size - view.checkmark_size.y) * 0.5
             ui_render_text(ctx, checkmark_text, check_text_x, check_text_y, ctx.style.font_size_small, {255, 255, 255, 255})
 
             // Detect click on checkmark button
             if is_checkmark_hot {
-                ctx.mouse_over_ui = true
                 if !ctx.mouse_down_prev && ctx.mouse_down {
                     // Trigger finish edit action
                     interaction.double_clicked = true  // Reuse this flag to signal "finish editing"
@@ -882,11 +987,13 @@ ui_feature_tree_panel :: proc(
         if feature.visible {
             vis_size: f32 = 8
             vis_x := x + width - spacing - vis_size - 8
-            vis_y := current_y + (item_height - vis_size) * 0.5
+            vis_y := row_y + (item_height - vis_size) * 0.5
             ui_render_rect(ctx, vis_x, vis_y, vis_size, vis_size, {0, 255, 100, 255})
         }
+    }
 
-        current_y += item_height + 4
+    if len(view.rows) > 0 {
+        current_y = list_y + viewport_height + FEATURE_ROW_GAP
     }
 
     height = current_y - y  // Return total height used
@@ -0,0 +1,239 @@
+// OhCAD - Virtualized feature tree list
+// The HISTORY panel only lays out and draws the rows inside its scroll window. The row list
+// (enabled features, in order) is rebuilt when the tree's revision or length changes, and each
+// row's elided label is cached by feature revision, so per-frame cost follows the number of
+// visible rows rather than the size of the history.
+package widgets
+
+import "core:strings"
+import ftree "../../features/feature_tree"
+
+FEATURE_ROW_HEIGHT :: 28
+FEATURE_ROW_GAP :: 4
+FEATURE_ROW_STRIDE :: FEATURE_ROW_HEIGHT + FEATURE_ROW_GAP
+
+// Cached layout for one visible-in-list feature
+FeatureTreeRow :: struct {
+    feature_index: int,  // Index into FeatureTree.features
+    feature_id: int,
+    measured: bool,      // label is valid for `revision`
+    revision: u64,       // Feature revision the label was measured at
+    label: string,       // Feature name, elided to the label width
+    label_owned: bool,   // label was allocated (elided) and must be freed
+}
+
+FeatureTreeView :: struct {
+    rows: [dynamic]FeatureTreeRow,
+
+    // What the rows were built from - any change triggers a rebuild
+    tree: ^ftree.FeatureTree,
+    tree_revision: u64,
+    tree_length: int,
+
+    // What the labels were measured with - any change re-measures visible rows
+    font_size: f32,
+    label_width: f32,
+    icon_sizes: [ftree.FeatureType][2]f32,
+    editing_icon_size: [2]f32,
+    checkmark_size: [2]f32,
+
+    // Scrolling
+    scroll: f32,              // Pixels from the top of the list
+    viewport_height: f32,     // Height of the scroll window last frame
+    jump_to_id: int,          // Feature to bring into view on the next layout (-1 = none)
+    last_editing_id: int,     // Editing a different feature jumps to it
+    dragging_scrollbar: bool,
+}
+
+feature_tree_view_init :: proc() -> FeatureTreeView {
+    return FeatureTreeView{
+        rows = make([dynamic]FeatureTreeRow),
+        tree_length = -1,
+        jump_to_id = -1,
+        last_editing_id = -1,
+    }
+}
+
+feature_tree_view_destroy :: proc(view: ^FeatureTreeView) {
+    feature_tree_view_clear_rows(view)
+    delete(view.rows)
+}
+
+// =============================================================================
+// Scrolling API
+// =============================================================================
+
+// Scroll the history panel by whole rows (negative = up)
+ui_feature_tree_scroll_rows :: proc(cad_state: ^CADUIState, rows: int) {
+    view := &cad_state.feature_tree_view
+    view.scroll += f32(rows) * FEATURE_ROW_STRIDE
+    feature_tree_view_clamp(view)
+}
+
+// Scroll the history panel by whole pages (negative = up)
+ui_feature_tree_scroll_pages :: proc(cad_state: ^CADUIState, pages: int) {
+    view := &cad_state.feature_tree_view
+    page_rows := max(int(view.viewport_height / FEATURE_ROW_STRIDE) - 1, 1)
+    ui_feature_tree_scroll_rows(cad_state, pages * page_rows)
+}
+
+// Bring a feature's row into view on the next frame (no-op if it is already visible)
+ui_feature_tree_jump_to :: proc(cad_state: ^CADUIState, feature_id: int) {
+    cad_state.feature_tree_view.jump_to_id = feature_id
+}
+
+// =============================================================================
+// Layout (called by ui_feature_tree_panel)
+// =============================================================================
+
+// Rebuild rows / drop cached labels if the tree or the text metrics changed
+feature_tree_view_sync :: proc(view: ^FeatureTreeView, ctx: ^UIContext, tree: ^ftree.FeatureTree, label_width: f32) {
+    font_size := ctx.style.font_size_small
+
+    if font_size != view.font_size {
+        view.font_size = font_size
+        for type in ftree.FeatureType {
+            w, h := ui_measure_text(ctx, feature_type_icon(type), font_size)
+            view.icon_sizes[type] = {w, h}
+        }
+        w, h := ui_measure_text(ctx, "ED", font_size)
+        view.editing_icon_size = {w, h}
+        w, h = ui_measure_text(ctx, "OK", font_size)
+        view.checkmark_size = {w, h}
+        view.label_width = -1  // Force label re-measure below
+    }
+
+    if tree != view.tree || tree.revision != view.tree_revision || len(tree.features) != view.tree_length {
+        // Keep following the newest feature if the list was scrolled to the bottom
+        at_bottom := view.scroll >= feature_tree_view_max_scroll(view) - 1
+        grew := view.tree == tree && len(tree.features) > view.tree_length
+
+        feature_tree_view_clear_rows(view)
+        for feature, i in tree.features {
+            if !feature.enabled do continue
+            append(&view.rows, FeatureTreeRow{feature_index = i, feature_id = feature.id})
+        }
+
+        view.tree = tree
+        view.tree_revision = tree.revision
+        view.tree_length = len(tree.features)
+
+        if at_bottom && grew {
+            view.scroll = feature_tree_view_max_scroll(view)
+        }
+        feature_tree_view_clamp(view)
+    }
+
+    if label_width != view.label_width {
+        view.label_width = label_width
+        for &row in view.rows {
+            feature_tree_view_release_label(&row)
+        }
+    }
+}
+
+// Set the scroll window height and resolve any pending jump
+feature_tree_view_set_viewport :: proc(view: ^FeatureTreeView, viewport_height: f32) {
+    view.viewport_height = viewport_height
+
+    if view.jump_to_id >= 0 {
+        for row, i in view.rows {
+            if row.feature_id != view.jump_to_id do continue
+
+            row_top := f32(i) * FEATURE_ROW_STRIDE
+            row_bottom := row_top + FEATURE_ROW_HEIGHT
+            if row_top < view.scroll {
+                view.scroll = row_top
+            } else if row_bottom > view.scroll + viewport_height {
+                view.scroll = row_bottom - viewport_height
+            }
+            break
+        }
+        view.jump_to_id = -1
+    }
+
+    feature_tree_view_clamp(view)
+}
+
+// Range of row indices intersecting the scroll window
+feature_tree_view_visible_range :: proc(view: ^FeatureTreeView) -> (first, last: int) {
+    first = clamp(int(view.scroll / FEATURE_ROW_STRIDE), 0, len(view.rows))
+    last = clamp(int((view.scroll + view.viewport_height) / FEATURE_ROW_STRIDE) + 1, first, len(view.rows))
+    return
+}
+
+// Row's label, measured and elided on first use after the feature changes
+feature_tree_view_row_label :: proc(view: ^FeatureTreeView, ctx: ^UIContext, row: ^FeatureTreeRow, feature: ^ftree.FeatureNode) -> string {
+    if row.measured && row.revision == feature.revision {
+        return row.label
+    }
+
+    feature_tree_view_release_label(row)
+    row.measured = true
+    row.revision = feature.revision
+    row.label = feature.name
+
+    width, _ := ui_measure_text(ctx, feature.name, view.font_size)
+    if width <= view.label_width {
+        return row.label
+    }
+
+    // Drop characters until the name plus an ellipsis fits
+    ellipsis_width, _ := ui_measure_text(ctx, "...", view.font_size)
+    end := len(feature.name)
+    for end > 0 {
+        end -= 1
+        for end > 0 && (feature.name[end] & 0xC0) == 0x80 do end -= 1  // UTF-8 boundary
+        w, _ := ui_measure_text(ctx, feature.name[:end], view.font_size)
+        if w + ellipsis_width <= view.label_width do break
+    }
+
+    row.label = strings.concatenate({feature.name[:end], "..."})
+    row.label_owned = true
+    return row.label
+}
+
+feature_tree_view_content_height :: proc(view: ^FeatureTreeView) -> f32 {
+    if len(view.rows) == 0 do return 0
+    return f32(len(view.rows)) * FEATURE_ROW_STRIDE - FEATURE_ROW_GAP
+}
+
+feature_tree_view_max_scroll :: proc(view: ^FeatureTreeView) -> f32 {
+    return max(feature_tree_view_content_height(view) - view.viewport_height, 0)
+}
+
+feature_tree_view_clamp :: proc(view: ^FeatureTreeView) {
+    view.scroll = clamp(view.scroll, 0, feature_tree_view_max_scroll(view))
+}
+
+// Icon abbreviation shown for each feature type
+feature_type_icon :: proc(type: ftree.FeatureType) -> string {
+    switch type {
+    case .Sketch:  return "SK"
+    case .Extrude: return "EX"
+    case .Revolve: return "RV"
+    case .Cut:     return "CT"
+    case .Move:    return "MV"
+    case .CopyBody: return "CP"
+    case .Fillet, .Chamfer: return "??"
+    }
+    return "??"
+}
+
+@(private="file")
+feature_tree_view_release_label :: proc(row: ^FeatureTreeRow) {
+    if row.label_owned {
+        delete(row.label)
+    }
+    row.label = ""
+    row.label_owned = false
+    row.measured = false
+}
+
+@(private="file")
+feature_tree_view_clear_rows :: proc(view: ^FeatureTreeView) {
+    for &row in view.rows {
+        feature_tree_view_release_label(&row)
+    }
+    clear(&view.rows)
+}
@@ -376,6 +376,7 @@ render_filled_rect_2d :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    v.frame_profiler_count_upload(&ctx.viewer.profiler, len(vertices) * size_of(v.LineVertex))
 
     // Wait for upload
     _ = sdl.WaitForGPUIdle(ctx.viewer.gpu_device)
@@ -406,6 +407,7 @@ render_filled_rect_2d :: proc(
     sdl.PushGPUVertexUniformData(ctx.cmd, 0, &uniforms, size_of(v.Uniforms))
     sdl.PushGPUFragmentUniformData(ctx.cmd, 0, &uniforms, size_of(v.Uniforms))
     sdl.DrawGPUPrimitives(ctx.pass, u32(len(vertices)), 1, 0, 0)
+    v.frame_profiler_count_draw(&ctx.viewer.profiler, len(vertices) / 3)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(ctx.pass, ctx.viewer.pipeline)
@@ -433,6 +435,7 @@ UIContext :: struct {
     mouse_down: bool,
     mouse_down_prev: bool,  // Previous frame mouse state for click detection
     mouse_clicked: bool,  // True for one frame after mouse up
+    scroll_y: f32,        // Mouse wheel steps since last frame (consumed by scrollable panels)
 
     // Widget ID tracking (for hover/active states)
     hot_id: u64,     // Widget under mouse
@@ -545,6 +548,9 @@ ui_end_frame :: proc(ctx: ^UIContext) {
     if !ctx.mouse_down {
         ctx.active_id = 0
     }
+
+    // Wheel input not consumed this frame is dropped
+    ctx.scroll_y = 0
 }
 
 // Generate unique widget ID
@@ -563,6 +569,21 @@ ui_point_in_rect :: proc(x, y, rx, ry, rw, rh: f32) -> bool {
 // Low-Level Rendering Helpers
 // =============================================================================
 
+// Clip subsequent UI drawing to a screen rectangle (scrolling lists)
+ui_set_clip :: proc(ctx: ^UIContext, x, y, width, height: f32) {
+    sdl.SetGPUScissor(ctx.pass, sdl.Rect{
+        x = i32(max(x, 0)),
+        y = i32(max(y, 0)),
+        w = i32(max(width, 0)),
+        h = i32(max(height, 0)),
+    })
+}
+
+// Restore full-screen drawing after ui_set_clip
+ui_clear_clip :: proc(ctx: ^UIContext) {
+    sdl.SetGPUScissor(ctx.pass, sdl.Rect{x = 0, y = 0, w = i32(ctx.screen_width), h = i32(ctx.screen_height)})
+}
+
 // Render filled rectangle
 ui_render_rect :: proc(
     ctx: ^UIContext,
@@ -634,6 +655,7 @@ ui_render_rect :: proc(
     sdl.UploadToGPUBuffer(copy_pass, src, dst, false)
     sdl.EndGPUCopyPass(copy_pass)
     _ = sdl.SubmitGPUCommandBuffer(upload_cmd)
+    v.frame_profiler_count_upload(&ctx.viewer.profiler, int(buffer_size))
     _ = sdl.WaitForGPUIdle(ctx.viewer.gpu_device)
 
     // Bind triangle pipeline
@@ -659,6 +681,7 @@ ui_render_rect :: proc(
 
     // Draw rectangle
     sdl.DrawGPUPrimitives(ctx.pass, 6, 1, 0, 0)
+    v.frame_profiler_count_draw(&ctx.viewer.profiler, 2)
 
     // Switch back to line pipeline
     sdl.BindGPUGraphicsPipeline(ctx.pass, ctx.viewer.pipeline)
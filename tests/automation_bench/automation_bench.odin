@@ -0,0 +1,341 @@
+// tests/automation_bench - Load-test client for the automation server (ohcad_gpu --serve)
+//
+// Writes a small sketch, loads it into `docs` documents, then drives the server from
+// `connections` client threads. Each connection keeps up to `pipeline` requests in flight
+// and cycles set_param → regenerate → mass_properties → mass_properties (cache hit).
+// Reports requests per second and per-op latency percentiles.
+//
+// Usage: odin run tests/automation_bench -o:speed -- <socket> [--docs n] [--connections n]
+//        [--requests n] [--pipeline n] [--shutdown]
+package automation_bench
+
+import "core:fmt"
+import "core:os"
+import "core:path/filepath"
+import "core:slice"
+import "core:strconv"
+import "core:strings"
+import "core:sys/posix"
+import "core:thread"
+import "core:time"
+import sketch "../../src/features/sketch"
+
+Options :: struct {
+    socket_path: string,
+    docs: int,
+    connections: int,
+    requests: int,     // Per connection
+    pipeline: int,
+    shutdown: bool,
+}
+
+OPS :: [4]string{"set_param", "regenerate", "mass_properties", "mass_properties"}
+
+// Per-connection results
+Client :: struct {
+    index: int,
+    opts: ^Options,
+    latencies: [len(OPS)][dynamic]f64,  // ms, indexed by position in OPS
+    errors: int,
+    ok: bool,
+}
+
+main :: proc() {
+    fmt.println("=== Automation Server Load Test ===\n")
+
+    opts, ok := parse_args(os.args[1:])
+    if !ok {
+        fmt.eprintln("Usage: automation_bench <socket> [--docs n] [--connections n] [--requests n] [--pipeline n] [--shutdown]")
+        os.exit(1)
+    }
+
+    sketch_path, _ := filepath.join({os.get_current_directory(context.temp_allocator), "automation_bench_sketch.json"})
+    if !write_test_sketch(sketch_path) {
+        fmt.eprintln("❌ Could not write", sketch_path)
+        os.exit(1)
+    }
+    defer os.remove(sketch_path)
+
+    // Load every document once, serially, before timing starts
+    {
+        fd, connected := connect(opts.socket_path)
+        if !connected {
+            os.exit(1)
+        }
+        defer posix.close(fd)
+
+        reader: LineReader
+        defer delete(reader.buffer)
+        for d in 0..<opts.docs {
+            send_line(fd, fmt.tprintf(`{"id":%d,"op":"load","doc":"doc_%d","path":"%s","depth":10}`, d, d, sketch_path))
+            line, _ := read_line(fd, &reader)
+            if !strings.contains(line, `"ok":true`) {
+                fmt.eprintln("❌ Load failed:", line)
+                os.exit(1)
+            }
+        }
+        fmt.printf("Loaded %d document(s)\n", opts.docs)
+    }
+
+    clients := make([]Client, opts.connections)
+    threads := make([]^thread.Thread, opts.connections)
+    defer {
+        for &client in clients {
+            for &list in client.latencies do delete(list)
+        }
+        delete(clients)
+        delete(threads)
+    }
+
+    start := time.tick_now()
+    for &client, i in clients {
+        client.index = i
+        client.opts = &opts
+        threads[i] = thread.create_and_start_with_poly_data(&client, run_client)
+    }
+    for t in threads {
+        thread.join(t)
+        thread.destroy(t)
+    }
+    wall := time.duration_seconds(time.tick_since(start))
+
+    report(clients, wall, opts)
+
+    if opts.shutdown {
+        if fd, connected := connect(opts.socket_path); connected {
+            send_line(fd, `{"id":0,"op":"shutdown"}`)
+            reader: LineReader
+            read_line(fd, &reader)
+            delete(reader.buffer)
+            posix.close(fd)
+        }
+    }
+}
+
+parse_args :: proc(args: []string) -> (opts: Options, ok: bool) {
+    opts.docs = 8
+    opts.requests = 2000
+    opts.pipeline = 16
+
+    for i := 0; i < len(args); i += 1 {
+        arg := args[i]
+        if arg == "--shutdown" {
+            opts.shutdown = true
+            continue
+        }
+        if !strings.has_prefix(arg, "--") {
+            opts.socket_path = arg
+            continue
+        }
+        if i + 1 >= len(args) do return opts, false
+        i += 1
+        value := strconv.parse_int(args[i]) or_return
+        if value <= 0 do return opts, false
+
+        switch arg {
+        case "--docs":        opts.docs = value
+        case "--connections": opts.connections = value
+        case "--requests":    opts.requests = value
+        case "--pipeline":    opts.pipeline = value
+        case:                 return opts, false
+        }
+    }
+
+    if opts.connections == 0 {
+        opts.connections = opts.docs
+    }
+    return opts, opts.socket_path != ""
+}
+
+// Rectangle profile (one closed loop → one extruded body)
+write_test_sketch :: proc(path: string) -> bool {
+    sk := sketch.sketch_init("Automation bench", sketch.sketch_plane_xy())
+    defer sketch.sketch_destroy(&sk)
+
+    p0 := sketch.sketch_add_point(&sk, 0, 0)
+    p1 := sketch.sketch_add_point(&sk, 40, 0)
+    p2 := sketch.sketch_add_point(&sk, 40, 25)
+    p3 := sketch.sketch_add_point(&sk, 0, 25)
+    sketch.sketch_add_line(&sk, p0, p1)
+    sketch.sketch_add_line(&sk, p1, p2)
+    sketch.sketch_add_line(&sk, p2, p3)
+    sketch.sketch_add_line(&sk, p3, p0)
+
+    return sketch.sketch_save_to_file(&sk, path)
+}
+
+// =============================================================================
+// Client Thread
+// =============================================================================
+
+run_client :: proc(client: ^Client) {
+    opts := client.opts
+    fd, connected := connect(opts.socket_path)
+    if !connected {
+        return
+    }
+    defer posix.close(fd)
+
+    reader: LineReader
+    defer delete(reader.buffer)
+
+    doc := client.index % opts.docs
+    sent_at := make([]time.Tick, opts.requests)
+    defer delete(sent_at)
+
+    sent, received := 0, 0
+    for received < opts.requests {
+        // Fill the pipeline window
+        for sent < opts.requests && sent - received < opts.pipeline {
+            op := OPS[sent % len(OPS)]
+            line: string
+            if op == "set_param" {
+                depth := 5.0 + f64((sent / len(OPS)) % 10)
+                line = fmt.tprintf(`{"id":%d,"op":"set_param","doc":"doc_%d","param":"depth","value":%.1f}`, sent, doc, depth)
+            } else {
+                line = fmt.tprintf(`{"id":%d,"op":"%s","doc":"doc_%d"}`, sent, op, doc)
+            }
+            sent_at[sent] = time.tick_now()
+            if !send_line(fd, line) {
+                return
+            }
+            sent += 1
+        }
+
+        response, ok := read_line(fd, &reader)
+        if !ok {
+            return
+        }
+        id, id_ok := response_id(response)
+        if !id_ok || id < 0 || id >= opts.requests {
+            client.errors += 1
+            received += 1
+            continue
+        }
+        if !strings.contains(response, `"ok":true`) {
+            client.errors += 1
+        }
+        append(&client.latencies[id % len(OPS)], time.duration_milliseconds(time.tick_since(sent_at[id])))
+        received += 1
+        free_all(context.temp_allocator)
+    }
+    client.ok = true
+}
+
+// =============================================================================
+// Reporting
+// =============================================================================
+
+report :: proc(clients: []Client, wall: f64, opts: Options) {
+    total, errors, failed_clients := 0, 0, 0
+    for client in clients {
+        errors += client.errors
+        if !client.ok do failed_clients += 1
+    }
+
+    fmt.printf("\n%d connection(s), %d document(s), pipeline %d\n", opts.connections, opts.docs, opts.pipeline)
+    fmt.printf("%-20s %8s %9s %9s %9s %9s\n", "op", "count", "p50 ms", "p95 ms", "p99 ms", "max ms")
+
+    all := make([dynamic]f64)
+    defer delete(all)
+
+    labels := [len(OPS)]string{"set_param", "regenerate", "mass_properties", "mass_properties*"}
+    for label, i in labels {
+        samples := make([dynamic]f64)
+        defer delete(samples)
+        for client in clients {
+            append(&samples, ..client.latencies[i][:])
+        }
+        append(&all, ..samples[:])
+        print_row(label, samples[:])
+    }
+    print_row("all", all[:])
+    total = len(all)
+
+    fmt.printf("\n%d request(s) in %.2f s → %.0f req/s", total, wall, f64(total) / wall)
+    fmt.printf(" (%d error(s), %d connection(s) dropped)\n", errors, failed_clients)
+    fmt.println("* second mass_properties after a regenerate is served from the result cache")
+}
+
+print_row :: proc(label: string, samples: []f64) {
+    if len(samples) == 0 {
+        fmt.printf("%-20s %8d\n", label, 0)
+        return
+    }
+    slice.sort(samples)
+    fmt.printf("%-20s %8d %9.3f %9.3f %9.3f %9.3f\n", label, len(samples),
+        percentile(samples, 0.50), percentile(samples, 0.95), percentile(samples, 0.99), samples[len(samples) - 1])
+}
+
+// Nearest-rank percentile of sorted samples
+percentile :: proc(sorted: []f64, q: f64) -> f64 {
+    rank := int(q * f64(len(sorted)) + 0.5)
+    return sorted[clamp(rank - 1, 0, len(sorted) - 1)]
+}
+
+// =============================================================================
+// Socket Helpers
+// =============================================================================
+
+LineReader :: struct {
+    buffer: [dynamic]u8,
+    consumed: int,
+}
+
+connect :: proc(socket_path: string) -> (posix.FD, bool) {
+    addr := posix.sockaddr_un{sun_family = .UNIX}
+    copy(addr.sun_path[:], socket_path)
+
+    fd := posix.socket(.UNIX, .STREAM)
+    if fd < 0 || posix.connect(fd, (^posix.sockaddr)(&addr), size_of(addr)) != .OK {
+        fmt.eprintln("❌ Cannot connect to", socket_path, "-", posix.strerror(posix.errno()))
+        if fd >= 0 do posix.close(fd)
+        return fd, false
+    }
+    return fd, true
+}
+
+send_line :: proc(fd: posix.FD, line: string) -> bool {
+    data := transmute([]u8)strings.concatenate({line, "\n"}, context.temp_allocator)
+    for sent := 0; sent < len(data); {
+        n := posix.send(fd, raw_data(data[sent:]), uint(len(data) - sent), {})
+        if n <= 0 do return false
+        sent += int(n)
+    }
+    return true
+}
+
+// Next response line (valid until the following call)
+read_line :: proc(fd: posix.FD, reader: ^LineReader) -> (string, bool) {
+    if reader.consumed > 0 {
+        remove_range(&reader.buffer, 0, reader.consumed)
+        reader.consumed = 0
+    }
+
+    scanned := 0
+    for {
+        for i in scanned..<len(reader.buffer) {
+            if reader.buffer[i] == '\n' {
+                reader.consumed = i + 1
+                return string(reader.buffer[:i]), true
+            }
+        }
+        scanned = len(reader.buffer)
+
+        chunk: [16 * 1024]u8
+        n := posix.recv(fd, raw_data(chunk[:]), len(chunk), {})
+        if n <= 0 do return "", false
+        append(&reader.buffer, ..chunk[:n])
+    }
+}
+
+// Value of the leading "id" field
+response_id :: proc(response: string) -> (int, bool) {
+    KEY :: `"id":`
+    start := strings.index(response, KEY)
+    if start < 0 do return 0, false
+    rest := response[start + len(KEY):]
+    end := strings.index_any(rest, ",}")
+    if end < 0 do return 0, false
+    return strconv.parse_int(rest[:end])
+}
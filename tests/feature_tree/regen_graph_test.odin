@@ -0,0 +1,110 @@
+// tests/feature_tree - Dependency graph of concurrent regeneration
+// Trees are assembled directly from feature nodes: building the graph never regenerates,
+// so no OCCT work runs (the package still links the OCCT wrapper).
+package test_feature_tree
+
+import "core:slice"
+import "core:testing"
+import ftree "../../src/features/feature_tree"
+
+// Feature IDs start at 0 and are appended in order, so they equal tree indices
+add_node :: proc(tree: ^ftree.FeatureTree, type: ftree.FeatureType, params: ftree.FeatureParams, parents: ..int) -> int {
+    feature := ftree.FeatureNode{
+        id = tree.next_id,
+        type = type,
+        params = params,
+        parent_features = make([dynamic]int),
+        enabled = true,
+        visible = true,
+    }
+    append(&feature.parent_features, ..parents)
+    tree.next_id += 1
+    append(&tree.features, feature)
+    return feature.id
+}
+
+add_sketch :: proc(tree: ^ftree.FeatureTree) -> int {
+    return add_node(tree, .Sketch, ftree.SketchParams{})
+}
+
+add_extrude :: proc(tree: ^ftree.FeatureTree, sketch_id: int) -> int {
+    return add_node(tree, .Extrude, ftree.ExtrudeParams{depth = 10, sketch_feature_id = sketch_id}, sketch_id)
+}
+
+add_cut :: proc(tree: ^ftree.FeatureTree, sketch_id, base_id: int) -> int {
+    params := ftree.CutParams{depth = 5, sketch_feature_id = sketch_id, base_feature_id = base_id}
+    return add_node(tree, .Cut, params, sketch_id, base_id)
+}
+
+add_copy_body :: proc(tree: ^ftree.FeatureTree, base_id: int) -> int {
+    return add_node(tree, .CopyBody, ftree.TransformParams{base_feature_id = base_id, translation = {20, 0, 0}}, base_id)
+}
+
+destroy_tree :: proc(tree: ^ftree.FeatureTree) {
+    for &feature in tree.features {
+        delete(feature.parent_features)
+    }
+    delete(tree.features)
+}
+
+// True if feature index `to` waits (directly or transitively) for index `from`
+depends_on :: proc(graph: ^ftree.RegenGraph, to, from: int) -> bool {
+    stack := make([dynamic]int, 0, 8, context.temp_allocator)
+    append(&stack, to)
+    for len(stack) > 0 {
+        current := pop(&stack)
+        if slice.contains(graph.deps[current][:], from) do return true
+        append(&stack, ..graph.deps[current][:])
+    }
+    return false
+}
+
+@(test)
+test_cut_on_copy_waits_for_cut_on_original :: proc(t: ^testing.T) {
+    tree: ftree.FeatureTree
+    defer destroy_tree(&tree)
+
+    body := add_extrude(&tree, add_sketch(&tree))
+    copy_id := add_copy_body(&tree, body)
+    cut_original := add_cut(&tree, add_sketch(&tree), body)
+    cut_copy := add_cut(&tree, add_sketch(&tree), copy_id)
+
+    graph := ftree.regen_graph_build(&tree)
+    defer ftree.regen_graph_destroy(&graph)
+
+    // Both cuts mesh faces of the same TShape, so they must not run concurrently
+    testing.expect(t, depends_on(&graph, cut_copy, cut_original), "cut on the copy should wait for the cut on the original")
+}
+
+@(test)
+test_cut_on_cut_result_shares_root :: proc(t: ^testing.T) {
+    tree: ftree.FeatureTree
+    defer destroy_tree(&tree)
+
+    body := add_extrude(&tree, add_sketch(&tree))
+    first_cut := add_cut(&tree, add_sketch(&tree), body)
+    copy_id := add_copy_body(&tree, first_cut)
+    other_cut := add_cut(&tree, add_sketch(&tree), body)
+    cut_copy := add_cut(&tree, add_sketch(&tree), copy_id)
+
+    graph := ftree.regen_graph_build(&tree)
+    defer ftree.regen_graph_destroy(&graph)
+
+    testing.expect(t, depends_on(&graph, cut_copy, other_cut), "a copy of a cut result shares the original body's root")
+}
+
+@(test)
+test_independent_bodies_stay_parallel :: proc(t: ^testing.T) {
+    tree: ftree.FeatureTree
+    defer destroy_tree(&tree)
+
+    body_a := add_extrude(&tree, add_sketch(&tree))
+    body_b := add_extrude(&tree, add_sketch(&tree))
+    cut_a := add_cut(&tree, add_sketch(&tree), body_a)
+    cut_b := add_cut(&tree, add_sketch(&tree), body_b)
+
+    graph := ftree.regen_graph_build(&tree)
+    defer ftree.regen_graph_destroy(&graph)
+
+    testing.expect(t, !depends_on(&graph, cut_b, cut_a), "cuts on unrelated bodies should not be chained")
+}
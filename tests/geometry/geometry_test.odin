@@ -291,3 +291,85 @@ test_distance_to_cylinder :: proc(t: ^testing.T) {
 
     testing.expect(t, m.is_near(dist, 5.0), "Distance should be 5")
 }
+
+// =============================================================================
+// Bézier / B-Spline Tests
+// =============================================================================
+
+@(test)
+test_point_on_bezier_2d :: proc(t: ^testing.T) {
+    curve := g.Bezier2{control_points = {{0, 0}, {0, 1}, {1, 1}, {1, 0}}}
+
+    testing.expect(t, m.is_near(g.point_on_bezier_2d(curve, 0.0), m.Vec2{0, 0}), "t=0 should give first control point")
+    testing.expect(t, m.is_near(g.point_on_bezier_2d(curve, 0.5), m.Vec2{0.5, 0.75}), "t=0.5 of symmetric arch")
+    testing.expect(t, m.is_near(g.point_on_bezier_2d(curve, 1.0), m.Vec2{1, 0}), "t=1 should give last control point")
+
+    left, right := g.split_bezier_2d(curve, 0.5)
+    testing.expect(t, m.is_near(left.control_points[3], m.Vec2{0.5, 0.75}), "Split point should lie on the curve")
+    testing.expect(t, m.is_near(g.point_on_bezier_2d(right, 0.5), g.point_on_bezier_2d(curve, 0.75)), "Right half should reparameterize")
+}
+
+@(test)
+test_points_on_bezier_2d_batch :: proc(t: ^testing.T) {
+    curve := g.Bezier2{control_points = {{-2, 1}, {0.5, 4}, {3, -2}, {5, 0.25}}}
+
+    // 7 parameters: one 4-wide step plus a scalar tail
+    params := []f64{0, 0.1, 0.25, 0.5, 0.6, 0.9, 1}
+    out: [7]m.Vec2
+    g.points_on_bezier_2d_batch(curve, params, out[:])
+
+    for p, i in params {
+        testing.expect(t, m.is_near(out[i], g.point_on_bezier_2d(curve, p)), "Batch should match scalar evaluation")
+    }
+}
+
+@(test)
+test_flatten_bezier_2d :: proc(t: ^testing.T) {
+    curve := g.Bezier2{control_points = {{0, 0}, {0, 10}, {10, 10}, {10, 0}}}
+    tolerance := 0.01
+
+    polyline := make([dynamic]m.Vec2)
+    defer delete(polyline)
+    g.flatten_bezier_2d(curve, tolerance, &polyline)
+
+    testing.expect(t, len(polyline) >= 3, "Curved segment should subdivide")
+    testing.expect(t, polyline[0] == curve.control_points[0], "Polyline should start on the curve")
+    testing.expect(t, polyline[len(polyline) - 1] == curve.control_points[3], "Polyline should end on the curve")
+
+    // Every curve point stays within tolerance of the polyline
+    for i in 0..=200 {
+        p := g.point_on_bezier_2d(curve, f64(i) / 200.0)
+        dist, _ := g.distance_point_to_polyline_2d(p, polyline[:])
+        testing.expect(t, dist <= tolerance, "Flattened curve should be within tolerance")
+    }
+}
+
+@(test)
+test_bspline_to_beziers_2d :: proc(t: ^testing.T) {
+    beziers := make([dynamic]g.Bezier2)
+    defer delete(beziers)
+
+    // 4 control points: the B-spline is the Bézier itself
+    single := []m.Vec2{{0, 0}, {1, 2}, {3, 2}, {4, 0}}
+    testing.expect(t, g.bspline_to_beziers_2d(single, &beziers), "4 control points should convert")
+    testing.expect(t, len(beziers) == 1, "4 control points should give one segment")
+    for i in 0..<4 {
+        testing.expect(t, m.is_near(beziers[0].control_points[i], single[i]), "Segment should keep the control points")
+    }
+
+    // 6 control points: 3 segments, clamped ends, C1 at the joins
+    clear(&beziers)
+    controls := []m.Vec2{{0, 0}, {1, 3}, {3, 4}, {5, 1}, {7, 3}, {8, 0}}
+    testing.expect(t, g.bspline_to_beziers_2d(controls, &beziers), "6 control points should convert")
+    testing.expect(t, len(beziers) == 3, "6 control points should give three segments")
+    testing.expect(t, m.is_near(beziers[0].control_points[0], controls[0]), "Curve should start at the first control point")
+    testing.expect(t, m.is_near(beziers[2].control_points[3], controls[5]), "Curve should end at the last control point")
+
+    for i in 0..<len(beziers) - 1 {
+        a, b := beziers[i].control_points, beziers[i + 1].control_points
+        testing.expect(t, m.is_near(a[3], b[0]), "Segments should join")
+        testing.expect(t, m.is_near(a[3] - a[2], b[1] - b[0]), "Segments should be tangent continuous")
+    }
+
+    testing.expect(t, !g.bspline_to_beziers_2d(controls[:1], &beziers), "A single control point is not a curve")
+}
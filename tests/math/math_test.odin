@@ -195,6 +195,14 @@ test_segment_segment_intersect_2d :: proc(t: ^testing.T) {
 
     _, ok2 := m.segment_segment_intersect_2d(c0, c1, d0, d1)
     testing.expect(t, !ok2, "Segments should not intersect (only extended lines would)")
+
+    // Exact decisions: a T-junction touches, a near miss does not
+    touch, ok3 := m.segment_segment_intersect_2d(m.Vec2{0, 0}, m.Vec2{2, 0}, m.Vec2{1, 0}, m.Vec2{1, 1})
+    testing.expect(t, ok3, "Segment ending on another should intersect")
+    testing.expect(t, touch == m.Vec2{1, 0}, "T-junction should meet at (1, 0)")
+
+    _, ok4 := m.segment_segment_intersect_2d(m.Vec2{0, 0}, m.Vec2{2, 0}, m.Vec2{1, 1e-12}, m.Vec2{1, 1})
+    testing.expect(t, !ok4, "Segment stopping just short of another should not intersect")
 }
 
 // =============================================================================
@@ -387,3 +395,122 @@ test_is_polygon_ccw :: proc(t: ^testing.T) {
 
     testing.expect(t, !m.is_polygon_ccw(cw_square), "CW square should not be detected as CCW")
 }
+
+// =============================================================================
+// Robust Predicates
+// =============================================================================
+
+@(test)
+test_orient2d_signs :: proc(t: ^testing.T) {
+    a := m.Vec2{0, 0}
+    b := m.Vec2{1, 0}
+
+    testing.expect(t, m.orient2d(a, b, m.Vec2{0.5, 1}) > 0, "Point left of a→b should be CCW")
+    testing.expect(t, m.orient2d(a, b, m.Vec2{0.5, -1}) < 0, "Point right of a→b should be CW")
+    testing.expect(t, m.orient2d(a, b, m.Vec2{7, 0}) == 0, "Collinear point should be exactly 0")
+}
+
+@(test)
+test_orient2d_near_degenerate :: proc(t: ^testing.T) {
+    // Points on the line y = x offset by one ulp - plain f64 evaluation loses the sign here
+    a := m.Vec2{0.5, 0.5}
+    b := m.Vec2{12, 12}
+    c := m.Vec2{24, 24}
+    above := m.Vec2{0.5, math.nextafter_f64(0.5, 1)}
+    below := m.Vec2{0.5, math.nextafter_f64(0.5, 0)}
+
+    testing.expect(t, m.orient2d(b, c, a) == 0, "Exactly collinear points should give 0")
+    testing.expect(t, m.orient2d(b, c, above) > 0, "One ulp above the line should be CCW")
+    testing.expect(t, m.orient2d(b, c, below) < 0, "One ulp below the line should be CW")
+
+    // Batch path must agree with the scalar predicate lane by lane
+    points := []m.Vec2{a, above, below, {3, 4}, {4, 3}}
+    out: [5]f64
+    m.orient2d_batch(b, c, points, out[:])
+    for p, i in points {
+        s := m.orient2d(b, c, p)
+        testing.expect(t, (out[i] > 0) == (s > 0) && (out[i] < 0) == (s < 0), "Batch sign should match scalar")
+    }
+}
+
+@(test)
+test_orient3d_and_incircle :: proc(t: ^testing.T) {
+    a := m.Vec3{0, 0, 0}
+    b := m.Vec3{1, 0, 0}
+    c := m.Vec3{0, 1, 0}
+
+    testing.expect(t, m.orient3d(a, b, c, m.Vec3{0, 0, -1}) > 0, "Point below CCW triangle should be positive")
+    testing.expect(t, m.orient3d(a, b, c, m.Vec3{0, 0, 1}) < 0, "Point above CCW triangle should be negative")
+    testing.expect(t, m.orient3d(a, b, c, m.Vec3{0.3, 0.3, 0}) == 0, "Coplanar point should be exactly 0")
+
+    p := m.Vec2{0, 0}
+    q := m.Vec2{1, 0}
+    r := m.Vec2{0, 1}
+    testing.expect(t, m.incircle(p, q, r, m.Vec2{0.5, 0.5}) > 0, "Circumcenter should be inside")
+    testing.expect(t, m.incircle(p, q, r, m.Vec2{2, 2}) < 0, "Far point should be outside")
+    testing.expect(t, m.incircle(p, q, r, m.Vec2{1, 1}) == 0, "Cocircular point should be exactly 0")
+}
+
+@(test)
+test_ray_triangle_shared_edge :: proc(t: ^testing.T) {
+    // Two triangles sharing the diagonal of the unit square; a ray through the diagonal
+    // must hit exactly one of them
+    tris := []m.TrianglePoints{
+        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}},
+        {{0, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+    }
+    origin := m.Vec3{0.3, 0.3, 5}
+    dir := m.Vec3{0, 0, -1}
+
+    hits_t: [2]f64
+    hits := m.ray_triangles_batch(origin, dir, tris, hits_t[:])
+    testing.expect(t, hits == 1, "Ray through shared edge should hit exactly one triangle")
+
+    // Same from below (back faces) and through the 4-wide path (padding triangles miss)
+    up_hits := m.ray_triangles_batch(m.Vec3{0.3, 0.3, -5}, m.Vec3{0, 0, 1}, tris, hits_t[:])
+    testing.expect(t, up_hits == 1, "Ray from the back should also hit exactly one triangle")
+
+    wide := []m.TrianglePoints{
+        tris[0],
+        {{5, 5, 0}, {6, 5, 0}, {6, 6, 0}},
+        tris[1],
+        {{5, 5, 0}, {6, 6, 0}, {5, 6, 0}},
+    }
+    wide_t: [4]f64
+    wide_hits := m.ray_triangles_batch(origin, dir, wide, wide_t[:])
+    testing.expect(t, wide_hits == 1, "Batched ray through shared edge should hit exactly one triangle")
+
+    // Ray through a vertex shared by a fan of four triangles
+    center := m.Vec3{0.5, 0.5, 0}
+    fan := []m.TrianglePoints{
+        {center, {0, 0, 0}, {1, 0, 0}},
+        {center, {1, 0, 0}, {1, 1, 0}},
+        {center, {1, 1, 0}, {0, 1, 0}},
+        {center, {0, 1, 0}, {0, 0, 0}},
+    }
+    fan_hits := m.ray_triangles_batch(m.Vec3{0.5, 0.5, 5}, dir, fan, wide_t[:])
+    testing.expect(t, fan_hits == 1, "Ray through shared vertex should hit exactly one triangle")
+    testing.expect(t, m.ray_triangles_any_hit(origin, dir, tris, 10), "Occlusion query should report the hit")
+    testing.expect(t, !m.ray_triangles_any_hit(origin, dir, tris, 4), "Hit beyond max_t should be ignored")
+
+    tt, hit := m.ray_triangle(m.Vec3{2, 2, 5}, dir, tris[0][0], tris[0][1], tris[0][2])
+    testing.expect(t, !hit, "Ray outside triangle should miss")
+    _ = tt
+}
+
+@(test)
+test_classify_point_polygon :: proc(t: ^testing.T) {
+    square := []m.Vec2{{0, 0}, {10, 0}, {10, 10}, {0, 10}}
+
+    testing.expect(t, m.classify_point_polygon_2d(m.Vec2{5, 5}, square) == .Inside, "Center should be inside")
+    testing.expect(t, m.classify_point_polygon_2d(m.Vec2{10, 5}, square) == .Boundary, "Point on edge should be boundary")
+    testing.expect(t, m.classify_point_polygon_2d(m.Vec2{0, 0}, square) == .Boundary, "Vertex should be boundary")
+    testing.expect(t, m.classify_point_polygon_2d(m.Vec2{-1, 0}, square) == .Outside, "Point on edge extension should be outside")
+
+    points := []m.Vec2{{5, 5}, {10, 5}, {11, 5}, {0, 0}, {2, 9}, {-3, 10}}
+    sides: [6]m.PolygonSide
+    m.classify_points_polygon_2d_batch(points, square, sides[:])
+    for p, i in points {
+        testing.expect(t, sides[i] == m.classify_point_polygon_2d(p, square), "Batch classification should match scalar")
+    }
+}
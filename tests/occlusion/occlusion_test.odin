@@ -0,0 +1,337 @@
+// tests/occlusion - Hi-Z occlusion culling against an unculled render
+//
+// Headless scene: a wall, boxes hidden behind it, and boxes in front of / beside it.
+// Renders every frame twice - two-phase culled and plain - and checks that:
+//   - the culled image matches the plain one (no missing or popping bodies)
+//   - the GPU reports exactly the boxes behind the wall as hidden
+//   - turning the camera around reveals them in the same frame (phase 2)
+//   - bodies hidden long enough are parked, and come back after the camera turns
+//
+// Runs on Metal, or Vulkan with the SPIR-V ports (lavapipe works: make test-occlusion).
+// Exits 1 on any failure, including a device without occlusion culling support.
+package occlusion_test
+
+import "core:fmt"
+import "core:os"
+import viewer "../../src/ui/viewer"
+import extrude "../../src/features/extrude"
+import m "../../src/core/math"
+import sdl "vendor:sdl3"
+
+SIZE :: 256
+
+// Scene layout (camera looks down -Z from the front, +Z from the back)
+WALL :: 0
+HIDDEN_FRONT :: []int{1, 2, 3}   // Behind the wall from the front, in front of it from the back
+VISIBLE_FRONT :: []int{4}        // In front of the wall from the front, behind it from the back
+BESIDE :: 5                      // Next to the wall - visible from both sides
+
+Scene :: struct {
+    color: ^sdl.GPUTexture,
+    depth: ^sdl.GPUTexture,
+    readback: ^sdl.GPUTransferBuffer,
+    solids: [dynamic]^extrude.SimpleSolid,
+    items: [dynamic]viewer.OcclusionItem,
+    bbox_min: m.Vec3,
+    bbox_max: m.Vec3,
+}
+
+main :: proc() {
+    fmt.println("=== Hi-Z Occlusion Culling Test ===\n")
+
+    gpu, ok := viewer.viewer_gpu_init(viewer.HEADLESS_GPU_CONFIG)
+    if !ok {
+        fmt.eprintln("FAIL: could not create a headless GPU viewer")
+        os.exit(1)
+    }
+    defer viewer.viewer_gpu_destroy(gpu)
+
+    if !gpu.occlusion.enabled {
+        fmt.eprintln("FAIL: occlusion culling is not available on this device")
+        os.exit(1)
+    }
+
+    scene: Scene
+    if !scene_init(gpu, &scene) {
+        os.exit(1)
+    }
+    defer scene_destroy(gpu, &scene)
+
+    failed := 0
+
+    // Frame 1 has no history: everything is drawn in phase 1, then tested
+    failed += check_frame(gpu, &scene, .Front, "front, first frame")
+    failed += check_hidden(gpu, HIDDEN_FRONT, VISIBLE_FRONT, "front")
+
+    // Frame 2 skips the hidden boxes entirely
+    failed += check_frame(gpu, &scene, .Front, "front, hidden boxes skipped")
+
+    // Turning around: last frame's hidden boxes are now in front and must show up in phase 2
+    failed += check_frame(gpu, &scene, .Back, "back, revealed in the same frame")
+    failed += check_hidden(gpu, VISIBLE_FRONT, HIDDEN_FRONT, "back")
+
+    // Hidden long enough → parked (not drawn, mesh can be evicted)
+    for _ in 0..<viewer.OCCLUSION_PARK_FRAMES {
+        delete(render(gpu, &scene, .Front, true))
+    }
+    viewer.occlusion_print_stats(gpu)
+    if gpu.occlusion.stats.parked != len(HIDDEN_FRONT) {
+        fmt.printf("FAIL: %d bodies parked, expected %d\n", gpu.occlusion.stats.parked, len(HIDDEN_FRONT))
+        failed += 1
+    } else {
+        fmt.printf("PASS: %d hidden bodies parked\n", len(HIDDEN_FRONT))
+    }
+
+    // Parked bodies wait for a readback: one frame late, then drawn again
+    delete(render(gpu, &scene, .Back, true))
+    failed += check_frame(gpu, &scene, .Back, "back, parked bodies restored")
+    failed += check_hidden(gpu, VISIBLE_FRONT, HIDDEN_FRONT, "back after parking")
+
+    fmt.println()
+    if failed > 0 {
+        fmt.printf("✗ %d check(s) failed\n", failed)
+        os.exit(1)
+    }
+    fmt.println("✓ All occlusion checks passed")
+}
+
+// =============================================================================
+// Checks
+// =============================================================================
+
+// Culled and unculled renders of the same view must match
+check_frame :: proc(gpu: ^viewer.ViewerGPU, scene: ^Scene, view: viewer.PreviewView, label: string) -> int {
+    culled := render(gpu, scene, view, true)
+    defer delete(culled)
+    reference := render(gpu, scene, view, false)
+    defer delete(reference)
+
+    differing := 0
+    for i in 0..<len(reference) {
+        if abs(int(culled[i]) - int(reference[i])) > 1 do differing += 1
+    }
+
+    if differing > 0 {
+        fmt.printf("FAIL: %s - %d channel values differ from the unculled render\n", label, differing)
+        return 1
+    }
+    fmt.printf("PASS: %s\n", label)
+    return 0
+}
+
+check_hidden :: proc(gpu: ^viewer.ViewerGPU, hidden, visible: []int, label: string) -> int {
+    failed := 0
+    for id in hidden {
+        if viewer.occlusion_hidden_frames(gpu, id) == 0 {
+            fmt.printf("FAIL: %s - body %d should be hidden\n", label, id)
+            failed += 1
+        }
+    }
+    for id in ([]int{WALL, BESIDE}) {
+        if viewer.occlusion_hidden_frames(gpu, id) != 0 {
+            fmt.printf("FAIL: %s - body %d should be visible\n", label, id)
+            failed += 1
+        }
+    }
+    for id in visible {
+        if viewer.occlusion_hidden_frames(gpu, id) != 0 {
+            fmt.printf("FAIL: %s - body %d should be visible\n", label, id)
+            failed += 1
+        }
+    }
+    if failed == 0 {
+        fmt.printf("PASS: %s - hidden %v, visible %v\n", label, hidden, visible)
+    }
+    return failed
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+// One frame of the scene; culled = the two-phase path of main_gpu, otherwise every body.
+// Waits for the GPU and returns RGBA8 pixels.
+render :: proc(gpu: ^viewer.ViewerGPU, scene: ^Scene, view: viewer.PreviewView, culled: bool) -> []u8 {
+    cmd := sdl.AcquireGPUCommandBuffer(gpu.gpu_device)
+    if cmd == nil {
+        fmt.eprintln("ERROR: Failed to acquire command buffer:", sdl.GetError())
+        return make([]u8, SIZE * SIZE * 4)
+    }
+
+    viewer.gpu_mesh_cache_begin_frame(&gpu.mesh_cache)
+
+    // Perspective, unlike the orthographic previews: with an orthographic near plane this far
+    // away most of the scene would land on clamped (zero) depth, which can never occlude
+    camera := viewer.preview_camera(view, scene.bbox_min, scene.bbox_max, 1)
+    camera.projection_mode = .Perspective
+    camera.fov = 45
+    mvp := viewer.camera_get_projection_matrix(&camera) * viewer.camera_get_view_matrix(&camera)
+
+    viewport := sdl.GPUViewport{w = SIZE, h = SIZE, min_depth = 0, max_depth = 1}
+    color_target := sdl.GPUColorTargetInfo{
+        texture = scene.color,
+        load_op = .CLEAR,
+        store_op = .STORE,
+        clear_color = {0.08, 0.08, 0.08, 1.0},
+    }
+    depth_target := sdl.GPUDepthStencilTargetInfo{
+        texture = scene.depth,
+        load_op = .CLEAR,
+        store_op = .STORE,
+        clear_depth = 1.0,
+        cycle = true,
+    }
+
+    occluded := culled && viewer.occlusion_begin_frame(gpu, cmd, scene.items[:])
+    if occluded {
+        pass := sdl.BeginGPURenderPass(cmd, &color_target, 1, &depth_target)
+        sdl.SetGPUViewport(pass, viewport)
+        viewer.occlusion_draw(gpu, scene.items[:], .Previous, mvp)
+        viewer.render_queue_flush(gpu, cmd, pass)
+        sdl.EndGPURenderPass(pass)
+
+        if !viewer.occlusion_cull(gpu, cmd, scene.depth, SIZE, SIZE, mvp) {
+            fmt.eprintln("ERROR: occlusion_cull failed")
+        }
+
+        color_target.load_op = .LOAD
+        depth_target.load_op = .LOAD
+        depth_target.cycle = false
+    }
+
+    pass := sdl.BeginGPURenderPass(cmd, &color_target, 1, &depth_target)
+    sdl.SetGPUViewport(pass, viewport)
+    if occluded {
+        viewer.occlusion_draw(gpu, scene.items[:], .Revealed, mvp)
+        viewer.render_queue_flush(gpu, cmd, pass)
+    } else {
+        for item in scene.items {
+            viewer.viewer_gpu_render_cached_mesh_instanced(
+                gpu, cmd, pass, item.key, item.solid, item.color, mvp * item.transform, item.normal_matrix,
+            )
+        }
+    }
+    sdl.EndGPURenderPass(pass)
+
+    copy_pass := sdl.BeginGPUCopyPass(cmd)
+    sdl.DownloadFromGPUTexture(
+        copy_pass,
+        sdl.GPUTextureRegion{texture = scene.color, w = SIZE, h = SIZE, d = 1},
+        sdl.GPUTextureTransferInfo{transfer_buffer = scene.readback},
+    )
+    sdl.EndGPUCopyPass(copy_pass)
+
+    fence := sdl.SubmitGPUCommandBufferAndAcquireFence(cmd)
+    if occluded {
+        viewer.occlusion_end_frame(gpu)
+        viewer.occlusion_collect(gpu, true)
+    }
+
+    pixels := make([]u8, SIZE * SIZE * 4)
+    if fence != nil {
+        _ = sdl.WaitForGPUFences(gpu.gpu_device, true, &fence, 1)
+        sdl.ReleaseGPUFence(gpu.gpu_device, fence)
+
+        if mapped := sdl.MapGPUTransferBuffer(gpu.gpu_device, scene.readback, false); mapped != nil {
+            copy(pixels, ([^]u8)(mapped)[:len(pixels)])
+            sdl.UnmapGPUTransferBuffer(gpu.gpu_device, scene.readback)
+        }
+    }
+    return pixels
+}
+
+// =============================================================================
+// Scene
+// =============================================================================
+
+scene_init :: proc(gpu: ^viewer.ViewerGPU, scene: ^Scene) -> bool {
+    boxes := [6][2]m.Vec3{
+        WALL = {{-8, -8, -0.5}, {8, 8, 0}},
+        1 = {{-2, -2, -4}, {-1, -1, -3}},
+        2 = {{1, -0.5, -4}, {2, 0.5, -3}},
+        3 = {{-0.5, 1, -5}, {0.5, 2, -4}},
+        4 = {{2, 2, 1}, {3, 3, 2}},
+        BESIDE = {{11, -1, -4}, {13, 1, -2}},
+    }
+
+    scene.bbox_min, scene.bbox_max = boxes[0][0], boxes[0][1]
+    for box, id in boxes {
+        solid := box_solid(box[0], box[1])
+        append(&scene.solids, solid)
+        append(&scene.items, viewer.OcclusionItem{
+            owner_id = id,
+            key = viewer.GPUMeshKey{owner_id = id},
+            solid = solid,
+            transform = 1,
+            normal_matrix = 1,
+            color = {0.45, 0.45, 0.45, 1.0},
+        })
+        scene.bbox_min = {min(scene.bbox_min.x, box[0].x), min(scene.bbox_min.y, box[0].y), min(scene.bbox_min.z, box[0].z)}
+        scene.bbox_max = {max(scene.bbox_max.x, box[1].x), max(scene.bbox_max.y, box[1].y), max(scene.bbox_max.z, box[1].z)}
+    }
+
+    scene.color = sdl.CreateGPUTexture(gpu.gpu_device, sdl.GPUTextureCreateInfo{
+        type = .D2,
+        format = gpu.color_format,
+        usage = {.COLOR_TARGET},
+        width = SIZE,
+        height = SIZE,
+        layer_count_or_depth = 1,
+        num_levels = 1,
+    })
+    scene.depth = sdl.CreateGPUTexture(gpu.gpu_device, sdl.GPUTextureCreateInfo{
+        type = .D2,
+        format = gpu.depth_format,
+        usage = viewer.occlusion_depth_usage(gpu),
+        width = SIZE,
+        height = SIZE,
+        layer_count_or_depth = 1,
+        num_levels = 1,
+    })
+    scene.readback = sdl.CreateGPUTransferBuffer(gpu.gpu_device, sdl.GPUTransferBufferCreateInfo{
+        usage = .DOWNLOAD,
+        size = SIZE * SIZE * 4,
+    })
+
+    if scene.color == nil || scene.depth == nil || scene.readback == nil {
+        fmt.eprintln("FAIL: could not create render targets:", sdl.GetError())
+        return false
+    }
+    return true
+}
+
+scene_destroy :: proc(gpu: ^viewer.ViewerGPU, scene: ^Scene) {
+    if scene.readback != nil do sdl.ReleaseGPUTransferBuffer(gpu.gpu_device, scene.readback)
+    if scene.depth != nil do sdl.ReleaseGPUTexture(gpu.gpu_device, scene.depth)
+    if scene.color != nil do sdl.ReleaseGPUTexture(gpu.gpu_device, scene.color)
+
+    for solid in scene.solids {
+        delete(solid.triangles)
+        free(solid)
+    }
+    delete(scene.solids)
+    delete(scene.items)
+}
+
+// Axis-aligned box as a shaded triangle mesh (outward-facing, counter-clockwise)
+box_solid :: proc(lo, hi: m.Vec3) -> ^extrude.SimpleSolid {
+    solid := new(extrude.SimpleSolid)
+
+    quads := [6]struct{corners: [4]m.Vec3, normal: m.Vec3}{
+        {{{lo.x, lo.y, lo.z}, {lo.x, hi.y, lo.z}, {hi.x, hi.y, lo.z}, {hi.x, lo.y, lo.z}}, {0, 0, -1}},
+        {{{lo.x, lo.y, hi.z}, {hi.x, lo.y, hi.z}, {hi.x, hi.y, hi.z}, {lo.x, hi.y, hi.z}}, {0, 0, 1}},
+        {{{lo.x, lo.y, lo.z}, {lo.x, lo.y, hi.z}, {lo.x, hi.y, hi.z}, {lo.x, hi.y, lo.z}}, {-1, 0, 0}},
+        {{{hi.x, lo.y, lo.z}, {hi.x, hi.y, lo.z}, {hi.x, hi.y, hi.z}, {hi.x, lo.y, hi.z}}, {1, 0, 0}},
+        {{{lo.x, lo.y, lo.z}, {hi.x, lo.y, lo.z}, {hi.x, lo.y, hi.z}, {lo.x, lo.y, hi.z}}, {0, -1, 0}},
+        {{{lo.x, hi.y, lo.z}, {lo.x, hi.y, hi.z}, {hi.x, hi.y, hi.z}, {hi.x, hi.y, lo.z}}, {0, 1, 0}},
+    }
+
+    for quad, face in quads {
+        c := quad.corners
+        append(&solid.triangles,
+            extrude.Triangle3D{v0 = c[0], v1 = c[1], v2 = c[2], normal = quad.normal, face_id = face},
+            extrude.Triangle3D{v0 = c[0], v1 = c[2], v2 = c[3], normal = quad.normal, face_id = face},
+        )
+    }
+    return solid
+}
@@ -0,0 +1,200 @@
+// Post-boolean topology cleanup benchmark
+// Builds the same part with 100 sequential cuts twice - raw booleans vs. booleans
+// followed by ShapeUpgrade_UnifySameDomain + ShapeFix_Shape - and compares face/edge
+// growth, per-cut boolean time and final tessellation time.
+//
+// Run from project root:
+//   make bench-boolean-cleanup
+//
+package boolean_cleanup_bench
+
+import "core:fmt"
+import "core:time"
+import occt "../../src/core/geometry/occt"
+
+// Part layout (millimeters)
+PLATE_X :: 200.0
+PLATE_Y :: 200.0
+PLATE_Z :: 30.0
+
+POCKET_COLS :: 10
+POCKET_ROWS :: 8
+POCKET_SIZE :: 20.0      // Each pocket tool is 20x20
+POCKET_PITCH :: 18.0     // Tools overlap by 2mm so floors/walls are coplanar
+POCKET_FLOOR_Z :: 20.0
+
+BORE_SEGMENTS :: 20      // One bore cut in 20 co-axial segments (co-cylindrical faces)
+BORE_RADIUS :: 4.0
+BORE_Y :: 185.0
+BORE_Z :: 10.0
+
+TOTAL_CUTS :: POCKET_COLS * POCKET_ROWS + BORE_SEGMENTS
+
+// Metrics for one build of the part
+RunStats :: struct {
+    label: string,
+    ok: bool,
+    cut_times: [TOTAL_CUTS]time.Duration,  // Boolean (+ cleanup) time per cut
+    total_time: time.Duration,
+    tessellate_time: time.Duration,
+    final_faces: int,
+    final_edges: int,
+    triangles: int,
+    valid: bool,
+}
+
+// Build the i-th cutting tool
+make_tool :: proc(i: int) -> occt.Shape {
+    if i < POCKET_COLS * POCKET_ROWS {
+        row := i / POCKET_COLS
+        col := i % POCKET_COLS
+        x0 := 10.0 + f64(col) * POCKET_PITCH
+        y0 := 10.0 + f64(row) * POCKET_PITCH
+        return occt.OCCT_Primitive_Box_TwoCorners(
+            x0, y0, POCKET_FLOOR_Z,
+            x0 + POCKET_SIZE, y0 + POCKET_SIZE, PLATE_Z + 1.0,
+        )
+    }
+
+    // Bore along +X, split into equal segments that share the same cylinder
+    seg := i - POCKET_COLS * POCKET_ROWS
+    seg_len := PLATE_X / f64(BORE_SEGMENTS)
+    x0 := f64(seg) * seg_len
+    if seg == 0 do x0 -= 1.0  // Poke through the first wall
+
+    length := seg_len
+    if seg == 0 || seg == BORE_SEGMENTS - 1 do length += 1.0
+
+    base := occt.OCCT_Pnt_Create(x0, BORE_Y, BORE_Z)
+    defer occt.OCCT_Pnt_Delete(base)
+    axis := occt.OCCT_Dir_Create(1, 0, 0)
+    defer occt.OCCT_Dir_Delete(axis)
+
+    return occt.OCCT_Primitive_Cylinder_Axis(base, axis, BORE_RADIUS, length)
+}
+
+// Build the part with TOTAL_CUTS sequential booleans
+run_build :: proc(label: string, simplify: bool) -> RunStats {
+    stats := RunStats{label = label}
+
+    shape := occt.OCCT_Primitive_Box(PLATE_X, PLATE_Y, PLATE_Z)
+    if shape == nil {
+        fmt.printf("❌ %s: failed to create base plate\n", label)
+        return stats
+    }
+    defer occt.delete_shape(shape)
+
+    total_start := time.tick_now()
+
+    for i in 0..<TOTAL_CUTS {
+        tool := make_tool(i)
+        if tool == nil {
+            fmt.printf("❌ %s: failed to create tool %d\n", label, i)
+            return stats
+        }
+
+        cut_start := time.tick_now()
+        result := occt.OCCT_Boolean_Difference(shape, tool)
+        occt.delete_shape(tool)
+
+        if result == nil {
+            fmt.printf("❌ %s: boolean %d failed\n", label, i)
+            return stats
+        }
+
+        if simplify {
+            simplified, _ := occt.simplify_shape(result, occt.DEFAULT_SIMPLIFY)
+            if simplified != nil {
+                occt.delete_shape(result)
+                result = simplified
+            }
+        }
+        stats.cut_times[i] = time.tick_since(cut_start)
+
+        occt.delete_shape(shape)
+        shape = result
+    }
+
+    stats.total_time = time.tick_since(total_start)
+    stats.final_faces = occt.count_faces(shape)
+    stats.final_edges = occt.count_edges(shape)
+    stats.valid = occt.is_valid(shape)
+
+    tess_start := time.tick_now()
+    mesh := occt.OCCT_Tessellate(shape, occt.DEFAULT_TESSELLATION)
+    stats.tessellate_time = time.tick_since(tess_start)
+    if mesh != nil {
+        stats.triangles = int(mesh.num_triangles)
+        occt.delete_mesh(mesh)
+    }
+
+    stats.ok = true
+    return stats
+}
+
+// Mean duration in milliseconds
+mean_ms :: proc(times: []time.Duration) -> f64 {
+    if len(times) == 0 do return 0
+    sum: f64
+    for d in times {
+        sum += time.duration_milliseconds(d)
+    }
+    return sum / f64(len(times))
+}
+
+print_stats :: proc(s: ^RunStats) {
+    fmt.printf("  %-10s  faces %5d  edges %5d  tris %7d  valid %-5v  total %8.1f ms  first10 %6.2f ms/cut  last10 %6.2f ms/cut  tessellate %7.2f ms\n",
+        s.label, s.final_faces, s.final_edges, s.triangles, s.valid,
+        time.duration_milliseconds(s.total_time),
+        mean_ms(s.cut_times[:10]),
+        mean_ms(s.cut_times[TOTAL_CUTS - 10:]),
+        time.duration_milliseconds(s.tessellate_time))
+}
+
+main :: proc() {
+    occt.initialize()
+    defer occt.cleanup()
+
+    fmt.println("=== Post-Boolean Topology Cleanup Benchmark ===")
+    fmt.printf("OCCT %s, %d sequential cuts (%d overlapping pockets + %d bore segments)\n\n",
+        occt.version(), TOTAL_CUTS, POCKET_COLS * POCKET_ROWS, BORE_SEGMENTS)
+
+    raw := run_build("raw", false)
+    clean := run_build("cleanup", true)
+
+    fmt.println("Results:")
+    print_stats(&raw)
+    print_stats(&clean)
+    fmt.println()
+
+    passed := 0
+    failed := 0
+
+    check :: proc(name: string, cond: bool, passed, failed: ^int) {
+        if cond {
+            fmt.printf("✅ PASS: %s\n", name)
+            passed^ += 1
+        } else {
+            fmt.printf("❌ FAIL: %s\n", name)
+            failed^ += 1
+        }
+    }
+
+    check("both builds complete", raw.ok && clean.ok, &passed, &failed)
+    check("cleanup result is a valid solid", clean.valid, &passed, &failed)
+    check("cleanup reduces face count", clean.final_faces < raw.final_faces, &passed, &failed)
+    check("cleanup reduces edge count", clean.final_edges < raw.final_edges, &passed, &failed)
+
+    if raw.ok && clean.ok && raw.final_faces > 0 {
+        fmt.printf("\nFace count: %d → %d (%.1f%% fewer), edges: %d → %d (%.1f%% fewer)\n",
+            raw.final_faces, clean.final_faces,
+            100.0 * f64(raw.final_faces - clean.final_faces) / f64(raw.final_faces),
+            raw.final_edges, clean.final_edges,
+            100.0 * f64(raw.final_edges - clean.final_edges) / f64(max(raw.final_edges, 1)))
+        fmt.printf("Total build: %.1f ms → %.1f ms, tessellation: %.2f ms → %.2f ms\n",
+            time.duration_milliseconds(raw.total_time), time.duration_milliseconds(clean.total_time),
+            time.duration_milliseconds(raw.tessellate_time), time.duration_milliseconds(clean.tessellate_time))
+    }
+
+    fmt.printf("\n=== %d passed, %d failed ===\n", passed, failed)
+}
@@ -0,0 +1,142 @@
+// Polygon wire construction benchmark
+// Times OCCT_Wire_FromPoints2D (shared vertices + BRep_Builder, one linear pass)
+// against the per-edge BRepBuilderAPI_MakeWire path it replaced, on circular
+// profiles of 100 to 100k points, and checks both produce the same topology.
+//
+// Run from project root:
+//   make bench-wire-build
+//
+package wire_build_bench
+
+import "core:fmt"
+import "core:math"
+import "core:time"
+import occt "../../src/core/geometry/occt"
+
+POINT_COUNTS :: [?]int{100, 1_000, 10_000, 100_000}
+PER_EDGE_MAX_POINTS :: 10_000  // The per-edge path is quadratic; 100k takes minutes
+REPEATS :: 3
+RADIUS :: 50.0
+
+WireBuilder :: enum {
+    Bulk,
+    PerEdge,
+}
+
+RunStats :: struct {
+    ok: bool,
+    best: time.Duration,
+    edges: int,
+}
+
+// Closed circle as [x, y] pairs, first point repeated at the end like a sketch loop
+make_circle :: proc(count: int) -> []f64 {
+    points := make([]f64, (count + 1) * 2)
+    for i in 0..=count {
+        angle := 2.0 * math.PI * f64(i % count) / f64(count)
+        points[i*2 + 0] = RADIUS * math.cos(angle)
+        points[i*2 + 1] = RADIUS * math.sin(angle)
+    }
+    return points
+}
+
+build_wire :: proc(builder: WireBuilder, points: []f64) -> occt.Wire {
+    count := i32(len(points) / 2)
+    switch builder {
+    case .Bulk:    return occt.OCCT_Wire_FromPoints2D(raw_data(points), count, true)
+    case .PerEdge: return occt.OCCT_Wire_FromPoints2D_PerEdge(raw_data(points), count, true)
+    }
+    return nil
+}
+
+// Best of REPEATS builds; topology is taken from the last one
+run_build :: proc(builder: WireBuilder, points: []f64) -> RunStats {
+    stats := RunStats{ok = true}
+
+    for r in 0..<REPEATS {
+        start := time.tick_now()
+        wire := build_wire(builder, points)
+        elapsed := time.tick_since(start)
+
+        if wire == nil {
+            stats.ok = false
+            return stats
+        }
+        if r == 0 || elapsed < stats.best do stats.best = elapsed
+        if r == REPEATS - 1 do stats.edges = occt.count_edges(occt.Shape(wire))
+
+        occt.OCCT_Wire_Delete(wire)
+    }
+
+    return stats
+}
+
+// The bulk wire must still close into a face that extrudes to a valid solid
+extrudes_cleanly :: proc(points: []f64) -> bool {
+    wire := build_wire(.Bulk, points)
+    if wire == nil do return false
+    defer occt.OCCT_Wire_Delete(wire)
+
+    solid := occt.OCCT_Extrude_Wire(wire, 0, 0, 10)
+    if solid == nil do return false
+    defer occt.delete_shape(solid)
+
+    return occt.is_valid(solid)
+}
+
+main :: proc() {
+    occt.initialize()
+    defer occt.cleanup()
+
+    fmt.println("=== Polygon Wire Build Benchmark ===")
+    fmt.printf("OCCT %s, closed circles, best of %d builds\n\n", occt.version(), REPEATS)
+    fmt.printf("  %8s  %12s  %12s  %8s  %7s\n", "points", "bulk ms", "per-edge ms", "speedup", "edges")
+
+    passed := 0
+    failed := 0
+
+    check :: proc(name: string, cond: bool, passed, failed: ^int) {
+        if cond {
+            fmt.printf("✅ PASS: %s\n", name)
+            passed^ += 1
+        } else {
+            fmt.printf("❌ FAIL: %s\n", name)
+            failed^ += 1
+        }
+    }
+
+    all_ok := true
+    edges_match := true
+    counts := POINT_COUNTS
+    for count in counts {
+        points := make_circle(count)
+        defer delete(points)
+
+        bulk := run_build(.Bulk, points)
+        all_ok = all_ok && bulk.ok && bulk.edges == count
+
+        if count <= PER_EDGE_MAX_POINTS {
+            per_edge := run_build(.PerEdge, points)
+            all_ok = all_ok && per_edge.ok
+            edges_match = edges_match && per_edge.edges == bulk.edges
+
+            bulk_ms := time.duration_milliseconds(bulk.best)
+            per_edge_ms := time.duration_milliseconds(per_edge.best)
+            fmt.printf("  %8d  %12.3f  %12.3f  %7.1fx  %7d\n",
+                count, bulk_ms, per_edge_ms, per_edge_ms / max(bulk_ms, 1e-6), bulk.edges)
+        } else {
+            fmt.printf("  %8d  %12.3f  %12s  %8s  %7d\n",
+                count, time.duration_milliseconds(bulk.best), "skipped", "-", bulk.edges)
+        }
+    }
+    fmt.println()
+
+    small := make_circle(1_000)
+    defer delete(small)
+
+    check("every wire builds with one edge per point", all_ok, &passed, &failed)
+    check("bulk and per-edge wires have the same edge count", edges_match, &passed, &failed)
+    check("bulk wire extrudes to a valid solid", extrudes_cleanly(small), &passed, &failed)
+
+    fmt.printf("\n=== %d passed, %d failed ===\n", passed, failed)
+}
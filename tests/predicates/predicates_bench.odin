@@ -0,0 +1,402 @@
+// tests/predicates - Robust predicate throughput benchmark
+//
+// Compares the plain f64 code the viewer/cut paths used before (naive), the filtered
+// scalar predicates and the 4-wide batch predicates on two workloads:
+//   - random: well-conditioned inputs, nearly every call is decided by the f64 filter
+//   - degenerate: points within a few ulps of collinear/coplanar/cocircular, where the
+//     naive code returns wrong signs and the exact fallback runs
+// and counts how often the naive sign disagrees with the exact one.
+//
+// Usage: odin run tests/predicates -o:speed -- [count]
+package predicates_bench
+
+import "core:fmt"
+import "core:math"
+import "core:math/rand"
+import "core:os"
+import "core:strconv"
+import "core:time"
+import m "../../src/core/math"
+
+DEFAULT_COUNT :: 1_000_000
+REPEATS :: 3
+RAY_GRID :: 32      // Cells per side of the ray-triangle test mesh
+
+main :: proc() {
+    count := DEFAULT_COUNT
+    if len(os.args) > 1 {
+        if value, ok := strconv.parse_int(os.args[1]); ok && value > 0 do count = value
+    }
+
+    fmt.println("=== Robust Predicate Benchmark ===")
+    fmt.printf("%d queries per workload, best of %d\n\n", count, REPEATS)
+
+    bench_orient2d(count, false)
+    bench_orient2d(count, true)
+    bench_orient3d(count, false)
+    bench_orient3d(count, true)
+    bench_incircle(count, false)
+    bench_incircle(count, true)
+    bench_ray_triangle(count)
+    bench_point_in_polygon(count)
+
+    fmt.println("\n=== Benchmark Complete ===")
+}
+
+// =============================================================================
+// Naive reference implementations (plain f64, as in the code being replaced)
+// =============================================================================
+
+naive_orient2d :: proc(a, b, c: m.Vec2) -> f64 {
+    return (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x)
+}
+
+naive_orient3d :: proc(a, b, c, d: m.Vec3) -> f64 {
+    ad, bd, cd := a - d, b - d, c - d
+    return ad.z * (bd.x * cd.y - cd.x * bd.y) +
+           bd.z * (cd.x * ad.y - ad.x * cd.y) +
+           cd.z * (ad.x * bd.y - bd.x * ad.y)
+}
+
+naive_incircle :: proc(a, b, c, d: m.Vec2) -> f64 {
+    ad, bd, cd := a - d, b - d, c - d
+    alift := ad.x * ad.x + ad.y * ad.y
+    blift := bd.x * bd.x + bd.y * bd.y
+    clift := cd.x * cd.x + cd.y * cd.y
+    return alift * (bd.x * cd.y - cd.x * bd.y) +
+           blift * (cd.x * ad.y - ad.x * cd.y) +
+           clift * (ad.x * bd.y - bd.x * ad.y)
+}
+
+// Möller-Trumbore (solid picker BVH leaves before the predicate library)
+naive_ray_triangle :: proc(origin, dir, v0, v1, v2: m.Vec3) -> bool {
+    e1 := v1 - v0
+    e2 := v2 - v0
+    p := m.Vec3{dir.y * e2.z - dir.z * e2.y, dir.z * e2.x - dir.x * e2.z, dir.x * e2.y - dir.y * e2.x}
+    det := e1.x * p.x + e1.y * p.y + e1.z * p.z
+    if abs(det) < 1e-14 do return false
+
+    inv := 1.0 / det
+    s := origin - v0
+    u := (s.x * p.x + s.y * p.y + s.z * p.z) * inv
+    if u < 0 || u > 1 do return false
+
+    q := m.Vec3{s.y * e1.z - s.z * e1.y, s.z * e1.x - s.x * e1.z, s.x * e1.y - s.y * e1.x}
+    w := (dir.x * q.x + dir.y * q.y + dir.z * q.z) * inv
+    if w < 0 || u + w > 1 do return false
+
+    return (e2.x * q.x + e2.y * q.y + e2.z * q.z) * inv > 0
+}
+
+// Ray casting with an interpolated crossing (cut.odin / main_gpu.odin before)
+naive_point_in_polygon :: proc(point: m.Vec2, polygon: []m.Vec2) -> bool {
+    inside := false
+    n := len(polygon)
+    for i in 0..<n {
+        p1 := polygon[i]
+        p2 := polygon[(i + 1) % n]
+        if ((p1.y > point.y) != (p2.y > point.y)) &&
+           (point.x < (p2.x - p1.x) * (point.y - p1.y) / (p2.y - p1.y) + p1.x) {
+            inside = !inside
+        }
+    }
+    return inside
+}
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+Timing :: struct {
+    naive, scalar, batch: time.Duration,
+}
+
+best :: proc(d: ^time.Duration, sample: time.Duration) {
+    if d^ == 0 || sample < d^ do d^ = sample
+}
+
+sign :: proc(x: f64) -> int {
+    return x > 0 ? 1 : (x < 0 ? -1 : 0)
+}
+
+print_row :: proc(name: string, count: int, timing: Timing, wrong: int) {
+    rate :: proc(count: int, d: time.Duration) -> f64 {
+        s := time.duration_seconds(d)
+        return s > 0 ? f64(count) / s / 1e6 : 0
+    }
+    fmt.printf("  %-24s naive %7.1f M/s   scalar %7.1f M/s   batch %7.1f M/s   naive wrong signs %d\n",
+        name, rate(count, timing.naive), rate(count, timing.scalar), rate(count, timing.batch), wrong)
+}
+
+// Random point on the line through a and b, nudged by up to `ulps` ulps in y
+near_line_point :: proc(a, b: m.Vec2, ulps: int) -> m.Vec2 {
+    t := rand.float64()
+    p := a + (b - a) * t
+    k := rand.int_max(2 * ulps + 1) - ulps
+    toward := k > 0 ? math.INF_F64 : math.NEG_INF_F64
+    for _ in 0..<abs(k) {
+        p.y = math.nextafter_f64(p.y, toward)
+    }
+    return p
+}
+
+random_vec2 :: proc() -> m.Vec2 {
+    return m.Vec2{rand.float64_range(-100, 100), rand.float64_range(-100, 100)}
+}
+
+random_vec3 :: proc() -> m.Vec3 {
+    return m.Vec3{rand.float64_range(-100, 100), rand.float64_range(-100, 100), rand.float64_range(-100, 100)}
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+
+bench_orient2d :: proc(count: int, degenerate: bool) {
+    a := m.Vec2{0.5, 0.5}
+    b := m.Vec2{12.1, 12.1}
+
+    points := make([]m.Vec2, count)
+    defer delete(points)
+    for &p in points {
+        p = degenerate ? near_line_point(a, b, 2) : random_vec2()
+    }
+
+    out := make([]f64, count)
+    defer delete(out)
+
+    timing: Timing
+    for _ in 0..<REPEATS {
+        start := time.tick_now()
+        for p, i in points do out[i] = naive_orient2d(a, b, p)
+        best(&timing.naive, time.tick_since(start))
+
+        start = time.tick_now()
+        for p, i in points do out[i] = m.orient2d(a, b, p)
+        best(&timing.scalar, time.tick_since(start))
+
+        start = time.tick_now()
+        m.orient2d_batch(a, b, points, out)
+        best(&timing.batch, time.tick_since(start))
+    }
+
+    wrong := 0
+    for p, i in points {
+        if sign(naive_orient2d(a, b, p)) != sign(out[i]) do wrong += 1
+    }
+
+    print_row(degenerate ? "orient2d (degenerate)" : "orient2d (random)", count, timing, wrong)
+}
+
+bench_orient3d :: proc(count: int, degenerate: bool) {
+    a := m.Vec3{0.1, 0.2, 0.3}
+    b := m.Vec3{17.3, 0.7, 1.1}
+    c := m.Vec3{0.9, 23.1, 2.3}
+
+    points := make([]m.Vec3, count)
+    defer delete(points)
+    for &p in points {
+        if degenerate {
+            // Rounded points on the plane abc
+            u, v := rand.float64(), rand.float64()
+            p = a + (b - a) * u + (c - a) * v
+        } else {
+            p = random_vec3()
+        }
+    }
+
+    out := make([]f64, count)
+    defer delete(out)
+
+    timing: Timing
+    for _ in 0..<REPEATS {
+        start := time.tick_now()
+        for p, i in points do out[i] = naive_orient3d(a, b, c, p)
+        best(&timing.naive, time.tick_since(start))
+
+        start = time.tick_now()
+        for p, i in points do out[i] = m.orient3d(a, b, c, p)
+        best(&timing.scalar, time.tick_since(start))
+
+        start = time.tick_now()
+        m.orient3d_batch(a, b, c, points, out)
+        best(&timing.batch, time.tick_since(start))
+    }
+
+    wrong := 0
+    for p, i in points {
+        if sign(naive_orient3d(a, b, c, p)) != sign(out[i]) do wrong += 1
+    }
+
+    print_row(degenerate ? "orient3d (degenerate)" : "orient3d (random)", count, timing, wrong)
+}
+
+bench_incircle :: proc(count: int, degenerate: bool) {
+    a := m.Vec2{10, 0}
+    b := m.Vec2{0, 10}
+    c := m.Vec2{-10, 0}
+
+    points := make([]m.Vec2, count)
+    defer delete(points)
+    for &p in points {
+        if degenerate {
+            // Rounded points on the circle through a, b, c
+            angle := rand.float64() * 2 * math.PI
+            p = m.Vec2{10 * math.cos(angle), 10 * math.sin(angle)}
+        } else {
+            p = random_vec2()
+        }
+    }
+
+    out := make([]f64, count)
+    defer delete(out)
+
+    timing: Timing
+    for _ in 0..<REPEATS {
+        start := time.tick_now()
+        for p, i in points do out[i] = naive_incircle(a, b, c, p)
+        best(&timing.naive, time.tick_since(start))
+
+        start = time.tick_now()
+        for p, i in points do out[i] = m.incircle(a, b, c, p)
+        best(&timing.scalar, time.tick_since(start))
+
+        start = time.tick_now()
+        m.incircle_batch(a, b, c, points, out)
+        best(&timing.batch, time.tick_since(start))
+    }
+
+    wrong := 0
+    for p, i in points {
+        if sign(naive_incircle(a, b, c, p)) != sign(out[i]) do wrong += 1
+    }
+
+    print_row(degenerate ? "incircle (degenerate)" : "incircle (random)", count, timing, wrong)
+}
+
+// Rays straight down through a tessellated grid, aimed at the shared edges
+bench_ray_triangle :: proc(count: int) {
+    tris := make([dynamic]m.TrianglePoints, 0, 2 * RAY_GRID * RAY_GRID)
+    defer delete(tris)
+    for y in 0..<RAY_GRID {
+        for x in 0..<RAY_GRID {
+            p00 := m.Vec3{f64(x) * 0.1, f64(y) * 0.1, 0}
+            p10 := m.Vec3{f64(x + 1) * 0.1, f64(y) * 0.1, 0}
+            p11 := m.Vec3{f64(x + 1) * 0.1, f64(y + 1) * 0.1, 0}
+            p01 := m.Vec3{f64(x) * 0.1, f64(y + 1) * 0.1, 0}
+            append(&tris, m.TrianglePoints{p00, p10, p11}, m.TrianglePoints{p00, p11, p01})
+        }
+    }
+
+    // Each ray tests one 4-triangle leaf (same shape as a picker BVH leaf)
+    origins := make([]m.Vec3, count)
+    defer delete(origins)
+    for &o in origins {
+        d := rand.float64() * f64(RAY_GRID) * 0.1
+        o = m.Vec3{d, d, 1}  // On the cell diagonals
+    }
+    dir := m.Vec3{0, 0, -1}
+
+    // The diagonal cell under o plus its neighbour
+    leaf_of :: proc(o: m.Vec3, tris: []m.TrianglePoints) -> []m.TrianglePoints {
+        k := clamp(int(o.x / 0.1), 0, RAY_GRID - 1)
+        first := min((k * RAY_GRID + k) * 2, len(tris) - 4)
+        return tris[first:first + 4]
+    }
+
+    timing: Timing
+    naive_misses, robust_misses, batch_misses: int
+    for _ in 0..<REPEATS {
+        naive_misses = 0
+        start := time.tick_now()
+        for o in origins {
+            leaf := leaf_of(o, tris[:])
+            hit := false
+            for tri in leaf {
+                if naive_ray_triangle(o, dir, tri[0], tri[1], tri[2]) {
+                    hit = true
+                    break
+                }
+            }
+            if !hit do naive_misses += 1
+        }
+        best(&timing.naive, time.tick_since(start))
+
+        robust_misses = 0
+        start = time.tick_now()
+        for o in origins {
+            leaf := leaf_of(o, tris[:])
+            hit := false
+            for tri in leaf {
+                if _, ok := m.ray_triangle(o, dir, tri[0], tri[1], tri[2]); ok {
+                    hit = true
+                    break
+                }
+            }
+            if !hit do robust_misses += 1
+        }
+        best(&timing.scalar, time.tick_since(start))
+
+        batch_misses = 0
+        start = time.tick_now()
+        for o in origins {
+            if !m.ray_triangles_any_hit(o, dir, leaf_of(o, tris[:]), math.INF_F64) do batch_misses += 1
+        }
+        best(&timing.batch, time.tick_since(start))
+    }
+
+    print_row("ray-triangle (4/leaf)", count, timing, naive_misses - robust_misses)
+    if robust_misses != 0 || batch_misses != 0 {
+        fmt.printf("  ❌ robust ray-triangle fell through %d (scalar) / %d (batch) shared edges\n",
+            robust_misses, batch_misses)
+    }
+}
+
+bench_point_in_polygon :: proc(count: int) {
+    // 64-gon; half the points sit exactly on its horizontal/vertex rows
+    N :: 64
+    polygon := make([]m.Vec2, N)
+    defer delete(polygon)
+    for i in 0..<N {
+        angle := f64(i) * 2 * math.PI / N
+        r := i % 2 == 0 ? 10.0 : 7.0
+        polygon[i] = m.Vec2{r * math.cos(angle), r * math.sin(angle)}
+    }
+
+    points := make([]m.Vec2, count)
+    defer delete(points)
+    for &p, i in points {
+        p = m.Vec2{rand.float64_range(-11, 11), rand.float64_range(-11, 11)}
+        if i % 2 == 0 do p.y = polygon[rand.int_max(N)].y
+    }
+
+    sides := make([]m.PolygonSide, count)
+    defer delete(sides)
+
+    timing: Timing
+    inside_naive := 0
+    for _ in 0..<REPEATS {
+        inside_naive = 0
+        start := time.tick_now()
+        for p in points {
+            if naive_point_in_polygon(p, polygon) do inside_naive += 1
+        }
+        best(&timing.naive, time.tick_since(start))
+
+        start = time.tick_now()
+        for p, i in points do sides[i] = m.classify_point_polygon_2d(p, polygon)
+        best(&timing.scalar, time.tick_since(start))
+
+        start = time.tick_now()
+        m.classify_points_polygon_2d_batch(points, polygon, sides)
+        best(&timing.batch, time.tick_since(start))
+    }
+
+    wrong := 0
+    for p, i in points {
+        if sides[i] == .Boundary do continue
+        if naive_point_in_polygon(p, polygon) != (sides[i] == .Inside) do wrong += 1
+    }
+
+    print_row("point-in-polygon (64)", count, timing, wrong)
+}
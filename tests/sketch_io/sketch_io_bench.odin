@@ -0,0 +1,439 @@
+// tests/sketch_io - Sketch serialization round-trip tests and throughput benchmark
+//
+// Builds large sketches (default 100k entities) covering every constraint type,
+// round-trips them through:
+//   - legacy JSON   (sketch_to_json + json.marshal / json.unmarshal + sketch_from_json)
+//   - streaming JSON (sketch_write_text / sketch_read_text)
+//   - binary        (sketch_write_binary / sketch_read_binary)
+// verifies the decoded sketch is identical to the original, and reports
+// encode/decode throughput.
+//
+// Usage: odin run tests/sketch_io -o:speed -- [entity_count]
+package sketch_io_bench
+
+import "core:fmt"
+import "core:os"
+import "core:strconv"
+import "core:time"
+import "core:encoding/json"
+import sketch "../../src/features/sketch"
+
+DEFAULT_ENTITY_COUNT :: 100_000
+REPEATS :: 3
+
+main :: proc() {
+    fmt.println("=== Sketch Serialization Tests ===\n")
+
+    entity_count := DEFAULT_ENTITY_COUNT
+    if len(os.args) > 1 {
+        if value, ok := strconv.parse_int(os.args[1]); ok && value > 0 do entity_count = value
+    }
+
+    test_all_constraint_types()
+    test_corrupt_input()
+    benchmark_round_trip(entity_count)
+
+    fmt.println("\n=== All Tests Complete ===")
+}
+
+// =============================================================================
+// Sketch Builders
+// =============================================================================
+
+// Small sketch with one constraint of every type, an arc, a circle, a spline and a fixed point
+build_reference_sketch :: proc() -> sketch.Sketch2D {
+    plane := sketch.sketch_plane_from_normal({1, 2, 3}, {0, 0.6, 0.8})
+    sk := sketch.sketch_init("Reference \"quoted\"\tname", plane)
+
+    p0 := sketch.sketch_add_point(&sk, 0, 0, true)
+    p1 := sketch.sketch_add_point(&sk, 4.25, 0)
+    p2 := sketch.sketch_add_point(&sk, 4.25, 3.0000000000000004)
+    p3 := sketch.sketch_add_point(&sk, 0, 3)
+    pc := sketch.sketch_add_point(&sk, 2, 1.5)
+    pa := sketch.sketch_add_point(&sk, 3, 1.5)
+    pb := sketch.sketch_add_point(&sk, 2, 2.5)
+    pf := sketch.sketch_add_point(&sk, -1e-300, 1e300)
+
+    l0 := sketch.sketch_add_line(&sk, p0, p1)
+    l1 := sketch.sketch_add_line(&sk, p1, p2)
+    l2 := sketch.sketch_add_line(&sk, p2, p3)
+    l3 := sketch.sketch_add_line(&sk, p3, p0)
+    circle := len(sk.entities)
+    append(&sk.entities, sketch.SketchCircle{id = sk.next_entity_id, center_id = pc, radius = 0.75})
+    sk.next_entity_id += 1
+    arc := sketch.sketch_add_arc(&sk, pc, pa, pb, 1)
+    sketch.sketch_add_bezier(&sk, p0, pa, pb, p3)
+
+    add :: proc(sk: ^sketch.Sketch2D, type: sketch.ConstraintType, data: sketch.ConstraintData) {
+        sketch.sketch_add_constraint(sk, type, data, skip_solve = true)
+    }
+
+    add(&sk, .Coincident, sketch.CoincidentData{point1_id = p0, point2_id = p0})
+    add(&sk, .Distance, sketch.DistanceData{point1_id = p0, point2_id = p1, distance = 4.25, offset = {2, -0.5}})
+    add(&sk, .DistanceX, sketch.DistanceXData{point1_id = p0, point2_id = p1, distance = -4.25, offset = {2, -1}, locked_dy = 0.125})
+    add(&sk, .DistanceY, sketch.DistanceYData{point1_id = p1, point2_id = p2, distance = 3, offset = {5, 1.5}, locked_dx = -0.5})
+    add(&sk, .Diameter, sketch.DiameterData{circle_id = circle, diameter = 1.5, offset = {3, 2}})
+    add(&sk, .Angle, sketch.AngleData{line1_id = l0, line2_id = l1, angle = 90, offset = {4, 0.5}})
+    add(&sk, .Perpendicular, sketch.PerpendicularData{line1_id = l1, line2_id = l2})
+    add(&sk, .Parallel, sketch.ParallelData{line1_id = l0, line2_id = l2})
+    add(&sk, .Horizontal, sketch.HorizontalData{line_id = l0})
+    add(&sk, .Vertical, sketch.VerticalData{line_id = l3})
+    add(&sk, .Tangent, sketch.TangentData{entity1_id = l2, entity2_id = circle})
+    add(&sk, .Equal, sketch.EqualData{entity1_id = l0, entity2_id = l2})
+    add(&sk, .PointOnLine, sketch.PointOnLineData{point_id = p3, line_id = l3})
+    add(&sk, .PointOnCircle, sketch.PointOnCircleData{point_id = pa, circle_id = arc})
+    add(&sk, .FixedPoint, sketch.FixedPointData{point_id = pf, x = -1e-300, y = 1e300})
+    add(&sk, .FixedDistance, nil)
+    add(&sk, .FixedAngle, nil)
+
+    sk.constraints[1].driving = false
+    sk.constraints[2].enabled = false
+
+    return sk
+}
+
+// Chain of `entity_count` entities: mostly H/V lines with a circle every 16th slot
+build_large_sketch :: proc(entity_count: int) -> sketch.Sketch2D {
+    sk := sketch.sketch_init("Large", sketch.sketch_plane_xy())
+    reserve(&sk.points, entity_count + 1)
+    reserve(&sk.entities, entity_count)
+    reserve(&sk.constraints, entity_count * 2)
+
+    x, y := 0.0, 0.0
+    prev := sketch.sketch_add_point(&sk, x, y, true)
+
+    for i in 0..<entity_count {
+        if i % 16 == 15 {
+            // Circle centered on the previous point, with its diameter dimension
+            circle := len(sk.entities)
+            radius := 0.1 + f64(i % 7) * 0.01
+            append(&sk.entities, sketch.SketchCircle{id = sk.next_entity_id, center_id = prev, radius = radius})
+            sk.next_entity_id += 1
+            sketch.sketch_add_constraint(&sk, .Diameter, sketch.DiameterData{
+                circle_id = circle,
+                diameter = radius * 2,
+                offset = {x + radius * 1.5, y},
+            }, skip_solve = true)
+            continue
+        }
+
+        length := 0.5 + f64(i % 11) * 0.173
+        horizontal := i % 2 == 0
+        if horizontal {
+            x += length
+        } else {
+            y += length
+        }
+
+        curr := sketch.sketch_add_point(&sk, x, y)
+        line := sketch.sketch_add_line(&sk, prev, curr)
+
+        if horizontal {
+            sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = line}, skip_solve = true)
+        } else {
+            sketch.sketch_add_constraint(&sk, .Vertical, sketch.VerticalData{line_id = line}, skip_solve = true)
+        }
+        sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+            point1_id = prev,
+            point2_id = curr,
+            distance = length,
+            offset = {x, y + 0.25},
+        }, skip_solve = true)
+
+        prev = curr
+    }
+
+    return sk
+}
+
+// =============================================================================
+// Comparison
+// =============================================================================
+
+same_f64 :: proc(a, b: f64) -> bool {
+    return a == b || (a != a && b != b)  // NaN round-trips as NaN
+}
+
+entity_equal :: proc(a, b: sketch.SketchEntity) -> bool {
+    switch ea in a {
+    case sketch.SketchLine:
+        eb, ok := b.(sketch.SketchLine)
+        return ok && ea == eb
+    case sketch.SketchCircle:
+        eb, ok := b.(sketch.SketchCircle)
+        return ok && ea.id == eb.id && ea.center_id == eb.center_id && same_f64(ea.radius, eb.radius)
+    case sketch.SketchArc:
+        eb, ok := b.(sketch.SketchArc)
+        return ok && ea.id == eb.id && ea.center_id == eb.center_id &&
+               ea.start_id == eb.start_id && ea.end_id == eb.end_id && same_f64(ea.radius, eb.radius)
+    case sketch.SketchSpline:
+        eb, ok := b.(sketch.SketchSpline)
+        return ok && ea == eb
+    }
+    return b == nil
+}
+
+constraint_equal :: proc(a, b: ^sketch.Constraint) -> bool {
+    if a.id != b.id || a.type != b.type || a.enabled != b.enabled || a.driving != b.driving do return false
+
+    fa := sketch.constraint_to_fields(a)
+    fb := sketch.constraint_to_fields(b)
+    if fa.n_ints != fb.n_ints || fa.n_floats != fb.n_floats do return false
+    for k in 0..<fa.n_ints {
+        if fa.ints[k] != fb.ints[k] do return false
+    }
+    for k in 0..<fa.n_floats {
+        if !same_f64(fa.floats[k], fb.floats[k]) do return false
+    }
+    return true
+}
+
+// Returns an empty string when equal, otherwise a description of the first mismatch
+sketch_diff :: proc(a, b: ^sketch.Sketch2D) -> string {
+    if a.name != b.name do return "name"
+    if a.plane != b.plane do return "plane"
+    if a.next_point_id != b.next_point_id || a.next_entity_id != b.next_entity_id ||
+       a.next_constraint_id != b.next_constraint_id {
+        return "id counters"
+    }
+    if len(a.points) != len(b.points) do return "point count"
+    if len(a.entities) != len(b.entities) do return "entity count"
+    if len(a.constraints) != len(b.constraints) do return "constraint count"
+
+    for i in 0..<len(a.points) {
+        pa, pb := a.points[i], b.points[i]
+        if pa.id != pb.id || pa.fixed != pb.fixed || !same_f64(pa.x, pb.x) || !same_f64(pa.y, pb.y) {
+            return fmt.tprintf("point %d", i)
+        }
+    }
+    for i in 0..<len(a.entities) {
+        if !entity_equal(a.entities[i], b.entities[i]) do return fmt.tprintf("entity %d", i)
+    }
+    for i in 0..<len(a.constraints) {
+        if !constraint_equal(&a.constraints[i], &b.constraints[i]) do return fmt.tprintf("constraint %d", i)
+    }
+    return ""
+}
+
+// =============================================================================
+// Test 1: Exact round-trip of every constraint type (text + binary)
+// =============================================================================
+
+test_all_constraint_types :: proc() {
+    fmt.println("Test 1: Round-trip all constraint types")
+    fmt.println("----------------------------------------")
+
+    original := build_reference_sketch()
+    defer sketch.sketch_destroy(&original)
+
+    for format in sketch.SketchFileFormat {
+        data := sketch.sketch_encode(&original, format)
+        defer delete(data)
+
+        decoded, err := sketch.sketch_decode(data)
+        defer sketch.sketch_destroy(&decoded)
+
+        if err != .None {
+            fmt.printf("❌ FAIL: %v decode error: %v\n", format, err)
+            continue
+        }
+
+        diff := sketch_diff(&original, &decoded)
+        if diff == "" {
+            fmt.printf("✅ PASS: %v round-trip exact (%d bytes, %d constraints)\n",
+                format, len(data), len(decoded.constraints))
+        } else {
+            fmt.printf("❌ FAIL: %v round-trip mismatch at %s\n", format, diff)
+        }
+    }
+
+    fmt.println()
+}
+
+// =============================================================================
+// Test 2: Corrupt / legacy input is rejected, not crashed on
+// =============================================================================
+
+test_corrupt_input :: proc() {
+    fmt.println("Test 2: Corrupt and legacy input")
+    fmt.println("---------------------------------")
+
+    original := build_reference_sketch()
+    defer sketch.sketch_destroy(&original)
+
+    // Every truncation of the binary encoding must fail cleanly
+    binary := sketch.sketch_encode(&original, .Binary)
+    defer delete(binary)
+
+    truncation_ok := true
+    for n in 0..<len(binary) {
+        decoded, err := sketch.sketch_decode(binary[:n])
+        if err == .None {
+            truncation_ok = false
+            sketch.sketch_destroy(&decoded)
+        }
+    }
+    fmt.printf("%s: truncated binary input rejected (%d prefixes)\n",
+        truncation_ok ? "✅ PASS" : "❌ FAIL", len(binary))
+
+    // Truncated text
+    text := sketch.sketch_encode(&original, .Text)
+    defer delete(text)
+
+    decoded, err := sketch.sketch_decode(text[:len(text) / 2])
+    if err != .None {
+        fmt.printf("✅ PASS: truncated text rejected (%v)\n", err)
+    } else {
+        fmt.println("❌ FAIL: truncated text accepted")
+        sketch.sketch_destroy(&decoded)
+    }
+
+    // Splines below the 4 control points sketch_add_spline requires are rejected in both formats
+    short := build_reference_sketch()
+    defer sketch.sketch_destroy(&short)
+    short_spline := sketch.SketchSpline{id = short.next_entity_id, control_start = len(short.spline_controls), control_count = 3}
+    append(&short.spline_controls, 0, 1, 2)
+    append(&short.entities, short_spline)
+
+    for format in ([]sketch.SketchFileFormat{.Text, .Binary}) {
+        encoded := sketch.sketch_encode(&short, format)
+        defer delete(encoded)
+
+        short_decoded, short_err := sketch.sketch_decode(encoded)
+        if short_err == .Bad_Entity {
+            fmt.printf("✅ PASS: %v spline with 3 control points rejected\n", format)
+        } else {
+            fmt.printf("❌ FAIL: %v spline with 3 control points gave %v\n", format, short_err)
+            if short_err == .None do sketch.sketch_destroy(&short_decoded)
+        }
+    }
+
+    // Version 1 JSON (as json.marshal wrote SketchJSON: object points before "lines")
+    // is recognised as legacy and loads through the file API
+    legacy := `{"name":"Old","plane":{"origin":[0,0,0],"x_axis":[1,0,0],"y_axis":[0,1,0],"normal":[0,0,1]},` +
+        `"points":[{"id":0,"x":0,"y":0},{"id":1,"x":10,"y":0},{"id":2,"x":10,"y":5}],` +
+        `"lines":[{"start_id":0,"end_id":1},{"start_id":1,"end_id":2}],"circles":[{"center_id":0,"radius":2.5}],"arcs":[]}`
+    _, legacy_err := sketch.sketch_decode(transmute([]byte)legacy)
+    fmt.printf("%s: legacy JSON detected (%v)\n",
+        legacy_err == .Legacy_Format ? "✅ PASS" : "❌ FAIL", legacy_err)
+
+    legacy_path := "sketch_io_legacy_v1.json"
+    if os.write_entire_file(legacy_path, transmute([]byte)legacy) {
+        defer os.remove(legacy_path)
+
+        loaded, load_ok := sketch.sketch_read_file(legacy_path)
+        defer if load_ok do sketch.sketch_destroy(&loaded)
+        legacy_ok := load_ok && len(loaded.points) == 3 && len(loaded.entities) == 3 && loaded.points[2].y == 5
+        fmt.printf("%s: legacy v1 file loads (%d points, %d entities)\n",
+            legacy_ok ? "✅ PASS" : "❌ FAIL", len(loaded.points), len(loaded.entities))
+    } else {
+        fmt.println("❌ FAIL: could not write legacy fixture")
+    }
+
+    fmt.println()
+}
+
+// =============================================================================
+// Benchmark: 100k-entity round-trip throughput
+// =============================================================================
+
+BenchTiming :: struct {
+    encode_ms: f64,
+    decode_ms: f64,
+    bytes: int,
+    exact: bool,
+}
+
+report_timing :: proc(label: string, t: BenchTiming, entity_count: int) {
+    mb := f64(t.bytes) / (1024 * 1024)
+    fmt.printf("  %-16s %8.2f MB  encode %8.2f ms (%7.1f MB/s)  decode %8.2f ms (%7.1f MB/s)  %7.2f M entities/s  %s\n",
+        label, mb,
+        t.encode_ms, mb / (t.encode_ms / 1000),
+        t.decode_ms, mb / (t.decode_ms / 1000),
+        f64(entity_count) / ((t.encode_ms + t.decode_ms) / 1000) / 1e6,
+        t.exact ? "✅ exact" : "❌ lossy")
+}
+
+bench_stream :: proc(original: ^sketch.Sketch2D, format: sketch.SketchFileFormat) -> BenchTiming {
+    t := BenchTiming{encode_ms = max(f64), decode_ms = max(f64)}
+
+    for _ in 0..<REPEATS {
+        start := time.tick_now()
+        data := sketch.sketch_encode(original, format)
+        t.encode_ms = min(t.encode_ms, time.duration_milliseconds(time.tick_since(start)))
+
+        start = time.tick_now()
+        decoded, err := sketch.sketch_decode(data)
+        t.decode_ms = min(t.decode_ms, time.duration_milliseconds(time.tick_since(start)))
+
+        t.bytes = len(data)
+        t.exact = err == .None && sketch_diff(original, &decoded) == ""
+
+        sketch.sketch_destroy(&decoded)
+        delete(data)
+    }
+
+    return t
+}
+
+// Previous save/load path: intermediate arrays + json.marshal, json.unmarshal + conversion.
+// Constraints are not stored and entity order is not preserved, so it is never exact.
+bench_legacy :: proc(original: ^sketch.Sketch2D) -> BenchTiming {
+    t := BenchTiming{encode_ms = max(f64), decode_ms = max(f64)}
+
+    for _ in 0..<REPEATS {
+        start := time.tick_now()
+        sketch_json := sketch.sketch_to_json(original)
+        data, marshal_err := json.marshal(sketch_json)
+        t.encode_ms = min(t.encode_ms, time.duration_milliseconds(time.tick_since(start)))
+
+        delete(sketch_json.points)
+        delete(sketch_json.lines)
+        delete(sketch_json.circles)
+        delete(sketch_json.arcs)
+        if marshal_err != nil do return t
+
+        start = time.tick_now()
+        decoded, ok := sketch.sketch_load_legacy_json(data)
+        t.decode_ms = min(t.decode_ms, time.duration_milliseconds(time.tick_since(start)))
+
+        t.bytes = len(data)
+        t.exact = ok && sketch_diff(original, &decoded) == ""
+
+        sketch.sketch_destroy(&decoded)
+        delete(data)
+    }
+
+    return t
+}
+
+benchmark_round_trip :: proc(entity_count: int) {
+    fmt.printf("Benchmark: %d-entity round-trip (best of %d)\n", entity_count, REPEATS)
+    fmt.println("----------------------------------------------------")
+
+    original := build_large_sketch(entity_count)
+    defer sketch.sketch_destroy(&original)
+
+    fmt.printf("  Sketch: %d points, %d entities, %d constraints\n",
+        len(original.points), len(original.entities), len(original.constraints))
+
+    legacy := bench_legacy(&original)
+    text := bench_stream(&original, .Text)
+    binary := bench_stream(&original, .Binary)
+
+    report_timing("legacy json", legacy, entity_count)
+    report_timing("streaming json", text, entity_count)
+    report_timing("binary", binary, entity_count)
+
+    if legacy.encode_ms > 0 && legacy.decode_ms > 0 {
+        fmt.printf("  Speedup vs legacy: text %.1fx, binary %.1fx (round-trip)\n",
+            (legacy.encode_ms + legacy.decode_ms) / (text.encode_ms + text.decode_ms),
+            (legacy.encode_ms + legacy.decode_ms) / (binary.encode_ms + binary.decode_ms))
+    }
+
+    if text.exact && binary.exact {
+        fmt.println("✅ PASS: streaming round-trips are exact")
+    } else {
+        fmt.println("❌ FAIL: streaming round-trip lost data")
+    }
+}
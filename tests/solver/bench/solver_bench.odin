@@ -0,0 +1,594 @@
+// tests/solver/bench - Cross-solver conformance and performance harness
+//
+// Generates families of randomized sketches (chains, grids, bolt circles,
+// trapezoids and their over/under-constrained variants) and runs every case
+// through both solvers:
+//   - libslvs      (solve_sketch_2d)
+//   - LM solver    (sketch_solve_constraints)
+//
+// Both solvers start from an identical copy of the sketch. After each solve the
+// residual is measured with the SAME evaluator (sketch_evaluate_constraints), so
+// the numbers are directly comparable. The report lists convergence, residuals
+// and wall time per case, aggregates them per sketch class, and recommends a
+// solver for each class. The CSV copy carries a per-sketch recommendation
+// column, so solver choice can be driven per sketch rather than per class.
+//
+// Usage: odin run tests/solver/bench -o:speed -- [seed] [report.csv]
+package solver_bench
+
+import "core:fmt"
+import "core:math"
+import "core:os"
+import "core:slice"
+import "core:strconv"
+import "core:strings"
+import "core:time"
+import sketch "../../../src/features/sketch"
+
+// Residual norm below which a case counts as converged (matches LM tolerance scale)
+CONVERGED_TOLERANCE :: 1e-5
+
+// Number of random instances generated per (class, size) pair
+INSTANCES_PER_SIZE :: 4
+
+// =============================================================================
+// Case Description
+// =============================================================================
+
+SketchClass :: enum {
+    Chain,
+    Grid,
+    BoltCircle,
+    Trapezoid,
+    Overconstrained,
+    Underconstrained,
+}
+
+SolverKind :: enum {
+    Libslvs,
+    LM,
+}
+
+// What a correct solver is expected to do with the case
+ExpectedOutcome :: enum {
+    Solve,    // Well-constrained: must converge to zero residual
+    Reject,   // Conflicting constraints: must report failure
+    Partial,  // Under-constrained: any zero-residual configuration is fine
+}
+
+BenchCase :: struct {
+    name: string,
+    class: SketchClass,
+    size: int,               // Generator size parameter (segments, cells, holes, ...)
+    expected: ExpectedOutcome,
+    sketch: sketch.Sketch2D,
+}
+
+BenchRun :: struct {
+    case_index: int,
+    solver: SolverKind,
+    reported_ok: bool,       // Solver's own verdict
+    conforms: bool,          // Verdict matches the expected outcome
+    iterations: int,         // LM only (-1 for libslvs)
+    dof: int,                // DOF reported by the solver
+    residual: f64,           // Residual norm after solving (common evaluator)
+    time_ms: f64,
+}
+
+// =============================================================================
+// Deterministic RNG (xorshift64*) - independent of core:math/rand versions
+// =============================================================================
+
+Rng :: struct {
+    state: u64,
+}
+
+rng_init :: proc(seed: u64) -> Rng {
+    return Rng{state = seed == 0 ? 0x9E3779B97F4A7C15 : seed}
+}
+
+rng_next :: proc(r: ^Rng) -> u64 {
+    r.state ~= r.state >> 12
+    r.state ~= r.state << 25
+    r.state ~= r.state >> 27
+    return r.state * 0x2545F4914F6CDD1D
+}
+
+// Uniform float in [lo, hi)
+rng_range :: proc(r: ^Rng, lo, hi: f64) -> f64 {
+    unit := f64(rng_next(r) >> 11) / f64(1 << 53)
+    return lo + (hi - lo) * unit
+}
+
+// =============================================================================
+// Sketch Generators
+// =============================================================================
+// Generators only use constraint types that libslvs and the LM solver interpret
+// identically (Distance, Horizontal, Vertical, Equal, PointOnCircle). DistanceX/Y
+// are deliberately excluded: libslvs maps them to a Euclidean distance, so they
+// would show up as a conformance difference rather than a solver quality signal.
+//
+// Every generator places points near (not at) the solution, with `noise` as the
+// maximum perturbation, then adds constraints with skip_solve so nothing is
+// solved before the benchmark runs.
+
+// Open polyline of `segments` lines alternating horizontal/vertical with random lengths
+generate_chain :: proc(rng: ^Rng, segments: int, noise: f64) -> sketch.Sketch2D {
+    sk := sketch.sketch_init("Chain", sketch.sketch_plane_xy())
+
+    x, y := 0.0, 0.0
+    prev := sketch.sketch_add_point(&sk, x, y, true)
+
+    for i in 0..<segments {
+        length := rng_range(rng, 0.5, 3.0)
+        horizontal := i % 2 == 0
+        if horizontal {
+            x += length
+        } else {
+            y += length
+        }
+
+        curr := sketch.sketch_add_point(&sk,
+            x + rng_range(rng, -noise, noise),
+            y + rng_range(rng, -noise, noise))
+        line := sketch.sketch_add_line(&sk, prev, curr)
+
+        if horizontal {
+            sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = line}, skip_solve = true)
+        } else {
+            sketch.sketch_add_constraint(&sk, .Vertical, sketch.VerticalData{line_id = line}, skip_solve = true)
+        }
+        sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+            point1_id = prev,
+            point2_id = curr,
+            distance = length,
+        }, skip_solve = true)
+
+        prev = curr
+    }
+
+    return sk
+}
+
+// rows x cols lattice of points. Row 0 is chained horizontally from the fixed
+// origin, every other point hangs vertically from the point above it. The
+// remaining horizontal edges are drawn but left unconstrained (DOF stays 0).
+generate_grid :: proc(rng: ^Rng, rows, cols: int, noise: f64) -> sketch.Sketch2D {
+    sk := sketch.sketch_init("Grid", sketch.sketch_plane_xy())
+
+    col_x := make([]f64, cols)
+    defer delete(col_x)
+    row_y := make([]f64, rows)
+    defer delete(row_y)
+
+    for c in 1..<cols do col_x[c] = col_x[c - 1] + rng_range(rng, 0.5, 2.0)
+    for r in 1..<rows do row_y[r] = row_y[r - 1] + rng_range(rng, 0.5, 2.0)
+
+    ids := make([]int, rows * cols)
+    defer delete(ids)
+
+    for r in 0..<rows {
+        for c in 0..<cols {
+            fixed := r == 0 && c == 0
+            jitter := fixed ? 0.0 : noise
+            ids[r * cols + c] = sketch.sketch_add_point(&sk,
+                col_x[c] + rng_range(rng, -jitter, jitter),
+                row_y[r] + rng_range(rng, -jitter, jitter),
+                fixed)
+        }
+    }
+
+    for r in 0..<rows {
+        for c in 0..<cols {
+            if r == 0 && c == 0 do continue
+
+            curr := ids[r * cols + c]
+            if r == 0 {
+                prev := ids[c - 1]
+                line := sketch.sketch_add_line(&sk, prev, curr)
+                sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = line}, skip_solve = true)
+                sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+                    point1_id = prev,
+                    point2_id = curr,
+                    distance = col_x[c] - col_x[c - 1],
+                }, skip_solve = true)
+            } else {
+                above := ids[(r - 1) * cols + c]
+                line := sketch.sketch_add_line(&sk, above, curr)
+                sketch.sketch_add_constraint(&sk, .Vertical, sketch.VerticalData{line_id = line}, skip_solve = true)
+                sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+                    point1_id = above,
+                    point2_id = curr,
+                    distance = row_y[r] - row_y[r - 1],
+                }, skip_solve = true)
+
+                // Cosmetic horizontal edge (no constraints)
+                if c > 0 do sketch.sketch_add_line(&sk, ids[r * cols + c - 1], curr)
+            }
+        }
+    }
+
+    return sk
+}
+
+// Fixed-center circle with `holes` equally spaced points on it. The first hole
+// is pinned by a horizontal spoke of fixed length (which also fixes the radius),
+// the rest by chord lengths.
+generate_bolt_circle :: proc(rng: ^Rng, holes: int, noise: f64) -> sketch.Sketch2D {
+    sk := sketch.sketch_init("BoltCircle", sketch.sketch_plane_xy())
+
+    radius := rng_range(rng, 2.0, 6.0)
+    chord := 2.0 * radius * math.sin(math.PI / f64(holes))
+
+    center := sketch.sketch_add_point(&sk, 0, 0, true)
+    circle := sketch.sketch_add_circle(&sk, center, radius)
+
+    prev := -1
+    for i in 0..<holes {
+        angle := 2.0 * math.PI * f64(i) / f64(holes)
+        hole := sketch.sketch_add_point(&sk,
+            radius * math.cos(angle) + rng_range(rng, -noise, noise),
+            radius * math.sin(angle) + rng_range(rng, -noise, noise))
+
+        sketch.sketch_add_constraint(&sk, .PointOnCircle, sketch.PointOnCircleData{
+            point_id = hole,
+            circle_id = circle,
+        }, skip_solve = true)
+
+        if i == 0 {
+            spoke := sketch.sketch_add_line(&sk, center, hole)
+            sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = spoke}, skip_solve = true)
+            sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+                point1_id = center,
+                point2_id = hole,
+                distance = radius,
+            }, skip_solve = true)
+        } else {
+            sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+                point1_id = prev,
+                point2_id = hole,
+                distance = chord,
+            }, skip_solve = true)
+        }
+        prev = hole
+    }
+
+    return sk
+}
+
+// Isosceles trapezoid: horizontal bottom/top with given lengths, equal legs, fixed height
+generate_trapezoid :: proc(rng: ^Rng, noise: f64) -> sketch.Sketch2D {
+    sk := sketch.sketch_init("Trapezoid", sketch.sketch_plane_xy())
+
+    bottom := rng_range(rng, 4.0, 8.0)
+    top := bottom * rng_range(rng, 0.3, 0.8)
+    height := rng_range(rng, 1.0, 4.0)
+    inset := (bottom - top) * 0.5
+
+    p0 := sketch.sketch_add_point(&sk, 0, 0, true)
+    p1 := sketch.sketch_add_point(&sk, bottom + rng_range(rng, -noise, noise), rng_range(rng, -noise, noise))
+    p2 := sketch.sketch_add_point(&sk, bottom - inset + rng_range(rng, -noise, noise), height + rng_range(rng, -noise, noise))
+    p3 := sketch.sketch_add_point(&sk, inset + rng_range(rng, -noise, noise), height + rng_range(rng, -noise, noise))
+
+    l_bottom := sketch.sketch_add_line(&sk, p0, p1)
+    l_right := sketch.sketch_add_line(&sk, p1, p2)
+    l_top := sketch.sketch_add_line(&sk, p2, p3)
+    l_left := sketch.sketch_add_line(&sk, p3, p0)
+
+    sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = l_bottom}, skip_solve = true)
+    sketch.sketch_add_constraint(&sk, .Horizontal, sketch.HorizontalData{line_id = l_top}, skip_solve = true)
+    sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{point1_id = p0, point2_id = p1, distance = bottom}, skip_solve = true)
+    sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{point1_id = p2, point2_id = p3, distance = top}, skip_solve = true)
+    sketch.sketch_add_constraint(&sk, .Equal, sketch.EqualData{entity1_id = l_left, entity2_id = l_right}, skip_solve = true)
+
+    // Height via the left leg length (keeps to conformant constraint types)
+    leg := math.sqrt(inset * inset + height * height)
+    sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{point1_id = p3, point2_id = p0, distance = leg}, skip_solve = true)
+
+    return sk
+}
+
+// Over-constrained variant: a chain with a contradictory duplicate distance on its first segment
+generate_overconstrained :: proc(rng: ^Rng, segments: int, noise: f64) -> sketch.Sketch2D {
+    sk := generate_chain(rng, segments, noise)
+    sk.name = "Overconstrained"
+
+    // First Distance constraint sits at index 1 (after the Horizontal)
+    if len(sk.constraints) >= 2 {
+        if data, ok := sk.constraints[1].data.(sketch.DistanceData); ok {
+            sketch.sketch_add_constraint(&sk, .Distance, sketch.DistanceData{
+                point1_id = data.point1_id,
+                point2_id = data.point2_id,
+                distance = data.distance * 1.5,
+            }, skip_solve = true)
+        }
+    }
+
+    return sk
+}
+
+// Under-constrained variant: a chain with every other Distance constraint removed
+generate_underconstrained :: proc(rng: ^Rng, segments: int, noise: f64) -> sketch.Sketch2D {
+    sk := generate_chain(rng, segments, noise)
+    sk.name = "Underconstrained"
+
+    distance_count := 0
+    for i := 0; i < len(sk.constraints); {
+        if sk.constraints[i].type == .Distance {
+            distance_count += 1
+            if distance_count % 2 == 0 {
+                ordered_remove(&sk.constraints, i)
+                continue
+            }
+        }
+        i += 1
+    }
+
+    return sk
+}
+
+// =============================================================================
+// Sketch Copy
+// =============================================================================
+
+// Deep copy geometry and constraints so each solver starts from the same state
+sketch_clone :: proc(src: ^sketch.Sketch2D) -> sketch.Sketch2D {
+    dst := src^
+    dst.points = make([dynamic]sketch.SketchPoint, len(src.points))
+    copy(dst.points[:], src.points[:])
+    dst.entities = make([dynamic]sketch.SketchEntity, len(src.entities))
+    copy(dst.entities[:], src.entities[:])
+    dst.constraints = make([dynamic]sketch.Constraint, len(src.constraints))
+    copy(dst.constraints[:], src.constraints[:])
+    return dst
+}
+
+// =============================================================================
+// Case Construction
+// =============================================================================
+
+build_cases :: proc(seed: u64) -> [dynamic]BenchCase {
+    rng := rng_init(seed)
+    cases := make([dynamic]BenchCase)
+
+    NOISE :: 0.25
+
+    add :: proc(cases: ^[dynamic]BenchCase, class: SketchClass, size: int, expected: ExpectedOutcome, sk: sketch.Sketch2D) {
+        append(cases, BenchCase{
+            name = fmt.aprintf("%v-%d-%d", class, size, len(cases)),
+            class = class,
+            size = size,
+            expected = expected,
+            sketch = sk,
+        })
+    }
+
+    for _ in 0..<INSTANCES_PER_SIZE {
+        for size in ([]int{4, 16, 64}) {
+            add(&cases, .Chain, size, .Solve, generate_chain(&rng, size, NOISE))
+        }
+        for size in ([]int{3, 6, 10}) {
+            add(&cases, .Grid, size, .Solve, generate_grid(&rng, size, size, NOISE))
+        }
+        for size in ([]int{4, 8, 24}) {
+            add(&cases, .BoltCircle, size, .Solve, generate_bolt_circle(&rng, size, NOISE * 0.5))
+        }
+        add(&cases, .Trapezoid, 4, .Solve, generate_trapezoid(&rng, NOISE))
+        for size in ([]int{4, 16}) {
+            add(&cases, .Overconstrained, size, .Reject, generate_overconstrained(&rng, size, NOISE))
+            add(&cases, .Underconstrained, size, .Partial, generate_underconstrained(&rng, size, NOISE))
+        }
+    }
+
+    return cases
+}
+
+destroy_cases :: proc(cases: ^[dynamic]BenchCase) {
+    for &c in cases {
+        sketch.sketch_destroy(&c.sketch)
+        delete(c.name)
+    }
+    delete(cases^)
+}
+
+// =============================================================================
+// Running
+// =============================================================================
+
+residual_norm :: proc(sk: ^sketch.Sketch2D) -> f64 {
+    residuals := sketch.sketch_evaluate_constraints(sk)
+    defer delete(residuals)
+    return sketch.compute_norm(residuals)
+}
+
+// Decide whether the solver's behavior matches what the case expects
+judge :: proc(expected: ExpectedOutcome, reported_ok: bool, residual: f64) -> bool {
+    switch expected {
+    case .Solve, .Partial:
+        return reported_ok && residual < CONVERGED_TOLERANCE
+    case .Reject:
+        return !reported_ok
+    }
+    return false
+}
+
+run_case :: proc(c: ^BenchCase, index: int, kind: SolverKind) -> BenchRun {
+    sk := sketch_clone(&c.sketch)
+    defer sketch.sketch_destroy(&sk)
+
+    run := BenchRun{case_index = index, solver = kind, iterations = -1}
+
+    start := time.tick_now()
+    switch kind {
+    case .Libslvs:
+        result := sketch.solve_sketch_2d(&sk)
+        run.reported_ok = result.success
+        run.dof = result.dof
+    case .LM:
+        result := sketch.sketch_solve_constraints(&sk)
+        run.reported_ok = result.status == .Success
+        run.iterations = result.iterations
+        run.dof = sketch.sketch_calculate_dof(&sk).dof
+    }
+    run.time_ms = time.duration_milliseconds(time.tick_since(start))
+
+    run.residual = residual_norm(&sk)
+    run.conforms = judge(c.expected, run.reported_ok, run.residual)
+    return run
+}
+
+// =============================================================================
+// Reporting
+// =============================================================================
+
+ClassSummary :: struct {
+    runs: int,
+    conforming: int,
+    times: [dynamic]f64,
+    max_residual: f64,
+}
+
+median :: proc(values: []f64) -> f64 {
+    if len(values) == 0 do return 0
+    slice.sort(values)
+    return values[len(values) / 2]
+}
+
+print_report :: proc(cases: []BenchCase, runs: []BenchRun) {
+    fmt.println("\n=== Per-Case Results ===")
+    fmt.printf("%-26s %-8s %-5s %-5s %6s %4s %12s %10s\n",
+        "case", "solver", "ok", "conf", "iters", "dof", "residual", "time(ms)")
+    for r in runs {
+        c := cases[r.case_index]
+        fmt.printf("%-26s %-8v %-5v %-5v %6d %4d %12.3e %10.3f\n",
+            c.name, r.solver, r.reported_ok, r.conforms, r.iterations, r.dof, r.residual, r.time_ms)
+    }
+
+    summaries: [SketchClass][SolverKind]ClassSummary
+    defer {
+        for class in SketchClass {
+            for kind in SolverKind do delete(summaries[class][kind].times)
+        }
+    }
+
+    for r in runs {
+        s := &summaries[cases[r.case_index].class][r.solver]
+        s.runs += 1
+        if r.conforms do s.conforming += 1
+        append(&s.times, r.time_ms)
+        if !math.is_nan(r.residual) && r.residual > s.max_residual do s.max_residual = r.residual
+    }
+
+    fmt.println("\n=== Per-Class Summary ===")
+    fmt.printf("%-18s %-8s %10s %14s %14s\n", "class", "solver", "conform", "median(ms)", "max residual")
+    for class in SketchClass {
+        for kind in SolverKind {
+            s := &summaries[class][kind]
+            if s.runs == 0 do continue
+            fmt.printf("%-18v %-8v %5d/%-4d %14.3f %14.3e\n",
+                class, kind, s.conforming, s.runs, median(s.times[:]), s.max_residual)
+        }
+    }
+
+    // Recommendation: highest conformance rate wins, median time breaks ties
+    fmt.println("\n=== Solver Recommendation ===")
+    for class in SketchClass {
+        slvs := &summaries[class][.Libslvs]
+        lm := &summaries[class][.LM]
+        if slvs.runs == 0 || lm.runs == 0 do continue
+
+        slvs_rate := f64(slvs.conforming) / f64(slvs.runs)
+        lm_rate := f64(lm.conforming) / f64(lm.runs)
+
+        best := SolverKind.Libslvs
+        if lm_rate > slvs_rate || (lm_rate == slvs_rate && median(lm.times[:]) < median(slvs.times[:])) {
+            best = .LM
+        }
+
+        marker := slvs_rate == 1 && lm_rate == 1 ? "✅" : "⚠️ "
+        fmt.printf("%s %-18v → %v (libslvs %.0f%%, LM %.0f%%)\n",
+            marker, class, best, slvs_rate * 100, lm_rate * 100)
+    }
+}
+
+// Solver to use for one sketch: the conforming one, the faster if both conform
+// ok = false when neither solver handled the sketch as expected
+recommend_for_case :: proc(runs: []BenchRun, case_index: int) -> (best: SolverKind, ok: bool) {
+    best_time := math.INF_F64
+    for r in runs {
+        if r.case_index != case_index || !r.conforms do continue
+        if r.time_ms < best_time {
+            best, best_time, ok = r.solver, r.time_ms, true
+        }
+    }
+    return
+}
+
+write_csv :: proc(filename: string, cases: []BenchCase, runs: []BenchRun) -> bool {
+    b := strings.builder_make()
+    defer strings.builder_destroy(&b)
+
+    strings.write_string(&b, "case,class,size,expected,solver,reported_ok,conforms,iterations,dof,residual,time_ms,recommended\n")
+    for r in runs {
+        c := cases[r.case_index]
+        fmt.sbprintf(&b, "%s,%v,%d,%v,%v,%v,%v,%d,%d,%.6e,%.6f,",
+            c.name, c.class, c.size, c.expected, r.solver, r.reported_ok, r.conforms,
+            r.iterations, r.dof, r.residual, r.time_ms)
+
+        if best, ok := recommend_for_case(runs, r.case_index); ok {
+            fmt.sbprintf(&b, "%v\n", best)
+        } else {
+            strings.write_string(&b, "none\n")
+        }
+    }
+
+    return os.write_entire_file(filename, transmute([]byte)strings.to_string(b))
+}
+
+// =============================================================================
+// Entry Point
+// =============================================================================
+
+main :: proc() {
+    fmt.println("=== Solver Conformance & Performance Harness ===")
+
+    seed: u64 = 0x0C4D
+    csv_path := "solver_bench.csv"
+
+    if len(os.args) > 1 {
+        if value, ok := strconv.parse_u64(os.args[1]); ok do seed = value
+    }
+    if len(os.args) > 2 {
+        csv_path = os.args[2]
+    }
+
+    fmt.printf("Seed: %d\n", seed)
+
+    cases := build_cases(seed)
+    defer destroy_cases(&cases)
+
+    fmt.printf("Generated %d sketches\n", len(cases))
+
+    runs := make([dynamic]BenchRun, 0, len(cases) * len(SolverKind))
+    defer delete(runs)
+
+    for &c, i in cases {
+        for kind in SolverKind {
+            append(&runs, run_case(&c, i, kind))
+        }
+    }
+
+    print_report(cases[:], runs[:])
+
+    if write_csv(csv_path, cases[:], runs[:]) {
+        fmt.printf("\n✅ Report written to %s\n", csv_path)
+    } else {
+        fmt.printf("\n❌ Failed to write report to %s\n", csv_path)
+    }
+
+    failures := 0
+    for r in runs {
+        if !r.conforms do failures += 1
+    }
+    fmt.printf("\n=== Harness Complete (%d non-conforming runs) ===\n", failures)
+}
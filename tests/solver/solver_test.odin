@@ -3,6 +3,7 @@ package solver_test
 
 import "core:fmt"
 import "core:math"
+import "core:time"
 import sketch "../../src/features/sketch"
 
 main :: proc() {
@@ -15,6 +16,7 @@ main :: proc() {
     test_rectangle_constraints()
     test_overconstrained()
     test_underconstrained()
+    test_async_solver()
 
     fmt.println("\n=== All Tests Complete ===")
 }
@@ -441,3 +443,65 @@ test_underconstrained :: proc() {
 
     fmt.println()
 }
+
+// =============================================================================
+// Test 7: Background Solver (superseded requests are never applied)
+// =============================================================================
+
+test_async_solver :: proc() {
+    fmt.println("Test 7: Background Solver")
+    fmt.println("-------------------------")
+
+    sk := new(sketch.Sketch2D)
+    sk^ = sketch.sketch_init("AsyncTest", sketch.sketch_plane_xy())
+    defer sketch.sketch_destroy(sk)
+    defer free(sk)
+
+    p1_id := sketch.sketch_add_point(sk, 0.0, 0.0, true)  // Fixed
+    p2_id := sketch.sketch_add_point(sk, 1.5, 2.3, false)
+    sketch.sketch_add_constraint(sk, .Distance, sketch.DistanceData{
+        point1_id = p1_id,
+        point2_id = p2_id,
+        distance = 3.0,
+    })
+    sketch.sketch_add_constraint(sk, .DistanceX, sketch.DistanceXData{
+        point1_id = p1_id,
+        point2_id = p2_id,
+        distance = 3.0,
+    })
+
+    solver: sketch.AsyncSolver
+    if !sketch.sketch_async_solver_init(&solver) {
+        fmt.println("❌ FAIL: Could not start solver thread")
+        return
+    }
+    defer sketch.sketch_async_solver_destroy(&solver)
+
+    // Two back-to-back requests: only the second may land
+    first := sketch.sketch_solve_async(&solver, sk)
+    latest := sketch.sketch_solve_async(&solver, sk)
+
+    solved: sketch.AsyncSolveResult
+    applied := false
+    deadline := time.tick_now()
+    for !applied && time.tick_since(deadline) < 5 * time.Second {
+        solved, applied = sketch.sketch_async_solver_poll(&solver, sk)
+        if !applied do time.sleep(time.Millisecond)
+    }
+
+    p2 := sketch.sketch_get_point(sk, p2_id)
+    fmt.printf("  Requests: %d, %d  Applied: %d  Status: %v\n", first, latest, solved.generation, solved.result.status)
+    fmt.printf("  Point 2: (%.6f, %.6f)\n", p2.x, p2.y)
+
+    if !applied {
+        fmt.println("❌ FAIL: Background solve never published")
+    } else if solved.generation != latest {
+        fmt.println("❌ FAIL: Superseded solve was applied")
+    } else if math.abs(p2.x - 3.0) < 1e-3 && math.abs(p2.y) < 1e-3 {
+        fmt.println("✅ PASS: Latest background solve applied to the sketch")
+    } else {
+        fmt.println("❌ FAIL: Solved positions not applied")
+    }
+
+    fmt.println()
+}
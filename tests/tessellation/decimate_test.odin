@@ -0,0 +1,134 @@
+// tests/tessellation - Unit tests for QEM mesh decimation
+package test_tessellation
+
+import "core:testing"
+import "core:math"
+import tess "../../src/core/tessellation"
+import m "../../src/core/math"
+
+// N x N grid on the XY plane spanning [0, 1]^2; left half face_id 0, right half face_id 1
+make_grid :: proc(n: int) -> [dynamic]tess.FaceTri {
+    tris := make([dynamic]tess.FaceTri, 0, n * n * 2)
+    step := 1.0 / f64(n)
+
+    for j in 0..<n {
+        for i in 0..<n {
+            p00 := m.Vec3{f64(i) * step, f64(j) * step, 0}
+            p10 := m.Vec3{f64(i + 1) * step, f64(j) * step, 0}
+            p01 := m.Vec3{f64(i) * step, f64(j + 1) * step, 0}
+            p11 := m.Vec3{f64(i + 1) * step, f64(j + 1) * step, 0}
+            face := i < n / 2 ? 0 : 1
+
+            append(&tris, tess.FaceTri{v0 = p00, v1 = p10, v2 = p11, normal = {0, 0, 1}, face_id = face})
+            append(&tris, tess.FaceTri{v0 = p00, v1 = p11, v2 = p01, normal = {0, 0, 1}, face_id = face})
+        }
+    }
+    return tris
+}
+
+@(test)
+test_indexed_mesh_welds_vertices :: proc(t: ^testing.T) {
+    tris := make_grid(4)
+    defer delete(tris)
+
+    mesh := tess.indexed_mesh_from_tris(tris[:])
+    defer tess.indexed_mesh_destroy(&mesh)
+
+    testing.expect_value(t, len(mesh.triangles), 32)
+    testing.expect_value(t, len(mesh.positions), 25)
+}
+
+@(test)
+test_decimate_flat_grid_to_target :: proc(t: ^testing.T) {
+    tris := make_grid(16)
+    defer delete(tris)
+
+    mesh := tess.indexed_mesh_from_tris(tris[:])
+    defer tess.indexed_mesh_destroy(&mesh)
+
+    params := tess.DEFAULT_DECIMATE
+    params.target_triangles = 64
+    stats := tess.decimate_mesh(&mesh, params)
+
+    testing.expect_value(t, stats.triangles_before, 512)
+    testing.expect(t, stats.triangles_after <= 64, "should reach the triangle target")
+    testing.expect(t, stats.max_error < 1e-9, "flat grid should decimate without error")
+
+    // Every remaining triangle stays on the plane and facing +Z
+    for tri in mesh.triangles {
+        p0, p1, p2 := mesh.positions[tri[0]], mesh.positions[tri[1]], mesh.positions[tri[2]]
+        n := (p1 - p0).x * (p2 - p0).y - (p1 - p0).y * (p2 - p0).x
+        testing.expect(t, n > 0, "triangle flipped or degenerate")
+        testing.expect(t, math.abs(p0.z) < 1e-12, "vertex left the plane")
+    }
+}
+
+@(test)
+test_decimate_preserves_face_boundaries :: proc(t: ^testing.T) {
+    tris := make_grid(16)
+    defer delete(tris)
+
+    mesh := tess.indexed_mesh_from_tris(tris[:])
+    defer tess.indexed_mesh_destroy(&mesh)
+
+    params := tess.DEFAULT_DECIMATE
+    params.target_triangles = 8
+    tess.decimate_mesh(&mesh, params)
+
+    // Triangles never straddle the x = 0.5 seam between face 0 and face 1
+    for tri, i in mesh.triangles {
+        for k in 0..<3 {
+            x := mesh.positions[tri[k]].x
+            if mesh.face_ids[i] == 0 {
+                testing.expect(t, x <= 0.5 + 1e-12, "face 0 triangle crosses the seam")
+            } else {
+                testing.expect(t, x >= 0.5 - 1e-12, "face 1 triangle crosses the seam")
+            }
+        }
+    }
+
+    // Outline corners are locked
+    corners := [4]m.Vec3{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}
+    for c in corners {
+        found := false
+        for p in mesh.positions {
+            if m.is_near(p, c) do found = true
+        }
+        testing.expect(t, found, "outline corner was collapsed")
+    }
+}
+
+@(test)
+test_decimate_locks_l_corner :: proc(t: ^testing.T) {
+    // Upper-right quadrant is face 1: its boundary inside the square is an L with the
+    // corner at (0.5, 0.5), a vertex on exactly two crease edges
+    n := 16
+    tris := make_grid(n)
+    defer delete(tris)
+    for &tri in tris {
+        c := (tri.v0 + tri.v1 + tri.v2) / 3
+        tri.face_id = c.x > 0.5 && c.y > 0.5 ? 1 : 0
+    }
+
+    mesh := tess.indexed_mesh_from_tris(tris[:])
+    defer tess.indexed_mesh_destroy(&mesh)
+
+    params := tess.DEFAULT_DECIMATE
+    params.target_triangles = 8
+    tess.decimate_mesh(&mesh, params)
+
+    found := false
+    for p in mesh.positions {
+        if m.is_near(p, m.Vec3{0.5, 0.5, 0}) do found = true
+    }
+    testing.expect(t, found, "L-shaped face boundary corner was collapsed")
+
+    // Face 1 triangles stay inside the quadrant
+    for tri, i in mesh.triangles {
+        if mesh.face_ids[i] != 1 do continue
+        for k in 0..<3 {
+            p := mesh.positions[tri[k]]
+            testing.expect(t, p.x >= 0.5 - 1e-12 && p.y >= 0.5 - 1e-12, "face 1 triangle left its quadrant")
+        }
+    }
+}
@@ -0,0 +1,139 @@
+// tests/tessellation - Unit tests for the polygon triangulation front end
+package test_tessellation
+
+import "core:testing"
+import "core:math"
+import tess "../../src/core/tessellation"
+import m "../../src/core/math"
+
+// Sum of triangle areas (absolute) in the polygon's 2D space
+triangulated_area :: proc(points: []m.Vec2, result: ^tess.Triangulation) -> f64 {
+    area := 0.0
+    for t in result.triangles {
+        a, b, c := points[t[0]], points[t[1]], points[t[2]]
+        area += abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5
+    }
+    return area
+}
+
+@(test)
+test_convex_polygon_uses_fan :: proc(t: ^testing.T) {
+    hexagon := make([]m.Vec2, 6)
+    defer delete(hexagon)
+    for i in 0..<6 {
+        angle := f64(i) * math.PI / 3
+        hexagon[i] = m.Vec2{math.cos(angle), math.sin(angle)}
+    }
+
+    result := tess.triangulate_polygon_2d(hexagon)
+    defer tess.triangulation_destroy(&result)
+
+    testing.expect_value(t, result.class, tess.PolygonClass.Convex)
+    testing.expect_value(t, result.path, tess.TriangulatePath.Fan)
+    testing.expect_value(t, len(result.triangles), 4)
+    testing.expect(t, abs(triangulated_area(hexagon, &result) - abs(m.polygon_signed_area_2d(hexagon))) < 1e-12,
+        "Fan should cover the hexagon exactly")
+}
+
+@(test)
+test_concave_polygon_uses_ear_clipping :: proc(t: ^testing.T) {
+    // Concave L-shape, clockwise
+    l_shape := []m.Vec2{{0, 0}, {0, 2}, {1, 2}, {1, 1}, {2, 1}, {2, 0}}
+
+    result := tess.triangulate_polygon_2d(l_shape)
+    defer tess.triangulation_destroy(&result)
+
+    testing.expect_value(t, result.class, tess.PolygonClass.Simple)
+    testing.expect_value(t, result.path, tess.TriangulatePath.EarClip)
+    testing.expect_value(t, len(result.triangles), 4)
+    testing.expect(t, abs(triangulated_area(l_shape, &result) - 3) < 1e-12, "Ear clipping should cover the L exactly")
+
+    // Every triangle keeps the input (CW) winding
+    for tri in result.triangles {
+        testing.expect(t, m.orient2d(l_shape[tri[0]], l_shape[tri[1]], l_shape[tri[2]]) < 0,
+            "Triangles should keep the polygon's winding")
+    }
+}
+
+@(test)
+test_self_intersecting_polygon_uses_sweep :: proc(t: ^testing.T) {
+    // Bow tie: edges (0,1) and (2,3) cross
+    bow_tie := []m.Vec2{{0, 0}, {2, 2}, {2, 0}, {0, 2}}
+
+    testing.expect_value(t, tess.classify_polygon_2d(bow_tie), tess.PolygonClass.Complex)
+
+    pentagram := make([]m.Vec2, 5)
+    defer delete(pentagram)
+    for i in 0..<5 {
+        angle := f64(i * 2) * 2 * math.PI / 5
+        pentagram[i] = m.Vec2{math.cos(angle), math.sin(angle)}
+    }
+    testing.expect(t, tess.classify_polygon_2d(pentagram) != tess.PolygonClass.Convex,
+        "Star polygon must not be treated as convex")
+}
+
+// Every triangle of result has the given orientation sign
+expect_winding :: proc(t: ^testing.T, points: []m.Vec2, result: ^tess.Triangulation, sign: f64, label: string) {
+    testing.expectf(t, len(result.triangles) > 0, "%s produced no triangles", label)
+    for tri in result.triangles {
+        o := m.orient2d(points[tri[0]], points[tri[1]], points[tri[2]])
+        testing.expectf(t, o * sign > 0, "%s: triangle %v does not keep the input winding", label, tri)
+    }
+}
+
+@(test)
+test_sweep_winding_matches_fast_paths :: proc(t: ^testing.T) {
+    square_ccw := []m.Vec2{{0, 0}, {1, 0}, {1, 1}, {0, 1}}
+    square_cw := []m.Vec2{{0, 1}, {1, 1}, {1, 0}, {0, 0}}
+
+    squares := [2][]m.Vec2{square_ccw, square_cw}
+    for square in squares {
+        sign := m.polygon_signed_area_2d(square) > 0 ? 1.0 : -1.0
+        paths := [3]tess.TriangulatePath{.Fan, .EarClip, .Sweep}
+        for path in paths {
+            result := tess.triangulate_polygon_2d(square, nil, path)
+            defer tess.triangulation_destroy(&result)
+            expect_winding(t, square, &result, sign, sign > 0 ? "CCW square" : "CW square")
+        }
+    }
+
+    // Large concave polygons take the sweep on the Auto path
+    N :: 100
+    gear := make([]m.Vec2, N)
+    defer delete(gear)
+    directions := [2]f64{1, -1}
+    for direction in directions {
+        for i in 0..<N {
+            angle := direction * f64(i) * 2 * math.PI / N
+            radius := i % 2 == 0 ? 1.0 : 0.8
+            gear[i] = m.Vec2{radius * math.cos(angle), radius * math.sin(angle)}
+        }
+
+        result := tess.triangulate_polygon_2d(gear)
+        defer tess.triangulation_destroy(&result)
+        testing.expect_value(t, result.path, tess.TriangulatePath.Sweep)
+        expect_winding(t, gear, &result, direction, direction > 0 ? "CCW 100-vertex gear" : "CW 100-vertex gear")
+    }
+}
+
+@(test)
+test_output_order_is_canonical :: proc(t: ^testing.T) {
+    square := []m.Vec2{{0, 0}, {1, 0}, {1, 1}, {0, 1}}
+
+    fan := tess.triangulate_polygon_2d(square, nil, .Fan)
+    defer tess.triangulation_destroy(&fan)
+    ear := tess.triangulate_polygon_2d(square, nil, .EarClip)
+    defer tess.triangulation_destroy(&ear)
+
+    results := [2]^tess.Triangulation{&fan, &ear}
+    for r in results {
+        for tri, i in r.triangles {
+            testing.expect(t, tri[0] < tri[1] && tri[0] < tri[2], "Triangles should start at their lowest index")
+            if i > 0 {
+                prev := r.triangles[i - 1]
+                testing.expect(t, prev[0] < tri[0] || (prev[0] == tri[0] && prev[1] <= tri[1]),
+                    "Triangles should be sorted")
+            }
+        }
+    }
+}
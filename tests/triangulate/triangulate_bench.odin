@@ -0,0 +1,121 @@
+// tests/triangulate - Triangulation front end benchmark
+//
+// For each polygon class the front end recognises, times the fast path it picks
+// against the libtess2 sweep every face used to go through:
+//   - convex quad and 32-gon  → fan
+//   - concave comb (simple)   → ear clipping
+//   - self-intersecting star  → libtess2 either way (classification overhead only)
+// and checks that both paths cover the same area.
+//
+// Usage: odin run tests/triangulate -o:speed -- [iterations]
+package triangulate_bench
+
+import "core:fmt"
+import "core:math"
+import "core:os"
+import "core:strconv"
+import "core:time"
+import tess "../../src/core/tessellation"
+import m "../../src/core/math"
+
+DEFAULT_ITERATIONS :: 100_000
+
+main :: proc() {
+    iterations := DEFAULT_ITERATIONS
+    if len(os.args) > 1 {
+        if value, ok := strconv.parse_int(os.args[1]); ok && value > 0 do iterations = value
+    }
+
+    fmt.println("=== Triangulation Front End Benchmark ===")
+    fmt.printf("%d triangulations per case\n\n", iterations)
+
+    quad := []m.Vec2{{0, 0}, {2, 0}, {2, 1}, {0, 1}}
+
+    ngon := make([]m.Vec2, 32)
+    defer delete(ngon)
+    for i in 0..<len(ngon) {
+        angle := f64(i) * 2 * math.PI / f64(len(ngon))
+        ngon[i] = m.Vec2{math.cos(angle), math.sin(angle)}
+    }
+
+    // Comb: 8 teeth along the top of a bar (simple, concave)
+    comb := make([dynamic]m.Vec2)
+    defer delete(comb)
+    append(&comb, m.Vec2{0, 0}, m.Vec2{16, 0})
+    for tooth := 7; tooth >= 0; tooth -= 1 {
+        x := f64(tooth) * 2
+        append(&comb, m.Vec2{x + 2, 1}, m.Vec2{x + 1.5, 3}, m.Vec2{x + 0.5, 3})
+    }
+    append(&comb, m.Vec2{0, 1})
+
+    // Self-intersecting 7-point star
+    star := make([]m.Vec2, 7)
+    defer delete(star)
+    for i in 0..<len(star) {
+        angle := f64(i * 3) * 2 * math.PI / f64(len(star))
+        star[i] = m.Vec2{math.cos(angle), math.sin(angle)}
+    }
+
+    failed := 0
+    failed += run_case("convex quad", quad, iterations)
+    failed += run_case("convex 32-gon", ngon, iterations)
+    failed += run_case("simple comb (27 verts)", comb[:], iterations)
+    failed += run_case("self-intersecting star", star, iterations)
+
+    fmt.printf("\n=== %s ===\n", failed == 0 ? "All cases consistent" : "Path mismatch detected")
+}
+
+// Time the automatic path against the forced libtess2 sweep; returns 1 on an area mismatch
+run_case :: proc(name: string, polygon: []m.Vec2, iterations: int) -> int {
+    auto_result := tess.triangulate_polygon_2d(polygon)
+    defer tess.triangulation_destroy(&auto_result)
+    sweep_result := tess.triangulate_polygon_2d(polygon, nil, .Sweep)
+    defer tess.triangulation_destroy(&sweep_result)
+
+    start := time.tick_now()
+    for _ in 0..<iterations {
+        r := tess.triangulate_polygon_2d(polygon)
+        tess.triangulation_destroy(&r)
+    }
+    auto_time := time.tick_since(start)
+
+    start = time.tick_now()
+    for _ in 0..<iterations {
+        r := tess.triangulate_polygon_2d(polygon, nil, .Sweep)
+        tess.triangulation_destroy(&r)
+    }
+    sweep_time := time.tick_since(start)
+
+    per_call :: proc(d: time.Duration, iterations: int) -> f64 {
+        return time.duration_microseconds(d) / f64(iterations)
+    }
+
+    auto_us := per_call(auto_time, iterations)
+    sweep_us := per_call(sweep_time, iterations)
+    fmt.printf("  %-24s class %-8v path %-8v %7.3f µs   libtess2 %7.3f µs   speedup %5.1fx\n",
+        name, auto_result.class, auto_result.path, auto_us, sweep_us, auto_us > 0 ? sweep_us / auto_us : 0)
+
+    // Self-intersecting input adds new vertices, so only compare area for single-cover polygons
+    if auto_result.class != .Complex {
+        a := covered_area(polygon, &auto_result)
+        b := covered_area(polygon, &sweep_result)
+        if abs(a - b) > 1e-4 * max(abs(a), 1) {
+            fmt.printf("  ❌ %s: fast path covers %.6f, libtess2 covers %.6f\n", name, a, b)
+            return 1
+        }
+    }
+    return 0
+}
+
+covered_area :: proc(points: []m.Vec2, result: ^tess.Triangulation) -> f64 {
+    point :: proc(points: []m.Vec2, result: ^tess.Triangulation, i: int) -> m.Vec2 {
+        return i < len(points) ? points[i] : result.extra_points[i - len(points)]
+    }
+
+    area := 0.0
+    for t in result.triangles {
+        a, b, c := point(points, result, t[0]), point(points, result, t[1]), point(points, result, t[2])
+        area += abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5
+    }
+    return area
+}